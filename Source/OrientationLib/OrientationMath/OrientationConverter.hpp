@@ -49,6 +49,7 @@
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransformsBatch.hpp"
 
 template<typename T>
 class OrientationConverter
@@ -239,6 +240,9 @@ class OrientationConverter
 
 };
 
+/* The conversion runs through the blocked, vectorized OrientationTransformsBatch
+ * path when the input has the packed layout of its representation and falls back
+ * to the per tuple OrientationTransforms loop otherwise. */
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD)\
   typedef OrientationArray<T> OrientationArray_t;\
   typename DataArray<T>::Pointer input = this->getInputData();\
@@ -250,12 +254,16 @@ class OrientationConverter
   typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
   output->initializeWithZeros(); /* Intialize the array with Zeros */ \
   T* OUT_ARRAY_NAME##Ptr = output->getPointer(0);\
-  for (size_t i = 0; i < nTuples; ++i) { \
-    OrientationArray_t rot(inPtr, inStride); \
-    OrientationArray_t res(OUT_ARRAY_NAME##Ptr, outStride); \
-    OrientationTransforms<OrientationArray_t, T>::CONVERSION_METHOD(rot, res); \
-    inPtr = inPtr + inStride; /* Increment input pointer */ \
-    OUT_ARRAY_NAME##Ptr = OUT_ARRAY_NAME##Ptr + outStride; /* Increment output pointer*/ \
+  if (inStride == OrientationTransformsBatch<T>::GetComponentCount(this->getOrientationRepresentation())) { \
+    OrientationTransformsBatch<T>::CONVERSION_METHOD(inPtr, OUT_ARRAY_NAME##Ptr, nTuples); \
+  } else { \
+    for (size_t i = 0; i < nTuples; ++i) { \
+      OrientationArray_t rot(inPtr, inStride); \
+      OrientationArray_t res(OUT_ARRAY_NAME##Ptr, outStride); \
+      OrientationTransforms<OrientationArray_t, T>::CONVERSION_METHOD(rot, res); \
+      inPtr = inPtr + inStride; /* Increment input pointer */ \
+      OUT_ARRAY_NAME##Ptr = OUT_ARRAY_NAME##Ptr + outStride; /* Increment output pointer*/ \
+    }\
   }\
   this->setOutputData(output);
 
@@ -0,0 +1,1141 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _OrientationTransformsBatch_H_
+#define _OrientationTransformsBatch_H_
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/**
+ * @brief The OrientationTransformsBatch class converts whole arrays of orientations
+ * between any pair of the 7 representations handled by OrientationTransforms. The
+ * scalar routines convert one orientation per call through the OrientationArray
+ * wrapper which keeps the compiler from vectorizing anything. Here the orientations
+ * are processed in blocks that are transposed into structure-of-arrays scratch
+ * buffers (one plane per component). Every conversion kernel is then a straight loop
+ * over a block with the branches of the scalar code expressed as selects, and the
+ * sin/cos/atan2 calls replaced by polynomial versions that only use arithmetic, so
+ * the loops can be vectorized by the compiler. Blocks are distributed over threads
+ * when parallel algorithms are enabled.
+ *
+ * The kernels compute in double precision for both float and double inputs and
+ * follow the same conversion paths as OrientationTransforms (e.g. ho2eu goes through
+ * ho2ax, ax2om and om2eu) so the results agree with the scalar path to within
+ * round off. Quaternions use the same <x,y,z>,w layout as the DataArrays, which is
+ * the default of the scalar routines.
+ *
+ * Float inputs are widened on load and the results are only rounded to float when
+ * they are stored, so the float instantiation matches the double scalar routines
+ * applied to the same float inputs to about 1.0E-6, including Rodrigues vectors
+ * near a half turn and the cubochoric outputs. It does not match the float scalar
+ * routines that closely, since those lose up to 1.0E-3 in the same places. The
+ * thresholds that decide the special cases follow the input type as in the scalar
+ * code. Close to a half turn the signs of the vector part of om2qu come from
+ * differences of matrix elements, so every conversion from a matrix only
+ * reproduces that rotation to about 2.5E-3 there, in both precisions.
+ *
+ * Two memory layouts are supported:
+ * @li Structure of arrays: "in" and "out" are arrays of component pointers, each
+ * pointing to N contiguous values.
+ * @li Interleaved: one pointer to N tuples of the representation's component count,
+ * which is how the orientations are stored in a DataArray.
+ *
+ * All 42 pairs are available as named functions (eu2om, cu2qu, ...) with an
+ * overload for each layout, and through Convert()/ConvertInterleaved() using the
+ * Representation enumeration.
+ */
+template<typename K>
+class OrientationTransformsBatch
+{
+  public:
+    /**
+     * @brief The order of the enumeration matches OrientationConverter::OrientationType
+     */
+    enum Representation
+    {
+      Euler = 0,
+      OrientationMatrix = 1,
+      Quaternion = 2,
+      AxisAngle = 3,
+      Rodrigues = 4,
+      Homochoric = 5,
+      Cubochoric = 6
+    };
+
+    virtual ~OrientationTransformsBatch() {}
+
+    /**
+     * @brief GetComponentCount Returns the number of components of a representation
+     * @param rep
+     * @return
+     */
+    static int GetComponentCount(int rep)
+    {
+      static const int counts[7] = { 3, 9, 4, 4, 4, 3, 3 };
+      if(rep < Euler || rep > Cubochoric) { return 0; }
+      return counts[rep];
+    }
+
+    /**
+     * @brief Convert Converts n orientations stored as structure of arrays
+     * @param inRep The input Representation
+     * @param in Array of GetComponentCount(inRep) pointers, one per component
+     * @param outRep The output Representation
+     * @param out Array of GetComponentCount(outRep) pointers, one per component
+     * @param n Number of orientations
+     */
+    static void Convert(int inRep, const K* const* in, int outRep, K* const* out, size_t n)
+    {
+      const K* inPtrs[9] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+      K* outPtrs[9] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+      for(int c = 0; c < GetComponentCount(inRep); c++) { inPtrs[c] = in[c]; }
+      for(int c = 0; c < GetComponentCount(outRep); c++) { outPtrs[c] = out[c]; }
+      Execute(inRep, inPtrs, 1, outRep, outPtrs, 1, n);
+    }
+
+    /**
+     * @brief ConvertInterleaved Converts n orientations stored as consecutive tuples
+     * @param inRep The input Representation
+     * @param in Pointer to n * GetComponentCount(inRep) values
+     * @param outRep The output Representation
+     * @param out Pointer to n * GetComponentCount(outRep) values
+     * @param n Number of orientations
+     */
+    static void ConvertInterleaved(int inRep, const K* in, int outRep, K* out, size_t n)
+    {
+      const K* inPtrs[9] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+      K* outPtrs[9] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+      int inComps = GetComponentCount(inRep);
+      int outComps = GetComponentCount(outRep);
+      if(n > 0)
+      {
+        for(int c = 0; c < inComps; c++) { inPtrs[c] = in + c; }
+        for(int c = 0; c < outComps; c++) { outPtrs[c] = out + c; }
+      }
+      Execute(inRep, inPtrs, inComps, outRep, outPtrs, outComps, n);
+    }
+
+#define OTB_CONVERSION_PAIR(name, inRep, outRep)\
+  static void name(const K* const* in, K* const* out, size_t n) { Convert(inRep, in, outRep, out, n); }\
+  static void name(const K* in, K* out, size_t n) { ConvertInterleaved(inRep, in, outRep, out, n); }
+
+    OTB_CONVERSION_PAIR(eu2om, Euler, OrientationMatrix)
+    OTB_CONVERSION_PAIR(eu2qu, Euler, Quaternion)
+    OTB_CONVERSION_PAIR(eu2ax, Euler, AxisAngle)
+    OTB_CONVERSION_PAIR(eu2ro, Euler, Rodrigues)
+    OTB_CONVERSION_PAIR(eu2ho, Euler, Homochoric)
+    OTB_CONVERSION_PAIR(eu2cu, Euler, Cubochoric)
+
+    OTB_CONVERSION_PAIR(om2eu, OrientationMatrix, Euler)
+    OTB_CONVERSION_PAIR(om2qu, OrientationMatrix, Quaternion)
+    OTB_CONVERSION_PAIR(om2ax, OrientationMatrix, AxisAngle)
+    OTB_CONVERSION_PAIR(om2ro, OrientationMatrix, Rodrigues)
+    OTB_CONVERSION_PAIR(om2ho, OrientationMatrix, Homochoric)
+    OTB_CONVERSION_PAIR(om2cu, OrientationMatrix, Cubochoric)
+
+    OTB_CONVERSION_PAIR(qu2eu, Quaternion, Euler)
+    OTB_CONVERSION_PAIR(qu2om, Quaternion, OrientationMatrix)
+    OTB_CONVERSION_PAIR(qu2ax, Quaternion, AxisAngle)
+    OTB_CONVERSION_PAIR(qu2ro, Quaternion, Rodrigues)
+    OTB_CONVERSION_PAIR(qu2ho, Quaternion, Homochoric)
+    OTB_CONVERSION_PAIR(qu2cu, Quaternion, Cubochoric)
+
+    OTB_CONVERSION_PAIR(ax2eu, AxisAngle, Euler)
+    OTB_CONVERSION_PAIR(ax2om, AxisAngle, OrientationMatrix)
+    OTB_CONVERSION_PAIR(ax2qu, AxisAngle, Quaternion)
+    OTB_CONVERSION_PAIR(ax2ro, AxisAngle, Rodrigues)
+    OTB_CONVERSION_PAIR(ax2ho, AxisAngle, Homochoric)
+    OTB_CONVERSION_PAIR(ax2cu, AxisAngle, Cubochoric)
+
+    OTB_CONVERSION_PAIR(ro2eu, Rodrigues, Euler)
+    OTB_CONVERSION_PAIR(ro2om, Rodrigues, OrientationMatrix)
+    OTB_CONVERSION_PAIR(ro2qu, Rodrigues, Quaternion)
+    OTB_CONVERSION_PAIR(ro2ax, Rodrigues, AxisAngle)
+    OTB_CONVERSION_PAIR(ro2ho, Rodrigues, Homochoric)
+    OTB_CONVERSION_PAIR(ro2cu, Rodrigues, Cubochoric)
+
+    OTB_CONVERSION_PAIR(ho2eu, Homochoric, Euler)
+    OTB_CONVERSION_PAIR(ho2om, Homochoric, OrientationMatrix)
+    OTB_CONVERSION_PAIR(ho2qu, Homochoric, Quaternion)
+    OTB_CONVERSION_PAIR(ho2ax, Homochoric, AxisAngle)
+    OTB_CONVERSION_PAIR(ho2ro, Homochoric, Rodrigues)
+    OTB_CONVERSION_PAIR(ho2cu, Homochoric, Cubochoric)
+
+    OTB_CONVERSION_PAIR(cu2eu, Cubochoric, Euler)
+    OTB_CONVERSION_PAIR(cu2om, Cubochoric, OrientationMatrix)
+    OTB_CONVERSION_PAIR(cu2qu, Cubochoric, Quaternion)
+    OTB_CONVERSION_PAIR(cu2ax, Cubochoric, AxisAngle)
+    OTB_CONVERSION_PAIR(cu2ro, Cubochoric, Rodrigues)
+    OTB_CONVERSION_PAIR(cu2ho, Cubochoric, Homochoric)
+
+#undef OTB_CONVERSION_PAIR
+
+    /**
+     * @brief SinCos Computes the sine and cosine of n values using a Cody-Waite
+     * reduction by pi/2 and the minimax polynomials of the Cephes library. Accurate
+     * to a couple of ulp for |x| < 1.0E5 which covers every angle used by the
+     * conversions. The loop body only uses arithmetic and selects so it vectorizes.
+     * @param x Input angles in radians
+     * @param s Output sines
+     * @param c Output cosines
+     * @param n Number of values
+     */
+    static void SinCos(const double* x, double* s, double* c, size_t n)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        double q = std::floor(x[i] * 0.63661977236758134308 + 0.5);
+        double r = ((x[i] - q * 1.57079625129699707031) - q * 7.54978941586159635335E-8) - q * 5.39030285815811905290E-15;
+        double z = r * r;
+        double ps = r + r * z * (((((1.58962301576546568060E-10 * z - 2.50507477628578072866E-8) * z
+                                     + 2.75573136213857245213E-6) * z - 1.98412698295895385996E-4) * z
+                                  + 8.33333333332211858878E-3) * z - 1.66666666666666307295E-1);
+        double pc = 1.0 - 0.5 * z + z * z * (((((-1.13585365213876817300E-11 * z + 2.08757008419747316778E-9) * z
+                                                - 2.75573141792967388112E-7) * z + 2.48015872888517045348E-5) * z
+                                              - 1.38888888888730564116E-3) * z + 4.16666666666665929218E-2);
+        int iq = static_cast<int>(q);
+        double sv = (iq & 1) ? pc : ps;
+        double cv = (iq & 1) ? ps : pc;
+        double nsv = -sv;
+        double ncv = -cv;
+        s[i] = (iq & 2) ? nsv : sv;
+        c[i] = ((iq + 1) & 2) ? ncv : cv;
+      }
+    }
+
+    /**
+     * @brief Atan2 Computes atan2(y, x) for n values. The arguments are folded into
+     * the first octant and the Cephes rational approximation of atan is evaluated
+     * on [0, 1]. The output may not alias the inputs.
+     * @param y
+     * @param x
+     * @param r Output angles in [-pi, pi]
+     * @param n Number of values
+     */
+    static void Atan2(const double* y, const double* x, double* r, size_t n)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        double ax = std::fabs(x[i]);
+        double ay = std::fabs(y[i]);
+        double mx = ax > ay ? ax : ay;
+        double mn = ax > ay ? ay : ax;
+        double den = mx > 0.0 ? mx : 1.0;
+        double t = mn / den;
+        bool big = t > 0.66;
+        double tr = (t - 1.0) / (t + 1.0);
+        double xr = big ? tr : t;
+        double z = xr * xr;
+        double p = (((-8.750608600031904122785E-1 * z - 1.615753718733365076637E1) * z
+                     - 7.500855792314704667340E1) * z - 1.228866684490136173410E2) * z - 6.485021904942025371773E1;
+        double qq = ((((z + 2.485846490142306297962E1) * z + 1.650270098316988542046E2) * z
+                      + 4.328810604912902668951E2) * z + 4.853903996359136964868E2) * z + 1.945506571482613964425E2;
+        double a = xr * z * p / qq + xr;
+        double ab = a + (0.78539816339744830962 + 3.061616997868382943065E-17);
+        a = big ? ab : a;
+        double ac = 1.57079632679489661923 - a;
+        a = ay > ax ? ac : a;
+        double an = 3.14159265358979323846 - a;
+        a = x[i] < 0.0 ? an : a;
+        double na = -a;
+        r[i] = y[i] < 0.0 ? na : a;
+      }
+    }
+
+  protected:
+    OrientationTransformsBatch() {}
+
+  private:
+    typedef double Real;
+
+    enum
+    {
+      k_BlockSize = 256,
+      k_MaxPathLength = 4,
+      k_Planes = 9,
+      k_TempBlocks = 3
+    };
+
+    enum Step
+    {
+      NoStep = -1,
+      EU2OM, EU2QU, EU2AX, EU2RO_AX,
+      OM2EU, OM2QU,
+      QU2EU, QU2OM, QU2AX, QU2RO, QU2HO,
+      AX2OM, AX2QU, AX2RO, AX2HO,
+      RO2AX, RO2HO,
+      HO2AX, HO2CU, CU2HO
+    };
+
+    /**
+     * @brief GetPath Returns the chain of kernels that converts inRep to outRep. The
+     * chains are the same ones used by the composite functions in OrientationTransforms.
+     * An empty chain means the representations are the same.
+     */
+    static const int* GetPath(int inRep, int outRep)
+    {
+      static const int paths[7][7][k_MaxPathLength] =
+      {
+        // Euler
+        {
+          { NoStep, NoStep, NoStep, NoStep },
+          { EU2OM, NoStep, NoStep, NoStep },
+          { EU2QU, NoStep, NoStep, NoStep },
+          { EU2AX, NoStep, NoStep, NoStep },
+          { EU2AX, EU2RO_AX, NoStep, NoStep },
+          { EU2AX, AX2HO, NoStep, NoStep },
+          { EU2AX, AX2HO, HO2CU, NoStep }
+        },
+        // Orientation Matrix
+        {
+          { OM2EU, NoStep, NoStep, NoStep },
+          { NoStep, NoStep, NoStep, NoStep },
+          { OM2QU, NoStep, NoStep, NoStep },
+          { OM2QU, QU2AX, NoStep, NoStep },
+          { OM2EU, EU2AX, EU2RO_AX, NoStep },
+          { OM2QU, QU2AX, AX2HO, NoStep },
+          { OM2QU, QU2AX, AX2HO, HO2CU }
+        },
+        // Quaternion
+        {
+          { QU2EU, NoStep, NoStep, NoStep },
+          { QU2OM, NoStep, NoStep, NoStep },
+          { NoStep, NoStep, NoStep, NoStep },
+          { QU2AX, NoStep, NoStep, NoStep },
+          { QU2RO, NoStep, NoStep, NoStep },
+          { QU2HO, NoStep, NoStep, NoStep },
+          { QU2HO, HO2CU, NoStep, NoStep }
+        },
+        // Axis Angle
+        {
+          { AX2OM, OM2EU, NoStep, NoStep },
+          { AX2OM, NoStep, NoStep, NoStep },
+          { AX2QU, NoStep, NoStep, NoStep },
+          { NoStep, NoStep, NoStep, NoStep },
+          { AX2RO, NoStep, NoStep, NoStep },
+          { AX2HO, NoStep, NoStep, NoStep },
+          { AX2HO, HO2CU, NoStep, NoStep }
+        },
+        // Rodrigues
+        {
+          { RO2AX, AX2OM, OM2EU, NoStep },
+          { RO2AX, AX2OM, NoStep, NoStep },
+          { RO2AX, AX2QU, NoStep, NoStep },
+          { RO2AX, NoStep, NoStep, NoStep },
+          { NoStep, NoStep, NoStep, NoStep },
+          { RO2HO, NoStep, NoStep, NoStep },
+          { RO2HO, HO2CU, NoStep, NoStep }
+        },
+        // Homochoric
+        {
+          { HO2AX, AX2OM, OM2EU, NoStep },
+          { HO2AX, AX2OM, NoStep, NoStep },
+          { HO2AX, AX2QU, NoStep, NoStep },
+          { HO2AX, NoStep, NoStep, NoStep },
+          { HO2AX, AX2RO, NoStep, NoStep },
+          { NoStep, NoStep, NoStep, NoStep },
+          { HO2CU, NoStep, NoStep, NoStep }
+        },
+        // Cubochoric
+        {
+          { CU2HO, HO2AX, AX2OM, OM2EU },
+          { CU2HO, HO2AX, AX2OM, NoStep },
+          { CU2HO, HO2AX, AX2QU, NoStep },
+          { CU2HO, HO2AX, NoStep, NoStep },
+          { CU2HO, HO2AX, AX2RO, NoStep },
+          { CU2HO, NoStep, NoStep, NoStep },
+          { NoStep, NoStep, NoStep, NoStep }
+        }
+      };
+      return paths[inRep][outRep];
+    }
+
+    /**
+     * @brief The Block struct holds one block of orientations as structure of arrays,
+     * one plane per component. Kernels read and write whole Blocks so the compiler
+     * sees every plane as an offset from one base pointer.
+     */
+    typedef struct
+    {
+      Real v[k_Planes][k_BlockSize];
+    } Block;
+
+    /**
+     * @brief The BlockConverter class converts a range of orientations one block at
+     * a time. Each invocation owns its scratch blocks so ranges can run concurrently.
+     */
+    class BlockConverter
+    {
+      public:
+        BlockConverter(int inRep, const K* const* in, size_t inStride, int outRep, K* const* out, size_t outStride) :
+          m_InRep(inRep),
+          m_InStride(inStride),
+          m_OutRep(outRep),
+          m_OutStride(outStride)
+        {
+          for(int c = 0; c < k_Planes; c++)
+          {
+            m_In[c] = in[c];
+            m_Out[c] = out[c];
+          }
+        }
+        virtual ~BlockConverter() {}
+
+        void convert(size_t start, size_t end) const
+        {
+          // Two ping-pong blocks plus the temporary blocks used by the kernels
+          std::vector<Block> blocks(2 + k_TempBlocks);
+          Block* cur = &(blocks[0]);
+          Block* next = &(blocks[1]);
+          Block* tmp = &(blocks[2]);
+
+          const int* path = GetPath(m_InRep, m_OutRep);
+          int inComps = GetComponentCount(m_InRep);
+          int outComps = GetComponentCount(m_OutRep);
+
+          for(size_t b = start; b < end; b += k_BlockSize)
+          {
+            size_t n = (end - b < static_cast<size_t>(k_BlockSize)) ? (end - b) : static_cast<size_t>(k_BlockSize);
+            for(int c = 0; c < inComps; c++)
+            {
+              const K* src = m_In[c] + b * m_InStride;
+              Real* dst = cur->v[c];
+              for(size_t i = 0; i < n; i++) { dst[i] = static_cast<Real>(src[i * m_InStride]); }
+            }
+
+            for(int s = 0; s < k_MaxPathLength && path[s] != NoStep; s++)
+            {
+              RunStep(path[s], *cur, *next, n, tmp);
+              Block* swap = cur;
+              cur = next;
+              next = swap;
+            }
+
+            for(int c = 0; c < outComps; c++)
+            {
+              const Real* src = cur->v[c];
+              K* dst = m_Out[c] + b * m_OutStride;
+              for(size_t i = 0; i < n; i++) { dst[i * m_OutStride] = static_cast<K>(src[i]); }
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          convert(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        int m_InRep;
+        const K* m_In[k_Planes];
+        size_t m_InStride;
+        int m_OutRep;
+        K* m_Out[k_Planes];
+        size_t m_OutStride;
+    };
+
+    /**
+     * @brief Execute Runs the conversion over n orientations, in parallel if possible
+     */
+    static void Execute(int inRep, const K* const* in, size_t inStride, int outRep, K* const* out, size_t outStride, size_t n)
+    {
+      if(n == 0 || GetComponentCount(inRep) == 0 || GetComponentCount(outRep) == 0) { return; }
+
+      BlockConverter converter(inRep, in, inStride, outRep, out, outStride);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = (n > static_cast<size_t>(4 * k_BlockSize));
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n, 4 * k_BlockSize), converter, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        converter.convert(0, n);
+      }
+    }
+
+    /**
+     * @brief RunStep Dispatches one kernel of a conversion chain over a block
+     */
+    static void RunStep(int step, const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      switch(step)
+      {
+        case EU2OM: eu2omKernel(in, out, n, tmp); break;
+        case EU2QU: eu2quKernel(in, out, n, tmp); break;
+        case EU2AX: eu2axKernel(in, out, n, tmp); break;
+        case EU2RO_AX: ax2roKernel(in, out, n, tmp, static_cast<Real>(1.0E-6f)); break;
+        case OM2EU: om2euKernel(in, out, n, tmp); break;
+        case OM2QU: om2quKernel(in, out, n, tmp); break;
+        case QU2EU: qu2euKernel(in, out, n, tmp); break;
+        case QU2OM: qu2omKernel(in, out, n); break;
+        case QU2AX: qu2axKernel(in, out, n, tmp); break;
+        case QU2RO: qu2roKernel(in, out, n); break;
+        case QU2HO: qu2hoKernel(in, out, n, tmp); break;
+        case AX2OM: ax2omKernel(in, out, n, tmp); break;
+        case AX2QU: ax2quKernel(in, out, n, tmp); break;
+        case AX2RO: ax2roKernel(in, out, n, tmp, static_cast<Real>(1.0E-7f)); break;
+        case AX2HO: ax2hoKernel(in, out, n, tmp); break;
+        case RO2AX: ro2axKernel(in, out, n, tmp); break;
+        case RO2HO: ro2hoKernel(in, out, n, tmp); break;
+        case HO2AX: ho2axKernel(in, out, n, tmp); break;
+        case HO2CU: ho2cuKernel(in, out, n); break;
+        case CU2HO: cu2hoKernel(in, out, n); break;
+        default: break;
+      }
+    }
+
+    /**
+     * @brief Acos acos(x) = atan2(sqrt(1 - x^2), x). Uses one plane of scratch.
+     */
+    static void Acos(const Real* x, Real* r, size_t n, Real* scratch)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        Real s = (1.0 - x[i]) * (1.0 + x[i]);
+        scratch[i] = std::sqrt(s > 0.0 ? s : 0.0);
+      }
+      Atan2(scratch, x, r, n);
+    }
+
+    /**
+     * @brief Atan atan(x) = atan2(x, 1). Uses one plane of scratch.
+     */
+    static void Atan(const Real* x, Real* r, size_t n, Real* scratch)
+    {
+      for(size_t i = 0; i < n; i++) { scratch[i] = 1.0; }
+      Atan2(x, scratch, r, n);
+    }
+
+    /**
+     * @brief Cbrt Applies pow(x, 1/3) in place. This is the only libm call left in
+     * the kernels so it runs as its own loop.
+     */
+    static void Cbrt(Real* values, size_t n)
+    {
+      for(size_t i = 0; i < n; i++) { values[i] = std::pow(values[i], 1.0 / 3.0); }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Kernels. Each one mirrors the scalar routine of the same name in
+    // OrientationTransforms, including its thresholds and special cases. The
+    // transcendental functions run as separate loops over whole planes and the
+    // branches of the scalar code are written as selects between values that are
+    // always computed, because a floating point operation inside a conditional
+    // can not be if-converted by the compiler and would keep the loop scalar.
+    // Temporary planes come from tmp[0]; om2qu also uses tmp[1] and tmp[2].
+    // -----------------------------------------------------------------------------
+    static void eu2omKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real eps = static_cast<Real>(1.0E-7f);
+      Block& t = tmp[0];
+      SinCos(in.v[0], t.v[0], t.v[1], n);
+      SinCos(in.v[1], t.v[2], t.v[3], n);
+      SinCos(in.v[2], t.v[4], t.v[5], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real s1 = t.v[0][i], c1 = t.v[1][i];
+        Real s = t.v[2][i], c = t.v[3][i];
+        Real s2 = t.v[4][i], c2 = t.v[5][i];
+        Real om[9];
+        om[0] = c1 * c2 - s1 * s2 * c;
+        om[1] = s1 * c2 + c1 * s2 * c;
+        om[2] = s2 * s;
+        om[3] = -c1 * s2 - s1 * c2 * c;
+        om[4] = -s1 * s2 + c1 * c2 * c;
+        om[5] = c2 * s;
+        om[6] = s1 * s;
+        om[7] = -c1 * s;
+        om[8] = c;
+        for(int j = 0; j < 9; j++)
+        {
+          out.v[j][i] = std::fabs(om[j]) < eps ? 0.0 : om[j];
+        }
+      }
+    }
+
+    static void eu2quKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real epsijk = RConst::epsijk;
+      Block& t = tmp[0];
+      for(size_t i = 0; i < n; i++)
+      {
+        Real e0 = 0.5 * in.v[0][i];
+        Real e2 = 0.5 * in.v[2][i];
+        t.v[6][i] = 0.5 * in.v[1][i];
+        t.v[7][i] = e0 - e2;
+        t.v[8][i] = e0 + e2;
+      }
+      SinCos(t.v[6], t.v[0], t.v[1], n);
+      SinCos(t.v[7], t.v[2], t.v[3], n);
+      SinCos(t.v[8], t.v[4], t.v[5], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real sPhi = t.v[0][i], cPhi = t.v[1][i];
+        Real sm = t.v[2][i], cm = t.v[3][i];
+        Real sp = t.v[4][i], cp = t.v[5][i];
+        Real w = cPhi * cp;
+        Real sign = w < 0.0 ? -1.0 : 1.0;
+        out.v[0][i] = sign * -epsijk * sPhi * cm;
+        out.v[1][i] = sign * -epsijk * sPhi * sm;
+        out.v[2][i] = sign * -epsijk * cPhi * sp;
+        out.v[3][i] = sign * w;
+      }
+    }
+
+    static void eu2axKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real thr = static_cast<Real>(1.0E-6f);
+      const Real epsijkd = RConst::epsijkd;
+      Block& t = tmp[0];
+      for(size_t i = 0; i < n; i++)
+      {
+        t.v[6][i] = in.v[1][i] * 0.5;
+        t.v[7][i] = 0.5 * (in.v[0][i] + in.v[2][i]);
+        t.v[8][i] = 0.5 * (in.v[0][i] - in.v[2][i]);
+      }
+      SinCos(t.v[6], t.v[0], t.v[1], n);
+      SinCos(t.v[7], t.v[2], t.v[3], n);
+      SinCos(t.v[8], t.v[4], t.v[5], n);
+      // t = tan(Phi/2) goes to plane 1, tau to plane 8 and tau/cos(sigma) to plane 6
+      for(size_t i = 0; i < n; i++)
+      {
+        Real tp = t.v[0][i] / t.v[1][i];
+        Real ss = t.v[2][i];
+        Real tau = std::sqrt(tp * tp + ss * ss);
+        t.v[6][i] = tau / t.v[3][i];
+        t.v[1][i] = tp;
+        t.v[8][i] = tau;
+      }
+      Atan(t.v[6], t.v[0], n, t.v[3]);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real tp = t.v[1][i];
+        Real ss = t.v[2][i];
+        Real sd = t.v[4][i];
+        Real cd = t.v[5][i];
+        Real tau = t.v[8][i];
+        Real alpha = 2.0 * t.v[0][i];
+        alpha = std::fabs(t.v[7][i] - DConst::k_PiOver2) < 1.0E-6 ? DConst::k_Pi : alpha;
+        bool identity = std::fabs(alpha) < thr;
+        Real sign = alpha < 0.0 ? -1.0 : 1.0;
+        Real a0 = sign * -epsijkd * tp * cd / tau;
+        Real a1 = sign * -epsijkd * tp * sd / tau;
+        Real a2 = sign * -epsijkd * ss / tau;
+        Real a3 = sign * alpha;
+        out.v[0][i] = identity ? 0.0 : a0;
+        out.v[1][i] = identity ? 0.0 : a1;
+        out.v[2][i] = identity ? 1.0 : a2;
+        out.v[3][i] = identity ? 0.0 : a3;
+      }
+    }
+
+    static void om2euKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      Block& t = tmp[0];
+      for(size_t i = 0; i < n; i++)
+      {
+        Real o8 = in.v[8][i];
+        bool close = std::fabs(std::fabs(o8) - 1.0) < 1.0E-6;
+        bool closePos = std::fabs(o8 - 1.0) < 1.0E-6;
+        Real no1 = -in.v[1][i];
+        Real no7 = -in.v[7][i];
+        Real y1 = closePos ? in.v[1][i] : no1;
+        t.v[0][i] = close ? y1 : in.v[6][i];
+        t.v[1][i] = close ? in.v[0][i] : no7;
+        t.v[2][i] = close ? 0.0 : in.v[2][i];
+        t.v[3][i] = close ? 1.0 : in.v[5][i];
+      }
+      Atan2(t.v[0], t.v[1], t.v[4], n);
+      Atan2(t.v[2], t.v[3], t.v[5], n);
+      Acos(in.v[8], t.v[6], n, t.v[7]);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real o8 = in.v[8][i];
+        bool close = std::fabs(std::fabs(o8) - 1.0) < 1.0E-6;
+        bool closePos = std::fabs(o8 - 1.0) < 1.0E-6;
+        bool closeNeg = close && !closePos;
+        Real phi1 = t.v[4][i];
+        Real nphi1 = -phi1;
+        phi1 = closeNeg ? nphi1 : phi1;
+        Real PhiClose = closePos ? 0.0 : DConst::k_Pi;
+        Real Phi = close ? PhiClose : t.v[6][i];
+        Real phi2 = t.v[5][i];
+
+        Real wphi1 = phi1 + DConst::k_2Pi;
+        Real wPhi = Phi + DConst::k_Pi;
+        Real wphi2 = phi2 + DConst::k_2Pi;
+        out.v[0][i] = phi1 < 0.0 ? wphi1 : phi1;
+        out.v[1][i] = Phi < 0.0 ? wPhi : Phi;
+        out.v[2][i] = phi2 < 0.0 ? wphi2 : phi2;
+      }
+    }
+
+    static void om2quKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real thr = (sizeof(K) == 4) ? 1.0E-6 : 1.0E-10;
+      const Real epsijk = RConst::epsijk;
+
+      // The scalar routine fixes the signs of the vector part against om2eu -> eu2ax
+      Block& eu = tmp[1];
+      Block& ax = tmp[2];
+      om2euKernel(in, eu, n, tmp);
+      eu2axKernel(eu, ax, n, tmp);
+
+      for(size_t i = 0; i < n; i++)
+      {
+        Real o0 = in.v[0][i];
+        Real o4 = in.v[4][i];
+        Real o8 = in.v[8][i];
+        Real s = o0 + o4 + o8 + 1.0;
+        Real s1 = o0 - o4 - o8 + 1.0;
+        Real s2 = -o0 + o4 - o8 + 1.0;
+        Real s3 = -o0 - o4 + o8 + 1.0;
+        s = std::fabs(s) < thr ? 0.0 : s;
+        s1 = std::fabs(s1) < thr ? 0.0 : s1;
+        s2 = std::fabs(s2) < thr ? 0.0 : s2;
+        s3 = std::fabs(s3) < thr ? 0.0 : s3;
+        Real w = std::sqrt(s) * 0.5;
+        Real x = std::sqrt(s1) * 0.5;
+        Real y = std::sqrt(s2) * 0.5;
+        Real z = std::sqrt(s3) * 0.5;
+        Real fx = -epsijk * x;
+        Real fy = -epsijk * y;
+        Real fz = -epsijk * z;
+        x = in.v[7][i] < in.v[5][i] ? fx : x;
+        y = in.v[2][i] < in.v[6][i] ? fy : y;
+        z = in.v[3][i] < in.v[1][i] ? fz : z;
+        Real mag = std::sqrt(x * x + y * y + z * z + w * w);
+        Real den = mag != 0.0 ? mag : 1.0;
+        x = x / den;
+        y = y / den;
+        z = z / den;
+        w = w / den;
+        Real nx = -x;
+        Real ny = -y;
+        Real nz = -z;
+        out.v[0][i] = ax.v[0][i] * x < 0.0 ? nx : x;
+        out.v[1][i] = ax.v[1][i] * y < 0.0 ? ny : y;
+        out.v[2][i] = ax.v[2][i] * z < 0.0 ? nz : z;
+        out.v[3][i] = w;
+      }
+    }
+
+    static void qu2euKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real e = RConst::epsijk;
+      Block& t = tmp[0];
+      for(size_t i = 0; i < n; i++)
+      {
+        Real x = in.v[0][i];
+        Real y = in.v[1][i];
+        Real z = in.v[2][i];
+        Real w = in.v[3][i];
+        Real q03 = w * w + z * z;
+        Real q12 = x * x + y * y;
+        Real chi = std::sqrt(q03 * q12);
+        bool degenerate = (chi == 0.0);
+        bool noVector = (q12 == 0.0);
+        // Degenerate cases: Phi is 0 or Pi and phi2 is arbitrarily set to 0
+        Real dy1 = noVector ? -e * 2.0 * w * z : 2.0 * x * y;
+        Real dx1 = noVector ? w * w - z * z : x * x - y * y;
+        t.v[0][i] = degenerate ? dy1 : (-e * w * y + x * z);
+        t.v[1][i] = degenerate ? dx1 : (-e * w * x - y * z);
+        t.v[2][i] = degenerate ? 0.0 : (e * w * y + x * z);
+        t.v[3][i] = degenerate ? 1.0 : (-e * w * x + y * z);
+        t.v[4][i] = 2.0 * chi;
+        t.v[5][i] = q03 - q12;
+      }
+      Atan2(t.v[0], t.v[1], t.v[6], n);
+      Atan2(t.v[2], t.v[3], t.v[7], n);
+      Atan2(t.v[4], t.v[5], t.v[8], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        bool degenerate = (t.v[4][i] == 0.0);
+        bool noVector = (in.v[0][i] * in.v[0][i] + in.v[1][i] * in.v[1][i] == 0.0);
+        Real dPhi = noVector ? 0.0 : DConst::k_Pi;
+        Real phi1 = t.v[6][i];
+        Real Phi = degenerate ? dPhi : t.v[8][i];
+        Real phi2 = t.v[7][i];
+
+        Real wphi1 = phi1 + DConst::k_2Pi;
+        Real wPhi = Phi + DConst::k_Pi;
+        Real wphi2 = phi2 + DConst::k_2Pi;
+        out.v[0][i] = phi1 < 0.0 ? wphi1 : phi1;
+        out.v[1][i] = Phi < 0.0 ? wPhi : Phi;
+        out.v[2][i] = phi2 < 0.0 ? wphi2 : phi2;
+      }
+    }
+
+    static void qu2omKernel(const Block& in, Block& out, size_t n)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        Real x = in.v[0][i];
+        Real y = in.v[1][i];
+        Real z = in.v[2][i];
+        Real w = in.v[3][i];
+        Real qq = w * w - (x * x + y * y + z * z);
+        out.v[0][i] = qq + 2.0 * x * x;
+        out.v[4][i] = qq + 2.0 * y * y;
+        out.v[8][i] = qq + 2.0 * z * z;
+        out.v[1][i] = 2.0 * (x * y - w * z);
+        out.v[5][i] = 2.0 * (y * z - w * x);
+        out.v[6][i] = 2.0 * (z * x - w * y);
+        out.v[3][i] = 2.0 * (y * x + w * z);
+        out.v[7][i] = 2.0 * (z * y + w * x);
+        out.v[2][i] = 2.0 * (x * z + w * y);
+      }
+    }
+
+    static void qu2axKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real epsijk = RConst::epsijkd;
+      const Real eps = static_cast<Real>(static_cast<K>(1.0e-12L));
+      Block& t = tmp[0];
+      // make sure q[0] is >= 0.0
+      for(size_t i = 0; i < n; i++) { t.v[0][i] = std::fabs(in.v[3][i]); }
+      Acos(t.v[0], t.v[1], n, t.v[2]);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real x = in.v[0][i];
+        Real y = in.v[1][i];
+        Real z = in.v[2][i];
+        Real omega = 2.0 * t.v[1][i];
+        bool identity = omega < eps;
+        Real mag = std::sqrt(x * x + y * y + z * z);
+        Real den = identity ? 1.0 : mag;
+        Real ax0 = x / den;
+        Real ax1 = y / den;
+        Real ax2 = z / den;
+        out.v[0][i] = identity ? 0.0 : ax0;
+        out.v[1][i] = identity ? 0.0 : ax1;
+        out.v[2][i] = identity ? epsijk : ax2;
+        out.v[3][i] = identity ? 0.0 : omega;
+      }
+    }
+
+    static void qu2roKernel(const Block& in, Block& out, size_t n)
+    {
+      const Real thr = static_cast<Real>(static_cast<K>(1.0E-8L));
+      const Real inf = std::numeric_limits<Real>::infinity();
+      for(size_t i = 0; i < n; i++)
+      {
+        Real x = in.v[0][i];
+        Real y = in.v[1][i];
+        Real z = in.v[2][i];
+        Real w = in.v[3][i];
+        // A rotation of Pi keeps the (unnormalized) vector part and an infinite length
+        bool atPi = w < thr;
+        Real s = std::sqrt(x * x + y * y + z * z);
+        bool identity = !atPi && s < thr;
+        Real den = (atPi || identity) ? 1.0 : s;
+        Real r0 = x / den;
+        Real r1 = y / den;
+        Real r2 = z / den;
+        // tan(acos(w)) for w > 0
+        Real sw = (1.0 - w) * (1.0 + w);
+        sw = sw > 0.0 ? sw : 0.0;
+        Real tn = std::sqrt(sw) / w;
+        tn = atPi ? inf : tn;
+        out.v[0][i] = identity ? 0.0 : r0;
+        out.v[1][i] = identity ? 0.0 : r1;
+        out.v[2][i] = identity ? 0.0 : r2;
+        out.v[3][i] = identity ? 0.0 : tn;
+      }
+    }
+
+    static void qu2hoKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      Block& t = tmp[0];
+      Acos(in.v[3], t.v[0], n, t.v[1]);
+      for(size_t i = 0; i < n; i++) { t.v[0][i] = 2.0 * t.v[0][i]; }
+      SinCos(t.v[0], t.v[1], t.v[2], n);
+      for(size_t i = 0; i < n; i++) { t.v[3][i] = 0.75 * (t.v[0][i] - t.v[1][i]); }
+      Cbrt(t.v[3], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real x = in.v[0][i];
+        Real y = in.v[1][i];
+        Real z = in.v[2][i];
+        bool identity = (t.v[0][i] == 0.0);
+        Real mag = std::sqrt(x * x + y * y + z * z);
+        Real den = identity ? 1.0 : mag;
+        Real s = t.v[3][i] / den;
+        s = identity ? 0.0 : s;
+        out.v[0][i] = x * s;
+        out.v[1][i] = y * s;
+        out.v[2][i] = z * s;
+      }
+    }
+
+    static void ax2omKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      int _01 = 1, _10 = 3, _12 = 5, _21 = 7, _02 = 2, _20 = 6;
+      // Check to see if we need to transpose
+      if (Rotations::Constants::epsijk == 1.0L)
+      {
+        _01 = 3;
+        _10 = 1;
+        _12 = 7;
+        _21 = 5;
+        _02 = 6;
+        _20 = 2;
+      }
+      Block& t = tmp[0];
+      SinCos(in.v[3], t.v[0], t.v[1], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real a0 = in.v[0][i];
+        Real a1 = in.v[1][i];
+        Real a2 = in.v[2][i];
+        Real s = t.v[0][i];
+        Real c = t.v[1][i];
+        Real omc = 1.0 - c;
+        out.v[0][i] = a0 * a0 * omc + c;
+        out.v[4][i] = a1 * a1 * omc + c;
+        out.v[8][i] = a2 * a2 * omc + c;
+        Real q = omc * a0 * a1;
+        out.v[_01][i] = q + s * a2;
+        out.v[_10][i] = q - s * a2;
+        q = omc * a1 * a2;
+        out.v[_12][i] = q + s * a0;
+        out.v[_21][i] = q - s * a0;
+        q = omc * a2 * a0;
+        out.v[_02][i] = q - s * a1;
+        out.v[_20][i] = q + s * a1;
+      }
+    }
+
+    static void ax2quKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      Block& t = tmp[0];
+      for(size_t i = 0; i < n; i++) { t.v[2][i] = in.v[3][i] * 0.5; }
+      SinCos(t.v[2], t.v[0], t.v[1], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        bool identity = (in.v[3][i] == 0.0);
+        Real s = t.v[0][i];
+        Real x = in.v[0][i] * s;
+        Real y = in.v[1][i] * s;
+        Real z = in.v[2][i] * s;
+        out.v[0][i] = identity ? 0.0 : x;
+        out.v[1][i] = identity ? 0.0 : y;
+        out.v[2][i] = identity ? 0.0 : z;
+        out.v[3][i] = identity ? 1.0 : t.v[1][i];
+      }
+    }
+
+    static void ax2roKernel(const Block& in, Block& out, size_t n, Block* tmp, Real thr)
+    {
+      const Real inf = std::numeric_limits<Real>::infinity();
+      Block& t = tmp[0];
+      for(size_t i = 0; i < n; i++) { t.v[2][i] = in.v[3][i] * 0.5; }
+      SinCos(t.v[2], t.v[0], t.v[1], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real a3 = in.v[3][i];
+        bool identity = (a3 == 0.0);
+        bool atPi = std::fabs(a3 - DConst::k_Pi) < thr;
+        Real tn = t.v[0][i] / t.v[1][i];
+        tn = atPi ? inf : tn;
+        out.v[0][i] = identity ? 0.0 : in.v[0][i];
+        out.v[1][i] = identity ? 0.0 : in.v[1][i];
+        out.v[2][i] = identity ? 0.0 : in.v[2][i];
+        out.v[3][i] = identity ? 0.0 : tn;
+      }
+    }
+
+    static void ax2hoKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      Block& t = tmp[0];
+      SinCos(in.v[3], t.v[0], t.v[1], n);
+      for(size_t i = 0; i < n; i++) { t.v[2][i] = 0.75 * (in.v[3][i] - t.v[0][i]); }
+      Cbrt(t.v[2], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real f = t.v[2][i];
+        out.v[0][i] = in.v[0][i] * f;
+        out.v[1][i] = in.v[1][i] * f;
+        out.v[2][i] = in.v[2][i] * f;
+      }
+    }
+
+    static void ro2axKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real inf = std::numeric_limits<Real>::infinity();
+      Block& t = tmp[0];
+      Atan(in.v[3], t.v[0], n, t.v[1]);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real r0 = in.v[0][i];
+        Real r1 = in.v[1][i];
+        Real r2 = in.v[2][i];
+        Real ta = in.v[3][i];
+        bool identity = (ta == 0.0);
+        bool atPi = (ta == inf);
+        Real angle = 2.0 * t.v[0][i];
+        angle = atPi ? DConst::k_Pi : angle;
+        Real mag = std::sqrt(r0 * r0 + r1 * r1 + r2 * r2);
+        Real den = (atPi || identity) ? 1.0 : mag;
+        Real a0 = r0 / den;
+        Real a1 = r1 / den;
+        Real a2 = r2 / den;
+        out.v[0][i] = identity ? 0.0 : a0;
+        out.v[1][i] = identity ? 0.0 : a1;
+        out.v[2][i] = identity ? 1.0 : a2;
+        out.v[3][i] = identity ? 0.0 : angle;
+      }
+    }
+
+    static void ro2hoKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real inf = std::numeric_limits<Real>::infinity();
+      Block& t = tmp[0];
+      Atan(in.v[3], t.v[0], n, t.v[1]);
+      for(size_t i = 0; i < n; i++) { t.v[0][i] = 2.0 * t.v[0][i]; }
+      SinCos(t.v[0], t.v[1], t.v[2], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real f = 0.75 * (t.v[0][i] - t.v[1][i]);
+        t.v[3][i] = (in.v[3][i] == inf) ? 0.75 * DConst::k_Pi : f;
+      }
+      Cbrt(t.v[3], n);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real r0 = in.v[0][i];
+        Real r1 = in.v[1][i];
+        Real r2 = in.v[2][i];
+        bool identity = (r0 == 0.0 && r1 == 0.0 && r2 == 0.0 && in.v[3][i] == 0.0);
+        Real f = identity ? 0.0 : t.v[3][i];
+        out.v[0][i] = r0 * f;
+        out.v[1][i] = r1 * f;
+        out.v[2][i] = r2 * f;
+      }
+    }
+
+    static void ho2axKernel(const Block& in, Block& out, size_t n, Block* tmp)
+    {
+      const Real thr = static_cast<Real>(1.0E-8f);
+      Block& t = tmp[0];
+      for(size_t i = 0; i < n; i++)
+      {
+        Real h0 = in.v[0][i];
+        Real h1 = in.v[1][i];
+        Real h2 = in.v[2][i];
+        Real hmag = h0 * h0 + h1 * h1 + h2 * h2;
+        Real hm = hmag;
+        Real s = LPs::tfit[0] + LPs::tfit[1] * hmag;
+        for(int j = 2; j < 16; j++)
+        {
+          hm = hm * hmag;
+          s = s + LPs::tfit[j] * hm;
+        }
+        t.v[0][i] = s;
+      }
+      Acos(t.v[0], t.v[1], n, t.v[2]);
+      for(size_t i = 0; i < n; i++)
+      {
+        Real h0 = in.v[0][i];
+        Real h1 = in.v[1][i];
+        Real h2 = in.v[2][i];
+        Real hmag = h0 * h0 + h1 * h1 + h2 * h2;
+        bool identity = (hmag == 0.0);
+        Real den = identity ? 1.0 : std::sqrt(hmag);
+        Real s = 2.0 * t.v[1][i];
+        s = std::fabs(s - DConst::k_Pi) < thr ? DConst::k_Pi : s;
+        Real a0 = h0 / den;
+        Real a1 = h1 / den;
+        Real a2 = h2 / den;
+        out.v[0][i] = identity ? 0.0 : a0;
+        out.v[1][i] = identity ? 0.0 : a1;
+        out.v[2][i] = identity ? 1.0 : a2;
+        out.v[3][i] = identity ? 0.0 : s;
+      }
+    }
+
+    // The Lambert cube <-> ball mappings depend on the pyramid and stay scalar
+    static void ho2cuKernel(const Block& in, Block& out, size_t n)
+    {
+      typedef OrientationArray<Real> ArrayType;
+      ArrayType ho(3);
+      ArrayType cu(3);
+      for(size_t i = 0; i < n; i++)
+      {
+        for(int c = 0; c < 3; c++) { ho[c] = in.v[c][i]; }
+        OrientationTransforms<ArrayType, Real>::ho2cu(ho, cu);
+        for(int c = 0; c < 3; c++) { out.v[c][i] = cu[c]; }
+      }
+    }
+
+    static void cu2hoKernel(const Block& in, Block& out, size_t n)
+    {
+      typedef OrientationArray<Real> ArrayType;
+      ArrayType cu(3);
+      ArrayType ho(3);
+      for(size_t i = 0; i < n; i++)
+      {
+        for(int c = 0; c < 3; c++) { cu[c] = in.v[c][i]; }
+        OrientationTransforms<ArrayType, Real>::cu2ho(cu, ho);
+        for(int c = 0; c < 3; c++) { out.v[c][i] = ho[c]; }
+      }
+    }
+
+    OrientationTransformsBatch(const OrientationTransformsBatch&); // Copy Constructor Not Implemented
+    void operator=(const OrientationTransformsBatch&); // Operator '=' Not Implemented
+};
+
+#endif /* _OrientationTransformsBatch_H_ */
@@ -151,10 +151,6 @@ class OrientationLib_EXPORT CubicLowOps : public SpaceGroupOps
     virtual QVector<UInt8ArrayType::Pointer> generatePoleFigure(PoleFigureConfiguration_t& config);
 
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[24], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
   private:
     CubicLowOps(const CubicLowOps&); // Copy Constructor Not Implemented
     void operator=(const CubicLowOps&); // Operator '=' Not Implemented
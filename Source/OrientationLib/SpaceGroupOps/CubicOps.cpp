@@ -52,6 +52,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 
 namespace Detail
@@ -72,34 +73,6 @@ namespace Detail
 }
 
 
-static const QuatF CubicQuatSym[24] =
-{
-  QuaternionMathF::New(0.000000000f, 0.000000000f, 0.000000000f, 1.000000000f),
-  QuaternionMathF::New(1.000000000f, 0.000000000f, 0.000000000f, 0.000000000f),
-  QuaternionMathF::New(0.000000000f, 1.000000000f, 0.000000000f, 0.000000000f),
-  QuaternionMathF::New(0.000000000f, 0.000000000f, 1.000000000f, 0.000000000f),
-  QuaternionMathF::New(SIMPLib::Constants::k_1OverRoot2, 0.000000000f, 0.000000000f, SIMPLib::Constants::k_1OverRoot2),
-  QuaternionMathF::New(0.000000000f, SIMPLib::Constants::k_1OverRoot2, 0.000000000f, SIMPLib::Constants::k_1OverRoot2),
-  QuaternionMathF::New(0.000000000f, 0.000000000f, SIMPLib::Constants::k_1OverRoot2, SIMPLib::Constants::k_1OverRoot2),
-  QuaternionMathF::New(-SIMPLib::Constants::k_1OverRoot2, 0.000000000f, 0.000000000f, SIMPLib::Constants::k_1OverRoot2),
-  QuaternionMathF::New(0.000000000f, -SIMPLib::Constants::k_1OverRoot2, 0.000000000f, SIMPLib::Constants::k_1OverRoot2),
-  QuaternionMathF::New(0.000000000f, 0.000000000f, -SIMPLib::Constants::k_1OverRoot2, SIMPLib::Constants::k_1OverRoot2),
-  QuaternionMathF::New(SIMPLib::Constants::k_1OverRoot2, SIMPLib::Constants::k_1OverRoot2, 0.000000000f, 0.000000000f),
-  QuaternionMathF::New(-SIMPLib::Constants::k_1OverRoot2, SIMPLib::Constants::k_1OverRoot2, 0.000000000f, 0.000000000f),
-  QuaternionMathF::New(0.000000000f, SIMPLib::Constants::k_1OverRoot2, SIMPLib::Constants::k_1OverRoot2, 0.000000000f),
-  QuaternionMathF::New(0.000000000f, -SIMPLib::Constants::k_1OverRoot2, SIMPLib::Constants::k_1OverRoot2, 0.000000000f),
-  QuaternionMathF::New(SIMPLib::Constants::k_1OverRoot2, 0.000000000f, SIMPLib::Constants::k_1OverRoot2, 0.000000000f),
-  QuaternionMathF::New(-SIMPLib::Constants::k_1OverRoot2, 0.000000000f, SIMPLib::Constants::k_1OverRoot2, 0.000000000f),
-  QuaternionMathF::New(0.500000000f, 0.500000000f, 0.500000000f, 0.500000000f),
-  QuaternionMathF::New(-0.500000000f, -0.500000000f, -0.500000000f, 0.500000000f),
-  QuaternionMathF::New(0.500000000f, -0.500000000f, 0.500000000f, 0.500000000f),
-  QuaternionMathF::New(-0.500000000f, 0.500000000f, -0.500000000f, 0.500000000f),
-  QuaternionMathF::New(-0.500000000f, 0.500000000f, 0.500000000f, 0.500000000f),
-  QuaternionMathF::New(0.500000000f, -0.500000000f, -0.500000000f, 0.500000000f),
-  QuaternionMathF::New(-0.500000000f, -0.500000000f, 0.500000000f, 0.500000000f),
-  QuaternionMathF::New(0.500000000f, 0.500000000f, -0.500000000f, 0.500000000f)
-};
-
 static const float CubicRodSym[24][3] = {{0.0f, 0.0f, 0.0f},
   {10000000000.0f, 0.0f, 0.0f},
   {0.0f, 10000000000.0f, 0.0f},
@@ -298,271 +271,12 @@ CubicOps::~CubicOps()
 // -----------------------------------------------------------------------------
 float CubicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-  int numsym = 24;
-  return _calcMisoQuat(CubicQuatSym, numsym, q1, q2, n1, n2, n3);
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float CubicOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
-                              QuatF& q1, QuatF& q2,
-                              float& n1, float& n2, float& n3)
-{
-  float wmin = 9999999.0f; //,na,nb,nc;
-  QuatF qco;
-  QuatF qc;
-  QuatF q2inv;
-  int type = 1;
-  float sin_wmin_over_2 = 0.0;
-
-  QuaternionMathF::Conjugate(q2, q2inv); // Computes the Conjugate of q2 and places the result in q2inv
-  QuaternionMathF::Multiply(q1, q2inv, qc);
-  QuaternionMathF::ElementWiseAbs(qc);
-
-  //if qc.x is smallest
-  if ( qc.x <= qc.y && qc.x <= qc.z && qc.x <= qc.w)
-  {
-    qco.x = qc.x;
-    //if qc.y is next smallest
-    if (qc.y <= qc.z && qc.y <= qc.w)
-    {
-      qco.y = qc.y;
-      if(qc.z <= qc.w)
-      {
-        qco.z = qc.z, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.z;
-      }
-    }
-    //if qc.z is next smallest
-    else if (qc.z <= qc.y && qc.z <= qc.w)
-    {
-      qco.y = qc.z;
-      if(qc.y <= qc.w)
-      {
-        qco.z = qc.y, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.y;
-      }
-    }
-    //if qc.w is next smallest
-    else
-    {
-      qco.y = qc.w;
-      if(qc.y <= qc.z)
-      {
-        qco.z = qc.y, qco.w = qc.z;
-      }
-      else
-      {
-        qco.z = qc.z, qco.w = qc.y;
-      }
-    }
-  }
-  //if qc.y is smallest
-  else if ( qc.y <= qc.x && qc.y <= qc.z && qc.y <= qc.w)
-  {
-    qco.x = qc.y;
-    //if qc.x is next smallest
-    if (qc.x <= qc.z && qc.x <= qc.w)
-    {
-      qco.y = qc.x;
-      if(qc.z <= qc.w)
-      {
-        qco.z = qc.z, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.z;
-      }
-    }
-    //if qc.z is next smallest
-    else if (qc.z <= qc.x && qc.z <= qc.w)
-    {
-      qco.y = qc.z;
-      if(qc.x <= qc.w)
-      {
-        qco.z = qc.x, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.x;
-      }
-    }
-    //if qc.w is next smallest
-    else
-    {
-      qco.y = qc.w;
-      if(qc.x <= qc.z)
-      {
-        qco.z = qc.x, qco.w = qc.z;
-      }
-      else
-      {
-        qco.z = qc.z, qco.w = qc.x;
-      }
-    }
-  }
-  //if qc.z is smallest
-  else if ( qc.z <= qc.x && qc.z <= qc.y && qc.z <= qc.w)
-  {
-    qco.x = qc.z;
-    //if qc.x is next smallest
-    if (qc.x <= qc.y && qc.x <= qc.w)
-    {
-      qco.y = qc.x;
-      if(qc.y <= qc.w)
-      {
-        qco.z = qc.y, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.y;
-      }
-    }
-    //if qc.y is next smallest
-    else if (qc.y <= qc.x && qc.y <= qc.w)
-    {
-      qco.y = qc.y;
-      if(qc.x <= qc.w)
-      {
-        qco.z = qc.x, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.x;
-      }
-    }
-    //if qc.w is next smallest
-    else
-    {
-      qco.y = qc.w;
-      if(qc.x <= qc.y)
-      {
-        qco.z = qc.x, qco.w = qc.y;
-      }
-      else
-      {
-        qco.z = qc.y, qco.w = qc.x;
-      }
-    }
-  }
-  //if qc.w is smallest
-  else
-  {
-    qco.x = qc.w;
-    //if qc.x is next smallest
-    if (qc.x <= qc.y && qc.x <= qc.z)
-    {
-      qco.y = qc.x;
-      if(qc.y <= qc.z)
-      {
-        qco.z = qc.y, qco.w = qc.z;
-      }
-      else
-      {
-        qco.z = qc.z, qco.w = qc.y;
-      }
-    }
-    //if qc.y is next smallest
-    else if (qc.y <= qc.x && qc.y <= qc.z)
-    {
-      qco.y = qc.y;
-      if(qc.x <= qc.z)
-      {
-        qco.z = qc.x, qco.w = qc.z;
-      }
-      else
-      {
-        qco.z = qc.z, qco.w = qc.x;
-      }
-    }
-    //if qc.z is next smallest
-    else
-    {
-      qco.y = qc.z;
-      if(qc.x <= qc.y)
-      {
-        qco.z = qc.x, qco.w = qc.y;
-      }
-      else
-      {
-        qco.z = qc.y, qco.w = qc.x;
-      }
-    }
-  }
-  wmin = qco.w;
-  if (((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2)) > wmin)
-  {
-    wmin = ((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2));
-    type = 2;
-  }
-  if (((qco.x + qco.y + qco.z + qco.w) / 2) > wmin)
-  {
-    wmin = ((qco.x + qco.y + qco.z + qco.w) / 2);
-    type = 3;
-  }
-  if (wmin < -1.0)
-  {
-    //  wmin = -1.0;
-    wmin = SIMPLib::Constants::k_ACosNeg1;
-    sin_wmin_over_2 = sinf(wmin);
-  }
-  else if (wmin > 1.0)
-  {
-    //   wmin = 1.0;
-    wmin = SIMPLib::Constants::k_ACos1;
-    sin_wmin_over_2 = sinf(wmin);
-  }
-  else
-  {
-    wmin = acos(wmin);
-    sin_wmin_over_2 = sinf(wmin);
-  }
-
-  if(type == 1)
-  {
-    n1 = qco.x / sin_wmin_over_2;
-    n2 = qco.y / sin_wmin_over_2;
-    n3 = qco.z / sin_wmin_over_2;
-  }
-  if(type == 2)
-  {
-    n1 = ((qco.x - qco.y) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
-    n2 = ((qco.x + qco.y) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
-    n3 = ((qco.z - qco.w) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
-  }
-  if(type == 3)
-  {
-    n1 = ((qco.x - qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
-    n2 = ((qco.x + qco.y - qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
-    n3 = ((-qco.x + qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
-  }
-  float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
-  n1 = n1 / denom;
-  n2 = n2 / denom;
-  n3 = n3 / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  wmin = 2.0f * wmin;
-  return wmin;
-
+  return LaueOps<Ebsd::CrystalStructure::Cubic_High>::getMisoQuat(q1, q2, n1, n2, n3);
 }
 
 void CubicOps::getQuatSymOp(int i, QuatF& q)
 {
-  QuaternionMathF::Copy(CubicQuatSym[i], q);
+  q = LaueOps<Ebsd::CrystalStructure::Cubic_High>::getQuatSymOp(i);
 }
 
 void CubicOps::getRodSymOp(int i, float* r)
@@ -658,16 +372,12 @@ FOrientArrayType CubicOps::getMDFFZRod(FOrientArrayType rod)
 
 void CubicOps::getNearestQuat(QuatF& q1, QuatF& q2)
 {
-  int numsym = 24;
-
-  _calcNearestQuat(CubicQuatSym, numsym, q1, q2);
+  LaueOps<Ebsd::CrystalStructure::Cubic_High>::getNearestQuat(q1, q2);
 }
 
 void CubicOps::getFZQuat(QuatF& qr)
 {
-  int numsym = 24;
-
-  _calcQuatNearestOrigin(CubicQuatSym, numsym, qr);
+  LaueOps<Ebsd::CrystalStructure::Cubic_High>::getFZQuat(qr);
 }
 
 // -----------------------------------------------------------------------------
@@ -739,7 +449,7 @@ FOrientArrayType CubicOps::randomizeEulerAngles(FOrientArrayType synea)
   FOrientArrayType quat(4, 0.0f);
   OrientationTransforms<FOrientArrayType, float>::eu2qu(synea, quat);
   q = quat.toQuaternion();
-  QuaternionMathF::Multiply(CubicQuatSym[symOp], q, qc);
+  QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Cubic_High>::getQuatSymOp(symOp), q, qc);
 
   quat.fromQuaternion(qc);
   OrientationTransforms<FOrientArrayType, float>::qu2eu(quat, synea);
@@ -1636,7 +1346,7 @@ SIMPL::Rgb CubicOps::generateIPFColor(double phi1, double phi, double phi2, doub
 
   for (int j = 0; j < 24; j++)
   {
-    QuaternionMathF::Multiply(CubicQuatSym[j], q1, qc);
+    QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Cubic_High>::getQuatSymOp(j), q1, qc);
 
     qu.fromQuaternion(qc);
     OrientationTransforms<FOrientArrayType, float>::qu2om(qu, om);
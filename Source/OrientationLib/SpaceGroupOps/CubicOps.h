@@ -167,9 +167,6 @@ class OrientationLib_EXPORT CubicOps : public SpaceGroupOps
 
 
   protected:
-    float _calcMisoQuat(const QuatF quatsym[24], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
     /**
      * @brief area preserving projection of volume preserving transformation (for C. Shuch and S. Patala coloring legend generation)
      * @param x
@@ -51,6 +51,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
 
@@ -77,14 +78,6 @@ const int HexagonalLowOps::k_OdfSize = 62208;
 const int HexagonalLowOps::k_MdfSize = 62208;
 const int HexagonalLowOps::k_NumSymQuats = 6;
 
-static const QuatF HexQuatSym[HexagonalLowOps::k_NumSymQuats] = {QuaternionMathF::New(0.000000000f, 0.000000000f, 0.000000000f, 1.000000000f),
-                                                                 QuaternionMathF::New(0.000000000f, 0.000000000f, 0.500000000f, 0.866025400f),
-                                                                 QuaternionMathF::New(0.000000000f, 0.000000000f, 0.866025400f, 0.500000000f),
-                                                                 QuaternionMathF::New(0.000000000f, 0.000000000f, 1.000000000f, 0.000000000f),
-                                                                 QuaternionMathF::New(0.000000000f, 0.000000000f, 0.866025400f, -0.50000000f),
-                                                                 QuaternionMathF::New(0.000000000f, 0.000000000f, 0.500000000f, -0.86602540f)
-                                                                };
-
 
 static const float HexRodSym[HexagonalLowOps::k_NumSymQuats][3] = {{0.0f, 0.0f, 0.0f},
   {0.0f, 0.0f, 0.57735f},
@@ -147,78 +140,14 @@ HexagonalLowOps::~HexagonalLowOps()
 {
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float HexagonalLowOps::_calcMisoQuat(const QuatF quatsym[12], int numsym,
-                                     QuatF& q1, QuatF& q2,
-                                     float& n1, float& n2, float& n3)
-{
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-  QuaternionMathF::Copy(q2, q2inv);
-  QuaternionMathF::Conjugate(q2inv);
-
-  QuaternionMathF::Multiply(q1, q2inv, qr);
-  for (int i = 0; i < numsym; i++)
-  {
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    if (qc.w < -1)
-    {
-      qc.w = -1;
-    }
-    else if (qc.w > 1)
-    {
-      qc.w = 1;
-    }
-
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
-
-    if (w > SIMPLib::Constants::k_Pi)
-    {
-      w = SIMPLib::Constants::k_2Pi - w;
-    }
-    if (w < wmin)
-    {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
-    }
-  }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
-}
-
 float HexagonalLowOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-  int numsym = 6;
-
-  return _calcMisoQuat(HexQuatSym, numsym, q1, q2, n1, n2, n3);
+  return LaueOps<Ebsd::CrystalStructure::Hexagonal_Low>::getMisoQuat(q1, q2, n1, n2, n3);
 }
 
 void HexagonalLowOps::getQuatSymOp(int i, QuatF& q)
 {
-  QuaternionMathF::Copy(HexQuatSym[i], q);
+  q = LaueOps<Ebsd::CrystalStructure::Hexagonal_Low>::getQuatSymOp(i);
 
 }
 
@@ -310,9 +239,7 @@ FOrientArrayType HexagonalLowOps::getMDFFZRod(FOrientArrayType rod)
 
 void HexagonalLowOps::getNearestQuat(QuatF& q1, QuatF& q2)
 {
-  int numsym = 6;
-
-  _calcNearestQuat(HexQuatSym, numsym, q1, q2);
+  LaueOps<Ebsd::CrystalStructure::Hexagonal_Low>::getNearestQuat(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -320,8 +247,7 @@ void HexagonalLowOps::getNearestQuat(QuatF& q1, QuatF& q2)
 // -----------------------------------------------------------------------------
 void HexagonalLowOps::getFZQuat(QuatF& qr)
 {
-  int numsym = 6;
-  _calcQuatNearestOrigin(HexQuatSym, numsym, qr);
+  LaueOps<Ebsd::CrystalStructure::Hexagonal_Low>::getFZQuat(qr);
 }
 
 // -----------------------------------------------------------------------------
@@ -393,7 +319,7 @@ FOrientArrayType HexagonalLowOps::randomizeEulerAngles(FOrientArrayType synea)
   FOrientArrayType quat(4, 0.0f);
   OrientationTransforms<FOrientArrayType, float>::eu2qu(synea, quat);
   q = quat.toQuaternion();
-  QuaternionMathF::Multiply(HexQuatSym[symOp], q, qc);
+  QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Hexagonal_Low>::getQuatSymOp(symOp), q, qc);
 
   quat.fromQuaternion(qc);
   OrientationTransforms<FOrientArrayType, float>::qu2eu(quat, synea);
@@ -1235,7 +1161,7 @@ SIMPL::Rgb HexagonalLowOps::generateIPFColor(double phi1, double phi, double phi
 
   for (int j = 0; j < 6; j++)
   {
-    QuaternionMathF::Multiply(HexQuatSym[j], q1, qc);
+    QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Hexagonal_Low>::getQuatSymOp(j), q1, qc);
 
     qu.fromQuaternion(qc);
     OrientationTransforms<FOrientArrayType, float>::qu2om(qu, om);
@@ -155,11 +155,6 @@ class OrientationLib_EXPORT HexagonalLowOps : public SpaceGroupOps
      */
     virtual UInt8ArrayType::Pointer generateIPFTriangleLegend(int imageDim);
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[12], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
-
   private:
     HexagonalLowOps(const HexagonalLowOps&); // Copy Constructor Not Implemented
     void operator=(const HexagonalLowOps&); // Operator '=' Not Implemented
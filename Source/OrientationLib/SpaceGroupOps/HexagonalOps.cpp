@@ -51,6 +51,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
 
@@ -73,20 +74,6 @@ namespace Detail
   }
 }
 
-static const QuatF HexQuatSym[12] = {QuaternionMathF::New(0.000000000f, 0.000000000f, 0.000000000f, 1.000000000f),
-                                     QuaternionMathF::New(0.000000000f, 0.000000000f, 0.500000000f, 0.866025400f),
-                                     QuaternionMathF::New(0.000000000f, 0.000000000f, 0.866025400f, 0.500000000f),
-                                     QuaternionMathF::New(0.000000000f, 0.000000000f, 1.000000000f, 0.000000000f),
-                                     QuaternionMathF::New(0.000000000f, 0.000000000f, 0.866025400f, -0.50000000f),
-                                     QuaternionMathF::New(0.000000000f, 0.000000000f, 0.500000000f, -0.86602540f),
-                                     QuaternionMathF::New(1.000000000f, 0.000000000f, 0.000000000f, 0.000000000f),
-                                     QuaternionMathF::New(0.866025400f, 0.500000000f, 0.000000000f, 0.000000000f),
-                                     QuaternionMathF::New(0.500000000f, 0.866025400f, 0.000000000f, 0.000000000f),
-                                     QuaternionMathF::New(0.000000000f, 1.000000000f, 0.000000000f, 0.000000000f),
-                                     QuaternionMathF::New(-0.50000000f, 0.866025400f, 0.000000000f, 0.000000000f),
-                                     QuaternionMathF::New(-0.86602540f, 0.500000000f, 0.000000000f, 0.000000000)
-                                    };
-
 
 static const float HexRodSym[12][3] = {{0.0f, 0.0f, 0.0f},
   {0.0f, 0.0f, 0.57735f},
@@ -182,82 +169,14 @@ HexagonalOps::~HexagonalOps()
 {
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float HexagonalOps::_calcMisoQuat(const QuatF quatsym[12], int numsym,
-                                  QuatF& q1, QuatF& q2,
-                                  float& n1, float& n2, float& n3)
-{
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-  QuaternionMathF::Copy(q2, q2inv);
-  QuaternionMathF::Conjugate(q2inv);
-
-  QuaternionMathF::Multiply(q1, q2inv, qr);
-  for (int i = 0; i < numsym; i++)
-  {
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    if (qc.w < -1)
-    {
-      qc.w = -1;
-    }
-    else if (qc.w > 1)
-    {
-      qc.w = 1;
-    }
-
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
-
-    if (w > SIMPLib::Constants::k_Pi)
-    {
-      w = SIMPLib::Constants::k_2Pi - w;
-    }
-    if (w < wmin)
-    {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
-    }
-  }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
-}
-
 float HexagonalOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-  int numsym = 12;
-
-  return _calcMisoQuat(HexQuatSym, numsym, q1, q2, n1, n2, n3);
+  return LaueOps<Ebsd::CrystalStructure::Hexagonal_High>::getMisoQuat(q1, q2, n1, n2, n3);
 }
 
 void HexagonalOps::getQuatSymOp(int i, QuatF& q)
 {
-  QuaternionMathF::Copy(HexQuatSym[i], q);
-  //  q.x = HexQuatSym[i][0];
-  //  q.y = HexQuatSym[i][1];
-  //  q.z = HexQuatSym[i][2];
-  //  q.w = HexQuatSym[i][3];
+  q = LaueOps<Ebsd::CrystalStructure::Hexagonal_High>::getQuatSymOp(i);
 }
 
 void HexagonalOps::getRodSymOp(int i, float* r)
@@ -349,9 +268,7 @@ FOrientArrayType HexagonalOps::getMDFFZRod(FOrientArrayType rod)
 
 void HexagonalOps::getNearestQuat(QuatF& q1, QuatF& q2)
 {
-  int numsym = 12;
-
-  _calcNearestQuat(HexQuatSym, numsym, q1, q2);
+  LaueOps<Ebsd::CrystalStructure::Hexagonal_High>::getNearestQuat(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -359,9 +276,7 @@ void HexagonalOps::getNearestQuat(QuatF& q1, QuatF& q2)
 // -----------------------------------------------------------------------------
 void HexagonalOps::getFZQuat(QuatF& qr)
 {
-  int numsym = 12;
-
-  _calcQuatNearestOrigin(HexQuatSym, numsym, qr);
+  LaueOps<Ebsd::CrystalStructure::Hexagonal_High>::getFZQuat(qr);
 }
 
 // -----------------------------------------------------------------------------
@@ -433,7 +348,7 @@ FOrientArrayType HexagonalOps::randomizeEulerAngles(FOrientArrayType synea)
   FOrientArrayType quat(4, 0.0f);
   OrientationTransforms<FOrientArrayType, float>::eu2qu(synea, quat);
   q = quat.toQuaternion();
-  QuaternionMathF::Multiply(HexQuatSym[symOp], q, qc);
+  QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Hexagonal_High>::getQuatSymOp(symOp), q, qc);
 
   quat.fromQuaternion(qc);
   OrientationTransforms<FOrientArrayType, float>::qu2eu(quat, synea);
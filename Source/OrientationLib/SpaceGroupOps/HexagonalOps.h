@@ -159,11 +159,6 @@ class OrientationLib_EXPORT HexagonalOps : public SpaceGroupOps
      */
     virtual UInt8ArrayType::Pointer generateIPFTriangleLegend(int imageDim);
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[12], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
-
   private:
     HexagonalOps(const HexagonalOps&); // Copy Constructor Not Implemented
     void operator=(const HexagonalOps&); // Operator '=' Not Implemented
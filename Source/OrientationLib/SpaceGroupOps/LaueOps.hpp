@@ -0,0 +1,1177 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#ifndef _laueops_h_
+#define _laueops_h_
+
+#include <stdint.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransformsBatch.hpp"
+
+/**
+ * @brief The LaueSymmetry struct holds the symmetry operators of one Laue class as a
+ * table of quaternions stored (x, y, z, w). The template parameter is the value of the
+ * constant at Ebsd::CrystalStructure::***. The tables are constant initialized, so a
+ * loop over them with the class fixed at compile time can be fully unrolled.
+ *
+ * Each specialization also describes the standard stereographic triangle used for the
+ * IPF colors: getIPFEtaRange() gives the range of the azimuth in degrees,
+ * k_IPFCubicTriangle marks the cubic triangles whose polar limit is the {101} great
+ * circle and k_IPFScaleToMax marks the classes whose colors are scaled so that the
+ * largest component is 1.
+ */
+template<unsigned int CrystalStructure>
+struct LaueSymmetry;
+
+/**
+ * @brief Symmetry operators of the Hexagonal-High 6/mmm Laue class (HexagonalOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Hexagonal_High>
+{
+  enum { k_NumSymOps = 12, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 30.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  0.000000000f,  0.000000000f,  0.500000000f,  0.866025400f },
+      {  0.000000000f,  0.000000000f,  0.866025400f,  0.500000000f },
+      {  0.000000000f,  0.000000000f,  1.000000000f,  0.000000000f },
+      {  0.000000000f,  0.000000000f,  0.866025400f, -0.500000000f },
+      {  0.000000000f,  0.000000000f,  0.500000000f, -0.866025400f },
+      {  1.000000000f,  0.000000000f,  0.000000000f,  0.000000000f },
+      {  0.866025400f,  0.500000000f,  0.000000000f,  0.000000000f },
+      {  0.500000000f,  0.866025400f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  1.000000000f,  0.000000000f,  0.000000000f },
+      { -0.500000000f,  0.866025400f,  0.000000000f,  0.000000000f },
+      { -0.866025400f,  0.500000000f,  0.000000000f,  0.000000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Cubic-High m3m Laue class (CubicOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Cubic_High>
+{
+  enum { k_NumSymOps = 24, k_IPFCubicTriangle = 1, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 45.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  1.000000000f,  0.000000000f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  1.000000000f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  0.000000000f,  1.000000000f,  0.000000000f },
+      {  0.707106781186547524f,  0.000000000f,  0.000000000f,  0.707106781186547524f },
+      {  0.000000000f,  0.707106781186547524f,  0.000000000f,  0.707106781186547524f },
+      {  0.000000000f,  0.000000000f,  0.707106781186547524f,  0.707106781186547524f },
+      { -0.707106781186547524f,  0.000000000f,  0.000000000f,  0.707106781186547524f },
+      {  0.000000000f, -0.707106781186547524f,  0.000000000f,  0.707106781186547524f },
+      {  0.000000000f,  0.000000000f, -0.707106781186547524f,  0.707106781186547524f },
+      {  0.707106781186547524f,  0.707106781186547524f,  0.000000000f,  0.000000000f },
+      { -0.707106781186547524f,  0.707106781186547524f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  0.707106781186547524f,  0.707106781186547524f,  0.000000000f },
+      {  0.000000000f, -0.707106781186547524f,  0.707106781186547524f,  0.000000000f },
+      {  0.707106781186547524f,  0.000000000f,  0.707106781186547524f,  0.000000000f },
+      { -0.707106781186547524f,  0.000000000f,  0.707106781186547524f,  0.000000000f },
+      {  0.500000000f,  0.500000000f,  0.500000000f,  0.500000000f },
+      { -0.500000000f, -0.500000000f, -0.500000000f,  0.500000000f },
+      {  0.500000000f, -0.500000000f,  0.500000000f,  0.500000000f },
+      { -0.500000000f,  0.500000000f, -0.500000000f,  0.500000000f },
+      { -0.500000000f,  0.500000000f,  0.500000000f,  0.500000000f },
+      {  0.500000000f, -0.500000000f, -0.500000000f,  0.500000000f },
+      { -0.500000000f, -0.500000000f,  0.500000000f,  0.500000000f },
+      {  0.500000000f,  0.500000000f, -0.500000000f,  0.500000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Hexagonal-Low 6/m Laue class (HexagonalLowOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Hexagonal_Low>
+{
+  enum { k_NumSymOps = 6, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 60.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  0.000000000f,  0.000000000f,  0.500000000f,  0.866025400f },
+      {  0.000000000f,  0.000000000f,  0.866025400f,  0.500000000f },
+      {  0.000000000f,  0.000000000f,  1.000000000f,  0.000000000f },
+      {  0.000000000f,  0.000000000f,  0.866025400f, -0.500000000f },
+      {  0.000000000f,  0.000000000f,  0.500000000f, -0.866025400f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Cubic-Low m3 Laue class (CubicLowOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Cubic_Low>
+{
+  enum { k_NumSymOps = 12, k_IPFCubicTriangle = 1, k_IPFScaleToMax = 0 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 90.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  1.000000000f,  0.000000000f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  1.000000000f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  0.000000000f,  1.000000000f,  0.000000000f },
+      {  0.500000000f,  0.500000000f,  0.500000000f,  0.500000000f },
+      { -0.500000000f, -0.500000000f, -0.500000000f,  0.500000000f },
+      {  0.500000000f, -0.500000000f,  0.500000000f,  0.500000000f },
+      { -0.500000000f,  0.500000000f, -0.500000000f,  0.500000000f },
+      { -0.500000000f,  0.500000000f,  0.500000000f,  0.500000000f },
+      {  0.500000000f, -0.500000000f, -0.500000000f,  0.500000000f },
+      { -0.500000000f, -0.500000000f,  0.500000000f,  0.500000000f },
+      {  0.500000000f,  0.500000000f, -0.500000000f,  0.500000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Triclinic -1 Laue class (TriclinicOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Triclinic>
+{
+  enum { k_NumSymOps = 1, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 180.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Monoclinic 2/m Laue class (MonoclinicOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Monoclinic>
+{
+  enum { k_NumSymOps = 2, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 180.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  0.000000000f,  1.000000000f,  0.000000000f,  0.000000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the OrthoRhombic mmm Laue class (OrthoRhombicOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::OrthoRhombic>
+{
+  enum { k_NumSymOps = 4, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 90.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  1.000000000f,  0.000000000f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  1.000000000f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  0.000000000f,  1.000000000f,  0.000000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Tetragonal-Low 4/m Laue class (TetragonalLowOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Tetragonal_Low>
+{
+  enum { k_NumSymOps = 4, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 90.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  0.000000000f,  0.000000000f,  1.000000000f,  0.000000000f },
+      {  0.000000000f,  0.000000000f,  0.707106781186547524f, -0.707106781186547524f },
+      {  0.000000000f,  0.000000000f,  0.707106781186547524f,  0.707106781186547524f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Tetragonal-High 4/mmm Laue class (TetragonalOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Tetragonal_High>
+{
+  enum { k_NumSymOps = 8, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = 0.0f; etaMax = 45.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  1.000000000f,  0.000000000f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  1.000000000f,  0.000000000f,  0.000000000f },
+      {  0.000000000f,  0.000000000f,  1.000000000f,  0.000000000f },
+      {  0.000000000f,  0.000000000f,  0.707106781186547524f, -0.707106781186547524f },
+      {  0.000000000f,  0.000000000f,  0.707106781186547524f,  0.707106781186547524f },
+      {  0.707106781186547524f,  0.707106781186547524f,  0.000000000f,  0.000000000f },
+      { -0.707106781186547524f,  0.707106781186547524f,  0.000000000f,  0.000000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Trigonal-Low -3 Laue class (TrigonalLowOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Trigonal_Low>
+{
+  enum { k_NumSymOps = 3, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = -120.0f; etaMax = 0.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  0.000000000f,  0.000000000f,  0.866025400f,  0.500000000f },
+      {  0.000000000f,  0.000000000f,  0.866025400f, -0.500000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @brief Symmetry operators of the Trigonal-High -3m Laue class (TrigonalOps)
+ */
+template<>
+struct LaueSymmetry<Ebsd::CrystalStructure::Trigonal_High>
+{
+  enum { k_NumSymOps = 6, k_IPFCubicTriangle = 0, k_IPFScaleToMax = 1 };
+
+  static void getIPFEtaRange(float& etaMin, float& etaMax) { etaMin = -90.0f; etaMax = -30.0f; }
+
+  static const float* getQuatSym()
+  {
+    static const float quatSym[k_NumSymOps][4] =
+    {
+      {  0.000000000f,  0.000000000f,  0.000000000f,  1.000000000f },
+      {  0.000000000f,  0.000000000f,  0.866025400f,  0.500000000f },
+      {  0.000000000f,  0.000000000f,  0.866025400f, -0.500000000f },
+      {  1.000000000f,  0.000000000f,  0.000000000f,  0.000000000f },
+      { -0.500000000f,  0.866025400f,  0.000000000f,  0.000000000f },
+      { -0.500000000f, -0.866025400f,  0.000000000f,  0.000000000f }
+    };
+    return quatSym[0];
+  }
+};
+
+/**
+ * @class LaueOps LaueOps.hpp OrientationLib/SpaceGroupOps/LaueOps.hpp
+ * @brief The LaueOps class is the compile time counterpart of the SpaceGroupOps classes for
+ * the operations that run once per cell or per pair of cells. All functions are static and
+ * inline, so a loop that works on a single Laue class calls them without any virtual
+ * dispatch. The SpaceGroupOps subclasses forward their virtual functions of the same name
+ * to this class. Filters usually reach it through LaueOpsDispatch(), which picks the Laue
+ * class once for a whole group of cells.
+ */
+template<unsigned int CrystalStructure>
+class LaueOps
+{
+  public:
+    typedef LaueSymmetry<CrystalStructure> Symmetry;
+
+    enum { k_NumSymOps = Symmetry::k_NumSymOps };
+
+    /**
+     * @brief getQuatSymOp Returns the symmetry operator at index i
+     */
+    static inline QuatF getQuatSymOp(int i)
+    {
+      const float* q = Symmetry::getQuatSym() + 4 * i;
+      return QuaternionMathF::New(q[0], q[1], q[2], q[3]);
+    }
+
+    /**
+     * @brief getMisoQuat Finds the misorientation between two orientations
+     * @param q1
+     * @param q2
+     * @param n1 [output] First component of the misorientation axis
+     * @param n2 [output] Second component of the misorientation axis
+     * @param n3 [output] Third component of the misorientation axis
+     * @return The misorientation angle in radians
+     */
+    static inline float getMisoQuat(const QuatF& q1, const QuatF& q2, float& n1, float& n2, float& n3)
+    {
+      float wmin = 9999999.0f;
+      float w = 0;
+      float n1min = 0.0f;
+      float n2min = 0.0f;
+      float n3min = 0.0f;
+      QuatF qr;
+      QuatF qc;
+      QuatF q2inv;
+      QuaternionMathF::Copy(q2, q2inv);
+      QuaternionMathF::Conjugate(q2inv);
+
+      QuaternionMathF::Multiply(q1, q2inv, qr);
+      for (int i = 0; i < k_NumSymOps; i++)
+      {
+        QuaternionMathF::Multiply(getQuatSymOp(i), qr, qc);
+        if (qc.w < -1)
+        {
+          qc.w = -1;
+        }
+        else if (qc.w > 1)
+        {
+          qc.w = 1;
+        }
+
+        FOrientArrayType ax(4, 0.0f);
+        FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
+        ax.toAxisAngle(n1, n2, n3, w);
+
+        if (w > SIMPLib::Constants::k_Pi)
+        {
+          w = SIMPLib::Constants::k_2Pi - w;
+        }
+        if (w < wmin)
+        {
+          wmin = w;
+          n1min = n1;
+          n2min = n2;
+          n3min = n3;
+        }
+      }
+      float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
+      n1 = n1min / denom;
+      n2 = n2min / denom;
+      n3 = n3min / denom;
+      if(denom == 0)
+      {
+        n1 = 0.0, n2 = 0.0, n3 = 1.0;
+      }
+      if(wmin == 0)
+      {
+        n1 = 0.0, n2 = 0.0, n3 = 1.0;
+      }
+      return wmin;
+    }
+
+    /**
+     * @brief getMisorientationAngle Returns the misorientation angle between two orientations
+     * in radians, the same angle getMisoQuat() returns, without finding the axis. The angle
+     * of the symmetry equivalent closest to the identity only depends on its w component, so
+     * the loop over the operators is a branch free running maximum.
+     * @param q1
+     * @param q2
+     */
+    static inline float getMisorientationAngle(const QuatF& q1, const QuatF& q2)
+    {
+      // w, x, y, z of q1 * conjugate(q2)
+      float rw = q1.w * q2.w + q1.x * q2.x + q1.y * q2.y + q1.z * q2.z;
+      float rx = q1.x * q2.w - q1.w * q2.x - q1.y * q2.z + q1.z * q2.y;
+      float ry = q1.y * q2.w - q1.w * q2.y - q1.z * q2.x + q1.x * q2.z;
+      float rz = q1.z * q2.w - q1.w * q2.z - q1.x * q2.y + q1.y * q2.x;
+
+      const float* sym = Symmetry::getQuatSym();
+      float wmax = 0.0f;
+      for (int i = 0; i < k_NumSymOps; i++)
+      {
+        float w = std::fabs(sym[4 * i + 3] * rw - sym[4 * i] * rx - sym[4 * i + 1] * ry - sym[4 * i + 2] * rz);
+        wmax = (w > wmax) ? w : wmax;
+      }
+      wmax = (wmax > 1.0f) ? 1.0f : wmax;
+      return 2.0f * std::acos(wmax);
+    }
+
+    /**
+     * @brief getNearestQuat Replaces q2 with its symmetry equivalent closest to q1
+     * @param q1
+     * @param q2
+     */
+    static inline void getNearestQuat(const QuatF& q1, QuatF& q2)
+    {
+      float dist = 0;
+      float smallestdist = 1000000.0f;
+      QuatF qc = QuaternionMath<float>::New();
+      QuatF qmax = QuaternionMath<float>::New();
+
+      for(int i = 0; i < k_NumSymOps; i++)
+      {
+        QuaternionMathF::Multiply(getQuatSymOp(i), q2, qc);
+        if(qc.w < 0)
+        {
+          qc.x = -qc.x;
+          qc.y = -qc.y;
+          qc.z = -qc.z;
+          qc.w = -qc.w;
+        }
+        dist = static_cast<float>(1 - (qc.w * q1.w + qc.x * q1.x + qc.y * q1.y + qc.z * q1.z));
+        if(dist < smallestdist)
+        {
+          smallestdist = dist;
+          QuaternionMathF::Copy(qc, qmax);
+        }
+      }
+      QuaternionMathF::Copy(qmax, q2);
+      if(q2.w < 0)
+      {
+        QuaternionMathF::Negate(q2);
+      }
+    }
+
+    /**
+     * @brief getFZQuat Replaces qr with its symmetry equivalent closest to the identity
+     * @param qr
+     */
+    static inline void getFZQuat(QuatF& qr)
+    {
+      float dist = 0;
+      float smallestdist = 1000000.0f;
+      QuatF qc = QuaternionMath<float>::New();
+      QuatF qmax = QuaternionMath<float>::New();
+
+      for(int i = 0; i < k_NumSymOps; i++)
+      {
+        QuaternionMathF::Multiply(getQuatSymOp(i), qr, qc);
+        dist = 1 - (qc.w * qc.w);
+        if(dist < smallestdist)
+        {
+          smallestdist = dist;
+          QuaternionMathF::Copy(qc, qmax);
+        }
+      }
+      QuaternionMathF::Copy(qmax, qr);
+      if(qr.w < 0)
+      {
+        QuaternionMathF::Negate(qr);
+      }
+    }
+
+    /**
+     * @brief generateIPFColors Computes the IPF colors of n orientations. This is the
+     * batched form of SpaceGroupOps::generateIPFColor(): the orientations are processed
+     * in blocks held as structure of arrays, the symmetry operators are applied to the
+     * sample direction with plain arithmetic and the standard triangle is tested on the
+     * cartesian direction with selects instead of branches, so the loops vectorize. The
+     * trigonometric functions are evaluated once per orientation instead of once per
+     * symmetry operator.
+     * @param eulers n Euler angles (phi1, Phi, phi2) in radians
+     * @param refDirs The reference (sample) direction, need not be normalized
+     * @param refDirStride 0 to use refDirs for every orientation, 3 for one direction per orientation
+     * @param n Number of orientations
+     * @param rgb [output] n RGB triplets
+     */
+    static void generateIPFColors(const float* eulers, const float* refDirs, size_t refDirStride, size_t n, uint8_t* rgb)
+    {
+      enum { k_BlockSize = 256 };
+
+      // The product S_j * q is linear in q. Its 4x4 matrix is built with QuaternionMath so the
+      // kernel follows the same product convention as the scalar code.
+      float symMap[k_NumSymOps][16];
+      for (int j = 0; j < k_NumSymOps; j++)
+      {
+        for (int k = 0; k < 4; k++)
+        {
+          QuatF e = QuaternionMathF::New(k == 0 ? 1.0f : 0.0f, k == 1 ? 1.0f : 0.0f, k == 2 ? 1.0f : 0.0f, k == 3 ? 1.0f : 0.0f);
+          QuatF qc;
+          QuaternionMathF::Multiply(getQuatSymOp(j), e, qc);
+          symMap[j][k] = qc.x;
+          symMap[j][4 + k] = qc.y;
+          symMap[j][8 + k] = qc.z;
+          symMap[j][12 + k] = qc.w;
+        }
+      }
+
+      float etaMinDeg = 0.0f, etaMaxDeg = 0.0f;
+      Symmetry::getIPFEtaRange(etaMinDeg, etaMaxDeg);
+      const float cosEtaMin = static_cast<float>(std::cos(etaMinDeg * SIMPLib::Constants::k_PiOver180));
+      const float sinEtaMin = static_cast<float>(std::sin(etaMinDeg * SIMPLib::Constants::k_PiOver180));
+      const float cosEtaMax = static_cast<float>(std::cos(etaMaxDeg * SIMPLib::Constants::k_PiOver180));
+      const float sinEtaMax = static_cast<float>(std::sin(etaMaxDeg * SIMPLib::Constants::k_PiOver180));
+      const float epsijk = RConst::epsijk;
+
+      double t[9][k_BlockSize];
+      float q[4][k_BlockSize];
+      float v[3][k_BlockSize];
+      float p[3][k_BlockSize];
+
+      for (size_t b = 0; b < n; b += k_BlockSize)
+      {
+        size_t m = (n - b < static_cast<size_t>(k_BlockSize)) ? (n - b) : static_cast<size_t>(k_BlockSize);
+        const float* eu = eulers + 3 * b;
+        const float* dir = refDirs + refDirStride * b;
+
+        // Euler angles to quaternions, as in OrientationTransforms::eu2qu. The sign of the
+        // quaternion does not change the direction so it is not made positive here.
+        for (size_t i = 0; i < m; i++)
+        {
+          t[6][i] = 0.5 * eu[3 * i + 1];
+          t[7][i] = 0.5 * (eu[3 * i] - eu[3 * i + 2]);
+          t[8][i] = 0.5 * (eu[3 * i] + eu[3 * i + 2]);
+        }
+        OrientationTransformsBatch<float>::SinCos(t[6], t[0], t[1], m);
+        OrientationTransformsBatch<float>::SinCos(t[7], t[2], t[3], m);
+        OrientationTransformsBatch<float>::SinCos(t[8], t[4], t[5], m);
+        for (size_t i = 0; i < m; i++)
+        {
+          q[0][i] = static_cast<float>(-epsijk * t[0][i] * t[3][i]);
+          q[1][i] = static_cast<float>(-epsijk * t[0][i] * t[2][i]);
+          q[2][i] = static_cast<float>(-epsijk * t[1][i] * t[4][i]);
+          q[3][i] = static_cast<float>(t[1][i] * t[5][i]);
+          v[0][i] = dir[refDirStride * i];
+          v[1][i] = dir[refDirStride * i + 1];
+          v[2][i] = dir[refDirStride * i + 2];
+        }
+
+        // The scalar code takes the first operator that brings the direction into the standard
+        // triangle and the last operator if none does. Going through the operators backwards
+        // and overwriting on every hit gives the same choice without an early exit.
+        for (int j = k_NumSymOps - 1; j >= 0; j--)
+        {
+          const float* s = symMap[j];
+          const bool last = (j == k_NumSymOps - 1);
+          for (size_t i = 0; i < m; i++)
+          {
+            float x = s[0] * q[0][i] + s[1] * q[1][i] + s[2] * q[2][i] + s[3] * q[3][i];
+            float y = s[4] * q[0][i] + s[5] * q[1][i] + s[6] * q[2][i] + s[7] * q[3][i];
+            float z = s[8] * q[0][i] + s[9] * q[1][i] + s[10] * q[2][i] + s[11] * q[3][i];
+            float w = epsijk * (s[12] * q[0][i] + s[13] * q[1][i] + s[14] * q[2][i] + s[15] * q[3][i]);
+            float qq = w * w - (x * x + y * y + z * z);
+            // Rows of OrientationTransforms::qu2om applied to the reference direction
+            float p0 = (qq + 2.0f * x * x) * v[0][i] + 2.0f * (x * y - w * z) * v[1][i] + 2.0f * (x * z + w * y) * v[2][i];
+            float p1 = 2.0f * (y * x + w * z) * v[0][i] + (qq + 2.0f * y * y) * v[1][i] + 2.0f * (y * z - w * x) * v[2][i];
+            float p2 = 2.0f * (z * x - w * y) * v[0][i] + 2.0f * (z * y + w * x) * v[1][i] + (qq + 2.0f * z * z) * v[2][i];
+            // Every Laue class has the inversion center, so the direction is moved to the upper
+            // hemisphere. The triangle tests and the angles below do not depend on the length of
+            // the direction, so it is never normalized.
+            float sign = (p2 < 0.0f) ? -1.0f : 1.0f;
+            p0 *= sign;
+            p1 *= sign;
+            p2 *= sign;
+            bool inside = (cosEtaMin * p1 - sinEtaMin * p0 >= 0.0f) & (p0 * sinEtaMax - p1 * cosEtaMax >= 0.0f);
+            if (Symmetry::k_IPFCubicTriangle)
+            {
+              inside = inside & (p2 >= ((p0 > p1) ? p0 : p1));
+            }
+            bool keep = inside | last;
+            p[0][i] = keep ? p0 : p[0][i];
+            p[1][i] = keep ? p1 : p[1][i];
+            p[2][i] = keep ? p2 : p[2][i];
+          }
+        }
+
+        // Polar angle chi and azimuth eta of the chosen direction. For the cubic classes t[6] holds
+        // the largest polar angle of the triangle at that azimuth.
+        for (size_t i = 0; i < m; i++)
+        {
+          double x = p[0][i];
+          double y = p[1][i];
+          t[0][i] = x;
+          t[1][i] = y;
+          t[2][i] = p[2][i];
+          t[3][i] = std::sqrt(x * x + y * y);
+          double a = (std::fabs(y) > std::fabs(x)) ? std::fabs(y) : std::fabs(x);
+          double d = std::sqrt(2.0 * a * a + (x * x + y * y - a * a));
+          double c = (d > 0.0) ? a / d : SIMPLib::Constants::k_1OverRoot2;
+          t[4][i] = c;
+          t[5][i] = std::sqrt(1.0 - c * c);
+        }
+        OrientationTransformsBatch<float>::Atan2(t[1], t[0], t[7], m);
+        OrientationTransformsBatch<float>::Atan2(t[3], t[2], t[8], m);
+        OrientationTransformsBatch<float>::Atan2(t[5], t[4], t[6], m);
+
+        uint8_t* out = rgb + 3 * b;
+        for (size_t i = 0; i < m; i++)
+        {
+          float eta = static_cast<float>(t[7][i]);
+          float chi = static_cast<float>(t[8][i]);
+          float chiMax = Symmetry::k_IPFCubicTriangle ? static_cast<float>(t[6][i]) : static_cast<float>(SIMPLib::Constants::k_PiOver2);
+          float ratio = chi / chiMax;
+          float etaDeg = eta * static_cast<float>(SIMPLib::Constants::k_180OverPi);
+          float red = 1.0f - ratio;
+          float blue = std::fabs(etaDeg - etaMinDeg) / (etaMaxDeg - etaMinDeg);
+          float green = (1.0f - blue) * ratio;
+          blue = blue * ratio;
+          red = std::sqrt(red > 0.0f ? red : 0.0f);
+          green = std::sqrt(green > 0.0f ? green : 0.0f);
+          blue = std::sqrt(blue > 0.0f ? blue : 0.0f);
+          if (Symmetry::k_IPFScaleToMax)
+          {
+            float max = (red > green) ? red : green;
+            max = (blue > max) ? blue : max;
+            float invMax = (max > 0.0f) ? 1.0f / max : 0.0f;
+            red *= invMax;
+            green *= invMax;
+            blue *= invMax;
+          }
+          out[3 * i] = static_cast<uint8_t>(static_cast<int>(red * 255.0f));
+          out[3 * i + 1] = static_cast<uint8_t>(static_cast<int>(green * 255.0f));
+          out[3 * i + 2] = static_cast<uint8_t>(static_cast<int>(blue * 255.0f));
+        }
+      }
+    }
+};
+
+/**
+ * @brief Cubic-High uses a closed form for the misorientation that sorts the components of
+ * the misorientation quaternion instead of trying all 24 operators
+ */
+template<>
+inline float LaueOps<Ebsd::CrystalStructure::Cubic_High>::getMisoQuat(const QuatF& q1, const QuatF& q2, float& n1, float& n2, float& n3)
+{
+  float wmin = 9999999.0f; //,na,nb,nc;
+  QuatF qco;
+  QuatF qc;
+  QuatF q2inv;
+  int type = 1;
+  float sin_wmin_over_2 = 0.0;
+
+  QuaternionMathF::Conjugate(q2, q2inv); // Computes the Conjugate of q2 and places the result in q2inv
+  QuaternionMathF::Multiply(q1, q2inv, qc);
+  QuaternionMathF::ElementWiseAbs(qc);
+
+  //if qc.x is smallest
+  if ( qc.x <= qc.y && qc.x <= qc.z && qc.x <= qc.w)
+  {
+    qco.x = qc.x;
+    //if qc.y is next smallest
+    if (qc.y <= qc.z && qc.y <= qc.w)
+    {
+      qco.y = qc.y;
+      if(qc.z <= qc.w)
+      {
+        qco.z = qc.z, qco.w = qc.w;
+      }
+      else
+      {
+        qco.z = qc.w, qco.w = qc.z;
+      }
+    }
+    //if qc.z is next smallest
+    else if (qc.z <= qc.y && qc.z <= qc.w)
+    {
+      qco.y = qc.z;
+      if(qc.y <= qc.w)
+      {
+        qco.z = qc.y, qco.w = qc.w;
+      }
+      else
+      {
+        qco.z = qc.w, qco.w = qc.y;
+      }
+    }
+    //if qc.w is next smallest
+    else
+    {
+      qco.y = qc.w;
+      if(qc.y <= qc.z)
+      {
+        qco.z = qc.y, qco.w = qc.z;
+      }
+      else
+      {
+        qco.z = qc.z, qco.w = qc.y;
+      }
+    }
+  }
+  //if qc.y is smallest
+  else if ( qc.y <= qc.x && qc.y <= qc.z && qc.y <= qc.w)
+  {
+    qco.x = qc.y;
+    //if qc.x is next smallest
+    if (qc.x <= qc.z && qc.x <= qc.w)
+    {
+      qco.y = qc.x;
+      if(qc.z <= qc.w)
+      {
+        qco.z = qc.z, qco.w = qc.w;
+      }
+      else
+      {
+        qco.z = qc.w, qco.w = qc.z;
+      }
+    }
+    //if qc.z is next smallest
+    else if (qc.z <= qc.x && qc.z <= qc.w)
+    {
+      qco.y = qc.z;
+      if(qc.x <= qc.w)
+      {
+        qco.z = qc.x, qco.w = qc.w;
+      }
+      else
+      {
+        qco.z = qc.w, qco.w = qc.x;
+      }
+    }
+    //if qc.w is next smallest
+    else
+    {
+      qco.y = qc.w;
+      if(qc.x <= qc.z)
+      {
+        qco.z = qc.x, qco.w = qc.z;
+      }
+      else
+      {
+        qco.z = qc.z, qco.w = qc.x;
+      }
+    }
+  }
+  //if qc.z is smallest
+  else if ( qc.z <= qc.x && qc.z <= qc.y && qc.z <= qc.w)
+  {
+    qco.x = qc.z;
+    //if qc.x is next smallest
+    if (qc.x <= qc.y && qc.x <= qc.w)
+    {
+      qco.y = qc.x;
+      if(qc.y <= qc.w)
+      {
+        qco.z = qc.y, qco.w = qc.w;
+      }
+      else
+      {
+        qco.z = qc.w, qco.w = qc.y;
+      }
+    }
+    //if qc.y is next smallest
+    else if (qc.y <= qc.x && qc.y <= qc.w)
+    {
+      qco.y = qc.y;
+      if(qc.x <= qc.w)
+      {
+        qco.z = qc.x, qco.w = qc.w;
+      }
+      else
+      {
+        qco.z = qc.w, qco.w = qc.x;
+      }
+    }
+    //if qc.w is next smallest
+    else
+    {
+      qco.y = qc.w;
+      if(qc.x <= qc.y)
+      {
+        qco.z = qc.x, qco.w = qc.y;
+      }
+      else
+      {
+        qco.z = qc.y, qco.w = qc.x;
+      }
+    }
+  }
+  //if qc.w is smallest
+  else
+  {
+    qco.x = qc.w;
+    //if qc.x is next smallest
+    if (qc.x <= qc.y && qc.x <= qc.z)
+    {
+      qco.y = qc.x;
+      if(qc.y <= qc.z)
+      {
+        qco.z = qc.y, qco.w = qc.z;
+      }
+      else
+      {
+        qco.z = qc.z, qco.w = qc.y;
+      }
+    }
+    //if qc.y is next smallest
+    else if (qc.y <= qc.x && qc.y <= qc.z)
+    {
+      qco.y = qc.y;
+      if(qc.x <= qc.z)
+      {
+        qco.z = qc.x, qco.w = qc.z;
+      }
+      else
+      {
+        qco.z = qc.z, qco.w = qc.x;
+      }
+    }
+    //if qc.z is next smallest
+    else
+    {
+      qco.y = qc.z;
+      if(qc.x <= qc.y)
+      {
+        qco.z = qc.x, qco.w = qc.y;
+      }
+      else
+      {
+        qco.z = qc.y, qco.w = qc.x;
+      }
+    }
+  }
+  wmin = qco.w;
+  if (((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2)) > wmin)
+  {
+    wmin = ((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2));
+    type = 2;
+  }
+  if (((qco.x + qco.y + qco.z + qco.w) / 2) > wmin)
+  {
+    wmin = ((qco.x + qco.y + qco.z + qco.w) / 2);
+    type = 3;
+  }
+  if (wmin < -1.0)
+  {
+    //  wmin = -1.0;
+    wmin = SIMPLib::Constants::k_ACosNeg1;
+    sin_wmin_over_2 = sinf(wmin);
+  }
+  else if (wmin > 1.0)
+  {
+    //   wmin = 1.0;
+    wmin = SIMPLib::Constants::k_ACos1;
+    sin_wmin_over_2 = sinf(wmin);
+  }
+  else
+  {
+    wmin = acos(wmin);
+    sin_wmin_over_2 = sinf(wmin);
+  }
+
+  if(type == 1)
+  {
+    n1 = qco.x / sin_wmin_over_2;
+    n2 = qco.y / sin_wmin_over_2;
+    n3 = qco.z / sin_wmin_over_2;
+  }
+  if(type == 2)
+  {
+    n1 = ((qco.x - qco.y) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+    n2 = ((qco.x + qco.y) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+    n3 = ((qco.z - qco.w) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+  }
+  if(type == 3)
+  {
+    n1 = ((qco.x - qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+    n2 = ((qco.x + qco.y - qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+    n3 = ((-qco.x + qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+  }
+  float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
+  n1 = n1 / denom;
+  n2 = n2 / denom;
+  n3 = n3 / denom;
+  if(denom == 0)
+  {
+    n1 = 0.0, n2 = 0.0, n3 = 1.0;
+  }
+  if(wmin == 0)
+  {
+    n1 = 0.0, n2 = 0.0, n3 = 1.0;
+  }
+  wmin = 2.0f * wmin;
+  return wmin;
+}
+
+/**
+ * @brief LaueOpsDispatch Calls functor.execute<CrystalStructure>() with the Laue class given
+ * at run time, so that the functor can run a whole loop with that class fixed at compile time.
+ * @param crystalStructure The value of the constant at Ebsd::CrystalStructure::***. The last
+ * entry of SpaceGroupOps::getOrientationOpsVector() is handled as OrthoRhombic, like there.
+ * @param functor Any type with the method template<unsigned int CrystalStructure> void execute()
+ * @return false if the crystal structure is not a known Laue class
+ */
+template<typename Functor>
+inline bool LaueOpsDispatch(unsigned int crystalStructure, Functor& functor)
+{
+  if (crystalStructure == Ebsd::CrystalStructure::LaueGroupEnd)
+  {
+    crystalStructure = Ebsd::CrystalStructure::OrthoRhombic;
+  }
+  switch(crystalStructure)
+  {
+    case Ebsd::CrystalStructure::Hexagonal_High:
+      functor.template execute<Ebsd::CrystalStructure::Hexagonal_High>();
+      return true;
+    case Ebsd::CrystalStructure::Cubic_High:
+      functor.template execute<Ebsd::CrystalStructure::Cubic_High>();
+      return true;
+    case Ebsd::CrystalStructure::Hexagonal_Low:
+      functor.template execute<Ebsd::CrystalStructure::Hexagonal_Low>();
+      return true;
+    case Ebsd::CrystalStructure::Cubic_Low:
+      functor.template execute<Ebsd::CrystalStructure::Cubic_Low>();
+      return true;
+    case Ebsd::CrystalStructure::Triclinic:
+      functor.template execute<Ebsd::CrystalStructure::Triclinic>();
+      return true;
+    case Ebsd::CrystalStructure::Monoclinic:
+      functor.template execute<Ebsd::CrystalStructure::Monoclinic>();
+      return true;
+    case Ebsd::CrystalStructure::OrthoRhombic:
+      functor.template execute<Ebsd::CrystalStructure::OrthoRhombic>();
+      return true;
+    case Ebsd::CrystalStructure::Tetragonal_Low:
+      functor.template execute<Ebsd::CrystalStructure::Tetragonal_Low>();
+      return true;
+    case Ebsd::CrystalStructure::Tetragonal_High:
+      functor.template execute<Ebsd::CrystalStructure::Tetragonal_High>();
+      return true;
+    case Ebsd::CrystalStructure::Trigonal_Low:
+      functor.template execute<Ebsd::CrystalStructure::Trigonal_Low>();
+      return true;
+    case Ebsd::CrystalStructure::Trigonal_High:
+      functor.template execute<Ebsd::CrystalStructure::Trigonal_High>();
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief LaueMisorientationAngle Returns LaueOps<crystalStructure>::getMisorientationAngle(q1, q2)
+ * for code that compares cells one pair at a time and cannot group them by Laue class. This is
+ * a single switch instead of a virtual call plus the search for the misorientation axis.
+ * @param crystalStructure The value of the constant at Ebsd::CrystalStructure::***
+ * @param q1
+ * @param q2
+ * @return The angle in radians, or the largest float if the crystal structure is not a
+ * known Laue class
+ */
+inline float LaueMisorientationAngle(unsigned int crystalStructure, const QuatF& q1, const QuatF& q2)
+{
+  if (crystalStructure == Ebsd::CrystalStructure::LaueGroupEnd)
+  {
+    crystalStructure = Ebsd::CrystalStructure::OrthoRhombic;
+  }
+  switch(crystalStructure)
+  {
+    case Ebsd::CrystalStructure::Hexagonal_High:
+      return LaueOps<Ebsd::CrystalStructure::Hexagonal_High>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Cubic_High:
+      return LaueOps<Ebsd::CrystalStructure::Cubic_High>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Hexagonal_Low:
+      return LaueOps<Ebsd::CrystalStructure::Hexagonal_Low>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Cubic_Low:
+      return LaueOps<Ebsd::CrystalStructure::Cubic_Low>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Triclinic:
+      return LaueOps<Ebsd::CrystalStructure::Triclinic>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Monoclinic:
+      return LaueOps<Ebsd::CrystalStructure::Monoclinic>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::OrthoRhombic:
+      return LaueOps<Ebsd::CrystalStructure::OrthoRhombic>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Tetragonal_Low:
+      return LaueOps<Ebsd::CrystalStructure::Tetragonal_Low>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Tetragonal_High:
+      return LaueOps<Ebsd::CrystalStructure::Tetragonal_High>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Trigonal_Low:
+      return LaueOps<Ebsd::CrystalStructure::Trigonal_Low>::getMisorientationAngle(q1, q2);
+    case Ebsd::CrystalStructure::Trigonal_High:
+      return LaueOps<Ebsd::CrystalStructure::Trigonal_High>::getMisorientationAngle(q1, q2);
+    default:
+      return std::numeric_limits<float>::max();
+  }
+}
+
+/**
+ * @class LaueIPFColorBatch LaueOps.hpp OrientationLib/SpaceGroupOps/LaueOps.hpp
+ * @brief The LaueIPFColorBatch class collects IPF color requests for elements of any Laue
+ * class and evaluates them with LaueOps<>::generateIPFColors(), one Laue class at a time.
+ * Each request is copied into the pending block of its Laue class; a full block is colored
+ * right away and the colors are written back to the locations given with the requests.
+ * flush() must be called after the last request. One instance is meant to be used by a
+ * single thread, so parallel loops create one per range.
+ */
+class LaueIPFColorBatch
+{
+  public:
+    LaueIPFColorBatch() :
+      m_Eulers(Ebsd::CrystalStructure::LaueGroupEnd * k_BatchSize * 3, 0.0f),
+      m_RefDirs(Ebsd::CrystalStructure::LaueGroupEnd * k_BatchSize * 3, 0.0f),
+      m_Colors(k_BatchSize * 3, 0),
+      m_Targets(Ebsd::CrystalStructure::LaueGroupEnd * k_BatchSize, NULL),
+      m_Counts(Ebsd::CrystalStructure::LaueGroupEnd, 0)
+    {}
+    virtual ~LaueIPFColorBatch() {}
+
+    /**
+     * @brief add Queues the IPF color of one orientation
+     * @param crystalStructure The value of the constant at Ebsd::CrystalStructure::***
+     * @param euler The Euler angles in radians
+     * @param refDir The reference direction
+     * @param rgb [output] Where the 3 color components are written
+     * @return false if the crystal structure is not a known Laue class, in which case rgb is not written
+     */
+    bool add(unsigned int crystalStructure, const float* euler, const float* refDir, uint8_t* rgb)
+    {
+      if (crystalStructure >= Ebsd::CrystalStructure::LaueGroupEnd) { return false; }
+      size_t slot = crystalStructure * k_BatchSize + m_Counts[crystalStructure];
+      m_Eulers[3 * slot] = euler[0];
+      m_Eulers[3 * slot + 1] = euler[1];
+      m_Eulers[3 * slot + 2] = euler[2];
+      m_RefDirs[3 * slot] = refDir[0];
+      m_RefDirs[3 * slot + 1] = refDir[1];
+      m_RefDirs[3 * slot + 2] = refDir[2];
+      m_Targets[slot] = rgb;
+      m_Counts[crystalStructure]++;
+      if (m_Counts[crystalStructure] == k_BatchSize) { flush(crystalStructure); }
+      return true;
+    }
+
+    /**
+     * @brief flush Colors every pending request
+     */
+    void flush()
+    {
+      for (unsigned int cs = 0; cs < Ebsd::CrystalStructure::LaueGroupEnd; cs++)
+      {
+        flush(cs);
+      }
+    }
+
+  private:
+    enum { k_BatchSize = 256 };
+
+    std::vector<float> m_Eulers;
+    std::vector<float> m_RefDirs;
+    std::vector<uint8_t> m_Colors;
+    std::vector<uint8_t*> m_Targets;
+    std::vector<size_t> m_Counts;
+
+    /**
+     * @brief The ColorFunctor class runs the kernel of one Laue class through LaueOpsDispatch
+     */
+    class ColorFunctor
+    {
+      public:
+        ColorFunctor(const float* eulers, const float* refDirs, size_t n, uint8_t* rgb) :
+          m_Eulers(eulers), m_RefDirs(refDirs), m_N(n), m_Rgb(rgb)
+        {}
+
+        template<unsigned int CrystalStructure>
+        void execute()
+        {
+          LaueOps<CrystalStructure>::generateIPFColors(m_Eulers, m_RefDirs, 3, m_N, m_Rgb);
+        }
+
+      private:
+        const float* m_Eulers;
+        const float* m_RefDirs;
+        size_t m_N;
+        uint8_t* m_Rgb;
+    };
+
+    void flush(unsigned int crystalStructure)
+    {
+      size_t count = m_Counts[crystalStructure];
+      if (count == 0) { return; }
+      size_t first = crystalStructure * k_BatchSize;
+      ColorFunctor functor(&(m_Eulers[3 * first]), &(m_RefDirs[3 * first]), count, &(m_Colors[0]));
+      LaueOpsDispatch(crystalStructure, functor);
+      for (size_t i = 0; i < count; i++)
+      {
+        uint8_t* rgb = m_Targets[first + i];
+        rgb[0] = m_Colors[3 * i];
+        rgb[1] = m_Colors[3 * i + 1];
+        rgb[2] = m_Colors[3 * i + 2];
+      }
+      m_Counts[crystalStructure] = 0;
+    }
+
+    LaueIPFColorBatch(const LaueIPFColorBatch&); // Copy Constructor Not Implemented
+    void operator=(const LaueIPFColorBatch&); // Operator '=' Not Implemented
+};
+
+#endif /* _laueops_h_ */
@@ -51,6 +51,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 
 
@@ -70,12 +71,6 @@ namespace Detail
   }
 }
 
-static const QuatF MonoclinicQuatSym[2] =
-{
-  QuaternionMathF::New(0.000000000f, 0.000000000f, 0.000000000f, 1.000000000f),
-  QuaternionMathF::New(0.000000000f, 1.000000000f, 0.000000000f, 0.000000000f)
-};
-
 
 static const float MonoclinicRodSym[2][3] = {{0.0f, 0.0f, 0.0f},
   {0.0f, 10000000000.0f, 0.0f}
@@ -116,79 +111,13 @@ MonoclinicOps::~MonoclinicOps()
 // -----------------------------------------------------------------------------
 float MonoclinicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-
-  int numsym = 2;
-
-  return _calcMisoQuat(MonoclinicQuatSym, numsym, q1, q2, n1, n2, n3);
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float MonoclinicOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
-                                   QuatF& q1, QuatF& q2,
-                                   float& n1, float& n2, float& n3)
-{
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-  QuaternionMathF::Copy(q2, q2inv);
-  QuaternionMathF::Conjugate(q2inv);
-
-  QuaternionMathF::Multiply(q1, q2inv, qr);
-  for (int i = 0; i < numsym; i++)
-  {
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    if (qc.w < -1)
-    {
-      qc.w = -1;
-    }
-    else if (qc.w > 1)
-    {
-      qc.w = 1;
-    }
-
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
-
-    if (w > SIMPLib::Constants::k_Pi)
-    {
-      w = SIMPLib::Constants::k_2Pi - w;
-    }
-    if (w < wmin)
-    {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
-    }
-  }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
-
+  return LaueOps<Ebsd::CrystalStructure::Monoclinic>::getMisoQuat(q1, q2, n1, n2, n3);
 }
 
 
 void MonoclinicOps::getQuatSymOp(int i, QuatF& q)
 {
-  QuaternionMathF::Copy(MonoclinicQuatSym[i], q);
+  q = LaueOps<Ebsd::CrystalStructure::Monoclinic>::getQuatSymOp(i);
 }
 
 void MonoclinicOps::getRodSymOp(int i, float* r)
@@ -246,9 +175,7 @@ FOrientArrayType MonoclinicOps::getMDFFZRod(FOrientArrayType rod)
 // -----------------------------------------------------------------------------
 void MonoclinicOps::getNearestQuat(QuatF& q1, QuatF& q2)
 {
-  int numsym = 2;
-
-  _calcNearestQuat(MonoclinicQuatSym, numsym, q1, q2);
+  LaueOps<Ebsd::CrystalStructure::Monoclinic>::getNearestQuat(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -320,7 +247,7 @@ FOrientArrayType MonoclinicOps::randomizeEulerAngles(FOrientArrayType synea)
   FOrientArrayType quat(4, 0.0f);
   OrientationTransforms<FOrientArrayType, float>::eu2qu(synea, quat);
   q = quat.toQuaternion();
-  QuaternionMathF::Multiply(MonoclinicQuatSym[symOp], q, qc);
+  QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Monoclinic>::getQuatSymOp(symOp), q, qc);
 
   quat.fromQuaternion(qc);
   OrientationTransforms<FOrientArrayType, float>::qu2eu(quat, synea);
@@ -624,7 +551,7 @@ SIMPL::Rgb MonoclinicOps::generateIPFColor(double phi1, double phi, double phi2,
 
   for (int j = 0; j < 2; j++)
   {
-    QuaternionMathF::Multiply(MonoclinicQuatSym[j], q1, qc);
+    QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Monoclinic>::getQuatSymOp(j), q1, qc);
 
     qu.fromQuaternion(qc);
     OrientationTransforms<FOrientArrayType, float>::qu2om(qu, om);
@@ -52,6 +52,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
 
@@ -73,12 +74,6 @@ namespace Detail
   }
 }
 
-static const QuatF OrthoQuatSym[4] = { QuaternionMathF::New(0.000000000f, 0.000000000f, 0.000000000f, 1.000000000f),
-                                       QuaternionMathF::New(1.000000000f, 0.000000000f, 0.000000000f, 0.000000000f),
-                                       QuaternionMathF::New(0.000000000f, 1.000000000f, 0.000000000f, 0.000000000f),
-                                       QuaternionMathF::New(0.000000000f, 0.000000000f, 1.000000000f, 0.000000000)
-                                     };
-
 static const float OrthoRodSym[4][3] = {{0.0f, 0.0f, 0.0f},
   {10000000000.0f, 0.0f, 0.0f},
   {0.0f, 10000000000.0f, 0.0f},
@@ -126,82 +121,14 @@ OrthoRhombicOps::~OrthoRhombicOps()
   
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float OrthoRhombicOps::_calcMisoQuat(const QuatF quatsym[4], int numsym,
-                                     QuatF& q1, QuatF& q2,
-                                     float& n1, float& n2, float& n3)
-{
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-
-  QuaternionMathF::Copy(q2, q2inv);
-  QuaternionMathF::Conjugate(q2inv);
-
-  QuaternionMathF::Multiply(q1, q2inv, qr);
-
-  for (int i = 0; i < numsym; i++)
-  {
-
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    //MULT_QUAT(qr, quatsym[i], qc)
-    if (qc.w < -1)
-    {
-      qc.w = -1;
-    }
-    else if (qc.w > 1)
-    {
-      qc.w = 1;
-    }
-
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
-
-    if (w > SIMPLib::Constants::k_Pi)
-    {
-      w = SIMPLib::Constants::k_2Pi - w;
-    }
-    if (w < wmin)
-    {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
-    }
-  }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
-}
-
 float OrthoRhombicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-  int numsym = 4;
-
-  return _calcMisoQuat(OrthoQuatSym, numsym, q1, q2, n1, n2, n3);
+  return LaueOps<Ebsd::CrystalStructure::OrthoRhombic>::getMisoQuat(q1, q2, n1, n2, n3);
 }
 
 void OrthoRhombicOps::getQuatSymOp(int i, QuatF& q)
 {
-  QuaternionMathF::Copy(OrthoQuatSym[i], q);
+  q = LaueOps<Ebsd::CrystalStructure::OrthoRhombic>::getQuatSymOp(i);
 
 }
 
@@ -262,17 +189,12 @@ FOrientArrayType OrthoRhombicOps::getMDFFZRod(FOrientArrayType rod)
 // -----------------------------------------------------------------------------
 void OrthoRhombicOps::getNearestQuat(QuatF& q1, QuatF& q2)
 {
-  int numsym = 4;
-
-  _calcNearestQuat(OrthoQuatSym, numsym, q1, q2);
+  LaueOps<Ebsd::CrystalStructure::OrthoRhombic>::getNearestQuat(q1, q2);
 }
 
 void OrthoRhombicOps::getFZQuat(QuatF& qr)
 {
-  int numsym = 4;
-
-  _calcQuatNearestOrigin(OrthoQuatSym, numsym, qr);
-
+  LaueOps<Ebsd::CrystalStructure::OrthoRhombic>::getFZQuat(qr);
 }
 
 // -----------------------------------------------------------------------------
@@ -343,7 +265,7 @@ FOrientArrayType OrthoRhombicOps::randomizeEulerAngles(FOrientArrayType synea)
   FOrientArrayType quat(4, 0.0f);
   OrientationTransforms<FOrientArrayType, float>::eu2qu(synea, quat);
   q = quat.toQuaternion();
-  QuaternionMathF::Multiply(OrthoQuatSym[symOp], q, qc);
+  QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::OrthoRhombic>::getQuatSymOp(symOp), q, qc);
 
   quat.fromQuaternion(qc);
   OrientationTransforms<FOrientArrayType, float>::qu2eu(quat, synea);
@@ -158,11 +158,6 @@ class OrientationLib_EXPORT OrthoRhombicOps : public SpaceGroupOps
      */
     virtual UInt8ArrayType::Pointer generateIPFTriangleLegend(int imageDim);
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[4], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
-
   private:
     OrthoRhombicOps(const OrthoRhombicOps&); // Copy Constructor Not Implemented
     void operator=(const OrthoRhombicOps&); // Operator '=' Not Implemented
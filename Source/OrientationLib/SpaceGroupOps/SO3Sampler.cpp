@@ -31,6 +31,16 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SO3Sampler.h"
 
+#include <algorithm>
+#include <cmath>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/ArrayHelpers.hpp"
@@ -103,6 +113,84 @@ static const int FZoarray[32] = { NoAxisOrder,NoAxisOrder,TwoFoldAxisOrder,TwoFo
                                   SixFoldAxisOrder,SixFoldAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder};
 
 
+/**
+ * @brief The SO3SampleSlicesImpl class samples a range of planes of the cubochoric grid
+ */
+class SO3SampleSlicesImpl
+{
+  public:
+    SO3SampleSlicesImpl(SO3Sampler* sampler, int nsteps, int extent, int FZtype, int FZorder, SO3Sampler::SampleCallback* callback) :
+      m_Sampler(sampler),
+      m_NSteps(nsteps),
+      m_Extent(extent),
+      m_FZtype(FZtype),
+      m_FZorder(FZorder),
+      m_Callback(callback)
+    {}
+    virtual ~SO3SampleSlicesImpl() {}
+
+    void sample(int start, int end) const
+    {
+      m_Sampler->sampleSlices(start, end, m_NSteps, m_Extent, m_FZtype, m_FZorder, m_Callback);
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int>& r) const
+    {
+      sample(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    SO3Sampler* m_Sampler;
+    int m_NSteps;
+    int m_Extent;
+    int m_FZtype;
+    int m_FZorder;
+    SO3Sampler::SampleCallback* m_Callback;
+};
+
+/**
+ * @brief The SO3SampleListCollector class keeps the points of every plane so the
+ * list returned by SampleRFZ() can be assembled in grid order
+ */
+class SO3SampleListCollector : public SO3Sampler::SampleCallback
+{
+  public:
+    SO3SampleListCollector(int nsteps) :
+      m_NSteps(nsteps),
+      m_Slices(2 * static_cast<size_t>(nsteps))
+    {}
+    virtual ~SO3SampleListCollector() {}
+
+    virtual void processSlice(int slice, const double* rods, size_t count)
+    {
+      // Every slice owns its own vector so no locking is needed
+      m_Slices[slice + m_NSteps].assign(rods, rods + 4 * count);
+    }
+
+    void appendTo(SO3Sampler::OrientationListArrayType& list) const
+    {
+      for (size_t s = 0; s < m_Slices.size(); s++)
+      {
+        const std::vector<double>& rods = m_Slices[s];
+        for (size_t p = 0; p < rods.size(); p += 4)
+        {
+          DOrientArrayType rod(4);
+          rod[0] = rods[p];
+          rod[1] = rods[p + 1];
+          rod[2] = rods[p + 2];
+          rod[3] = rods[p + 3];
+          list.push_back(rod);
+        }
+      }
+    }
+
+  private:
+    int m_NSteps;
+    std::vector<std::vector<double> > m_Slices;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -421,50 +509,134 @@ bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 //--------------------------------------------------------------------------
 SO3Sampler::OrientationListArrayType SO3Sampler::SampleRFZ(int nsteps,int pgnum)
 {
+  OrientationListArrayType FZlist;
+  if (nsteps <= 0) { return FZlist; }
 
-  double                        x, y, z, delta;
-  OrientationListArrayType              FZlist;
-  int32_t                 FZtype, FZorder;
+  SO3SampleListCollector collector(nsteps);
+  SampleRFZ(nsteps, pgnum, &collector);
+  collector.appendTo(FZlist);
 
-  // step size for sampling of grid; total number of samples = (2*nsteps+1)**3
-  delta = ( 0.50 * LPs::ap)/static_cast<double>(nsteps);
+  return FZlist;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SO3Sampler::SampleRFZ(int nsteps, int pgnum, SampleCallback* callback)
+{
+  if (nsteps <= 0 || pgnum < 1 || pgnum > 32 || NULL == callback) { return; }
 
   // determine which function we should call for this point group symmetry
-  FZtype = FZtarray[pgnum-1];
-  FZorder = FZoarray[pgnum-1];
-  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+  int FZtype = FZtarray[pgnum-1];
+  int FZorder = FZoarray[pgnum-1];
+  int extent = FZSampleExtent(nsteps, FZtype, FZorder);
 
   // loop over the cube of volume pi^2; note that we do not want to include
   // the opposite edges/facets of the cube, to avoid double counting rotations
   // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-  for(int i = -nsteps; i < nsteps; i++)
+  int start = std::max(-nsteps, -extent);
+  int end = std::min(nsteps, extent + 1);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
   {
-    x = static_cast<double>(i) * delta;
+    tbb::parallel_for(tbb::blocked_range<int>(start, end, 1),
+                      SO3SampleSlicesImpl(this, nsteps, extent, FZtype, FZorder, callback), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SO3SampleSlicesImpl serial(this, nsteps, extent, FZtype, FZorder, callback);
+    serial.sample(start, end);
+  }
+}
 
-    for(int j = -nsteps; j < nsteps; j++)
-    {
-      y = static_cast<double>(j) * delta;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SO3Sampler::sampleSlices(int start, int end, int nsteps, int extent, int FZtype, int FZorder, SampleCallback* callback)
+{
+  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
 
-      for (int k = -nsteps; k < nsteps; k++)
+  // step size for sampling of grid; total number of samples = (2*nsteps+1)**3
+  double delta = ( 0.50 * LPs::ap)/static_cast<double>(nsteps);
+  int lo = std::max(-nsteps, -extent);
+  int hi = std::min(nsteps, extent + 1);
+
+  std::vector<double> rods;
+  DOrientArrayType cu(3);
+  DOrientArrayType rod(4);
+  for (int i = start; i < end; i++)
+  {
+    rods.clear();
+    cu[0] = static_cast<double>(i) * delta;
+    for (int j = lo; j < hi; j++)
+    {
+      cu[1] = static_cast<double>(j) * delta;
+      for (int k = lo; k < hi; k++)
       {
-        z = static_cast<double>(k) * delta;
+        cu[2] = static_cast<double>(k) * delta;
 
         // convert to Rodrigues representation
-        DOrientArrayType cu(x, y, z);
-        DOrientArrayType rod(4);
         OrientationTransformsType::cu2ro(cu, rod);
-
-        // If insideFZ=true, then add this point to the linked list FZlist and keep
-        // track of how many points there are on this list
-        bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-        if (b)
+        if (IsinsideFZ(rod.data(), FZtype, FZorder))
         {
-          FZlist.push_back(rod);
+          rods.insert(rods.end(), rod.data(), rod.data() + 4);
         }
-
       }
     }
+    if (!rods.empty())
+    {
+      callback->processSlice(i, &(rods.front()), rods.size() / 4);
+    }
   }
+}
 
-  return FZlist;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SO3Sampler::FZSampleExtent(int nsteps, int FZtype, int FZorder)
+{
+  // Largest Rodrigues vector length inside the FZ
+  double rmax = 0.0;
+  switch(FZtype)
+  {
+    case DihedralType:
+    {
+      if (FZorder < TwoFoldAxisOrder || FZorder > SixFoldAxisOrder) { return nsteps; }
+      // 2n sided prism: apothem 1 in the plane, half height tan(pi/2n)
+      double halfAngle = SIMPLib::Constants::k_Pi / (2.0 * static_cast<double>(FZorder));
+      double circum = 1.0 / cos(halfAngle);
+      rmax = sqrt(circum * circum + LPs::BP[FZorder - 1] * LPs::BP[FZorder - 1]);
+      break;
+    }
+    case TetrahedralType:
+      // octahedron |r0| + |r1| + |r2| <= 1
+      rmax = 1.0;
+      break;
+    case OctahedralType:
+    {
+      // truncated cube; the farthest vertex is (t, t, 1 - 2t) with t = tan(pi/8)
+      double t = LPs::BP[3];
+      rmax = sqrt(2.0 * t * t + (1.0 - 2.0 * t) * (1.0 - 2.0 * t));
+      break;
+    }
+    default:
+      return nsteps;
+  }
+
+  // rotation angle -> homochoric radius -> half edge of the concentric cubochoric cube
+  double omega = 2.0 * atan(rmax);
+  double h = pow(0.75 * (omega - sin(omega)), 1.0 / 3.0);
+  double halfEdge = h * (0.50 * LPs::ap) / LPs::R1;
+  double delta = ( 0.50 * LPs::ap)/static_cast<double>(nsteps);
+
+  // one extra step absorbs rounding on the FZ boundary
+  int extent = static_cast<int>(floor(halfEdge / delta)) + 1;
+  return std::min(extent, nsteps);
 }
@@ -34,6 +34,9 @@
 
 
 
+#include <list>
+#include <vector>
+
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
@@ -59,9 +62,60 @@ class OrientationLib_EXPORT SO3Sampler
      */
     typedef std::list<DOrientArrayType> OrientationListArrayType;
 
+    /**
+     * @brief The SampleCallback class receives the orientations of the streaming
+     * SampleRFZ() overload one plane of the cubochoric grid at a time.
+     */
+    class OrientationLib_EXPORT SampleCallback
+    {
+      public:
+        virtual ~SampleCallback() {}
+
+        /**
+         * @brief processSlice Called once for every plane x = slice * delta of the
+         * cubochoric grid that contains points inside the FZ. The planes are processed
+         * in parallel, so this may be called from several threads at once for
+         * different slices. Within a slice the points are in the same order as
+         * in the list returned by SampleRFZ(nsteps, pgnum).
+         * @param slice Grid index along X in the range [-nsteps, nsteps)
+         * @param rods Rodrigues vectors (4 values each, axis and tan(w/2)). The memory is only valid during the call.
+         * @param count Number of Rodrigues vectors
+         */
+        virtual void processSlice(int slice, const double* rods, size_t count) = 0;
+    };
+
     // sampler routine
     OrientationListArrayType SampleRFZ(int nsteps,int pgnum);
 
+    /**
+     * @brief SampleRFZ Streaming version of the sampler. Only the part of the
+     * cubochoric grid that can reach the FZ is visited and the points are handed to
+     * the callback plane by plane instead of being collected into a list.
+     * @param nsteps Number of steps along the semi-edge of the cubochoric grid
+     * @param pgnum Point group number
+     * @param callback Receives the points inside the FZ
+     */
+    void SampleRFZ(int nsteps, int pgnum, SampleCallback* callback);
+
+    /**
+     * @brief FZSampleExtent Returns the largest grid index m such that every grid
+     * point of the FZ lies inside [-m, m] along each cubochoric axis. The cube to
+     * ball map sends concentric cubes onto concentric spheres, so the rotation angle
+     * of a grid point depends only on its largest coordinate, and the finite FZs
+     * (dihedral, tetrahedral and octahedral) fit inside a sphere of known radius.
+     * The cyclic and triclinic FZs contain 180 degree rotations and use the full grid.
+     * @param nsteps Number of steps along the semi-edge of the cubochoric grid
+     * @param FZtype
+     * @param FZorder
+     */
+    static int FZSampleExtent(int nsteps, int FZtype, int FZorder);
+
+    /**
+     * @brief sampleSlices Samples the planes [start, end) of the grid. Used by the
+     * streaming SampleRFZ() from one or more threads.
+     */
+    void sampleSlices(int start, int end, int nsteps, int extent, int FZtype, int FZorder, SampleCallback* callback);
+
     /**
      * @brief IsinsideFZ
      * @param rod
@@ -37,6 +37,7 @@
 
 set(OrientationLib_SpaceGroupOps_HDRS
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/SpaceGroupOps.h
+  ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/LaueOps.hpp
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/CubicOps.h
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/CubicLowOps.h
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/HexagonalOps.h
@@ -99,70 +99,6 @@ void SpaceGroupOps::getFZQuat(QuatF& qr)
   Q_ASSERT(false);
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float SpaceGroupOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
-                                   QuatF& q1, QuatF& q2,
-                                   float& n1, float& n2, float& n3)
-{
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-
-  QuaternionMathF::Copy(q2, q2inv);
-
-  QuaternionMathF::Conjugate(q2inv);
-  QuaternionMathF::Multiply(q1, q2inv, qr);
-  for (int i = 0; i < numsym; i++)
-  {
-
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    if (qc.w < -1)
-    {
-      qc.w = -1;
-    }
-    else if (qc.w > 1)
-    {
-      qc.w = 1;
-    }
-
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
-
-    if (w > SIMPLib::Constants::k_Pi)
-    {
-      w = SIMPLib::Constants::k_2Pi - w;
-    }
-    if (w < wmin)
-    {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
-    }
-  }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -206,71 +142,6 @@ FOrientArrayType SpaceGroupOps::_calcRodNearestOrigin(const float rodsym[24][3],
   return outRod;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void SpaceGroupOps::_calcNearestQuat(const QuatF quatsym[24], int numsym,
-                                     QuatF& q1,
-                                     QuatF& q2)
-{
-  float dist = 0;
-  float smallestdist = 1000000.0f;
-  QuatF qc = QuaternionMath<float>::New();
-  QuatF qmax = QuaternionMath<float>::New();
-
-  QuaternionMathF::Copy(q2, qc);
-
-  for(int i = 0; i < numsym; i++)
-  {
-    QuaternionMathF::Multiply(quatsym[i], q2, qc);
-    if(qc.w < 0)
-    {
-      qc.x = -qc.x;
-      qc.y = -qc.y;
-      qc.z = -qc.z;
-      qc.w = -qc.w;
-    }
-    dist = static_cast<float>(1 - (qc.w * q1.w + qc.x * q1.x + qc.y * q1.y + qc.z * q1.z));
-    if(dist < smallestdist)
-    {
-      smallestdist = dist;
-      QuaternionMathF::Copy(qc, qmax);
-    }
-  }
-  QuaternionMathF::Copy(qmax, q2);
-  if(q2.w < 0)
-  {
-    QuaternionMathF::Negate(q2);
-  }
-}
-
-void SpaceGroupOps::_calcQuatNearestOrigin(const QuatF quatsym[24], int numsym, QuatF& qr)
-{
-  float dist = 0;
-  float smallestdist = 1000000.0f;
-  QuatF qc = QuaternionMath<float>::New();
-  QuatF qmax = QuaternionMath<float>::New();
-
-  QuaternionMathF::Copy(qr, qc);
-
-  for(int i = 0; i < numsym; i++)
-  {
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    dist = 1 - (qc.w * qc.w);
-    if(dist < smallestdist)
-    {
-      smallestdist = dist;
-      QuaternionMathF::Copy(qc, qmax);
-
-    }
-  }
-  QuaternionMathF::Copy(qmax, qr);
-  if(qr.w < 0)
-  {
-    QuaternionMathF::Negate(qr);
-  }
-}
-
 
 int SpaceGroupOps::_calcMisoBin(float dim[3], float bins[3], float step[3], const FOrientArrayType& ho)
 {
@@ -205,13 +205,7 @@ class OrientationLib_EXPORT SpaceGroupOps
   protected:
     SpaceGroupOps();
 
-    float _calcMisoQuat(const QuatF quatsym[24], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
-
     FOrientArrayType _calcRodNearestOrigin(const float rodsym[24][3], int numsym, FOrientArrayType rod);
-    void _calcNearestQuat(const QuatF quatsym[24], int numsym, QuatF& q1, QuatF& q2);
-    void _calcQuatNearestOrigin(const QuatF quatsym[24], int numsym, QuatF& qr);
 
     int _calcMisoBin(float dim[3], float bins[3], float step[3], const FOrientArrayType& homochoric);
     void _calcDetermineHomochoricValues(uint64_t seed, float init[3], float step[3], int32_t phi[3], int choose, float& r1, float& r2, float& r3);
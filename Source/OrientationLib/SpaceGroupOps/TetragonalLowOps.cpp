@@ -52,6 +52,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
 
@@ -71,12 +72,6 @@ namespace Detail
     static const int symSize2 = 2;
   }
 }
-static const QuatF TetraQuatSym[4] = {QuaternionMathF::New(0.000000000f, 0.000000000f, 0.000000000f, 1.000000000f),
-                                      QuaternionMathF::New(0.000000000f, 0.000000000f, 1.000000000f, 0.000000000f),
-                                      QuaternionMathF::New(0.000000000f, 0.000000000f, SIMPLib::Constants::k_1OverRoot2, -SIMPLib::Constants::k_1OverRoot2),
-                                      QuaternionMathF::New(0.000000000f, 0.000000000f, SIMPLib::Constants::k_1OverRoot2, SIMPLib::Constants::k_1OverRoot2)
-                                     };
-
 
 static const float TetraRodSym[4][3] = {{0.0f, 0.0f, 0.0f},
   {0.0f, 0.0f, 10000000000.0f},
@@ -130,79 +125,14 @@ TetragonalLowOps::~TetragonalLowOps()
   
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float TetragonalLowOps::_calcMisoQuat(const QuatF quatsym[8], int numsym,
-                                      QuatF& q1, QuatF& q2,
-                                      float& n1, float& n2, float& n3)
-{
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-
-  QuaternionMathF::Copy(q2, q2inv);
-  QuaternionMathF::Conjugate(q2inv);
-
-  QuaternionMathF::Multiply(q1, q2inv, qr);
-  for (int i = 0; i < numsym; i++)
-  {
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    if (qc.w < -1)
-    {
-      qc.w = -1;
-    }
-    else if (qc.w > 1)
-    {
-      qc.w = 1;
-    }
-
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
-
-    if (w > SIMPLib::Constants::k_Pi)
-    {
-      w = SIMPLib::Constants::k_2Pi - w;
-    }
-    if (w < wmin)
-    {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
-    }
-  }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
-}
-
 float TetragonalLowOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-  int numsym = 4;
-
-  return _calcMisoQuat(TetraQuatSym, numsym, q1, q2, n1, n2, n3);
+  return LaueOps<Ebsd::CrystalStructure::Tetragonal_Low>::getMisoQuat(q1, q2, n1, n2, n3);
 }
 
 void TetragonalLowOps::getQuatSymOp(int i, QuatF& q)
 {
-  QuaternionMathF::Copy(TetraQuatSym[i], q);
+  q = LaueOps<Ebsd::CrystalStructure::Tetragonal_Low>::getQuatSymOp(i);
 }
 
 void TetragonalLowOps::getRodSymOp(int i, float* r)
@@ -262,9 +192,7 @@ FOrientArrayType TetragonalLowOps::getMDFFZRod(FOrientArrayType rod)
 // -----------------------------------------------------------------------------
 void TetragonalLowOps::getNearestQuat(QuatF& q1, QuatF& q2)
 {
-  int numsym = 4;
-
-  _calcNearestQuat(TetraQuatSym, numsym, q1, q2);
+  LaueOps<Ebsd::CrystalStructure::Tetragonal_Low>::getNearestQuat(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -337,7 +265,7 @@ FOrientArrayType TetragonalLowOps::randomizeEulerAngles(FOrientArrayType synea)
   FOrientArrayType quat(4, 0.0f);
   OrientationTransforms<FOrientArrayType, float>::eu2qu(synea, quat);
   q = quat.toQuaternion();
-  QuaternionMathF::Multiply(TetraQuatSym[symOp], q, qc);
+  QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Tetragonal_Low>::getQuatSymOp(symOp), q, qc);
 
   quat.fromQuaternion(qc);
   OrientationTransforms<FOrientArrayType, float>::qu2eu(quat, synea);
@@ -155,11 +155,6 @@ class OrientationLib_EXPORT TetragonalLowOps : public SpaceGroupOps
      */
     virtual UInt8ArrayType::Pointer generateIPFTriangleLegend(int imageDim);
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[8], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
-
   private:
     TetragonalLowOps(const TetragonalLowOps&); // Copy Constructor Not Implemented
     void operator=(const TetragonalLowOps&); // Operator '=' Not Implemented
@@ -154,10 +154,6 @@ class OrientationLib_EXPORT TriclinicOps : public SpaceGroupOps
      */
     virtual UInt8ArrayType::Pointer generateIPFTriangleLegend(int imageDim);
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[24], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
   private:
     TriclinicOps(const TriclinicOps&); // Copy Constructor Not Implemented
     void operator=(const TriclinicOps&); // Operator '=' Not Implemented
@@ -51,6 +51,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 
 namespace Detail
@@ -69,11 +70,6 @@ namespace Detail
     static const int symSize2 = 2;
   }
 }
-static const QuatF TrigQuatSym[3] = {QuaternionMathF::New(0.000000000f, 0.000000000f, 0.000000000f, 1.000000000f),
-                                     QuaternionMathF::New(0.000000000f, 0.000000000f, 0.866025400f, 0.500000000f),
-                                     QuaternionMathF::New(0.000000000f, 0.000000000f, 0.866025400f, -0.50000000f)
-                                    };
-
 static const float TrigRodSym[3][3] = {{0.0f, 0.0f, 0.0f},
   {0.0f, 0.0f, 1.73205f},
   {0.0f, 0.0f, -1.73205f}
@@ -119,79 +115,14 @@ TrigonalLowOps::~TrigonalLowOps()
 {
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float TrigonalLowOps::_calcMisoQuat(const QuatF quatsym[6], int numsym,
-                                    QuatF& q1, QuatF& q2,
-                                    float& n1, float& n2, float& n3)
-{
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-
-  QuaternionMathF::Copy(q2, q2inv);
-  QuaternionMathF::Conjugate(q2inv);
-
-  QuaternionMathF::Multiply(q1, q2inv, qr);
-  for (int i = 0; i < numsym; i++)
-  {
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    if (qc.w < -1)
-    {
-      qc.w = -1;
-    }
-    else if (qc.w > 1)
-    {
-      qc.w = 1;
-    }
-
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
-
-    if (w > SIMPLib::Constants::k_Pi)
-    {
-      w = SIMPLib::Constants::k_2Pi - w;
-    }
-    if (w < wmin)
-    {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
-    }
-  }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
-}
-
 float TrigonalLowOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-  int numsym = 3;
-
-  return _calcMisoQuat(TrigQuatSym, numsym, q1, q2, n1, n2, n3);
+  return LaueOps<Ebsd::CrystalStructure::Trigonal_Low>::getMisoQuat(q1, q2, n1, n2, n3);
 }
 
 void TrigonalLowOps::getQuatSymOp(int i, QuatF& q)
 {
-  QuaternionMathF::Copy(TrigQuatSym[i], q);
+  q = LaueOps<Ebsd::CrystalStructure::Trigonal_Low>::getQuatSymOp(i);
 
 }
 
@@ -282,9 +213,7 @@ FOrientArrayType TrigonalLowOps::getMDFFZRod(FOrientArrayType rod)
 // -----------------------------------------------------------------------------
 void TrigonalLowOps::getNearestQuat(QuatF& q1, QuatF& q2)
 {
-  int numsym = 3;
-
-  _calcNearestQuat(TrigQuatSym, numsym, q1, q2);
+  LaueOps<Ebsd::CrystalStructure::Trigonal_Low>::getNearestQuat(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -356,7 +285,7 @@ FOrientArrayType TrigonalLowOps::randomizeEulerAngles(FOrientArrayType synea)
   FOrientArrayType quat(4, 0.0f);
   OrientationTransforms<FOrientArrayType, float>::eu2qu(synea, quat);
   q = quat.toQuaternion();
-  QuaternionMathF::Multiply(TrigQuatSym[symOp], q, qc);
+  QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Trigonal_Low>::getQuatSymOp(symOp), q, qc);
 
   quat.fromQuaternion(qc);
   OrientationTransforms<FOrientArrayType, float>::qu2eu(quat, synea);
@@ -156,11 +156,6 @@ class OrientationLib_EXPORT TrigonalLowOps : public SpaceGroupOps
      */
     virtual UInt8ArrayType::Pointer generateIPFTriangleLegend(int imageDim);
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[6], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
-
   private:
     TrigonalLowOps(const TrigonalLowOps&); // Copy Constructor Not Implemented
     void operator=(const TrigonalLowOps&); // Operator '=' Not Implemented
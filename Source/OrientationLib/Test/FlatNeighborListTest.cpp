@@ -0,0 +1,188 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/Utilities/FlatNeighborList.h"
+
+#include "OrientationLibTestFileLocations.h"
+
+class FlatNeighborListTest
+{
+  public:
+    FlatNeighborListTest(){}
+    virtual ~FlatNeighborListTest(){}
+    SIMPL_TYPE_MACRO(FlatNeighborListTest)
+
+    // -----------------------------------------------------------------------------
+    // Lists of sizes 0, 3, 0, 2 and 1, the middle empty list sits between two full ones
+    // -----------------------------------------------------------------------------
+    int TestFlatNeighborListLayout()
+    {
+      FlatNeighborList<int32_t> lists;
+      lists.setNumberOfFeatures(5);
+      DREAM3D_REQUIRE_EQUAL(lists.getNumberOfFeatures(), 5)
+      DREAM3D_REQUIRE_EQUAL(lists.getNumberOfValues(), 0)
+
+      // Counted one at a time, set at once, and counted in one step
+      lists.addToListSize(1);
+      lists.addToListSize(1);
+      lists.addToListSize(1);
+      lists.setListSize(3, 2);
+      lists.addToListSize(4, 1);
+      lists.allocate();
+
+      size_t sizes[5] = { 0, 3, 0, 2, 1 };
+      size_t start = 0;
+      for (size_t i = 0; i < 5; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(lists.getListSize(i), sizes[i])
+        DREAM3D_REQUIRE_EQUAL(lists.getListStart(i), start)
+        DREAM3D_REQUIRE_EQUAL(lists.getListEnd(i), start + sizes[i])
+        start += sizes[i];
+      }
+      DREAM3D_REQUIRE_EQUAL(lists.getNumberOfValues(), 6)
+
+      // The appends of different Features may be interleaved
+      lists.append(3, 30);
+      lists.append(1, 10);
+      lists.append(4, 40);
+      lists.append(1, 11);
+      lists.append(3, 31);
+      lists.append(1, 12);
+      int32_t expected[6] = { 10, 11, 12, 30, 31, 40 };
+      for (size_t i = 0; i < 6; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(lists.getValues()[i], expected[i])
+      }
+      DREAM3D_REQUIRE_EQUAL(lists.getValue(3, 1), 31)
+      DREAM3D_REQUIRE_EQUAL(lists.getList(4)[0], 40)
+
+      // Writing through getList() is the same as appending
+      lists.getList(1)[2] = 13;
+      DREAM3D_REQUIRE_EQUAL(lists.getValue(1, 2), 13)
+
+      // A second list with the same layout holds one value per entry
+      FlatNeighborList<float> values;
+      values.copyLayout(lists);
+      DREAM3D_REQUIRE_EQUAL(values.getNumberOfFeatures(), 5)
+      DREAM3D_REQUIRE_EQUAL(values.getNumberOfValues(), 6)
+      for (size_t i = 0; i < 5; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(values.getListStart(i), lists.getListStart(i))
+        DREAM3D_REQUIRE_EQUAL(values.getListSize(i), lists.getListSize(i))
+      }
+      values.append(3, 3.5f);
+      DREAM3D_REQUIRE_EQUAL(values.getValue(3, 0), 3.5f)
+
+      // Resetting the number of Features drops the old lists
+      lists.setNumberOfFeatures(2);
+      DREAM3D_REQUIRE_EQUAL(lists.getNumberOfValues(), 0)
+      DREAM3D_REQUIRE_EQUAL(lists.getListSize(1), 0)
+      lists.allocate();
+      DREAM3D_REQUIRE_EQUAL(lists.getList(1) == NULL, true)
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFlatNeighborListNeighborList()
+    {
+      NeighborList<int32_t>::Pointer input = NeighborList<int32_t>::CreateArray(4, "Input", true);
+      for (int32_t i = 0; i < 4; i++)
+      {
+        NeighborList<int32_t>::SharedVectorType list(new std::vector<int32_t>);
+        for (int32_t j = 0; j < i; j++) { list->push_back(10 * i + j); }
+        input->setList(i, list);
+      }
+
+      FlatNeighborList<int32_t> lists;
+      lists.readNeighborList(*input);
+      DREAM3D_REQUIRE_EQUAL(lists.getNumberOfFeatures(), 4)
+      DREAM3D_REQUIRE_EQUAL(lists.getNumberOfValues(), 6)
+      for (int32_t i = 0; i < 4; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(lists.getListSize(i), static_cast<size_t>(i))
+        for (int32_t j = 0; j < i; j++)
+        {
+          DREAM3D_REQUIRE_EQUAL(lists.getValue(i, j), 10 * i + j)
+        }
+      }
+
+      // Feature 0 is never copied, so its list in the output keeps its old value
+      NeighborList<int32_t>::Pointer output = NeighborList<int32_t>::CreateArray(4, "Output", true);
+      NeighborList<int32_t>::SharedVectorType zeroList(new std::vector<int32_t>(1, -7));
+      output->setList(0, zeroList);
+      lists.getList(3)[0] = 99;
+      lists.copyToNeighborList(output);
+      DREAM3D_REQUIRE_EQUAL(output->getListReference(0).size(), 1)
+      DREAM3D_REQUIRE_EQUAL(output->getListReference(0)[0], -7)
+      DREAM3D_REQUIRE_EQUAL(output->getListReference(1).size(), 1)
+      DREAM3D_REQUIRE_EQUAL(output->getListReference(1)[0], 10)
+      DREAM3D_REQUIRE_EQUAL(output->getListReference(3).size(), 3)
+      DREAM3D_REQUIRE_EQUAL(output->getListReference(3)[0], 99)
+      DREAM3D_REQUIRE_EQUAL(output->getListReference(3)[2], 32)
+
+      // The output lists are copies, changing the flat lists afterwards leaves them alone
+      lists.getList(2)[1] = 0;
+      DREAM3D_REQUIRE_EQUAL(output->getListReference(2)[1], 21)
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestFlatNeighborListLayout())
+      DREAM3D_REGISTER_TEST(TestFlatNeighborListNeighborList())
+    }
+
+  private:
+    FlatNeighborListTest(const FlatNeighborListTest&); // Copy Constructor Not Implemented
+    void operator=(const FlatNeighborListTest&); // Operator '=' Not Implemented
+};
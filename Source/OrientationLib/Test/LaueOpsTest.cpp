@@ -0,0 +1,327 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Softwae, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+#include "SIMPLib/Utilities/ColorTable.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
+
+/**
+ * @brief Records the Laue class it was dispatched with
+ */
+class LaueOpsTestDispatch
+{
+  public:
+    LaueOpsTestDispatch() : m_CrystalStructure(Ebsd::CrystalStructure::UnknownCrystalStructure), m_NumSymOps(0) {}
+
+    template<unsigned int CrystalStructure>
+    void execute()
+    {
+      m_CrystalStructure = CrystalStructure;
+      m_NumSymOps = LaueOps<CrystalStructure>::k_NumSymOps;
+    }
+
+    unsigned int m_CrystalStructure;
+    int m_NumSymOps;
+};
+
+class LaueOpsTest
+{
+  public:
+    LaueOpsTest(){}
+    virtual ~LaueOpsTest(){}
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      // QFile::remove();
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    QuatF RandomQuat()
+    {
+      QuatF q = QuaternionMathF::New(static_cast<float>(rand()) / RAND_MAX - 0.5f, static_cast<float>(rand()) / RAND_MAX - 0.5f,
+                                     static_cast<float>(rand()) / RAND_MAX - 0.5f, static_cast<float>(rand()) / RAND_MAX - 0.5f);
+      QuaternionMathF::UnitQuaternion(q);
+      return q;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestDispatch()
+    {
+      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+      for (int i = 0; i < ops.size(); i++)
+      {
+        LaueOpsTestDispatch dispatch;
+        bool known = LaueOpsDispatch(static_cast<unsigned int>(i), dispatch);
+        DREAM3D_REQUIRE_EQUAL(known, true)
+        DREAM3D_REQUIRE_EQUAL(dispatch.m_NumSymOps, ops[i]->getNumSymOps())
+      }
+
+      LaueOpsTestDispatch dispatch;
+      bool known = LaueOpsDispatch(Ebsd::CrystalStructure::UnknownCrystalStructure, dispatch);
+      DREAM3D_REQUIRE_EQUAL(known, false)
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    QuatF AxisAngleQuat(float x, float y, float z, float degrees)
+    {
+      float norm = std::sqrt(x * x + y * y + z * z);
+      float halfAngle = 0.5f * degrees * SIMPLib::Constants::k_PiOver180;
+      float s = std::sin(halfAngle) / norm;
+      return QuaternionMathF::New(x * s, y * s, z * s, std::cos(halfAngle));
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestMisorientationAngle()
+    {
+      // Each pair differs by a known rotation; the expected angles were worked out by hand from the point
+      // group generators and do not come from the symmetry operator tables under test. The float acos
+      // near the identity limits the agreement to a few thousandths of a radian.
+      struct KnownPair
+      {
+        unsigned int crystalStructure;
+        float axis[3];
+        float rotation;
+        float expected;
+      };
+      const KnownPair pairs[] =
+      {
+        { Ebsd::CrystalStructure::Hexagonal_High, { 0.0f, 0.0f, 1.0f }, 60.0f, 0.0f },
+        { Ebsd::CrystalStructure::Hexagonal_High, { 0.0f, 0.0f, 1.0f }, 30.0f, 30.0f },
+        { Ebsd::CrystalStructure::Hexagonal_High, { 0.0f, 0.0f, 1.0f }, 90.0f, 30.0f },
+        { Ebsd::CrystalStructure::Hexagonal_High, { 1.0f, 0.0f, 0.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::Hexagonal_High, { 0.0f, 1.0f, 0.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::Hexagonal_High, { 1.0f, 0.0f, 0.0f }, 90.0f, 90.0f },
+        { Ebsd::CrystalStructure::Cubic_High, { 0.0f, 0.0f, 1.0f }, 90.0f, 0.0f },
+        { Ebsd::CrystalStructure::Cubic_High, { 0.0f, 0.0f, 1.0f }, 45.0f, 45.0f },
+        { Ebsd::CrystalStructure::Cubic_High, { 1.0f, 1.0f, 1.0f }, 120.0f, 0.0f },
+        { Ebsd::CrystalStructure::Cubic_High, { 1.0f, 1.0f, 1.0f }, 60.0f, 60.0f },
+        { Ebsd::CrystalStructure::Cubic_High, { 1.0f, 0.0f, 0.0f }, 30.0f, 30.0f },
+        { Ebsd::CrystalStructure::Cubic_High, { 1.0f, 1.0f, 0.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::Cubic_High, { 1.0f, 1.0f, 0.0f }, 90.0f, 62.7994f },
+        { Ebsd::CrystalStructure::Hexagonal_Low, { 0.0f, 0.0f, 1.0f }, 60.0f, 0.0f },
+        { Ebsd::CrystalStructure::Hexagonal_Low, { 0.0f, 0.0f, 1.0f }, 20.0f, 20.0f },
+        { Ebsd::CrystalStructure::Hexagonal_Low, { 1.0f, 0.0f, 0.0f }, 180.0f, 180.0f },
+        { Ebsd::CrystalStructure::Cubic_Low, { 0.0f, 0.0f, 1.0f }, 90.0f, 90.0f },
+        { Ebsd::CrystalStructure::Cubic_Low, { 0.0f, 0.0f, 1.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::Cubic_Low, { 1.0f, 1.0f, 1.0f }, 120.0f, 0.0f },
+        { Ebsd::CrystalStructure::Cubic_Low, { 1.0f, 1.0f, 1.0f }, 60.0f, 60.0f },
+        { Ebsd::CrystalStructure::Triclinic, { 1.0f, 0.0f, 0.0f }, 30.0f, 30.0f },
+        { Ebsd::CrystalStructure::Triclinic, { 1.0f, 2.0f, 3.0f }, 150.0f, 150.0f },
+        { Ebsd::CrystalStructure::Monoclinic, { 0.0f, 1.0f, 0.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::Monoclinic, { 0.0f, 1.0f, 0.0f }, 90.0f, 90.0f },
+        { Ebsd::CrystalStructure::Monoclinic, { 0.0f, 0.0f, 1.0f }, 180.0f, 180.0f },
+        { Ebsd::CrystalStructure::OrthoRhombic, { 0.0f, 0.0f, 1.0f }, 90.0f, 90.0f },
+        { Ebsd::CrystalStructure::OrthoRhombic, { 1.0f, 0.0f, 0.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::OrthoRhombic, { 0.0f, 0.0f, 1.0f }, 120.0f, 60.0f },
+        { Ebsd::CrystalStructure::Tetragonal_Low, { 0.0f, 0.0f, 1.0f }, 90.0f, 0.0f },
+        { Ebsd::CrystalStructure::Tetragonal_Low, { 0.0f, 0.0f, 1.0f }, 45.0f, 45.0f },
+        { Ebsd::CrystalStructure::Tetragonal_Low, { 1.0f, 0.0f, 0.0f }, 180.0f, 180.0f },
+        { Ebsd::CrystalStructure::Tetragonal_High, { 0.0f, 0.0f, 1.0f }, 90.0f, 0.0f },
+        { Ebsd::CrystalStructure::Tetragonal_High, { 0.0f, 0.0f, 1.0f }, 45.0f, 45.0f },
+        { Ebsd::CrystalStructure::Tetragonal_High, { 1.0f, 0.0f, 0.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::Tetragonal_High, { 1.0f, 1.0f, 0.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::Trigonal_Low, { 0.0f, 0.0f, 1.0f }, 120.0f, 0.0f },
+        { Ebsd::CrystalStructure::Trigonal_Low, { 0.0f, 0.0f, 1.0f }, 60.0f, 60.0f },
+        { Ebsd::CrystalStructure::Trigonal_Low, { 0.0f, 0.0f, 1.0f }, 180.0f, 60.0f },
+        { Ebsd::CrystalStructure::Trigonal_High, { 0.0f, 0.0f, 1.0f }, 120.0f, 0.0f },
+        { Ebsd::CrystalStructure::Trigonal_High, { 1.0f, 0.0f, 0.0f }, 180.0f, 0.0f },
+        { Ebsd::CrystalStructure::Trigonal_High, { 0.0f, 0.0f, 1.0f }, 60.0f, 60.0f },
+      };
+      const size_t numPairs = sizeof(pairs) / sizeof(pairs[0]);
+
+      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+      srand(12345);
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      for (size_t p = 0; p < numPairs; p++)
+      {
+        const KnownPair& pair = pairs[p];
+        QuatF r = AxisAngleQuat(pair.axis[0], pair.axis[1], pair.axis[2], pair.rotation);
+        float expected = pair.expected * SIMPLib::Constants::k_PiOver180;
+        for (int t = 0; t < 10; t++)
+        {
+          // A common rotation applied to both orientations must not change their misorientation
+          QuatF q1 = RandomQuat();
+          QuatF q2;
+          QuaternionMathF::Multiply(r, q1, q2);
+          float w = ops[pair.crystalStructure]->getMisoQuat(q1, q2, n1, n2, n3);
+          DREAM3D_REQUIRE(std::fabs(w - expected) < 5.0E-3f)
+          float angle = LaueMisorientationAngle(pair.crystalStructure, q1, q2);
+          DREAM3D_REQUIRE(std::fabs(angle - expected) < 5.0E-3f)
+        }
+      }
+
+      // The axes of the Sigma 3 twin in cubic and of a 30 degree twist about c in hexagonal are unambiguous
+      QuatF q1 = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 1.0f);
+      QuatF q2 = AxisAngleQuat(1.0f, 1.0f, 1.0f, 60.0f);
+      ops[Ebsd::CrystalStructure::Cubic_High]->getMisoQuat(q1, q2, n1, n2, n3);
+      DREAM3D_REQUIRE(std::fabs(std::fabs(n1) - 1.0f / std::sqrt(3.0f)) < 1.0E-3f)
+      DREAM3D_REQUIRE(std::fabs(std::fabs(n2) - 1.0f / std::sqrt(3.0f)) < 1.0E-3f)
+      DREAM3D_REQUIRE(std::fabs(std::fabs(n3) - 1.0f / std::sqrt(3.0f)) < 1.0E-3f)
+      q2 = AxisAngleQuat(0.0f, 0.0f, 1.0f, 30.0f);
+      ops[Ebsd::CrystalStructure::Hexagonal_High]->getMisoQuat(q1, q2, n1, n2, n3);
+      DREAM3D_REQUIRE(std::fabs(n1) < 1.0E-3f)
+      DREAM3D_REQUIRE(std::fabs(n2) < 1.0E-3f)
+      DREAM3D_REQUIRE(std::fabs(std::fabs(n3) - 1.0f) < 1.0E-3f)
+
+      // No pair of random orientations may exceed the maximum misorientation of its Laue class
+      const float maxAngle[Ebsd::CrystalStructure::LaueGroupEnd] =
+      {
+        93.84f, 62.80f, 180.0f, 90.0f, 180.0f, 180.0f, 120.0f, 180.0f, 98.43f, 180.0f, 104.48f
+      };
+      for (unsigned int cs = 0; cs < Ebsd::CrystalStructure::LaueGroupEnd; cs++)
+      {
+        for (int t = 0; t < 1000; t++)
+        {
+          QuatF qa = RandomQuat();
+          QuatF qb = RandomQuat();
+          float w = ops[cs]->getMisoQuat(qa, qb, n1, n2, n3);
+          DREAM3D_REQUIRE(w >= 0.0f)
+          DREAM3D_REQUIRE(w <= maxAngle[cs] * SIMPLib::Constants::k_PiOver180 + 1.0E-3f)
+          float angle = LaueMisorientationAngle(cs, qa, qb);
+          DREAM3D_REQUIRE(angle <= maxAngle[cs] * SIMPLib::Constants::k_PiOver180 + 1.0E-3f)
+        }
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestCubicClosedForm()
+    {
+      // The closed form Cubic-High misorientation must agree with the search over all operators
+      srand(54321);
+      for (int t = 0; t < 1000; t++)
+      {
+        QuatF q1 = RandomQuat();
+        QuatF q2 = RandomQuat();
+        QuatF q2inv;
+        QuatF qr;
+        QuatF qc;
+        QuaternionMathF::Conjugate(q2, q2inv);
+        QuaternionMathF::Multiply(q1, q2inv, qr);
+        float wmax = 0.0f;
+        for (int i = 0; i < LaueOps<Ebsd::CrystalStructure::Cubic_High>::k_NumSymOps; i++)
+        {
+          QuaternionMathF::Multiply(LaueOps<Ebsd::CrystalStructure::Cubic_High>::getQuatSymOp(i), qr, qc);
+          wmax = std::max(wmax, std::fabs(qc.w));
+        }
+        float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+        float w = LaueOps<Ebsd::CrystalStructure::Cubic_High>::getMisoQuat(q1, q2, n1, n2, n3);
+        DREAM3D_REQUIRE(std::fabs(w - 2.0f * std::acos(std::min(wmax, 1.0f))) < 1.0E-3f)
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestIPFColors()
+    {
+      // The batched IPF colors must match the scalar ones up to rounding of the last bit
+      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+      srand(24680);
+      const size_t numOrientations = 2000;
+      std::vector<float> eulers(numOrientations * 3);
+      std::vector<float> refDirs(numOrientations * 3);
+      for (size_t i = 0; i < numOrientations; i++)
+      {
+        eulers[3 * i] = static_cast<float>(rand()) / RAND_MAX * SIMPLib::Constants::k_2Pi;
+        eulers[3 * i + 1] = static_cast<float>(rand()) / RAND_MAX * SIMPLib::Constants::k_Pi;
+        eulers[3 * i + 2] = static_cast<float>(rand()) / RAND_MAX * SIMPLib::Constants::k_2Pi;
+        refDirs[3 * i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+        refDirs[3 * i + 1] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+        refDirs[3 * i + 2] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+      }
+
+      for (unsigned int cs = 0; cs < Ebsd::CrystalStructure::LaueGroupEnd; cs++)
+      {
+        std::vector<uint8_t> rgb(numOrientations * 3, 0);
+        LaueIPFColorBatch batch;
+        for (size_t i = 0; i < numOrientations; i++)
+        {
+          batch.add(cs, &(eulers[3 * i]), &(refDirs[3 * i]), &(rgb[3 * i]));
+        }
+        batch.flush();
+
+        for (size_t i = 0; i < numOrientations; i++)
+        {
+          SIMPL::Rgb argb = ops[cs]->generateIPFColor(eulers[3 * i], eulers[3 * i + 1], eulers[3 * i + 2], refDirs[3 * i], refDirs[3 * i + 1], refDirs[3 * i + 2], false);
+          DREAM3D_REQUIRE(std::abs(static_cast<int>(RgbColor::dRed(argb)) - static_cast<int>(rgb[3 * i])) <= 2)
+          DREAM3D_REQUIRE(std::abs(static_cast<int>(RgbColor::dGreen(argb)) - static_cast<int>(rgb[3 * i + 1])) <= 2)
+          DREAM3D_REQUIRE(std::abs(static_cast<int>(RgbColor::dBlue(argb)) - static_cast<int>(rgb[3 * i + 2])) <= 2)
+        }
+      }
+    }
+
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestDispatch() )
+      DREAM3D_REGISTER_TEST( TestMisorientationAngle() )
+      DREAM3D_REGISTER_TEST( TestCubicClosedForm() )
+      DREAM3D_REGISTER_TEST( TestIPFColors() )
+      DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+    }
+
+  private:
+    LaueOpsTest(const LaueOpsTest&); // Copy Constructor Not Implemented
+    void operator=(const LaueOpsTest&); // Operator '=' Not Implemented
+};
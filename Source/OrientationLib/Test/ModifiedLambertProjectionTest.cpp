@@ -0,0 +1,359 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
+
+#include "OrientationLibTestFileLocations.h"
+
+/**
+ * @brief The LambertReference struct is the per point computation the projection used
+ * before points were converted in batches and binned into per thread squares: the
+ * square coordinate of one point, followed by the bilinear update of the four bins
+ * around it.
+ */
+struct LambertReference
+{
+  int dimension;
+  float sphereRadius;
+  float stepSize;
+  float maxCoord;
+  float halfDimensionTimesStepSize;
+
+  LambertReference(int dims, float radius) :
+    dimension(dims),
+    sphereRadius(radius)
+  {
+    float halfSphereArea = 4 * M_PI * radius * radius / 2.0;
+    float squareEdge = sqrt(halfSphereArea);
+    stepSize = squareEdge / static_cast<float>(dims);
+    maxCoord = squareEdge / 2.0;
+    float halfDimension = static_cast<float>(dims) / 2.0;
+    halfDimensionTimesStepSize = halfDimension * stepSize;
+  }
+
+  bool getSquareCoord(const float* xyz, float* sqCoord) const
+  {
+    bool nhCheck = false;
+    float adjust = 1.0;
+    if(xyz[2] >= 0.0)
+    {
+      adjust = -1.0;
+      nhCheck = true;
+    }
+    if(xyz[0] == 0 && xyz[1] == 0)
+    {
+      sqCoord[0] = 0.0;
+      sqCoord[1] = 0.0;
+      return nhCheck;
+    }
+    if(fabs(xyz[0]) >= fabs(xyz[1]))
+    {
+      sqCoord[0] = (xyz[0] / fabs(xyz[0]) ) * sqrt(2.0 * sphereRadius * (sphereRadius + (xyz[2] * adjust) ) ) * SIMPLib::Constants::k_HalfOfSqrtPi;
+      sqCoord[1] = (xyz[0] / fabs(xyz[0]) ) * sqrt(2.0 * sphereRadius * (sphereRadius + (xyz[2] * adjust) ) ) * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(xyz[1] / xyz[0]));
+    }
+    else
+    {
+      sqCoord[0] = (xyz[1] / fabs(xyz[1])) * sqrt(2.0 * sphereRadius * (sphereRadius + (xyz[2] * adjust))) * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(xyz[0] / xyz[1]));
+      sqCoord[1] = (xyz[1] / fabs(xyz[1])) * sqrt(2.0 * sphereRadius * (sphereRadius + (xyz[2] * adjust))) * (SIMPLib::Constants::k_HalfOfSqrtPi);
+    }
+    if (sqCoord[0] >= maxCoord)
+    {
+      sqCoord[0] = (maxCoord) - .0001;
+    }
+    if (sqCoord[1] >= maxCoord)
+    {
+      sqCoord[1] = (maxCoord) - .0001;
+    }
+    return nhCheck;
+  }
+
+  void getStencil(const float* sqCoord, int index[4], float& modX, float& modY) const
+  {
+    int abin1 = 0, bbin1 = 0;
+    int abin2 = 0, bbin2 = 0;
+    int abin3 = 0, bbin3 = 0;
+    int abin4 = 0, bbin4 = 0;
+    int abinSign, bbinSign;
+    modX = (sqCoord[0] + halfDimensionTimesStepSize ) / stepSize;
+    modY = (sqCoord[1] + halfDimensionTimesStepSize ) / stepSize;
+    int abin = (int) modX;
+    int bbin = (int) modY;
+    modX -= abin;
+    modY -= bbin;
+    modX -= 0.5;
+    modY -= 0.5;
+    if(modX == 0.0) { abinSign = 1; }
+    else { abinSign = modX / fabs(modX); }
+    if(modY == 0.0) { bbinSign = 1; }
+    else { bbinSign = modY / fabs(modY); }
+    abin1 = abin;
+    bbin1 = bbin;
+    abin2 = abin + abinSign;
+    bbin2 = bbin;
+    if(abin2 < 0 || abin2 > dimension - 1)
+    {
+      abin2 = abin2 - (abinSign * dimension), bbin2 = dimension - bbin2 - 1;
+    }
+    abin3 = abin;
+    bbin3 = bbin + bbinSign;
+    if(bbin3 < 0 || bbin3 > dimension - 1)
+    {
+      abin3 = dimension - abin3 - 1, bbin3 = bbin3 - (bbinSign * dimension);
+    }
+    abin4 = abin + abinSign;
+    bbin4 = bbin + bbinSign;
+    if((abin4 < 0 || abin4 > dimension - 1) && (bbin4 >= 0 && bbin4 <= dimension - 1))
+    {
+      abin4 = abin4 - (abinSign * dimension), bbin4 = dimension - bbin4 - 1;
+    }
+    else if((abin4 >= 0 && abin4 <= dimension - 1) && (bbin4 < 0 || bbin4 > dimension - 1))
+    {
+      abin4 = dimension - abin4 - 1, bbin4 = bbin4 - (bbinSign * dimension);
+    }
+    else if((abin4 < 0 || abin4 > dimension - 1) && (bbin4 < 0 || bbin4 > dimension - 1))
+    {
+      abin4 = abin4 - (abinSign * dimension), bbin4 = bbin4 - (bbinSign * dimension);
+    }
+    modX = fabs(modX);
+    modY = fabs(modY);
+    index[0] = bbin1 * dimension + abin1;
+    index[1] = bbin2 * dimension + abin2;
+    index[2] = bbin3 * dimension + abin3;
+    index[3] = bbin4 * dimension + abin4;
+  }
+
+  void addInterpolatedValues(std::vector<double>& square, const float* sqCoord, double value) const
+  {
+    int index[4];
+    float modX = 0.0f, modY = 0.0f;
+    getStencil(sqCoord, index, modX, modY);
+    double v1 = square[index[0]] + value * (1.0 - modX) * (1.0 - modY);
+    double v2 = square[index[1]] + value * (modX) * (1.0 - modY);
+    double v3 = square[index[2]] + value * (1.0 - modX) * (modY);
+    double v4 = square[index[3]] + value * (modX) * (modY);
+    square[index[0]] = v1;
+    square[index[1]] = v2;
+    square[index[2]] = v3;
+    square[index[3]] = v4;
+  }
+
+  float getInterpolatedValue(const std::vector<double>& square, const float* sqCoord) const
+  {
+    int index[4];
+    float modX = 0.0f, modY = 0.0f;
+    getStencil(sqCoord, index, modX, modY);
+    float intensity1 = square[index[0]];
+    float intensity2 = square[index[1]];
+    float intensity3 = square[index[2]];
+    float intensity4 = square[index[3]];
+    return ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
+  }
+};
+
+class ModifiedLambertProjectionTest
+{
+  public:
+    ModifiedLambertProjectionTest() :
+      m_Seed(20160602u)
+    {}
+    virtual ~ModifiedLambertProjectionTest(){}
+    SIMPL_TYPE_MACRO(ModifiedLambertProjectionTest)
+
+    // -----------------------------------------------------------------------------
+    // Uniform random number in [0, 1)
+    // -----------------------------------------------------------------------------
+    float NextRandom()
+    {
+      m_Seed = m_Seed * 1103515245u + 12345u;
+      return static_cast<float>((m_Seed >> 8) & 0xFFFFFF) / 16777216.0f;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Random points on the sphere, led by the points where the sector or the
+    // hemisphere of the projection changes: the poles, the axes and the diagonals
+    // of the equator and of both hemispheres
+    // -----------------------------------------------------------------------------
+    FloatArrayType::Pointer CreateSpherePoints(size_t numPoints, float sphereRadius)
+    {
+      QVector<size_t> cDims(1, 3);
+      FloatArrayType::Pointer coords = FloatArrayType::CreateArray(numPoints, cDims, "SpherePoints");
+      const float s = sqrtf(0.5f);
+      const float t = sqrtf(1.0f / 3.0f);
+      const float special[][3] = {
+        { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f },
+        { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+        { s, s, 0.0f }, { -s, s, 0.0f }, { s, -s, 0.0f }, { -s, -s, 0.0f },
+        { t, t, t }, { -t, t, -t }, { t, -t, -t }, { -t, -t, t },
+        { s, 0.0f, s }, { 0.0f, -s, -s }
+      };
+      size_t numSpecial = sizeof(special) / sizeof(special[0]);
+      for (size_t i = 0; i < numPoints; i++)
+      {
+        float* p = coords->getPointer(3 * i);
+        if (i < numSpecial)
+        {
+          p[0] = special[i][0];
+          p[1] = special[i][1];
+          p[2] = special[i][2];
+        }
+        else
+        {
+          float z = 2.0f * NextRandom() - 1.0f;
+          float phi = SIMPLib::Constants::k_2Pi * NextRandom();
+          float r = sqrtf(std::max(0.0f, 1.0f - z * z));
+          p[0] = r * cosf(phi);
+          p[1] = r * sinf(phi);
+          p[2] = z;
+        }
+        for (int k = 0; k < 3; k++) { p[k] *= sphereRadius; }
+      }
+      return coords;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The batched, branch reduced square coordinates match the per point computation
+    // -----------------------------------------------------------------------------
+    int TestSquareCoords()
+    {
+      const float radii[2] = { 1.0f, 2.5f };
+      for (int r = 0; r < 2; r++)
+      {
+        size_t numPoints = 600;
+        FloatArrayType::Pointer coords = CreateSpherePoints(numPoints, radii[r]);
+        ModifiedLambertProjection::Pointer projection = ModifiedLambertProjection::New();
+        projection->initializeSquares(22, radii[r]);
+        LambertReference reference(22, radii[r]);
+
+        std::vector<float> sqCoords(2 * numPoints, 0.0f);
+        bool* batchNhCheck = new bool[numPoints];
+        projection->getSquareCoords(coords->getPointer(0), numPoints, &(sqCoords.front()), batchNhCheck);
+        for (size_t i = 0; i < numPoints; i++)
+        {
+          float expected[2] = { 0.0f, 0.0f };
+          bool expectedNorth = reference.getSquareCoord(coords->getPointer(3 * i), expected);
+
+          float sqCoord[2] = { 0.0f, 0.0f };
+          bool north = projection->getSquareCoord(coords->getPointer(3 * i), sqCoord);
+          DREAM3D_REQUIRE_EQUAL(north, expectedNorth)
+          DREAM3D_REQUIRE_EQUAL(batchNhCheck[i], expectedNorth)
+          for (int k = 0; k < 2; k++)
+          {
+            float tolerance = 1.0E-6f * (1.0f + fabsf(expected[k]));
+            DREAM3D_REQUIRE(fabsf(sqCoord[k] - expected[k]) <= tolerance)
+            DREAM3D_REQUIRE(fabsf(sqCoords[2 * i + k] - expected[k]) <= tolerance)
+          }
+        }
+        delete[] batchNhCheck;
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // CreateProjectionFromXYZCoords bins the same values as adding the points one by
+    // one. The larger point count takes the per thread squares path. The atan overload
+    // picked up here may round differently than the one in the library, which moves
+    // a square coordinate by an ulp, so the bins are compared to a relative 1e-5.
+    // -----------------------------------------------------------------------------
+    int TestProjectionBinning()
+    {
+      const size_t pointCounts[3] = { 1, 600, 9000 };
+      const int dims[3] = { 22, 7, 22 };
+      for (int c = 0; c < 3; c++)
+      {
+        float sphereRadius = 1.0f;
+        FloatArrayType::Pointer coords = CreateSpherePoints(pointCounts[c], sphereRadius);
+        ModifiedLambertProjection::Pointer projection = ModifiedLambertProjection::CreateProjectionFromXYZCoords(coords.get(), dims[c], sphereRadius);
+        DREAM3D_REQUIRE_VALID_POINTER(projection.get())
+
+        LambertReference reference(dims[c], sphereRadius);
+        size_t squareSize = static_cast<size_t>(dims[c] * dims[c]);
+        std::vector<double> north(squareSize, 0.0);
+        std::vector<double> south(squareSize, 0.0);
+        for (size_t i = 0; i < pointCounts[c]; i++)
+        {
+          float sqCoord[2] = { 0.0f, 0.0f };
+          bool nhCheck = reference.getSquareCoord(coords->getPointer(3 * i), sqCoord);
+          reference.addInterpolatedValues(nhCheck ? north : south, sqCoord, 1.0);
+        }
+
+        DoubleArrayType::Pointer northSquare = projection->getNorthSquare();
+        DoubleArrayType::Pointer southSquare = projection->getSouthSquare();
+        DREAM3D_REQUIRE_EQUAL(northSquare->getNumberOfTuples(), squareSize)
+        DREAM3D_REQUIRE_EQUAL(southSquare->getNumberOfTuples(), squareSize)
+        for (size_t i = 0; i < squareSize; i++)
+        {
+          DREAM3D_REQUIRE(fabs(northSquare->getValue(i) - north[i]) <= 1.0E-5 * (1.0 + north[i]))
+          DREAM3D_REQUIRE(fabs(southSquare->getValue(i) - south[i]) <= 1.0E-5 * (1.0 + south[i]))
+        }
+
+        // Reading the squares back goes through the same stencil
+        for (size_t i = 0; i < std::min(pointCounts[c], static_cast<size_t>(300)); i++)
+        {
+          float sqCoord[2] = { 0.0f, 0.0f };
+          bool nhCheck = reference.getSquareCoord(coords->getPointer(3 * i), sqCoord);
+          float expected = reference.getInterpolatedValue(nhCheck ? north : south, sqCoord);
+          ModifiedLambertProjection::Square square = nhCheck ? ModifiedLambertProjection::NorthSquare : ModifiedLambertProjection::SouthSquare;
+          double value = projection->getInterpolatedValue(square, sqCoord);
+          DREAM3D_REQUIRE(fabs(value - expected) <= 1.0E-5 * (1.0 + fabs(expected)))
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestSquareCoords())
+      DREAM3D_REGISTER_TEST(TestProjectionBinning())
+    }
+
+  private:
+    uint32_t m_Seed;
+
+    ModifiedLambertProjectionTest(const ModifiedLambertProjectionTest&); // Copy Constructor Not Implemented
+    void operator=(const ModifiedLambertProjectionTest&); // Operator '=' Not Implemented
+};
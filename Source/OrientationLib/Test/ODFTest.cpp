@@ -34,20 +34,20 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 
-/**
- * @brief main.cpp This is mainly a test to make sure that the Texture.h
- * file will compile using strict STL containers
- * @param argc
- * @param argv
- * @return
- */
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
 
+#include "OrientationLib/Texture/ODFSampler.hpp"
 #include "OrientationLib/Texture/Texture.hpp"
 #include "OrientationLib/Texture/StatsGen.hpp"
 
+#include "OrientationLibTestFileLocations.h"
+
 #define POPULATE_DATA(i, e1, e2, e3, w, s)\
   e1s[i] = e1;\
   e2s[i] = e2;\
@@ -61,7 +61,10 @@ class ODFTest
     ODFTest(){}
     virtual ~ODFTest(){}
 
-    void operator()()
+    // -----------------------------------------------------------------------------
+    // Cubic ODF with two Gaussian texture components
+    // -----------------------------------------------------------------------------
+    std::vector<float> CreateCubicODF()
     {
       // Resize the ODF vector properly for Cubic
       std::vector<float> odf(CubicOps::k_OdfSize);
@@ -75,33 +78,152 @@ class ODFTest
       POPULATE_DATA(1, 59, 37, 63, 1000.0, 1.0)
 
       // Calculate the ODF Data
-
       size_t numEntries = e1s.size();
       Texture::CalculateCubicODFData(&(e1s.front()), &(e2s.front()), &(e3s.front()),
                                      &(weights.front()), &(sigmas.front()), true,
                                      &(odf.front()), numEntries);
+      return odf;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The linear walk over the cumulative density that the sampler replaced: the
+    // first bin whose cumulative density is larger than the random value, or bin 0
+    // if the random value is past the total density
+    // -----------------------------------------------------------------------------
+    int32_t BruteForceBin(const std::vector<float>& odf, double random)
+    {
+      double totaldensity = 0.0;
+      for (size_t j = 0; j < odf.size(); j++)
+      {
+        double td1 = totaldensity;
+        totaldensity = totaldensity + static_cast<double>(odf[j]);
+        if (random < totaldensity && random >= td1) { return static_cast<int32_t>(j); }
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Compares pickBin() with the linear walk for random values and for values that
+    // fall exactly on the bin boundaries
+    // -----------------------------------------------------------------------------
+    int CompareWithBruteForce(const std::vector<float>& odf, uint32_t seed)
+    {
+      ODFSampler<float> sampler(&(odf.front()), odf.size());
+      DREAM3D_REQUIRE_EQUAL(sampler.getNumberOfBins(), odf.size())
+
+      std::vector<double> randoms;
+      double total = 0.0;
+      randoms.push_back(0.0);
+      for (size_t j = 0; j < odf.size(); j++)
+      {
+        total += static_cast<double>(odf[j]);
+        if (total < 1.0) { randoms.push_back(total); }
+      }
+      SIMPL_RANDOMNG_NEW_SEEDED(seed)
+      for (size_t i = 0; i < 20000; i++)
+      {
+        randoms.push_back(rg.genrand_res53());
+      }
 
-      size_t npoints = 1000;
-      std::vector<float > x001(npoints * 3);
-      std::vector<float > y001(npoints * 3);
-      std::vector<float > x011(npoints * 6);
-      std::vector<float > y011(npoints * 6);
-      std::vector<float > x111(npoints * 4);
-      std::vector<float > y111(npoints * 4);
+      for (size_t i = 0; i < randoms.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(sampler.pickBin(randoms[i]), BruteForceBin(odf, randoms[i]))
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestODFSamplerBins()
+    {
+      std::vector<float> cubic = CreateCubicODF();
+      DREAM3D_REQUIRE_EQUAL(CompareWithBruteForce(cubic, 101), EXIT_SUCCESS)
+
+      // Unnormalized densities: the values past a total below 1 select bin 0
+      const size_t numBins = 5000;
+      std::vector<float> odf(numBins, 0.0f);
+      uint32_t lcg = 2016u;
+      for (size_t j = 0; j < numBins; j++)
+      {
+        lcg = lcg * 1103515245u + 12345u;
+        odf[j] = static_cast<float>((lcg >> 16) % 1000) / 1000.0f;
+      }
+      float sum = 0.0f;
+      for (size_t j = 0; j < numBins; j++) { sum += odf[j]; }
+      const float totals[2] = { 0.7f, 1.3f };
+      for (int t = 0; t < 2; t++)
+      {
+        std::vector<float> scaled(odf);
+        for (size_t j = 0; j < numBins; j++) { scaled[j] *= totals[t] / sum; }
+        DREAM3D_REQUIRE_EQUAL(CompareWithBruteForce(scaled, 202 + t), EXIT_SUCCESS)
+      }
+
+      // Mostly empty bins with a few spikes, including the first and last bin
+      std::vector<float> sparse(numBins, 0.0f);
+      sparse[0] = 0.1f;
+      sparse[1234] = 0.25f;
+      sparse[1235] = 0.25f;
+      sparse[4000] = 0.15f;
+      sparse[numBins - 1] = 0.25f;
+      DREAM3D_REQUIRE_EQUAL(CompareWithBruteForce(sparse, 303), EXIT_SUCCESS)
+
+      // All density in one bin, and no density at all
+      std::vector<float> spike(numBins, 0.0f);
+      spike[2500] = 1.0f;
+      DREAM3D_REQUIRE_EQUAL(CompareWithBruteForce(spike, 404), EXIT_SUCCESS)
+      std::vector<float> empty(numBins, 0.0f);
+      DREAM3D_REQUIRE_EQUAL(CompareWithBruteForce(empty, 505), EXIT_SUCCESS)
+
+      return EXIT_SUCCESS;
+    }
 
+    // -----------------------------------------------------------------------------
+    // Rebuilds the Euler angles of generateEulerAngles() serially: the bins of each
+    // chunk of points come from the stream of that chunk and are picked with the
+    // linear walk, and point i is placed in its bin with the seed (seed + i + 1)
+    // -----------------------------------------------------------------------------
+    int TestODFSamplerEulerAngles()
+    {
+      std::vector<float> odf = CreateCubicODF();
+      ODFSampler<float> sampler(&(odf.front()), odf.size());
 
+      const uint64_t seed = 1465000000000ULL;
+      const size_t npoints = 2 * ODFSampler<float>::ChunkSize + 300;
+      std::vector<float> eulers(3 * npoints, -1.0f);
+      sampler.generateEulerAngles<CubicOps>(seed, &(eulers.front()), npoints);
 
-      int err = 0;
-      //  err = StatsGen::GenCubicODFPlotData(&(odf.front()), &(x001.front()), &(y001.front()), &(x011.front()),
-      //                                     &(y011.front()), &(x111.front()), &(y111.front()), npoints);
-      if (err == 1)
+      CubicOps ops;
+      size_t numChunks = (npoints + ODFSampler<float>::ChunkSize - 1) / ODFSampler<float>::ChunkSize;
+      for (size_t c = 0; c < numChunks; c++)
       {
-        //TODO: Present Error Message
-        return;
+        SIMPL_RANDOMNG_NEW_SEEDED(ODFSampler<float>::StreamSeed(seed, c))
+        size_t start = c * ODFSampler<float>::ChunkSize;
+        size_t end = std::min(start + ODFSampler<float>::ChunkSize, npoints);
+        for (size_t i = start; i < end; i++)
+        {
+          int32_t choose = BruteForceBin(odf, rg.genrand_res53());
+          FOrientArrayType eu = ops.determineEulerAngles(seed + i + 1, choose);
+          for (size_t k = 0; k < 3; k++)
+          {
+            DREAM3D_REQUIRE_EQUAL(eulers[3 * i + k], eu[k])
+          }
+        }
       }
 
+      return EXIT_SUCCESS;
+    }
 
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestODFSamplerBins() )
+      DREAM3D_REGISTER_TEST( TestODFSamplerEulerAngles() )
     }
+
   private:
     ODFTest(const ODFTest&); // Copy Constructor Not Implemented
     void operator=(const ODFTest&); // Operator '=' Not Implemented
@@ -53,6 +53,7 @@
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/OrientationMath/OrientationConverter.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransformsBatch.hpp"
 
 
 #include "OrientationLibTestFileLocations.h"
@@ -606,6 +607,229 @@ class OrientationTransformsTest
     }
 
 
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    template<typename K>
+    bool BatchValueMatches(K batch, K scalar, bool isAngle, K tol)
+    {
+      if(batch == scalar) { return true; }
+      if(std::isinf(batch) || std::isinf(scalar)) { return false; }
+      K delta = std::fabs(batch - scalar);
+      if(isAngle == true)
+      {
+        // The scalar code wraps with fmod() while the batch code adds 2Pi, which can differ by a full turn
+        delta = std::fabs(delta - SIMPLib::Constants::k_2Pi) < delta ? std::fabs(delta - SIMPLib::Constants::k_2Pi) : delta;
+      }
+      K mag = std::fabs(scalar) > 1.0 ? std::fabs(scalar) : 1.0;
+      return delta <= tol * mag;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Converts a single orientation of any representation back into a matrix
+    // -----------------------------------------------------------------------------
+    void BatchToMatrix(int rep, OrientationArray<double>& in, OrientationArray<double>& om)
+    {
+      typedef OrientationTransforms<OrientationArray<double>, double> OrTr_Type;
+      switch(rep)
+      {
+        case 0: OrTr_Type::eu2om(in, om); break;
+        case 2: OrTr_Type::qu2om(in, om); break;
+        case 3: OrTr_Type::ax2om(in, om); break;
+        case 4: OrTr_Type::ro2om(in, om); break;
+        case 5: OrTr_Type::ho2om(in, om); break;
+        case 6: OrTr_Type::cu2om(in, om); break;
+        default: for(int c = 0; c < 9; c++) { om[c] = in[c]; }
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    // The batch kernels compute in double for both types, so the reference is the
+    // scalar code run in double on the same inputs. Close to a half turn om2qu picks
+    // the signs of the vector part from differences of matrix elements, which the
+    // scalar code does too, so for matrix inputs the batch output is converted back
+    // and compared as a rotation with the 2.5E-3 that this achieves.
+    // -----------------------------------------------------------------------------
+    template<typename K>
+    int CompareBatchPair(const char* name, const std::vector<K>& input, int inRep, const std::vector<K>& batch, const std::vector<double>& scalar, int outRep, size_t nTuples, bool halfTurns)
+    {
+      K tol = static_cast<K>(1.0E-6);
+      double rotationTol = 2.5E-3;
+      int inComps = k_CompDims[inRep];
+      int outComps = k_CompDims[outRep];
+      for(size_t t = 0; t < nTuples; t++)
+      {
+        if(halfTurns == true && inRep == 1)
+        {
+          std::vector<double> out(batch.begin() + t * outComps, batch.begin() + (t + 1) * outComps);
+          double matrix[9] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+          OrientationArray<double> outArray(&(out[0]), outComps);
+          OrientationArray<double> omArray(matrix, 9);
+          BatchToMatrix(outRep, outArray, omArray);
+          for(int c = 0; c < 9; c++)
+          {
+            bool matches = std::fabs(matrix[c] - static_cast<double>(input[t * inComps + c])) <= rotationTol;
+            if(matches == false) { std::cout << name << " tuple " << t << ": " << matrix[c] << " != " << input[t * inComps + c] << std::endl; }
+            DREAM3D_REQUIRE_EQUAL(matches, true)
+          }
+          continue;
+        }
+        for(int c = 0; c < outComps; c++)
+        {
+          size_t v = t * outComps + c;
+          bool matches = BatchValueMatches<K>(batch[v], static_cast<K>(scalar[v]), outRep == 0, tol);
+          if(matches == false) { std::cout << name << " tuple " << t << ": " << batch[v] << " != " << scalar[v] << std::endl; }
+          DREAM3D_REQUIRE_EQUAL(matches, true)
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    template<typename K>
+    void TestBatchConversions(bool halfTurns)
+    {
+      typedef OrientationArray<K> OrientationArrayType;
+      typedef OrientationTransforms<OrientationArrayType, K> OrTr_Type;
+      typedef OrientationTransforms<OrientationArray<double>, double> DoubleTr_Type;
+      typedef OrientationTransformsBatch<K> Batch_Type;
+
+      // Enough tuples that the batch code splits the work across several blocks. The
+      // regular grid is offset so no rotation is exactly 180 degrees, where the sign
+      // of the axis is arbitrary and may legitimately differ between the two code
+      // paths. The half turn set approaches 180 degrees from both Euler families,
+      // Phi close to Pi and phi1 + phi2 close to Pi with a small Phi.
+      size_t nSteps = 16;
+      size_t nTuples = nSteps * nSteps * nSteps;
+      K phi1Inc = SIMPLib::Constants::k_2Pi / static_cast<K>(nSteps);
+      K phiInc = SIMPLib::Constants::k_Pi / static_cast<K>(nSteps);
+      K phi2Inc = SIMPLib::Constants::k_2Pi / static_cast<K>(nSteps);
+
+      std::vector<std::vector<K> > reps(7);
+      for(int r = 0; r < 7; r++)
+      {
+        reps[r].resize(nTuples * k_CompDims[r]);
+      }
+
+      size_t idx = 0;
+      for(size_t i = 0; i < nSteps; i++)
+      {
+        for(size_t j = 0; j < nSteps; j++)
+        {
+          for(size_t k = 0; k < nSteps; k++)
+          {
+            K offset = static_cast<K>(1.0E-5 + 1.0E-3 * static_cast<double>(k) / static_cast<double>(nSteps));
+            reps[0][idx * 3] = (static_cast<K>(i) + 0.25) * phi1Inc;
+            if(halfTurns == false)
+            {
+              reps[0][idx * 3 + 1] = (static_cast<K>(j) + 0.3) * phiInc;
+              reps[0][idx * 3 + 2] = (static_cast<K>(k) + 0.4) * phi2Inc;
+            }
+            else if(j % 2 == 0)
+            {
+              reps[0][idx * 3 + 1] = SIMPLib::Constants::k_Pi - offset;
+              reps[0][idx * 3 + 2] = (static_cast<K>(j) + 0.4) * phi2Inc;
+            }
+            else
+            {
+              K phi2 = SIMPLib::Constants::k_Pi - reps[0][idx * 3] - offset;
+              reps[0][idx * 3 + 1] = offset * static_cast<K>(j);
+              reps[0][idx * 3 + 2] = phi2 < 0.0 ? phi2 + SIMPLib::Constants::k_2Pi : phi2;
+            }
+            idx++;
+          }
+        }
+      }
+
+      // The inputs for the other representations come from the scalar code
+      for(size_t t = 0; t < nTuples; t++)
+      {
+        OrientationArrayType eu(&(reps[0][t * 3]), 3);
+        OrientationArrayType om(&(reps[1][t * 9]), 9);
+        OrientationArrayType qu(&(reps[2][t * 4]), 4);
+        OrientationArrayType ax(&(reps[3][t * 4]), 4);
+        OrientationArrayType ro(&(reps[4][t * 4]), 4);
+        OrientationArrayType ho(&(reps[5][t * 3]), 3);
+        OrientationArrayType cu(&(reps[6][t * 3]), 3);
+        OrTr_Type::eu2om(eu, om);
+        OrTr_Type::eu2qu(eu, qu);
+        OrTr_Type::eu2ax(eu, ax);
+        OrTr_Type::eu2ro(eu, ro);
+        OrTr_Type::eu2ho(eu, ho);
+        OrTr_Type::eu2cu(eu, cu);
+      }
+
+      std::vector<K> batch;
+      std::vector<double> scalar;
+      std::vector<double> input;
+
+#define CHECK_BATCH_PAIR(name, inRep, outRep)\
+  batch.assign(nTuples * k_CompDims[outRep], 0);\
+  scalar.assign(nTuples * k_CompDims[outRep], 0);\
+  Batch_Type::name(&(reps[inRep][0]), &(batch[0]), nTuples);\
+  for(size_t t = 0; t < nTuples; t++)\
+  {\
+    input.assign(reps[inRep].begin() + t * k_CompDims[inRep], reps[inRep].begin() + (t + 1) * k_CompDims[inRep]);\
+    OrientationArray<double> in(&(input[0]), k_CompDims[inRep]);\
+    OrientationArray<double> out(&(scalar[t * k_CompDims[outRep]]), k_CompDims[outRep]);\
+    DoubleTr_Type::name(in, out);\
+  }\
+  DREAM3D_REQUIRE_EQUAL(CompareBatchPair<K>(#name, reps[inRep], inRep, batch, scalar, outRep, nTuples, halfTurns), EXIT_SUCCESS)
+
+      CHECK_BATCH_PAIR(eu2om, 0, 1)
+      CHECK_BATCH_PAIR(eu2qu, 0, 2)
+      CHECK_BATCH_PAIR(eu2ax, 0, 3)
+      CHECK_BATCH_PAIR(eu2ro, 0, 4)
+      CHECK_BATCH_PAIR(eu2ho, 0, 5)
+      CHECK_BATCH_PAIR(eu2cu, 0, 6)
+
+      CHECK_BATCH_PAIR(om2eu, 1, 0)
+      CHECK_BATCH_PAIR(om2qu, 1, 2)
+      CHECK_BATCH_PAIR(om2ax, 1, 3)
+      CHECK_BATCH_PAIR(om2ro, 1, 4)
+      CHECK_BATCH_PAIR(om2ho, 1, 5)
+      CHECK_BATCH_PAIR(om2cu, 1, 6)
+
+      CHECK_BATCH_PAIR(qu2eu, 2, 0)
+      CHECK_BATCH_PAIR(qu2om, 2, 1)
+      CHECK_BATCH_PAIR(qu2ax, 2, 3)
+      CHECK_BATCH_PAIR(qu2ro, 2, 4)
+      CHECK_BATCH_PAIR(qu2ho, 2, 5)
+      CHECK_BATCH_PAIR(qu2cu, 2, 6)
+
+      CHECK_BATCH_PAIR(ax2eu, 3, 0)
+      CHECK_BATCH_PAIR(ax2om, 3, 1)
+      CHECK_BATCH_PAIR(ax2qu, 3, 2)
+      CHECK_BATCH_PAIR(ax2ro, 3, 4)
+      CHECK_BATCH_PAIR(ax2ho, 3, 5)
+      CHECK_BATCH_PAIR(ax2cu, 3, 6)
+
+      CHECK_BATCH_PAIR(ro2eu, 4, 0)
+      CHECK_BATCH_PAIR(ro2om, 4, 1)
+      CHECK_BATCH_PAIR(ro2qu, 4, 2)
+      CHECK_BATCH_PAIR(ro2ax, 4, 3)
+      CHECK_BATCH_PAIR(ro2ho, 4, 5)
+      CHECK_BATCH_PAIR(ro2cu, 4, 6)
+
+      CHECK_BATCH_PAIR(ho2eu, 5, 0)
+      CHECK_BATCH_PAIR(ho2om, 5, 1)
+      CHECK_BATCH_PAIR(ho2qu, 5, 2)
+      CHECK_BATCH_PAIR(ho2ax, 5, 3)
+      CHECK_BATCH_PAIR(ho2ro, 5, 4)
+      CHECK_BATCH_PAIR(ho2cu, 5, 6)
+
+      CHECK_BATCH_PAIR(cu2eu, 6, 0)
+      CHECK_BATCH_PAIR(cu2om, 6, 1)
+      CHECK_BATCH_PAIR(cu2qu, 6, 2)
+      CHECK_BATCH_PAIR(cu2ax, 6, 3)
+      CHECK_BATCH_PAIR(cu2ro, 6, 4)
+      CHECK_BATCH_PAIR(cu2ho, 6, 5)
+
+#undef CHECK_BATCH_PAIR
+    }
+
     // -----------------------------------------------------------------------------
     //
     // -----------------------------------------------------------------------------
@@ -664,6 +888,10 @@ class OrientationTransformsTest
 
       StartTest();
 
+      DREAM3D_REGISTER_TEST( TestBatchConversions<double>(false) );
+      DREAM3D_REGISTER_TEST( TestBatchConversions<double>(true) );
+      DREAM3D_REGISTER_TEST( TestBatchConversions<float>(false) );
+      DREAM3D_REGISTER_TEST( TestBatchConversions<float>(true) );
 
       DREAM3D_REGISTER_TEST( RemoveTestFiles() );
     }
@@ -75,6 +75,47 @@ class SO3SamplerTest
       DREAM3D_REQUIRE_EQUAL(333227, orientations.size());
     }
 
+    /**
+     * @brief Counts the points of every slice. Each slice has its own counter so the
+     * slices can be delivered from several threads at once.
+     */
+    class SliceCounter : public SO3Sampler::SampleCallback
+    {
+      public:
+        SliceCounter(int nsteps) : m_NSteps(nsteps), m_Counts(2 * nsteps, 0) {}
+        virtual ~SliceCounter() {}
+        virtual void processSlice(int slice, const double* rods, size_t count)
+        {
+          m_Counts[slice + m_NSteps] = count;
+        }
+        size_t total()
+        {
+          size_t sum = 0;
+          for (size_t i = 0; i < m_Counts.size(); i++) { sum += m_Counts[i]; }
+          return sum;
+        }
+      private:
+        int m_NSteps;
+        std::vector<size_t> m_Counts;
+    };
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void SO3StreamingCountTest()
+    {
+      SO3Sampler::Pointer sampler = SO3Sampler::New();
+      SliceCounter counter(10);
+      sampler->SampleRFZ(10, 32, &counter);
+      DREAM3D_REQUIRE_EQUAL(361, counter.total());
+
+      // The streaming interface delivers the same points as the list for a hexagonal group
+      SliceCounter hexCounter(20);
+      sampler->SampleRFZ(20, 27, &hexCounter);
+      SO3Sampler::OrientationListArrayType orientations = sampler->SampleRFZ(20, 27);
+      DREAM3D_REQUIRE_EQUAL(orientations.size(), hexCounter.total());
+    }
+
     // -----------------------------------------------------------------------------
     //
     // -----------------------------------------------------------------------------
@@ -138,6 +179,7 @@ class SO3SamplerTest
       DREAM3D_REGISTER_TEST( InsideCubicFZTest() )
       DREAM3D_REGISTER_TEST( TestPyramid() )
       DREAM3D_REGISTER_TEST( SO3CountTest() )
+      DREAM3D_REGISTER_TEST( SO3StreamingCountTest() )
       DREAM3D_REGISTER_TEST( RemoveTestFiles() )
     }
 
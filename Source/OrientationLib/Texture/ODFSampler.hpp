@@ -0,0 +1,240 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _odfsampler_h_
+#define _odfsampler_h_
+
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+template<typename T> class ODFSampler;
+
+/**
+ * @brief The ODFSamplerEulerImpl class generates the Euler angles for a range of
+ * chunks of ODFSampler::ChunkSize points
+ */
+template<typename T, typename Ops>
+class ODFSamplerEulerImpl
+{
+  public:
+    ODFSamplerEulerImpl(const ODFSampler<T>* sampler, uint64_t seed, T* eulers, size_t npoints) :
+      m_Sampler(sampler),
+      m_Seed(seed),
+      m_Eulers(eulers),
+      m_NumPoints(npoints)
+    {}
+    virtual ~ODFSamplerEulerImpl() {}
+
+    void generate(size_t startChunk, size_t endChunk) const
+    {
+      Ops ops;
+      for (size_t c = startChunk; c < endChunk; c++)
+      {
+        // Every chunk draws its bins from its own stream so the result does not
+        // depend on how the chunks are distributed over the threads
+        SIMPL_RANDOMNG_NEW_SEEDED(ODFSampler<T>::StreamSeed(m_Seed, c));
+        size_t start = c * ODFSampler<T>::ChunkSize;
+        size_t end = start + ODFSampler<T>::ChunkSize;
+        if (end > m_NumPoints) { end = m_NumPoints; }
+        for (size_t i = start; i < end; i++)
+        {
+          int32_t choose = m_Sampler->pickBin(rg.genrand_res53());
+          FOrientArrayType eu = ops.determineEulerAngles(m_Seed + i + 1, choose);
+          m_Eulers[3 * i + 0] = eu[0];
+          m_Eulers[3 * i + 1] = eu[1];
+          m_Eulers[3 * i + 2] = eu[2];
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const ODFSampler<T>* m_Sampler;
+    uint64_t m_Seed;
+    T* m_Eulers;
+    size_t m_NumPoints;
+};
+
+/**
+ * @brief The ODFSampler class draws ODF bins with probability proportional to their
+ * density. The cumulative density of the bins is computed once together with a guide
+ * table that maps the random value to the first bin that can contain it, so a draw
+ * costs O(1) on average instead of a linear walk over all of the bins.
+ *
+ * The bins are not normalized: a random value in [0, 1) selects the first bin whose
+ * cumulative density is larger than the value, and values beyond the total density
+ * select bin 0. This is the same mapping as the linear search it replaces.
+ */
+template<typename T>
+class ODFSampler
+{
+  public:
+    /**
+     * @brief Number of points that share one random stream in generateEulerAngles()
+     */
+    static const size_t ChunkSize = 1024;
+
+    ODFSampler() {}
+
+    /**
+     * @brief ODFSampler
+     * @param odf ODF bin data
+     * @param numBins Number of bins in odf
+     */
+    ODFSampler(const T* odf, size_t numBins)
+    {
+      reset(odf, numBins);
+    }
+
+    virtual ~ODFSampler() {}
+
+    /**
+     * @brief reset Rebuilds the cumulative density and guide table for new ODF data
+     */
+    void reset(const T* odf, size_t numBins)
+    {
+      m_Cdf.resize(numBins);
+      double total = 0.0;
+      for (size_t j = 0; j < numBins; j++)
+      {
+        total += static_cast<double>(odf[j]);
+        m_Cdf[j] = total;
+      }
+
+      // Guide entry k holds the first bin whose cumulative density exceeds k / numGuides
+      size_t numGuides = (numBins > 0) ? numBins : 1;
+      m_Guide.resize(numGuides);
+      size_t j = 0;
+      for (size_t k = 0; k < numGuides; k++)
+      {
+        double u = static_cast<double>(k) / static_cast<double>(numGuides);
+        while (j < numBins && m_Cdf[j] <= u) { j++; }
+        m_Guide[k] = j;
+      }
+    }
+
+    /**
+     * @brief pickBin Returns the bin selected by a random value in [0, 1)
+     */
+    int32_t pickBin(double random) const
+    {
+      size_t numBins = m_Cdf.size();
+      if (numBins == 0 || random < 0.0) { return 0; }
+      size_t k = static_cast<size_t>(random * static_cast<double>(m_Guide.size()));
+      if (k >= m_Guide.size()) { k = m_Guide.size() - 1; }
+      size_t j = m_Guide[k];
+      while (j < numBins && m_Cdf[j] <= random) { j++; }
+      return (j < numBins) ? static_cast<int32_t>(j) : 0;
+    }
+
+    /**
+     * @brief getNumberOfBins
+     */
+    size_t getNumberOfBins() const
+    {
+      return m_Cdf.size();
+    }
+
+    /**
+     * @brief generateEulerAngles Draws npoints orientations from the ODF. Point i is
+     * placed inside its bin with the seed (seed + i + 1). The bins are drawn from one
+     * random stream per ChunkSize points, so for a given seed the output is the same
+     * no matter how many threads are used.
+     * @param seed Base seed
+     * @param eulers Euler angles to be generated. This memory must already be preallocated to 3 * npoints.
+     * @param npoints Number of orientations to generate
+     */
+    template<typename Ops>
+    void generateEulerAngles(uint64_t seed, T* eulers, size_t npoints) const
+    {
+      size_t numChunks = (npoints + ChunkSize - 1) / ChunkSize;
+      if (numChunks == 0) { return; }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks),
+                          ODFSamplerEulerImpl<T, Ops>(this, seed, eulers, npoints), tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        ODFSamplerEulerImpl<T, Ops> serial(this, seed, eulers, npoints);
+        serial.generate(0, numChunks);
+      }
+    }
+
+    /**
+     * @brief StreamSeed Seed of the random stream used for the bins of a chunk. The
+     * chunk index is mixed into the seed so the streams do not coincide with the
+     * consecutive seeds used to place the points inside their bins.
+     */
+    static uint32_t StreamSeed(uint64_t seed, size_t chunk)
+    {
+      uint64_t z = seed + (static_cast<uint64_t>(chunk) + 1) * 0x9E3779B97F4A7C15ULL;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return static_cast<uint32_t>(z ^ (z >> 31));
+    }
+
+  private:
+    std::vector<double> m_Cdf;
+    std::vector<size_t> m_Guide;
+};
+
+#endif /* _odfsampler_h_ */
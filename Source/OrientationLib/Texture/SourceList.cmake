@@ -37,6 +37,7 @@ set(OrientationLib_Texture_HDRS
   ${OrientationLib_SOURCE_DIR}/Texture/TexturePreset.h
   ${OrientationLib_SOURCE_DIR}/Texture/Texture.hpp
   ${OrientationLib_SOURCE_DIR}/Texture/StatsGen.hpp
+  ${OrientationLib_SOURCE_DIR}/Texture/ODFSampler.hpp
 )
 
 set(OrientationLib_Texture_SRCS
@@ -48,6 +48,7 @@
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
 
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+#include "OrientationLib/Texture/ODFSampler.hpp"
 #include "OrientationLib/Texture/Texture.hpp"
 
 
@@ -229,35 +230,10 @@ class StatsGen
     template<typename T>
     static int GenCubicODFPlotData(const T* odf, T* eulers, size_t npoints)
     {
-      uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-      SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-      int err = 0;
-      int choose;
-      T totaldensity;
-      T random, density;
-
-      CubicOps ops;
-      T td1;
-      //float* odfPtr = &(odf.front());
-      for (size_t i = 0; i < npoints; i++)
-      {
-        m_Seed++;
-        random = rg.genrand_res53();
-        choose = 0;
-        totaldensity = 0;
-        for (int j = 0; j < CubicOps::k_OdfSize; j++)
-        {
-          density = odf[j];
-          td1 = totaldensity;
-          totaldensity = totaldensity + density;
-          if (random < totaldensity && random >= td1) { choose = static_cast<int> (j); break; }
-        }
-        FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
-        eulers[3 * i + 0] = eu[0];
-        eulers[3 * i + 1] = eu[1];
-        eulers[3 * i + 2] = eu[2];
-      }
-      return err;
+      uint64_t seed = QDateTime::currentMSecsSinceEpoch();
+      ODFSampler<T> sampler(odf, CubicOps::k_OdfSize);
+      sampler.template generateEulerAngles<CubicOps>(seed, eulers, static_cast<size_t>(npoints));
+      return 0;
     }
 
     /**
@@ -274,34 +250,10 @@ class StatsGen
     template<typename T>
     static int GenHexODFPlotData(T* odf, T* eulers, int npoints)
     {
-      uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-      SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-      int err = 0;
-      int choose;
-      float totaldensity;
-      float random, density;
-      HexagonalOps ops;
-
-      float td1;
-      for (int i = 0; i < npoints; i++)
-      {
-        m_Seed++;
-        random = rg.genrand_res53();
-        choose = 0;
-        totaldensity = 0;
-        for (int j = 0; j < HexagonalOps::k_OdfSize; j++)
-        {
-          density = odf[j];
-          td1 = totaldensity;
-          totaldensity = totaldensity + density;
-          if (random < totaldensity && random >= td1) { choose = static_cast<int> (j); break; }
-        }
-        FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
-        eulers[3 * i + 0] = eu[0];
-        eulers[3 * i + 1] = eu[1];
-        eulers[3 * i + 2] = eu[2];
-      }
-      return err;
+      uint64_t seed = QDateTime::currentMSecsSinceEpoch();
+      ODFSampler<T> sampler(odf, HexagonalOps::k_OdfSize);
+      sampler.template generateEulerAngles<HexagonalOps>(seed, eulers, static_cast<size_t>(npoints));
+      return 0;
     }
 
     /**
@@ -318,38 +270,10 @@ class StatsGen
     template<typename T>
     static int GenOrthoRhombicODFPlotData(T* odf, T* eulers, int npoints)
     {
-      uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-      SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-      int err = 0;
-      int choose;
-      float totaldensity;
-      float random, density;
-      OrthoRhombicOps ops;
-
-      float td1;
-      for (int i = 0; i < npoints; i++)
-      {
-        m_Seed++;
-        random = rg.genrand_res53();
-        choose = 0;
-        totaldensity = 0;
-        for (int j = 0; j < OrthoRhombicOps::k_OdfSize; j++)
-        {
-          density = odf[j];
-          td1 = totaldensity;
-          totaldensity = totaldensity + density;
-          if (random < totaldensity && random >= td1)
-          {
-            choose = static_cast<int> (j);
-            break;
-          }
-        }
-        FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
-        eulers[3 * i + 0] = eu[0];
-        eulers[3 * i + 1] = eu[1];
-        eulers[3 * i + 2] = eu[2];
-      }
-      return err;
+      uint64_t seed = QDateTime::currentMSecsSinceEpoch();
+      ODFSampler<T> sampler(odf, OrthoRhombicOps::k_OdfSize);
+      sampler.template generateEulerAngles<OrthoRhombicOps>(seed, eulers, static_cast<size_t>(npoints));
+      return 0;
     }
 
     /**
@@ -375,38 +299,10 @@ class StatsGen
     template<typename T>
     static int GenAxisODFPlotData(T* odf, T* eulers, int npoints)
     {
-      uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-      SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-      int err = 0;
-      int choose;
-      float totaldensity;
-      float random, density;
-      OrthoRhombicOps ops;
-
-      float td1;
-      for (int i = 0; i < npoints; i++)
-      {
-        m_Seed++;
-        random = rg.genrand_res53();
-        choose = 0;
-        totaldensity = 0;
-        for (int j = 0; j < OrthoRhombicOps::k_OdfSize; j++)
-        {
-          density = odf[j];
-          td1 = totaldensity;
-          totaldensity = totaldensity + density;
-          if (random < totaldensity && random >= td1)
-          {
-            choose = static_cast<int> (j);
-            break;
-          }
-        }
-        FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
-        eulers[3 * i + 0] = eu[0];
-        eulers[3 * i + 1] = eu[1];
-        eulers[3 * i + 2] = eu[2];
-      }
-      return err;
+      uint64_t seed = QDateTime::currentMSecsSinceEpoch();
+      ODFSampler<T> sampler(odf, OrthoRhombicOps::k_OdfSize);
+      sampler.template generateEulerAngles<OrthoRhombicOps>(seed, eulers, static_cast<size_t>(npoints));
+      return 0;
     }
 
     /**
@@ -55,6 +55,7 @@
 #include "OrientationLib/SpaceGroupOps/CubicOps.h"
 #include "OrientationLib/SpaceGroupOps/HexagonalOps.h"
 #include "OrientationLib/SpaceGroupOps/OrthoRhombicOps.h"
+#include "OrientationLib/Texture/ODFSampler.hpp"
 
 /**
  * @class Texture Texture.h AIM/Common/Texture.h
@@ -453,9 +454,9 @@ class Texture
       int choose1, choose2;
       QuatF q1;
       QuatF q2;
-      float totaldensity;
       float n1, n2, n3;
-      float random1, random2, density;
+      float random1, random2;
+      ODFSampler<T> sampler(odf, static_cast<size_t>(odfsize));
 
       for (int i = 0; i < mdfsize; i++)
       {
@@ -481,18 +482,8 @@ class Texture
         SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
         random1 = rg.genrand_res53();
         random2 = rg.genrand_res53();
-        choose1 = 0;
-        choose2 = 0;
-
-        totaldensity = 0;
-        for (int j = 0; j < odfsize; j++)
-        {
-          density = odf[j];
-          float d = totaldensity;
-          totaldensity = totaldensity + density;
-          if(random1 >= d && random1 < totaldensity) { choose1 = static_cast<int>(j); }
-          if(random2 >= d && random2 < totaldensity) { choose2 = static_cast<int>(j); }
-        }
+        choose1 = sampler.pickBin(random1);
+        choose2 = sampler.pickBin(random2);
 
         FOrientArrayType eu = orientationOps.determineEulerAngles(m_Seed, choose1);
         FOrientArrayType qu(4);
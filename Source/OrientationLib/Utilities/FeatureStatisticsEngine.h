@@ -0,0 +1,455 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#ifndef _featurestatisticsengine_h_
+#define _featurestatisticsengine_h_
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The FeatureStatisticsEngine class computes per Feature statistics of a
+ * FeatureIds cell array on an image grid in a single sweep over the cells. The
+ * statistics that are needed are registered as accumulators before execute() is
+ * called. Rows of the grid are split over the threads and every thread reduces
+ * into its own set of accumulators, which are combined once the sweep is done.
+ *
+ * Cell coordinates are the cell index times the resolution along each axis, the
+ * same convention FindFeatureCentroids and FindShapes use. Axes with a single cell
+ * are never treated as a boundary, so planar grids need no special handling.
+ *
+ * The class is header only and lives in OrientationLib so that the filters of every
+ * plugin can use it.
+ */
+class FeatureStatisticsEngine
+{
+  public:
+    enum Accumulator
+    {
+      Count = 0x01,        //!< Number of cells of each Feature
+      Centroid = 0x02,     //!< Mean cell coordinate of each Feature
+      BoundingBox = 0x04,  //!< Smallest and largest cell index of each Feature along each axis
+      Moments = 0x08,      //!< Second moments of the cell coordinates about the Feature centroid
+      Surface = 0x10,      //!< Whether a Feature touches the grid boundary or a cell with Feature Id 0
+      Phase = 0x20         //!< Phase of the last cell (in memory order) of each Feature
+    };
+
+    enum MomentComponent
+    {
+      XX = 0,
+      YY,
+      ZZ,
+      XY,
+      YZ,
+      XZ,
+      NumMomentComponents
+    };
+
+    /**
+     * @brief FeatureStatisticsEngine
+     * @param featureIds Feature Id of every cell, X fastest
+     * @param dims Dimensions of the cell grid
+     * @param res Resolution of the cell grid
+     * @param numFeatures Number of Features including Feature 0
+     */
+    FeatureStatisticsEngine(const int32_t* featureIds, const size_t dims[3], const float res[3], size_t numFeatures) :
+      m_FeatureIds(featureIds),
+      m_NumFeatures(numFeatures),
+      m_Accumulators(0),
+      m_CellPhases(NULL),
+      m_ReferenceCentroids(NULL)
+    {
+      for (int32_t d = 0; d < 3; d++)
+      {
+        m_Dims[d] = dims[d];
+        m_Res[d] = res[d];
+      }
+    }
+    virtual ~FeatureStatisticsEngine() {}
+
+    /**
+     * @brief addAccumulators Registers one or more Accumulator values. Count is
+     * implied by Centroid and Moments.
+     */
+    void addAccumulators(int accumulators)
+    {
+      m_Accumulators |= accumulators;
+      if ((m_Accumulators & (Centroid | Moments)) != 0) { m_Accumulators |= Count; }
+    }
+
+    int getAccumulators() const { return m_Accumulators; }
+
+    /**
+     * @brief setCellPhases Sets the cell phases read by the Phase accumulator
+     */
+    void setCellPhases(const int32_t* cellPhases) { m_CellPhases = cellPhases; }
+
+    /**
+     * @brief setReferenceCentroids Makes the Moments accumulator sum about the given
+     * centroids (3 per Feature, in the coordinates described above) instead of the
+     * centroids found in the same sweep
+     */
+    void setReferenceCentroids(const float* centroids) { m_ReferenceCentroids = centroids; }
+
+    /**
+     * @brief getCellVolume Returns the volume of one cell, or its area if one of the
+     * axes has a single cell
+     */
+    float getCellVolume() const
+    {
+      if (m_Dims[0] == 1) { return m_Res[1] * m_Res[2]; }
+      else if (m_Dims[1] == 1) { return m_Res[0] * m_Res[2]; }
+      else if (m_Dims[2] == 1) { return m_Res[0] * m_Res[1]; }
+      return m_Res[0] * m_Res[1] * m_Res[2];
+    }
+
+    /**
+     * @brief execute Sweeps the cells once and fills the registered accumulators
+     */
+    void execute()
+    {
+      Partial total;
+      total.allocate(m_Accumulators, m_NumFeatures);
+      size_t numRows = m_Dims[1] * m_Dims[2];
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::enumerable_thread_specific<Partial> partials(total);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), SweepImpl(this, &partials), tbb::auto_partitioner());
+        for (tbb::enumerable_thread_specific<Partial>::iterator iter = partials.begin(); iter != partials.end(); ++iter)
+        {
+          total.merge(*iter);
+        }
+      }
+      else
+#endif
+      {
+        sweep(0, numRows, total);
+      }
+
+      finish(total);
+    }
+
+    int32_t getCount(size_t feature) const { return static_cast<int32_t>(m_Counts[feature]); }
+
+    void getCentroid(size_t feature, float centroid[3]) const
+    {
+      for (int32_t d = 0; d < 3; d++)
+      {
+        centroid[d] = m_Centroids[3 * feature + d];
+      }
+    }
+
+    /**
+     * @brief getBoundingBox Returns false if the Feature has no cells
+     */
+    bool getBoundingBox(size_t feature, int64_t minIndex[3], int64_t maxIndex[3]) const
+    {
+      for (int32_t d = 0; d < 3; d++)
+      {
+        minIndex[d] = m_Bounds[6 * feature + d];
+        maxIndex[d] = m_Bounds[6 * feature + 3 + d];
+      }
+      return maxIndex[0] >= minIndex[0];
+    }
+
+    /**
+     * @brief getMoments Returns the NumMomentComponents sums of the products of the
+     * centered cell coordinates
+     */
+    const double* getMoments(size_t feature) const { return &(m_Moments[NumMomentComponents * feature]); }
+
+    bool isSurfaceFeature(size_t feature) const { return m_Surface[feature] != 0; }
+
+    int32_t getPhase(size_t feature) const { return m_Phases[feature]; }
+
+  private:
+    /**
+     * @brief The Partial struct holds one set of accumulators. Only the vectors of
+     * the registered accumulators are allocated.
+     */
+    struct Partial
+    {
+      std::vector<int64_t> counts;
+      std::vector<double> firstSums;
+      std::vector<double> secondSums;
+      std::vector<int64_t> bounds;
+      std::vector<uint8_t> surface;
+      std::vector<int64_t> lastCells;
+      std::vector<int32_t> phases;
+
+      void allocate(int accumulators, size_t numFeatures)
+      {
+        if ((accumulators & Count) != 0) { counts.assign(numFeatures, 0); }
+        if ((accumulators & (Centroid | Moments)) != 0) { firstSums.assign(3 * numFeatures, 0.0); }
+        if ((accumulators & Moments) != 0) { secondSums.assign(NumMomentComponents * numFeatures, 0.0); }
+        if ((accumulators & BoundingBox) != 0)
+        {
+          bounds.resize(6 * numFeatures);
+          for (size_t i = 0; i < numFeatures; i++)
+          {
+            for (int32_t d = 0; d < 3; d++)
+            {
+              bounds[6 * i + d] = std::numeric_limits<int64_t>::max();
+              bounds[6 * i + 3 + d] = -1;
+            }
+          }
+        }
+        if ((accumulators & Surface) != 0) { surface.assign(numFeatures, 0); }
+        if ((accumulators & Phase) != 0)
+        {
+          lastCells.assign(numFeatures, -1);
+          phases.assign(numFeatures, 0);
+        }
+      }
+
+      void merge(const Partial& other)
+      {
+        for (size_t i = 0; i < counts.size(); i++) { counts[i] += other.counts[i]; }
+        for (size_t i = 0; i < firstSums.size(); i++) { firstSums[i] += other.firstSums[i]; }
+        for (size_t i = 0; i < secondSums.size(); i++) { secondSums[i] += other.secondSums[i]; }
+        for (size_t i = 0; i < bounds.size(); i += 6)
+        {
+          for (int32_t d = 0; d < 3; d++)
+          {
+            if (other.bounds[i + d] < bounds[i + d]) { bounds[i + d] = other.bounds[i + d]; }
+            if (other.bounds[i + 3 + d] > bounds[i + 3 + d]) { bounds[i + 3 + d] = other.bounds[i + 3 + d]; }
+          }
+        }
+        for (size_t i = 0; i < surface.size(); i++) { surface[i] |= other.surface[i]; }
+        for (size_t i = 0; i < lastCells.size(); i++)
+        {
+          if (other.lastCells[i] > lastCells[i])
+          {
+            lastCells[i] = other.lastCells[i];
+            phases[i] = other.phases[i];
+          }
+        }
+      }
+    };
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    /**
+     * @brief The SweepImpl class runs a range of rows into the calling thread's Partial
+     */
+    class SweepImpl
+    {
+      public:
+        SweepImpl(const FeatureStatisticsEngine* engine, tbb::enumerable_thread_specific<Partial>* partials) :
+          m_Engine(engine),
+          m_Partials(partials)
+        {}
+
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          m_Engine->sweep(r.begin(), r.end(), m_Partials->local());
+        }
+
+      private:
+        const FeatureStatisticsEngine* m_Engine;
+        tbb::enumerable_thread_specific<Partial>* m_Partials;
+    };
+#endif
+
+    /**
+     * @brief referencePoint Returns the point the first and second sums of a Feature are
+     * taken about. Summing about a point close to the Feature keeps the sums small.
+     */
+    inline void referencePoint(int32_t gnum, double ref[3]) const
+    {
+      for (int32_t d = 0; d < 3; d++)
+      {
+        if (NULL != m_ReferenceCentroids) { ref[d] = static_cast<double>(m_ReferenceCentroids[3 * gnum + d]); }
+        else { ref[d] = 0.5 * static_cast<double>(m_Dims[d] - 1) * static_cast<double>(m_Res[d]); }
+      }
+    }
+
+    void sweep(size_t rowStart, size_t rowEnd, Partial& p) const
+    {
+      bool doCount = (m_Accumulators & Count) != 0;
+      bool doFirst = (m_Accumulators & (Centroid | Moments)) != 0;
+      bool doSecond = (m_Accumulators & Moments) != 0;
+      bool doBounds = (m_Accumulators & BoundingBox) != 0;
+      bool doSurface = (m_Accumulators & Surface) != 0;
+      bool doPhase = (m_Accumulators & Phase) != 0 && NULL != m_CellPhases;
+
+      int64_t dims[3] = { static_cast<int64_t>(m_Dims[0]), static_cast<int64_t>(m_Dims[1]), static_cast<int64_t>(m_Dims[2]) };
+      int64_t strides[3] = { 1, dims[0], dims[0] * dims[1] };
+      double ref[3] = { 0.0, 0.0, 0.0 };
+
+      for (size_t row = rowStart; row < rowEnd; row++)
+      {
+        int64_t pos[3] = { 0, static_cast<int64_t>(row % m_Dims[1]), static_cast<int64_t>(row / m_Dims[1]) };
+        int64_t rowOffset = static_cast<int64_t>(row) * dims[0];
+        for (pos[0] = 0; pos[0] < dims[0]; pos[0]++)
+        {
+          int64_t index = rowOffset + pos[0];
+          int32_t gnum = m_FeatureIds[index];
+          if (doCount) { p.counts[gnum]++; }
+          if (doFirst)
+          {
+            referencePoint(gnum, ref);
+            double delta[3] = { 0.0, 0.0, 0.0 };
+            for (int32_t d = 0; d < 3; d++)
+            {
+              delta[d] = static_cast<double>(pos[d]) * static_cast<double>(m_Res[d]) - ref[d];
+              p.firstSums[3 * gnum + d] += delta[d];
+            }
+            if (doSecond)
+            {
+              double* s = &(p.secondSums[NumMomentComponents * gnum]);
+              s[XX] += delta[0] * delta[0];
+              s[YY] += delta[1] * delta[1];
+              s[ZZ] += delta[2] * delta[2];
+              s[XY] += delta[0] * delta[1];
+              s[YZ] += delta[1] * delta[2];
+              s[XZ] += delta[0] * delta[2];
+            }
+          }
+          if (doBounds)
+          {
+            int64_t* b = &(p.bounds[6 * gnum]);
+            for (int32_t d = 0; d < 3; d++)
+            {
+              if (pos[d] < b[d]) { b[d] = pos[d]; }
+              if (pos[d] > b[3 + d]) { b[3 + d] = pos[d]; }
+            }
+          }
+          if (doSurface && p.surface[gnum] == 0)
+          {
+            for (int32_t d = 0; d < 3; d++)
+            {
+              if (dims[d] == 1) { continue; }
+              if (pos[d] == 0 || pos[d] == dims[d] - 1
+                  || m_FeatureIds[index - strides[d]] == 0 || m_FeatureIds[index + strides[d]] == 0)
+              {
+                p.surface[gnum] = 1;
+                break;
+              }
+            }
+          }
+          if (doPhase)
+          {
+            p.lastCells[gnum] = index;
+            p.phases[gnum] = m_CellPhases[index];
+          }
+        }
+      }
+    }
+
+    void finish(Partial& total)
+    {
+      m_Counts.swap(total.counts);
+      m_Bounds.swap(total.bounds);
+      m_Surface.swap(total.surface);
+      m_Phases.swap(total.phases);
+
+      if ((m_Accumulators & Centroid) != 0)
+      {
+        m_Centroids.resize(3 * m_NumFeatures);
+        double ref[3] = { 0.0, 0.0, 0.0 };
+        for (size_t i = 0; i < m_NumFeatures; i++)
+        {
+          referencePoint(static_cast<int32_t>(i), ref);
+          double count = static_cast<double>(m_Counts[i]);
+          for (int32_t d = 0; d < 3; d++)
+          {
+            m_Centroids[3 * i + d] = static_cast<float>(ref[d] + total.firstSums[3 * i + d] / count);
+          }
+        }
+      }
+
+      if ((m_Accumulators & Moments) != 0)
+      {
+        m_Moments.swap(total.secondSums);
+        // Sums about the grid center are moved to the Feature centroid; sums about the
+        // reference centroids are used as they are
+        if (NULL == m_ReferenceCentroids)
+        {
+          for (size_t i = 0; i < m_NumFeatures; i++)
+          {
+            if (m_Counts[i] == 0) { continue; }
+            double count = static_cast<double>(m_Counts[i]);
+            const double* f = &(total.firstSums[3 * i]);
+            double* s = &(m_Moments[NumMomentComponents * i]);
+            s[XX] -= f[0] * f[0] / count;
+            s[YY] -= f[1] * f[1] / count;
+            s[ZZ] -= f[2] * f[2] / count;
+            s[XY] -= f[0] * f[1] / count;
+            s[YZ] -= f[1] * f[2] / count;
+            s[XZ] -= f[0] * f[2] / count;
+          }
+        }
+      }
+    }
+
+    const int32_t* m_FeatureIds;
+    size_t m_Dims[3];
+    float m_Res[3];
+    size_t m_NumFeatures;
+    int m_Accumulators;
+    const int32_t* m_CellPhases;
+    const float* m_ReferenceCentroids;
+
+    std::vector<int64_t> m_Counts;
+    std::vector<float> m_Centroids;
+    std::vector<int64_t> m_Bounds;
+    std::vector<double> m_Moments;
+    std::vector<uint8_t> m_Surface;
+    std::vector<int32_t> m_Phases;
+
+    FeatureStatisticsEngine(const FeatureStatisticsEngine&); // Copy Constructor Not Implemented
+    void operator=(const FeatureStatisticsEngine&); // Operator '=' Not Implemented
+};
+
+#endif /* _featurestatisticsengine_h_ */
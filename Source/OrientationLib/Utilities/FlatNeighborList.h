@@ -0,0 +1,182 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+
+#ifndef _flatneighborlist_h_
+#define _flatneighborlist_h_
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+
+/**
+ * @brief The FlatNeighborList class holds one list of values per Feature in compressed
+ * sparse row form: the list of Feature i is the range [getListStart(i), getListEnd(i))
+ * of a single contiguous value array. Filters that produce neighbor lists build them
+ * in this form, which needs two allocations instead of one per Feature and can be
+ * filled by several threads at once, and copy the result into a NeighborList when
+ * they are done.
+ *
+ * A list is built in three steps: the size of every list is set (or counted) with
+ * addToListSize(), allocate() lays out the value array, and the values are written
+ * either with append() or directly through getList().
+ *
+ * The class is header only and lives in OrientationLib so that the filters of every
+ * plugin can use it.
+ */
+template<typename T>
+class FlatNeighborList
+{
+  public:
+    FlatNeighborList() :
+      m_Offsets(1, 0)
+    {}
+    virtual ~FlatNeighborList() {}
+
+    /**
+     * @brief setNumberOfFeatures Clears the lists and makes room for the given number
+     * of Features, all with empty lists
+     */
+    void setNumberOfFeatures(size_t numFeatures)
+    {
+      m_Offsets.assign(numFeatures + 1, 0);
+      m_Values.clear();
+      m_Cursors.clear();
+    }
+
+    /**
+     * @brief addToListSize Grows the list of the given Feature. Only valid before allocate()
+     */
+    void addToListSize(size_t feature, size_t count = 1) { m_Offsets[feature + 1] += count; }
+
+    /**
+     * @brief setListSize Sets the size of the list of the given Feature. Only valid
+     * before allocate(); distinct Features may be set from different threads
+     */
+    void setListSize(size_t feature, size_t count) { m_Offsets[feature + 1] = count; }
+
+    /**
+     * @brief allocate Turns the list sizes into offsets and sizes the value array
+     */
+    void allocate()
+    {
+      for (size_t i = 1; i < m_Offsets.size(); i++)
+      {
+        m_Offsets[i] += m_Offsets[i - 1];
+      }
+      m_Values.resize(m_Offsets.back());
+      m_Cursors.assign(m_Offsets.begin(), m_Offsets.end() - 1);
+    }
+
+    /**
+     * @brief copyLayout Gives this object the same list sizes as another one that was
+     * already allocated, so that values of a second type can be stored per entry
+     */
+    template<typename U>
+    void copyLayout(const FlatNeighborList<U>& other)
+    {
+      m_Offsets = other.getOffsets();
+      m_Values.resize(m_Offsets.back());
+      m_Cursors.assign(m_Offsets.begin(), m_Offsets.end() - 1);
+    }
+
+    /**
+     * @brief append Writes the next value of the list of the given Feature
+     */
+    void append(size_t feature, T value) { m_Values[m_Cursors[feature]++] = value; }
+
+    size_t getNumberOfFeatures() const { return m_Offsets.size() - 1; }
+    size_t getNumberOfValues() const { return m_Values.size(); }
+
+    size_t getListStart(size_t feature) const { return m_Offsets[feature]; }
+    size_t getListEnd(size_t feature) const { return m_Offsets[feature + 1]; }
+    size_t getListSize(size_t feature) const { return m_Offsets[feature + 1] - m_Offsets[feature]; }
+
+    /**
+     * @brief getList Returns a pointer to the first value of the list of the given Feature
+     */
+    T* getList(size_t feature) { return m_Values.empty() ? NULL : &(m_Values.front()) + m_Offsets[feature]; }
+    const T* getList(size_t feature) const { return m_Values.empty() ? NULL : &(m_Values.front()) + m_Offsets[feature]; }
+
+    T getValue(size_t feature, size_t index) const { return m_Values[m_Offsets[feature] + index]; }
+
+    const std::vector<size_t>& getOffsets() const { return m_Offsets; }
+    std::vector<T>& getValues() { return m_Values; }
+    const std::vector<T>& getValues() const { return m_Values; }
+
+    /**
+     * @brief readNeighborList Replaces the lists with the ones of a NeighborList
+     */
+    void readNeighborList(NeighborList<T>& neighborList)
+    {
+      size_t numFeatures = neighborList.getNumberOfTuples();
+      setNumberOfFeatures(numFeatures);
+      for (size_t i = 0; i < numFeatures; i++)
+      {
+        setListSize(i, neighborList[i].size());
+      }
+      allocate();
+      for (size_t i = 0; i < numFeatures; i++)
+      {
+        std::copy(neighborList[i].begin(), neighborList[i].end(), m_Values.begin() + m_Offsets[i]);
+      }
+    }
+
+    /**
+     * @brief copyToNeighborList Copies the lists into a NeighborList, starting at Feature 1.
+     * The list of Feature 0 is left untouched, as the filters that create neighbor lists
+     * never fill it.
+     */
+    void copyToNeighborList(typename NeighborList<T>::Pointer neighborList) const
+    {
+      size_t numFeatures = getNumberOfFeatures();
+      for (size_t i = 1; i < numFeatures; i++)
+      {
+        typename NeighborList<T>::SharedVectorType list(new std::vector<T>(m_Values.begin() + m_Offsets[i], m_Values.begin() + m_Offsets[i + 1]));
+        neighborList->setList(static_cast<int32_t>(i), list);
+      }
+    }
+
+  private:
+    std::vector<size_t> m_Offsets;
+    std::vector<T> m_Values;
+    std::vector<size_t> m_Cursors;
+};
+
+#endif /* _flatneighborlist_h_ */
@@ -38,12 +38,123 @@
 
 #include <QtCore/QSet>
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
 
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/MatrixMath.h"
 
 #define WRITE_LAMBERT_SQUARE_COORD_VTK 0
 
+namespace
+{
+  // Number of points whose square coordinates are computed together
+  const size_t k_LambertBatchSize = 1024;
+}
+
+/**
+ * @brief The LambertBinningImpl class bins a range of XYZ coordinates into a pair
+ * of north/south squares. In parallel every thread owns its own pair of squares
+ * (stored back to back) which are summed once all of the points are binned.
+ */
+class LambertBinningImpl
+{
+  public:
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    typedef tbb::enumerable_thread_specific<std::vector<double> > ThreadSquares_t;
+#endif
+
+    LambertBinningImpl(const ModifiedLambertProjection* projection, const float* coords, size_t squareSize) :
+      m_Projection(projection),
+      m_Coords(coords),
+      m_SquareSize(squareSize)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      , m_ThreadSquares(NULL)
+#endif
+    {}
+    virtual ~LambertBinningImpl() {}
+
+    void bin(size_t start, size_t end, double* north, double* south) const
+    {
+      float sqCoords[2 * k_LambertBatchSize];
+      bool nhCheck[k_LambertBatchSize];
+      for (size_t b = start; b < end; b += k_LambertBatchSize)
+      {
+        size_t count = std::min(k_LambertBatchSize, end - b);
+        m_Projection->getSquareCoords(m_Coords + 3 * b, count, sqCoords, nhCheck);
+        for (size_t i = 0; i < count; i++)
+        {
+          m_Projection->addInterpolatedValues(nhCheck[i] ? north : south, sqCoords + 2 * i, 1.0);
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void setThreadSquares(ThreadSquares_t* squares)
+    {
+      m_ThreadSquares = squares;
+    }
+
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      std::vector<double>& squares = m_ThreadSquares->local();
+      if (squares.empty())
+      {
+        squares.resize(2 * m_SquareSize, 0.0);
+      }
+      bin(r.begin(), r.end(), &(squares.front()), &(squares.front()) + m_SquareSize);
+    }
+#endif
+
+  private:
+    const ModifiedLambertProjection* m_Projection;
+    const float* m_Coords;
+    size_t m_SquareSize;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    ThreadSquares_t* m_ThreadSquares;
+#endif
+};
+
+/**
+ * @brief The LambertStereographicImpl class fills a range of rows of the
+ * stereographic intensity image
+ */
+class LambertStereographicImpl
+{
+  public:
+    LambertStereographicImpl(const ModifiedLambertProjection* projection, int dim, double* intensity) :
+      m_Projection(projection),
+      m_Dim(dim),
+      m_Intensity(intensity)
+    {}
+    virtual ~LambertStereographicImpl() {}
+
+    void fill(int64_t start, int64_t end) const
+    {
+      m_Projection->fillStereographicRows(m_Dim, start, end, m_Intensity);
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      fill(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const ModifiedLambertProjection* m_Projection;
+    int m_Dim;
+    double* m_Intensity;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -72,9 +183,6 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::CreateProjectionFr
 {
 
   size_t npoints = coords->getNumberOfTuples();
-  bool nhCheck = false;
-  float sqCoord[2];
-  //int sqIndex = 0;
   ModifiedLambertProjection::Pointer squareProj = ModifiedLambertProjection::New();
   squareProj->initializeSquares(dimension, sphereRadius);
 
@@ -99,36 +207,50 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::CreateProjectionFr
   fprintf(f, "\n");
 
   fprintf(f, "DATASET UNSTRUCTURED_GRID\nPOINTS %lu float\n", coords->getNumberOfTuples() );
-#endif
-
   for(size_t i = 0; i < npoints; ++i)
   {
-    sqCoord[0] = 0.0;
-    sqCoord[1] = 0.0;
-    //get coordinates in square projection of crystal normal parallel to boundary normal
-    nhCheck = squareProj->getSquareCoord(coords->getPointer(i * 3), sqCoord);
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
+    float sqCoord[2] = { 0.0f, 0.0f };
+    squareProj->getSquareCoord(coords->getPointer(i * 3), sqCoord);
     fprintf(f, "%f %f 0\n", sqCoord[0], sqCoord[1]);
+  }
+  fclose(f);
 #endif
 
-    // Based on the XY coordinate, get the pointer index that the value corresponds to in the proper square
-//    sqIndex = squareProj->getSquareIndex(sqCoord);
-    if (nhCheck == true)
-    {
-      //north increment by 1
-//      squareProj->addValue(ModifiedLambertProjection::NorthSquare, sqIndex, 1.0);
-      squareProj->addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
-    }
-    else
+  if (npoints == 0)
+  {
+    return squareProj;
+  }
+
+  double* north = squareProj->getNorthSquare()->getPointer(0);
+  double* south = squareProj->getSouthSquare()->getPointer(0);
+  size_t squareSize = static_cast<size_t>(dimension) * static_cast<size_t>(dimension);
+  LambertBinningImpl binning(squareProj.get(), coords->getPointer(0), squareSize);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  bool doParallel = npoints > 4 * k_LambertBatchSize;
+  if (doParallel == true)
+  {
+    // Every thread bins into private squares which are summed afterwards
+    LambertBinningImpl::ThreadSquares_t threadSquares;
+    binning.setThreadSquares(&threadSquares);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, npoints, k_LambertBatchSize), binning, tbb::auto_partitioner());
+
+    for (LambertBinningImpl::ThreadSquares_t::const_iterator iter = threadSquares.begin(); iter != threadSquares.end(); ++iter)
     {
-      // south increment by 1
-//      squareProj->addValue(ModifiedLambertProjection::SouthSquare, sqIndex, 1.0);
-      squareProj->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+      const std::vector<double>& squares = *iter;
+      if (squares.empty()) { continue; }
+      for (size_t i = 0; i < squareSize; i++)
+      {
+        north[i] += squares[i];
+        south[i] += squares[squareSize + i];
+      }
     }
   }
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
-  fclose(f);
+  else
 #endif
+  {
+    binning.bin(0, npoints, north, south);
+  }
 
   return squareProj;
 }
@@ -183,15 +305,15 @@ int ModifiedLambertProjection::readHDF5Data(hid_t groupId)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCoord, double value)
+void ModifiedLambertProjection::getInterpolationStencil(const float* sqCoord, int index[4], float& modX, float& modY) const
 {
   int abin1 = 0, bbin1 = 0;
   int abin2 = 0, bbin2 = 0;
   int abin3 = 0, bbin3 = 0;
   int abin4 = 0, bbin4 = 0;
   int abinSign, bbinSign;
-  float modX = (sqCoord[0] + m_HalfDimensionTimesStepSize ) / m_StepSize;
-  float modY = (sqCoord[1] + m_HalfDimensionTimesStepSize ) / m_StepSize;
+  modX = (sqCoord[0] + m_HalfDimensionTimesStepSize ) / m_StepSize;
+  modY = (sqCoord[1] + m_HalfDimensionTimesStepSize ) / m_StepSize;
   int abin = (int) modX;
   int bbin = (int) modY;
   modX -= abin;
@@ -245,31 +367,44 @@ void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCo
   modX = fabs(modX);
   modY = fabs(modY);
 
-  int index1 = bbin1 * m_Dimension + abin1;
-  int index2 = bbin2 * m_Dimension + abin2;
-  int index3 = bbin3 * m_Dimension + abin3;
-  int index4 = bbin4 * m_Dimension + abin4;
+  index[0] = bbin1 * m_Dimension + abin1;
+  index[1] = bbin2 * m_Dimension + abin2;
+  index[2] = bbin3 * m_Dimension + abin3;
+  index[3] = bbin4 * m_Dimension + abin4;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addInterpolatedValues(double* square, const float* sqCoord, double value) const
+{
+  int index[4];
+  float modX = 0.0f, modY = 0.0f;
+  getInterpolationStencil(sqCoord, index, modX, modY);
+
+  // All four values are read before any is written so coinciding bins behave as before
+  double v1 = square[index[0]] + value * (1.0 - modX) * (1.0 - modY);
+  double v2 = square[index[1]] + value * (modX) * (1.0 - modY);
+  double v3 = square[index[2]] + value * (1.0 - modX) * (modY);
+  double v4 = square[index[3]] + value * (modX) * (modY);
+  square[index[0]] = v1;
+  square[index[1]] = v2;
+  square[index[2]] = v3;
+  square[index[3]] = v4;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCoord, double value)
+{
   if (square == NorthSquare)
   {
-    double v1 = m_NorthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
-    double v2 = m_NorthSquare->getValue(index2) + value * (modX) * (1.0 - modY);
-    double v3 = m_NorthSquare->getValue(index3) + value * (1.0 - modX) * (modY);
-    double v4 = m_NorthSquare->getValue(index4) + value * (modX) * (modY);
-    m_NorthSquare->setValue(index1, v1);
-    m_NorthSquare->setValue(index2, v2);
-    m_NorthSquare->setValue(index3, v3);
-    m_NorthSquare->setValue(index4, v4);
+    addInterpolatedValues(m_NorthSquare->getPointer(0), sqCoord, value);
   }
   else
   {
-    double v1 = m_SouthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
-    double v2 = m_SouthSquare->getValue(index2) + value * (modX) * (1.0 - modY);
-    double v3 = m_SouthSquare->getValue(index3) + value * (1.0 - modX) * (modY);
-    double v4 = m_SouthSquare->getValue(index4) + value * (modX) * (modY);
-    m_SouthSquare->setValue(index1, v1);
-    m_SouthSquare->setValue(index2, v2);
-    m_SouthSquare->setValue(index3, v3);
-    m_SouthSquare->setValue(index4, v4);
+    addInterpolatedValues(m_SouthSquare->getPointer(0), sqCoord, value);
   }
 }
 
@@ -308,7 +443,7 @@ void ModifiedLambertProjection::setValue(Square square, int index, double value)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-double ModifiedLambertProjection::getValue(Square square, int index)
+double ModifiedLambertProjection::getValue(Square square, int index) const
 {
   if (square == NorthSquare)
   {
@@ -323,132 +458,76 @@ double ModifiedLambertProjection::getValue(Square square, int index)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-double ModifiedLambertProjection::getInterpolatedValue(Square square, float* sqCoord)
+double ModifiedLambertProjection::getInterpolatedValue(Square square, float* sqCoord) const
 {
-// float sqCoord[2] = { sqCoord0[0] - 0.5*m_StepSize, sqCoord0[1] - 0.5*m_StepSize};
-  int abin1, bbin1;
-  int abin2, bbin2;
-  int abin3, bbin3;
-  int abin4, bbin4;
-  int abinSign, bbinSign;
-  float modX = (sqCoord[0] + m_HalfDimensionTimesStepSize ) / m_StepSize;
-  float modY = (sqCoord[1] + m_HalfDimensionTimesStepSize ) / m_StepSize;
-  int abin = (int) modX;
-  int bbin = (int) modY;
-  modX -= abin;
-  modY -= bbin;
-  modX -= 0.5;
-  modY -= 0.5;
-  if(modX == 0.0)
-  {
-    abinSign = 1;
-  }
-  else
-  {
-    abinSign = modX / fabs(modX);
-  }
-  if(modY == 0.0)
-  {
-    bbinSign = 1;
-  }
-  else
-  {
-    bbinSign = modY / fabs(modY);
-  }
-  abin1 = abin;
-  bbin1 = bbin;
-  abin2 = abin + abinSign;
-  bbin2 = bbin;
-  if(abin2 < 0 || abin2 > m_Dimension - 1)
-  {
-    abin2 = abin2 - (abinSign * m_Dimension), bbin2 = m_Dimension - bbin2 - 1;
-  }
-  abin3 = abin;
-  bbin3 = bbin + bbinSign;
-  if(bbin3 < 0 || bbin3 > m_Dimension - 1)
-  {
-    abin3 = m_Dimension - abin3 - 1, bbin3 = bbin3 - (bbinSign * m_Dimension);
-  }
-  abin4 = abin + abinSign;
-  bbin4 = bbin + bbinSign;
-  if((abin4 < 0 || abin4 > m_Dimension - 1) && (bbin4 >= 0 && bbin4 <= m_Dimension - 1))
-  {
-    abin4 = abin4 - (abinSign * m_Dimension), bbin4 = m_Dimension - bbin4 - 1;
-  }
-  else if((abin4 >= 0 && abin4 <= m_Dimension - 1) && (bbin4 < 0 || bbin4 > m_Dimension - 1))
-  {
-    abin4 = m_Dimension - abin4 - 1, bbin4 = bbin4 - (bbinSign * m_Dimension);
-  }
-  else if((abin4 < 0 || abin4 > m_Dimension - 1) && (bbin4 < 0 || bbin4 > m_Dimension - 1))
-  {
-    abin4 = abin4 - (abinSign * m_Dimension), bbin4 = bbin4 - (bbinSign * m_Dimension);
-  }
-  modX = fabs(modX);
-  modY = fabs(modY);
-  if (square == NorthSquare)
-  {
-    float intensity1 = m_NorthSquare->getValue((abin1) + (bbin1 * m_Dimension));
-    float intensity2 = m_NorthSquare->getValue((abin2) + (bbin2 * m_Dimension));
-    float intensity3 = m_NorthSquare->getValue((abin3) + (bbin3 * m_Dimension));
-    float intensity4 = m_NorthSquare->getValue((abin4) + (bbin4 * m_Dimension));
-    float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
-    return interpolatedIntensity;
-  }
-  else
-  {
-    float intensity1 = m_SouthSquare->getValue((abin1) + (bbin1 * m_Dimension));
-    float intensity2 = m_SouthSquare->getValue((abin2) + (bbin2 * m_Dimension));
-    float intensity3 = m_SouthSquare->getValue((abin3) + (bbin3 * m_Dimension));
-    float intensity4 = m_SouthSquare->getValue((abin4) + (bbin4 * m_Dimension));
-    float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
-    return interpolatedIntensity;
-  }
+  int index[4];
+  float modX = 0.0f, modY = 0.0f;
+  getInterpolationStencil(sqCoord, index, modX, modY);
+
+  const double* values = (square == NorthSquare) ? m_NorthSquare->getPointer(0) : m_SouthSquare->getPointer(0);
+  float intensity1 = values[index[0]];
+  float intensity2 = values[index[1]];
+  float intensity3 = values[index[2]];
+  float intensity4 = values[index[3]];
+  float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
+  return interpolatedIntensity;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool ModifiedLambertProjection::getSquareCoord(float* xyz, float* sqCoord)
+bool ModifiedLambertProjection::getSquareCoord(float* xyz, float* sqCoord) const
 {
   bool nhCheck = false;
-  float adjust = 1.0;
-  if(xyz[2] >= 0.0)
-  {
-    adjust = -1.0;
-    nhCheck = true;
-  }
-  if(xyz[0] == 0 && xyz[1] == 0)
-  {
-    sqCoord[0] = 0.0;
-    sqCoord[1] = 0.0;
-    return nhCheck;
-  }
-  if(fabs(xyz[0]) >= fabs(xyz[1]))
-  {
-    sqCoord[0] = (xyz[0] / fabs(xyz[0]) ) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (xyz[2] * adjust) ) ) * SIMPLib::Constants::k_HalfOfSqrtPi;
-    sqCoord[1] = (xyz[0] / fabs(xyz[0]) ) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (xyz[2] * adjust) ) ) * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(xyz[1] / xyz[0]));
-  }
-  else
-  {
-    sqCoord[0] = (xyz[1] / fabs(xyz[1])) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (xyz[2] * adjust))) * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(xyz[0] / xyz[1]));
-    sqCoord[1] = (xyz[1] / fabs(xyz[1])) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (xyz[2] * adjust))) * (SIMPLib::Constants::k_HalfOfSqrtPi);
-  }
+  getSquareCoords(xyz, 1, sqCoord, &nhCheck);
+  return nhCheck;
+}
 
-  if (sqCoord[0] >= m_MaxCoord)
-  {
-    sqCoord[0] = (m_MaxCoord) - .0001;
-  }
-  if (sqCoord[1] >= m_MaxCoord)
-  {
-    sqCoord[1] = (m_MaxCoord) - .0001;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::getSquareCoords(const float* xyz, size_t count, float* sqCoords, bool* nhCheck) const
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    const float* p = xyz + 3 * i;
+    float* sqCoord = sqCoords + 2 * i;
+    bool north = (p[2] >= 0.0);
+    float adjust = north ? -1.0f : 1.0f;
+    nhCheck[i] = north;
+
+    // The larger of |x| and |y| selects the square sector; the two sectors only
+    // differ in which output receives which term, so both share one code path
+    bool xSector = (fabs(p[0]) >= fabs(p[1]));
+    float lead = xSector ? p[0] : p[1];
+    float other = xSector ? p[1] : p[0];
+    if (lead == 0.0f)
+    {
+      sqCoord[0] = 0.0;
+      sqCoord[1] = 0.0;
+      continue;
+    }
+    double radius = (lead / fabs(lead)) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (p[2] * adjust)));
+    float edge = radius * SIMPLib::Constants::k_HalfOfSqrtPi;
+    float angle = radius * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(other / lead));
+    sqCoord[0] = xSector ? edge : angle;
+    sqCoord[1] = xSector ? angle : edge;
+
+    if (sqCoord[0] >= m_MaxCoord)
+    {
+      sqCoord[0] = (m_MaxCoord) - .0001;
+    }
+    if (sqCoord[1] >= m_MaxCoord)
+    {
+      sqCoord[1] = (m_MaxCoord) - .0001;
+    }
   }
-  return nhCheck;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int ModifiedLambertProjection::getSquareIndex(float* sqCoord)
+int ModifiedLambertProjection::getSquareIndex(float* sqCoord) const
 {
   int x = (int)( (sqCoord[0] + m_MaxCoord) / m_StepSize);
   if (x >= m_Dimension)
@@ -530,6 +609,28 @@ void ModifiedLambertProjection::normalizeSquaresToMRD()
 //
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::createStereographicProjection(int dim, DoubleArrayType* stereoIntensity)
+{
+  stereoIntensity->initializeWithZeros();
+  double* intensity = stereoIntensity->getPointer(0);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, dim), LambertStereographicImpl(this, dim, intensity), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    LambertStereographicImpl serial(this, dim, intensity);
+    serial.fill(0, dim);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::fillStereographicRows(int dim, int64_t startRow, int64_t endRow, double* intensity) const
 {
   int xpoints = dim;
   int ypoints = dim;
@@ -544,11 +645,7 @@ void ModifiedLambertProjection::createStereographicProjection(int dim, DoubleArr
   float xyz[3];
   bool nhCheck = false;
 
-  stereoIntensity->initializeWithZeros();
-  double* intensity = stereoIntensity->getPointer(0);
-// int sqIndex = 0;
-
-  for (int64_t y = 0; y < ypoints; y++)
+  for (int64_t y = startRow; y < endRow; y++)
   {
     for (int64_t x = 0; x < xpoints; x++)
     {
@@ -106,6 +106,16 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     void addInterpolatedValues(Square square, float* sqCoord, double value);
 
+    /**
+     * @brief addInterpolatedValues Spreads value over the four bins around sqCoord
+     * of the given square data, which has the layout of the North/South squares.
+     * Used to bin into private copies of the squares from several threads.
+     * @param square Dimension * Dimension values
+     * @param sqCoord
+     * @param value
+     */
+    void addInterpolatedValues(double* square, const float* sqCoord, double value) const;
+
     /**
      * @brief addValue
      * @param square
@@ -128,7 +138,7 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      * @param index
      * @return
      */
-    double getValue(Square square, int index);
+    double getValue(Square square, int index) const;
 
     /**
      * @brief getInterpolatedValue
@@ -136,7 +146,7 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      * @param sqCoord
      * @return
      */
-    double getInterpolatedValue(Square square, float* sqCoord);
+    double getInterpolatedValue(Square square, float* sqCoord) const;
 
     /**
      * @brief getSquareCoord
@@ -144,14 +154,23 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      * @param sqCoord [output] The XY coordinate in the Modified Lambert Square
      * @return If the point was in the north or south squares
      */
-    bool getSquareCoord(float* xyz, float* sqCoord);
+    bool getSquareCoord(float* xyz, float* sqCoord) const;
+
+    /**
+     * @brief getSquareCoords Batch version of getSquareCoord
+     * @param xyz count XYZ coordinates on the sphere
+     * @param count Number of coordinates
+     * @param sqCoords [output] count XY coordinates in the Modified Lambert Square
+     * @param nhCheck [output] true for the points that are in the north square
+     */
+    void getSquareCoords(const float* xyz, size_t count, float* sqCoords, bool* nhCheck) const;
 
     /**
      * @brief getSquareIndex
      * @param sqCoord
      * @return
      */
-    int getSquareIndex(float* sqCoord);
+    int getSquareIndex(float* sqCoord) const;
 
     /**
      * @brief This function normalizes the squares by taking the value of each square and dividing by the sum of all the
@@ -172,6 +191,13 @@ class OrientationLib_EXPORT ModifiedLambertProjection
 
     void createStereographicProjection(int dim, DoubleArrayType* stereoIntensity);
 
+    /**
+     * @brief fillStereographicRows Computes the rows [startRow, endRow) of the
+     * stereographic projection image. The rows are independent of each other,
+     * which lets createStereographicProjection fill them in parallel.
+     */
+    void fillStereographicRows(int dim, int64_t startRow, int64_t endRow, double* intensity) const;
+
   protected:
     ModifiedLambertProjection();
 
@@ -189,6 +215,12 @@ class OrientationLib_EXPORT ModifiedLambertProjection
     DoubleArrayType::Pointer m_NorthSquare;
     DoubleArrayType::Pointer m_SouthSquare;
 
+    /**
+     * @brief getInterpolationStencil Computes the four bins around sqCoord and the
+     * bilinear weights, shared by the binning and the lookup of interpolated values
+     */
+    void getInterpolationStencil(const float* sqCoord, int index[4], float& modX, float& modY) const;
+
 
 
     ModifiedLambertProjection(const ModifiedLambertProjection&); // Copy Constructor Not Implemented
@@ -44,6 +44,8 @@ set(OrientationLib_Utilities_HDRS
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjectionArray.h
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjection3D.hpp
   ${OrientationLib_SOURCE_DIR}/Utilities/PoleFigureImageUtilities.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/FeatureStatisticsEngine.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/FlatNeighborList.h
 )
 
 set(OrientationLib_Utilities_SRCS
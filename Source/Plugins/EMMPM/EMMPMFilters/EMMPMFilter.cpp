@@ -35,6 +35,14 @@
 
 #include "EMMPMFilter.h"
 
+#include <algorithm>
+#include <limits>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#include <tbb/task_group.h>
+#endif
+
 #include "EMMPM/EMMPMConstants.h"
 #include "EMMPM/EMMPMLib/EMMPMLib.h"
 #include "EMMPM/EMMPMLib/Common/EMTime.h"
@@ -49,11 +57,13 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/SIMPLibVersion.h"
@@ -78,6 +88,10 @@ EMMPMFilter::EMMPMFilter() :
   m_CurvaturePenalty(1.0f),
   m_RMax(15.0f),
   m_EMLoopDelay(1),
+  m_SegmentationMode(SingleImage),
+  m_Neighborhood(2),
+  m_MaxConcurrentSlices(4),
+  m_RandomSeed(0),
   m_OutputDataArrayPath("", "", ""),
   m_EmmpmInitType(EMMPM_Basic)
 {
@@ -110,6 +124,39 @@ void EMMPMFilter::setupFilterParameters()
   parameters.push_back(DoubleFilterParameter::New("Curvature Penalty (Beta C)", "CurvaturePenalty", getCurvaturePenalty(), FilterParameter::Parameter));
   parameters.push_back(DoubleFilterParameter::New("R Max", "RMax", getRMax(), FilterParameter::Parameter));
   parameters.push_back(IntFilterParameter::New("EM Loop Delay", "EMLoopDelay", getEMLoopDelay(), FilterParameter::Parameter));
+  {
+    LinkedChoicesFilterParameter::Pointer parameter = LinkedChoicesFilterParameter::New();
+    parameter->setHumanLabel("Segmentation Mode");
+    parameter->setPropertyName("SegmentationMode");
+
+    QVector<QString> choices;
+    choices.push_back("Single Image");
+    choices.push_back("Volume (3D Neighborhood)");
+    choices.push_back("Independent Slices");
+    parameter->setChoices(choices);
+    QStringList linkedProps;
+    linkedProps << "Neighborhood" << "MaxConcurrentSlices";
+    parameter->setLinkedProperties(linkedProps);
+    parameter->setEditable(false);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Neighborhood");
+    parameter->setPropertyName("Neighborhood");
+
+    QVector<QString> choices;
+    choices.push_back("6 (Faces)");
+    choices.push_back("18 (Faces and Edges)");
+    choices.push_back("26 (Faces, Edges and Corners)");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameter->setGroupIndex(Volume);
+    parameters.push_back(parameter);
+  }
+  parameters.push_back(IntFilterParameter::New("Max Concurrent Slices", "MaxConcurrentSlices", getMaxConcurrentSlices(), FilterParameter::Parameter, IndependentSlices));
+  parameters.push_back(IntFilterParameter::New("Random Seed (0 Uses the Clock)", "RandomSeed", getRandomSeed(), FilterParameter::Parameter));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::UInt8, 1, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
@@ -141,6 +188,10 @@ void EMMPMFilter::readFilterParameters(AbstractFilterParametersReader* reader, i
   setCurvaturePenalty(reader->readValue("CurvaturePenalty", getCurvaturePenalty()));
   setRMax(reader->readValue("RMax", getRMax()));
   setEMLoopDelay(reader->readValue("EMLoopDelay", getEMLoopDelay()));
+  setSegmentationMode(reader->readValue("SegmentationMode", getSegmentationMode()));
+  setNeighborhood(reader->readValue("Neighborhood", getNeighborhood()));
+  setMaxConcurrentSlices(reader->readValue("MaxConcurrentSlices", getMaxConcurrentSlices()));
+  setRandomSeed(reader->readValue("RandomSeed", getRandomSeed()));
   setOutputDataArrayPath(reader->readDataArrayPath("OutputDataArrayPath", getOutputDataArrayPath()));
   reader->closeFilterGroup();
 }
@@ -164,6 +215,10 @@ int EMMPMFilter::writeFilterParameters(AbstractFilterParametersWriter* writer, i
   SIMPL_FILTER_WRITE_PARAMETER(CurvaturePenalty)
   SIMPL_FILTER_WRITE_PARAMETER(RMax)
   SIMPL_FILTER_WRITE_PARAMETER(EMLoopDelay)
+  SIMPL_FILTER_WRITE_PARAMETER(SegmentationMode)
+  SIMPL_FILTER_WRITE_PARAMETER(Neighborhood)
+  SIMPL_FILTER_WRITE_PARAMETER(MaxConcurrentSlices)
+  SIMPL_FILTER_WRITE_PARAMETER(RandomSeed)
   SIMPL_FILTER_WRITE_PARAMETER(OutputDataArrayPath)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
@@ -208,6 +263,58 @@ void EMMPMFilter::dataCheck()
     QString ss = QObject::tr("The minimum number of classes is 2");
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
   }
+  if (getSegmentationMode() == Volume && (getUseGradientPenalty() || getUseCurvaturePenalty()))
+  {
+    setErrorCondition(-62004);
+    QString ss = QObject::tr("The gradient and curvature penalties are only available for 2D images. Turn them off or use the Independent Slices mode");
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+  if (getSegmentationMode() == IndependentSlices && getMaxConcurrentSlices() < 1)
+  {
+    setErrorCondition(-62005);
+    QString ss = QObject::tr("The maximum number of concurrent slices must be at least 1");
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if(getErrorCondition() < 0) { return; }
+
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(getInputDataArrayPath());
+  if(NULL != am.get())
+  {
+    checkSegmentationSize(am->getTupleDimensions());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::checkSegmentationSize(const QVector<size_t>& tDims)
+{
+  size_t columns = (tDims.size() > 0) ? tDims[0] : 1;
+  size_t rows = (tDims.size() > 1) ? tDims[1] : 1;
+  size_t slices = (tDims.size() > 2) ? tDims[2] : 1;
+  // Only the Volume mode keeps the working memory of more than one XY plane at a time
+  if (getSegmentationMode() != Volume)
+  {
+    slices = 1;
+  }
+
+  // The EM/MPM library stores the dimensions as 32 bit values and walks the
+  // rows * slices lines of the image with 32 bit indices. Every per voxel buffer
+  // holds up to one real_t per class.
+  const size_t maxDim = static_cast<size_t>(std::numeric_limits<int32_t>::max());
+  const size_t maxVoxels = std::numeric_limits<size_t>::max() / (sizeof(real_t) * static_cast<size_t>(getNumClasses() + 1));
+  bool tooLarge = (columns > maxDim || rows > maxDim || slices > maxDim);
+  if (!tooLarge && slices > 0 && rows > maxDim / slices) { tooLarge = true; }
+  if (!tooLarge && rows * slices > 0 && columns > maxVoxels / (rows * slices)) { tooLarge = true; }
+
+  if (tooLarge)
+  {
+    setErrorCondition(-62006);
+    QString ss = QObject::tr("The image (%1 x %2 x %3) is too large to be segmented in a single pass. Use the Independent Slices mode or crop the image")
+                 .arg(columns).arg(rows).arg(slices);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -241,16 +348,51 @@ void EMMPMFilter::execute()
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void EMMPMFilter::segment(EMMPM_InitializationType initType)
+/**
+ * @brief The SliceStatus struct holds the error condition and the error and warning
+ * messages of one slice that was segmented without a receiving filter.
+ */
+struct SliceStatus
 {
-  // Copy all the variables from the filter into the EMmpm data structure.
-  EMMPM_Data::Pointer data = EMMPM_Data::New();
-  data->initVariables();
-  data->initType = initType;
+  SliceStatus() : errorCondition(0) {}
+  int errorCondition;
+  QVector<PipelineMessage> messages;
+};
+
+/**
+ * @brief The SliceMessageCollector class stores the error and warning messages
+ * of an EMMPM object in a SliceStatus. It is invoked directly on the thread
+ * that is segmenting the slice.
+ */
+class SliceMessageCollector
+{
+  public:
+    SliceMessageCollector(SliceStatus* status) :
+      m_Status(status)
+    {}
+    virtual ~SliceMessageCollector() {}
+
+    void operator()(const PipelineMessage& msg) const
+    {
+      if (msg.getType() == PipelineMessage::Error || msg.getType() == PipelineMessage::Warning)
+      {
+        m_Status->messages.push_back(msg);
+      }
+    }
 
+  private:
+    SliceStatus* m_Status;
+};
+
+/**
+ * @brief Runs the EM/MPM algorithm on an EMMPM_Data object that was created by
+ * EMMPMFilter::createEmmpmData(). If a receiver is given the status messages of
+ * the algorithm are forwarded to it, otherwise the errors and warnings are stored
+ * in the status if one is given.
+ * @return The error condition of the algorithm
+ */
+static int ExecuteEmmpm(EMMPM_Data::Pointer data, const QString& messagePrefix, AbstractFilter* receiver, SliceStatus* status = NULL)
+{
   InitializationFunction::Pointer initFunction = BasicInitialization::New();
 
   // Set the initialization function based on the parameters
@@ -267,6 +409,77 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
       break;
   }
 
+  // Create a new StatsDelegate so the EMMPM algorith has somewhere to write its statistics
+  StatsDelegate::Pointer statsDelegate = StatsDelegate::New();
+
+  // Start the EM/MPM process going
+  EMMPM::Pointer emmpm = EMMPM::New();
+
+  emmpm->setData(data);
+  emmpm->setStatsDelegate(statsDelegate.get());
+  emmpm->setInitializationFunction(initFunction);
+  emmpm->setMessagePrefix(messagePrefix);
+
+  // Connect up the Error/Warning/Progress object so the filter can report those things
+  if (NULL != receiver)
+  {
+    QObject::connect(emmpm.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)),
+                     receiver, SLOT(broadcastPipelineMessage(const PipelineMessage&)));
+  }
+  else if (NULL != status)
+  {
+    QObject::connect(emmpm.get(), &Observable::filterGeneratedMessage, SliceMessageCollector(status));
+  }
+
+  emmpm->execute();
+
+  // We manually set the pointers to NULL so that the EMMPM_Data class does not try to free the memory
+  data->inputImage = NULL;
+  data->xt = NULL;
+
+  if (NULL != status)
+  {
+    status->errorCondition = emmpm->getErrorCondition();
+  }
+  return emmpm->getErrorCondition();
+}
+
+/**
+ * @brief The SegmentSliceImpl class segments a single XY plane of a volume and
+ * records the outcome in the status of that slice
+ */
+class SegmentSliceImpl
+{
+  public:
+    SegmentSliceImpl(EMMPM_Data::Pointer data, const QString& messagePrefix, SliceStatus* status) :
+      m_Data(data),
+      m_MessagePrefix(messagePrefix),
+      m_Status(status)
+    {}
+    virtual ~SegmentSliceImpl() {}
+
+    void operator()() const
+    {
+      ExecuteEmmpm(m_Data, m_MessagePrefix, NULL, m_Status);
+    }
+
+  private:
+    EMMPM_Data::Pointer m_Data;
+    QString m_MessagePrefix;
+    SliceStatus* m_Status;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EMMPM_Data::Pointer EMMPMFilter::createEmmpmData(EMMPM_InitializationType initType, size_t columns, size_t rows, size_t slices,
+                                                 uint8_t* input, uint8_t* output)
+{
+  // Copy all the variables from the filter into the EMmpm data structure.
+  EMMPM_Data::Pointer data = EMMPM_Data::New();
+  data->initVariables();
+  data->initType = initType;
+
   data->classes = getNumClasses();
   data->in_beta = getExchangeEnergy();
   data->emIterations = getHistogramLoops();
@@ -283,16 +496,14 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
     data->w_gamma[i] = i;
   }
 
-  DataArrayPath dap = getInputDataArrayPath();
-  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
-  QVector<size_t> tDims = am->getTupleDimensions();
-  IDataArray::Pointer iDataArray = am->getAttributeArray(getInputDataArrayPath().getDataArrayName());
-  QVector<size_t> cDims = iDataArray->getComponentDimensions();
-
-  data->columns = tDims[0];
-  data->rows = tDims[1];
+  data->columns = columns;
+  data->rows = rows;
+  data->slices = slices;
   data->dims = 1; // We operate on a single channel | single component "image".
-  data->inputImageChannels = cDims[0];
+  data->inputImageChannels = 1;
+
+  const unsigned int neighborhoods[3] = { 6, 18, 26 };
+  data->neighborhood = neighborhoods[(getNeighborhood() >= 0 && getNeighborhood() < 3) ? getNeighborhood() : 2];
 
   data->simulatedAnnealing = (char)( getUseSimulatedAnnealing() );
   data->useGradientPenalty = getUseGradientPenalty();
@@ -301,13 +512,22 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
   data->beta_c = getCurvaturePenalty();
   data->r_max = getRMax();
   data->ccostLoopDelay = getEMLoopDelay();
+  // A fixed seed makes the MPM random streams, and so the segmentation, reproducible;
+  // every slice of the Independent Slices mode starts from the same seed
+  data->rngSeed = static_cast<uint64_t>(static_cast<uint32_t>(getRandomSeed()));
 
   // Assign our data array allocated input and output images into the EMMPM_Data class
-  data->inputImage = m_InputImage;
-  data->xt = m_OutputImage;
+  data->inputImage = input;
+  data->xt = output;
 
   // Allocate all the memory here
-  data->allocateDataStructureMemory();
+  if (data->allocateDataStructureMemory() < 0)
+  {
+    // Do not let the EMMPM_Data class free the borrowed buffers
+    data->inputImage = NULL;
+    data->xt = NULL;
+    return EMMPM_Data::NullPointer();
+  }
 
   // If we are using the "Feedback" loop then we copy the previous Mu/Sigma values into the Mean/Variance
   // variables
@@ -323,26 +543,48 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
     }
   }
 
-  // Create a new StatsDelegate so the EMMPM algorith has somewhere to write its statistics
-  StatsDelegate::Pointer statsDelegate = StatsDelegate::New();
-
-  // Start the EM/MPM process going
-  EMMPM::Pointer emmpm = EMMPM::New();
+  return data;
+}
 
-  emmpm->setData(data);
-  emmpm->setStatsDelegate(statsDelegate.get());
-  emmpm->setInitializationFunction(initFunction);
-  emmpm->setMessagePrefix(getMessagePrefix());
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::segment(EMMPM_InitializationType initType)
+{
+  DataArrayPath dap = getInputDataArrayPath();
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
+  QVector<size_t> tDims = am->getTupleDimensions();
+  size_t slices = (tDims.size() > 2) ? tDims[2] : 1;
 
-  // Connect up the Error/Warning/Progress object so the filter can report those things
-  connect(emmpm.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)),
-          this, SLOT(broadcastPipelineMessage(const PipelineMessage&)));
+  if (getSegmentationMode() == IndependentSlices)
+  {
+    segmentSlices(initType, tDims);
+    return;
+  }
 
-  emmpm->execute();
+  // The single image mode only looks at the first XY plane of the image while
+  // the volume mode uses the 3D neighborhood and one set of class statistics
+  // for the whole volume
+  if (getSegmentationMode() != Volume)
+  {
+    slices = 1;
+  }
 
-  // We manually set the pointers to NULL so that the EMMPM_Data class does not try to free the memory
-  data->inputImage = NULL;
-  data->xt = NULL;
+  EMMPM_Data::Pointer data = createEmmpmData(initType, tDims[0], tDims[1], slices, m_InputImage, m_OutputImage);
+  if (NULL == data.get())
+  {
+    setErrorCondition(-62007);
+    QString ss = QObject::tr("Error allocating the working memory of the EM/MPM algorithm");
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  int err = ExecuteEmmpm(data, getMessagePrefix(), this);
+  if (err < 0)
+  {
+    // The algorithm already sent its error message through this filter
+    setErrorCondition(err);
+    return;
+  }
 
   // Grab the Mu/Sigma values from the current finished segmented image and use those as inputs
   // into the initialization of the next Image to be Segmented
@@ -364,6 +606,102 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::segmentSlices(EMMPM_InitializationType initType, const QVector<size_t>& tDims)
+{
+  size_t columns = tDims[0];
+  size_t rows = tDims[1];
+  size_t slices = (tDims.size() > 2) ? tDims[2] : 1;
+  size_t sliceSize = columns * rows;
+
+  // Only MaxConcurrentSlices planes are in flight at any time. Each one holds
+  // its own working memory (roughly classes * 2 floats per pixel) so this is
+  // what bounds the memory used by this mode.
+  size_t batchSize = static_cast<size_t>(getMaxConcurrentSlices());
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  for (size_t batchStart = 0; batchStart < slices; batchStart += batchSize)
+  {
+    if (getCancel()) { break; }
+    size_t batchEnd = std::min(batchStart + batchSize, slices);
+
+    QString ss = QObject::tr("Segmenting Slices %1-%2 of %3").arg(batchStart + 1).arg(batchEnd).arg(slices);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+    // Each slice of the batch reports into its own status so the errors and
+    // warnings can be sent from this thread once the batch is finished
+    std::vector<SliceStatus> statuses(batchEnd - batchStart);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_group* g = new tbb::task_group;
+#endif
+    for (size_t z = batchStart; z < batchEnd; z++)
+    {
+      SliceStatus* status = &(statuses[z - batchStart]);
+      EMMPM_Data::Pointer data = createEmmpmData(initType, columns, rows, 1, m_InputImage + z * sliceSize, m_OutputImage + z * sliceSize);
+      if (NULL == data.get())
+      {
+        status->errorCondition = -62007;
+        PipelineMessage em(getNameOfClass(), QObject::tr("Error allocating the working memory of the EM/MPM algorithm"), -62007, PipelineMessage::Error);
+        status->messages.push_back(em);
+        break;
+      }
+      QString prefix = QObject::tr("%1 (Slice %2)").arg(getMessagePrefix()).arg(z);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        g->run(SegmentSliceImpl(data, prefix, status));
+      }
+      else
+#endif
+      {
+        SegmentSliceImpl serial(data, prefix, status);
+        serial();
+      }
+    }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    g->wait(); // Wait for all the slices of this batch before starting the next one
+    delete g;
+#endif
+
+    int32_t failedSlice = -1;
+    for (size_t i = 0; i < statuses.size(); i++)
+    {
+      const SliceStatus& status = statuses[i];
+      for (int32_t m = 0; m < status.messages.size(); m++)
+      {
+        const PipelineMessage& msg = status.messages[m];
+        QString text = QObject::tr("Slice %1: %2").arg(batchStart + i).arg(msg.getText());
+        if (msg.getType() == PipelineMessage::Warning)
+        {
+          notifyWarningMessage(getHumanLabel(), text, msg.getCode());
+        }
+        else if (failedSlice < 0)
+        {
+          failedSlice = static_cast<int32_t>(i);
+          setErrorCondition(status.errorCondition < 0 ? status.errorCondition : msg.getCode());
+          notifyErrorMessage(getHumanLabel(), text, getErrorCondition());
+        }
+      }
+      if (failedSlice < 0 && status.errorCondition < 0)
+      {
+        failedSlice = static_cast<int32_t>(i);
+        setErrorCondition(status.errorCondition);
+        QString text = QObject::tr("Slice %1: The EM/MPM algorithm failed").arg(batchStart + i);
+        notifyErrorMessage(getHumanLabel(), text, getErrorCondition());
+      }
+    }
+    // Do not start any more slices once one of them has failed
+    if (failedSlice >= 0) { break; }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -42,6 +42,7 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 
 #include "EMMPMLib/Core/EMMPM_Constants.h"
+#include "EMMPMLib/Core/EMMPM_Data.h"
 
 /**
  * @brief The EMMPMFilter class. See [Filter documentation](@ref emmpmfilter) for details.
@@ -57,6 +58,13 @@ class EMMPMFilter : public AbstractFilter
 
     virtual ~EMMPMFilter();
 
+    enum SegmentationModes
+    {
+      SingleImage = 0,      //!< Segments the first XY plane of the image
+      Volume = 1,           //!< Segments the whole volume with a 3D MRF prior and shared class statistics
+      IndependentSlices = 2 //!< Segments every XY plane on its own, several planes at a time
+    };
+
     SIMPL_FILTER_PARAMETER(DataArrayPath, InputDataArrayPath)
     Q_PROPERTY(DataArrayPath InputDataArrayPath READ getInputDataArrayPath WRITE setInputDataArrayPath)
 
@@ -93,6 +101,18 @@ class EMMPMFilter : public AbstractFilter
     SIMPL_FILTER_PARAMETER(int, EMLoopDelay)
     Q_PROPERTY(int EMLoopDelay READ getEMLoopDelay WRITE setEMLoopDelay)
 
+    SIMPL_FILTER_PARAMETER(int, SegmentationMode)
+    Q_PROPERTY(int SegmentationMode READ getSegmentationMode WRITE setSegmentationMode)
+
+    SIMPL_FILTER_PARAMETER(int, Neighborhood)
+    Q_PROPERTY(int Neighborhood READ getNeighborhood WRITE setNeighborhood)
+
+    SIMPL_FILTER_PARAMETER(int, MaxConcurrentSlices)
+    Q_PROPERTY(int MaxConcurrentSlices READ getMaxConcurrentSlices WRITE setMaxConcurrentSlices)
+
+    SIMPL_FILTER_PARAMETER(int, RandomSeed)
+    Q_PROPERTY(int RandomSeed READ getRandomSeed WRITE setRandomSeed)
+
     SIMPL_FILTER_PARAMETER(DataArrayPath, OutputDataArrayPath)
     Q_PROPERTY(DataArrayPath OutputDataArrayPath READ getOutputDataArrayPath WRITE setOutputDataArrayPath)
 
@@ -204,6 +224,35 @@ class EMMPMFilter : public AbstractFilter
      */
     virtual void segment(EMMPM_InitializationType initType);
 
+    /**
+     * @brief createEmmpmData Creates an EMMPM_Data object holding the current filter parameters
+     * and allocates its working memory. The input and output buffers are borrowed, not copied.
+     * @param initType Enumeration of EMMPM initialization types
+     * @param columns The width of the image
+     * @param rows The height of the image
+     * @param slices The number of slices that are segmented together
+     * @param input The gray scale input pixels
+     * @param output The class labels
+     * @return
+     */
+    EMMPM_Data::Pointer createEmmpmData(EMMPM_InitializationType initType, size_t columns, size_t rows, size_t slices,
+                                        uint8_t* input, uint8_t* output);
+
+    /**
+     * @brief segmentSlices Segments every XY plane of the volume independently running
+     * up to MaxConcurrentSlices planes at the same time.
+     * @param initType Enumeration of EMMPM initialization types
+     * @param tDims The tuple dimensions of the input image
+     */
+    void segmentSlices(EMMPM_InitializationType initType, const QVector<size_t>& tDims);
+
+    /**
+     * @brief checkSegmentationSize Sets an error condition if the working memory of the
+     * EM/MPM algorithm for an image of the given tuple dimensions can not be addressed.
+     * @param tDims The tuple dimensions of the input image
+     */
+    void checkSegmentationSize(const QVector<size_t>& tDims);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(uint8_t, InputImage)
     DEFINE_DATAARRAY_VARIABLE(uint8_t, OutputImage)
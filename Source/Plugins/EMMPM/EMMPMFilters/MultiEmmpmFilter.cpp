@@ -130,6 +130,10 @@ void MultiEmmpmFilter::readFilterParameters(AbstractFilterParametersReader* read
   setCurvaturePenalty(reader->readValue("CurvaturePenalty", getCurvaturePenalty()));
   setRMax(reader->readValue("RMax", getRMax()));
   setEMLoopDelay(reader->readValue("EMLoopDelay", getEMLoopDelay()));
+  setSegmentationMode(reader->readValue("SegmentationMode", getSegmentationMode()));
+  setNeighborhood(reader->readValue("Neighborhood", getNeighborhood()));
+  setMaxConcurrentSlices(reader->readValue("MaxConcurrentSlices", getMaxConcurrentSlices()));
+  setRandomSeed(reader->readValue("RandomSeed", getRandomSeed()));
   setOutputAttributeMatrixName(reader->readString("OutputAttributeMatrixName", getOutputAttributeMatrixName()));
   setUsePreviousMuSigma(reader->readValue("UsePreviousMuSigma", getUsePreviousMuSigma()));
   setOutputArrayPrefix(reader->readString("OutputArrayPrefix", getOutputArrayPrefix()));
@@ -155,6 +159,10 @@ int MultiEmmpmFilter::writeFilterParameters(AbstractFilterParametersWriter* writ
   SIMPL_FILTER_WRITE_PARAMETER(CurvaturePenalty)
   SIMPL_FILTER_WRITE_PARAMETER(RMax)
   SIMPL_FILTER_WRITE_PARAMETER(EMLoopDelay)
+  SIMPL_FILTER_WRITE_PARAMETER(SegmentationMode)
+  SIMPL_FILTER_WRITE_PARAMETER(Neighborhood)
+  SIMPL_FILTER_WRITE_PARAMETER(MaxConcurrentSlices)
+  SIMPL_FILTER_WRITE_PARAMETER(RandomSeed)
   SIMPL_FILTER_WRITE_PARAMETER(OutputAttributeMatrixName)
   SIMPL_FILTER_WRITE_PARAMETER(UsePreviousMuSigma)
   SIMPL_FILTER_WRITE_PARAMETER(OutputArrayPrefix)
@@ -261,6 +269,22 @@ void MultiEmmpmFilter::dataCheck()
     QString ss = QObject::tr("The minimum number of classes is 2");
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
   }
+  if (getSegmentationMode() == Volume && (getUseGradientPenalty() || getUseCurvaturePenalty()))
+  {
+    setErrorCondition(-62004);
+    QString ss = QObject::tr("The gradient and curvature penalties are only available for 2D images. Turn them off or use the Independent Slices mode");
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+  if (getSegmentationMode() == IndependentSlices && getMaxConcurrentSlices() < 1)
+  {
+    setErrorCondition(-62005);
+    QString ss = QObject::tr("The maximum number of concurrent slices must be at least 1");
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+  if (getErrorCondition() >= 0)
+  {
+    checkSegmentationSize(tDims);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -362,6 +386,10 @@ AbstractFilter::Pointer MultiEmmpmFilter::newFilterInstance(bool copyFilterParam
     SIMPL_COPY_INSTANCEVAR(CurvaturePenalty)
     SIMPL_COPY_INSTANCEVAR(RMax)
     SIMPL_COPY_INSTANCEVAR(EMLoopDelay)
+    SIMPL_COPY_INSTANCEVAR(SegmentationMode)
+    SIMPL_COPY_INSTANCEVAR(Neighborhood)
+    SIMPL_COPY_INSTANCEVAR(MaxConcurrentSlices)
+    SIMPL_COPY_INSTANCEVAR(RandomSeed)
     SIMPL_COPY_INSTANCEVAR(OutputAttributeMatrixName)
   }
   return filter;
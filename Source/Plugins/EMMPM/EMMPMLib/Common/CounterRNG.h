@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, BlueQuartz Software
+//  All rights reserved.
+//  BSD License: http://www.opensource.org/licenses/bsd-license.html
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _counterrng_h_
+#define _counterrng_h_
+
+#include <stdint.h>
+
+/**
+ * @class CounterRNG CounterRNG.h EMMPMLib/Common/CounterRNG.h
+ * @brief A stateless, counter based random number generator. Each value is a
+ * pure function of (seed, stream, counter) so any thread can draw the number
+ * belonging to any pixel without sharing generator state. This makes the
+ * parallel MPM sweeps independent of how the work is scheduled. The mixing
+ * function is the 64 bit finalizer from SplitMix64 applied twice.
+ */
+class CounterRNG
+{
+  public:
+    CounterRNG(uint64_t seed, uint64_t stream) :
+      m_Key(mix(seed ^ (stream * 0xD1B54A32D192ED03ULL)))
+    {}
+
+    /**
+     * @brief Returns the raw 64 bit value for the given counter
+     * @param counter
+     */
+    inline uint64_t operator()(uint64_t counter) const
+    {
+      return mix(m_Key + (counter + 1) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    /**
+     * @brief Returns a uniform deviate in the range [0, 1) for the given counter.
+     * @param counter
+     */
+    inline float uniform(uint64_t counter) const
+    {
+      return static_cast<float>((*this)(counter) >> 40) * (1.0f / 16777216.0f);
+    }
+
+  private:
+    uint64_t m_Key;
+
+    static inline uint64_t mix(uint64_t z)
+    {
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return z ^ (z >> 31);
+    }
+};
+
+#endif /* _counterrng_h_ */
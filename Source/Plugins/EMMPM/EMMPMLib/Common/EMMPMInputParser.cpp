@@ -229,6 +229,9 @@ int EMMPMInputParser::parseCLIArguments(int argc, char* argv[], EMMPM_Data* inpu
   TCLAP::SwitchArg simAnneal("s", "simanneal", "Use Simulated Annealing", false);
   cmd.add(simAnneal);
 
+  TCLAP::ValueArg<unsigned long long> rngSeed("", "seed", "Seed for the MPM random number streams. Using the same seed reproduces a segmentation exactly. 0 seeds from the clock", false, 0, "0");
+  cmd.add(rngSeed);
+
   TCLAP::ValueArg<int> initType("z", "inittype", "The initialization algorithm that should be performed", false, 0, "1");
   cmd.add(initType);
   TCLAP::ValueArg<std::string> initcoords("", "coords", "The upper left (x,y) and lower right (x,y) pixel coordinate sets of each class to be used in the initialization algorithm where each set is separated by a colon ':'. An example is 487,192,507,212:0,332,60,392 for 2 class system.", false, "", "");
@@ -277,6 +280,7 @@ int EMMPMInputParser::parseCLIArguments(int argc, char* argv[], EMMPM_Data* inpu
     inputs->classes = in_numClasses.getValue();
     inputs->verbose = in_verbose.getValue();
     inputs->simulatedAnnealing = simAnneal.getValue();
+    inputs->rngSeed = rngSeed.getValue();
 
     inputs->input_file_name = copyFilenameToNewCharBuffer(in_inputFile.getValue() );
     if (inputs->input_file_name == NULL)
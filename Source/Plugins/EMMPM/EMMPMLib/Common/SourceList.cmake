@@ -10,6 +10,7 @@ set (EMMPMLib_Common_SRCS
 )
 
 set (EMMPMLib_Common_HDRS
+    ${EMMPMLib_SOURCE_DIR}/Common/CounterRNG.h
     ${EMMPMLib_SOURCE_DIR}/Common/EMMPM_Math.h
     ${EMMPMLib_SOURCE_DIR}/Common/EMMPMLibDLLExport.h
     ${EMMPMLib_SOURCE_DIR}/Common/EMTime.h
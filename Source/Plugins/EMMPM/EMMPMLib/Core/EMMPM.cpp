@@ -132,6 +132,7 @@ void EMMPM::printData(EMMPM_Data::Pointer data)
   PRINT_DATA( classes); /**<  */
   PRINT_DATA( rows); /**< The height of the image.  Applicable for both input and output images */
   PRINT_DATA( columns); /**< The width of the image. Applicable for both input and output images */
+  PRINT_DATA( slices); /**< The number of slices in a volume */
   PRINT_DATA( channels); /**< The number of color channels in the images. This should always be 1 */
   PRINT_DATA( initType); /**< The type of initialization algorithm to use  */
   PRINT_2D_UINT_ARRAY( initCoords, EMMPM_MAX_CLASSES, 4); /**<  MAX_CLASSES rows x 4 Columns  */
@@ -185,6 +186,14 @@ void EMMPM::execute()
 
   if (data->cancel) { data->progress = 100.0; return; }
 
+  /* The gradient and curvature penalties are defined on the 2D pixel grid */
+  if (data->slices > 1 && (data->useCurvaturePenalty || data->useGradientPenalty))
+  {
+    setErrorCondition(-55200);
+    notifyErrorMessage(getHumanLabel(), "The gradient and curvature penalties are not available when segmenting a volume", getErrorCondition());
+    return;
+  }
+
 
   /* Initialize the Curvature Penalty variables:  */
   data->ccost = NULL;
@@ -52,13 +52,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 void EMMPMUtilities::ConvertInputImageToWorkingImage(EMMPM_Data::Pointer data)
 {
   uint8_t* dst;
-  int i;
-  int j;
-  int d;
+  size_t i;
+  size_t j;
+  size_t d;
   size_t index = 0;
-  int width;
-  int height;
-  int dims;
+  size_t width;
+  size_t height;
+  size_t dims;
 
   if (data->inputImageChannels == 0)
   {
@@ -75,7 +75,7 @@ void EMMPMUtilities::ConvertInputImageToWorkingImage(EMMPM_Data::Pointer data)
 
   /* Copy input image to y[][] */
   width = data->columns;
-  height = data->rows;
+  height = static_cast<size_t>(data->rows) * data->slices;
   dims = data->dims;
   dst = data->inputImage;
 
@@ -100,7 +100,8 @@ void EMMPMUtilities::ConvertInputImageToWorkingImage(EMMPM_Data::Pointer data)
 void EMMPMUtilities::ConvertXtToOutputImage(EMMPM_Data::Pointer data)
 {
   size_t index;
-  unsigned int i, j, d;
+  size_t i, j;
+  unsigned int d;
   unsigned char* raster;
   int l, ld;
   size_t gtindex = 0;
@@ -128,10 +129,10 @@ void EMMPMUtilities::ConvertXtToOutputImage(EMMPM_Data::Pointer data)
   }
   raster = data->outputImage;
   index = 0;
-  totalPixels = data->rows * data->columns;
-  unsigned int rows = data->rows;
-  unsigned int columns = data->columns;
-  unsigned int ixCol = 0;
+  totalPixels = static_cast<size_t>(data->rows) * data->slices * data->columns;
+  size_t rows = static_cast<size_t>(data->rows) * data->slices;
+  size_t columns = data->columns;
+  size_t ixCol = 0;
   unsigned int* colorTable = data->colorTable;
 
   for (i = 0; i < rows; i++)
@@ -254,28 +255,28 @@ class EstimateMeans
     }
     virtual ~EstimateMeans() {}
 
-    void calc(int rowStart, int rowEnd, int colStart, int colEnd) const
+    void calc(size_t rowStart, size_t rowEnd, size_t colStart, size_t colEnd) const
     {
-      int dims = data->dims;
-      int rows = data->rows;
-      int cols = data->columns;
-      int32_t k_, k2_, lij, ld, ijd, k_temp, k2_temp;
+      size_t dims = data->dims;
+      size_t rows = static_cast<size_t>(data->rows) * data->slices;
+      size_t cols = data->columns;
+      size_t k_, k2_, lij, ld, ijd, k_temp, k2_temp;
       real_t* m = data->mean;
       unsigned char* y = data->y;
       real_t* probs = data->probs;
       real_t* N = data->N;
 
       k_temp = (cols * rows * l);
-      for (int r = rowStart; r < rowEnd; r++)
+      for (size_t r = rowStart; r < rowEnd; r++)
       {
         k_ = k_temp + (cols * r);
         k2_temp = (dims * cols * r);
-        for (int c = colStart; c < colEnd; c++)
+        for (size_t c = colStart; c < colEnd; c++)
         {
           k2_ = k2_temp + ( dims * c);
           lij = k_ + c;
           N[l] += probs[lij]; // denominator of (20)
-          for (int d = 0; d < dims; d++)
+          for (size_t d = 0; d < dims; d++)
           {
             ld = dims * l + d;
             ijd = k2_ + d;
@@ -285,7 +286,7 @@ class EstimateMeans
       }
       if (N[l] != 0)
       {
-        for (int d = 0; d < dims; d++)
+        for (size_t d = 0; d < dims; d++)
         {
           ld = dims * l + d;
           m[ld] = m[ld] / N[l];
@@ -311,31 +312,31 @@ class EstimateVariance
     }
     virtual ~EstimateVariance() {}
 
-    void calc(int rowStart, int rowEnd, int colStart, int colEnd) const
+    void calc(size_t rowStart, size_t rowEnd, size_t colStart, size_t colEnd) const
     {
-      int dims = data->dims;
-      int rows = data->rows;
-      int cols = data->columns;
-      int32_t k_, k2_, lij, ld, ijd, k_temp, k2_temp;
+      size_t dims = data->dims;
+      size_t rows = static_cast<size_t>(data->rows) * data->slices;
+      size_t cols = data->columns;
+      size_t k_, k2_, lij, ld, ijd, k_temp, k2_temp;
       real_t* m = data->mean;
       unsigned char* y = data->y;
       real_t* probs = data->probs;
       real_t* N = data->N;
       real_t res = 0.0f;
       real_t* v = data->variance;
-      int32_t dimsXl = dims * l;
+      size_t dimsXl = dims * l;
 
       k_temp = (cols * rows * l);
-      for (int r = rowStart; r < rowEnd; r++)
+      for (size_t r = rowStart; r < rowEnd; r++)
       {
         k_ = k_temp + (cols * r);
         k2_temp = (dims * cols * r);
-        for (int c = colStart; c < colEnd; c++)
+        for (size_t c = colStart; c < colEnd; c++)
         {
           k2_ = k2_temp + ( dims * c);
           // numerator of (21)
           lij = k_ + c;
-          for (int d = 0; d < dims; d++)
+          for (size_t d = 0; d < dims; d++)
           {
             ld = dimsXl + d;
             ijd = k2_ + d;
@@ -348,7 +349,7 @@ class EstimateVariance
 
       if(N[l] != 0)
       {
-        for (int d = 0; d < dims; d++)
+        for (size_t d = 0; d < dims; d++)
         {
           ld = dims * l + d;
           v[ld] = v[ld] / N[l];
@@ -371,7 +372,7 @@ void EMMPMUtilities::UpdateMeansAndVariances(EMMPM_Data::Pointer dt)
 
   size_t l;
 // size_t dims = data->dims;
-  size_t rows = data->rows;
+  size_t rows = static_cast<size_t>(data->rows) * data->slices;
   size_t cols = data->columns;
   size_t classes = data->classes;
 
@@ -436,7 +437,7 @@ void EMMPMUtilities::RemoveZeroProbClasses(EMMPM_Data::Pointer dt)
 
   size_t kk, l, dd, ld, l1d, i, j, ij;
   size_t dims = data->dims;
-  size_t rows = data->rows;
+  size_t rows = static_cast<size_t>(data->rows) * data->slices;
   size_t cols = data->columns;
   size_t classes = data->classes;
 
@@ -95,13 +95,13 @@ int EMMPM_Data::allocateDataStructureMemory()
 {
   if(NULL == this->y)
   {
-    this->y = (unsigned char*)malloc(this->columns * this->rows * this->dims * sizeof(unsigned char));
+    this->y = (unsigned char*)malloc(static_cast<size_t>(this->columns) * this->rows * this->slices * this->dims * sizeof(unsigned char));
   }
   if(NULL == this->y) { return -1; }
 
   if(NULL == this->xt)
   {
-    this->xt = (unsigned char*)malloc(this->columns * this->rows * sizeof(unsigned char));
+    this->xt = (unsigned char*)malloc(static_cast<size_t>(this->columns) * this->rows * this->slices * sizeof(unsigned char));
   }
   if(NULL == this->xt) { return -1; }
 
@@ -132,7 +132,7 @@ int EMMPM_Data::allocateDataStructureMemory()
 
   if(NULL == this->probs)
   {
-    this->probs = (real_t*)malloc(this->classes * this->columns * this->rows * sizeof(real_t));
+    this->probs = (real_t*)malloc(static_cast<size_t>(this->classes) * this->columns * this->rows * this->slices * sizeof(real_t));
   }
   if(NULL == this->probs) { return -1; }
 
@@ -164,7 +164,7 @@ void EMMPM_Data::allocateOutputImage()
     this->outputImage = NULL;
   }
 
-  this->outputImage = reinterpret_cast<unsigned char*>(malloc(this->columns * this->rows * this->dims));
+  this->outputImage = reinterpret_cast<unsigned char*>(malloc(static_cast<size_t>(this->columns) * this->rows * this->slices * this->dims));
 }
 
 // -----------------------------------------------------------------------------
@@ -181,6 +181,8 @@ void EMMPM_Data::initVariables()
   this->classes = 0;
   this->rows = 0;
   this->columns = 0;
+  this->slices = 1;
+  this->neighborhood = 26;
   this->dims = 1;
   this->initType = EMMPM_Basic;
   this->couplingBeta = NULL;
@@ -197,6 +199,7 @@ void EMMPM_Data::initVariables()
   }
   this->verbose = 0;
   this->cancel = 0;
+  this->rngSeed = 0;
 
   this->mean = NULL;
   this->variance = NULL;
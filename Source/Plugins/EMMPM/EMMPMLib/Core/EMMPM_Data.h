@@ -39,6 +39,7 @@
 
 // C Includes
 #include <stddef.h>
+#include <stdint.h>
 
 // C++ Includes
 #include <vector>
@@ -100,6 +101,8 @@ class EMMPMLib_EXPORT EMMPM_Data
     int classes; /**<  */
     unsigned int rows; /**< The height of the image.  Applicable for both input and output images */
     unsigned int columns; /**< The width of the image. Applicable for both input and output images */
+    unsigned int slices; /**< The number of slices in a volume. Slices are stacked after each other so any per pixel loop runs over rows * slices rows. 1 for a 2D image */
+    unsigned int neighborhood; /**< The size of the MRF clique when segmenting a volume. One of 6, 18 or 26 */
     unsigned int dims; /**< The number of vector elements in the image.*/
     enum EMMPM_InitializationType initType;  /**< The type of initialization algorithm to use  */
     unsigned int initCoords[EMMPM_MAX_CLASSES][4];  /**<  MAX_CLASSES rows x 4 Columns  */
@@ -107,6 +110,7 @@ class EMMPMLib_EXPORT EMMPM_Data
     unsigned int colorTable[EMMPM_MAX_CLASSES];
     real_t min_variance[EMMPM_MAX_CLASSES]; /**< The minimum value that the variance can be for each class */
     char simulatedAnnealing; /**<  */
+    uint64_t rngSeed; /**< Seed for the MPM random streams. A value of zero seeds from the clock on the first MPM loop */
     char verbose; /**<  */
 
 
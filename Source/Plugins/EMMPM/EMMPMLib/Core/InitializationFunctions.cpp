@@ -40,17 +40,12 @@
 #include <string.h>
 
 
-//-- Boost Includes
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/uniform_real.hpp>
-#include <boost/random/variate_generator.hpp>
-
-
 //-- EMMMPM Lib Includes
 #include "EMMPMLib/Core/EMMPM.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
 #include "EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPMLib/Common/EMTime.h"
+#include "EMMPMLib/Common/CounterRNG.h"
 
 
 // -----------------------------------------------------------------------------
@@ -101,11 +96,12 @@ BasicInitialization::~BasicInitialization()
 void BasicInitialization::initialize(EMMPM_Data::Pointer data)
 {
   //FIXME: This needs to be adapted for vector images (dims > 1)
-  unsigned int i, k, l;
+  unsigned int k, l;
+  size_t i;
   real_t mu, sigma;
   char msgbuff[256];
-  unsigned int rows = data->rows;
-  unsigned int cols = data->columns;
+  size_t rows = static_cast<size_t>(data->rows) * data->slices;
+  size_t cols = data->columns;
   unsigned int classes = data->classes;
   unsigned char* y = data->y;
   size_t total;
@@ -249,24 +245,20 @@ void XtArrayInitialization::initialize(EMMPM_Data::Pointer data)
 {
   size_t total;
 
-  total = data->rows * data->columns;
+  total = static_cast<size_t>(data->rows) * data->columns * data->slices;
 
-  const float rangeMin = 0.0f;
-  const float rangeMax = 1.0f;
-  typedef boost::uniform_real<> NumberDistribution;
-  typedef boost::mt19937 RandomNumberGenerator;
-  typedef boost::variate_generator<RandomNumberGenerator&,
-          NumberDistribution> Generator;
-
-  NumberDistribution distribution(rangeMin, rangeMax);
-  RandomNumberGenerator generator;
-  Generator numberGenerator(generator, distribution);
-  generator.seed(EMMPM_getMilliSeconds()); // seed with the current time
+  // Draw from the same seeded counter based generator the MPM loops use so a
+  // seeded run is reproducible from the very first labels.
+  if (data->rngSeed == 0)
+  {
+    data->rngSeed = EMMPM_getMilliSeconds(); // seed with the current time
+  }
+  CounterRNG rng(data->rngSeed, 0xFFFFFFFFFFFFFFFFULL);
 
   /* Initialize classification of each pixel randomly with a uniform disribution */
   for (size_t i = 0; i < total; i++)
   {
-    data->xt[i] = numberGenerator() * data->classes;
+    data->xt[i] = static_cast<unsigned char>(rng.uniform(i) * data->classes);
   }
 
 }
@@ -49,81 +49,111 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 #include <stdio.h>
 
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/uniform_real.hpp>
-#include <boost/random/variate_generator.hpp>
+#include <vector>
 
 
 #include "EMMPMLib/Core/EMMPM.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
 #include "EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPMLib/Common/EMTime.h"
+#include "EMMPMLib/Common/CounterRNG.h"
 #include "EMMPMLib/Core/EMMPMUtilities.h"
 
-#define USE_TBB_TASK_GROUP 0
 #if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
 #include <tbb/task_scheduler_init.h>
 #include <tbb/parallel_for.h>
-#include <tbb/blocked_range2d.h>
+#include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_group.h>
+#endif
+
+/* The per class terms are evaluated over a fixed width so that the class loops
+ * have a compile time trip count and are vectorized by the compiler. The
+ * coupling table and the accumulators are zero padded out to this width. */
+#define EMMPM_CLASS_STRIDE 16
 
+#if (EMMPM_MAX_CLASSES + 1) > EMMPM_CLASS_STRIDE
+#error EMMPM_CLASS_STRIDE must be at least EMMPM_MAX_CLASSES + 1
 #endif
 
-#define COMPUTE_C_CLIQUE( C, x, y, ci, cj)\
-  if((x) < 0 || (x) >= colEnd || (y) < 0 || (y) >= rowEnd) {\
-    C[ci][cj] = classes;\
+#define COMPUTE_C_CLIQUE( C, x, y, ci)\
+  if((x) < 0 || (x) >= cols || (y) < 0 || (y) >= rows) {\
+    C[ci] = classes;\
   }\
   else\
   {\
-    ij = (cols * (y)) + (x);\
-    C[ci][cj] = xt[ij];\
+    C[ci] = xt[(cols * (y)) + (x)];\
   }
 
 
+/**
+ * @brief Evaluates the posterior of every class for one pixel from its total
+ * energy and draws the new class with the uniform deviate u.
+ * @param yk The per class log likelihoods. Classes are the slowest moving dimension
+ * @param classStride The number of pixels in one class plane of yk
+ */
+static inline int DrawClass(const real_t* yk, const real_t* energy, const real_t* gamma,
+                            real_t kappa, int classes, size_t classStride, size_t ij, float u)
+{
+  real_t post[EMMPM_CLASS_STRIDE];
+  real_t sum = 0.0f;
+  for (int l = 0; l < classes; ++l)
+  {
+    post[l] = expf(kappa * (yk[classStride * l + ij] - energy[l] - gamma[l]));
+    sum += post[l];
+  }
 
+  real_t xrnd = u * sum;
+  real_t current = 0.0f;
+  for (int l = 0; l < classes - 1; l++)
+  {
+    current += post[l];
+    if (xrnd < current)
+    {
+      return l;
+    }
+  }
+  return classes - 1;
+}
 
 /**
- * @class ParallelCalcLoop ParallelCalcLoop.h EMMPM/Curvature/ParallelCalcLoop.h
- * @brief This class can calculate the parts of the MPM loop in parallel
+ * @class ParallelMPMLoop ParallelMPMLoop.h EMMPM/Curvature/ParallelMPMLoop.h
+ * @brief Performs one color of a graph colored Gibbs sweep of the MPM loop.
+ *
+ * The 8 neighbor clique means a pixel interacts with every pixel whose x AND y
+ * coordinates are within one of its own, so the image is split into four
+ * colors by (x % 2, y % 2). Pixels of the same color never read each other so
+ * each color can be updated in place from any number of threads, and since
+ * the random number for a pixel is drawn from a counter based stream keyed on
+ * its index the result does not depend on how the rows were scheduled.
  *
  * @date March 11, 2012
- * @version 1.0
+ * @version 2.0
  */
 class ParallelMPMLoop
 {
   public:
-#if USE_TBB_TASK_GROUP
-    ParallelCalcLoop(EMMPM_Data* dPtr, real_t* ykPtr, real_t* rnd, int rowStart, int rowEnd,
-                     int colStart, int colEnd) :
-      m_RowStart(rowStart),
-      m_RowEnd(rowEnd),
-      m_ColStart(colStart),
-      m_ColEnd(colEnd),
-#else
-    ParallelMPMLoop(EMMPM_Data * dPtr, real_t* ykPtr, real_t* rnd) :
-#endif
-
+    ParallelMPMLoop(EMMPM_Data* dPtr, real_t* ykPtr, const real_t* couplingT,
+                    const CounterRNG& rng, int colorX, int colorY) :
       data(dPtr),
       yk(ykPtr),
-      rnd(rnd)
+      m_CouplingT(couplingT),
+      m_Rng(rng),
+      m_ColorX(colorX),
+      m_ColorY(colorY)
     {}
     virtual ~ParallelMPMLoop() {}
 
-
-    void calc(int rowStart, int rowEnd,
-              int colStart, int colEnd) const
+    /**
+     * @brief Updates every pixel of this loop's color in the rows 2*rowStart+colorY
+     * up to (but not including) 2*rowEnd+colorY
+     */
+    void calc(int rowStart, int rowEnd) const
     {
-      //uint64_t millis = EMMPM_getMilliSeconds();
-      //  int l;
-      real_t prior;
-      int32_t ij, lij;
+      size_t ij, lij;
       int rows = data->rows;
       int cols = data->columns;
       int classes = data->classes;
-
-      real_t xrnd, current;
-      real_t post[EMMPM_MAX_CLASSES], sum, edge;
+      size_t classStride = static_cast<size_t>(cols) * static_cast<size_t>(rows);
 
       size_t nsCols = data->columns - 1;
       size_t ewCols = data->columns;
@@ -137,169 +167,225 @@ class ParallelMPMLoop
       real_t* ew = data->ew;
       real_t* sw = data->sw;
       real_t* nw = data->nw;
-      real_t curvature_value = (real_t)0.0;
-
-
-      int C[3][3]; // This is the Clique for the current Pixel
+      const real_t* gamma = data->w_gamma;
+      const real_t kappa = data->workingKappa;
+      const real_t beta_c = data->beta_c;
+      const bool useGradient = (data->useGradientPenalty != 0);
+      const bool useCurvature = (data->useCurvaturePenalty != 0);
+
+      int C[8]; // The Clique for the current Pixel
+      real_t W[8]; // The gradient weight on the edge to each clique member
 //      --------- X -----
-//      |   | 0 | 1 | 2 |
+//      |   |   |   |   |
 //      -----------------
-//   Y  | 0 |   |   |   |
+//   Y  |   | 0 | 1 | 2 |
 //      -----------------
-//      | 1 |   | P |   |
+//      |   | 3 | P | 4 |
 //      -----------------
-//      | 2 |   |   |   |
+//      |   | 5 | 6 | 7 |
 //
-// When we calculate the "C" matrix if the pixel value for the specific index of
+// When we calculate the "C" array if the pixel value for the specific index of
 // the clique would be off the image then a value = number of classes is
-// used for the C[i][j]. That way we can figure out if we are off the image
+// used for the C[i]. That way we can figure out if we are off the image
 
-      std::stringstream ss;
-      unsigned int cSize = classes + 1;
-      real_t* coupling = data->couplingBeta;
+      real_t energy[EMMPM_CLASS_STRIDE];
+      real_t edgeByClass[EMMPM_CLASS_STRIDE];
 
-      for (int32_t y = rowStart; y < rowEnd; y++)
+      for (int32_t r = rowStart; r < rowEnd; r++)
       {
-        for (int32_t x = colStart; x < colEnd; x++)
+        int32_t y = 2 * r + m_ColorY;
+        for (int32_t x = m_ColorX; x < cols; x += 2)
         {
-
-          /* -------------  */
-          COMPUTE_C_CLIQUE(C, x - 1, y - 1, 0, 0);
-          COMPUTE_C_CLIQUE(C,   x, y - 1, 1, 0);
-          COMPUTE_C_CLIQUE(C, x + 1, y - 1, 2, 0);
-          COMPUTE_C_CLIQUE(C, x - 1,   y, 0, 1);
-          COMPUTE_C_CLIQUE(C, x + 1,   y, 2, 1);
-          COMPUTE_C_CLIQUE(C, x - 1, y + 1, 0, 2);
-          COMPUTE_C_CLIQUE(C,   x, y + 1, 1, 2);
-          COMPUTE_C_CLIQUE(C, x + 1, y + 1, 2, 2);
-
-#if 0
-          if (y == rowStart + 1 && x == colStart + 1)
+          COMPUTE_C_CLIQUE(C, x - 1, y - 1, 0);
+          COMPUTE_C_CLIQUE(C,   x, y - 1, 1);
+          COMPUTE_C_CLIQUE(C, x + 1, y - 1, 2);
+          COMPUTE_C_CLIQUE(C, x - 1,   y, 3);
+          COMPUTE_C_CLIQUE(C, x + 1,   y, 4);
+          COMPUTE_C_CLIQUE(C, x - 1, y + 1, 5);
+          COMPUTE_C_CLIQUE(C,   x, y + 1, 6);
+          COMPUTE_C_CLIQUE(C, x + 1, y + 1, 7);
+
+          ij = (static_cast<size_t>(cols) * y) + x;
+
+          // The prior for every class is the sum of the coupling rows of the
+          // 8 neighbors. Row C[n] of the transposed table holds the coupling
+          // of every class to the class C[n] contiguously.
+          for (int l = 0; l < EMMPM_CLASS_STRIDE; ++l)
           {
-            ss << "------------------------------" << std::endl;
-            ss << "|" << C[0][0] << "\t" << C[1][0] << "\t" << C[2][0] << std::endl;
-            ss << "|" << C[0][1] << "\t" << C[1][1] << "\t" << C[2][1] << std::endl;
-            ss << "|" << C[0][2] << "\t" << C[1][2] << "\t" << C[2][2] << std::endl;
-            ss << "------------------------------" << std::endl;
-            std::cout << ss.str() << std::endl;
+            energy[l] = 0.0f;
+            edgeByClass[l] = 0.0f;
           }
-#endif
-
-          ij = (cols * y) + x;
-          sum = 0;
-          for (int l = 0; l < classes; ++l)
+          for (int n = 0; n < 8; ++n)
           {
-            prior = 0;
-            edge = 0;
-
-            prior += coupling[(cSize * l) + C[0][0]];
-            prior += coupling[(cSize * l) + C[1][0]];
-            prior += coupling[(cSize * l) + C[2][0]];
-            prior += coupling[(cSize * l) + C[0][1]];
-            prior += coupling[(cSize * l) + C[2][1]];
-            prior += coupling[(cSize * l) + C[0][2]];
-            prior += coupling[(cSize * l) + C[1][2]];
-            prior += coupling[(cSize * l) + C[2][2]];
-
-#if 0
-            if (y == rowStart + 1 && x == colStart + 1)
+            const real_t* row = m_CouplingT + EMMPM_CLASS_STRIDE * C[n];
+            for (int l = 0; l < EMMPM_CLASS_STRIDE; ++l)
             {
-              std::cout << "Class: " << l << "\t prior: " << prior << std::endl;
+              energy[l] += row[l];
             }
-#endif
+          }
 
-            // now check for the gradient penalty. If our current class is NOT equal
-            // to the class at index[i][j] AND the value of C[i][j] does NOT equal
-            // to the Number of Classes then add in the gradient penalty.
-            if (data->useGradientPenalty)
+          // The gradient penalty adds the weight of every edge to a neighbor
+          // whose class is different from the candidate class. That is the
+          // total weight minus the weight of the edges to neighbors that
+          // already have the candidate class.
+          if (useGradient)
+          {
+            W[0] = (C[0] != classes) ? sw[(swCols * (y - 1)) + x - 1] : 0.0f;
+            W[1] = (C[1] != classes) ? ew[(ewCols * (y - 1)) + x] : 0.0f;
+            W[2] = (C[2] != classes) ? nw[(nwCols * (y - 1)) + x] : 0.0f;
+            W[3] = (C[3] != classes) ? ns[(nsCols * y) + x - 1] : 0.0f;
+            W[4] = (C[4] != classes) ? ns[(nsCols * y) + x] : 0.0f;
+            W[5] = (C[5] != classes) ? nw[(nwCols * y) + x - 1] : 0.0f;
+            W[6] = (C[6] != classes) ? ew[(ewCols * y) + x] : 0.0f;
+            W[7] = (C[7] != classes) ? sw[(swCols * y) + x] : 0.0f;
+            real_t edgeTotal = 0.0f;
+            for (int n = 0; n < 8; ++n)
             {
-              if (C[0][0] != l && C[0][0] != classes) { edge += sw[(swCols * (y - 1)) + x - 1]; }
-              if (C[1][0] != l && C[1][0] != classes) { edge += ew[(ewCols * (y - 1)) + x]; }
-              if (C[2][0] != l && C[2][0] != classes) { edge += nw[(nwCols * (y - 1)) + x]; }
-              if (C[0][1] != l && C[0][1] != classes) { edge += ns[(nsCols * y) + x - 1]; }
-              if (C[2][1] != l && C[2][1] != classes) { edge += ns[(nsCols * y) + x]; }
-              if (C[0][2] != l && C[0][2] != classes) { edge += nw[(nwCols * y) + x - 1]; }
-              if (C[1][2] != l && C[1][2] != classes) { edge += ew[(ewCols * y) + x]; }
-              if (C[2][2] != l && C[2][2] != classes) { edge += sw[(swCols * y) + x]; }
+              edgeTotal += W[n];
+              edgeByClass[C[n]] += W[n];
             }
-
-
-            lij = (cols * rows * l) + (cols * y) + x;
-            curvature_value = 0.0;
-            if (data->useCurvaturePenalty)
+            for (int l = 0; l < EMMPM_CLASS_STRIDE; ++l)
             {
-              curvature_value = data->beta_c * ccost[lij];
+              energy[l] += edgeTotal - edgeByClass[l];
             }
-            real_t arg = data->workingKappa * (yk[lij] - (prior) - (edge) - (curvature_value) - data->w_gamma[l]);
-            post[l] = expf(arg);
-            sum += post[l];
           }
 
-          xrnd = rnd[ij];
-          current = 0.0;
-
-          for (int l = 0; l < classes; l++)
+          if (useCurvature)
           {
-            lij = (cols * rows * l) + ij;
-            real_t arg = post[l] / sum;
-            if ((xrnd >= current) && (xrnd <= (current + arg)))
+            for (int l = 0; l < classes; ++l)
             {
-              xt[ij] = l;
-              probs[lij] += 1.0;
+              energy[l] += beta_c * ccost[classStride * l + ij];
             }
-            current += arg;
           }
-#if 0
-          Dont even THINK about using this code...
-          This classifys the pixel based on the largest
-          in magnitude  probability
-          real_t max = 0.0;
-          int maxClass = 0;
-          for (int l = 0; l < classes; l++)
+
+          int newClass = DrawClass(yk, energy, gamma, kappa, classes, classStride, ij, m_Rng.uniform(ij));
+          xt[ij] = newClass;
+          lij = (classStride * newClass) + ij;
+          probs[lij] += 1.0;
+        }
+      }
+    }
+
+
+#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
+    void operator()(const tbb::blocked_range<int>& r) const
+    {
+      calc(r.begin(), r.end());
+    }
+#endif
+
+
+  private:
+    const EMMPM_Data* data;
+    const real_t* yk;
+    const real_t* m_CouplingT;
+    CounterRNG m_Rng;
+    int m_ColorX;
+    int m_ColorY;
+
+};
+
+/**
+ * @class ParallelMPMLoop3D
+ * @brief Performs one color of the graph colored Gibbs sweep for a volume.
+ *
+ * The 6, 18 and 26 neighbor cliques all only reach voxels whose coordinates
+ * are within one of the current voxel, so the same parity coloring as the 2D
+ * loop is used with 8 colors given by (x % 2, y % 2, z % 2). The work is
+ * split across the rows (y,z) of the current color.
+ */
+class ParallelMPMLoop3D
+{
+  public:
+    ParallelMPMLoop3D(EMMPM_Data* dPtr, real_t* ykPtr, const real_t* couplingT,
+                      const CounterRNG& rng, const int* offsets, int numNeighbors,
+                      int colorX, int colorY, int colorZ) :
+      data(dPtr),
+      yk(ykPtr),
+      m_CouplingT(couplingT),
+      m_Rng(rng),
+      m_Offsets(offsets),
+      m_NumNeighbors(numNeighbors),
+      m_ColorX(colorX),
+      m_ColorY(colorY),
+      m_ColorZ(colorZ)
+    {}
+    virtual ~ParallelMPMLoop3D() {}
+
+    /**
+     * @brief Updates every voxel of this loop's color in the rows [lineStart, lineEnd)
+     * where the rows of the color are numbered slice by slice.
+     */
+    void calc(int lineStart, int lineEnd) const
+    {
+      int rows = data->rows;
+      int cols = data->columns;
+      int slices = data->slices;
+      int classes = data->classes;
+      size_t sliceSize = static_cast<size_t>(cols) * static_cast<size_t>(rows);
+      size_t classStride = sliceSize * static_cast<size_t>(slices);
+      int colorRows = (rows - m_ColorY + 1) / 2;
+
+      unsigned char* xt = data->xt;
+      real_t* probs = data->probs;
+      const real_t* gamma = data->w_gamma;
+      const real_t kappa = data->workingKappa;
+
+      real_t energy[EMMPM_CLASS_STRIDE];
+
+      for (int32_t t = lineStart; t < lineEnd; t++)
+      {
+        int32_t z = 2 * (t / colorRows) + m_ColorZ;
+        int32_t y = 2 * (t % colorRows) + m_ColorY;
+        for (int32_t x = m_ColorX; x < cols; x += 2)
+        {
+          size_t ij = (sliceSize * z) + (static_cast<size_t>(cols) * y) + x;
+
+          for (int l = 0; l < EMMPM_CLASS_STRIDE; ++l)
+          {
+            energy[l] = 0.0f;
+          }
+          for (int n = 0; n < m_NumNeighbors; ++n)
           {
-            lij = (cols * rows * l) + ij;
-            //real_t arg = post[l] / sum;
-            if (probs[lij] > max)
+            int32_t nx = x + m_Offsets[3 * n];
+            int32_t ny = y + m_Offsets[3 * n + 1];
+            int32_t nz = z + m_Offsets[3 * n + 2];
+            int c = classes;
+            if (nx >= 0 && nx < cols && ny >= 0 && ny < rows && nz >= 0 && nz < slices)
             {
-              max = probs[lij];
-              maxClass = l;
+              c = xt[(sliceSize * nz) + (static_cast<size_t>(cols) * ny) + nx];
+            }
+            const real_t* row = m_CouplingT + EMMPM_CLASS_STRIDE * c;
+            for (int l = 0; l < EMMPM_CLASS_STRIDE; ++l)
+            {
+              energy[l] += row[l];
             }
           }
-          //Assign class based on Maximum probability
-          xt[ij] = maxClass;
-#endif
+
+          int newClass = DrawClass(yk, energy, gamma, kappa, classes, classStride, ij, m_Rng.uniform(ij));
+          xt[ij] = newClass;
+          probs[classStride * newClass + ij] += 1.0;
         }
       }
-      //  std::cout << "     --" << EMMPM_getMilliSeconds() - millis << "--" << std::endl;
     }
 
-
 #if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-#if USE_TBB_TASK_GROUP
-    void operator()() const
+    void operator()(const tbb::blocked_range<int>& r) const
     {
-      calc(m_RowStart, m_RowEnd, m_ColStart, m_ColEnd);
+      calc(r.begin(), r.end());
     }
-#else
-    void operator()(const tbb::blocked_range2d<int>& r) const
-    {
-      calc(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
-    }
-#endif
 #endif
 
-
   private:
-#if USE_TBB_TASK_GROUP
-    int m_RowStart;
-    int m_RowEnd;
-    int m_ColStart;
-    int m_ColEnd;
-#endif
     const EMMPM_Data* data;
     const real_t* yk;
-    const real_t* rnd;
-
+    const real_t* m_CouplingT;
+    CounterRNG m_Rng;
+    const int* m_Offsets;
+    int m_NumNeighbors;
+    int m_ColorX;
+    int m_ColorY;
+    int m_ColorZ;
 };
 
 // -----------------------------------------------------------------------------
@@ -333,10 +419,14 @@ void MPMCalculation::execute()
   // int k, l;
 // unsigned int i, j, d;
   size_t ld, ijd, lij;
-  unsigned int dims = data->dims;
-  unsigned int rows = data->rows;
-  unsigned int cols = data->columns;
-  unsigned int classes = data->classes;
+  size_t dims = data->dims;
+  size_t rows = data->rows;
+  size_t cols = data->columns;
+  size_t classes = data->classes;
+  size_t slices = data->slices;
+  // Slices are stacked after each other so every per pixel loop that does not
+  // care about the neighborhood simply runs over all the rows of the volume
+  size_t totalRows = rows * slices;
 
 //  int rowEnd = rows/2;
   unsigned char* y = data->y;
@@ -358,7 +448,7 @@ void MPMCalculation::execute()
   memset(msgbuff, 0, 256);
   data->progress++;
 
-  yk = (real_t*)malloc(cols * rows * classes * sizeof(real_t));
+  yk = (real_t*)malloc(cols * totalRows * classes * sizeof(real_t));
 
   sqrt2pi = sqrt(2.0 * M_PI);
 
@@ -372,16 +462,16 @@ void MPMCalculation::execute()
     }
   }
 
-  for (uint32_t i = 0; i < rows; i++)
+  for (size_t i = 0; i < totalRows; i++)
   {
-    for (uint32_t j = 0; j < cols; j++)
+    for (size_t j = 0; j < cols; j++)
     {
-      for (uint32_t l = 0; l < classes; l++)
+      for (size_t l = 0; l < classes; l++)
       {
-        lij = (cols * rows * l) + (cols * i) + j;
+        lij = (cols * totalRows * l) + (cols * i) + j;
         probs[lij] = 0;
         yk[lij] = con[l];
-        for (uint32_t d = 0; d < dims; d++)
+        for (size_t d = 0; d < dims; d++)
         {
           ld = dims * l + d;
           ijd = (dims * cols * i) + (dims * j) + d;
@@ -391,25 +481,46 @@ void MPMCalculation::execute()
     }
   }
 
-  const float rangeMin = 0;
-  const float rangeMax = 1.0f;
-  typedef boost::uniform_real<real_t> NumberDistribution;
-  typedef boost::mt19937 RandomNumberGenerator;
-  typedef boost::variate_generator<RandomNumberGenerator&,
-          NumberDistribution> Generator;
-
-  NumberDistribution distribution(rangeMin, rangeMax);
-  RandomNumberGenerator generator;
-  Generator numberGenerator(generator, distribution);
-  generator.seed(EMMPM_getMilliSeconds()); // seed with the current time
-
-  // Generate all the numbers up front
-  size_t total = rows * cols;
-  std::vector<real_t> rndNumbers(total);
-  real_t* rndNumbersPtr = &(rndNumbers.front());
-  for(size_t i = 0; i < total; ++i)
+  // Transpose and pad the coupling matrix so that the coupling of every class
+  // to a given neighbor class is contiguous. Row "classes" is the off image
+  // neighbor.
+  size_t cSize = classes + 1;
+  std::vector<real_t> couplingT(EMMPM_CLASS_STRIDE * cSize, 0.0f);
+  for (size_t c = 0; c < cSize; c++)
+  {
+    for (uint32_t l = 0; l < classes; l++)
+    {
+      couplingT[EMMPM_CLASS_STRIDE * c + l] = data->couplingBeta[(cSize * l) + c];
+    }
+  }
+
+  // The neighbor offsets (dx, dy, dz) of the clique used for volumes. The 6
+  // neighborhood shares a face, the 18 neighborhood a face or an edge and the
+  // 26 neighborhood any face, edge or corner.
+  std::vector<int> offsets;
+  for (int dz = -1; dz <= 1; dz++)
+  {
+    for (int dy = -1; dy <= 1; dy++)
+    {
+      for (int dx = -1; dx <= 1; dx++)
+      {
+        int manhattan = abs(dx) + abs(dy) + abs(dz);
+        if (manhattan == 0) { continue; }
+        if (data->neighborhood == 6 && manhattan > 1) { continue; }
+        if (data->neighborhood == 18 && manhattan > 2) { continue; }
+        offsets.push_back(dx);
+        offsets.push_back(dy);
+        offsets.push_back(dz);
+      }
+    }
+  }
+  int numNeighbors = static_cast<int>(offsets.size() / 3);
+
+  // Every MPM loop gets its own random stream so that the random number used
+  // for a pixel only depends on the seed, the loop and the pixel index.
+  if (data->rngSeed == 0)
   {
-    rndNumbersPtr[i] = numberGenerator(); // Work directly with the pointer for speed.
+    data->rngSeed = EMMPM_getMilliSeconds(); // seed with the current time
   }
 
   //unsigned long long int millis = EMMPM_getMilliSeconds();
@@ -422,37 +533,44 @@ void MPMCalculation::execute()
     if (data->cancel) { data->progress = 100.0; break; }
     data->inside_mpm_loop = 1;
 
-#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-    tbb::task_scheduler_init init;
-    int threads = init.default_num_threads();
-#if USE_TBB_TASK_GROUP
-    tbb::task_group* g = new tbb::task_group;
-    unsigned int rowIncrement = rows / threads;
-    unsigned int rowStop = 0 + rowIncrement;
-    unsigned int rowStart = 0;
-    for (int t = 0; t < threads; ++t)
+    uint64_t stream = static_cast<uint64_t>(data->currentEMLoop) * data->mpmIterations + k;
+    CounterRNG rng(data->rngSeed, stream);
+
+    if (slices > 1)
     {
-      g->run(ParallelCalcLoop(data, yk, &(rndNumbers.front()), rowStart, rowStop, 0, cols) );
-      rowStart = rowStop;
-      rowStop = rowStop + rowIncrement;
-      if (rowStop >= rows)
+      for (int color = 0; color < 8; color++)
       {
-        rowStop = rows;
-      }
-    }
-    g->wait();
-    delete g;
+        int colorX = color & 1;
+        int colorY = (color >> 1) & 1;
+        int colorZ = color >> 2;
+        int colorLines = ((static_cast<int>(rows) - colorY + 1) / 2) * ((static_cast<int>(slices) - colorZ + 1) / 2);
+#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
+        tbb::parallel_for(tbb::blocked_range<int>(0, colorLines),
+                          ParallelMPMLoop3D(data, yk, &(couplingT.front()), rng, &(offsets.front()), numNeighbors, colorX, colorY, colorZ),
+                          tbb::auto_partitioner());
 #else
-    tbb::parallel_for(tbb::blocked_range2d<int>(0, rows, rows / threads, 0, cols, cols),
-                      ParallelMPMLoop(data, yk, &(rndNumbers.front())),
-                      tbb::simple_partitioner());
+        ParallelMPMLoop3D pcl(data, yk, &(couplingT.front()), rng, &(offsets.front()), numNeighbors, colorX, colorY, colorZ);
+        pcl.calc(0, colorLines);
 #endif
-
+      }
+    }
+    else
+    {
+      for (int color = 0; color < 4; color++)
+      {
+        int colorX = color & 1;
+        int colorY = color >> 1;
+        int colorRows = (static_cast<int>(rows) - colorY + 1) / 2;
+#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
+        tbb::parallel_for(tbb::blocked_range<int>(0, colorRows),
+                          ParallelMPMLoop(data, yk, &(couplingT.front()), rng, colorX, colorY),
+                          tbb::auto_partitioner());
 #else
-    ParallelMPMLoop pcl(data, yk, &(rndNumbers.front()));
-    pcl.calc(0, rows, 0, cols);
+        ParallelMPMLoop pcl(data, yk, &(couplingT.front()), rng, colorX, colorY);
+        pcl.calc(0, colorRows);
 #endif
-
+      }
+    }
 
     //std::cout << "Counter: " << counter << std::endl;
     EMMPMUtilities::ConvertXtToOutputImage(getData());
@@ -485,13 +603,13 @@ void MPMCalculation::execute()
   if (!data->cancel)
   {
     /* Normalize probabilities */
-    for (uint32_t i = 0; i < data->rows; i++)
+    for (size_t i = 0; i < totalRows; i++)
     {
-      for (uint32_t j = 0; j < data->columns; j++)
+      for (size_t j = 0; j < cols; j++)
       {
-        for (uint32_t l = 0; l < classes; l++)
+        for (size_t l = 0; l < classes; l++)
         {
-          lij = (cols * rows * l) + (cols * i) + j;
+          lij = (cols * totalRows * l) + (cols * i) + j;
           data->probs[lij] = data->probs[lij] / (real_t)data->mpmIterations;
         }
       }
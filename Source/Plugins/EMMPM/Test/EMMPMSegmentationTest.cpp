@@ -33,6 +33,9 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 
@@ -48,9 +51,33 @@
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 #include "SIMPLib/Utilities/UnitTestSupport.hpp"
 #include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "EMMPMTestFileLocations.h"
 
+/**
+ * @brief The EMMPMBatchMessageCollector class keeps the text of the status messages
+ * a filter sends while it segments batches of slices
+ */
+class EMMPMBatchMessageCollector
+{
+  public:
+    EMMPMBatchMessageCollector(QStringList* batches) :
+      m_Batches(batches)
+    {}
+
+    void operator()(const PipelineMessage& msg) const
+    {
+      if (msg.getType() == PipelineMessage::StatusMessage && msg.getText().startsWith("Segmenting Slices"))
+      {
+        m_Batches->push_back(msg.getText());
+      }
+    }
+
+  private:
+    QStringList* m_Batches;
+};
 
 class EMMPMSegmentationTest
 {
@@ -317,6 +344,140 @@ class EMMPMSegmentationTest
     }
 
 
+    // -----------------------------------------------------------------------------
+    // Three gray levels in diagonal bands that move from slice to slice, plus noise
+    // that only depends on the voxel position, so any plane can be rebuilt on its own
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateSliceTestData(size_t columns, size_t rows, size_t firstSlice, size_t numSlices)
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New("ImageDataContainer");
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(columns, rows, numSlices);
+      m->setGeometry(image);
+
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = columns;
+      tDims[1] = rows;
+      tDims[2] = numSlices;
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, "CellData", SIMPL::AttributeMatrixType::Cell);
+      UInt8ArrayType::Pointer gray = UInt8ArrayType::CreateArray(tDims, QVector<size_t>(1, 1), "Gray", true);
+      const int32_t levels[3] = { 40, 120, 200 };
+      for (size_t z = 0; z < numSlices; z++)
+      {
+        for (size_t y = 0; y < rows; y++)
+        {
+          for (size_t x = 0; x < columns; x++)
+          {
+            size_t slice = firstSlice + z;
+            uint32_t hash = static_cast<uint32_t>(((slice * rows + y) * columns + x) * 2654435761u + 12345u);
+            hash ^= hash >> 15;
+            int32_t noise = static_cast<int32_t>(hash % 41) - 20;
+            int32_t level = levels[(x / 6 + y / 5 + slice) % 3];
+            gray->setValue((z * rows + y) * columns + x, static_cast<uint8_t>(level + noise));
+          }
+        }
+      }
+      am->addAttributeArray(gray->getName(), gray);
+      m->addAttributeMatrix(am->getName(), am);
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    // segmentationMode is 0 for Single Image and 2 for Independent Slices
+    // -----------------------------------------------------------------------------
+    UInt8ArrayType::Pointer RunSeededEMMPM(DataContainerArray::Pointer dca, int segmentationMode, int maxConcurrentSlices, QStringList* batches)
+    {
+      QString filtName = "EMMPMFilter";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      bool propWasSet;
+      var.setValue(DataArrayPath("ImageDataContainer", "CellData", "Gray"));
+      propWasSet = filter->setProperty("InputDataArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath("ImageDataContainer", "CellData", "Segmented"));
+      propWasSet = filter->setProperty("OutputDataArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(3);
+      propWasSet = filter->setProperty("NumClasses", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(segmentationMode);
+      propWasSet = filter->setProperty("SegmentationMode", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(maxConcurrentSlices);
+      propWasSet = filter->setProperty("MaxConcurrentSlices", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(20160531);
+      propWasSet = filter->setProperty("RandomSeed", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      if (NULL != batches)
+      {
+        QObject::connect(filter.get(), &Observable::filterGeneratedMessage, EMMPMBatchMessageCollector(batches));
+      }
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      UInt8ArrayType::Pointer output = std::dynamic_pointer_cast<UInt8ArrayType>(dca->getAttributeMatrix(DataArrayPath("ImageDataContainer", "CellData", ""))->getAttributeArray("Segmented"));
+      DREAM3D_REQUIRE_VALID_POINTER(output.get());
+      return output;
+    }
+
+    // -----------------------------------------------------------------------------
+    // With a fixed seed, every plane segmented by the Independent Slices mode has to
+    // match the Single Image segmentation of that plane alone, and the result may not
+    // depend on how many slices are in flight. The batches are reported one status
+    // message each, so their ranges show that no more than MaxConcurrentSlices planes
+    // were started together.
+    // -----------------------------------------------------------------------------
+    int TestIndependentSlices()
+    {
+      const size_t columns = 30;
+      const size_t rows = 24;
+      const size_t slices = 5;
+      const size_t sliceSize = columns * rows;
+
+      std::vector<UInt8ArrayType::Pointer> alone(slices);
+      for (size_t z = 0; z < slices; z++)
+      {
+        alone[z] = RunSeededEMMPM(CreateSliceTestData(columns, rows, z, 1), 0, 1, NULL);
+      }
+
+      const int batchSizes[3] = { 1, 2, 7 };
+      for (int b = 0; b < 3; b++)
+      {
+        QStringList batches;
+        UInt8ArrayType::Pointer volume = RunSeededEMMPM(CreateSliceTestData(columns, rows, 0, slices), 2, batchSizes[b], &batches);
+        for (size_t z = 0; z < slices; z++)
+        {
+          for (size_t i = 0; i < sliceSize; i++)
+          {
+            DREAM3D_REQUIRE_EQUAL(volume->getValue(z * sliceSize + i), alone[z]->getValue(i))
+          }
+        }
+
+        QStringList expected;
+        for (size_t start = 0; start < slices; start += batchSizes[b])
+        {
+          size_t end = std::min(start + static_cast<size_t>(batchSizes[b]), slices);
+          expected << QObject::tr("Segmenting Slices %1-%2 of %3").arg(start + 1).arg(end).arg(slices);
+        }
+        DREAM3D_REQUIRE_EQUAL(batches.size(), expected.size())
+        for (int i = 0; i < expected.size(); i++)
+        {
+          DREAM3D_REQUIRE(batches[i] == expected[i])
+        }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
     // -----------------------------------------------------------------------------
     //
     // -----------------------------------------------------------------------------
@@ -327,6 +488,7 @@ class EMMPMSegmentationTest
 
       DREAM3D_REGISTER_TEST(TestEMMPMSegmentation())
           DREAM3D_REGISTER_TEST(TestMultiEMMPMSegmentation())
+          DREAM3D_REGISTER_TEST(TestIndependentSlices())
 
           DREAM3D_REGISTER_TEST(RemoveTestFiles())
     }
@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/FeatureStatisticsEngine.h"
+
 #include "Generic/GenericConstants.h"
 
 // Include the MOC generated file for this class
@@ -160,55 +162,20 @@ void FindFeatureCentroids::preflight()
 void FindFeatureCentroids::find_centroids()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
 
   size_t totalFeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  QVector<size_t> dims(1, 5);
-  FloatArrayType::Pointer m_FeatureCentersPtr = FloatArrayType::CreateArray(totalFeatures, dims, "_INTERNAL_USE_ONLY_Centroids");
-  m_FeatureCentersPtr->initializeWithZeros();
-  float* featurecenters = m_FeatureCentersPtr->getPointer(0);
-
-  float x = 0.0f;
-  float y = 0.0f;
-  float z = 0.0f;
-
-  size_t xPoints = m->getGeometryAs<ImageGeom>()->getXPoints();
-  size_t yPoints = m->getGeometryAs<ImageGeom>()->getYPoints();
-  size_t zPoints = m->getGeometryAs<ImageGeom>()->getZPoints();
+  size_t dims[3] = { image->getXPoints(), image->getYPoints(), image->getZPoints() };
+  float res[3] = { image->getXRes(), image->getYRes(), image->getZRes() };
 
-  float xRes = m->getGeometryAs<ImageGeom>()->getXRes();
-  float yRes = m->getGeometryAs<ImageGeom>()->getYRes();
-  float zRes = m->getGeometryAs<ImageGeom>()->getZRes();
+  FeatureStatisticsEngine engine(m_FeatureIds, dims, res, totalFeatures);
+  engine.addAccumulators(FeatureStatisticsEngine::Centroid);
+  engine.execute();
 
-  size_t zStride = 0;
-  size_t yStride = 0;
-  for (size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for (size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for (size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        featurecenters[gnum * 5 + 0]++;
-        x = float(k) * xRes;
-        y = float(j) * yRes;
-        z = float(i) * zRes;
-        featurecenters[gnum * 5 + 1] = featurecenters[gnum * 5 + 1] + x;
-        featurecenters[gnum * 5 + 2] = featurecenters[gnum * 5 + 2] + y;
-        featurecenters[gnum * 5 + 3] = featurecenters[gnum * 5 + 3] + z;
-      }
-    }
-  }
   for (size_t i = 1; i < totalFeatures; i++)
   {
-    featurecenters[i * 5 + 1] = featurecenters[i * 5 + 1] / featurecenters[i * 5 + 0];
-    featurecenters[i * 5 + 2] = featurecenters[i * 5 + 2] / featurecenters[i * 5 + 0];
-    featurecenters[i * 5 + 3] = featurecenters[i * 5 + 3] / featurecenters[i * 5 + 0];
-    m_Centroids[3 * i] = featurecenters[i * 5 + 1];
-    m_Centroids[3 * i + 1] = featurecenters[i * 5 + 2];
-    m_Centroids[3 * i + 2] = featurecenters[i * 5 + 3];
+    engine.getCentroid(i, m_Centroids + 3 * i);
   }
 }
 
@@ -0,0 +1,456 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FindFeatureStatistics.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/SIMPLibVersion.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "OrientationLib/Utilities/FeatureStatisticsEngine.h"
+
+#include "Generic/GenericConstants.h"
+
+// Include the MOC generated file for this class
+#include "moc_FindFeatureStatistics.cpp"
+
+
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindFeatureStatistics::FindFeatureStatistics() :
+  AbstractFilter(),
+  m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds),
+  m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases),
+  m_CellFeatureAttributeMatrixName(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""),
+  m_FindSizes(true),
+  m_FindCentroids(true),
+  m_FindSurfaceFeatures(true),
+  m_FindPhases(false),
+  m_FindBoundingBoxes(false),
+  m_NumCellsArrayName(SIMPL::FeatureData::NumCells),
+  m_VolumesArrayName(SIMPL::FeatureData::Volumes),
+  m_EquivalentDiametersArrayName(SIMPL::FeatureData::EquivalentDiameters),
+  m_CentroidsArrayName(SIMPL::FeatureData::Centroids),
+  m_SurfaceFeaturesArrayName(SIMPL::FeatureData::SurfaceFeatures),
+  m_FeaturePhasesArrayName(SIMPL::FeatureData::Phases),
+  m_BoundingBoxesArrayName("BoundingBoxes"),
+  m_FeatureIds(NULL),
+  m_CellPhases(NULL),
+  m_NumCells(NULL),
+  m_Volumes(NULL),
+  m_EquivalentDiameters(NULL),
+  m_Centroids(NULL),
+  m_SurfaceFeatures(NULL),
+  m_FeaturePhases(NULL),
+  m_BoundingBoxes(NULL)
+{
+  setupFilterParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindFeatureStatistics::~FindFeatureStatistics()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+  QStringList linkedProps;
+  linkedProps << "NumCellsArrayName" << "VolumesArrayName" << "EquivalentDiametersArrayName";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Find Sizes", "FindSizes", getFindSizes(), linkedProps, FilterParameter::Parameter));
+  linkedProps.clear();
+  linkedProps << "CentroidsArrayName";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Find Centroids", "FindCentroids", getFindCentroids(), linkedProps, FilterParameter::Parameter));
+  linkedProps.clear();
+  linkedProps << "SurfaceFeaturesArrayName";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Find Surface Features", "FindSurfaceFeatures", getFindSurfaceFeatures(), linkedProps, FilterParameter::Parameter));
+  linkedProps.clear();
+  linkedProps << "CellPhasesArrayPath" << "FeaturePhasesArrayName";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Find Phases", "FindPhases", getFindPhases(), linkedProps, FilterParameter::Parameter));
+  linkedProps.clear();
+  linkedProps << "BoundingBoxesArrayName";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Find Bounding Boxes", "FindBoundingBoxes", getFindBoundingBoxes(), linkedProps, FilterParameter::Parameter));
+  parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(DataArraySelectionFilterParameter::New("Feature Ids", "FeatureIdsArrayPath", getFeatureIdsArrayPath(), FilterParameter::RequiredArray, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(DataArraySelectionFilterParameter::New("Phases", "CellPhasesArrayPath", getCellPhasesArrayPath(), FilterParameter::RequiredArray, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Cell Feature Data", FilterParameter::RequiredArray));
+  {
+    AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(SIMPL::AttributeMatrixType::CellFeature, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(AttributeMatrixSelectionFilterParameter::New("Cell Feature Attribute Matrix", "CellFeatureAttributeMatrixName", getCellFeatureAttributeMatrixName(), FilterParameter::RequiredArray, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Cell Feature Data", FilterParameter::CreatedArray));
+  parameters.push_back(StringFilterParameter::New("Number of Cells", "NumCellsArrayName", getNumCellsArrayName(), FilterParameter::CreatedArray));
+  parameters.push_back(StringFilterParameter::New("Volumes", "VolumesArrayName", getVolumesArrayName(), FilterParameter::CreatedArray));
+  parameters.push_back(StringFilterParameter::New("Equivalent Diameters", "EquivalentDiametersArrayName", getEquivalentDiametersArrayName(), FilterParameter::CreatedArray));
+  parameters.push_back(StringFilterParameter::New("Centroids", "CentroidsArrayName", getCentroidsArrayName(), FilterParameter::CreatedArray));
+  parameters.push_back(StringFilterParameter::New("Surface Features", "SurfaceFeaturesArrayName", getSurfaceFeaturesArrayName(), FilterParameter::CreatedArray));
+  parameters.push_back(StringFilterParameter::New("Phases", "FeaturePhasesArrayName", getFeaturePhasesArrayName(), FilterParameter::CreatedArray));
+  parameters.push_back(StringFilterParameter::New("Bounding Boxes", "BoundingBoxesArrayName", getBoundingBoxesArrayName(), FilterParameter::CreatedArray));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath() ) );
+  setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath() ) );
+  setCellFeatureAttributeMatrixName(reader->readDataArrayPath("CellFeatureAttributeMatrixName", getCellFeatureAttributeMatrixName() ) );
+  setFindSizes(reader->readValue("FindSizes", getFindSizes() ) );
+  setFindCentroids(reader->readValue("FindCentroids", getFindCentroids() ) );
+  setFindSurfaceFeatures(reader->readValue("FindSurfaceFeatures", getFindSurfaceFeatures() ) );
+  setFindPhases(reader->readValue("FindPhases", getFindPhases() ) );
+  setFindBoundingBoxes(reader->readValue("FindBoundingBoxes", getFindBoundingBoxes() ) );
+  setNumCellsArrayName(reader->readString("NumCellsArrayName", getNumCellsArrayName() ) );
+  setVolumesArrayName(reader->readString("VolumesArrayName", getVolumesArrayName() ) );
+  setEquivalentDiametersArrayName(reader->readString("EquivalentDiametersArrayName", getEquivalentDiametersArrayName() ) );
+  setCentroidsArrayName(reader->readString("CentroidsArrayName", getCentroidsArrayName() ) );
+  setSurfaceFeaturesArrayName(reader->readString("SurfaceFeaturesArrayName", getSurfaceFeaturesArrayName() ) );
+  setFeaturePhasesArrayName(reader->readString("FeaturePhasesArrayName", getFeaturePhasesArrayName() ) );
+  setBoundingBoxesArrayName(reader->readString("BoundingBoxesArrayName", getBoundingBoxesArrayName() ) );
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FindFeatureStatistics::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
+{
+  writer->openFilterGroup(this, index);
+  SIMPL_FILTER_WRITE_PARAMETER(FilterVersion)
+  SIMPL_FILTER_WRITE_PARAMETER(FeatureIdsArrayPath)
+  SIMPL_FILTER_WRITE_PARAMETER(CellPhasesArrayPath)
+  SIMPL_FILTER_WRITE_PARAMETER(CellFeatureAttributeMatrixName)
+  SIMPL_FILTER_WRITE_PARAMETER(FindSizes)
+  SIMPL_FILTER_WRITE_PARAMETER(FindCentroids)
+  SIMPL_FILTER_WRITE_PARAMETER(FindSurfaceFeatures)
+  SIMPL_FILTER_WRITE_PARAMETER(FindPhases)
+  SIMPL_FILTER_WRITE_PARAMETER(FindBoundingBoxes)
+  SIMPL_FILTER_WRITE_PARAMETER(NumCellsArrayName)
+  SIMPL_FILTER_WRITE_PARAMETER(VolumesArrayName)
+  SIMPL_FILTER_WRITE_PARAMETER(EquivalentDiametersArrayName)
+  SIMPL_FILTER_WRITE_PARAMETER(CentroidsArrayName)
+  SIMPL_FILTER_WRITE_PARAMETER(SurfaceFeaturesArrayName)
+  SIMPL_FILTER_WRITE_PARAMETER(FeaturePhasesArrayName)
+  SIMPL_FILTER_WRITE_PARAMETER(BoundingBoxesArrayName)
+  writer->closeFilterGroup();
+  return ++index; // we want to return the next index that was just written to
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::initialize()
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::dataCheck()
+{
+  setErrorCondition(0);
+  DataArrayPath tempPath;
+
+  if (getFindSizes() == false && getFindCentroids() == false && getFindSurfaceFeatures() == false && getFindPhases() == false
+      && getFindBoundingBoxes() == false)
+  {
+    QString ss = QObject::tr("At least one statistic must be selected");
+    setErrorCondition(-5650);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getFeatureIdsArrayPath().getDataContainerName());
+
+  QVector<DataArrayPath> dataArrayPaths;
+
+  QVector<size_t> cDims(1, 1);
+  m_FeatureIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getFeatureIdsArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if( NULL != m_FeatureIdsPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+  { m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+  if(getErrorCondition() >= 0) { dataArrayPaths.push_back(getFeatureIdsArrayPath()); }
+
+  getDataContainerArray()->getPrereqAttributeMatrixFromPath<AbstractFilter>(this, getCellFeatureAttributeMatrixName(), -301);
+  if(getErrorCondition() < 0) { return; }
+
+  QString dcName = getCellFeatureAttributeMatrixName().getDataContainerName();
+  QString amName = getCellFeatureAttributeMatrixName().getAttributeMatrixName();
+
+  if (getFindSizes() == true)
+  {
+    tempPath.update(dcName, amName, getNumCellsArrayName() );
+    m_NumCellsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_NumCellsPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_NumCells = m_NumCellsPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+    tempPath.update(dcName, amName, getVolumesArrayName() );
+    m_VolumesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_VolumesPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_Volumes = m_VolumesPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+    tempPath.update(dcName, amName, getEquivalentDiametersArrayName() );
+    m_EquivalentDiametersPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_EquivalentDiametersPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_EquivalentDiameters = m_EquivalentDiametersPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
+  if (getFindCentroids() == true)
+  {
+    cDims[0] = 3;
+    tempPath.update(dcName, amName, getCentroidsArrayName() );
+    m_CentroidsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_CentroidsPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_Centroids = m_CentroidsPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+    cDims[0] = 1;
+  }
+
+  if (getFindSurfaceFeatures() == true)
+  {
+    tempPath.update(dcName, amName, getSurfaceFeaturesArrayName() );
+    m_SurfaceFeaturesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>, AbstractFilter, bool>(this, tempPath, false, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_SurfaceFeaturesPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_SurfaceFeatures = m_SurfaceFeaturesPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
+  if (getFindPhases() == true)
+  {
+    m_CellPhasesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getCellPhasesArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_CellPhasesPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_CellPhases = m_CellPhasesPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCondition() >= 0) { dataArrayPaths.push_back(getCellPhasesArrayPath()); }
+
+    tempPath.update(dcName, amName, getFeaturePhasesArrayName() );
+    m_FeaturePhasesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_FeaturePhasesPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_FeaturePhases = m_FeaturePhasesPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
+  if (getFindBoundingBoxes() == true)
+  {
+    cDims[0] = 6;
+    tempPath.update(dcName, amName, getBoundingBoxesArrayName() );
+    m_BoundingBoxesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, -1, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_BoundingBoxesPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_BoundingBoxes = m_BoundingBoxesPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+    cDims[0] = 1;
+  }
+
+  getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, dataArrayPaths);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::execute()
+{
+  setErrorCondition(0);
+  dataCheck();
+  if(getErrorCondition() < 0) { return; }
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+  AttributeMatrix::Pointer cellFeatureAttrMat = getDataContainerArray()->getAttributeMatrix(getCellFeatureAttributeMatrixName());
+  size_t totalFeatures = cellFeatureAttrMat->getNumTuples();
+
+  size_t dims[3] = { image->getXPoints(), image->getYPoints(), image->getZPoints() };
+  float res[3] = { image->getXRes(), image->getYRes(), image->getZRes() };
+  bool is3D = (dims[0] > 1 && dims[1] > 1 && dims[2] > 1);
+
+  // All selected statistics are gathered in a single sweep over the Feature Ids
+  FeatureStatisticsEngine engine(m_FeatureIds, dims, res, totalFeatures);
+  if (m_FindSizes == true) { engine.addAccumulators(FeatureStatisticsEngine::Count); }
+  if (m_FindCentroids == true) { engine.addAccumulators(FeatureStatisticsEngine::Centroid); }
+  if (m_FindSurfaceFeatures == true) { engine.addAccumulators(FeatureStatisticsEngine::Surface); }
+  if (m_FindBoundingBoxes == true) { engine.addAccumulators(FeatureStatisticsEngine::BoundingBox); }
+  if (m_FindPhases == true)
+  {
+    engine.addAccumulators(FeatureStatisticsEngine::Phase);
+    engine.setCellPhases(m_CellPhases);
+  }
+  engine.execute();
+
+  if (m_FindSizes == true)
+  {
+    float res_scalar = engine.getCellVolume();
+    float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_Pi;
+    for (size_t i = 1; i < totalFeatures; i++)
+    {
+      m_NumCells[i] = engine.getCount(i);
+      m_Volumes[i] = static_cast<float>(m_NumCells[i]) * res_scalar;
+      if (is3D == true) { m_EquivalentDiameters[i] = 2.0f * powf(m_Volumes[i] / vol_term, 0.3333333333f); }
+      else { m_EquivalentDiameters[i] = 2.0f * sqrtf(m_Volumes[i] / SIMPLib::Constants::k_Pi); }
+    }
+  }
+
+  if (m_FindCentroids == true)
+  {
+    for (size_t i = 1; i < totalFeatures; i++)
+    {
+      engine.getCentroid(i, m_Centroids + 3 * i);
+    }
+  }
+
+  if (m_FindSurfaceFeatures == true)
+  {
+    for (size_t i = 0; i < totalFeatures; i++)
+    {
+      m_SurfaceFeatures[i] = engine.isSurfaceFeature(i);
+    }
+  }
+
+  if (m_FindPhases == true)
+  {
+    for (size_t i = 0; i < totalFeatures; i++)
+    {
+      m_FeaturePhases[i] = engine.getPhase(i);
+    }
+  }
+
+  if (m_FindBoundingBoxes == true)
+  {
+    // Features without Cells keep -1 for every bound
+    int64_t minIndex[3] = { 0, 0, 0 };
+    int64_t maxIndex[3] = { 0, 0, 0 };
+    for (size_t i = 0; i < totalFeatures; i++)
+    {
+      if (engine.getBoundingBox(i, minIndex, maxIndex) == false) { continue; }
+      for (int32_t d = 0; d < 3; d++)
+      {
+        m_BoundingBoxes[6 * i + d] = static_cast<int32_t>(minIndex[d]);
+        m_BoundingBoxes[6 * i + 3 + d] = static_cast<int32_t>(maxIndex[d]);
+      }
+    }
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer FindFeatureStatistics::newFilterInstance(bool copyFilterParameters)
+{
+  FindFeatureStatistics::Pointer filter = FindFeatureStatistics::New();
+  if(true == copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getCompiledLibraryName()
+{
+  return GenericConstants::GenericBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getBrandingString()
+{
+  return "Generic";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getFilterVersion()
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream <<  SIMPLib::Version::Major() << "." << SIMPLib::Version::Minor() << "." << SIMPLib::Version::Patch();
+  return version;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getGroupName()
+{ return SIMPL::FilterGroups::GenericFilters; }
+
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getSubGroupName()
+{ return SIMPL::FilterSubGroups::MiscFilters; }
+
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getHumanLabel()
+{ return "Find Feature Statistics"; }
+
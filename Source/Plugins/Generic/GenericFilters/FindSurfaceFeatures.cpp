@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/FeatureStatisticsEngine.h"
+
 #include "Generic/GenericConstants.h"
 
 // Include the MOC generated file for this class
@@ -161,91 +163,21 @@ void FindSurfaceFeatures::preflight()
 void FindSurfaceFeatures::find_surfacefeatures()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
 
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-
-  int64_t zStride = 0, yStride = 0;
-  for (int64_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for (int64_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for (int64_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        if( m_SurfaceFeatures[gnum] == false)
-        {
-          if (k <= 0) { m_SurfaceFeatures[gnum] = true; }
-          if (k >= xPoints - 1) { m_SurfaceFeatures[gnum] = true; }
-          if (j <= 0) { m_SurfaceFeatures[gnum] = true; }
-          if (j >= yPoints - 1) { m_SurfaceFeatures[gnum] = true; }
-          if (i <= 0) { m_SurfaceFeatures[gnum] = true; }
-          if (i >= zPoints - 1) { m_SurfaceFeatures[gnum] = true; }
-          if (m_SurfaceFeatures[gnum] == false)
-          {
-            if (m_FeatureIds[zStride + yStride + k - 1] == 0) { m_SurfaceFeatures[gnum] = true; }
-            if (m_FeatureIds[zStride + yStride + k + 1] == 0) { m_SurfaceFeatures[gnum] = true; }
-            if (m_FeatureIds[zStride + yStride + k - xPoints] == 0) { m_SurfaceFeatures[gnum] = true; }
-            if (m_FeatureIds[zStride + yStride + k + xPoints] == 0) { m_SurfaceFeatures[gnum] = true; }
-            if (m_FeatureIds[zStride + yStride + k - (xPoints * yPoints)] == 0) { m_SurfaceFeatures[gnum] = true; }
-            if (m_FeatureIds[zStride + yStride + k + (xPoints * yPoints)] == 0) { m_SurfaceFeatures[gnum] = true; }
-          }
-        }
-      }
-    }
-  }
-}
+  size_t totalFeatures = m_SurfaceFeaturesPtr.lock()->getNumberOfTuples();
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindSurfaceFeatures::find_surfacefeatures2D()
-{
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
+  size_t dims[3] = { image->getXPoints(), image->getYPoints(), image->getZPoints() };
+  float res[3] = { image->getXRes(), image->getYRes(), image->getZRes() };
 
-  int64_t xPoints = 0, yPoints = 0;
+  // Axes with a single cell are skipped by the engine, so the same sweep covers 2D and 3D data
+  FeatureStatisticsEngine engine(m_FeatureIds, dims, res, totalFeatures);
+  engine.addAccumulators(FeatureStatisticsEngine::Surface);
+  engine.execute();
 
-  if (m->getGeometryAs<ImageGeom>()->getXPoints() == 1)
+  for (size_t i = 0; i < totalFeatures; i++)
   {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  }
-  if (m->getGeometryAs<ImageGeom>()->getYPoints() == 1)
-  {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  }
-  if (m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-  {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  }
-
-  int64_t yStride;
-  for (int64_t j = 0; j < yPoints; j++)
-  {
-    yStride = j * xPoints;
-    for (int64_t k = 0; k < xPoints; k++)
-    {
-      int32_t gnum = m_FeatureIds[yStride + k];
-      if (m_SurfaceFeatures[gnum] == false)
-      {
-        if (k <= 0) { m_SurfaceFeatures[gnum] = true; }
-        if (k >= xPoints - 1) { m_SurfaceFeatures[gnum] = true; }
-        if (j <= 0) { m_SurfaceFeatures[gnum] = true; }
-        if (j >= yPoints - 1) { m_SurfaceFeatures[gnum] = true; }
-        if (m_SurfaceFeatures[gnum] == false)
-        {
-          if (m_FeatureIds[yStride + k - 1] == 0) { m_SurfaceFeatures[gnum] = true; }
-          if (m_FeatureIds[yStride + k + 1] == 0) { m_SurfaceFeatures[gnum] = true; }
-          if (m_FeatureIds[yStride + k - static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints())] == 0) { m_SurfaceFeatures[gnum] = true; }
-          if (m_FeatureIds[yStride + k + static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints())] == 0) { m_SurfaceFeatures[gnum] = true; }
-        }
-      }
-    }
+    m_SurfaceFeatures[i] = engine.isSurfaceFeature(i);
   }
 }
 
@@ -258,10 +190,7 @@ void FindSurfaceFeatures::execute()
   dataCheck();
   if(getErrorCondition() < 0) { return; }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-
-  if(m->getGeometryAs<ImageGeom>()->getXPoints() > 1 && m->getGeometryAs<ImageGeom>()->getYPoints() > 1 && m->getGeometryAs<ImageGeom>()->getZPoints() > 1) { find_surfacefeatures(); }
-  if(m->getGeometryAs<ImageGeom>()->getXPoints() == 1 || m->getGeometryAs<ImageGeom>()->getYPoints() == 1 || m->getGeometryAs<ImageGeom>()->getZPoints() == 1) { find_surfacefeatures2D(); }
+  find_surfacefeatures();
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
@@ -23,6 +23,7 @@ FindBoundingBoxFeatures
 FindFeatureCentroids
 FindFeaturePhases
 FindFeaturePhasesBinary
+FindFeatureStatistics
 FindSurfaceFeatures
 GenerateVectorColors
 )
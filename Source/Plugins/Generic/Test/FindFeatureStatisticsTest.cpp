@@ -0,0 +1,305 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "GenericTestFileLocations.h"
+
+// Feature 0 is the background and the last Feature owns no cells
+static const int32_t k_FeatureStatsNumFeatures = 10;
+
+class FindFeatureStatisticsTest
+{
+  public:
+    FindFeatureStatisticsTest(){}
+    virtual ~FindFeatureStatisticsTest(){}
+    SIMPL_TYPE_MACRO(FindFeatureStatisticsTest)
+
+    // -----------------------------------------------------------------------------
+    // Blocks of Features 1 to 8 with scattered background cells, so the Features are
+    // neither boxes nor aligned with the grid
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestVolume(const size_t dims[3])
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(dims[0], dims[1], dims[2]);
+      image->setResolution(0.5f, 1.0f, 2.0f);
+      image->setOrigin(0.0f, 0.0f, 0.0f);
+      m->setGeometry(image);
+
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = dims[0];
+      tDims[1] = dims[1];
+      tDims[2] = dims[2];
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::FeatureIds, true);
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
+      uint32_t seed = 2718;
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            size_t index = (z * dims[1] + y) * dims[0] + x;
+            seed = seed * 1103515245u + 12345u;
+            int32_t feature = 1 + static_cast<int32_t>((x / 3 + 3 * (y / 4) + 6 * (z / 3)) % 8);
+            if ((seed >> 16) % 7 == 0) { feature = 0; }
+            else if ((seed >> 16) % 11 == 0) { feature = 1 + static_cast<int32_t>((seed >> 8) % 8); }
+            featureIds->setValue(index, feature);
+            phases->setValue(index, 1 + feature % 2);
+          }
+        }
+      }
+      am->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+      am->addAttributeArray(SIMPL::CellData::Phases, phases);
+      m->addAttributeMatrix(am->getName(), am);
+
+      AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(QVector<size_t>(1, k_FeatureStatsNumFeatures), SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+      m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    AbstractFilter::Pointer CreateFilter(const QString& name, DataContainerArray::Pointer dca)
+    {
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(name);
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+      bool propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      return filter;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    template<typename T>
+    typename DataArray<T>::Pointer GetFeatureArray(DataContainerArray::Pointer dca, const QString& name)
+    {
+      AttributeMatrix::Pointer am = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      DREAM3D_REQUIRE_VALID_POINTER(am.get());
+      typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T> >(am->getAttributeArray(name));
+      DREAM3D_REQUIRE_VALID_POINTER(array.get());
+      DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), static_cast<size_t>(k_FeatureStatsNumFeatures))
+      return array;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    static bool CloseEnough(float a, float b)
+    {
+      return std::fabs(a - b) <= 1.0e-4f * std::max(1.0f, std::fabs(b));
+    }
+
+    // -----------------------------------------------------------------------------
+    // Runs Find Feature Sizes and Find Feature Centroids on one copy of the volume and
+    // Find Feature Statistics on another, then checks both against each other and the
+    // counts, centroids and bounding boxes against a plain loop over the cells
+    // -----------------------------------------------------------------------------
+    int CompareWithSingleStatisticFilters(const size_t dims[3])
+    {
+      DataContainerArray::Pointer referenceDca = CreateTestVolume(dims);
+      DataContainerArray::Pointer dca = CreateTestVolume(dims);
+      QVariant var;
+      bool propWasSet = false;
+
+      AbstractFilter::Pointer findSizes = CreateFilter("FindSizes", referenceDca);
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+      propWasSet = findSizes->setProperty("CellFeatureAttributeMatrixName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      findSizes->execute();
+      DREAM3D_REQUIRED(findSizes->getErrorCondition(), >=, 0)
+
+      AbstractFilter::Pointer findCentroids = CreateFilter("FindFeatureCentroids", referenceDca);
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids));
+      propWasSet = findCentroids->setProperty("CentroidsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      findCentroids->execute();
+      DREAM3D_REQUIRED(findCentroids->getErrorCondition(), >=, 0)
+
+      AbstractFilter::Pointer findStatistics = CreateFilter("FindFeatureStatistics", dca);
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+      propWasSet = findStatistics->setProperty("CellFeatureAttributeMatrixName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(true);
+      propWasSet = findStatistics->setProperty("FindSizes", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = findStatistics->setProperty("FindCentroids", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = findStatistics->setProperty("FindBoundingBoxes", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(false);
+      propWasSet = findStatistics->setProperty("FindSurfaceFeatures", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = findStatistics->setProperty("FindPhases", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(SIMPL::FeatureData::NumCells);
+      propWasSet = findStatistics->setProperty("NumCellsArrayName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(SIMPL::FeatureData::Volumes);
+      propWasSet = findStatistics->setProperty("VolumesArrayName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(SIMPL::FeatureData::EquivalentDiameters);
+      propWasSet = findStatistics->setProperty("EquivalentDiametersArrayName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(SIMPL::FeatureData::Centroids);
+      propWasSet = findStatistics->setProperty("CentroidsArrayName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      findStatistics->execute();
+      DREAM3D_REQUIRED(findStatistics->getErrorCondition(), >=, 0)
+
+      Int32ArrayType::Pointer refNumCells = GetFeatureArray<int32_t>(referenceDca, SIMPL::FeatureData::NumCells);
+      FloatArrayType::Pointer refVolumes = GetFeatureArray<float>(referenceDca, SIMPL::FeatureData::Volumes);
+      FloatArrayType::Pointer refDiameters = GetFeatureArray<float>(referenceDca, SIMPL::FeatureData::EquivalentDiameters);
+      FloatArrayType::Pointer refCentroids = GetFeatureArray<float>(referenceDca, SIMPL::FeatureData::Centroids);
+      Int32ArrayType::Pointer numCells = GetFeatureArray<int32_t>(dca, SIMPL::FeatureData::NumCells);
+      FloatArrayType::Pointer volumes = GetFeatureArray<float>(dca, SIMPL::FeatureData::Volumes);
+      FloatArrayType::Pointer diameters = GetFeatureArray<float>(dca, SIMPL::FeatureData::EquivalentDiameters);
+      FloatArrayType::Pointer centroids = GetFeatureArray<float>(dca, SIMPL::FeatureData::Centroids);
+      Int32ArrayType::Pointer boundingBoxes = GetFeatureArray<int32_t>(dca, "BoundingBoxes");
+      DREAM3D_REQUIRE_EQUAL(boundingBoxes->getNumberOfComponents(), 6)
+
+      // Brute force reference for the counts, centroids and bounding boxes
+      const float res[3] = { 0.5f, 1.0f, 2.0f };
+      std::vector<int32_t> counts(k_FeatureStatsNumFeatures, 0);
+      std::vector<double> sums(3 * k_FeatureStatsNumFeatures, 0.0);
+      std::vector<int32_t> boxes(6 * k_FeatureStatsNumFeatures, -1);
+      Int32ArrayType::Pointer featureIds = std::dynamic_pointer_cast<Int32ArrayType>(
+            dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArray(SIMPL::CellData::FeatureIds));
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            int32_t feature = featureIds->getValue((z * dims[1] + y) * dims[0] + x);
+            const int32_t cell[3] = { static_cast<int32_t>(x), static_cast<int32_t>(y), static_cast<int32_t>(z) };
+            counts[feature]++;
+            for (int d = 0; d < 3; d++)
+            {
+              sums[3 * feature + d] += cell[d] * res[d];
+              if (boxes[6 * feature + d] < 0 || cell[d] < boxes[6 * feature + d]) { boxes[6 * feature + d] = cell[d]; }
+              if (cell[d] > boxes[6 * feature + 3 + d]) { boxes[6 * feature + 3 + d] = cell[d]; }
+            }
+          }
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(counts[k_FeatureStatsNumFeatures - 1], 0)
+
+      for (int32_t i = 1; i < k_FeatureStatsNumFeatures; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(numCells->getValue(i), refNumCells->getValue(i))
+        DREAM3D_REQUIRE_EQUAL(numCells->getValue(i), counts[i])
+        DREAM3D_REQUIRE_EQUAL(CloseEnough(volumes->getValue(i), refVolumes->getValue(i)), true)
+        DREAM3D_REQUIRE_EQUAL(CloseEnough(diameters->getValue(i), refDiameters->getValue(i)), true)
+        for (int d = 0; d < 6; d++)
+        {
+          DREAM3D_REQUIRE_EQUAL(boundingBoxes->getComponent(i, d), boxes[6 * i + d])
+        }
+        if (counts[i] == 0) { continue; }
+        for (int d = 0; d < 3; d++)
+        {
+          DREAM3D_REQUIRE_EQUAL(CloseEnough(centroids->getComponent(i, d), refCentroids->getComponent(i, d)), true)
+          DREAM3D_REQUIRE_EQUAL(CloseEnough(centroids->getComponent(i, d), static_cast<float>(sums[3 * i + d] / counts[i])), true)
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFindFeatureStatisticsVolume()
+    {
+      size_t dims[3] = { 9, 8, 6 };
+      return CompareWithSingleStatisticFilters(dims);
+    }
+
+    // -----------------------------------------------------------------------------
+    // A single slice takes the circle equivalent diameter branch of Find Feature Sizes
+    // -----------------------------------------------------------------------------
+    int TestFindFeatureStatisticsSlice()
+    {
+      size_t dims[3] = { 9, 8, 1 };
+      return CompareWithSingleStatisticFilters(dims);
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestFindFeatureStatisticsVolume())
+      DREAM3D_REGISTER_TEST(TestFindFeatureStatisticsSlice())
+    }
+
+  private:
+    FindFeatureStatisticsTest(const FindFeatureStatisticsTest&); // Copy Constructor Not Implemented
+    void operator=(const FindFeatureStatisticsTest&); // Operator '=' Not Implemented
+};
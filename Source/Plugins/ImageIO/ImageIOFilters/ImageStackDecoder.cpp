@@ -0,0 +1,424 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ImageStackDecoder.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QRect>
+#include <QtGui/QImage>
+#include <QtGui/QImageReader>
+
+#include "SIMPLib/Common/AbstractFilter.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#include <tbb/task_group.h>
+#endif
+
+/**
+ * @brief The DecodeSliceImpl class decodes a single output slice as a tbb task
+ */
+class DecodeSliceImpl
+{
+  public:
+    DecodeSliceImpl(const ImageStackDecoder* decoder, size_t outZ, uint8_t* dst, size_t tupleStride, size_t channelOffset, int* err, QString* message) :
+      m_Decoder(decoder),
+      m_OutZ(outZ),
+      m_Dst(dst),
+      m_TupleStride(tupleStride),
+      m_ChannelOffset(channelOffset),
+      m_Err(err),
+      m_Message(message)
+    {}
+    virtual ~DecodeSliceImpl() {}
+
+    void operator()() const
+    {
+      *m_Err = m_Decoder->decodeSlice(m_OutZ, m_Dst, m_TupleStride, m_ChannelOffset, *m_Message);
+    }
+
+  private:
+    const ImageStackDecoder* m_Decoder;
+    size_t m_OutZ;
+    uint8_t* m_Dst;
+    size_t m_TupleStride;
+    size_t m_ChannelOffset;
+    int* m_Err;
+    QString* m_Message;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ImageStackDecoder::ImageStackDecoder(const QVector<QString>& fileList, size_t width, size_t height, size_t pixelBytes) :
+  m_FileList(fileList),
+  m_Width(width),
+  m_Height(height),
+  m_PixelBytes(pixelBytes),
+  m_DownsampleFactor(1),
+  m_NumDecoderThreads(0),
+  m_SwapRGB(false)
+{
+  m_Min[0] = 0;
+  m_Min[1] = 0;
+  m_Min[2] = 0;
+  m_Max[0] = (width > 0) ? width - 1 : 0;
+  m_Max[1] = (height > 0) ? height - 1 : 0;
+  m_Max[2] = (fileList.size() > 0) ? static_cast<size_t>(fileList.size() - 1) : 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ImageStackDecoder::~ImageStackDecoder()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ImageStackDecoder::GetImportRegion(AbstractFilter* filter, const int64_t dims[3], bool cropImages, const IntVec3_t& cropMinimum, const IntVec3_t& cropMaximum,
+                                       int downsampleFactor, int numDecoderThreads, size_t cropMin[3], size_t cropMax[3])
+{
+  QString ss;
+  if (downsampleFactor < 1)
+  {
+    ss = QObject::tr("The downsample factor must be at least 1");
+    filter->setErrorCondition(-4410);
+    filter->notifyErrorMessage(filter->getHumanLabel(), ss, filter->getErrorCondition());
+  }
+  if (numDecoderThreads < 0)
+  {
+    ss = QObject::tr("The number of decoder threads must be 0 (automatic) or larger");
+    filter->setErrorCondition(-4411);
+    filter->notifyErrorMessage(filter->getHumanLabel(), ss, filter->getErrorCondition());
+  }
+
+  int64_t minVoxel[3] = { 0, 0, 0 };
+  int64_t maxVoxel[3] = { dims[0] - 1, dims[1] - 1, dims[2] - 1 };
+  if (cropImages == true)
+  {
+    minVoxel[0] = cropMinimum.x;
+    minVoxel[1] = cropMinimum.y;
+    minVoxel[2] = cropMinimum.z;
+    maxVoxel[0] = cropMaximum.x;
+    maxVoxel[1] = cropMaximum.y;
+    maxVoxel[2] = cropMaximum.z;
+  }
+
+  const char* axis[3] = { "X", "Y", "Z" };
+  for (int32_t i = 0; i < 3; i++)
+  {
+    if (minVoxel[i] < 0 || minVoxel[i] > maxVoxel[i])
+    {
+      ss = QObject::tr("The %1 crop minimum (%2) must be at least 0 and no larger than the %1 crop maximum (%3)").arg(axis[i]).arg(minVoxel[i]).arg(maxVoxel[i]);
+      filter->setErrorCondition(-4412);
+      filter->notifyErrorMessage(filter->getHumanLabel(), ss, filter->getErrorCondition());
+      return filter->getErrorCondition();
+    }
+    if (maxVoxel[i] >= dims[i])
+    {
+      ss = QObject::tr("The %1 crop maximum (%2) is outside of the image stack, which has %3 voxels along %1").arg(axis[i]).arg(maxVoxel[i]).arg(dims[i]);
+      filter->setErrorCondition(-4413);
+      filter->notifyErrorMessage(filter->getHumanLabel(), ss, filter->getErrorCondition());
+      return filter->getErrorCondition();
+    }
+    cropMin[i] = static_cast<size_t>(minVoxel[i]);
+    cropMax[i] = static_cast<size_t>(maxVoxel[i]);
+  }
+  return (filter->getErrorCondition() < 0) ? filter->getErrorCondition() : 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImageStackDecoder::setCropRegion(const size_t min[3], const size_t max[3])
+{
+  for (int i = 0; i < 3; i++)
+  {
+    m_Min[i] = min[i];
+    m_Max[i] = max[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImageStackDecoder::setDownsampleFactor(size_t factor)
+{
+  m_DownsampleFactor = (factor < 1) ? 1 : factor;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImageStackDecoder::setNumDecoderThreads(int numThreads)
+{
+  m_NumDecoderThreads = numThreads;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ImageStackDecoder::getNumDecoderThreads() const
+{
+  if (m_NumDecoderThreads > 0) { return m_NumDecoderThreads; }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  return tbb::task_scheduler_init::default_num_threads();
+#else
+  return 1;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImageStackDecoder::setSwapRGB(bool swap)
+{
+  m_SwapRGB = swap;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ImageStackDecoder::getSwapRGB() const
+{
+  return m_SwapRGB;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImageStackDecoder::getOutputDimensions(size_t dims[3]) const
+{
+  for (int i = 0; i < 3; i++)
+  {
+    size_t extent = m_Max[i] - m_Min[i] + 1;
+    dims[i] = (extent + m_DownsampleFactor - 1) / m_DownsampleFactor;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ImageStackDecoder::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ImageStackDecoder::decodeSlice(size_t outZ, uint8_t* dst, size_t tupleStride, size_t channelOffset, QString& message) const
+{
+  size_t factor = m_DownsampleFactor;
+  size_t outDims[3] = { 0, 0, 0 };
+  getOutputDimensions(outDims);
+  size_t cropWidth = m_Max[0] - m_Min[0] + 1;
+  size_t cropHeight = m_Max[1] - m_Min[1] + 1;
+  QRect cropRect(static_cast<int>(m_Min[0]), static_cast<int>(m_Min[1]), static_cast<int>(cropWidth), static_cast<int>(cropHeight));
+
+  size_t zBegin = m_Min[2] + outZ * factor;
+  size_t zEnd = std::min(zBegin + factor, m_Max[2] + 1);
+  uint8_t* sliceDst = dst + outZ * outDims[0] * outDims[1] * tupleStride + channelOffset;
+
+  // Block sums for the downsampled case. A 32 bit sum cannot overflow for any sane factor.
+  std::vector<uint32_t> sums;
+  if (factor > 1) { sums.assign(outDims[0] * outDims[1] * m_PixelBytes, 0); }
+
+  for (size_t z = zBegin; z < zEnd; ++z)
+  {
+    const QString& imageFName = m_FileList[static_cast<int>(z)];
+    QImageReader reader(imageFName);
+    QSize imageSize = reader.size();
+    bool clipInReader = imageSize.isValid();
+    if (clipInReader)
+    {
+      if (static_cast<size_t>(imageSize.width()) != m_Width || static_cast<size_t>(imageSize.height()) != m_Height)
+      {
+        message = QObject::tr("Image %1 is %2 x %3 pixels but the stack is %4 x %5 pixels").arg(imageFName).arg(imageSize.width()).arg(imageSize.height()).arg(m_Width).arg(m_Height);
+        return -14001;
+      }
+      // Formats that support it decode only the region of interest
+      reader.setClipRect(cropRect);
+    }
+    QImage image = reader.read();
+    if (image.isNull() == true)
+    {
+      message = QObject::tr("Failed to load image file %1").arg(imageFName);
+      return -14000;
+    }
+    if (clipInReader == false)
+    {
+      if (static_cast<size_t>(image.width()) != m_Width || static_cast<size_t>(image.height()) != m_Height)
+      {
+        message = QObject::tr("Image %1 is %2 x %3 pixels but the stack is %4 x %5 pixels").arg(imageFName).arg(image.width()).arg(image.height()).arg(m_Width).arg(m_Height);
+        return -14001;
+      }
+      image = image.copy(cropRect);
+    }
+    if (static_cast<size_t>(image.depth() / 8) != m_PixelBytes)
+    {
+      message = QObject::tr("Image %1 has %2 bytes per pixel but the stack has %3").arg(imageFName).arg(image.depth() / 8).arg(m_PixelBytes);
+      return -14002;
+    }
+#if defined (CMP_WORDS_BIGENDIAN)
+#error
+#else
+    // We need to convert from Little Endian based ARGB to a physical RGB layout
+    if (m_SwapRGB == true && m_PixelBytes == 4) { image = image.rgbSwapped(); }
+#endif
+
+    for (size_t y = 0; y < cropHeight; ++y)
+    {
+      const uint8_t* source = image.constScanLine(static_cast<int>(y));
+      if (factor == 1)
+      {
+        uint8_t* rowDst = sliceDst + y * outDims[0] * tupleStride;
+        if (tupleStride == m_PixelBytes)
+        {
+          ::memcpy(rowDst, source, cropWidth * m_PixelBytes);
+        }
+        else
+        {
+          for (size_t x = 0; x < cropWidth; ++x)
+          {
+            ::memcpy(rowDst + x * tupleStride, source + x * m_PixelBytes, m_PixelBytes);
+          }
+        }
+      }
+      else
+      {
+        uint32_t* rowSums = &(sums[(y / factor) * outDims[0] * m_PixelBytes]);
+        for (size_t x = 0; x < cropWidth; ++x)
+        {
+          uint32_t* pixelSums = rowSums + (x / factor) * m_PixelBytes;
+          for (size_t k = 0; k < m_PixelBytes; ++k)
+          {
+            pixelSums[k] += source[x * m_PixelBytes + k];
+          }
+        }
+      }
+    }
+  }
+
+  if (factor > 1)
+  {
+    size_t depth = zEnd - zBegin;
+    for (size_t oy = 0; oy < outDims[1]; ++oy)
+    {
+      size_t ny = std::min(factor, cropHeight - oy * factor);
+      for (size_t ox = 0; ox < outDims[0]; ++ox)
+      {
+        size_t nx = std::min(factor, cropWidth - ox * factor);
+        uint32_t count = static_cast<uint32_t>(nx * ny * depth);
+        const uint32_t* pixelSums = &(sums[(oy * outDims[0] + ox) * m_PixelBytes]);
+        uint8_t* pixelDst = sliceDst + (oy * outDims[0] + ox) * tupleStride;
+        for (size_t k = 0; k < m_PixelBytes; ++k)
+        {
+          pixelDst[k] = static_cast<uint8_t>((pixelSums[k] + count / 2) / count);
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ImageStackDecoder::decode(uint8_t* dst, size_t tupleStride, size_t channelOffset, AbstractFilter* filter)
+{
+  m_ErrorMessage.clear();
+
+  size_t outDims[3] = { 0, 0, 0 };
+  getOutputDimensions(outDims);
+  size_t window = static_cast<size_t>(getNumDecoderThreads());
+  if (window < 1) { window = 1; }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  std::vector<int> errors(window, 0);
+  std::vector<QString> messages(window);
+
+  for (size_t zStart = 0; zStart < outDims[2]; zStart += window)
+  {
+    size_t zStop = std::min(zStart + window, outDims[2]);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true && zStop - zStart > 1)
+    {
+      tbb::task_group* g = new tbb::task_group;
+      for (size_t z = zStart; z < zStop; z++)
+      {
+        g->run(DecodeSliceImpl(this, z, dst, tupleStride, channelOffset, &(errors[z - zStart]), &(messages[z - zStart])));
+      }
+      g->wait();
+      delete g;
+    }
+    else
+#endif
+    {
+      for (size_t z = zStart; z < zStop; z++)
+      {
+        errors[z - zStart] = decodeSlice(z, dst, tupleStride, channelOffset, messages[z - zStart]);
+      }
+    }
+
+    // Commit the window in slice order so the first failing slice is the one reported
+    for (size_t z = zStart; z < zStop; z++)
+    {
+      if (errors[z - zStart] < 0)
+      {
+        m_ErrorMessage = messages[z - zStart];
+        return errors[z - zStart];
+      }
+    }
+
+    if (NULL != filter)
+    {
+      QString ss = QObject::tr("Imported Slice %1 of %2").arg(zStop).arg(outDims[2]);
+      filter->notifyStatusMessage(filter->getMessagePrefix(), filter->getHumanLabel(), ss);
+      if (filter->getCancel() == true) { return 0; }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,156 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _imagestackdecoder_h_
+#define _imagestackdecoder_h_
+
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+
+class AbstractFilter;
+
+/**
+ * @brief The ImageStackDecoder class decodes a stack of 2D image files straight into
+ * a preallocated cell array. The stack may be cropped to a region of interest and
+ * box-filtered by an integer factor while it is read, so only the reduced array is
+ * ever allocated. Slices are decoded by a pool of tasks in windows of
+ * getNumDecoderThreads() output slices; each window is finished in Z order before
+ * the next one starts, which bounds the memory held by decoded images and keeps
+ * progress and error reporting in slice order.
+ */
+class ImageStackDecoder
+{
+  public:
+    /**
+     * @brief ImageStackDecoder
+     * @param fileList One file per input slice, already in Z order
+     * @param width Width of every image in the stack
+     * @param height Height of every image in the stack
+     * @param pixelBytes Number of bytes per pixel (1 or 4)
+     */
+    ImageStackDecoder(const QVector<QString>& fileList, size_t width, size_t height, size_t pixelBytes);
+    virtual ~ImageStackDecoder();
+
+    /**
+     * @brief GetImportRegion Validates the crop, downsample and thread settings of an import
+     * filter against the dimensions of the image stack and returns the inclusive voxel range
+     * to import. Any error is set on and reported through the filter.
+     * @param filter The import filter
+     * @param dims Dimensions of the full image stack
+     * @param cropImages Whether the crop minimum and maximum are used
+     * @param cropMinimum First voxel of the region to import
+     * @param cropMaximum Last voxel of the region to import
+     * @param downsampleFactor The downsample factor of the filter
+     * @param numDecoderThreads The number of decoder threads of the filter
+     * @param cropMin Returns the first voxel to import
+     * @param cropMax Returns the last voxel to import
+     * @return 0 on success, otherwise the negative error code set on the filter
+     */
+    static int GetImportRegion(AbstractFilter* filter, const int64_t dims[3], bool cropImages, const IntVec3_t& cropMinimum, const IntVec3_t& cropMaximum,
+                               int downsampleFactor, int numDecoderThreads, size_t cropMin[3], size_t cropMax[3]);
+
+    /**
+     * @brief setCropRegion Sets the inclusive voxel range of the input stack to import.
+     * The Z values are indices into the file list. The default is the whole stack.
+     */
+    void setCropRegion(const size_t min[3], const size_t max[3]);
+
+    /**
+     * @brief setDownsampleFactor Each output voxel is the average of a block of
+     * factor x factor x factor input voxels. Partial blocks at the upper edges of the
+     * crop region are averaged over the voxels they contain.
+     */
+    void setDownsampleFactor(size_t factor);
+
+    /**
+     * @brief setNumDecoderThreads Sets how many slices are decoded concurrently. A
+     * value of 0 selects one decoder per available core.
+     */
+    void setNumDecoderThreads(int numThreads);
+    int getNumDecoderThreads() const;
+
+    /**
+     * @brief setSwapRGB Decodes 4 byte pixels as R, G, B, A bytes instead of the B, G, R, A
+     * byte order QImage uses on little endian machines. Off by default.
+     */
+    void setSwapRGB(bool swap);
+    bool getSwapRGB() const;
+
+    /**
+     * @brief getOutputDimensions Returns the dimensions of the imported volume after
+     * cropping and downsampling
+     */
+    void getOutputDimensions(size_t dims[3]) const;
+
+    /**
+     * @brief decode Decodes the stack. Voxel (x, y, z) of the output is written at
+     * dst + ((z * dimY + y) * dimX + x) * tupleStride + channelOffset, so several
+     * stacks may be interleaved into one multi-component array.
+     * @param dst Destination array
+     * @param tupleStride Number of bytes between consecutive tuples in dst
+     * @param channelOffset Byte offset of this stack inside each tuple
+     * @param filter Filter used for progress messages and cancel requests
+     * @return 0 on success, otherwise a negative error code. See getErrorMessage()
+     */
+    int decode(uint8_t* dst, size_t tupleStride, size_t channelOffset, AbstractFilter* filter);
+
+    /**
+     * @brief decodeSlice Decodes the input slices that make up output slice outZ.
+     * This is thread safe as long as no two calls share the same outZ.
+     */
+    int decodeSlice(size_t outZ, uint8_t* dst, size_t tupleStride, size_t channelOffset, QString& message) const;
+
+    QString getErrorMessage() const;
+
+  private:
+    QVector<QString> m_FileList;
+    size_t m_Width;
+    size_t m_Height;
+    size_t m_PixelBytes;
+    size_t m_Min[3];
+    size_t m_Max[3];
+    size_t m_DownsampleFactor;
+    int m_NumDecoderThreads;
+    bool m_SwapRGB;
+    QString m_ErrorMessage;
+
+    ImageStackDecoder(const ImageStackDecoder&); // Copy Constructor Not Implemented
+    void operator=(const ImageStackDecoder&); // Operator '=' Not Implemented
+};
+
+#endif /* _imagestackdecoder_h_ */
@@ -44,14 +44,18 @@
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/RectGridGeom.h"
 
 #include "ImageIO/ImageIOConstants.h"
+#include "ImageIO/ImageIOFilters/ImageStackDecoder.h"
 
 // Include the MOC generated file for this class
 #include "moc_ImportImageStack.cpp"
@@ -67,6 +71,9 @@ ImportImageStack::ImportImageStack() :
   m_CellAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName),
   m_BoundsFile(""),
   m_GeometryType(0),
+  m_CropImages(false),
+  m_DownsampleFactor(1),
+  m_NumDecoderThreads(0),
   m_ImageDataArrayName(SIMPL::CellData::ImageData)
 {
   m_Origin.x = 0.0f;
@@ -77,6 +84,14 @@ ImportImageStack::ImportImageStack() :
   m_Resolution.y = 1.0f;
   m_Resolution.z = 1.0f;
 
+  m_CropMinimum.x = 0;
+  m_CropMinimum.y = 0;
+  m_CropMinimum.z = 0;
+
+  m_CropMaximum.x = 0;
+  m_CropMaximum.y = 0;
+  m_CropMaximum.z = 0;
+
   m_InputFileListInfo.FileExtension = QString("tif");
   m_InputFileListInfo.StartIndex = 0;
   m_InputFileListInfo.EndIndex = 0;
@@ -118,6 +133,13 @@ void ImportImageStack::setupFilterParameters()
   parameters.push_back(FloatVec3FilterParameter::New("Origin", "Origin", getOrigin(), FilterParameter::Parameter, 0));
   parameters.push_back(FloatVec3FilterParameter::New("Resolution", "Resolution", getResolution(), FilterParameter::Parameter, 0));
   parameters.push_back(InputFileFilterParameter::New("Bounds File", "BoundsFile", getBoundsFile(), FilterParameter::Parameter, "*.txt", "", 1));
+  QStringList linkedProps;
+  linkedProps << "CropMinimum" << "CropMaximum";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Crop Images", "CropImages", getCropImages(), linkedProps, FilterParameter::Parameter));
+  parameters.push_back(IntVec3FilterParameter::New("Crop Minimum (Voxels)", "CropMinimum", getCropMinimum(), FilterParameter::Parameter));
+  parameters.push_back(IntVec3FilterParameter::New("Crop Maximum (Voxels)", "CropMaximum", getCropMaximum(), FilterParameter::Parameter));
+  parameters.push_back(IntFilterParameter::New("Downsample Factor", "DownsampleFactor", getDownsampleFactor(), FilterParameter::Parameter));
+  parameters.push_back(IntFilterParameter::New("Decoder Threads (0 = Automatic)", "NumDecoderThreads", getNumDecoderThreads(), FilterParameter::Parameter));
   parameters.push_back(StringFilterParameter::New("Data Container", "DataContainerName", getDataContainerName(), FilterParameter::CreatedArray));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(StringFilterParameter::New("Cell Attribute Matrix", "CellAttributeMatrixName", getCellAttributeMatrixName(), FilterParameter::CreatedArray));
@@ -139,6 +161,11 @@ void ImportImageStack::readFilterParameters(AbstractFilterParametersReader* read
   setResolution( reader->readFloatVec3("Resolution", getResolution()) );
   setGeometryType(reader->readValue("GeometryType", getGeometryType()));
   setBoundsFile(reader->readString("BoundsFile", getBoundsFile()));
+  setCropImages(reader->readValue("CropImages", getCropImages()));
+  setCropMinimum(reader->readIntVec3("CropMinimum", getCropMinimum()));
+  setCropMaximum(reader->readIntVec3("CropMaximum", getCropMaximum()));
+  setDownsampleFactor(reader->readValue("DownsampleFactor", getDownsampleFactor()));
+  setNumDecoderThreads(reader->readValue("NumDecoderThreads", getNumDecoderThreads()));
   reader->closeFilterGroup();
 }
 
@@ -157,6 +184,11 @@ int ImportImageStack::writeFilterParameters(AbstractFilterParametersWriter* writ
   SIMPL_FILTER_WRITE_PARAMETER(Resolution)
   SIMPL_FILTER_WRITE_PARAMETER(GeometryType)
   SIMPL_FILTER_WRITE_PARAMETER(BoundsFile)
+  SIMPL_FILTER_WRITE_PARAMETER(CropImages)
+  SIMPL_FILTER_WRITE_PARAMETER(CropMinimum)
+  SIMPL_FILTER_WRITE_PARAMETER(CropMaximum)
+  SIMPL_FILTER_WRITE_PARAMETER(DownsampleFactor)
+  SIMPL_FILTER_WRITE_PARAMETER(NumDecoderThreads)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -244,6 +276,13 @@ void ImportImageStack::dataCheck()
     QImageReader reader((fileList[0]));
     QSize imageDims = reader.size();
     int64_t dims[3] = { imageDims.width(), imageDims.height(), fileList.size() };
+    if (dims[0] < 1 || dims[1] < 1)
+    {
+      ss = QObject::tr("The dimensions of the image %1 could not be determined").arg(fileList[0]);
+      setErrorCondition(-4401);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
     /* Sanity check what we are trying to load to make sure it can fit in our address space.
      * Note that this does not guarantee the user has enough left, just that the
      * size of the volume can fit in the address space of the program
@@ -271,23 +310,35 @@ void ImportImageStack::dataCheck()
     }
     /* ************ End Sanity Check *************************** */
 
+    // The geometry describes the imported volume, i.e. after any cropping and downsampling
+    size_t cropMin[3] = { 0, 0, 0 };
+    size_t cropMax[3] = { 0, 0, 0 };
+    ImageStackDecoder::GetImportRegion(this, dims, m_CropImages, m_CropMinimum, m_CropMaximum, m_DownsampleFactor, m_NumDecoderThreads, cropMin, cropMax);
+    if (getErrorCondition() < 0) { return; }
+    ImageStackDecoder decoder(fileList, static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), 1);
+    decoder.setCropRegion(cropMin, cropMax);
+    decoder.setDownsampleFactor(static_cast<size_t>(m_DownsampleFactor));
+    size_t outDims[3] = { 0, 0, 0 };
+    decoder.getOutputDimensions(outDims);
+    float factor = static_cast<float>(m_DownsampleFactor);
+
     if (m_GeometryType == 0)
     {
-      m->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), static_cast<size_t>(dims[2]));
-      m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x, m_Resolution.y, m_Resolution.z);
-      m->getGeometryAs<ImageGeom>()->setOrigin(m_Origin.x, m_Origin.y, m_Origin.z);
+      m->getGeometryAs<ImageGeom>()->setDimensions(outDims[0], outDims[1], outDims[2]);
+      m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x * factor, m_Resolution.y * factor, m_Resolution.z * factor);
+      m->getGeometryAs<ImageGeom>()->setOrigin(m_Origin.x + cropMin[0] * m_Resolution.x, m_Origin.y + cropMin[1] * m_Resolution.y, m_Origin.z + cropMin[2] * m_Resolution.z);
     }
     else if (m_GeometryType == 1)
     {
-      m->getGeometryAs<RectGridGeom>()->setDimensions(static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), static_cast<size_t>(dims[2]));
-      if (!m_BoundsFile.isEmpty()) { err = readBounds(); }
+      m->getGeometryAs<RectGridGeom>()->setDimensions(outDims[0], outDims[1], outDims[2]);
+      if (!m_BoundsFile.isEmpty()) { err = readBounds(dims, cropMin, cropMax); }
       if (err < 0) { setErrorCondition(err); }
     }
 
     QVector<size_t> tDims(3, 0);
     for (int32_t i = 0; i < 3; i++)
     {
-      tDims[i] = dims[i];
+      tDims[i] = outDims[i];
     }
     m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellAttributeMatrixName(), tDims, SIMPL::AttributeMatrixType::Cell);
 
@@ -350,25 +401,6 @@ void ImportImageStack::execute()
   dataCheck();
   if(getErrorCondition() < 0) { return; }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
-  if (m_GeometryType == 0)
-  {
-    m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x, m_Resolution.y, m_Resolution.z);
-    m->getGeometryAs<ImageGeom>()->setOrigin(m_Origin.x, m_Origin.y, m_Origin.z);
-  }
-  else if (m_GeometryType == 1)
-  {
-    int err = readBounds();
-    if (err < 0) return;
-  }
-  UInt8ArrayType::Pointer data = UInt8ArrayType::NullPointer();
-
-  uint8_t* imagePtr = NULL;
-
-  int64_t z = m_InputFileListInfo.StartIndex;
-  int64_t zSpot = 0;
-  size_t pixelBytes = 0; // MUST BE Defined & Initialized out here.
   bool hasMissingFiles = false;
   bool orderAscending = false;
 
@@ -386,84 +418,42 @@ void ImportImageStack::execute()
     QString ss = QObject::tr("No files have been selected for import");
     setErrorCondition(-11);
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
 
-  for (QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
-  {
-    QString imageFName = *filepath;
-    QString ss = QObject::tr("Importing file %1").arg(imageFName);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    QImageReader reader(imageFName);
-    QImage image(imageFName);
-    if (image.isNull() == true)
-    {
-      setErrorCondition(-14000);
-      notifyErrorMessage(getHumanLabel(), "Failed to load image file", getErrorCondition());
-      return;
-    }
-#if defined (CMP_WORDS_BIGENDIAN)
-#error
-#else
-    // We need to convert from Little Endian based ARGB to a physical RGB layout
-    image = image.rgbSwapped();
-#endif
-    size_t height = static_cast<size_t>(image.height());
-    size_t width = static_cast<size_t>(image.width());
-    size_t totalPixels = width * height;
+  QImageReader reader(fileList[0]);
+  QSize imageDims = reader.size();
+  int64_t dims[3] = { imageDims.width(), imageDims.height(), fileList.size() };
+  size_t cropMin[3] = { 0, 0, 0 };
+  size_t cropMax[3] = { 0, 0, 0 };
+  ImageStackDecoder::GetImportRegion(this, dims, m_CropImages, m_CropMinimum, m_CropMaximum, m_DownsampleFactor, m_NumDecoderThreads, cropMin, cropMax);
+  if (getErrorCondition() < 0) { return; }
 
-
-
-    // This is the first image so we need to create our block of data to store the data
-    if (z == m_InputFileListInfo.StartIndex)
-    {
-      if (m_GeometryType == 0) { m->getGeometryAs<ImageGeom>()->setDimensions(width, height, fileList.size()); }
-      else if (m_GeometryType == 1) { m->getGeometryAs<RectGridGeom>()->setDimensions(width, height, fileList.size()); }
-
-      const QImage::Format format = reader.imageFormat();
-      switch(format)
-      {
-        case QImage::Format_Indexed8:
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 5, 0))
-      case QImage::Format_Grayscale8:
-#endif
-          pixelBytes = 1;
-          break;
-        case QImage::Format_RGB32:
-        case QImage::Format_ARGB32:
-          pixelBytes = 4;
-          break;
-        default:
-           pixelBytes = 0;
-      }
-
-      if(pixelBytes == 0)
-      {
-        ss = QObject::tr("Image format is of unsupported type (QImage::Format=%1). Imported images must be either grayscale, RGB, or ARGB").arg(format);
-        setErrorCondition(-4400);
-        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-        return;
-      }
-
-      QVector<size_t> cDims(1, pixelBytes);
-
-      data = UInt8ArrayType::CreateArray(size_t(fileList.size()) * height * width, cDims, m_ImageDataArrayName);
-      data->initializeWithValue(128);
-    }
-
-    // Get the current position in the array to copy the image into
-    zSpot = (z - m_InputFileListInfo.StartIndex);
-    for (size_t i = 0; i < height; ++i)
-    {
-      imagePtr = data->getPointer( (zSpot) * totalPixels * pixelBytes + i * (width * pixelBytes));
-      uint8_t* source = image.scanLine(i);
-      ::memcpy(imagePtr, source, width * pixelBytes);
-    }
-
-    ++z;
-    if (getCancel() == true) { return; }
+  // The geometry was set up by dataCheck(); the rectilinear grid still needs its bounds
+  if (m_GeometryType == 1)
+  {
+    int err = readBounds(dims, cropMin, cropMax);
+    if (err < 0) { return; }
   }
 
-  m->getAttributeMatrix(getCellAttributeMatrixName())->addAttributeArray(data->getName(), data);
+  // The array created by dataCheck() already has the cropped and downsampled size, so the
+  // images are decoded straight into it and the full resolution stack is never held in memory
+  UInt8ArrayType::Pointer data = m_ImageDataPtr.lock();
+  size_t pixelBytes = data->getNumberOfComponents();
+  ImageStackDecoder decoder(fileList, static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), pixelBytes);
+  decoder.setCropRegion(cropMin, cropMax);
+  decoder.setDownsampleFactor(static_cast<size_t>(m_DownsampleFactor));
+  decoder.setNumDecoderThreads(m_NumDecoderThreads);
+  decoder.setSwapRGB(true);
+
+  int err = decoder.decode(data->getPointer(0), pixelBytes, 0, this);
+  if (err < 0)
+  {
+    setErrorCondition(err);
+    notifyErrorMessage(getHumanLabel(), decoder.getErrorMessage(), getErrorCondition());
+    return;
+  }
+  if (getCancel() == true) { return; }
 
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -472,12 +462,11 @@ void ImportImageStack::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int ImportImageStack::readBounds()
+int ImportImageStack::readBounds(const int64_t dims[3], const size_t cropMin[3], const size_t cropMax[3])
 {
-  size_t dims[3];
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-  m->getGeometryAs<RectGridGeom>()->getDimensions(dims);
 
+  // The file holds the bounds of every voxel in the image stack, whatever part of it is imported
   FloatArrayType::Pointer xbounds = FloatArrayType::CreateArray(dims[0] + 1, SIMPL::Geometry::xBoundsList);
   FloatArrayType::Pointer ybounds = FloatArrayType::CreateArray(dims[1] + 1, SIMPL::Geometry::yBoundsList);
   FloatArrayType::Pointer zbounds = FloatArrayType::CreateArray(dims[2] + 1, SIMPL::Geometry::zBoundsList);
@@ -530,7 +519,7 @@ int ImportImageStack::readBounds()
   size_t numXBounds = tokens[1].toInt(&ok, 10);
   if (numXBounds != xbounds->getNumberOfTuples())
   {
-    QString ss = QObject::tr("The number of X bounds in %1 does not match the x dimension of the geometry.").arg(m_BoundsFile);
+    QString ss = QObject::tr("The number of X bounds in %1 does not match the x dimension of the image stack.").arg(m_BoundsFile);
     setErrorCondition(-100);
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
     return -1;
@@ -586,7 +575,7 @@ int ImportImageStack::readBounds()
   size_t numYBounds = tokens[1].toInt(&ok, 10);
   if (numYBounds != ybounds->getNumberOfTuples())
   {
-    QString ss = QObject::tr("The number of Y bounds in %1 does not match the y dimension of the geometry.").arg(m_BoundsFile);
+    QString ss = QObject::tr("The number of Y bounds in %1 does not match the y dimension of the image stack.").arg(m_BoundsFile);
     setErrorCondition(-100);
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
     return -1;
@@ -635,7 +624,7 @@ int ImportImageStack::readBounds()
   size_t numZBounds = tokens[1].toInt(&ok, 10);
   if (numZBounds != zbounds->getNumberOfTuples())
   {
-    QString ss = QObject::tr("The number of Z bounds in %1 does not match the z dimension of the geometry.").arg(m_BoundsFile);
+    QString ss = QObject::tr("The number of Z bounds in %1 does not match the z dimension of the image stack.").arg(m_BoundsFile);
     setErrorCondition(-100);
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
     return -1;
@@ -663,9 +652,27 @@ int ImportImageStack::readBounds()
 
   inFile.close();
 
-  m->getGeometryAs<RectGridGeom>()->setXBounds(xbounds);
-  m->getGeometryAs<RectGridGeom>()->setYBounds(ybounds);
-  m->getGeometryAs<RectGridGeom>()->setZBounds(zbounds);
+  // Each imported cell spans DownsampleFactor voxels of the stack starting at cropMin, and the
+  // last one is cut off at the crop boundary just like the decoder does
+  size_t factor = static_cast<size_t>(m_DownsampleFactor);
+  FloatArrayType::Pointer fullBounds[3] = { xbounds, ybounds, zbounds };
+  FloatArrayType::Pointer croppedBounds[3];
+  for (int32_t i = 0; i < 3; i++)
+  {
+    size_t outDim = (cropMax[i] - cropMin[i] + factor) / factor;
+    croppedBounds[i] = FloatArrayType::CreateArray(outDim + 1, fullBounds[i]->getName());
+    float* full = fullBounds[i]->getPointer(0);
+    float* cropped = croppedBounds[i]->getPointer(0);
+    for (size_t j = 0; j < outDim; j++)
+    {
+      cropped[j] = full[cropMin[i] + j * factor];
+    }
+    cropped[outDim] = full[cropMax[i] + 1];
+  }
+
+  m->getGeometryAs<RectGridGeom>()->setXBounds(croppedBounds[0]);
+  m->getGeometryAs<RectGridGeom>()->setYBounds(croppedBounds[1]);
+  m->getGeometryAs<RectGridGeom>()->setZBounds(croppedBounds[2]);
 
   return 0;
 }
@@ -687,6 +694,11 @@ AbstractFilter::Pointer ImportImageStack::newFilterInstance(bool copyFilterParam
     SIMPL_COPY_INSTANCEVAR(Resolution)
     SIMPL_COPY_INSTANCEVAR(Origin)
     SIMPL_COPY_INSTANCEVAR(BoundsFile)
+    SIMPL_COPY_INSTANCEVAR(CropImages)
+    SIMPL_COPY_INSTANCEVAR(CropMinimum)
+    SIMPL_COPY_INSTANCEVAR(CropMaximum)
+    SIMPL_COPY_INSTANCEVAR(DownsampleFactor)
+    SIMPL_COPY_INSTANCEVAR(NumDecoderThreads)
 #if 0
     SIMPL_COPY_INSTANCEVAR(ZStartIndex)
     SIMPL_COPY_INSTANCEVAR(ZEndIndex)
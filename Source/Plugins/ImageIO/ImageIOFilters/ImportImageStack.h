@@ -43,6 +43,7 @@
 #include "SIMPLib/Common/AbstractFilter.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
 
 /**
@@ -79,6 +80,21 @@ class ImportImageStack : public AbstractFilter
     SIMPL_FILTER_PARAMETER(FileListInfo_t, InputFileListInfo)
     Q_PROPERTY(FileListInfo_t InputFileListInfo READ getInputFileListInfo WRITE setInputFileListInfo)
 
+    SIMPL_FILTER_PARAMETER(bool, CropImages)
+    Q_PROPERTY(bool CropImages READ getCropImages WRITE setCropImages)
+
+    SIMPL_FILTER_PARAMETER(IntVec3_t, CropMinimum)
+    Q_PROPERTY(IntVec3_t CropMinimum READ getCropMinimum WRITE setCropMinimum)
+
+    SIMPL_FILTER_PARAMETER(IntVec3_t, CropMaximum)
+    Q_PROPERTY(IntVec3_t CropMaximum READ getCropMaximum WRITE setCropMaximum)
+
+    SIMPL_FILTER_PARAMETER(int, DownsampleFactor)
+    Q_PROPERTY(int DownsampleFactor READ getDownsampleFactor WRITE setDownsampleFactor)
+
+    SIMPL_FILTER_PARAMETER(int, NumDecoderThreads)
+    Q_PROPERTY(int NumDecoderThreads READ getNumDecoderThreads WRITE setNumDecoderThreads)
+
     SIMPL_FILTER_PARAMETER(int, ImageStack)
     Q_PROPERTY(int ImageStack READ getImageStack WRITE setImageStack)
 
@@ -185,9 +201,13 @@ class ImportImageStack : public AbstractFilter
     void initialize();
 
     /**
-    * @brief readBounds Reads the bounds for voxels from the specified file
+    * @brief readBounds Reads the bounds for voxels of the full image stack from the specified file and
+    * keeps the ones that bound the imported, i.e. cropped and downsampled, cells
+    * @param dims Dimensions of the full image stack
+    * @param cropMin First imported voxel in each direction
+    * @param cropMax Last imported voxel in each direction
     */
-    int readBounds();
+    int readBounds(const int64_t dims[3], const size_t cropMin[3], const size_t cropMax[3]);
 
   private:
     DEFINE_DATAARRAY_VARIABLE(uint8_t, ImageData)
@@ -47,6 +47,9 @@
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
@@ -54,6 +57,7 @@
 
 #include "ImageIO/ImageIOConstants.h"
 #include "ImageIO/FilterParameters/ImportVectorImageStackFilterParameter.h"
+#include "ImageIO/ImageIOFilters/ImageStackDecoder.h"
 
 // Include the MOC generated file for this class
 #include "moc_ImportVectorImageStack.cpp"
@@ -77,6 +81,9 @@ ImportVectorImageStack::ImportVectorImageStack() :
   m_PaddingDigits(0),
   m_RefFrameZDir(SIMPL::RefFrameZDir::LowtoHigh),
   m_VectorDataArrayName(SIMPL::CellData::VectorData),
+  m_CropImages(false),
+  m_DownsampleFactor(1),
+  m_NumDecoderThreads(0),
   m_VectorData(NULL)
 {
 
@@ -88,6 +95,13 @@ ImportVectorImageStack::ImportVectorImageStack() :
   m_Resolution.y = 1.0;
   m_Resolution.z = 1.0;
 
+  m_CropMinimum.x = 0;
+  m_CropMinimum.y = 0;
+  m_CropMinimum.z = 0;
+
+  m_CropMaximum.x = 0;
+  m_CropMaximum.y = 0;
+  m_CropMaximum.z = 0;
 
   setupFilterParameters();
 }
@@ -107,6 +121,13 @@ void ImportVectorImageStack::setupFilterParameters()
   QVector<FilterParameter::Pointer> parameters;
 
   parameters.push_back(ImportVectorImageStackFilterParameter::New("Import Image Data", "ImageVector", getImageVector(), FilterParameter::Parameter));
+  QStringList linkedProps;
+  linkedProps << "CropMinimum" << "CropMaximum";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Crop Images", "CropImages", getCropImages(), linkedProps, FilterParameter::Parameter));
+  parameters.push_back(IntVec3FilterParameter::New("Crop Minimum (Voxels)", "CropMinimum", getCropMinimum(), FilterParameter::Parameter));
+  parameters.push_back(IntVec3FilterParameter::New("Crop Maximum (Voxels)", "CropMaximum", getCropMaximum(), FilterParameter::Parameter));
+  parameters.push_back(IntFilterParameter::New("Downsample Factor", "DownsampleFactor", getDownsampleFactor(), FilterParameter::Parameter));
+  parameters.push_back(IntFilterParameter::New("Decoder Threads (0 = Automatic)", "NumDecoderThreads", getNumDecoderThreads(), FilterParameter::Parameter));
 
   parameters.push_back(StringFilterParameter::New("Data Container Name", "DataContainerName", getDataContainerName(), FilterParameter::CreatedArray));
   parameters.push_back(StringFilterParameter::New("Cell Attribute Matrix Name", "CellAttributeMatrixName", getCellAttributeMatrixName(), FilterParameter::CreatedArray));
@@ -137,6 +158,11 @@ void ImportVectorImageStack::readFilterParameters(AbstractFilterParametersReader
   setFileExtension( reader->readString("FileExtension", getFileExtension()) );
   setOrigin( reader->readFloatVec3("Origin", getOrigin()) );
   setResolution( reader->readFloatVec3("Resolution", getResolution()) );
+  setCropImages( reader->readValue("CropImages", getCropImages()) );
+  setCropMinimum( reader->readIntVec3("CropMinimum", getCropMinimum()) );
+  setCropMaximum( reader->readIntVec3("CropMaximum", getCropMaximum()) );
+  setDownsampleFactor( reader->readValue("DownsampleFactor", getDownsampleFactor()) );
+  setNumDecoderThreads( reader->readValue("NumDecoderThreads", getNumDecoderThreads()) );
   reader->closeFilterGroup();
 }
 
@@ -163,6 +189,11 @@ int ImportVectorImageStack::writeFilterParameters(AbstractFilterParametersWriter
   SIMPL_FILTER_WRITE_PARAMETER(FileExtension)
   SIMPL_FILTER_WRITE_PARAMETER(Origin)
   SIMPL_FILTER_WRITE_PARAMETER(Resolution)
+  SIMPL_FILTER_WRITE_PARAMETER(CropImages)
+  SIMPL_FILTER_WRITE_PARAMETER(CropMinimum)
+  SIMPL_FILTER_WRITE_PARAMETER(CropMaximum)
+  SIMPL_FILTER_WRITE_PARAMETER(DownsampleFactor)
+  SIMPL_FILTER_WRITE_PARAMETER(NumDecoderThreads)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -221,10 +252,17 @@ void ImportVectorImageStack::dataCheck()
     // We should read the file and see what we have? Of course Qt is going to read it up into
     // an RGB array by default
     int err = 0;
-    QImage image(fileList[0]);
-    int64_t dims[3] = {image.width(), image.height(), ((m_EndIndex - m_StartIndex) + 1)};
-    size_t pixelBytes = 0;
     QImageReader reader((fileList[0]));
+    QSize imageDims = reader.size();
+    int64_t dims[3] = {imageDims.width(), imageDims.height(), ((m_EndIndex - m_StartIndex) + 1)};
+    if (dims[0] < 1 || dims[1] < 1)
+    {
+      ss = QObject::tr("The dimensions of the image %1 could not be determined").arg(fileList[0]);
+      setErrorCondition(-4401);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    size_t pixelBytes = 0;
     QImage::Format format = reader.imageFormat();
     switch(format)
     {
@@ -274,14 +312,26 @@ void ImportVectorImageStack::dataCheck()
     }
     /* ************ End Sanity Check *************************** */
 
-    m->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), static_cast<size_t>(dims[2]));
-    m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x, m_Resolution.y, m_Resolution.z);
-    m->getGeometryAs<ImageGeom>()->setOrigin(m_Origin.x, m_Origin.y, m_Origin.z);
+    // The geometry describes the imported volume, i.e. after any cropping and downsampling
+    size_t cropMin[3] = { 0, 0, 0 };
+    size_t cropMax[3] = { 0, 0, 0 };
+    ImageStackDecoder::GetImportRegion(this, dims, m_CropImages, m_CropMinimum, m_CropMaximum, m_DownsampleFactor, m_NumDecoderThreads, cropMin, cropMax);
+    if(getErrorCondition() < 0) { return; }
+    ImageStackDecoder decoder(fileList, static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), pixelBytes);
+    decoder.setCropRegion(cropMin, cropMax);
+    decoder.setDownsampleFactor(static_cast<size_t>(m_DownsampleFactor));
+    size_t outDims[3] = { 0, 0, 0 };
+    decoder.getOutputDimensions(outDims);
+    float factor = static_cast<float>(m_DownsampleFactor);
+
+    m->getGeometryAs<ImageGeom>()->setDimensions(outDims[0], outDims[1], outDims[2]);
+    m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x * factor, m_Resolution.y * factor, m_Resolution.z * factor);
+    m->getGeometryAs<ImageGeom>()->setOrigin(m_Origin.x + cropMin[0] * m_Resolution.x, m_Origin.y + cropMin[1] * m_Resolution.y, m_Origin.z + cropMin[2] * m_Resolution.z);
 
     QVector<size_t> tDims(3, 0);
     for(int i = 0; i < 3; i++)
     {
-      tDims[i] = dims[i];
+      tDims[i] = outDims[i];
     }
     AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellAttributeMatrixName(), tDims, SIMPL::AttributeMatrixType::Cell);
     if(getErrorCondition() < 0) { return; }
@@ -355,29 +405,11 @@ void ImportVectorImageStack::execute()
   dataCheck();
   if(getErrorCondition() < 0) { return; }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
-
-  QVector<size_t> tDims = cellAttrMat->getTupleDimensions();
-  size_t imageWidth = tDims[0];
-  size_t imageHeight = tDims[1];
-  //size_t numVecImages = tDims[2];
-
   size_t numComps = m_VectorDataPtr.lock()->getNumberOfComponents();
   QVector<size_t> cDims = m_VectorDataPtr.lock()->getComponentDimensions();
-  //size_t vecDim = cDims[0];
+  size_t vecDim = cDims[0];
   size_t pixDepth = cDims[1];
 
-  size_t numCompsPerVecImage = imageHeight * imageWidth * numComps;
-
-  int64_t comp = m_StartComp;
-  size_t compSpot;
-  int64_t imageNum = m_StartIndex;
-  size_t imageSpot;
-  size_t imageCompShift;
-
-  uint8_t pixVal = 0;
-
   bool hasMissingFiles = false;
   bool stackLowToHigh = false;
 
@@ -390,49 +422,39 @@ void ImportVectorImageStack::execute()
                               m_FilePrefix, m_Separator, m_FileSuffix, m_FileExtension,
                               m_PaddingDigits);
 
+  QImageReader reader(fileList[0]);
+  QSize imageDims = reader.size();
+  int64_t dims[3] = {imageDims.width(), imageDims.height(), ((m_EndIndex - m_StartIndex) + 1)};
+  size_t cropMin[3] = { 0, 0, 0 };
+  size_t cropMax[3] = { 0, 0, 0 };
+  ImageStackDecoder::GetImportRegion(this, dims, m_CropImages, m_CropMinimum, m_CropMaximum, m_DownsampleFactor, m_NumDecoderThreads, cropMin, cropMax);
+  if(getErrorCondition() < 0) { return; }
 
-  for (QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
+  // The file list holds every component of an image before moving on to the next image. Each
+  // component is imported as its own stack, interleaved into the vector array, so the decoders
+  // write straight into the cropped and downsampled array created by dataCheck()
+  for(size_t comp = 0; comp < vecDim; ++comp)
   {
-    QString imageFName = *filepath;
-    QString ss = QObject::tr("Importing file %1").arg(imageFName);
-    notifyStatusMessage(getHumanLabel(), ss);
-
-    QImage image(imageFName);
-    if (image.isNull() == true)
+    QVector<QString> compFileList;
+    for(int i = static_cast<int>(comp); i < fileList.size(); i += static_cast<int>(vecDim))
     {
-      setErrorCondition(-14000);
-      notifyErrorMessage(getHumanLabel(), "Failed to load Image file", getErrorCondition());
+      compFileList.push_back(fileList[i]);
     }
 
-    compSpot = (comp - m_StartComp);
-    imageSpot = (imageNum - m_StartIndex);
-    imageCompShift = numCompsPerVecImage * imageSpot;
-    size_t compStride = (compSpot * pixDepth);
-    size_t src = 0;
-    size_t dst = 0;
-    size_t hStride;
-    for(size_t i = 0; i < imageHeight; ++i)
-    {
-      uint8_t* source = image.scanLine(i);
-      src = 0;
-      hStride = i * imageWidth;
-      for(size_t j = 0; j < imageWidth; ++j)
-      {
-        dst = imageCompShift + (numComps * (hStride + j)) + compStride;
-        src = j * pixDepth;
-        for(size_t k = 0; k < pixDepth; ++k)
-        {
-          pixVal = source[src + k];
-          m_VectorData[dst + k] = pixVal;
-        }
-      }
-    }
+    QString ss = QObject::tr("Importing component %1 of %2").arg(comp + 1).arg(vecDim);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+    ImageStackDecoder decoder(compFileList, static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), pixDepth);
+    decoder.setCropRegion(cropMin, cropMax);
+    decoder.setDownsampleFactor(static_cast<size_t>(m_DownsampleFactor));
+    decoder.setNumDecoderThreads(m_NumDecoderThreads);
 
-    ++comp;
-    if(comp > m_EndComp)
+    err = decoder.decode(m_VectorData, numComps, comp * pixDepth, this);
+    if(err < 0)
     {
-      comp = m_StartComp;
-      imageNum++;
+      setErrorCondition(err);
+      notifyErrorMessage(getHumanLabel(), decoder.getErrorMessage(), getErrorCondition());
+      return;
     }
     if(getCancel() == true)
     {
@@ -474,6 +496,11 @@ AbstractFilter::Pointer ImportVectorImageStack::newFilterInstance(bool copyFilte
     SIMPL_COPY_INSTANCEVAR(RefFrameZDir)
     SIMPL_COPY_INSTANCEVAR(ImageVector)
     SIMPL_COPY_INSTANCEVAR(VectorDataArrayName)
+    SIMPL_COPY_INSTANCEVAR(CropImages)
+    SIMPL_COPY_INSTANCEVAR(CropMinimum)
+    SIMPL_COPY_INSTANCEVAR(CropMaximum)
+    SIMPL_COPY_INSTANCEVAR(DownsampleFactor)
+    SIMPL_COPY_INSTANCEVAR(NumDecoderThreads)
   }
   return filter;
 }
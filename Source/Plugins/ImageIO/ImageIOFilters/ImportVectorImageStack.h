@@ -43,6 +43,7 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 
 #include "ImageIO/ImageIOConstants.h"
 /**
@@ -88,6 +89,21 @@ class ImportVectorImageStack : public AbstractFilter
     SIMPL_FILTER_PARAMETER(QString, VectorDataArrayName)
     Q_PROPERTY(QString VectorDataArrayName READ getVectorDataArrayName WRITE setVectorDataArrayName)
 
+    SIMPL_FILTER_PARAMETER(bool, CropImages)
+    Q_PROPERTY(bool CropImages READ getCropImages WRITE setCropImages)
+
+    SIMPL_FILTER_PARAMETER(IntVec3_t, CropMinimum)
+    Q_PROPERTY(IntVec3_t CropMinimum READ getCropMinimum WRITE setCropMinimum)
+
+    SIMPL_FILTER_PARAMETER(IntVec3_t, CropMaximum)
+    Q_PROPERTY(IntVec3_t CropMaximum READ getCropMaximum WRITE setCropMaximum)
+
+    SIMPL_FILTER_PARAMETER(int, DownsampleFactor)
+    Q_PROPERTY(int DownsampleFactor READ getDownsampleFactor WRITE setDownsampleFactor)
+
+    SIMPL_FILTER_PARAMETER(int, NumDecoderThreads)
+    Q_PROPERTY(int NumDecoderThreads READ getNumDecoderThreads WRITE setNumDecoderThreads)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
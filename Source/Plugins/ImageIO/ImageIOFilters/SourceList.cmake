@@ -50,7 +50,12 @@ foreach(f ${_PrivateFilters} )
 endforeach()
 
 
-
+#-------------
+# These are files that need to be compiled into the plugin but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER(${ImageIO_SOURCE_DIR} ${_filterGroupName} ImageStackDecoder.h)
+ADD_SIMPL_SUPPORT_SOURCE(${ImageIO_SOURCE_DIR} ${_filterGroupName} ImageStackDecoder.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${ImageIO_SOURCE_DIR} ${_filterGroupName} TiffWriter.h)
+ADD_SIMPL_SUPPORT_SOURCE(${ImageIO_SOURCE_DIR} ${_filterGroupName} TiffWriter.cpp)
 
 SIMPL_END_FILTER_GROUP(${ImageIO_BINARY_DIR} "${_filterGroupName}" "Image Import Filters")
 
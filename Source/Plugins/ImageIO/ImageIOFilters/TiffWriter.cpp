@@ -0,0 +1,267 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TiffWriter.h"
+
+#include <string.h>
+
+#include <limits>
+#include <vector>
+
+#include <QtCore/QFile>
+
+namespace
+{
+  enum TiffFieldType
+  {
+    TiffAscii = 2,
+    TiffShort = 3,
+    TiffLong = 4
+  };
+
+  /**
+   * @brief One IFD entry. Values of up to 4 bytes are stored in place, anything
+   * larger is written after the image data and referenced by offset.
+   */
+  struct TiffEntry
+  {
+    uint16_t tag;
+    uint16_t type;
+    uint32_t count;
+    QByteArray value;
+  };
+
+  template<typename T>
+  void appendValue(QByteArray& buffer, T value)
+  {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  TiffEntry shortEntry(uint16_t tag, const std::vector<uint16_t>& values)
+  {
+    TiffEntry entry = { tag, TiffShort, static_cast<uint32_t>(values.size()), QByteArray() };
+    for (size_t i = 0; i < values.size(); i++) { appendValue<uint16_t>(entry.value, values[i]); }
+    return entry;
+  }
+
+  TiffEntry longEntry(uint16_t tag, const std::vector<uint32_t>& values)
+  {
+    TiffEntry entry = { tag, TiffLong, static_cast<uint32_t>(values.size()), QByteArray() };
+    for (size_t i = 0; i < values.size(); i++) { appendValue<uint32_t>(entry.value, values[i]); }
+    return entry;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TiffWriter::TiffWriter()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TiffWriter::~TiffWriter()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TiffWriter::PackBits(const uint8_t* src, size_t count, QByteArray& dst)
+{
+  size_t i = 0;
+  while (i < count)
+  {
+    size_t j = i + 1;
+    while (j < count && j - i < 128 && src[j] == src[i]) { j++; }
+    size_t runLength = j - i;
+    if (runLength >= 3)
+    {
+      // Replicate run: header is 1 - runLength
+      dst.append(static_cast<char>(1 - static_cast<int>(runLength)));
+      dst.append(static_cast<char>(src[i]));
+      i = j;
+    }
+    else
+    {
+      // Literal run, stopping in front of the next run of 3 or more equal bytes
+      size_t start = i;
+      while (i < count && i - start < 128)
+      {
+        if (i + 2 < count && src[i] == src[i + 1] && src[i] == src[i + 2]) { break; }
+        i++;
+      }
+      dst.append(static_cast<char>(i - start - 1));
+      dst.append(reinterpret_cast<const char*>(src + start), static_cast<int>(i - start));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TiffWriter::WriteImage(const QString& filePath, const void* data, size_t width, size_t height, size_t samplesPerPixel,
+                           size_t bitsPerSample, int sampleFormat, int compression, const QString& description)
+{
+  size_t rowBytes = width * samplesPerPixel * (bitsPerSample / 8);
+  // Offsets in a baseline TIFF are 32 bit. Leave room for the PackBits worst case and the tags.
+  uint64_t worstCase = static_cast<uint64_t>(rowBytes) * height;
+  worstCase += worstCase / 128 + height + (1 << 20);
+  if (rowBytes == 0 || height == 0 || worstCase > std::numeric_limits<uint32_t>::max())
+  {
+    return -1;
+  }
+
+  QFile file(filePath);
+  if (file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false)
+  {
+    return -2;
+  }
+
+  // Header, the offset of the IFD is patched in at the end
+  QByteArray buffer;
+#if defined (CMP_WORDS_BIGENDIAN)
+  buffer.append("MM", 2);
+#else
+  buffer.append("II", 2);
+#endif
+  appendValue<uint16_t>(buffer, 42);
+  appendValue<uint32_t>(buffer, 0);
+  if (file.write(buffer) != buffer.size()) { return -2; }
+  uint64_t position = static_cast<uint64_t>(buffer.size());
+
+  // Strips of about 64KB each
+  size_t rowsPerStrip = (rowBytes < 65536) ? 65536 / rowBytes : 1;
+  if (rowsPerStrip > height) { rowsPerStrip = height; }
+  size_t numStrips = (height + rowsPerStrip - 1) / rowsPerStrip;
+  std::vector<uint32_t> stripOffsets(numStrips, 0);
+  std::vector<uint32_t> stripByteCounts(numStrips, 0);
+
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  for (size_t s = 0; s < numStrips; s++)
+  {
+    size_t firstRow = s * rowsPerStrip;
+    size_t numRows = (firstRow + rowsPerStrip > height) ? height - firstRow : rowsPerStrip;
+    const uint8_t* stripStart = bytes + firstRow * rowBytes;
+    stripOffsets[s] = static_cast<uint32_t>(position);
+    if (compression == PackBitsCompression)
+    {
+      // PackBits runs never cross a row boundary
+      buffer.clear();
+      for (size_t r = 0; r < numRows; r++)
+      {
+        PackBits(stripStart + r * rowBytes, rowBytes, buffer);
+      }
+      if (file.write(buffer) != buffer.size()) { return -2; }
+      stripByteCounts[s] = static_cast<uint32_t>(buffer.size());
+    }
+    else
+    {
+      qint64 numBytes = static_cast<qint64>(numRows * rowBytes);
+      if (file.write(reinterpret_cast<const char*>(stripStart), numBytes) != numBytes) { return -2; }
+      stripByteCounts[s] = static_cast<uint32_t>(numBytes);
+    }
+    position += stripByteCounts[s];
+  }
+
+  // The IFD entries must be sorted by tag
+  std::vector<TiffEntry> entries;
+  entries.push_back(longEntry(256, std::vector<uint32_t>(1, static_cast<uint32_t>(width))));
+  entries.push_back(longEntry(257, std::vector<uint32_t>(1, static_cast<uint32_t>(height))));
+  entries.push_back(shortEntry(258, std::vector<uint16_t>(samplesPerPixel, static_cast<uint16_t>(bitsPerSample))));
+  entries.push_back(shortEntry(259, std::vector<uint16_t>(1, static_cast<uint16_t>(compression))));
+  entries.push_back(shortEntry(262, std::vector<uint16_t>(1, (samplesPerPixel >= 3) ? 2 : 1)));
+  if (description.isEmpty() == false)
+  {
+    QByteArray text = description.toLatin1();
+    text.append('\0');
+    TiffEntry entry = { 270, TiffAscii, static_cast<uint32_t>(text.size()), text };
+    entries.push_back(entry);
+  }
+  entries.push_back(longEntry(273, stripOffsets));
+  entries.push_back(shortEntry(277, std::vector<uint16_t>(1, static_cast<uint16_t>(samplesPerPixel))));
+  entries.push_back(longEntry(278, std::vector<uint32_t>(1, static_cast<uint32_t>(rowsPerStrip))));
+  entries.push_back(longEntry(279, stripByteCounts));
+  entries.push_back(shortEntry(284, std::vector<uint16_t>(1, 1)));
+  if (samplesPerPixel == 4)
+  {
+    entries.push_back(shortEntry(338, std::vector<uint16_t>(1, 0)));
+  }
+  entries.push_back(shortEntry(339, std::vector<uint16_t>(samplesPerPixel, static_cast<uint16_t>(sampleFormat))));
+
+  // Values that do not fit into an entry go in front of the IFD, each on a word boundary
+  buffer.clear();
+  if (position % 2 != 0) { buffer.append('\0'); }
+  std::vector<uint32_t> valueOffsets(entries.size(), 0);
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    if (entries[i].value.size() > 4)
+    {
+      valueOffsets[i] = static_cast<uint32_t>(position + buffer.size());
+      buffer.append(entries[i].value);
+      if ((position + buffer.size()) % 2 != 0) { buffer.append('\0'); }
+    }
+  }
+  uint32_t ifdOffset = static_cast<uint32_t>(position + buffer.size());
+
+  appendValue<uint16_t>(buffer, static_cast<uint16_t>(entries.size()));
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    appendValue<uint16_t>(buffer, entries[i].tag);
+    appendValue<uint16_t>(buffer, entries[i].type);
+    appendValue<uint32_t>(buffer, entries[i].count);
+    if (entries[i].value.size() > 4)
+    {
+      appendValue<uint32_t>(buffer, valueOffsets[i]);
+    }
+    else
+    {
+      QByteArray value = entries[i].value;
+      while (value.size() < 4) { value.append('\0'); }
+      buffer.append(value);
+    }
+  }
+  appendValue<uint32_t>(buffer, 0); // No further IFDs
+  if (file.write(buffer) != buffer.size()) { return -2; }
+
+  // Point the header at the IFD
+  buffer.clear();
+  appendValue<uint32_t>(buffer, ifdOffset);
+  if (file.seek(4) == false || file.write(buffer) != buffer.size()) { return -2; }
+  file.close();
+  return 0;
+}
@@ -0,0 +1,96 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _tiffwriter_h_
+#define _tiffwriter_h_
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The TiffWriter class writes single page, baseline TIFF files without going
+ * through QImage. This allows grayscale, RGB and RGBA images with 8 or 16 bit unsigned
+ * integer or 32 bit floating point samples to be written, optionally compressed with
+ * PackBits. The file is written in the byte order of the host.
+ */
+class TiffWriter
+{
+  public:
+    enum CompressionType
+    {
+      NoCompression = 1,
+      PackBitsCompression = 32773
+    };
+
+    enum SampleFormatType
+    {
+      UnsignedIntegerSample = 1,
+      FloatSample = 3
+    };
+
+    virtual ~TiffWriter();
+
+    /**
+     * @brief WriteImage Writes an image to a TIFF file
+     * @param filePath Path of the file to write
+     * @param data Pixel interleaved samples, row by row starting at the top of the image
+     * @param width Width of the image in pixels
+     * @param height Height of the image in pixels
+     * @param samplesPerPixel 1 (grayscale), 3 (RGB) or 4 (RGBA)
+     * @param bitsPerSample 8, 16 or 32
+     * @param sampleFormat One of the SampleFormatType values
+     * @param compression One of the CompressionType values
+     * @param description Text for the ImageDescription tag
+     * @return 0 on success, -1 if the image is too large for a TIFF file and -2 if the file could not be written
+     */
+    static int WriteImage(const QString& filePath, const void* data, size_t width, size_t height, size_t samplesPerPixel,
+                          size_t bitsPerSample, int sampleFormat, int compression, const QString& description);
+
+    /**
+     * @brief PackBits Appends the PackBits encoding of count bytes to dst
+     */
+    static void PackBits(const uint8_t* src, size_t count, QByteArray& dst);
+
+  protected:
+    TiffWriter();
+
+  private:
+    TiffWriter(const TiffWriter&); // Copy Constructor Not Implemented
+    void operator=(const TiffWriter&); // Operator '=' Not Implemented
+};
+
+#endif /* _tiffwriter_h_ */
@@ -35,26 +35,269 @@
 
 #include "WriteImages.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include <QtCore/QDir>
+#include <QtGui/QImage>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#include <tbb/task_group.h>
+#endif
 
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.hpp"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 #include "SIMPLib/FilterParameters/OutputPathFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "ImageIO/ImageIOConstants.h"
+#include "ImageIO/ImageIOFilters/TiffWriter.h"
 
 // Include the MOC generated file for this class
 #include "moc_WriteImages.cpp"
 
+/**
+ * @brief The WriteImagesImpl class gathers and writes a block of consecutive slices of
+ * one plane. Several instances run at the same time as tbb tasks. Errors are handed back
+ * through err and message so that the filter can report them in slice order.
+ */
+template<typename T>
+class WriteImagesImpl
+{
+  public:
+    WriteImagesImpl(WriteImages* filter, const T* data, const size_t* dims, size_t nComp, int plane, size_t firstSlice, size_t numSlices,
+                    bool useTiffWriter, int* err, QString* message) :
+      m_Filter(filter),
+      m_Data(data),
+      m_Dims(dims),
+      m_NComp(nComp),
+      m_Plane(plane),
+      m_FirstSlice(firstSlice),
+      m_NumSlices(numSlices),
+      m_UseTiffWriter(useTiffWriter),
+      m_Err(err),
+      m_Message(message)
+    {}
+    virtual ~WriteImagesImpl() {}
+
+    void operator()() const
+    {
+      // dB is the width and dA the height of the images for this plane
+      size_t dB = (WriteImages::YZPlane == m_Plane) ? m_Dims[1] : m_Dims[0];
+      size_t dA = (WriteImages::XYPlane == m_Plane) ? m_Dims[1] : m_Dims[2];
+      size_t imageSize = dB * dA * m_NComp;
+      size_t rowSize = m_Dims[0] * m_NComp;
+      std::vector<std::vector<T> > images(m_NumSlices, std::vector<T>(imageSize));
+
+      // Every gather reads whole rows of the volume; the YZ images of a block share each row
+      if (WriteImages::XYPlane == m_Plane)
+      {
+        ::memcpy(&(images[0][0]), m_Data + m_FirstSlice * m_Dims[1] * rowSize, imageSize * sizeof(T));
+      }
+      else if (WriteImages::XZPlane == m_Plane)
+      {
+        for (size_t z = 0; z < m_Dims[2]; ++z)
+        {
+          const T* row = m_Data + (z * m_Dims[1] + m_FirstSlice) * rowSize;
+          ::memcpy(&(images[0][z * rowSize]), row, rowSize * sizeof(T));
+        }
+      }
+      else
+      {
+        for (size_t z = 0; z < m_Dims[2]; ++z)
+        {
+          for (size_t y = 0; y < m_Dims[1]; ++y)
+          {
+            const T* row = m_Data + (z * m_Dims[1] + y) * rowSize + m_FirstSlice * m_NComp;
+            size_t dst = (z * m_Dims[1] + y) * m_NComp;
+            for (size_t i = 0; i < m_NumSlices; ++i)
+            {
+              for (size_t k = 0; k < m_NComp; ++k)
+              {
+                images[i][dst + k] = row[i * m_NComp + k];
+              }
+            }
+          }
+        }
+      }
+
+      for (size_t i = 0; i < m_NumSlices; ++i)
+      {
+        QString path = m_Filter->generateImagePath(m_Plane, m_FirstSlice + i);
+        *m_Err = writeImage(path, images[i], dB, dA);
+        if (*m_Err < 0)
+        {
+          *m_Message = QObject::tr("The image '%1' was not successfully saved").arg(path);
+          return;
+        }
+        // Release each image as soon as it is on disk
+        std::vector<T>().swap(images[i]);
+      }
+    }
+
+  private:
+    WriteImages* m_Filter;
+    const T* m_Data;
+    const size_t* m_Dims;
+    size_t m_NComp;
+    int m_Plane;
+    size_t m_FirstSlice;
+    size_t m_NumSlices;
+    bool m_UseTiffWriter;
+    int* m_Err;
+    QString* m_Message;
+
+    int writeImage(const QString& path, const std::vector<T>& pixels, size_t dB, size_t dA) const
+    {
+      if (m_UseTiffWriter)
+      {
+        int sampleFormat = std::numeric_limits<T>::is_integer ? TiffWriter::UnsignedIntegerSample : TiffWriter::FloatSample;
+        int compression = m_Filter->getCompressTiff() ? TiffWriter::PackBitsCompression : TiffWriter::NoCompression;
+        int err = TiffWriter::WriteImage(path, &(pixels[0]), dB, dA, m_NComp, sizeof(T) * 8, sampleFormat, compression, SIMPLib::Version::PackageComplete());
+        return (err < 0) ? -1 : 0;
+      }
+
+      // Only uint8_t arrays get here
+      QImage image(static_cast<int>(dB), static_cast<int>(dA), (m_NComp == 1) ? QImage::Format_Grayscale8 : QImage::Format_RGB32);
+      if (image.isNull())
+      {
+        return -1;
+      }
+      for (size_t axisA = 0; axisA < dA; ++axisA)
+      {
+        uint8_t* scanLine = image.scanLine(static_cast<int>(axisA));
+        const T* source = &(pixels[axisA * dB * m_NComp]);
+        if (m_NComp == 1)
+        {
+          ::memcpy(scanLine, source, dB);
+          continue;
+        }
+        for (size_t axisB = 0; axisB < dB; ++axisB)
+        {
+#if defined (CMP_WORDS_BIGENDIAN)
+#error
+#else
+          scanLine[axisB * 4 + 3] = 0xFF;
+          scanLine[axisB * 4 + 2] = static_cast<uint8_t>(source[axisB * m_NComp + 0]);
+          scanLine[axisB * 4 + 1] = static_cast<uint8_t>(source[axisB * m_NComp + 1]);
+          scanLine[axisB * 4 + 0] = static_cast<uint8_t>(source[axisB * m_NComp + 2]);
+#endif
+        }
+      }
+      image.setText("Description", SIMPLib::Version::PackageComplete());
+      return image.save(path) ? 0 : -1;
+    }
+};
+
+/**
+ * @brief writePlanes Writes all slices of the selected planes. The slices are split into
+ * jobs that are run a window at a time, one job per thread, so at most one window of
+ * images is held in memory. Each window is checked in order for errors before the next
+ * one starts.
+ */
+template<typename T>
+void writePlanes(WriteImages* filter, IDataArray::Pointer colors, const size_t* dims, const QVector<int>& planes, bool useTiffWriter)
+{
+  typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T> >(colors);
+  const T* data = array->getPointer(0);
+  size_t nComp = static_cast<size_t>(array->getNumberOfComponents());
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  size_t numThreads = static_cast<size_t>(init.default_num_threads());
+#else
+  size_t numThreads = 1;
+#endif
+  if (filter->getNumWriterThreads() > 0) { numThreads = static_cast<size_t>(filter->getNumWriterThreads()); }
+
+  // One job per XY or XZ slice. YZ slices are gathered in blocks so that every row of
+  // the volume that is touched is used for a whole block of images.
+  std::vector<int> jobPlane;
+  std::vector<size_t> jobFirst;
+  std::vector<size_t> jobCount;
+  for (int p = 0; p < planes.size(); p++)
+  {
+    size_t numSlices = (WriteImages::XYPlane == planes[p]) ? dims[2] : (WriteImages::XZPlane == planes[p]) ? dims[1] : dims[0];
+    size_t block = 1;
+    if (WriteImages::YZPlane == planes[p])
+    {
+      size_t imageBytes = dims[1] * dims[2] * nComp * sizeof(T);
+      block = (imageBytes > 0) ? (size_t(64) << 20) / imageBytes : 1;
+      block = std::max(size_t(1), std::min(block, size_t(32)));
+    }
+    for (size_t s = 0; s < numSlices; s += block)
+    {
+      jobPlane.push_back(planes[p]);
+      jobFirst.push_back(s);
+      jobCount.push_back(std::min(block, numSlices - s));
+    }
+  }
+
+  size_t numJobs = jobPlane.size();
+  size_t window = std::max(size_t(1), numThreads);
+  std::vector<int> errors(window, 0);
+  std::vector<QString> messages(window);
+  size_t imagesWritten = 0;
+  size_t totalImages = 0;
+  for (size_t j = 0; j < numJobs; j++) { totalImages += jobCount[j]; }
+
+  for (size_t jStart = 0; jStart < numJobs; jStart += window)
+  {
+    size_t jStop = std::min(jStart + window, numJobs);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true && jStop - jStart > 1)
+    {
+      tbb::task_group* g = new tbb::task_group;
+      for (size_t j = jStart; j < jStop; j++)
+      {
+        g->run(WriteImagesImpl<T>(filter, data, dims, nComp, jobPlane[j], jobFirst[j], jobCount[j], useTiffWriter, &(errors[j - jStart]), &(messages[j - jStart])));
+      }
+      g->wait();
+      delete g;
+    }
+    else
+#endif
+    {
+      for (size_t j = jStart; j < jStop; j++)
+      {
+        WriteImagesImpl<T> serial(filter, data, dims, nComp, jobPlane[j], jobFirst[j], jobCount[j], useTiffWriter, &(errors[j - jStart]), &(messages[j - jStart]));
+        serial();
+      }
+    }
+
+    for (size_t j = jStart; j < jStop; j++)
+    {
+      if (errors[j - jStart] < 0)
+      {
+        filter->setErrorCondition(-1007);
+        filter->notifyErrorMessage(filter->getHumanLabel(), messages[j - jStart], filter->getErrorCondition());
+        return;
+      }
+      imagesWritten += jobCount[j];
+    }
+
+    QString ss = QObject::tr("Wrote %1 of %2 images").arg(imagesWritten).arg(totalImages);
+    filter->notifyStatusMessage(filter->getMessagePrefix(), filter->getHumanLabel(), ss);
+    if (filter->getCancel() == true) { return; }
+  }
+}
+
 
 
 // -----------------------------------------------------------------------------
@@ -68,6 +311,8 @@ WriteImages::WriteImages() :
   m_ImageFormat(0),
   m_Plane(0),
   m_ColorsArrayPath("", "", ""),
+  m_CompressTiff(false),
+  m_NumWriterThreads(0),
   m_Colors(NULL)
 {
   setupFilterParameters();
@@ -108,6 +353,7 @@ void WriteImages::setupFilterParameters()
     choices.push_back("XY");
     choices.push_back("XZ");
     choices.push_back("YZ");
+    choices.push_back("All (XY, XZ and YZ)");
     parameter->setChoices(choices);
     parameter->setCategory(FilterParameter::Parameter);
     parameters.push_back(parameter);
@@ -120,9 +366,16 @@ void WriteImages::setupFilterParameters()
     parameters.push_back(LinkedBooleanFilterParameter::New("File Prefix", "FilePrefix", getFilePrefix(), linkedProps, FilterParameter::Parameter));
   }
   parameters.push_back(StringFilterParameter::New("Image File Prefix", "ImagePrefix", getImagePrefix(), FilterParameter::Parameter));
+  parameters.push_back(BooleanFilterParameter::New("Compress TIFF Images (PackBits)", "CompressTiff", getCompressTiff(), FilterParameter::Parameter));
+  parameters.push_back(IntFilterParameter::New("Writer Threads (0 = Automatic)", "NumWriterThreads", getNumWriterThreads(), FilterParameter::Parameter));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::UInt8, SIMPL::Defaults::AnyComponentSize, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
+    QVector<QString> daTypes;
+    daTypes.push_back(SIMPL::TypeNames::UInt8);
+    daTypes.push_back(SIMPL::TypeNames::UInt16);
+    daTypes.push_back(SIMPL::TypeNames::Float);
+    req.daTypes = daTypes;
     parameters.push_back(DataArraySelectionFilterParameter::New("Color Data", "ColorsArrayPath", getColorsArrayPath(), FilterParameter::RequiredArray, req));
   }
   setFilterParameters(parameters);
@@ -140,6 +393,8 @@ void WriteImages::readFilterParameters(AbstractFilterParametersReader* reader, i
   setColorsArrayPath( reader->readDataArrayPath("ColorsArrayPath", getColorsArrayPath()) );
   setImageFormat( reader->readValue("ImageFormat", getImageFormat()) );
   setPlane(reader->readValue("Plane", getPlane()));
+  setCompressTiff(reader->readValue("CompressTiff", getCompressTiff()));
+  setNumWriterThreads(reader->readValue("NumWriterThreads", getNumWriterThreads()));
   reader->closeFilterGroup();
 }
 
@@ -156,6 +411,8 @@ int WriteImages::writeFilterParameters(AbstractFilterParametersWriter* writer, i
   SIMPL_FILTER_WRITE_PARAMETER(ColorsArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(ImageFormat)
   SIMPL_FILTER_WRITE_PARAMETER(Plane)
+  SIMPL_FILTER_WRITE_PARAMETER(CompressTiff)
+  SIMPL_FILTER_WRITE_PARAMETER(NumWriterThreads)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -191,33 +448,65 @@ void WriteImages::dataCheck()
   ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getColorsArrayPath().getDataContainerName());
   if(getErrorCondition() < 0) { return; }
 
-  size_t dims[3] = { 0, 0, 0 };
-  image->getDimensions(dims);
-  if (0 == m_Plane) // XY plane
+  if (m_Plane < XYPlane || m_Plane > AllPlanes)
   {
-    size_t total = dims[0] * dims[1] * 4;
-    if(total > std::numeric_limits<int32_t>::max())
-    {
-      QString ss = QObject::tr("The image will have more than 2GB worth of pixels. Try cropping the data so that the total pixels on a single plane is less than 2GB.");
-      setErrorCondition(-1012);
-      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-      return;
-    }
+    QString ss = QObject::tr("The selected plane (%1) is not valid").arg(m_Plane);
+    setErrorCondition(-1013);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
-  else if (1 == m_Plane) // XZ plane
+
+  if (m_NumWriterThreads < 0)
   {
-    size_t total = dims[0] * dims[2] * 4;
-    if(total > std::numeric_limits<int32_t>::max())
+    QString ss = QObject::tr("The number of writer threads must be 0 (automatic) or larger");
+    setErrorCondition(-1017);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  m_ColorsPtr = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, getColorsArrayPath());
+  if (getErrorCondition() < 0) { return; }
+
+  IDataArray::Pointer iDa = m_ColorsPtr.lock();
+  size_t bytesPerPixel = 4; // 8 bit images go through QImage, which converts them to RGBA
+  if (TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(iDa))
+  {
+    if (m_ImageFormat == TifImageType && m_CompressTiff) { bytesPerPixel = iDa->getNumberOfComponents(); }
+  }
+  else if (TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(iDa) || TemplateHelpers::CanDynamicCast<FloatArrayType>()(iDa))
+  {
+    if (m_ImageFormat != TifImageType)
     {
-      QString ss = QObject::tr("The image will have more than 2GB worth of pixels. Try cropping the data so that the total pixels on a single plane is less than 2GB.");
-      setErrorCondition(-1012);
+      QString ss = QObject::tr("16 bit and floating point arrays can only be written as tif images");
+      setErrorCondition(-1015);
       notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
       return;
     }
+    bytesPerPixel = iDa->getNumberOfComponents() * iDa->getTypeSize();
   }
-  else if (2 == m_Plane) // YZ plane
+  else
+  {
+    QString ss = QObject::tr("The color data must be of type uint8_t, uint16_t or float. The selected array is of type %1").arg(iDa->getTypeAsString());
+    setErrorCondition(-1016);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  QVector<size_t> cDims = iDa->getComponentDimensions();
+  if (cDims[0] != 1 && cDims[0] != 3 && cDims[0] != 4)
   {
-    size_t total = dims[1] * dims[2] * 4;
+    setErrorCondition(-1006);
+    notifyErrorMessage(getHumanLabel(), "Number of components must be 1 (grayscale), 3 (RGB) or 4 (ARGB) arrays", getErrorCondition());
+    return;
+  }
+
+  size_t dims[3] = { 0, 0, 0 };
+  image->getDimensions(dims);
+  size_t planeSizes[3] = { dims[0] * dims[1], dims[0] * dims[2], dims[1] * dims[2] };
+  for (int plane = XYPlane; plane <= YZPlane; plane++)
+  {
+    if (m_Plane != plane && m_Plane != AllPlanes) { continue; }
+    size_t total = planeSizes[plane] * bytesPerPixel;
     if(total > std::numeric_limits<int32_t>::max())
     {
       QString ss = QObject::tr("The image will have more than 2GB worth of pixels. Try cropping the data so that the total pixels on a single plane is less than 2GB.");
@@ -226,34 +515,6 @@ void WriteImages::dataCheck()
       return;
     }
   }
-  IDataArray::Pointer iDa = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, getColorsArrayPath());
-  if (getErrorCondition() < 0) { return; }
-
-  QVector<size_t> cDims = iDa->getComponentDimensions();
-
-  if (cDims[0] == 1)
-  {
-    m_ColorsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint8_t>, AbstractFilter>(this, getColorsArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if (NULL != m_ColorsPtr.lock().get()) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
-    { m_Colors = m_ColorsPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
-  }
-  else if (cDims[0] == 3)
-  {
-    m_ColorsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint8_t>, AbstractFilter>(this, getColorsArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if (NULL != m_ColorsPtr.lock().get()) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
-    { m_Colors = m_ColorsPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
-  }
-  else if (cDims[0] == 4)
-  {
-    m_ColorsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint8_t>, AbstractFilter>(this, getColorsArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if (NULL != m_ColorsPtr.lock().get()) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
-    { m_Colors = m_ColorsPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
-  }
-  else
-  {
-    setErrorCondition(-1006);
-    notifyErrorMessage(getHumanLabel(), "Number of components must be 1 (grayscale), 3 (RGB) or 4 (ARGB) arrays", getErrorCondition());
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -283,180 +544,64 @@ void WriteImages::execute()
   size_t dims[3] = { 0, 0, 0 };
   m->getGeometryAs<ImageGeom>()->getDimensions(dims);
 
-  int32_t nComp = m_ColorsPtr.lock()->getNumberOfComponents();
-
-  if (0 == m_Plane) // XY plane
+  QVector<int> planes;
+  if (AllPlanes == m_Plane)
   {
-    for (size_t z = 0; z < dims[2]; ++z)
-    {
-      if (nComp == 1)
-      {
-        err = writeGrayscaleImage(z, dims[0], dims[1], dims);
-      }
-      else
-      {
-        err = writeRGBImage(z, dims[0], dims[1], dims);
-      }
-
-      if (-1 == err)
-      {
-        return;
-      }
-    }
+    planes << XYPlane << XZPlane << YZPlane;
   }
-  else if (1 == m_Plane) // XZ plane
+  else
   {
-    for (size_t y = 0; y < dims[1]; ++y)
-    {
-      if (nComp == 1)
-      {
-        err = writeGrayscaleImage(y, dims[0], dims[2], dims);
-      }
-      else
-      {
-        err = writeRGBImage(y, dims[0], dims[2], dims);
-      }
-
-      if (-1 == err)
-      {
-        return;
-      }
-    }
+    planes << m_Plane;
   }
-  else if (2 == m_Plane) // YZ plane
+
+  // Create the output folders up front so the writer tasks never race on them
+  for (int p = 0; p < planes.size(); p++)
   {
-    for (size_t x = 0; x < dims[0]; ++x)
+    QFileInfo fi(generateImagePath(planes[p], 0));
+    QDir parent(fi.absolutePath());
+    if (parent.exists() == false && parent.mkpath(fi.absolutePath()) == false)
     {
-      if (nComp == 1)
-      {
-        err = writeGrayscaleImage(x, dims[1], dims[2], dims);
-      }
-      else
-      {
-        err = writeRGBImage(x, dims[1], dims[2], dims);
-      }
-
-      if (-1 == err)
-      {
-        return;
-      }
+      QString ss = QObject::tr("The output directory '%1' could not be created").arg(fi.absolutePath());
+      setErrorCondition(-1008);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
     }
   }
 
-  notifyStatusMessage(getHumanLabel(), "Complete");
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t WriteImages::writeRGBImage(size_t slice, size_t dB, size_t dA, size_t* dims)
-{
-  int32_t err = 0;
-  // Sets up for Gray Scale or RGB or RGBA arrays
-  int32_t nComp = m_ColorsPtr.lock()->getNumberOfComponents();
-
-  QString path = (m_OutputPath) + QDir::separator() + (m_ImagePrefix) + QString::number(slice);
-
-  if (!m_FilePrefix)
+  IDataArray::Pointer colors = m_ColorsPtr.lock();
+  if (TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(colors))
   {
-    path = (m_OutputPath) + QDir::separator() + QString::number(slice);
+    writePlanes<uint8_t>(this, colors, dims, planes, (m_ImageFormat == TifImageType && m_CompressTiff));
   }
-  if (m_ImageFormat == TifImageType)
+  else if (TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(colors))
   {
-    path.append(".tif");
+    writePlanes<uint16_t>(this, colors, dims, planes, true);
   }
-  else if (m_ImageFormat == BmpImageType)
-  {
-    path.append(".bmp");
-  }
-  else if (m_ImageFormat == PngImageType)
-  {
-    path.append(".png");
-  }
-
-  path = QDir::toNativeSeparators(path);
-  QFileInfo fi(path);
-  QDir parent(fi.absolutePath());
-  if (parent.exists() == false)
-  {
-    parent.mkpath(fi.absolutePath());
-  }
-
-  int32_t index = 0;
-  size_t total = dB * dA * 4; // The '4' is there because QImage will convert it to RGBA image.
-  if(total > std::numeric_limits<int32_t>::max())
-  {
-    QString ss = QObject::tr("The image will have more than 2GB worth of pixels. Try cropping the data so that the total pixels on a single plane is less than 2GB.");
-    setErrorCondition(-1012);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-    return getErrorCondition();
-  }
-
-
-  QImage image(dB, dA, QImage::Format_RGB32);
-  if(image.isNull())
+  else if (TemplateHelpers::CanDynamicCast<FloatArrayType>()(colors))
   {
-    QString ss = QObject::tr("The memory for the image could not be allocated using a QImage. The total number of bytes would be greater than 2GB");
-    setErrorCondition(-1014);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-    return getErrorCondition();
+    writePlanes<float>(this, colors, dims, planes, true);
   }
+  if (getErrorCondition() < 0 || getCancel() == true) { return; }
 
-  for (size_t axisA = 0; axisA < dA; ++axisA)
-  {
-    uint8_t* scanLine = image.scanLine(axisA);
-    for (size_t axisB = 0; axisB < dB; ++axisB)
-    {
-#if defined (CMP_WORDS_BIGENDIAN)
-#error
-#else
-      scanLine[axisB * 4 + 3] = 0xFF;
-      if (0 == m_Plane)  // XY plane
-      {
-        index = (nComp * dims[0] * dims[1] * slice) + (nComp * dims[0] * axisA) + (nComp * axisB);
-      }
-      if (1 == m_Plane)  // XZ plane
-      {
-        index = (nComp * dims[0] * dims[1] * axisA) + (nComp * dims[0] * slice) + (nComp * axisB);
-      }
-      if (2 == m_Plane)  // YZ plane
-      {
-        index = (nComp * dims[0] * dims[1] * axisA) + (nComp * dims[0] * axisB) + (nComp * slice);
-      }
-      scanLine[axisB * 4 + 2] = m_Colors[index + 0];
-      scanLine[axisB * 4 + 1] = m_Colors[index + 1];
-      scanLine[axisB * 4 + 0] = m_Colors[index + 2];
-#endif
-    }
-  }
-  image.setText("Description", SIMPLib::Version::PackageComplete());
-  bool success = image.save(path);
-  if (success)
-  {
-    err = 0;
-  }
-  else
-  {
-    err = -1;
-    QString ss = QObject::tr("The image '%1' was not successfully saved").arg(path);
-    setErrorCondition(-1007);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-  }
-  return err;
+  notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t WriteImages::writeGrayscaleImage(size_t slice, size_t dB, size_t dA, size_t* dims)
+QString WriteImages::generateImagePath(int plane, size_t slice)
 {
-  int32_t err = 0;
-
-  QString path = (m_OutputPath) + QDir::separator() + (m_ImagePrefix) + QString::number(slice);
+  QString folder = m_OutputPath;
+  if (AllPlanes == m_Plane)
+  {
+    const char* planeNames[3] = { "XY", "XZ", "YZ" };
+    folder = folder + QDir::separator() + planeNames[plane];
+  }
 
+  QString path = folder + QDir::separator() + (m_ImagePrefix) + QString::number(slice);
   if (!m_FilePrefix)
   {
-    path = (m_OutputPath) + QDir::separator() + QString::number(slice);
+    path = folder + QDir::separator() + QString::number(slice);
   }
   if (m_ImageFormat == TifImageType)
   {
@@ -470,73 +615,7 @@ int32_t WriteImages::writeGrayscaleImage(size_t slice, size_t dB, size_t dA, siz
   {
     path.append(".png");
   }
-
-  path = QDir::toNativeSeparators(path);
-  QFileInfo fi(path);
-  QDir parent(fi.absolutePath());
-  if (parent.exists() == false)
-  {
-    parent.mkpath(fi.absolutePath());
-  }
-
-  int32_t index = 0;
-  size_t total = dB * dA;
-  if(total > std::numeric_limits<int32_t>::max())
-  {
-    QString ss = QObject::tr("The image will have more than 2GB worth of pixels. Try cropping the data so that the total pixels on a single plane is less than 2GB.");
-    setErrorCondition(-1012);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-    return getErrorCondition();
-  }
-
-
-  QImage image(dB, dA, QImage::Format_Grayscale8);
-  if(image.isNull())
-  {
-    QString ss = QObject::tr("The memory for the image could not be allocated using a QImage. The total number of bytes would be greater than 2GB");
-    setErrorCondition(-1014);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-    return getErrorCondition();
-  }
-
-  for (size_t axisA = 0; axisA < dA; ++axisA)
-  {
-    uint8_t* scanLine = image.scanLine(axisA);
-    for (size_t axisB = 0; axisB < dB; ++axisB)
-    {
-#if defined (CMP_WORDS_BIGENDIAN)
-#error
-#else
-      if (0 == m_Plane)  // XY plane
-      {
-        index = (dims[0] * dims[1] * slice) + (dims[0] * axisA) + axisB;
-      }
-      if (1 == m_Plane)  // XZ plane
-      {
-        index = (dims[0] * dims[1] * axisA) + (dims[0] * slice) + axisB;
-      }
-      if (2 == m_Plane)  // YZ plane
-      {
-        index = (dims[0] * dims[1] * axisA) + (dims[0] * axisB) + slice;
-      }
-      scanLine[axisB] = m_Colors[index];
-#endif
-    }
-  }
-  image.setText("Description", SIMPLib::Version::PackageComplete());
-  bool success = image.save(path);
-  if (success)
-  {
-    err = 0;
-  }
-  else
-  {
-    err = -1;
-    QString ss = QObject::tr("The image '%1' was not successfully saved").arg(path);
-    setErrorCondition(-1007);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-  }
-  return err;
+  return QDir::toNativeSeparators(path);
 }
 
 // -----------------------------------------------------------------------------
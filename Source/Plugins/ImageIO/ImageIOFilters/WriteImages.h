@@ -72,6 +72,12 @@ class WriteImages : public AbstractFilter
     SIMPL_FILTER_PARAMETER(DataArrayPath, ColorsArrayPath)
     Q_PROPERTY(DataArrayPath ColorsArrayPath READ getColorsArrayPath WRITE setColorsArrayPath)
 
+    SIMPL_FILTER_PARAMETER(bool, CompressTiff)
+    Q_PROPERTY(bool CompressTiff READ getCompressTiff WRITE setCompressTiff)
+
+    SIMPL_FILTER_PARAMETER(int, NumWriterThreads)
+    Q_PROPERTY(int NumWriterThreads READ getNumWriterThreads WRITE setNumWriterThreads)
+
     enum ImageFormatType
     {
       TifImageType = 0,
@@ -80,6 +86,14 @@ class WriteImages : public AbstractFilter
       JpgImageType = 3
     };
 
+    enum PlaneType
+    {
+      XYPlane = 0,
+      XZPlane = 1,
+      YZPlane = 2,
+      AllPlanes = 3
+    };
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -145,24 +159,13 @@ class WriteImages : public AbstractFilter
     virtual void preflight();
 
     /**
-     * @brief saveImage Saves the data to an image on the disk
-     * @param slice The axis on which the slicing occurs
-     * @param dA Dimensions of one axis of the plane
-     * @param dB Dimensions of the second axis of the plane
-     * @param dims Array of the 3 dimensions
-     * @return Integer error values
-     */
-    int32_t writeRGBImage(size_t slice, size_t dB, size_t dA, size_t* dims);
-
-    /**
-     * @brief saveImage Saves the data to an image on the disk
-     * @param slice The axis on which the slicing occurs
-     * @param dA Dimensions of one axis of the plane
-     * @param dB Dimensions of the second axis of the plane
-     * @param dims Array of the 3 dimensions
-     * @return Integer error values
+     * @brief generateImagePath Returns the path of the image for a slice. When all
+     * planes are written each plane goes into its own sub folder of the output path.
+     * @param plane One of XYPlane, XZPlane or YZPlane
+     * @param slice Index of the slice along the plane normal
+     * @return
      */
-    int32_t writeGrayscaleImage(size_t slice, size_t dB, size_t dA, size_t* dims);
+    QString generateImagePath(int plane, size_t slice);
 
   signals:
     /**
@@ -201,7 +204,7 @@ class WriteImages : public AbstractFilter
 
 
   private:
-    DEFINE_DATAARRAY_VARIABLE(uint8_t, Colors)
+    DEFINE_IDATAARRAY_VARIABLE(Colors)
 
     WriteImages(const WriteImages&); // Copy Constructor Not Implemented
     void operator=(const WriteImages&); // Operator '=' Not Implemented
@@ -0,0 +1,386 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+#include <QtCore/QTextStream>
+#include <QtGui/QImage>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/RectGridGeom.h"
+
+#include "ImageIOTestFileLocations.h"
+
+
+#define IMPORT_IMAGE_STACK_FILTER_NAME "ImportImageStack"
+
+class ImportImageStackTest
+{
+  public:
+    ImportImageStackTest(){}
+    virtual ~ImportImageStackTest(){}
+    SIMPL_TYPE_MACRO(ImportImageStackTest)
+
+    QList<QString> fileNames;
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      for (int i = 0; i < fileNames.size(); i++)
+      {
+        QFileInfo fi(fileNames.at(i));
+        if (fi.exists())
+        {
+          QFile::remove(fileNames.at(i));
+        }
+      }
+#endif
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Every voxel of the stack holds a different gray value
+    // -----------------------------------------------------------------------------
+    uint8_t StackValue(size_t x, size_t y, size_t z)
+    {
+      return static_cast<uint8_t>(x + 8 * y + 48 * z);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Unevenly spaced bounds so a shifted or stretched selection of them is noticed. All
+    // of them are multiples of 0.25, so they survive the round trip through the text file
+    // -----------------------------------------------------------------------------
+    float StackBound(size_t index, size_t axis)
+    {
+      return static_cast<float>(axis + 1) * static_cast<float>(index) + 0.25f * static_cast<float>(index * index);
+    }
+
+    // -----------------------------------------------------------------------------
+    // An 8 x 6 x 5 stack of 8 bit gray images and the bounds file of all its voxels
+    // -----------------------------------------------------------------------------
+    int WriteTestStack(size_t dims[3])
+    {
+      dims[0] = 8;
+      dims[1] = 6;
+      dims[2] = 5;
+
+      QVector<QRgb> grayTable(256);
+      for (int i = 0; i < 256; i++)
+      {
+        grayTable[i] = qRgb(i, i, i);
+      }
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        QImage image(static_cast<int>(dims[0]), static_cast<int>(dims[1]), QImage::Format_Indexed8);
+        image.setColorTable(grayTable);
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          uint8_t* line = image.scanLine(static_cast<int>(y));
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            line[x] = StackValue(x, y, z);
+          }
+        }
+        QString fileName = UnitTest::TestTempDir + QDir::separator() + "ImportImageStackTest_" + QString::number(z) + ".png";
+        fileNames << fileName;
+        DREAM3D_REQUIRE_EQUAL(image.save(fileName), true)
+      }
+
+      QString boundsName = UnitTest::TestTempDir + QDir::separator() + "ImportImageStackTest_Bounds.txt";
+      fileNames << boundsName;
+      QFile boundsFile(boundsName);
+      DREAM3D_REQUIRE_EQUAL(boundsFile.open(QIODevice::WriteOnly | QIODevice::Text), true)
+      QTextStream out(&boundsFile);
+      out << "# Bounds of every voxel in the ImportImageStackTest stack\n";
+      const char* keywords[3] = { "X_COORDINATES", "Y_COORDINATES", "Z_COORDINATES" };
+      for (size_t axis = 0; axis < 3; axis++)
+      {
+        out << keywords[axis] << " " << (dims[axis] + 1) << "\n";
+        for (size_t i = 0; i <= dims[axis]; i++)
+        {
+          out << StackBound(i, axis) << "\n";
+        }
+      }
+      boundsFile.close();
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    AbstractFilter::Pointer CreateFilter(int geometryType, const int cropMin[3], const int cropMax[3], int factor)
+    {
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(IMPORT_IMAGE_STACK_FILTER_NAME);
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(DataContainerArray::New());
+
+      QVariant var;
+      bool propWasSet = false;
+
+      FileListInfo_t fileListInfo;
+      fileListInfo.InputPath = UnitTest::TestTempDir;
+      fileListInfo.FilePrefix = "ImportImageStackTest_";
+      fileListInfo.FileSuffix = "";
+      fileListInfo.FileExtension = "png";
+      fileListInfo.StartIndex = 0;
+      fileListInfo.EndIndex = 4;
+      fileListInfo.PaddingDigits = 0;
+      fileListInfo.Ordering = 0;
+      var.setValue(fileListInfo);
+      propWasSet = filter->setProperty("InputFileListInfo", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      var.setValue(geometryType);
+      propWasSet = filter->setProperty("GeometryType", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      var.setValue(UnitTest::TestTempDir + QDir::separator() + "ImportImageStackTest_Bounds.txt");
+      propWasSet = filter->setProperty("BoundsFile", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      FloatVec3_t origin;
+      origin.x = 1.0f;
+      origin.y = -2.0f;
+      origin.z = 3.0f;
+      var.setValue(origin);
+      propWasSet = filter->setProperty("Origin", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      FloatVec3_t resolution;
+      resolution.x = 0.5f;
+      resolution.y = 0.25f;
+      resolution.z = 2.0f;
+      var.setValue(resolution);
+      propWasSet = filter->setProperty("Resolution", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      var.setValue(true);
+      propWasSet = filter->setProperty("CropImages", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      IntVec3_t minimum;
+      minimum.x = cropMin[0];
+      minimum.y = cropMin[1];
+      minimum.z = cropMin[2];
+      var.setValue(minimum);
+      propWasSet = filter->setProperty("CropMinimum", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      IntVec3_t maximum;
+      maximum.x = cropMax[0];
+      maximum.y = cropMax[1];
+      maximum.z = cropMax[2];
+      var.setValue(maximum);
+      propWasSet = filter->setProperty("CropMaximum", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      var.setValue(factor);
+      propWasSet = filter->setProperty("DownsampleFactor", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      return filter;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Imports the crop region with the given downsample factor and compares the cell data,
+    // and either the image geometry or the rectilinear grid bounds, with the ones cut
+    // directly out of the full stack
+    // -----------------------------------------------------------------------------
+    int CheckCroppedImport(int geometryType, const int cropMin[3], const int cropMax[3], int factor)
+    {
+      AbstractFilter::Pointer filter = CreateFilter(geometryType, cropMin, cropMax, factor);
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      size_t f = static_cast<size_t>(factor);
+      size_t outDims[3] = { 0, 0, 0 };
+      for (size_t i = 0; i < 3; i++)
+      {
+        outDims[i] = (static_cast<size_t>(cropMax[i] - cropMin[i]) + f) / f;
+      }
+
+      DataContainer::Pointer m = filter->getDataContainerArray()->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+      DREAM3D_REQUIRE_VALID_POINTER(m.get())
+      size_t geomDims[3] = { 0, 0, 0 };
+      if (geometryType == 0)
+      {
+        ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+        DREAM3D_REQUIRE_VALID_POINTER(image.get())
+        image->getDimensions(geomDims);
+        float origin[3] = { 0.0f, 0.0f, 0.0f };
+        float res[3] = { 0.0f, 0.0f, 0.0f };
+        image->getOrigin(origin);
+        image->getResolution(res);
+        const float inputOrigin[3] = { 1.0f, -2.0f, 3.0f };
+        const float inputRes[3] = { 0.5f, 0.25f, 2.0f };
+        for (size_t i = 0; i < 3; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(origin[i], inputOrigin[i] + cropMin[i] * inputRes[i])
+          DREAM3D_REQUIRE_EQUAL(res[i], inputRes[i] * factor)
+        }
+      }
+      else
+      {
+        RectGridGeom::Pointer rectGrid = m->getGeometryAs<RectGridGeom>();
+        DREAM3D_REQUIRE_VALID_POINTER(rectGrid.get())
+        rectGrid->getDimensions(geomDims);
+        FloatArrayType::Pointer bounds[3] = { rectGrid->getXBounds(), rectGrid->getYBounds(), rectGrid->getZBounds() };
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          DREAM3D_REQUIRE_VALID_POINTER(bounds[axis].get())
+          DREAM3D_REQUIRE_EQUAL(bounds[axis]->getNumberOfTuples(), outDims[axis] + 1)
+          for (size_t j = 0; j < outDims[axis]; j++)
+          {
+            DREAM3D_REQUIRE_EQUAL(bounds[axis]->getValue(j), StackBound(cropMin[axis] + j * f, axis))
+          }
+          DREAM3D_REQUIRE_EQUAL(bounds[axis]->getValue(outDims[axis]), StackBound(cropMax[axis] + 1, axis))
+        }
+      }
+      for (size_t i = 0; i < 3; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(geomDims[i], outDims[i])
+      }
+
+      AttributeMatrix::Pointer am = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+      DREAM3D_REQUIRE_VALID_POINTER(am.get())
+      UInt8ArrayType::Pointer data = std::dynamic_pointer_cast<UInt8ArrayType>(am->getAttributeArray(SIMPL::CellData::ImageData));
+      DREAM3D_REQUIRE_VALID_POINTER(data.get())
+      DREAM3D_REQUIRE_EQUAL(data->getNumberOfComponents(), 1)
+      DREAM3D_REQUIRE_EQUAL(data->getNumberOfTuples(), outDims[0] * outDims[1] * outDims[2])
+
+      // Downsampled cells are the rounded mean of their block, clipped at the crop boundary
+      for (size_t oz = 0; oz < outDims[2]; oz++)
+      {
+        for (size_t oy = 0; oy < outDims[1]; oy++)
+        {
+          for (size_t ox = 0; ox < outDims[0]; ox++)
+          {
+            uint32_t sum = 0;
+            uint32_t count = 0;
+            for (size_t z = cropMin[2] + oz * f; z < cropMin[2] + (oz + 1) * f && z <= static_cast<size_t>(cropMax[2]); z++)
+            {
+              for (size_t y = cropMin[1] + oy * f; y < cropMin[1] + (oy + 1) * f && y <= static_cast<size_t>(cropMax[1]); y++)
+              {
+                for (size_t x = cropMin[0] + ox * f; x < cropMin[0] + (ox + 1) * f && x <= static_cast<size_t>(cropMax[0]); x++)
+                {
+                  sum += StackValue(x, y, z);
+                  count++;
+                }
+              }
+            }
+            uint8_t expected = static_cast<uint8_t>((sum + count / 2) / count);
+            DREAM3D_REQUIRE_EQUAL(data->getValue((oz * outDims[1] + oy) * outDims[0] + ox), expected)
+          }
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFilterAvailability()
+    {
+      QString filtName = IMPORT_IMAGE_STACK_FILTER_NAME;
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+      if (NULL == filterFactory.get() )
+      {
+        std::stringstream ss;
+        ss << "The ImportImageStackTest Requires the use of the " << filtName.toStdString() << " filter which is found in the ImageIO Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The bounds file always describes the whole stack, so a cropped rectilinear grid has
+    // to keep the bounds of the cropped voxels instead of rejecting the file
+    // -----------------------------------------------------------------------------
+    int TestCroppedImport()
+    {
+      size_t stackDims[3] = { 0, 0, 0 };
+      DREAM3D_REQUIRE_EQUAL(WriteTestStack(stackDims), EXIT_SUCCESS)
+
+      const int fullMin[3] = { 0, 0, 0 };
+      const int fullMax[3] = { 7, 5, 4 };
+      const int cropMin[3] = { 2, 1, 1 };
+      const int cropMax[3] = { 6, 4, 3 };
+      for (int geometryType = 0; geometryType < 2; geometryType++)
+      {
+        DREAM3D_REQUIRE_EQUAL(CheckCroppedImport(geometryType, fullMin, fullMax, 1), EXIT_SUCCESS)
+        DREAM3D_REQUIRE_EQUAL(CheckCroppedImport(geometryType, cropMin, cropMax, 1), EXIT_SUCCESS)
+        DREAM3D_REQUIRE_EQUAL(CheckCroppedImport(geometryType, cropMin, cropMax, 2), EXIT_SUCCESS)
+      }
+      return EXIT_SUCCESS;
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+      DREAM3D_REGISTER_TEST(TestCroppedImport())
+
+      DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+    }
+
+  private:
+    ImportImageStackTest(const ImportImageStackTest&); // Copy Constructor Not Implemented
+    void operator=(const ImportImageStackTest&); // Operator '=' Not Implemented
+};
@@ -33,6 +33,10 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <string.h>
+
+#include <vector>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -52,6 +56,8 @@
 #include "SIMPLib/Utilities/QMetaObjectUtilities.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "ImageIO/ImageIOFilters/TiffWriter.h"
+
 #include "ImageIOTestFileLocations.h"
 
 
@@ -277,6 +283,217 @@ class WriteImagesTest
       return 1;
     }
 
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int WriteNativeTiffImages()
+    {
+      QString filtName = WRITE_IMAGES_FILTER_NAME;
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+
+      // A 20x10x3 float volume written as compressed float TIFFs for all three planes
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer vdc = DataContainer::New("dc4");
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      vdc->setGeometry(image);
+      size_t dims[3] = { 20, 10, 3 };
+      image->setDimensions(dims);
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = dims[0];
+      tDims[1] = dims[1];
+      tDims[2] = dims[2];
+      QVector<size_t> cDims(1, 1);
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+      FloatArrayType::Pointer data = FloatArrayType::CreateArray(tDims, cDims, "Float Array");
+      for (size_t i = 0; i < data->getNumberOfTuples(); i++)
+      {
+        data->setValue(i, static_cast<float>(i) * 0.5f);
+      }
+      am->addAttributeArray(data->getName(), data);
+      vdc->addAttributeMatrix(am->getName(), am);
+      dca->addDataContainer(vdc);
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+      QVariant var;
+      var.setValue(DataArrayPath("dc4", SIMPL::Defaults::CellAttributeMatrixName, "Float Array"));
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("ColorsArrayPath", var), true)
+      var.setValue(3); // All planes
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("Plane", var), true)
+      var.setValue(2); // png cannot hold float data
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("ImageFormat", var), true)
+      var.setValue(false);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("FilePrefix", var), true)
+      var.setValue(true);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("CompressTiff", var), true)
+      QString outputPath = UnitTest::TestTempDir + QDir::separator() + "WriteImagesTest";
+      var.setValue(outputPath);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("OutputPath", var), true)
+
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -1015)
+
+      var.setValue(0); // tif
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("ImageFormat", var), true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >= , 0)
+
+      QStringList planes;
+      planes << "XY" << "XZ" << "YZ";
+      size_t numSlices[3] = { dims[2], dims[1], dims[0] };
+      for (int p = 0; p < planes.size(); p++)
+      {
+        for (size_t i = 0; i < numSlices[p]; i++)
+        {
+          QString fileName = outputPath + QDir::separator() + planes[p] + QDir::separator() + QString::number(i) + ".tif";
+          fileNames << fileName;
+          QFile file(fileName);
+          DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::ReadOnly), true)
+          QByteArray header = file.read(4);
+          DREAM3D_REQUIRE_EQUAL(header.size(), 4)
+          DREAM3D_REQUIRE_EQUAL(header[2] == 42 || header[3] == 42, true)
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    template<typename T>
+    T readValue(const QByteArray& bytes, size_t offset)
+    {
+      T value = 0;
+      ::memcpy(&value, bytes.constData() + offset, sizeof(T));
+      return value;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Reads the SHORT or LONG values of a tag of the first IFD. TiffWriter writes
+    // in the byte order of the host so the values are read the same way.
+    // -----------------------------------------------------------------------------
+    std::vector<uint32_t> readTag(const QByteArray& bytes, uint16_t tag)
+    {
+      std::vector<uint32_t> values;
+      uint32_t ifd = readValue<uint32_t>(bytes, 4);
+      DREAM3D_REQUIRE_EQUAL(ifd % 2, 0)
+      uint16_t numEntries = readValue<uint16_t>(bytes, ifd);
+      for (uint16_t i = 0; i < numEntries; i++)
+      {
+        size_t entry = ifd + 2 + i * 12;
+        if (readValue<uint16_t>(bytes, entry) != tag) { continue; }
+        uint16_t type = readValue<uint16_t>(bytes, entry + 2);
+        uint32_t count = readValue<uint32_t>(bytes, entry + 4);
+        size_t typeSize = (type == 3) ? 2 : 4;
+        size_t valueOffset = entry + 8;
+        if (count * typeSize > 4)
+        {
+          valueOffset = readValue<uint32_t>(bytes, entry + 8);
+          // Every value outside of the IFD must start on a word boundary
+          DREAM3D_REQUIRE_EQUAL(valueOffset % 2, 0)
+        }
+        for (uint32_t c = 0; c < count; c++)
+        {
+          if (type == 3) { values.push_back(readValue<uint16_t>(bytes, valueOffset + c * 2)); }
+          else { values.push_back(readValue<uint32_t>(bytes, valueOffset + c * 4)); }
+        }
+      }
+      return values;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Writes an 8 bit image with TiffWriter, parses the file back and compares the pixels
+    // -----------------------------------------------------------------------------
+    void TiffRoundTrip(size_t width, size_t height, size_t samplesPerPixel, int compression, const QString& description)
+    {
+      std::vector<uint8_t> pixels(width * height * samplesPerPixel, 0);
+      for (size_t i = 0; i < pixels.size(); i++)
+      {
+        // Runs of equal bytes mixed with literal bytes exercise both PackBits codes
+        pixels[i] = static_cast<uint8_t>(((i / 5) % 3 == 0) ? 7 : (i * 31) % 251);
+      }
+
+      QString fileName = UnitTest::TestTempDir + QDir::separator() + QString("TiffRoundTrip_%1x%2x%3_%4.tif").arg(width).arg(height).arg(samplesPerPixel).arg(compression);
+      fileNames << fileName;
+      int err = TiffWriter::WriteImage(fileName, &(pixels[0]), width, height, samplesPerPixel, 8, TiffWriter::UnsignedIntegerSample, compression, description);
+      DREAM3D_REQUIRE_EQUAL(err, 0)
+
+      QFile file(fileName);
+      DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::ReadOnly), true)
+      QByteArray bytes = file.readAll();
+      DREAM3D_REQUIRED(bytes.size(), >, 8)
+
+      DREAM3D_REQUIRE_EQUAL(readTag(bytes, 256)[0], width)
+      DREAM3D_REQUIRE_EQUAL(readTag(bytes, 257)[0], height)
+      DREAM3D_REQUIRE_EQUAL(readTag(bytes, 258).size(), samplesPerPixel)
+      DREAM3D_REQUIRE_EQUAL(readTag(bytes, 258)[0], 8)
+      DREAM3D_REQUIRE_EQUAL(readTag(bytes, 259)[0], compression)
+      DREAM3D_REQUIRE_EQUAL(readTag(bytes, 277)[0], samplesPerPixel)
+      if (samplesPerPixel == 4)
+      {
+        DREAM3D_REQUIRE_EQUAL(readTag(bytes, 338).size(), 1)
+      }
+
+      std::vector<uint32_t> stripOffsets = readTag(bytes, 273);
+      std::vector<uint32_t> stripByteCounts = readTag(bytes, 279);
+      DREAM3D_REQUIRE_EQUAL(stripOffsets.size(), stripByteCounts.size())
+
+      std::vector<uint8_t> decoded;
+      for (size_t s = 0; s < stripOffsets.size(); s++)
+      {
+        DREAM3D_REQUIRED(static_cast<size_t>(stripOffsets[s]) + stripByteCounts[s], <=, static_cast<size_t>(bytes.size()))
+        const uint8_t* strip = reinterpret_cast<const uint8_t*>(bytes.constData()) + stripOffsets[s];
+        if (compression == TiffWriter::NoCompression)
+        {
+          decoded.insert(decoded.end(), strip, strip + stripByteCounts[s]);
+          continue;
+        }
+        size_t i = 0;
+        while (i < stripByteCounts[s])
+        {
+          int8_t header = static_cast<int8_t>(strip[i++]);
+          if (header >= 0)
+          {
+            decoded.insert(decoded.end(), strip + i, strip + i + header + 1);
+            i += header + 1;
+          }
+          else if (header != -128)
+          {
+            decoded.insert(decoded.end(), static_cast<size_t>(1 - header), strip[i++]);
+          }
+        }
+      }
+
+      DREAM3D_REQUIRE_EQUAL(decoded.size(), pixels.size())
+      for (size_t i = 0; i < pixels.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(decoded[i], pixels[i])
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TiffWriterRoundTrip()
+    {
+      // An odd number of image bytes leaves the values after the strips at an odd
+      // offset and the odd length description moves the next value off the word boundary
+      QString description("An odd description");
+      for (int c = 0; c < 2; c++)
+      {
+        int compression = (c == 0) ? TiffWriter::NoCompression : TiffWriter::PackBitsCompression;
+        TiffRoundTrip(7, 5, 1, compression, description);
+        TiffRoundTrip(20, 10, 1, compression, description);
+        TiffRoundTrip(13, 3, 3, compression, description);
+        TiffRoundTrip(9, 7, 4, compression, description);
+        // More than one strip
+        TiffRoundTrip(301, 257, 1, compression, description);
+      }
+      return EXIT_SUCCESS;
+    }
+
     /**
   * @brief
 */
@@ -286,6 +503,8 @@ class WriteImagesTest
       DREAM3D_REGISTER_TEST( TestFilterAvailability() );
 
       DREAM3D_REGISTER_TEST(WriteImages())
+      DREAM3D_REGISTER_TEST(WriteNativeTiffImages())
+      DREAM3D_REGISTER_TEST(TiffWriterRoundTrip())
 
           DREAM3D_REGISTER_TEST( RemoveTestFiles() )
     }
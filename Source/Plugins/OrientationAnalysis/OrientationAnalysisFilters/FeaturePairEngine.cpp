@@ -0,0 +1,210 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "FeaturePairEngine.h"
+
+#include <algorithm>
+
+/**
+ * @brief The FindReversePairsImpl class looks up the reverse pair of every pair of a
+ * range of Features by searching the row of the neighbor. Rows are short, so a linear
+ * search is cheaper than building any index.
+ */
+class FindReversePairsImpl
+{
+  public:
+    FindReversePairsImpl(const FlatNeighborList<int32_t>& pairs, std::vector<int64_t>& reversePairs) :
+      m_Offsets(pairs.getOffsets()),
+      m_Neighbors(pairs.getValues()),
+      m_ReversePairs(reversePairs)
+    {}
+    virtual ~FindReversePairsImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      size_t numFeatures = m_Offsets.size() - 1;
+      for (size_t i = start; i < end; i++)
+      {
+        for (size_t p = m_Offsets[i]; p < m_Offsets[i + 1]; p++)
+        {
+          int32_t j = m_Neighbors[p];
+          if (j < 0 || static_cast<size_t>(j) >= numFeatures) { continue; }
+          for (size_t q = m_Offsets[j]; q < m_Offsets[j + 1]; q++)
+          {
+            if (m_Neighbors[q] >= 0 && static_cast<size_t>(m_Neighbors[q]) == i)
+            {
+              m_ReversePairs[p] = static_cast<int64_t>(q);
+              break;
+            }
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const std::vector<size_t>& m_Offsets;
+    const std::vector<int32_t>& m_Neighbors;
+    std::vector<int64_t>& m_ReversePairs;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeaturePairEngine::FeaturePairEngine()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeaturePairEngine::~FeaturePairEngine()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeaturePairEngine::setPairs(NeighborList<int32_t>& neighborList)
+{
+  size_t numFeatures = neighborList.getNumberOfTuples();
+  m_Pairs.setNumberOfFeatures(numFeatures);
+  for (size_t i = 1; i < numFeatures; i++)
+  {
+    m_Pairs.setListSize(i, neighborList[i].size());
+  }
+  m_Pairs.allocate();
+  for (size_t i = 1; i < numFeatures; i++)
+  {
+    std::copy(neighborList[i].begin(), neighborList[i].end(), m_Pairs.getList(i));
+  }
+  m_FacePairs.clear();
+
+  findReversePairs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeaturePairEngine::setPairs(const int32_t* faceLabels, size_t numFaces, size_t numFeatures)
+{
+  // Each face contributes both directions of its pair. Packing a pair into one 64 bit
+  // key makes sorting it order the pairs by first and then by second Feature.
+  std::vector<uint64_t> keys;
+  keys.reserve(2 * numFaces);
+  for (size_t f = 0; f < numFaces; f++)
+  {
+    int32_t label0 = faceLabels[2 * f];
+    int32_t label1 = faceLabels[2 * f + 1];
+    if (label0 <= 0 || label1 <= 0) { continue; }
+    keys.push_back((static_cast<uint64_t>(label0) << 32) | static_cast<uint64_t>(label1));
+    keys.push_back((static_cast<uint64_t>(label1) << 32) | static_cast<uint64_t>(label0));
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  m_Pairs.setNumberOfFeatures(numFeatures);
+  for (size_t p = 0; p < keys.size(); p++)
+  {
+    m_Pairs.addToListSize(static_cast<size_t>(keys[p] >> 32));
+  }
+  m_Pairs.allocate();
+  for (size_t p = 0; p < keys.size(); p++)
+  {
+    m_Pairs.append(static_cast<size_t>(keys[p] >> 32), static_cast<int32_t>(keys[p] & 0xFFFFFFFFULL));
+  }
+
+  m_FacePairs.assign(numFaces, -1);
+  for (size_t f = 0; f < numFaces; f++)
+  {
+    int32_t label0 = faceLabels[2 * f];
+    int32_t label1 = faceLabels[2 * f + 1];
+    if (label0 <= 0 || label1 <= 0) { continue; }
+    const int32_t* rowBegin = m_Pairs.getList(label0);
+    const int32_t* rowEnd = rowBegin + m_Pairs.getListSize(label0);
+    m_FacePairs[f] = static_cast<int64_t>(m_Pairs.getListStart(label0) + (std::lower_bound(rowBegin, rowEnd, label1) - rowBegin));
+  }
+
+  findReversePairs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeaturePairEngine::findReversePairs()
+{
+  size_t numFeatures = getNumberOfFeatures();
+  m_ReversePairs.assign(getNumberOfPairs(), -1);
+
+  FindReversePairsImpl impl(m_Pairs, m_ReversePairs);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numFeatures);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeaturePairEngine::copyToNeighborList(const std::vector<float>& values, size_t numComponents, size_t component, NeighborList<float>::Pointer neighborList) const
+{
+  FlatNeighborList<float> lists;
+  lists.copyLayout(m_Pairs);
+  std::vector<float>& flatValues = lists.getValues();
+  for (size_t p = 0; p < flatValues.size(); p++)
+  {
+    flatValues[p] = values[p * numComponents + component];
+  }
+  lists.copyToNeighborList(neighborList);
+}
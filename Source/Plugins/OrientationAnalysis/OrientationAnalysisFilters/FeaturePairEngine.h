@@ -0,0 +1,326 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#ifndef _featurepairengine_h_
+#define _featurepairengine_h_
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+#include "OrientationLib/Utilities/FlatNeighborList.h"
+
+/**
+ * @brief The FeaturePairEngine class evaluates a per pair quantity (misorientation,
+ * slip transmission metrics, c-axis misalignment, ...) over a set of ordered Feature
+ * pairs. The pairs are stored in compressed sparse row form: the pairs whose first
+ * Feature is i are the entries [getRowStart(i), getRowEnd(i)) of one flat array, and
+ * the values are written into flat arrays laid out the same way.
+ *
+ * The pairs are taken either from a Feature neighbor list or from the Feature labels
+ * of the faces of a surface mesh. In the latter case every distinct pair of labels is
+ * stored once per direction, so a quantity is evaluated once per boundary instead of
+ * once per triangle.
+ *
+ * Kernels are evaluated in parallel. A kernel is any type with the method
+ * void operator()(int32_t feature, int32_t neighbor, float* values) const
+ * that writes its components for the pair (feature, neighbor). When the quantity does
+ * not depend on the order of the pair, evaluate() can compute it once per unordered
+ * pair and copy it into the reversed entry.
+ */
+class FeaturePairEngine
+{
+  public:
+    FeaturePairEngine();
+    virtual ~FeaturePairEngine();
+
+    /**
+     * @brief setPairs Takes the pairs from a neighbor list: the row of Feature i holds
+     * (i, neighborList[i][j]) for every j, in the order of the list. Feature 0 gets an
+     * empty row.
+     */
+    void setPairs(NeighborList<int32_t>& neighborList);
+
+    /**
+     * @brief setPairs Takes the pairs from the Feature labels of a surface mesh, two per
+     * face. Faces with a label that is not positive are skipped. Rows are sorted by the
+     * second Feature.
+     * @param faceLabels Two labels per face
+     * @param numFaces Number of faces
+     * @param numFeatures Number of Features including Feature 0; every label must be smaller
+     */
+    void setPairs(const int32_t* faceLabels, size_t numFaces, size_t numFeatures);
+
+    size_t getNumberOfFeatures() const { return m_Pairs.getNumberOfFeatures(); }
+    size_t getNumberOfPairs() const { return m_Pairs.getNumberOfValues(); }
+
+    size_t getRowStart(size_t feature) const { return m_Pairs.getListStart(feature); }
+    size_t getRowEnd(size_t feature) const { return m_Pairs.getListEnd(feature); }
+
+    /**
+     * @brief getNeighbor Returns the second Feature of the given pair
+     */
+    int32_t getNeighbor(size_t pair) const { return m_Pairs.getValues()[pair]; }
+
+    /**
+     * @brief getFacePair Returns the pair (label 0, label 1) of the given face, or -1 if
+     * the face was skipped. The reversed pair is getReversePair() of the result.
+     * Only available after the pairs were taken from face labels.
+     */
+    int64_t getFacePair(size_t face) const { return m_FacePairs[face]; }
+
+    /**
+     * @brief getReversePair Returns the pair (neighbor, feature) of the given pair
+     * (feature, neighbor), or -1 if there is no such pair
+     */
+    int64_t getReversePair(size_t pair) const { return m_ReversePairs[pair]; }
+
+    /**
+     * @brief evaluate Runs the kernel over all pairs
+     * @param kernel See the class description
+     * @param numComponents Number of values the kernel writes per pair
+     * @param symmetric If true the kernel is only run for one direction of each pair
+     * that is stored both ways and the values are copied to the other direction
+     * @param values Resized to numComponents values per pair
+     */
+    template<typename Kernel>
+    void evaluate(const Kernel& kernel, size_t numComponents, bool symmetric, std::vector<float>& values) const
+    {
+      values.resize(getNumberOfPairs() * numComponents);
+      if (values.empty()) { return; }
+      size_t numFeatures = getNumberOfFeatures();
+
+      EvaluateImpl<Kernel> impl(this, kernel, numComponents, symmetric, &(values.front()));
+      MirrorImpl mirror(this, numComponents, &(values.front()));
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), impl, tbb::auto_partitioner());
+        if (symmetric == true) { tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), mirror, tbb::auto_partitioner()); }
+      }
+      else
+#endif
+      {
+        impl.convert(0, numFeatures);
+        if (symmetric == true) { mirror.convert(0, numFeatures); }
+      }
+    }
+
+    /**
+     * @brief copyToNeighborList Copies one component of the values into a NeighborList
+     * with one list per Feature, starting at Feature 1
+     */
+    void copyToNeighborList(const std::vector<float>& values, size_t numComponents, size_t component, NeighborList<float>::Pointer neighborList) const;
+
+  private:
+    FlatNeighborList<int32_t> m_Pairs;
+    std::vector<int64_t> m_ReversePairs;
+    std::vector<int64_t> m_FacePairs;
+
+    /**
+     * @brief findReversePairs Fills m_ReversePairs by searching the row of each
+     * neighbor for the first Feature
+     */
+    void findReversePairs();
+
+    /**
+     * @brief isMirrored Returns true if the values of the pair are copied from its reverse
+     * pair instead of being computed
+     */
+    bool isMirrored(size_t feature, size_t pair) const
+    {
+      return m_ReversePairs[pair] >= 0 && static_cast<size_t>(getNeighbor(pair)) < feature;
+    }
+
+    /**
+     * @brief The EvaluateImpl class runs a kernel over the pairs of a range of Features
+     */
+    template<typename Kernel>
+    class EvaluateImpl
+    {
+      public:
+        EvaluateImpl(const FeaturePairEngine* engine, const Kernel& kernel, size_t numComponents, bool symmetric, float* values) :
+          m_Engine(engine),
+          m_Kernel(kernel),
+          m_NumComponents(numComponents),
+          m_Symmetric(symmetric),
+          m_Values(values)
+        {}
+        virtual ~EvaluateImpl() {}
+
+        void convert(size_t start, size_t end) const
+        {
+          for (size_t i = start; i < end; i++)
+          {
+            for (size_t p = m_Engine->getRowStart(i); p < m_Engine->getRowEnd(i); p++)
+            {
+              if (m_Symmetric == true && m_Engine->isMirrored(i, p) == true) { continue; }
+              m_Kernel(static_cast<int32_t>(i), m_Engine->getNeighbor(p), m_Values + p * m_NumComponents);
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          convert(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        const FeaturePairEngine* m_Engine;
+        const Kernel& m_Kernel;
+        size_t m_NumComponents;
+        bool m_Symmetric;
+        float* m_Values;
+    };
+
+    /**
+     * @brief The MirrorImpl class copies the values of the evaluated pairs into their
+     * reverse pairs
+     */
+    class MirrorImpl
+    {
+      public:
+        MirrorImpl(const FeaturePairEngine* engine, size_t numComponents, float* values) :
+          m_Engine(engine),
+          m_NumComponents(numComponents),
+          m_Values(values)
+        {}
+        virtual ~MirrorImpl() {}
+
+        void convert(size_t start, size_t end) const
+        {
+          for (size_t i = start; i < end; i++)
+          {
+            for (size_t p = m_Engine->getRowStart(i); p < m_Engine->getRowEnd(i); p++)
+            {
+              if (m_Engine->isMirrored(i, p) == false) { continue; }
+              const float* source = m_Values + static_cast<size_t>(m_Engine->getReversePair(p)) * m_NumComponents;
+              float* destination = m_Values + p * m_NumComponents;
+              for (size_t c = 0; c < m_NumComponents; c++)
+              {
+                destination[c] = source[c];
+              }
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          convert(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        const FeaturePairEngine* m_Engine;
+        size_t m_NumComponents;
+        float* m_Values;
+    };
+
+    FeaturePairEngine(const FeaturePairEngine&); // Copy Constructor Not Implemented
+    void operator=(const FeaturePairEngine&); // Operator '=' Not Implemented
+};
+
+/**
+ * @brief The SlipTransmissionKernel class computes the slip transmission metrics of a
+ * Feature pair for a loading direction. The four components are mPrime, F1, F1spt and
+ * F7; they are 0 unless both Features have the same crystal structure and the first
+ * Feature has a phase greater than 0. The metrics depend on the order of the pair.
+ */
+class SlipTransmissionKernel
+{
+  public:
+    SlipTransmissionKernel(QVector<SpaceGroupOps::Pointer>& orientationOps, float* avgQuats, int32_t* featurePhases, uint32_t* crystalStructures, const float loadingDirection[3]) :
+      m_OrientationOps(orientationOps),
+      m_AvgQuats(reinterpret_cast<QuatF*>(avgQuats)),
+      m_FeaturePhases(featurePhases),
+      m_CrystalStructures(crystalStructures)
+    {
+      for (int32_t i = 0; i < 3; i++)
+      {
+        m_LD[i] = loadingDirection[i];
+      }
+    }
+    virtual ~SlipTransmissionKernel() {}
+
+    void operator()(int32_t feature, int32_t neighbor, float* values) const
+    {
+      values[0] = 0.0f;
+      values[1] = 0.0f;
+      values[2] = 0.0f;
+      values[3] = 0.0f;
+      uint32_t xtal = m_CrystalStructures[m_FeaturePhases[feature]];
+      if (xtal == m_CrystalStructures[m_FeaturePhases[neighbor]] && m_FeaturePhases[feature] > 0)
+      {
+        QuatF q1 = QuaternionMathF::New();
+        QuatF q2 = QuaternionMathF::New();
+        QuaternionMathF::Copy(m_AvgQuats[feature], q1);
+        QuaternionMathF::Copy(m_AvgQuats[neighbor], q2);
+        float LD[3] = { m_LD[0], m_LD[1], m_LD[2] };
+        m_OrientationOps[xtal]->getmPrime(q1, q2, LD, values[0]);
+        m_OrientationOps[xtal]->getF1(q1, q2, LD, true, values[1]);
+        m_OrientationOps[xtal]->getF1spt(q1, q2, LD, true, values[2]);
+        m_OrientationOps[xtal]->getF7(q1, q2, LD, true, values[3]);
+      }
+    }
+
+  private:
+    QVector<SpaceGroupOps::Pointer>& m_OrientationOps;
+    QuatF* m_AvgQuats;
+    int32_t* m_FeaturePhases;
+    uint32_t* m_CrystalStructures;
+    float m_LD[3];
+};
+
+#endif /* _featurepairengine_h_ */
@@ -47,6 +47,7 @@
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/FeaturePairEngine.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindBoundaryStrengths.cpp"
@@ -264,11 +265,7 @@ void FindBoundaryStrengths::execute()
 
   size_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-  float mPrime_1 = 0.0f, mPrime_2 = 0.0f, F1_1 = 0.0f, F1_2 = 0.0f, F1spt_1 = 0.0f, F1spt_2 = 0.0f, F7_1 = 0.0f,  F7_2 = 0.0f;
-  int32_t gname1 = 0, gname2 = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  size_t numFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
   float LD[3] = { 0.0f, 0.0f, 0.0f };
 
@@ -277,57 +274,32 @@ void FindBoundaryStrengths::execute()
   LD[2] = m_Loading.z;
   MatrixMath::Normalize3x1(LD);
 
+  // Most triangles share their pair of Features with many others, so the metrics are
+  // evaluated once per distinct pair and direction and then copied to the triangles
+  FeaturePairEngine engine;
+  engine.setPairs(m_SurfaceMeshFaceLabels, numTriangles, numFeatures);
+  std::vector<float> metrics;
+  SlipTransmissionKernel kernel(m_OrientationOps, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, LD);
+  engine.evaluate(kernel, 4, false, metrics);
+
   for (size_t i = 0; i < numTriangles; i++)
   {
-    gname1 = m_SurfaceMeshFaceLabels[i * 2];
-    gname2 = m_SurfaceMeshFaceLabels[i * 2 + 1];
-    if (gname1 > 0 && gname2 > 0)
-    {
-      QuaternionMathF::Copy(avgQuats[gname1], q1);
-      QuaternionMathF::Copy(avgQuats[gname2], q2);
-      if (m_CrystalStructures[m_FeaturePhases[gname1]] == m_CrystalStructures[m_FeaturePhases[gname2]]
-          && m_FeaturePhases[gname1] > 0)
-      {
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getmPrime(q1, q2, LD, mPrime_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getmPrime(q2, q1, LD, mPrime_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1(q1, q2, LD, true, F1_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1(q2, q1, LD, true, F1_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1spt(q1, q2, LD, true, F1spt_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1spt(q2, q1, LD, true, F1spt_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF7(q1, q2, LD, true, F7_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF7(q2, q1, LD, true, F7_2);
-      }
-      else
-      {
-        mPrime_1 = 0.0f;
-        F1_1 = 0.0f;
-        F1spt_1 = 0.0f;
-        F7_1 = 0.0f;
-        mPrime_2 = 0.0f;
-        F1_2 = 0.0f;
-        F1spt_2 = 0.0f;
-        F7_2 = 0.0f;
-      }
-    }
-    else
+    int64_t pair1 = engine.getFacePair(i);
+    const float* metrics_1 = NULL;
+    const float* metrics_2 = NULL;
+    if (pair1 >= 0)
     {
-      mPrime_1 = 0.0f;
-      F1_1 = 0.0f;
-      F1spt_1 = 0.0f;
-      F7_1 = 0.0f;
-      mPrime_2 = 0.0f;
-      F1_2 = 0.0f;
-      F1spt_2 = 0.0f;
-      F7_2 = 0.0f;
+      metrics_1 = &(metrics[4 * pair1]);
+      metrics_2 = &(metrics[4 * engine.getReversePair(pair1)]);
     }
-    m_SurfaceMeshmPrimes[2 * i] = mPrime_1;
-    m_SurfaceMeshmPrimes[2 * i + 1] = mPrime_2;
-    m_SurfaceMeshF1s[2 * i] = F1_1;
-    m_SurfaceMeshF1s[2 * i + 1] = F1_2;
-    m_SurfaceMeshF1spts[2 * i] = F1spt_1;
-    m_SurfaceMeshF1spts[2 * i + 1] = F1spt_2;
-    m_SurfaceMeshF7s[2 * i] = F7_1;
-    m_SurfaceMeshF7s[2 * i + 1] = F7_2;
+    m_SurfaceMeshmPrimes[2 * i] = (NULL != metrics_1) ? metrics_1[0] : 0.0f;
+    m_SurfaceMeshmPrimes[2 * i + 1] = (NULL != metrics_2) ? metrics_2[0] : 0.0f;
+    m_SurfaceMeshF1s[2 * i] = (NULL != metrics_1) ? metrics_1[1] : 0.0f;
+    m_SurfaceMeshF1s[2 * i + 1] = (NULL != metrics_2) ? metrics_2[1] : 0.0f;
+    m_SurfaceMeshF1spts[2 * i] = (NULL != metrics_1) ? metrics_1[2] : 0.0f;
+    m_SurfaceMeshF1spts[2 * i + 1] = (NULL != metrics_2) ? metrics_2[2] : 0.0f;
+    m_SurfaceMeshF7s[2 * i] = (NULL != metrics_1) ? metrics_1[3] : 0.0f;
+    m_SurfaceMeshF7s[2 * i + 1] = (NULL != metrics_2) ? metrics_2[3] : 0.0f;
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
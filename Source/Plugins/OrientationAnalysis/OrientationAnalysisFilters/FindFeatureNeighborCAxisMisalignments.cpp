@@ -48,12 +48,52 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/FeaturePairEngine.h"
 
 #include "EbsdLib/EbsdConstants.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindFeatureNeighborCAxisMisalignments.cpp"
 
+/**
+ * @brief The CAxisMisalignmentKernel class computes the angle in degrees between the
+ * c-axes of a Feature pair, or -100 unless both Features are hexagonal (6/mmm)
+ */
+class CAxisMisalignmentKernel
+{
+  public:
+    CAxisMisalignmentKernel(const float* cAxes, int32_t* featurePhases, uint32_t* crystalStructures) :
+      m_CAxes(cAxes),
+      m_FeaturePhases(featurePhases),
+      m_CrystalStructures(crystalStructures)
+    {}
+    virtual ~CAxisMisalignmentKernel() {}
+
+    void operator()(int32_t feature, int32_t neighbor, float* values) const
+    {
+      uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[feature]];
+      uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighbor]];
+      if (phase1 == phase2 && (phase1 == Ebsd::CrystalStructure::Hexagonal_High) )
+      {
+        float c1[3] = { m_CAxes[3 * feature], m_CAxes[3 * feature + 1], m_CAxes[3 * feature + 2] };
+        float c2[3] = { m_CAxes[3 * neighbor], m_CAxes[3 * neighbor + 1], m_CAxes[3 * neighbor + 2] };
+        float w = GeometryMath::CosThetaBetweenVectors(c1, c2);
+        SIMPLibMath::boundF(w, -1, 1);
+        w = acosf(w);
+        if (w > (SIMPLib::Constants::k_Pi / 2)) { w = SIMPLib::Constants::k_Pi - w; }
+        values[0] = w * SIMPLib::Constants::k_180OverPi;
+      }
+      else
+      {
+        values[0] = -100.0f;
+      }
+    }
+
+  private:
+    const float* m_CAxes;
+    int32_t* m_FeaturePhases;
+    uint32_t* m_CrystalStructures;
+};
 
 
 // -----------------------------------------------------------------------------
@@ -236,93 +276,57 @@ void FindFeatureNeighborCAxisMisalignments::execute()
 
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
-
-  std::vector<std::vector<float> > misalignmentlists;
-
-  float w = 0.0f;
   float g1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float g2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
   float g1t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float g2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float c1[3] = { 0.0f, 0.0f, 0.0f };
-  float c2[3] = { 0.0f, 0.0f, 0.0f };
   float caxis[3] = { 0.0f, 0.0f, 1.0f };
-  size_t hexneighborlistsize = 0;
   QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  uint32_t phase1 = 0, phase2 = 0;
-  size_t nname = 0;
-  misalignmentlists.resize(totalFeatures);
-
+  // The sample direction of each Feature's c-axis is computed once instead of once per neighbor
+  std::vector<float> cAxes(3 * totalFeatures, 0.0f);
   for (size_t i = 1; i < totalFeatures; i++)
   {
     QuaternionMathF::Copy(avgQuats[i], q1);
-    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
     FOrientArrayType om(9);
     FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
     om.toGMatrix(g1);
     // transpose the g matrix so when caxis is multiplied by it
     // it will give the sample direction that the caxis is along
     MatrixMath::Transpose3x3(g1, g1t);
-    MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
+    MatrixMath::Multiply3x3with3x1(g1t, caxis, &(cAxes[3 * i]));
     // normalize so that the dot product can be taken below without
     // dividing by the magnitudes (they would be 1)
-    MatrixMath::Normalize3x1(c1);
-    misalignmentlists[i].resize(neighborlist[i].size(), -1.0f);
-    for (size_t j = 0; j < neighborlist[i].size(); j++)
-    {
-      w = std::numeric_limits<float>::max();
-      nname = neighborlist[i][j];
-      phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      hexneighborlistsize = neighborlist[i].size();
-      if (phase1 == phase2 && (phase1 == Ebsd::CrystalStructure::Hexagonal_High) )
-      {
-        QuaternionMathF::Copy(avgQuats[nname], q2);
-        FOrientTransformsType::qu2om(FOrientArrayType(q2), om);
-        om.toGMatrix(g2);
-        // transpose the g matrix so when caxis is multiplied by it
-        // it will give the sample direction that the caxis is along
-        MatrixMath::Transpose3x3(g2, g2t);
-        MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
-        // normalize so that the dot product can be taken below without
-        // dividing by the magnitudes (they would be 1)
-        MatrixMath::Normalize3x1(c2);
-
-        w = GeometryMath::CosThetaBetweenVectors(c1, c2);
-        SIMPLibMath::boundF(w, -1, 1);
-        w = acosf(w);
-        if (w > (SIMPLib::Constants::k_Pi / 2)) { w = SIMPLib::Constants::k_Pi - w; }
+    MatrixMath::Normalize3x1(&(cAxes[3 * i]));
+  }
 
-        misalignmentlists[i][j] = w * SIMPLib::Constants::k_180OverPi;
-        if (m_FindAvgMisals == true) { m_AvgCAxisMisalignments[i] += misalignmentlists[i][j]; }
-      }
-      else
+  // The misalignment does not depend on the order of the pair, so every boundary
+  // that is listed from both sides is only computed once
+  FeaturePairEngine engine;
+  engine.setPairs(*(m_NeighborList.lock()));
+  std::vector<float> misalignments;
+  CAxisMisalignmentKernel kernel(&(cAxes.front()), m_FeaturePhases, m_CrystalStructures);
+  engine.evaluate(kernel, 1, true, misalignments);
+
+  if (m_FindAvgMisals == true)
+  {
+    for (size_t i = 1; i < totalFeatures; i++)
+    {
+      uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[i]];
+      size_t hexneighborlistsize = 0;
+      for (size_t p = engine.getRowStart(i); p < engine.getRowEnd(i); p++)
       {
-        if (m_FindAvgMisals == true) { hexneighborlistsize--; }
-        misalignmentlists[i][j] = -100.0f;
+        if (phase1 == m_CrystalStructures[m_FeaturePhases[engine.getNeighbor(p)]] && (phase1 == Ebsd::CrystalStructure::Hexagonal_High))
+        {
+          m_AvgCAxisMisalignments[i] += misalignments[p];
+          hexneighborlistsize++;
+        }
       }
-    }
-    if (m_FindAvgMisals == true)
-    {
       if (hexneighborlistsize > 0) { m_AvgCAxisMisalignments[i] /= hexneighborlistsize; }
       else { m_AvgCAxisMisalignments[i] = -100.0f; }
-      hexneighborlistsize = 0;
     }
   }
 
-  for (size_t i = 1; i < totalFeatures; i++)
-  {
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType misaL(new std::vector<float>);
-    misaL->assign(misalignmentlists[i].begin(), misalignmentlists[i].end());
-    m_CAxisMisalignmentList.lock()->setList(static_cast<int32_t>(i), misaL);
-  }
+  engine.copyToNeighborList(misalignments, 1, 0, m_CAxisMisalignmentList.lock());
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
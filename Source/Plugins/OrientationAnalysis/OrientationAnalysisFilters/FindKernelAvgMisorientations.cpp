@@ -35,6 +35,16 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <algorithm>
+#include <set>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -45,6 +55,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 
 #include "EbsdLib/EbsdConstants.h"
@@ -52,6 +64,145 @@
 // Include the MOC generated file for this class
 #include "moc_FindKernelAvgMisorientations.cpp"
 
+/**
+ * @brief The FindKernelAvgMisorientationsImpl class computes the kernel average misorientation
+ * of the cells of a range of planes. Only the cells whose phase has the crystal structure given
+ * as template parameter are visited, so the misorientation of every pair in the kernel is an
+ * inlined LaueOps call instead of a virtual SpaceGroupOps call.
+ */
+template<unsigned int CrystalStructure>
+class FindKernelAvgMisorientationsImpl
+{
+  public:
+    FindKernelAvgMisorientationsImpl(const int32_t* featureIds, const int32_t* cellPhases, const uint32_t* crystalStructures,
+                                     const QuatF* quats, const int64_t dims[3], const IntVec3_t& kernelSize, float* kernelAverageMisorientations) :
+      m_FeatureIds(featureIds),
+      m_CellPhases(cellPhases),
+      m_CrystalStructures(crystalStructures),
+      m_Quats(quats),
+      m_KernelSize(kernelSize),
+      m_KernelAverageMisorientations(kernelAverageMisorientations)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~FindKernelAvgMisorientationsImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      int64_t xPoints = m_Dims[0];
+      int64_t yPoints = m_Dims[1];
+      int64_t zPoints = m_Dims[2];
+      for (int64_t plane = static_cast<int64_t>(start); plane < static_cast<int64_t>(end); plane++)
+      {
+        for (int64_t row = 0; row < yPoints; row++)
+        {
+          for (int64_t col = 0; col < xPoints; col++)
+          {
+            int64_t point = (plane * xPoints * yPoints) + (row * xPoints) + col;
+            if (m_FeatureIds[point] <= 0 || m_CellPhases[point] <= 0) { continue; }
+            if (m_CrystalStructures[m_CellPhases[point]] != CrystalStructure) { continue; }
+
+            float totalmisorientation = 0.0f;
+            int32_t numVoxel = 0;
+            const QuatF& q1 = m_Quats[point];
+            for (int32_t j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
+            {
+              if (plane + j < 0 || plane + j > zPoints - 1) { continue; }
+              int64_t jStride = j * xPoints * yPoints;
+              for (int32_t k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
+              {
+                if (row + k < 0 || row + k > yPoints - 1) { continue; }
+                int64_t kStride = k * xPoints;
+                for (int32_t l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
+                {
+                  if (col + l < 0 || col + l > xPoints - 1) { continue; }
+                  int64_t neighbor = point + jStride + kStride + l;
+                  if (m_FeatureIds[point] == m_FeatureIds[neighbor])
+                  {
+                    float w = LaueOps<CrystalStructure>::getMisorientationAngle(q1, m_Quats[neighbor]);
+                    totalmisorientation = totalmisorientation + w * (180.0f / SIMPLib::Constants::k_Pi);
+                    numVoxel++;
+                  }
+                }
+              }
+            }
+            m_KernelAverageMisorientations[point] = (numVoxel == 0) ? 0.0f : totalmisorientation / (float)numVoxel;
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const int32_t* m_FeatureIds;
+    const int32_t* m_CellPhases;
+    const uint32_t* m_CrystalStructures;
+    const QuatF* m_Quats;
+    int64_t m_Dims[3];
+    IntVec3_t m_KernelSize;
+    float* m_KernelAverageMisorientations;
+};
+
+/**
+ * @brief The FindKernelAvgMisorientationsDispatch class runs FindKernelAvgMisorientationsImpl over
+ * all planes for the Laue class picked by LaueOpsDispatch()
+ */
+class FindKernelAvgMisorientationsDispatch
+{
+  public:
+    FindKernelAvgMisorientationsDispatch(const int32_t* featureIds, const int32_t* cellPhases, const uint32_t* crystalStructures,
+                                         const QuatF* quats, const int64_t dims[3], const IntVec3_t& kernelSize, float* kernelAverageMisorientations) :
+      m_FeatureIds(featureIds),
+      m_CellPhases(cellPhases),
+      m_CrystalStructures(crystalStructures),
+      m_Quats(quats),
+      m_Dims(dims),
+      m_KernelSize(kernelSize),
+      m_KernelAverageMisorientations(kernelAverageMisorientations)
+    {}
+    virtual ~FindKernelAvgMisorientationsDispatch() {}
+
+    template<unsigned int CrystalStructure>
+    void execute()
+    {
+      FindKernelAvgMisorientationsImpl<CrystalStructure> impl(m_FeatureIds, m_CellPhases, m_CrystalStructures, m_Quats, m_Dims, m_KernelSize, m_KernelAverageMisorientations);
+      size_t zPoints = static_cast<size_t>(m_Dims[2]);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, zPoints), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.convert(0, zPoints);
+      }
+    }
+
+  private:
+    const int32_t* m_FeatureIds;
+    const int32_t* m_CellPhases;
+    const uint32_t* m_CrystalStructures;
+    const QuatF* m_Quats;
+    const int64_t* m_Dims;
+    IntVec3_t m_KernelSize;
+    float* m_KernelAverageMisorientations;
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -220,82 +371,32 @@ void FindKernelAvgMisorientations::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  int32_t numVoxel = 0; // number of voxels in the feature...
-  bool good = false;
-
-  float w = 0.0f, totalmisorientation = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = Ebsd::CrystalStructure::UnknownCrystalStructure;
-  uint32_t phase2 = Ebsd::CrystalStructure::UnknownCrystalStructure;
   size_t udims[3] = { 0, 0, 0 };
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
+  int64_t dims[3] =
+  {
+    static_cast<int64_t>(udims[0]),
+    static_cast<int64_t>(udims[1]),
+    static_cast<int64_t>(udims[2]),
+  };
+
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  std::fill(m_KernelAverageMisorientations, m_KernelAverageMisorientations + totalPoints, 0.0f);
+
+  // Each Laue class that occurs gets its own pass over the cells, so the Laue class is
+  // fixed for the whole kernel loop instead of being looked up for every pair
+  std::set<uint32_t> crystalStructures;
+  size_t numPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
+  for (size_t i = 1; i < numPhases; i++)
+  {
+    crystalStructures.insert(m_CrystalStructures[i]);
+  }
 
-  int64_t xPoints = static_cast<int64_t>(udims[0]);
-  int64_t yPoints = static_cast<int64_t>(udims[1]);
-  int64_t zPoints = static_cast<int64_t>(udims[2]);
-  int64_t point = 0;
-  size_t neighbor = 0;
-  int64_t jStride = 0;
-  int64_t kStride = 0;
-
-  for (int64_t col = 0; col < xPoints; col++)
+  FindKernelAvgMisorientationsDispatch dispatch(m_FeatureIds, m_CellPhases, m_CrystalStructures, reinterpret_cast<QuatF*>(m_Quats), dims, m_KernelSize, m_KernelAverageMisorientations);
+  for (std::set<uint32_t>::iterator iter = crystalStructures.begin(); iter != crystalStructures.end(); ++iter)
   {
-    for (int64_t row = 0; row < yPoints; row++)
-    {
-      for (int64_t plane = 0; plane < zPoints; plane++)
-      {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if (m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
-        {
-          totalmisorientation = 0.0f;
-          numVoxel = 0;
-          QuaternionMathF::Copy(quats[point], q1);
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for (int32_t j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for (int32_t k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
-            {
-              kStride = k * xPoints;
-              for (int32_t l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
-              {
-                good = true;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if (plane + j < 0) { good = false; }
-                else if (plane + j > zPoints - 1) { good = false; }
-                else if (row + k < 0) { good = false; }
-                else if (row + k > yPoints - 1) { good = false; }
-                else if (col + l < 0) { good = false; }
-                else if (col + l > xPoints - 1) { good = false; }
-                if (good == true && m_FeatureIds[point] == m_FeatureIds[neighbor])
-                {
-                  w = std::numeric_limits<float>::max();
-                  QuaternionMathF::Copy(quats[neighbor], q2);
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                  w = w * (180.0f / SIMPLib::Constants::k_Pi);
-                  totalmisorientation = totalmisorientation + w;
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if (numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0.0f;
-          }
-        }
-        if (m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
-        {
-          m_KernelAverageMisorientations[point] = 0.0f;
-        }
-      }
-    }
+    if (getCancel() == true) { return; }
+    LaueOpsDispatch(*iter, dispatch);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -45,10 +45,52 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/FeaturePairEngine.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindMisorientations.cpp"
 
+/**
+ * @brief The MisorientationKernel class computes the misorientation angle in degrees of
+ * a Feature pair, or -100 if the Features have different crystal structures
+ */
+class MisorientationKernel
+{
+  public:
+    MisorientationKernel(QVector<SpaceGroupOps::Pointer>& orientationOps, float* avgQuats, int32_t* featurePhases, uint32_t* crystalStructures) :
+      m_OrientationOps(orientationOps),
+      m_AvgQuats(reinterpret_cast<QuatF*>(avgQuats)),
+      m_FeaturePhases(featurePhases),
+      m_CrystalStructures(crystalStructures)
+    {}
+    virtual ~MisorientationKernel() {}
+
+    void operator()(int32_t feature, int32_t neighbor, float* values) const
+    {
+      uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[feature]];
+      uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighbor]];
+      if (phase1 == phase2)
+      {
+        QuatF q1 = QuaternionMathF::New();
+        QuatF q2 = QuaternionMathF::New();
+        QuaternionMathF::Copy(m_AvgQuats[feature], q1);
+        QuaternionMathF::Copy(m_AvgQuats[neighbor], q2);
+        float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+        float w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+        values[0] = w * SIMPLib::Constants::k_180OverPi;
+      }
+      else
+      {
+        values[0] = -100.0f;
+      }
+    }
+
+  private:
+    QVector<SpaceGroupOps::Pointer>& m_OrientationOps;
+    QuatF* m_AvgQuats;
+    int32_t* m_FeaturePhases;
+    uint32_t* m_CrystalStructures;
+};
 
 
 // -----------------------------------------------------------------------------
@@ -232,63 +274,35 @@ void FindMisorientations::execute()
 
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
-
-  std::vector<std::vector<float> > misorientationlists;
+  // The misorientation angle does not depend on the order of the pair, so every
+  // boundary that is listed from both sides is only computed once
+  FeaturePairEngine engine;
+  engine.setPairs(*(m_NeighborList.lock()));
+  std::vector<float> misorientations;
+  MisorientationKernel kernel(m_OrientationOps, m_AvgQuats, m_FeaturePhases, m_CrystalStructures);
+  engine.evaluate(kernel, 1, true, misorientations);
 
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float w = 0.0f;
-  size_t tempMisoList = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  uint32_t phase1 = 0, phase2 = 0;
-  int32_t nname = 0;
-
-  misorientationlists.resize(totalFeatures);
-  for (size_t i = 1; i < totalFeatures; i++)
+  if (m_FindAvgMisors == true)
   {
-    QuaternionMathF::Copy(avgQuats[i], q1);
-    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
-    misorientationlists[i].assign(neighborlist[i].size(), -1.0 );
-    for (size_t j = 0; j < neighborlist[i].size(); j++)
+    for (size_t i = 1; i < totalFeatures; i++)
     {
-      w = std::numeric_limits<float>::max();
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
-      phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      tempMisoList = neighborlist[i].size();
-      if (phase1 == phase2)
-      {
-        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-        misorientationlists[i][j] = w * SIMPLib::Constants::k_180OverPi;
-        if (m_FindAvgMisors == true) { m_AvgMisorientations[i] += misorientationlists[i][j]; }
-      }
-      else
+      uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[i]];
+      size_t tempMisoList = 0;
+      for (size_t p = engine.getRowStart(i); p < engine.getRowEnd(i); p++)
       {
-        if (m_FindAvgMisors == true) { tempMisoList--; }
-        misorientationlists[i][j] = -100.0f;
+        if (phase1 == m_CrystalStructures[m_FeaturePhases[engine.getNeighbor(p)]])
+        {
+          m_AvgMisorientations[i] += misorientations[p];
+          tempMisoList++;
+        }
       }
-    }
-    if (m_FindAvgMisors == true)
-    {
       if (tempMisoList != 0) { m_AvgMisorientations[i] /= tempMisoList; }
       else { m_AvgMisorientations[i] = -100.0f; }
-      tempMisoList = 0;
     }
   }
 
-  for (size_t i = 1; i < totalFeatures; i++)
-  {
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType misoL(new std::vector<float>);
-    misoL->assign(misorientationlists[i].begin(), misorientationlists[i].end());
-    m_MisorientationList.lock()->setList(static_cast<int32_t>(i), misoL);
-  }
+  engine.copyToNeighborList(misorientations, 1, 0, m_MisorientationList.lock());
+
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
@@ -44,6 +44,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/FeaturePairEngine.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindSlipTransmissionMetrics.cpp"
@@ -234,85 +235,19 @@ void FindSlipTransmissionMetrics::execute()
   dataCheck();
   if(getErrorCondition() < 0) { return; }
 
-  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
-
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
-
-  std::vector<std::vector<float> > F1lists;
-  std::vector<std::vector<float> > F1sptlists;
-  std::vector<std::vector<float> > F7lists;
-  std::vector<std::vector<float> > mPrimelists;
-
-  float mprime = 0.0f, F1 = 0.0f, F1spt = 0.0f, F7 = 0.0f;
-  int32_t nname;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
   float LD[3] = { 0.0f, 0.0f, 1.0f };
 
-  F1lists.resize(totalFeatures);
-  F1sptlists.resize(totalFeatures);
-  F7lists.resize(totalFeatures);
-  mPrimelists.resize(totalFeatures);
-
-  for (size_t i = 1; i < totalFeatures; i++)
-  {
-    F1lists[i].assign(neighborlist[i].size(), 0.0f);
-    F1sptlists[i].assign(neighborlist[i].size(), 0.0f);
-    F7lists[i].assign(neighborlist[i].size(), 0.0f);
-    mPrimelists[i].assign(neighborlist[i].size(), 0.0f);
-    for (size_t j = 0; j < neighborlist[i].size(); j++)
-    {
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[i], q1);
-      QuaternionMathF::Copy(avgQuats[nname], q1);
-      if (m_CrystalStructures[m_FeaturePhases[i]] == m_CrystalStructures[m_FeaturePhases[nname]] && m_FeaturePhases[i] > 0)
-      {
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getmPrime(q1, q2, LD, mprime);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1(q1, q2, LD, true, F1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1spt(q1, q2, LD, true, F1spt);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF7(q1, q2, LD, true, F7);
-      }
-      else
-      {
-        mprime = 0.0f;
-        F1 = 0.0f;
-        F1spt = 0.0f;
-        F7 = 0.0f;
-      }
-      mPrimelists[i][j] = mprime;
-      F1lists[i][j] = F1;
-      F1sptlists[i][j] = F1spt;
-      F7lists[i][j] = F7;
-    }
-  }
-
-  for (size_t i = 1; i < totalFeatures; i++)
-  {
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f1L(new std::vector<float>);
-    f1L->assign(F1lists[i].begin(), F1lists[i].end());
-    m_F1List.lock()->setList(static_cast<int32_t>(i), f1L);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f1sptL(new std::vector<float>);
-    f1sptL->assign(F1sptlists[i].begin(), F1sptlists[i].end());
-    m_F1sptList.lock()->setList(static_cast<int32_t>(i), f1sptL);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f7L(new std::vector<float>);
-    f7L->assign(F7lists[i].begin(), F7lists[i].end());
-    m_F7List.lock()->setList(static_cast<int32_t>(i), f7L);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType mPrimeL(new std::vector<float>);
-    mPrimeL->assign(mPrimelists[i].begin(), mPrimelists[i].end());
-    m_mPrimeList.lock()->setList(static_cast<int32_t>(i), mPrimeL);
-  }
+  // The metrics depend on the order of the pair, so both directions are evaluated
+  FeaturePairEngine engine;
+  engine.setPairs(*(m_NeighborList.lock()));
+  std::vector<float> metrics;
+  SlipTransmissionKernel kernel(m_OrientationOps, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, LD);
+  engine.evaluate(kernel, 4, false, metrics);
+
+  engine.copyToNeighborList(metrics, 4, 0, m_mPrimeList.lock());
+  engine.copyToNeighborList(metrics, 4, 1, m_F1List.lock());
+  engine.copyToNeighborList(metrics, 4, 2, m_F1sptList.lock());
+  engine.copyToNeighborList(metrics, 4, 3, m_F7List.lock());
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
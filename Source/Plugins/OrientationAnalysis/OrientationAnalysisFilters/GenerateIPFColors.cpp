@@ -54,6 +54,7 @@
 #include "SIMPLib/Utilities/ColorTable.h"
 
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 
@@ -80,10 +81,9 @@ class GenerateIPFColorsImpl
 
     void convert(size_t start, size_t end) const
     {
-      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
-      double refDir[3] = {m_ReferenceDir.x, m_ReferenceDir.y, m_ReferenceDir.z};
-      double dEuler[3] = {0.0, 0.0, 0.0};
-      SIMPL::Rgb argb = 0x00000000;
+      // The colors are computed in batches of cells that share a Laue class
+      LaueIPFColorBatch batch;
+      float refDir[3] = {m_ReferenceDir.x, m_ReferenceDir.y, m_ReferenceDir.z};
       int32_t phase = 0;
       bool calcIPF = false;
       size_t index = 0;
@@ -94,9 +94,6 @@ class GenerateIPFColorsImpl
         m_CellIPFColors[index] = 0;
         m_CellIPFColors[index + 1] = 0;
         m_CellIPFColors[index + 2] = 0;
-        dEuler[0] = m_CellEulerAngles[index];
-        dEuler[1] = m_CellEulerAngles[index + 1];
-        dEuler[2] = m_CellEulerAngles[index + 2];
 
         // Make sure we are using a valid Euler Angles with valid crystal symmetry
         calcIPF = true;
@@ -104,12 +101,10 @@ class GenerateIPFColorsImpl
 
         if (calcIPF && m_CrystalStructures[phase] < Ebsd::CrystalStructure::LaueGroupEnd)
         {
-          argb = ops[m_CrystalStructures[phase]]->generateIPFColor(dEuler, refDir, false);
-          m_CellIPFColors[index] = RgbColor::dRed(argb);
-          m_CellIPFColors[index + 1] = RgbColor::dGreen(argb);
-          m_CellIPFColors[index + 2] = RgbColor::dBlue(argb);
+          batch.add(m_CrystalStructures[phase], m_CellEulerAngles + index, refDir, m_CellIPFColors + index);
         }
       }
+      batch.flush();
     }
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
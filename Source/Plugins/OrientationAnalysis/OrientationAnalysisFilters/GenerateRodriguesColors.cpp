@@ -35,6 +35,14 @@
 
 #include "GenerateRodriguesColors.h"
 
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -47,6 +55,7 @@
 #include "SIMPLib/Utilities/ColorTable.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransformsBatch.hpp"
 #include "OrientationLib/SpaceGroupOps/CubicLowOps.h"
 #include "OrientationLib/SpaceGroupOps/CubicOps.h"
 #include "OrientationLib/SpaceGroupOps/HexagonalLowOps.h"
@@ -64,6 +73,71 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+/**
+ * @brief The GenerateRodriguesColorsImpl class computes the Rodrigues colors of a range of cells. The
+ * Euler angles are converted to Rodrigues vectors a block at a time with OrientationTransformsBatch
+ * instead of one OrientationArray per cell.
+ */
+class GenerateRodriguesColorsImpl
+{
+  public:
+    GenerateRodriguesColorsImpl(float* eulers, int32_t* phases, uint32_t* crystalStructures, bool* goodVoxels, uint8_t* colors) :
+      m_CellEulerAngles(eulers),
+      m_CellPhases(phases),
+      m_CrystalStructures(crystalStructures),
+      m_GoodVoxels(goodVoxels),
+      m_CellRodriguesColors(colors)
+    {}
+    virtual ~GenerateRodriguesColorsImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+      const size_t blockSize = 1024;
+      std::vector<float> rods(blockSize * 4, 0.0f);
+      SIMPL::Rgb argb = 0x00000000;
+      int32_t phase = 0;
+      size_t index = 0;
+      for (size_t b = start; b < end; b += blockSize)
+      {
+        size_t count = (end - b < blockSize) ? (end - b) : blockSize;
+        OrientationTransformsBatch<float>::eu2ro(m_CellEulerAngles + 3 * b, &(rods[0]), count);
+        for (size_t j = 0; j < count; j++)
+        {
+          size_t i = b + j;
+          phase = m_CellPhases[i];
+          index = i * 3;
+          m_CellRodriguesColors[index] = 0;
+          m_CellRodriguesColors[index + 1] = 0;
+          m_CellRodriguesColors[index + 2] = 0;
+
+          // Make sure we are using a valid Euler Angles with valid crystal symmetry
+          if( (NULL == m_GoodVoxels || m_GoodVoxels[i] == true)
+              && m_CrystalStructures[phase] < Ebsd::CrystalStructure::LaueGroupEnd )
+          {
+            argb = ops[m_CrystalStructures[phase]]->generateRodriguesColor(rods[4 * j], rods[4 * j + 1], rods[4 * j + 2]);
+            m_CellRodriguesColors[index] = RgbColor::dRed(argb);
+            m_CellRodriguesColors[index + 1] = RgbColor::dGreen(argb);
+            m_CellRodriguesColors[index + 2] = RgbColor::dBlue(argb);
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  private:
+    float* m_CellEulerAngles;
+    int32_t* m_CellPhases;
+    uint32_t* m_CrystalStructures;
+    bool* m_GoodVoxels;
+    uint8_t* m_CellRodriguesColors;
+};
+
 // Include the MOC generated file for this class
 #include "moc_GenerateRodriguesColors.cpp"
 
@@ -234,53 +308,24 @@ void GenerateRodriguesColors::execute()
   dataCheck();
   if(getErrorCondition() < 0) { return; }
 
-  int64_t totalPoints = m_CellEulerAnglesPtr.lock()->getNumberOfTuples();
+  size_t totalPoints = m_CellEulerAnglesPtr.lock()->getNumberOfTuples();
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  bool missingGoodVoxels = true;
-  if (NULL != m_GoodVoxels)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
   {
-    missingGoodVoxels = false;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints),
+                      GenerateRodriguesColorsImpl(m_CellEulerAngles, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_CellRodriguesColors), tbb::auto_partitioner());
   }
-
-  // Create 1 of every type of Ops class. This condenses the code below
-  QVector<SpaceGroupOps::Pointer> ops;
-  ops.push_back(HexagonalOps::New());
-  ops.push_back(CubicOps::New());
-  ops.push_back(HexagonalLowOps::New());
-  ops.push_back(CubicLowOps::New());
-  ops.push_back(TriclinicOps::New());
-  ops.push_back(MonoclinicOps::New());
-  ops.push_back(OrthoRhombicOps::New());
-  ops.push_back(TetragonalLowOps::New());
-  ops.push_back(TetragonalOps::New());
-  ops.push_back(TrigonalLowOps::New());
-  ops.push_back(TrigonalOps::New());
-
-  int phase;
-  size_t index = 0;
-  SIMPL::Rgb argb = 0x00000000;
-
-  // Write the IPF Coloring Cell Data
-  for (int64_t i = 0; i < totalPoints; i++)
+  else
+#endif
   {
-    phase = m_CellPhases[i];
-    index = i * 3;
-    m_CellRodriguesColors[index] = 0;
-    m_CellRodriguesColors[index + 1] = 0;
-    m_CellRodriguesColors[index + 2] = 0;
-
-    // Make sure we are using a valid Euler Angles with valid crystal symmetry
-    if( (missingGoodVoxels == true || m_GoodVoxels[i] == true)
-        && m_CrystalStructures[phase] < Ebsd::CrystalStructure::LaueGroupEnd )
-    {
-      FOrientArrayType rod(4);
-      FOrientTransformsType::eu2ro( FOrientArrayType( m_CellEulerAngles + index, 3), rod);
-
-      argb = ops[m_CrystalStructures[phase]]->generateRodriguesColor(rod[0], rod[1], rod[2]);
-      m_CellRodriguesColors[index] = RgbColor::dRed(argb);
-      m_CellRodriguesColors[index + 1] = RgbColor::dGreen(argb);
-      m_CellRodriguesColors[index + 2] = RgbColor::dBlue(argb);
-    }
+    GenerateRodriguesColorsImpl serial(m_CellEulerAngles, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_CellRodriguesColors);
+    serial.convert(0, totalPoints);
   }
 
   /* Let the GUI know we are done with this filter */
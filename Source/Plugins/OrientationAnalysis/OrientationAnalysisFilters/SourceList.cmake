@@ -87,6 +87,11 @@ foreach(f ${_PrivateFilters} )
                         ${${PLUGIN_NAME}_SOURCE_DIR}/Documentation/${_filterGroupName}/${f}.md FALSE ${${PLUGIN_NAME}_BINARY_DIR})
 endforeach()
 
+#-------------
+# These are files that need to be compiled into the plugin but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER(${OrientationAnalysis_SOURCE_DIR} ${_filterGroupName} FeaturePairEngine.h)
+ADD_SIMPL_SUPPORT_SOURCE(${OrientationAnalysis_SOURCE_DIR} ${_filterGroupName} FeaturePairEngine.cpp)
+
 
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
@@ -0,0 +1,203 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindMisorientationsTest
+{
+  public:
+    FindMisorientationsTest(){}
+    virtual ~FindMisorientationsTest(){}
+    SIMPL_TYPE_MACRO(FindMisorientationsTest)
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void SetAxisAngle(FloatArrayType::Pointer avgQuats, size_t feature, float x, float y, float z, float degrees)
+    {
+      float norm = std::sqrt(x * x + y * y + z * z);
+      float halfAngle = 0.5f * degrees * SIMPLib::Constants::k_PiOver180;
+      float s = std::sin(halfAngle) / norm;
+      avgQuats->setComponent(feature, 0, x * s);
+      avgQuats->setComponent(feature, 1, y * s);
+      avgQuats->setComponent(feature, 2, z * s);
+      avgQuats->setComponent(feature, 3, std::cos(halfAngle));
+    }
+
+    // -----------------------------------------------------------------------------
+    // Feature 1 sits at the identity and borders Feature 2, a Sigma 3 twin, Feature 3,
+    // turned 45 degrees about [001], and Feature 4, which is hexagonal
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateFeatureData()
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+
+      QVector<size_t> tDims(1, 5);
+      AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+      QVector<size_t> cDims(1, 4);
+      FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(tDims, cDims, SIMPL::FeatureData::AvgQuats, true);
+      SetAxisAngle(avgQuats, 0, 0.0f, 0.0f, 1.0f, 0.0f);
+      SetAxisAngle(avgQuats, 1, 0.0f, 0.0f, 1.0f, 0.0f);
+      SetAxisAngle(avgQuats, 2, 1.0f, 1.0f, 1.0f, 60.0f);
+      SetAxisAngle(avgQuats, 3, 0.0f, 0.0f, 1.0f, 45.0f);
+      SetAxisAngle(avgQuats, 4, 1.0f, 0.0f, 0.0f, 20.0f);
+      featureAttrMat->addAttributeArray(SIMPL::FeatureData::AvgQuats, avgQuats);
+
+      cDims[0] = 1;
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::FeatureData::Phases, true);
+      phases->setValue(0, 0);
+      phases->setValue(1, 1);
+      phases->setValue(2, 1);
+      phases->setValue(3, 1);
+      phases->setValue(4, 2);
+      featureAttrMat->addAttributeArray(SIMPL::FeatureData::Phases, phases);
+
+      int32_t neighbors[5][3] = { { 0, 0, 0 }, { 2, 3, 4 }, { 1, 3, 0 }, { 1, 2, 0 }, { 1, 0, 0 } };
+      size_t numNeighbors[5] = { 0, 3, 2, 2, 1 };
+      NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(5, SIMPL::FeatureData::NeighborList, true);
+      for (size_t i = 0; i < 5; i++)
+      {
+        NeighborList<int32_t>::SharedVectorType list(new std::vector<int32_t>(neighbors[i], neighbors[i] + numNeighbors[i]));
+        neighborList->setList(i, list);
+      }
+      featureAttrMat->addAttributeArray(SIMPL::FeatureData::NeighborList, neighborList);
+      m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+      AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(QVector<size_t>(1, 3), SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::AttributeMatrixType::CellEnsemble);
+      UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, SIMPL::EnsembleData::CrystalStructures);
+      crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+      crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+      crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+      ensembleAttrMat->addAttributeArray(SIMPL::EnsembleData::CrystalStructures, crystalStructures);
+      m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFindMisorientations()
+    {
+      DataContainerArray::Pointer dca = CreateFeatureData();
+
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("FindMisorientations");
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+      QVariant var;
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::NeighborList));
+      bool propWasSet = filter->setProperty("NeighborListArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::AvgQuats));
+      propWasSet = filter->setProperty("AvgQuatsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases));
+      propWasSet = filter->setProperty("FeaturePhasesArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+      propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(true);
+      propWasSet = filter->setProperty("FindAvgMisors", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      NeighborList<float>::Pointer misorientationList = std::dynamic_pointer_cast<NeighborList<float> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::MisorientationList));
+      FloatArrayType::Pointer avgMisorientations = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::AvgMisorientations));
+      DREAM3D_REQUIRE_VALID_POINTER(misorientationList.get());
+      DREAM3D_REQUIRE_VALID_POINTER(avgMisorientations.get());
+
+      // The Sigma 3 twin is 60 degrees off, the [001] turn 45 degrees, and the twin and the
+      // turn 48.83 degrees; pairs across crystal structures get -100
+      float expected[5][3] = { { 0.0f, 0.0f, 0.0f }, { 60.0f, 45.0f, -100.0f }, { 60.0f, 48.83f, 0.0f }, { 45.0f, 48.83f, 0.0f }, { -100.0f, 0.0f, 0.0f } };
+      size_t numNeighbors[5] = { 0, 3, 2, 2, 1 };
+      for (size_t i = 1; i < 5; i++)
+      {
+        std::vector<float>& misorientations = misorientationList->getListReference(i);
+        DREAM3D_REQUIRE_EQUAL(misorientations.size(), numNeighbors[i])
+        for (size_t j = 0; j < numNeighbors[i]; j++)
+        {
+          DREAM3D_REQUIRE(std::fabs(misorientations[j] - expected[i][j]) < 0.1f)
+        }
+      }
+
+      DREAM3D_REQUIRE(std::fabs(avgMisorientations->getValue(1) - 52.5f) < 0.1f)
+      DREAM3D_REQUIRE(std::fabs(avgMisorientations->getValue(2) - 54.415f) < 0.1f)
+      DREAM3D_REQUIRE(std::fabs(avgMisorientations->getValue(3) - 46.915f) < 0.1f)
+      DREAM3D_REQUIRE_EQUAL(avgMisorientations->getValue(4), -100.0f)
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestFindMisorientations() )
+    }
+
+  private:
+    FindMisorientationsTest(const FindMisorientationsTest&); // Copy Constructor Not Implemented
+    void operator=(const FindMisorientationsTest&); // Operator '=' Not Implemented
+};
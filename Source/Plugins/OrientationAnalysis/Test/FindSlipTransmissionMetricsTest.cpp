@@ -0,0 +1,228 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindSlipTransmissionMetricsTest
+{
+  public:
+    FindSlipTransmissionMetricsTest(){}
+    virtual ~FindSlipTransmissionMetricsTest(){}
+    SIMPL_TYPE_MACRO(FindSlipTransmissionMetricsTest)
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void SetAxisAngle(FloatArrayType::Pointer avgQuats, size_t feature, float x, float y, float z, float degrees)
+    {
+      float norm = std::sqrt(x * x + y * y + z * z);
+      float halfAngle = 0.5f * degrees * SIMPLib::Constants::k_PiOver180;
+      float s = std::sin(halfAngle) / norm;
+      avgQuats->setComponent(feature, 0, x * s);
+      avgQuats->setComponent(feature, 1, y * s);
+      avgQuats->setComponent(feature, 2, z * s);
+      avgQuats->setComponent(feature, 3, std::cos(halfAngle));
+    }
+
+    // -----------------------------------------------------------------------------
+    // Features 1 to 3 are cubic and border each other; Features 1 and 3 share their
+    // orientation. Feature 4 is hexagonal and only borders Feature 1.
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateFeatureData()
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+
+      QVector<size_t> tDims(1, 5);
+      AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+      QVector<size_t> cDims(1, 4);
+      FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(tDims, cDims, SIMPL::FeatureData::AvgQuats, true);
+      SetAxisAngle(avgQuats, 0, 0.0f, 0.0f, 1.0f, 0.0f);
+      SetAxisAngle(avgQuats, 1, 1.0f, 2.0f, 3.0f, 20.0f);
+      SetAxisAngle(avgQuats, 2, 3.0f, -1.0f, 2.0f, 35.0f);
+      SetAxisAngle(avgQuats, 3, 1.0f, 2.0f, 3.0f, 20.0f);
+      SetAxisAngle(avgQuats, 4, 0.0f, 1.0f, 0.0f, 50.0f);
+      featureAttrMat->addAttributeArray(SIMPL::FeatureData::AvgQuats, avgQuats);
+
+      cDims[0] = 1;
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::FeatureData::Phases, true);
+      phases->setValue(0, 0);
+      phases->setValue(1, 1);
+      phases->setValue(2, 1);
+      phases->setValue(3, 1);
+      phases->setValue(4, 2);
+      featureAttrMat->addAttributeArray(SIMPL::FeatureData::Phases, phases);
+
+      int32_t neighbors[5][3] = { { 0, 0, 0 }, { 2, 3, 4 }, { 1, 3, 0 }, { 1, 2, 0 }, { 1, 0, 0 } };
+      size_t numNeighbors[5] = { 0, 3, 2, 2, 1 };
+      NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(5, SIMPL::FeatureData::NeighborList, true);
+      for (size_t i = 0; i < 5; i++)
+      {
+        NeighborList<int32_t>::SharedVectorType list(new std::vector<int32_t>(neighbors[i], neighbors[i] + numNeighbors[i]));
+        neighborList->setList(i, list);
+      }
+      featureAttrMat->addAttributeArray(SIMPL::FeatureData::NeighborList, neighborList);
+      m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+      AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(QVector<size_t>(1, 3), SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::AttributeMatrixType::CellEnsemble);
+      UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, SIMPL::EnsembleData::CrystalStructures);
+      crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+      crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+      crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+      ensembleAttrMat->addAttributeArray(SIMPL::EnsembleData::CrystalStructures, crystalStructures);
+      m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFindSlipTransmissionMetrics()
+    {
+      DataContainerArray::Pointer dca = CreateFeatureData();
+
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("FindSlipTransmissionMetrics");
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+      QVariant var;
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::NeighborList));
+      bool propWasSet = filter->setProperty("NeighborListArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::AvgQuats));
+      propWasSet = filter->setProperty("AvgQuatsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases));
+      propWasSet = filter->setProperty("FeaturePhasesArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+      propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      FloatArrayType::Pointer avgQuats = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::AvgQuats));
+      NeighborList<int32_t>::Pointer neighborList = std::dynamic_pointer_cast<NeighborList<int32_t> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::NeighborList));
+      NeighborList<float>::Pointer mPrimeList = std::dynamic_pointer_cast<NeighborList<float> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::mPrimeList));
+      NeighborList<float>::Pointer f1List = std::dynamic_pointer_cast<NeighborList<float> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::F1List));
+      NeighborList<float>::Pointer f1sptList = std::dynamic_pointer_cast<NeighborList<float> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::F1sptList));
+      NeighborList<float>::Pointer f7List = std::dynamic_pointer_cast<NeighborList<float> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::F7List));
+      DREAM3D_REQUIRE_VALID_POINTER(mPrimeList.get());
+      DREAM3D_REQUIRE_VALID_POINTER(f1List.get());
+      DREAM3D_REQUIRE_VALID_POINTER(f1sptList.get());
+      DREAM3D_REQUIRE_VALID_POINTER(f7List.get());
+
+      // The slip systems of two Features with the same orientation line up exactly, while
+      // Features 1 and 2 are far from it. Comparing a Feature with itself, as the filter
+      // once did, would give an mPrime of 1 for every pair.
+      DREAM3D_REQUIRE(std::fabs(mPrimeList->getListReference(1)[1] - 1.0f) < 1.0E-4f)
+      DREAM3D_REQUIRE(std::fabs(mPrimeList->getListReference(3)[0] - 1.0f) < 1.0E-4f)
+      DREAM3D_REQUIRE(mPrimeList->getListReference(1)[0] < 0.5f)
+      DREAM3D_REQUIRE(mPrimeList->getListReference(2)[0] < 0.5f)
+
+      // Every metric is the one of the Feature with its neighbor, in that order
+      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+      QuatF* quats = reinterpret_cast<QuatF*>(avgQuats->getPointer(0));
+      float LD[3] = { 0.0f, 0.0f, 1.0f };
+      for (int32_t i = 1; i < 5; i++)
+      {
+        std::vector<int32_t>& neighbors = neighborList->getListReference(i);
+        DREAM3D_REQUIRE_EQUAL(mPrimeList->getListReference(i).size(), neighbors.size())
+        DREAM3D_REQUIRE_EQUAL(f1List->getListReference(i).size(), neighbors.size())
+        DREAM3D_REQUIRE_EQUAL(f1sptList->getListReference(i).size(), neighbors.size())
+        DREAM3D_REQUIRE_EQUAL(f7List->getListReference(i).size(), neighbors.size())
+        for (size_t j = 0; j < neighbors.size(); j++)
+        {
+          float mPrime = 0.0f, F1 = 0.0f, F1spt = 0.0f, F7 = 0.0f;
+          if (i != 4 && neighbors[j] != 4)
+          {
+            QuatF q1 = quats[i];
+            QuatF q2 = quats[neighbors[j]];
+            ops[Ebsd::CrystalStructure::Cubic_High]->getmPrime(q1, q2, LD, mPrime);
+            ops[Ebsd::CrystalStructure::Cubic_High]->getF1(q1, q2, LD, true, F1);
+            ops[Ebsd::CrystalStructure::Cubic_High]->getF1spt(q1, q2, LD, true, F1spt);
+            ops[Ebsd::CrystalStructure::Cubic_High]->getF7(q1, q2, LD, true, F7);
+          }
+          DREAM3D_REQUIRE(std::fabs(mPrimeList->getListReference(i)[j] - mPrime) < 1.0E-5f)
+          DREAM3D_REQUIRE(std::fabs(f1List->getListReference(i)[j] - F1) < 1.0E-5f)
+          DREAM3D_REQUIRE(std::fabs(f1sptList->getListReference(i)[j] - F1spt) < 1.0E-5f)
+          DREAM3D_REQUIRE(std::fabs(f7List->getListReference(i)[j] - F7) < 1.0E-5f)
+        }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestFindSlipTransmissionMetrics() )
+    }
+
+  private:
+    FindSlipTransmissionMetricsTest(const FindSlipTransmissionMetricsTest&); // Copy Constructor Not Implemented
+    void operator=(const FindSlipTransmissionMetricsTest&); // Operator '=' Not Implemented
+};
@@ -0,0 +1,355 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "ConnectedComponentLabeler.h"
+
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The ConnectedComponentLabelerImpl class labels a range of slabs of rows
+ */
+class ConnectedComponentLabelerImpl
+{
+  public:
+    ConnectedComponentLabelerImpl(ConnectedComponentLabeler* labeler, int64_t rowsPerSlab, int64_t totalRows, const bool* mask, bool value) :
+      m_Labeler(labeler),
+      m_RowsPerSlab(rowsPerSlab),
+      m_TotalRows(totalRows),
+      m_Mask(mask),
+      m_Value(value)
+    {}
+    virtual ~ConnectedComponentLabelerImpl() {}
+
+    void labelSlabs(int64_t start, int64_t end) const
+    {
+      for (int64_t s = start; s < end; s++)
+      {
+        int64_t startRow = s * m_RowsPerSlab;
+        int64_t endRow = std::min(startRow + m_RowsPerSlab, m_TotalRows);
+        m_Labeler->labelRows(startRow, endRow, m_Mask, m_Value);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      labelSlabs(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    ConnectedComponentLabeler* m_Labeler;
+    int64_t m_RowsPerSlab;
+    int64_t m_TotalRows;
+    const bool* m_Mask;
+    bool m_Value;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ConnectedComponentLabeler::ConnectedComponentLabeler(const size_t dims[3], int32_t connectivity, bool sliceBySlice) :
+  m_SliceBySlice(sliceBySlice)
+{
+  for (int32_t d = 0; d < 3; d++)
+  {
+    m_Dims[d] = static_cast<int64_t>(dims[d]);
+  }
+
+  // Keep the neighbors that a raster scan visits before the voxel itself
+  for (int64_t dz = -1; dz <= 0; dz++)
+  {
+    if (m_SliceBySlice == true && dz != 0) { continue; }
+    for (int64_t dy = -1; dy <= 1; dy++)
+    {
+      for (int64_t dx = -1; dx <= 1; dx++)
+      {
+        if (dz == 0 && (dy > 0 || (dy == 0 && dx >= 0))) { continue; }
+        int32_t nonZero = (dx != 0) + (dy != 0) + (dz != 0);
+        if (nonZero == 2 && connectivity < EdgeConnected) { continue; }
+        if (nonZero == 3 && connectivity < CornerConnected) { continue; }
+        m_Offsets.push_back(dx);
+        m_Offsets.push_back(dy);
+        m_Offsets.push_back(dz);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ConnectedComponentLabeler::~ConnectedComponentLabeler()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t ConnectedComponentLabeler::findRoot(int64_t index)
+{
+  // Path halving; parents always have a smaller index than their children
+  while (m_Labels[index] != index)
+  {
+    m_Labels[index] = m_Labels[m_Labels[index]];
+    index = m_Labels[index];
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ConnectedComponentLabeler::unite(int64_t a, int64_t b)
+{
+  int64_t rootA = findRoot(a);
+  int64_t rootB = findRoot(b);
+  if (rootA < rootB)
+  {
+    m_Labels[rootB] = rootA;
+  }
+  else if (rootB < rootA)
+  {
+    m_Labels[rootA] = rootB;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ConnectedComponentLabeler::labelRows(int64_t startRow, int64_t endRow, const bool* mask, bool value)
+{
+  int64_t xp = m_Dims[0];
+  int64_t yp = m_Dims[1];
+  size_t numOffsets = m_Offsets.size() / 3;
+  for (int64_t r = startRow; r < endRow; r++)
+  {
+    int64_t y = r % yp;
+    int64_t z = r / yp;
+    for (int64_t x = 0; x < xp; x++)
+    {
+      int64_t index = r * xp + x;
+      if (mask[index] != value)
+      {
+        m_Labels[index] = -1;
+        continue;
+      }
+      m_Labels[index] = index;
+      for (size_t j = 0; j < numOffsets; j++)
+      {
+        int64_t nx = x + m_Offsets[3 * j];
+        int64_t ny = y + m_Offsets[3 * j + 1];
+        int64_t nz = z + m_Offsets[3 * j + 2];
+        if (nx < 0 || nx >= xp || ny < 0 || ny >= yp || nz < 0) { continue; }
+        int64_t neighborRow = nz * yp + ny;
+        if (neighborRow < startRow) { continue; }
+        int64_t neighbor = neighborRow * xp + nx;
+        if (m_Labels[neighbor] >= 0)
+        {
+          unite(index, neighbor);
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ConnectedComponentLabeler::joinRows(int64_t startRow, int64_t endRow, int64_t boundaryRow, const bool* mask, bool value)
+{
+  int64_t xp = m_Dims[0];
+  int64_t yp = m_Dims[1];
+  size_t numOffsets = m_Offsets.size() / 3;
+  for (int64_t r = startRow; r < endRow; r++)
+  {
+    int64_t y = r % yp;
+    int64_t z = r / yp;
+    for (int64_t x = 0; x < xp; x++)
+    {
+      int64_t index = r * xp + x;
+      if (mask[index] != value) { continue; }
+      for (size_t j = 0; j < numOffsets; j++)
+      {
+        int64_t nx = x + m_Offsets[3 * j];
+        int64_t ny = y + m_Offsets[3 * j + 1];
+        int64_t nz = z + m_Offsets[3 * j + 2];
+        if (nx < 0 || nx >= xp || ny < 0 || ny >= yp || nz < 0) { continue; }
+        int64_t neighborRow = nz * yp + ny;
+        if (neighborRow >= boundaryRow) { continue; }
+        int64_t neighbor = neighborRow * xp + nx;
+        if (m_Labels[neighbor] >= 0)
+        {
+          unite(index, neighbor);
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t ConnectedComponentLabeler::label(const bool* mask, bool value)
+{
+  int64_t totalRows = m_Dims[1] * m_Dims[2];
+  int64_t totalPoints = totalRows * m_Dims[0];
+  m_Labels.resize(totalPoints);
+  m_ComponentSizes.clear();
+  if (totalPoints == 0)
+  {
+    return 0;
+  }
+
+  int64_t numSlabs = 1;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  numSlabs = std::min<int64_t>(4 * tbb::task_scheduler_init::default_num_threads(), totalRows);
+#endif
+  int64_t rowsPerSlab = (totalRows + numSlabs - 1) / numSlabs;
+  numSlabs = (totalRows + rowsPerSlab - 1) / rowsPerSlab;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, numSlabs, 1),
+                      ConnectedComponentLabelerImpl(this, rowsPerSlab, totalRows, mask, value), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    ConnectedComponentLabelerImpl serial(this, rowsPerSlab, totalRows, mask, value);
+    serial.labelSlabs(0, numSlabs);
+  }
+
+  // Join the components across the slab boundaries. Only the first plane (plus one
+  // row) of a slab can reach back into the previous slabs.
+  for (int64_t s = 1; s < numSlabs; s++)
+  {
+    int64_t startRow = s * rowsPerSlab;
+    int64_t endRow = std::min(std::min(startRow + m_Dims[1] + 1, startRow + rowsPerSlab), totalRows);
+    joinRows(startRow, endRow, startRow, mask, value);
+  }
+
+  // Every parent comes before its children so a single forward pass replaces the
+  // parents with consecutive component numbers
+  for (int64_t i = 0; i < totalPoints; i++)
+  {
+    int64_t parent = m_Labels[i];
+    if (parent < 0) { continue; }
+    if (parent == i)
+    {
+      m_Labels[i] = static_cast<int64_t>(m_ComponentSizes.size());
+      m_ComponentSizes.push_back(1);
+    }
+    else
+    {
+      m_Labels[i] = m_Labels[parent];
+      m_ComponentSizes[m_Labels[i]]++;
+    }
+  }
+
+  return static_cast<int64_t>(m_ComponentSizes.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int64_t>& ConnectedComponentLabeler::getLabels() const
+{
+  return m_Labels;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int64_t>& ConnectedComponentLabeler::getComponentSizes() const
+{
+  return m_ComponentSizes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t ConnectedComponentLabeler::getLargestComponent() const
+{
+  int64_t largest = -1;
+  int64_t largestSize = 0;
+  for (size_t c = 0; c < m_ComponentSizes.size(); c++)
+  {
+    if (m_ComponentSizes[c] >= largestSize)
+    {
+      largestSize = m_ComponentSizes[c];
+      largest = static_cast<int64_t>(c);
+    }
+  }
+  return largest;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<bool> ConnectedComponentLabeler::findBoundaryComponents() const
+{
+  std::vector<bool> boundary(m_ComponentSizes.size(), false);
+  int64_t xp = m_Dims[0];
+  int64_t yp = m_Dims[1];
+  int64_t zp = m_Dims[2];
+  for (int64_t z = 0; z < zp; z++)
+  {
+    bool surfacePlane = (m_SliceBySlice == false && (z == 0 || z == zp - 1));
+    for (int64_t y = 0; y < yp; y++)
+    {
+      int64_t rowStart = (z * yp + y) * xp;
+      bool surfaceRow = (surfacePlane == true || y == 0 || y == yp - 1);
+      int64_t step = (surfaceRow == true || xp < 2) ? 1 : xp - 1;
+      for (int64_t x = 0; x < xp; x += step)
+      {
+        int64_t component = m_Labels[rowStart + x];
+        if (component >= 0) { boundary[component] = true; }
+      }
+    }
+  }
+  return boundary;
+}
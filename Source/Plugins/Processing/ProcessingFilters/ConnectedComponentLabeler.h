@@ -0,0 +1,126 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#ifndef _connectedcomponentlabeler_h_
+#define _connectedcomponentlabeler_h_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The ConnectedComponentLabeler class labels the connected regions of the voxels
+ * of an image geometry that carry a given mask value. The volume is split into slabs
+ * of rows that are labeled in parallel with a union-find forest in which every root is
+ * the smallest voxel index of its tree; the few unions that cross a slab boundary are
+ * applied afterwards and a final linear pass turns the forest into consecutive labels.
+ * Components are numbered in the order of their first voxel, which is the order a raster
+ * scan flood fill would discover them in.
+ */
+class ConnectedComponentLabeler
+{
+  public:
+    /**
+     * @brief Voxels sharing a face (6), a face or an edge (18) or any corner (26) are connected
+     */
+    enum Connectivity
+    {
+      FaceConnected = 6,
+      EdgeConnected = 18,
+      CornerConnected = 26
+    };
+
+    /**
+     * @param dims The X, Y, Z dimensions of the image geometry
+     * @param connectivity One of the Connectivity values
+     * @param sliceBySlice If true every Z slice is labeled on its own (2D connectivity)
+     */
+    ConnectedComponentLabeler(const size_t dims[3], int32_t connectivity = FaceConnected, bool sliceBySlice = false);
+    virtual ~ConnectedComponentLabeler();
+
+    /**
+     * @brief label Labels the voxels i where mask[i] == value
+     * @return The number of components that were found
+     */
+    int64_t label(const bool* mask, bool value);
+
+    /**
+     * @brief getLabels Component of every voxel, -1 for voxels that were not labeled
+     */
+    const std::vector<int64_t>& getLabels() const;
+
+    /**
+     * @brief getComponentSizes Number of voxels in each component
+     */
+    const std::vector<int64_t>& getComponentSizes() const;
+
+    /**
+     * @brief getLargestComponent The component with the most voxels. Ties go to the
+     * component found last. Returns -1 if nothing was labeled.
+     */
+    int64_t getLargestComponent() const;
+
+    /**
+     * @brief findBoundaryComponents Flags the components that have a voxel on the outer
+     * surface of the volume. In slice by slice mode only the X and Y edges of each slice
+     * count as the surface.
+     */
+    std::vector<bool> findBoundaryComponents() const;
+
+    /**
+     * @brief labelRows Builds the union-find forest for the rows [startRow, endRow), where
+     * row r covers the voxels of y = r % dimY, z = r / dimY. Neighbors in rows before
+     * startRow are left for label() to join. Used by label() from one or more threads.
+     */
+    void labelRows(int64_t startRow, int64_t endRow, const bool* mask, bool value);
+
+  private:
+    int64_t m_Dims[3];
+    bool m_SliceBySlice;
+    std::vector<int64_t> m_Offsets; // (dx, dy, dz) of the neighbors that come before a voxel
+    std::vector<int64_t> m_Labels;
+    std::vector<int64_t> m_ComponentSizes;
+
+    int64_t findRoot(int64_t index);
+    void unite(int64_t a, int64_t b);
+    void joinRows(int64_t startRow, int64_t endRow, int64_t boundaryRow, const bool* mask, bool value);
+
+    ConnectedComponentLabeler(const ConnectedComponentLabeler&); // Copy Constructor Not Implemented
+    void operator=(const ConnectedComponentLabeler&); // Operator '=' Not Implemented
+};
+
+#endif /* _connectedcomponentlabeler_h_ */
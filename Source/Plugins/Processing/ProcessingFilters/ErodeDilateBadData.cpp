@@ -35,6 +35,13 @@
 
 #include "ErodeDilateBadData.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -47,10 +54,113 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/MorphologyEngine.h"
 
 // Include the MOC generated file for this class
 #include "moc_ErodeDilateBadData.cpp"
 
+/**
+ * @brief The ErodeDilateBadDataImpl class finds the donor of every voxel that changes in
+ * one iteration. The voxels that change in iteration t are the ones at distance t, and
+ * their donors are picked exactly as the iteration would: for an erosion the last bad
+ * neighbor in scan order, for a dilation the first neighbor of the feature that the most
+ * neighbors belong to. The neighbors seen are the ones that changed in an earlier
+ * iteration (or were already there), all of which have their donor resolved.
+ */
+class ErodeDilateBadDataImpl
+{
+  public:
+    ErodeDilateBadDataImpl(const int32_t* featureIds, const int32_t* distances, int32_t* donors, const int64_t* voxels,
+                           const int64_t dims[3], const bool dirOn[3], unsigned int direction, int32_t level) :
+      m_FeatureIds(featureIds),
+      m_Distances(distances),
+      m_Donors(donors),
+      m_Voxels(voxels),
+      m_Direction(direction),
+      m_Level(level)
+    {
+      for (int32_t d = 0; d < 3; d++)
+      {
+        m_Dims[d] = dims[d];
+        m_DirOn[d] = dirOn[d];
+      }
+    }
+    virtual ~ErodeDilateBadDataImpl() {}
+
+    void resolve(int64_t start, int64_t end) const
+    {
+      int64_t neighpoints[6] = { -m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1] };
+      int32_t features[6] = { 0, 0, 0, 0, 0, 0 };
+      int32_t counts[6] = { 0, 0, 0, 0, 0, 0 };
+      for (int64_t v = start; v < end; v++)
+      {
+        int64_t point = m_Voxels[v];
+        int32_t featurename = m_FeatureIds[point];
+        // Voxels that are neither bad nor part of a feature never change
+        if ((m_Direction == 0 && featurename <= 0) || (m_Direction == 1 && featurename != 0)) { continue; }
+
+        int64_t i = point % m_Dims[0];
+        int64_t j = (point / m_Dims[0]) % m_Dims[1];
+        int64_t k = point / (m_Dims[0] * m_Dims[1]);
+        int32_t numFeatures = 0;
+        int32_t most = 0;
+        int64_t donor = -1;
+        for (int32_t l = 0; l < 6; l++)
+        {
+          if (l == 0 && (k == 0 || m_DirOn[2] == false)) { continue; }
+          if (l == 5 && (k == (m_Dims[2] - 1) || m_DirOn[2] == false)) { continue; }
+          if (l == 1 && (j == 0 || m_DirOn[1] == false)) { continue; }
+          if (l == 4 && (j == (m_Dims[1] - 1) || m_DirOn[1] == false)) { continue; }
+          if (l == 2 && (i == 0 || m_DirOn[0] == false)) { continue; }
+          if (l == 3 && (i == (m_Dims[0] - 1) || m_DirOn[0] == false)) { continue; }
+          int64_t neighpoint = point + neighpoints[l];
+          if (m_Distances[neighpoint] >= m_Level) { continue; }
+          int64_t neighborDonor = (m_Distances[neighpoint] == 0) ? neighpoint : m_Donors[neighpoint];
+          if (neighborDonor < 0) { continue; }
+          if (m_Direction == 0)
+          {
+            // Neighbors come in increasing index order, so the last one was scanned last
+            donor = neighborDonor;
+            continue;
+          }
+          int32_t feature = m_FeatureIds[neighborDonor];
+          int32_t f = 0;
+          while (f < numFeatures && features[f] != feature) { f++; }
+          if (f == numFeatures)
+          {
+            features[f] = feature;
+            counts[f] = 0;
+            numFeatures++;
+          }
+          counts[f]++;
+          if (counts[f] > most)
+          {
+            most = counts[f];
+            donor = neighborDonor;
+          }
+        }
+        m_Donors[point] = static_cast<int32_t>(donor);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      resolve(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const int32_t* m_FeatureIds;
+    const int32_t* m_Distances;
+    int32_t* m_Donors;
+    const int64_t* m_Voxels;
+    int64_t m_Dims[3];
+    bool m_DirOn[3];
+    unsigned int m_Direction;
+    int32_t m_Level;
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -209,122 +319,72 @@ void ErodeDilateBadData::execute()
     static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = 0;
+  if (m_NumIterations <= 0 || m_Direction > 1)
+  {
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
 
+  // An erosion spreads the bad voxels into the features, a dilation spreads the features
+  // into the bad voxels. Either way the voxels that change in iteration t are the ones t
+  // steps away from the spreading voxels.
+  BoolArrayType::Pointer spreadingPtr = BoolArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Spreading");
+  bool* spreading = spreadingPtr->getPointer(0);
   for (size_t i = 0; i < totalPoints; i++)
   {
-    featurename = m_FeatureIds[i];
-    if (featurename > numfeatures) { numfeatures = featurename; }
+    spreading[i] = (m_Direction == 0) ? (m_FeatureIds[i] == 0) : (m_FeatureIds[i] > 0);
   }
 
-  int64_t neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
+  Int32ArrayType::Pointer distancesPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Distances");
+  int32_t* distances = distancesPtr->getPointer(0);
 
-  QVector<int32_t> n(numfeatures + 1, 0);
+  MorphologyEngine engine(udims, m_XDirOn, m_YDirOn, m_ZDirOn);
+  engine.computeDistances(spreading, true, m_NumIterations, distances);
+  std::vector<int64_t> voxels;
+  std::vector<int64_t> levelStarts;
+  engine.sortByDistance(distances, m_NumIterations, voxels, levelStarts);
 
-  for (int32_t iteration = 0; iteration < m_NumIterations; iteration++)
+  // m_Neighbors holds the voxel whose tuple each changed voxel ends up with
+  bool dirOn[3] = { m_XDirOn, m_YDirOn, m_ZDirOn };
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  for (int32_t level = 1; level <= m_NumIterations; level++)
   {
-    for (int64_t k = 0; k < dims[2]; k++)
+    int64_t start = levelStarts[level - 1];
+    int64_t end = levelStarts[level];
+    if (start == end) { break; }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
     {
-      kstride = dims[0] * dims[1] * k;
-      for (int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for (int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if (featurename == 0)
-          {
-            current = 0;
-            most = 0;
-            for (int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if (l == 0 && (k == 0 || m_ZDirOn == false)) { good = 0; }
-              else if (l == 5 && (k == (dims[2] - 1) || m_ZDirOn == false)) { good = 0; }
-              else if (l == 1 && (j == 0 || m_YDirOn == false)) { good = 0; }
-              else if (l == 4 && (j == (dims[1] - 1) || m_YDirOn == false)) { good = 0; }
-              else if (l == 2 && (i == 0 || m_XDirOn == false)) { good = 0; }
-              else if (l == 3 && (i == (dims[0] - 1) || m_XDirOn == false)) { good = 0; }
-              if (good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if (m_Direction == 0 && feature > 0)
-                {
-                  m_Neighbors[neighpoint] = count;
-                }
-                if (feature > 0 && m_Direction == 1)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if (current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            if (m_Direction == 1)
-            {
-              for (int32_t l = 0; l < 6; l++)
-              {
-                good = 1;
-                neighpoint = count + neighpoints[l];
-                if (l == 0 && k == 0) { good = 0; }
-                if (l == 5 && k == (dims[2] - 1)) { good = 0; }
-                if (l == 1 && j == 0) { good = 0; }
-                if (l == 4 && j == (dims[1] - 1)) { good = 0; }
-                if (l == 2 && i == 0) { good = 0; }
-                if (l == 3 && i == (dims[0] - 1)) { good = 0; }
-                if (good == 1)
-                {
-                  feature = m_FeatureIds[neighpoint];
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
+      tbb::parallel_for(tbb::blocked_range<int64_t>(start, end),
+                        ErodeDilateBadDataImpl(m_FeatureIds, distances, m_Neighbors, &(voxels.front()), dims, dirOn, m_Direction, level), tbb::auto_partitioner());
     }
+    else
+#endif
+    {
+      ErodeDilateBadDataImpl serial(m_FeatureIds, distances, m_Neighbors, &(voxels.front()), dims, dirOn, m_Direction, level);
+      serial.resolve(start, end);
+    }
+  }
 
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-
-    for (size_t j = 0; j < totalPoints; j++)
+  std::vector<int64_t> changed;
+  std::vector<int64_t> donors;
+  for (size_t v = 0; v < voxels.size(); v++)
+  {
+    int32_t donor = m_Neighbors[voxels[v]];
+    if (donor >= 0)
     {
-      featurename = m_FeatureIds[j];
-      int32_t neighbor = m_Neighbors[j];
-      if (neighbor >= 0)
-      {
-        if ( (featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1)
-             || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
-        {
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-            p->copyTuple(neighbor, j);
-          }
-        }
-      }
+      changed.push_back(voxels[v]);
+      donors.push_back(donor);
     }
   }
 
+  MorphologyEngine::ApplyDonors(m->getAttributeMatrix(m_FeatureIdsArrayPath.getAttributeMatrixName()), changed, donors);
+
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
@@ -46,6 +46,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/MorphologyEngine.h"
 
 // Include the MOC generated file for this class
 #include "moc_ErodeDilateCoordinationNumber.cpp"
@@ -210,8 +211,14 @@ void ErodeDilateCoordinationNumber::execute()
   neighpoints[4] = dims[0];
   neighpoints[5] = dims[0] * dims[1];
 
-  QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  // The sweeps only update a copy of the feature ids and remember where every voxel
+  // gets its tuple from. The cell arrays are copied once at the end.
+  std::vector<int32_t> featureIds(m_FeatureIds, m_FeatureIds + totalPoints);
+  std::vector<int64_t> donors(totalPoints);
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    donors[i] = static_cast<int64_t>(i);
+  }
 
   QVector<int32_t> n(numfeatures + 1, 0);
   QVector<int32_t> coordinationNumber(totalPoints, 0);
@@ -232,7 +239,7 @@ void ErodeDilateCoordinationNumber::execute()
         for (int64_t i = 0; i < dims[0]; i++)
         {
           point = kstride + jstride + i;
-          featurename = m_FeatureIds[point];
+          featurename = featureIds[point];
           coordination = 0;
           current = 0;
           most = 0;
@@ -248,7 +255,7 @@ void ErodeDilateCoordinationNumber::execute()
             if (l == 3 && i == (dims[0] - 1)) { good = 0; }
             if (good == 1)
             {
-              feature = m_FeatureIds[neighpoint];
+              feature = featureIds[neighpoint];
               if ((featurename > 0 && feature == 0) || (featurename == 0 && feature > 0))
               {
                 coordination = coordination + 1;
@@ -266,11 +273,8 @@ void ErodeDilateCoordinationNumber::execute()
           int32_t neighbor = m_Neighbors[point];
           if (coordinationNumber[point] >= m_CoordinationNumber && coordinationNumber[point] > 0)
           {
-            for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-              p->copyTuple(neighbor, point);
-            }
+            featureIds[point] = featureIds[neighbor];
+            donors[point] = donors[neighbor];
           }
           for (int32_t l = 0; l < 6; l++)
           {
@@ -284,7 +288,7 @@ void ErodeDilateCoordinationNumber::execute()
             if (l == 3 && i == (dims[0] - 1)) { good = 0; }
             if (good == 1)
             {
-              feature = m_FeatureIds[neighpoint];
+              feature = featureIds[neighpoint];
               if (feature > 0) { n[feature] = 0; }
             }
           }
@@ -309,6 +313,18 @@ void ErodeDilateCoordinationNumber::execute()
     }
   }
 
+  std::vector<int64_t> changed;
+  std::vector<int64_t> changedDonors;
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    if (donors[i] != static_cast<int64_t>(i))
+    {
+      changed.push_back(static_cast<int64_t>(i));
+      changedDonors.push_back(donors[i]);
+    }
+  }
+  MorphologyEngine::ApplyDonors(m->getAttributeMatrix(m_FeatureIdsArrayPath.getAttributeMatrixName()), changed, changedDonors);
+
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
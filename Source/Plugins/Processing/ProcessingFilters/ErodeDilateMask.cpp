@@ -47,6 +47,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/MorphologyEngine.h"
 
 // Include the MOC generated file for this class
 #include "moc_ErodeDilateMask.cpp"
@@ -64,7 +65,7 @@ ErodeDilateMask::ErodeDilateMask() :
   m_YDirOn(true),
   m_ZDirOn(true),
   m_MaskArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask),
-  m_MaskCopy(NULL),
+  m_Distances(NULL),
   m_Mask(NULL)
 {
   setupFilterParameters();
@@ -145,7 +146,7 @@ int ErodeDilateMask::writeFilterParameters(AbstractFilterParametersWriter* write
 // -----------------------------------------------------------------------------
 void ErodeDilateMask::initialize()
 {
-  m_MaskCopy = nullptr;
+  m_Distances = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -196,79 +197,29 @@ void ErodeDilateMask::execute()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_MaskArrayPath.getDataContainerName());
   size_t totalPoints = m_MaskPtr.lock()->getNumberOfTuples();
 
-  BoolArrayType::Pointer maskCopyPtr = BoolArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_MaskCopy");
-  m_MaskCopy = maskCopyPtr->getPointer(0);
-  maskCopyPtr->initializeWithValue(false);
+  Int32ArrayType::Pointer distancesPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Distances");
+  m_Distances = distancesPtr->getPointer(0);
 
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
 
-  int64_t dims[3] =
-  {
-    static_cast<int64_t>(udims[0]),
-    static_cast<int64_t>(udims[1]),
-    static_cast<int64_t>(udims[2]),
-  };
-
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int64_t neighpoint = 0;
-
-  int64_t neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  for (int32_t iteration = 0; iteration < m_NumIterations; iteration++)
+  // Every iteration grows (shrinks) the mask by one voxel, so after all of them the
+  // mask holds exactly the voxels within NumIterations steps of a true (false) voxel
+  MorphologyEngine engine(udims, m_XDirOn, m_YDirOn, m_ZDirOn);
+  if (m_NumIterations > 0 && m_Direction == 0)
   {
+    engine.computeDistances(m_Mask, true, m_NumIterations, m_Distances);
     for (size_t j = 0; j < totalPoints; j++)
     {
-      m_MaskCopy[j] = m_Mask[j];
-    }
-    for (int64_t k = 0; k < dims[2]; k++)
-    {
-      kstride = dims[0] * dims[1] * k;
-      for (int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for (int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          if (m_Mask[count] == false)
-          {
-            for (int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if (l == 0 && (k == 0 || m_ZDirOn == false)) { good = 0; }
-              else if (l == 5 && (k == (dims[2] - 1) || m_ZDirOn == false)) { good = 0; }
-              else if (l == 1 && (j == 0 || m_YDirOn == false)) { good = 0; }
-              else if (l == 4 && (j == (dims[1] - 1) || m_YDirOn == false)) { good = 0; }
-              else if (l == 2 && (i == 0 || m_XDirOn == false)) { good = 0; }
-              else if (l == 3 && (i == (dims[0] - 1) || m_XDirOn == false)) { good = 0; }
-              if (good == 1)
-              {
-                if (m_Direction == 0 && m_Mask[neighpoint] == true)
-                {
-                  m_MaskCopy[count] = true;
-                }
-                if (m_Direction == 1 && m_Mask[neighpoint] == true)
-                {
-                  m_MaskCopy[neighpoint] = false;
-                }
-              }
-            }
-          }
-        }
-      }
+      m_Mask[j] = (m_Distances[j] <= m_NumIterations);
     }
+  }
+  else if (m_NumIterations > 0 && m_Direction == 1)
+  {
+    engine.computeDistances(m_Mask, false, m_NumIterations, m_Distances);
     for (size_t j = 0; j < totalPoints; j++)
     {
-      m_Mask[j] = m_MaskCopy[j];
+      m_Mask[j] = (m_Distances[j] > m_NumIterations);
     }
   }
 
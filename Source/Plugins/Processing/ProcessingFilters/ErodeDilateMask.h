@@ -173,7 +173,7 @@ class ErodeDilateMask : public AbstractFilter
 
 
   private:
-    bool* m_MaskCopy;
+    int32_t* m_Distances;
 
     DEFINE_DATAARRAY_VARIABLE(bool, Mask)
 
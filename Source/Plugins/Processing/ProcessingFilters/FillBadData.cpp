@@ -47,6 +47,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/ConnectedComponentLabeler.h"
 
 // Include the MOC generated file for this class
 #include "moc_FillBadData.cpp"
@@ -212,9 +213,7 @@ void FillBadData::execute()
   size_t count = 1;
   int32_t good = 1;
   int64_t neighbor;
-  int64_t index = 0;
   float x = 0.0f, y = 0.0f, z = 0.0f;
-  int64_t column = 0, row = 0, plane = 0;
   int64_t neighpoint = 0;
   int32_t featurename = 0, feature = 0;
   size_t numfeatures = 0;
@@ -241,7 +240,6 @@ void FillBadData::execute()
   neighpoints[3] = 1;
   neighpoints[4] = dims[0];
   neighpoints[5] = dims[0] * dims[1];
-  std::vector<int64_t> currentvlist;
 
   for (size_t iter = 0; iter < totalPoints; iter++)
   {
@@ -249,52 +247,21 @@ void FillBadData::execute()
     if (m_FeatureIds[iter] != 0) { m_AlreadyChecked[iter] = true; }
   }
 
+  // Defects at least as big as the minimum size stay bad voxels, the smaller ones get marked (-1) to be filled in below
+  ConnectedComponentLabeler labeler(udims, ConnectedComponentLabeler::FaceConnected);
+  labeler.label(m_AlreadyChecked, false);
+  const std::vector<int64_t>& labels = labeler.getLabels();
+  const std::vector<int64_t>& defectSizes = labeler.getComponentSizes();
   for (size_t i = 0; i < totalPoints; i++)
   {
-    if (m_AlreadyChecked[i] == false && m_FeatureIds[i] == 0)
+    if (labels[i] < 0) { continue; }
+    if (defectSizes[labels[i]] >= m_MinAllowedDefectSize)
     {
-      currentvlist.push_back(static_cast<int64_t>(i));
-      count = 0;
-      while (count < currentvlist.size())
-      {
-        index = currentvlist[count];
-        column = index % dims[0];
-        row = (index / dims[0]) % dims[1];
-        plane = index / (dims[0] * dims[1]);
-        for (int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if (j == 0 && plane == 0) { good = 0; }
-          if (j == 5 && plane == (dims[2] - 1)) { good = 0; }
-          if (j == 1 && row == 0) { good = 0; }
-          if (j == 4 && row == (dims[1] - 1)) { good = 0; }
-          if (j == 2 && column == 0) { good = 0; }
-          if (j == 3 && column == (dims[0] - 1)) { good = 0; }
-          if (good == 1 && m_FeatureIds[neighbor] == 0 && m_AlreadyChecked[neighbor] == false)
-          {
-            currentvlist.push_back(neighbor);
-            m_AlreadyChecked[neighbor] = true;
-          }
-        }
-        count++;
-      }
-      if ((int32_t)currentvlist.size() >= m_MinAllowedDefectSize)
-      {
-        for (size_t k = 0; k < currentvlist.size(); k++)
-        {
-          m_FeatureIds[currentvlist[k]] = 0;
-          if (m_StoreAsNewPhase == true) { m_CellPhases[currentvlist[k]] = maxPhase + 1; }
-        }
-      }
-      if ((int32_t)currentvlist.size() < m_MinAllowedDefectSize)
-      {
-        for (std::vector<int64_t>::size_type k = 0; k < currentvlist.size(); k++)
-        {
-          m_FeatureIds[currentvlist[k]] = -1;
-        }
-      }
-      currentvlist.clear();
+      if (m_StoreAsNewPhase == true) { m_CellPhases[i] = maxPhase + 1; }
+    }
+    else
+    {
+      m_FeatureIds[i] = -1;
     }
   }
 
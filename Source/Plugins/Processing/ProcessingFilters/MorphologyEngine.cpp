@@ -0,0 +1,343 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "MorphologyEngine.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "SIMPLib/Common/TemplateHelpers.hpp"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The DistanceSweepImpl class sweeps a range of lines along one axis
+ */
+class DistanceSweepImpl
+{
+  public:
+    DistanceSweepImpl(const MorphologyEngine* engine, int32_t axis, int32_t cap, int32_t* distances) :
+      m_Engine(engine),
+      m_Axis(axis),
+      m_Cap(cap),
+      m_Distances(distances)
+    {}
+    virtual ~DistanceSweepImpl() {}
+
+    void sweep(int64_t start, int64_t end) const
+    {
+      m_Engine->sweepLines(m_Axis, start, end, m_Cap, m_Distances);
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      sweep(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const MorphologyEngine* m_Engine;
+    int32_t m_Axis;
+    int32_t m_Cap;
+    int32_t* m_Distances;
+};
+
+/**
+ * @brief IsPlainDataArray Returns true for the DataArray<T> types of plain numbers whose
+ * tuples can be moved with memcpy. Other arrays (strings, neighbor lists, ...) only
+ * support copyTuple().
+ */
+static bool IsPlainDataArray(IDataArray::Pointer p)
+{
+  return TemplateHelpers::CanDynamicCast<Int8ArrayType>()(p) || TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(p)
+         || TemplateHelpers::CanDynamicCast<Int16ArrayType>()(p) || TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(p)
+         || TemplateHelpers::CanDynamicCast<Int32ArrayType>()(p) || TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(p)
+         || TemplateHelpers::CanDynamicCast<Int64ArrayType>()(p) || TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(p)
+         || TemplateHelpers::CanDynamicCast<FloatArrayType>()(p) || TemplateHelpers::CanDynamicCast<DoubleArrayType>()(p)
+         || TemplateHelpers::CanDynamicCast<BoolArrayType>()(p);
+}
+
+/**
+ * @brief The DonorCopyImpl class gathers the donor tuples of one plain DataArray into a
+ * buffer or scatters the buffer onto the changed voxels
+ */
+class DonorCopyImpl
+{
+  public:
+    DonorCopyImpl(IDataArray* array, const std::vector<int64_t>& voxels, const std::vector<int64_t>& donors, char* buffer, bool gather) :
+      m_Array(array),
+      m_Voxels(voxels),
+      m_Donors(donors),
+      m_Buffer(buffer),
+      m_Gather(gather)
+    {}
+    virtual ~DonorCopyImpl() {}
+
+    void copy(size_t start, size_t end) const
+    {
+      size_t tupleSize = m_Array->getTypeSize() * static_cast<size_t>(m_Array->getNumberOfComponents());
+      char* data = static_cast<char*>(m_Array->getVoidPointer(0));
+      for (size_t i = start; i < end; i++)
+      {
+        if (m_Gather == true)
+        {
+          ::memcpy(m_Buffer + i * tupleSize, data + static_cast<size_t>(m_Donors[i]) * tupleSize, tupleSize);
+        }
+        else
+        {
+          ::memcpy(data + static_cast<size_t>(m_Voxels[i]) * tupleSize, m_Buffer + i * tupleSize, tupleSize);
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      copy(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    IDataArray* m_Array;
+    const std::vector<int64_t>& m_Voxels;
+    const std::vector<int64_t>& m_Donors;
+    char* m_Buffer;
+    bool m_Gather;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MorphologyEngine::MorphologyEngine(const size_t dims[3], bool xDirOn, bool yDirOn, bool zDirOn)
+{
+  for (int32_t d = 0; d < 3; d++)
+  {
+    m_Dims[d] = static_cast<int64_t>(dims[d]);
+  }
+  m_DirOn[0] = xDirOn;
+  m_DirOn[1] = yDirOn;
+  m_DirOn[2] = zDirOn;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MorphologyEngine::~MorphologyEngine()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MorphologyEngine::sweepLines(int32_t axis, int64_t start, int64_t end, int32_t cap, int32_t* distances) const
+{
+  int64_t xp = m_Dims[0];
+  int64_t yp = m_Dims[1];
+  int64_t zp = m_Dims[2];
+  int64_t planeSize = xp * yp;
+
+  if (axis == 0)
+  {
+    for (int64_t r = start; r < end; r++)
+    {
+      int32_t* d = distances + r * xp;
+      for (int64_t x = 1; x < xp; x++)
+      {
+        d[x] = std::min(d[x], std::min(d[x - 1] + 1, cap));
+      }
+      for (int64_t x = xp - 2; x >= 0; x--)
+      {
+        d[x] = std::min(d[x], std::min(d[x + 1] + 1, cap));
+      }
+    }
+  }
+  else
+  {
+    // Along Y and Z whole rows are swept at once so the inner loop runs over contiguous X
+    int64_t numRows = (axis == 1) ? yp : zp;
+    int64_t rowStride = (axis == 1) ? xp : planeSize;
+    int64_t lineStride = (axis == 1) ? planeSize : xp;
+    for (int64_t line = start; line < end; line++)
+    {
+      int32_t* base = distances + line * lineStride;
+      for (int64_t row = 1; row < numRows; row++)
+      {
+        int32_t* d = base + row * rowStride;
+        const int32_t* prev = d - rowStride;
+        for (int64_t x = 0; x < xp; x++)
+        {
+          d[x] = std::min(d[x], std::min(prev[x] + 1, cap));
+        }
+      }
+      for (int64_t row = numRows - 2; row >= 0; row--)
+      {
+        int32_t* d = base + row * rowStride;
+        const int32_t* next = d + rowStride;
+        for (int64_t x = 0; x < xp; x++)
+        {
+          d[x] = std::min(d[x], std::min(next[x] + 1, cap));
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MorphologyEngine::computeDistances(const bool* mask, bool value, int32_t maxDistance, int32_t* distances) const
+{
+  int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+  int32_t cap = maxDistance + 1;
+  for (int64_t i = 0; i < totalPoints; i++)
+  {
+    distances[i] = (mask[i] == value) ? 0 : cap;
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  for (int32_t axis = 0; axis < 3; axis++)
+  {
+    if (m_DirOn[axis] == false || m_Dims[axis] < 2) { continue; }
+    // X sweeps run along each row, Y sweeps over each slice and Z sweeps down each row index
+    int64_t numLines = (axis == 0) ? m_Dims[1] * m_Dims[2] : ((axis == 1) ? m_Dims[2] : m_Dims[1]);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<int64_t>(0, numLines),
+                        DistanceSweepImpl(this, axis, cap, distances), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      DistanceSweepImpl serial(this, axis, cap, distances);
+      serial.sweep(0, numLines);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MorphologyEngine::sortByDistance(const int32_t* distances, int32_t maxDistance, std::vector<int64_t>& voxels, std::vector<int64_t>& levelStarts) const
+{
+  int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+  levelStarts.assign(maxDistance + 1, 0);
+  for (int64_t i = 0; i < totalPoints; i++)
+  {
+    int32_t d = distances[i];
+    if (d >= 1 && d <= maxDistance) { levelStarts[d]++; }
+  }
+  for (int32_t d = 1; d <= maxDistance; d++)
+  {
+    levelStarts[d] += levelStarts[d - 1];
+  }
+
+  voxels.resize(levelStarts[maxDistance]);
+  std::vector<int64_t> next(levelStarts.begin(), levelStarts.end() - 1);
+  for (int64_t i = 0; i < totalPoints; i++)
+  {
+    int32_t d = distances[i];
+    if (d >= 1 && d <= maxDistance) { voxels[next[d - 1]++] = i; }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MorphologyEngine::ApplyDonors(AttributeMatrix::Pointer attrMat, const std::vector<int64_t>& voxels, const std::vector<int64_t>& donors)
+{
+  if (voxels.empty())
+  {
+    return;
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  QList<QString> arrayNames = attrMat->getAttributeArrayNames();
+  for (QList<QString>::iterator iter = arrayNames.begin(); iter != arrayNames.end(); ++iter)
+  {
+    IDataArray::Pointer p = attrMat->getAttributeArray(*iter);
+    if (IsPlainDataArray(p) == false)
+    {
+      // The array is grown by one tuple per changed voxel to hold the donor tuples while
+      // the changed voxels are overwritten, then shrunk back
+      size_t numTuples = p->getNumberOfTuples();
+      p->resize(numTuples + voxels.size());
+      for (size_t i = 0; i < voxels.size(); i++)
+      {
+        p->copyTuple(static_cast<size_t>(donors[i]), numTuples + i);
+      }
+      for (size_t i = 0; i < voxels.size(); i++)
+      {
+        p->copyTuple(numTuples + i, static_cast<size_t>(voxels[i]));
+      }
+      p->resize(numTuples);
+      continue;
+    }
+    size_t tupleSize = p->getTypeSize() * static_cast<size_t>(p->getNumberOfComponents());
+    std::vector<char> buffer(voxels.size() * tupleSize);
+    for (int32_t pass = 0; pass < 2; pass++)
+    {
+      bool gather = (pass == 0);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, voxels.size()),
+                          DonorCopyImpl(p.get(), voxels, donors, &(buffer.front()), gather), tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        DonorCopyImpl serial(p.get(), voxels, donors, &(buffer.front()), gather);
+        serial.copy(0, voxels.size());
+      }
+    }
+  }
+}
@@ -0,0 +1,107 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#ifndef _morphologyengine_h_
+#define _morphologyengine_h_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+/**
+ * @brief The MorphologyEngine class holds the shared pieces of the ErodeDilate filters.
+ * Instead of running one pass over the volume per iteration, the filters compute the
+ * city block distance of every voxel to a set of source voxels once: n iterations of a
+ * 6 neighbor erosion or dilation change exactly the voxels at distances 1 to n, the ones
+ * at distance d in iteration d. The distance transform is separable, so it is computed with a
+ * forward and a backward sweep along each enabled axis, each sweep running in parallel
+ * over the lines of the volume. Filters that move whole tuples record where each changed
+ * voxel gets its data from (a donor map) and copy every cell array once at the end.
+ */
+class MorphologyEngine
+{
+  public:
+    /**
+     * @param dims The X, Y, Z dimensions of the image geometry
+     * @param xDirOn, yDirOn, zDirOn The axes along which voxels are neighbors
+     */
+    MorphologyEngine(const size_t dims[3], bool xDirOn, bool yDirOn, bool zDirOn);
+    virtual ~MorphologyEngine();
+
+    /**
+     * @brief computeDistances Computes the city block distance, along the enabled axes,
+     * from each voxel to the nearest voxel i with mask[i] == value. Distances larger than
+     * maxDistance (and voxels that cannot reach a source) are stored as maxDistance + 1.
+     * @param distances [output] One value per voxel
+     */
+    void computeDistances(const bool* mask, bool value, int32_t maxDistance, int32_t* distances) const;
+
+    /**
+     * @brief sweepLines Runs the forward and backward sweeps of the distance transform
+     * along one axis over the lines [start, end). For the X axis a line is a row (y, z),
+     * for the Y axis a whole Z slice and for the Z axis a row index y across all of the
+     * slices. Used by computeDistances() from one or more threads.
+     */
+    void sweepLines(int32_t axis, int64_t start, int64_t end, int32_t cap, int32_t* distances) const;
+
+    /**
+     * @brief sortByDistance Lists the voxels with a distance in [1, maxDistance] grouped
+     * by distance, in increasing voxel order within each distance.
+     * @param voxels [output] The voxels
+     * @param levelStarts [output] The voxels at distance d are voxels[levelStarts[d - 1],
+     * levelStarts[d]); holds maxDistance + 1 entries
+     */
+    void sortByDistance(const int32_t* distances, int32_t maxDistance, std::vector<int64_t>& voxels, std::vector<int64_t>& levelStarts) const;
+
+    /**
+     * @brief ApplyDonors Copies, for every i, the tuple at donors[i] onto the tuple at
+     * voxels[i] in every array of the AttributeMatrix. All of the donor tuples are read
+     * before any tuple is written, so a donor may itself be one of the changed voxels.
+     * Arrays that are not plain numeric DataArrays are copied tuple by tuple.
+     */
+    static void ApplyDonors(AttributeMatrix::Pointer attrMat, const std::vector<int64_t>& voxels, const std::vector<int64_t>& donors);
+
+  private:
+    int64_t m_Dims[3];
+    bool m_DirOn[3];
+
+    MorphologyEngine(const MorphologyEngine&); // Copy Constructor Not Implemented
+    void operator=(const MorphologyEngine&); // Operator '=' Not Implemented
+};
+
+#endif /* _morphologyengine_h_ */
@@ -36,7 +36,6 @@
 #include "MultiThresholdObjects.h"
 
 #include "SIMPLib/Common/Constants.h"
-#include "SIMPLib/Common/ThresholdFilterHelper.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
@@ -45,6 +44,7 @@
 #include "SIMPLib/SIMPLibVersion.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/ThresholdExpression.h"
 
 // Include the MOC generated file for this class
 #include "moc_MultiThresholdObjects.cpp"
@@ -224,58 +224,27 @@ void MultiThresholdObjects::execute()
 
   DataContainerArray::Pointer dca = getDataContainerArray();
   DataContainer::Pointer m = dca->getDataContainer(dcName);
+  AttributeMatrix::Pointer attrMat = m->getAttributeMatrix(amName);
 
-  // Prime our output array with the result of the first comparison
+  // All comparisons are ANDed together and evaluated in one pass over the tuples
+  ThresholdExpression expression;
+  int32_t root = -1;
+  for (int32_t i = 0; i < m_SelectedThresholds.size(); ++i)
   {
-    ThresholdFilterHelper filter(static_cast<SIMPL::Comparison::Enumeration>(comp_0.compOperator), comp_0.compValue, m_DestinationPtr.lock().get());
-    // Run the first threshold and store the results in our output array
-    err = filter.execute(m->getAttributeMatrix(amName)->getAttributeArray(comp_0.attributeArrayName).get(), m_DestinationPtr.lock().get());
-    if (err < 0)
+    ComparisonInput_t& compRef = m_SelectedThresholds[i];
+    int32_t node = expression.addComparison(attrMat->getAttributeArray(compRef.attributeArrayName), compRef.compOperator, compRef.compValue);
+    if (node < 0)
     {
-      DataArrayPath tempPath(comp_0.dataContainerName, comp_0.attributeMatrixName, comp_0.attributeArrayName);
-      QString ss = QObject::tr("Error Executing threshold filter on first array. The path is %1").arg(tempPath.serialize());
-      setErrorCondition(-13001);
+      DataArrayPath tempPath(compRef.dataContainerName, compRef.attributeMatrixName, compRef.attributeArrayName);
+      QString ss = QObject::tr("Error Executing threshold filter on array. The path is %1").arg(tempPath.serialize());
+      setErrorCondition(i == 0 ? -13001 : -13002);
       notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
       return;
     }
+    root = (root < 0) ? node : expression.addAnd(root, node);
   }
-
-  if (m_SelectedThresholds.size() > 1)
-  {
-    // Get the total number of tuples, create and initialize an array to use for these results
-    int64_t totalTuples = static_cast<int64_t>(m->getAttributeMatrix(amName)->getNumTuples());
-    BoolArrayType::Pointer currentArrayPtr = BoolArrayType::CreateArray(totalTuples, "_INTERNAL_USE_ONLY_TEMP");
-
-    // Loop on the remaining Comparison objects updating our final result array as we go
-    for (int32_t i = 1; i < m_SelectedThresholds.size(); ++i)
-    {
-      // Initialize the array to false
-      currentArrayPtr->initializeWithZeros();
-      // Get the pointer to the front of the array. Raw Pointers = fast access = NO Bounds Checking!!!
-      bool* currentArray = currentArrayPtr->getPointer(0);
-
-      ComparisonInput_t& compRef = m_SelectedThresholds[i];
-
-      ThresholdFilterHelper filter(static_cast<SIMPL::Comparison::Enumeration>(compRef.compOperator), compRef.compValue, currentArrayPtr.get());
-
-      err = filter.execute(m->getAttributeMatrix(amName)->getAttributeArray(compRef.attributeArrayName).get(), currentArrayPtr.get());
-      if (err < 0)
-      {
-        DataArrayPath tempPath(compRef.dataContainerName, compRef.attributeMatrixName, compRef.attributeArrayName);
-        QString ss = QObject::tr("Error Executing threshold filter on array. The path is %1").arg(tempPath.serialize());
-        setErrorCondition(-13002);
-        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-        return;
-      }
-      for (int64_t p = 0; p < totalTuples; ++p)
-      {
-        if (m_Destination[p] == false || currentArray[p] == false)
-        {
-          m_Destination[p] = false;
-        }
-      }
-    }
-  }
+  expression.setRoot(root);
+  expression.evaluate(m_DestinationPtr.lock()->getNumberOfTuples(), m_Destination, NULL);
 
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -56,8 +56,14 @@ foreach(f ${_PrivateFilters} )
                         ${${PLUGIN_NAME}_SOURCE_DIR}/Documentation/${_filterGroupName}/${f}.md FALSE ${${PLUGIN_NAME}_BINARY_DIR})
 endforeach()
 
-
-
+#-------------
+# These are files that need to be compiled into the plugin but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER(${Processing_SOURCE_DIR} ${_filterGroupName} ConnectedComponentLabeler.h)
+ADD_SIMPL_SUPPORT_SOURCE(${Processing_SOURCE_DIR} ${_filterGroupName} ConnectedComponentLabeler.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${Processing_SOURCE_DIR} ${_filterGroupName} MorphologyEngine.h)
+ADD_SIMPL_SUPPORT_SOURCE(${Processing_SOURCE_DIR} ${_filterGroupName} MorphologyEngine.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${Processing_SOURCE_DIR} ${_filterGroupName} ThresholdExpression.h)
+ADD_SIMPL_SUPPORT_SOURCE(${Processing_SOURCE_DIR} ${_filterGroupName} ThresholdExpression.cpp)
 
 SIMPL_END_FILTER_GROUP(${Processing_BINARY_DIR} "${_filterGroupName}" "Processing Filters")
 
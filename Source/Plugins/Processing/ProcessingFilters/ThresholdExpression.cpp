@@ -0,0 +1,417 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "ThresholdExpression.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Common/Constants.h"
+
+namespace
+{
+  const size_t WordsPerBlock = ThresholdExpression::BlockSize / 64;
+
+  template<typename T>
+  struct LessThan
+  {
+    static inline bool apply(T a, T b) { return a < b; }
+  };
+
+  template<typename T>
+  struct GreaterThan
+  {
+    static inline bool apply(T a, T b) { return a > b; }
+  };
+
+  template<typename T>
+  struct EqualTo
+  {
+    static inline bool apply(T a, T b) { return a == b; }
+  };
+
+  template<typename T>
+  struct NotEqualTo
+  {
+    static inline bool apply(T a, T b) { return a != b; }
+  };
+
+  /**
+   * @brief Compares count values against value and packs the results into out. The
+   * comparison itself writes one byte per tuple into a 64 entry buffer, a branch free
+   * loop the compiler turns into vector compares, and the bytes are then folded into
+   * a single word.
+   */
+  template<typename T, typename Op>
+  void CompareWords(const T* data, size_t count, T value, uint64_t* out)
+  {
+    uint8_t flags[64];
+    size_t numWords = (count + 63) / 64;
+    for (size_t w = 0; w < numWords; ++w)
+    {
+      const T* p = data + w * 64;
+      size_t n = std::min<size_t>(64, count - w * 64);
+      for (size_t i = 0; i < n; ++i)
+      {
+        flags[i] = static_cast<uint8_t>(Op::apply(p[i], value));
+      }
+      uint64_t bits = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        bits |= static_cast<uint64_t>(flags[i]) << i;
+      }
+      out[w] = bits;
+    }
+  }
+
+  template<typename T>
+  void CompareTyped(const void* data, size_t start, size_t count, int32_t compOperator, double value, uint64_t* out)
+  {
+    const T* p = static_cast<const T*>(data) + start;
+    T v = static_cast<T>(value);
+    switch(compOperator)
+    {
+      case SIMPL::Comparison::Operator_LessThan:
+        CompareWords<T, LessThan<T> >(p, count, v, out);
+        break;
+      case SIMPL::Comparison::Operator_GreaterThan:
+        CompareWords<T, GreaterThan<T> >(p, count, v, out);
+        break;
+      case SIMPL::Comparison::Operator_Equal:
+        CompareWords<T, EqualTo<T> >(p, count, v, out);
+        break;
+      case SIMPL::Comparison::Operator_NotEqual:
+        CompareWords<T, NotEqualTo<T> >(p, count, v, out);
+        break;
+      default:
+        ::memset(out, 0, ((count + 63) / 64) * sizeof(uint64_t));
+        break;
+    }
+  }
+
+  /**
+   * @brief Returns the mask of the bits of word w that belong to one of count tuples
+   */
+  inline uint64_t ValidBits(size_t w, size_t count)
+  {
+    size_t remaining = count - w * 64;
+    return (remaining >= 64) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << remaining) - 1);
+  }
+}
+
+/**
+ * @brief The ThresholdExpressionImpl class evaluates a range of blocks
+ */
+class ThresholdExpressionImpl
+{
+  public:
+    ThresholdExpressionImpl(const ThresholdExpression* expression, size_t numTuples, bool* destination, uint64_t* packed) :
+      m_Expression(expression),
+      m_NumTuples(numTuples),
+      m_Destination(destination),
+      m_Packed(packed)
+    {}
+    virtual ~ThresholdExpressionImpl() {}
+
+    void evaluate(size_t start, size_t end) const
+    {
+      m_Expression->evaluateBlocks(start, end, m_NumTuples, m_Destination, m_Packed);
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      evaluate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const ThresholdExpression* m_Expression;
+    size_t m_NumTuples;
+    bool* m_Destination;
+    uint64_t* m_Packed;
+};
+
+const size_t ThresholdExpression::BlockSize;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThresholdExpression::ThresholdExpression() :
+  m_Root(-1)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThresholdExpression::~ThresholdExpression()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ThresholdExpression::addNode(const Node& node)
+{
+  m_Nodes.push_back(node);
+  m_Root = static_cast<int32_t>(m_Nodes.size() - 1);
+  return m_Root;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ThresholdExpression::addComparison(IDataArray::Pointer array, int32_t compOperator, double value)
+{
+  if (NULL == array.get() || array->getNumberOfComponents() != 1)
+  {
+    return -1;
+  }
+  if (compOperator != SIMPL::Comparison::Operator_LessThan && compOperator != SIMPL::Comparison::Operator_GreaterThan
+      && compOperator != SIMPL::Comparison::Operator_Equal && compOperator != SIMPL::Comparison::Operator_NotEqual)
+  {
+    return -1;
+  }
+
+  Node node;
+  node.type = Comparison;
+  node.lhs = -1;
+  node.rhs = -1;
+  node.compOperator = compOperator;
+  node.value = value;
+  node.data = array->getVoidPointer(0);
+
+  QString type = array->getTypeAsString();
+  if (type == "int8_t") { node.valueType = Int8; }
+  else if (type == "uint8_t") { node.valueType = UInt8; }
+  else if (type == "int16_t") { node.valueType = Int16; }
+  else if (type == "uint16_t") { node.valueType = UInt16; }
+  else if (type == "int32_t") { node.valueType = Int32; }
+  else if (type == "uint32_t") { node.valueType = UInt32; }
+  else if (type == "int64_t") { node.valueType = Int64; }
+  else if (type == "uint64_t") { node.valueType = UInt64; }
+  else if (type == "float") { node.valueType = Float; }
+  else if (type == "double") { node.valueType = Double; }
+  else if (type == "bool") { node.valueType = Bool; }
+  else
+  {
+    return -1;
+  }
+
+  // Hold on to the array so the raw data pointer stays valid
+  m_Arrays.push_back(array);
+  return addNode(node);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ThresholdExpression::addAnd(int32_t lhs, int32_t rhs)
+{
+  Node node;
+  ::memset(&node, 0, sizeof(Node));
+  node.type = And;
+  node.lhs = lhs;
+  node.rhs = rhs;
+  return addNode(node);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ThresholdExpression::addOr(int32_t lhs, int32_t rhs)
+{
+  Node node;
+  ::memset(&node, 0, sizeof(Node));
+  node.type = Or;
+  node.lhs = lhs;
+  node.rhs = rhs;
+  return addNode(node);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThresholdExpression::setRoot(int32_t node)
+{
+  m_Root = node;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ThresholdExpression::PackedWordCount(size_t numTuples)
+{
+  return (numTuples + 63) / 64;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThresholdExpression::compareBlock(const Node& node, size_t start, size_t count, uint64_t* out) const
+{
+  switch(node.valueType)
+  {
+    case Int8: CompareTyped<int8_t>(node.data, start, count, node.compOperator, node.value, out); break;
+    case UInt8: CompareTyped<uint8_t>(node.data, start, count, node.compOperator, node.value, out); break;
+    case Int16: CompareTyped<int16_t>(node.data, start, count, node.compOperator, node.value, out); break;
+    case UInt16: CompareTyped<uint16_t>(node.data, start, count, node.compOperator, node.value, out); break;
+    case Int32: CompareTyped<int32_t>(node.data, start, count, node.compOperator, node.value, out); break;
+    case UInt32: CompareTyped<uint32_t>(node.data, start, count, node.compOperator, node.value, out); break;
+    case Int64: CompareTyped<int64_t>(node.data, start, count, node.compOperator, node.value, out); break;
+    case UInt64: CompareTyped<uint64_t>(node.data, start, count, node.compOperator, node.value, out); break;
+    case Float: CompareTyped<float>(node.data, start, count, node.compOperator, node.value, out); break;
+    case Double: CompareTyped<double>(node.data, start, count, node.compOperator, node.value, out); break;
+    case Bool: CompareTyped<bool>(node.data, start, count, node.compOperator, node.value, out); break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThresholdExpression::evaluateNode(int32_t index, size_t start, size_t count, uint64_t* out, uint64_t* scratch) const
+{
+  const Node& node = m_Nodes[index];
+  size_t numWords = (count + 63) / 64;
+  if (node.type == Comparison)
+  {
+    compareBlock(node, start, count, out);
+    return;
+  }
+
+  evaluateNode(node.lhs, start, count, out, scratch);
+
+  // Skip the right hand side if the left hand side already decides the block
+  bool decided = true;
+  for (size_t w = 0; w < numWords && decided; ++w)
+  {
+    decided = (node.type == And) ? (out[w] == 0) : (out[w] == ValidBits(w, count));
+  }
+  if (decided)
+  {
+    return;
+  }
+
+  // Every node owns one block of scratch space, so the right hand side can never
+  // overwrite a result that is still needed further up the tree
+  uint64_t* rhsOut = scratch + static_cast<size_t>(node.rhs) * WordsPerBlock;
+  evaluateNode(node.rhs, start, count, rhsOut, scratch);
+  if (node.type == And)
+  {
+    for (size_t w = 0; w < numWords; ++w) { out[w] &= rhsOut[w]; }
+  }
+  else
+  {
+    for (size_t w = 0; w < numWords; ++w) { out[w] |= rhsOut[w]; }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThresholdExpression::evaluateBlocks(size_t startBlock, size_t endBlock, size_t numTuples, bool* destination, uint64_t* packed) const
+{
+  std::vector<uint64_t> scratch(m_Nodes.size() * WordsPerBlock, 0);
+  uint64_t words[WordsPerBlock];
+
+  for (size_t b = startBlock; b < endBlock; ++b)
+  {
+    size_t start = b * BlockSize;
+    size_t count = std::min(BlockSize, numTuples - start);
+    size_t numWords = (count + 63) / 64;
+
+    if (m_Root >= 0)
+    {
+      evaluateNode(m_Root, start, count, words, &(scratch.front()));
+    }
+    else
+    {
+      ::memset(words, 0, sizeof(words));
+    }
+
+    if (NULL != packed)
+    {
+      ::memcpy(packed + start / 64, words, numWords * sizeof(uint64_t));
+    }
+    if (NULL != destination)
+    {
+      bool* dst = destination + start;
+      for (size_t i = 0; i < count; ++i)
+      {
+        dst[i] = ((words[i >> 6] >> (i & 63)) & 1) != 0;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThresholdExpression::evaluate(size_t numTuples, bool* destination, uint64_t* packed) const
+{
+  size_t numBlocks = (numTuples + BlockSize - 1) / BlockSize;
+  if (numBlocks == 0)
+  {
+    return;
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks),
+                      ThresholdExpressionImpl(this, numTuples, destination, packed), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    ThresholdExpressionImpl serial(this, numTuples, destination, packed);
+    serial.evaluate(0, numBlocks);
+  }
+}
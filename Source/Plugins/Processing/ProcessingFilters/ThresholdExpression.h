@@ -0,0 +1,148 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#ifndef _thresholdexpression_h_
+#define _thresholdexpression_h_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+/**
+ * @brief The ThresholdExpression class evaluates a tree of scalar comparisons joined by
+ * AND/OR nodes in a single pass over the tuples. The tuples are processed in blocks;
+ * every node of the tree writes its result for a block into a small per thread bit mask
+ * (one bit per tuple) so no full size temporary array is ever allocated. Each comparison
+ * runs a tight loop specialized for the array type and operator that the compiler can
+ * vectorize. The right hand side of an AND (OR) node is skipped for blocks where the
+ * left hand side is already all false (all true).
+ */
+class ThresholdExpression
+{
+  public:
+    /**
+     * @brief Number of tuples evaluated together. Always a multiple of 64 so blocks
+     * start on a word boundary of the packed output.
+     */
+    static const size_t BlockSize = 4096;
+
+    ThresholdExpression();
+    virtual ~ThresholdExpression();
+
+    /**
+     * @brief addComparison Adds the leaf "array[i] <op> value" where op is a
+     * SIMPL::Comparison::Enumeration. The value is cast to the type of the array
+     * before comparing. The array must be a single component array of a numeric or
+     * bool type.
+     * @return Index of the new node or -1 if the array type or operator is not supported
+     */
+    int32_t addComparison(IDataArray::Pointer array, int32_t compOperator, double value);
+
+    /**
+     * @brief addAnd Adds a node that is true where both child nodes are true
+     * @return Index of the new node
+     */
+    int32_t addAnd(int32_t lhs, int32_t rhs);
+
+    /**
+     * @brief addOr Adds a node that is true where either child node is true
+     * @return Index of the new node
+     */
+    int32_t addOr(int32_t lhs, int32_t rhs);
+
+    /**
+     * @brief setRoot Selects the node that evaluate() computes. Defaults to the last
+     * node that was added.
+     */
+    void setRoot(int32_t node);
+
+    /**
+     * @brief evaluate Computes the expression for tuples [0, numTuples). Either output
+     * may be NULL. The packed mask stores tuple i in bit (i % 64) of word (i / 64) and
+     * must hold PackedWordCount(numTuples) words.
+     */
+    void evaluate(size_t numTuples, bool* destination, uint64_t* packed) const;
+
+    /**
+     * @brief evaluateBlocks Evaluates the blocks [startBlock, endBlock). Used by
+     * evaluate() from one or more threads.
+     */
+    void evaluateBlocks(size_t startBlock, size_t endBlock, size_t numTuples, bool* destination, uint64_t* packed) const;
+
+    /**
+     * @brief PackedWordCount Number of 64 bit words needed to hold one bit per tuple
+     */
+    static size_t PackedWordCount(size_t numTuples);
+
+  private:
+    enum NodeType
+    {
+      Comparison = 0,
+      And = 1,
+      Or = 2
+    };
+
+    enum ValueType
+    {
+      Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double, Bool
+    };
+
+    struct Node
+    {
+      NodeType type;
+      int32_t lhs;
+      int32_t rhs;
+      ValueType valueType;
+      int32_t compOperator;
+      double value;
+      const void* data;
+    };
+
+    std::vector<Node> m_Nodes;
+    std::vector<IDataArray::Pointer> m_Arrays;
+    int32_t m_Root;
+
+    int32_t addNode(const Node& node);
+    void evaluateNode(int32_t node, size_t start, size_t count, uint64_t* out, uint64_t* scratch) const;
+    void compareBlock(const Node& node, size_t start, size_t count, uint64_t* out) const;
+
+    ThresholdExpression(const ThresholdExpression&); // Copy Constructor Not Implemented
+    void operator=(const ThresholdExpression&); // Operator '=' Not Implemented
+};
+
+#endif /* _thresholdexpression_h_ */
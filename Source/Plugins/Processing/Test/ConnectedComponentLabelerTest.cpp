@@ -0,0 +1,251 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <deque>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "Processing/ProcessingFilters/ConnectedComponentLabeler.h"
+
+#include "ProcessingTestFileLocations.h"
+
+class ConnectedComponentLabelerTest
+{
+  public:
+    ConnectedComponentLabelerTest(){}
+    virtual ~ConnectedComponentLabelerTest(){}
+    SIMPL_TYPE_MACRO(ConnectedComponentLabelerTest)
+
+    // -----------------------------------------------------------------------------
+    // Random mask with the given fraction of true voxels
+    // -----------------------------------------------------------------------------
+    std::vector<bool> CreateMask(const size_t dims[3], uint32_t seed, uint32_t percentTrue)
+    {
+      std::vector<bool> mask(dims[0] * dims[1] * dims[2], false);
+      for (size_t i = 0; i < mask.size(); i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        mask[i] = ((seed >> 16) % 100) < percentTrue;
+      }
+      return mask;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Breadth first flood fill started from every unlabeled voxel in raster order, so
+    // components are numbered in the order of their first voxel
+    // -----------------------------------------------------------------------------
+    int64_t ReferenceLabels(const size_t dims[3], const bool* mask, bool value, int32_t connectivity, bool sliceBySlice, std::vector<int64_t>& labels)
+    {
+      int64_t xp = static_cast<int64_t>(dims[0]);
+      int64_t yp = static_cast<int64_t>(dims[1]);
+      int64_t zp = static_cast<int64_t>(dims[2]);
+      int64_t totalPoints = xp * yp * zp;
+      labels.assign(totalPoints, -1);
+      int64_t numComponents = 0;
+      std::deque<int64_t> queue;
+      for (int64_t seed = 0; seed < totalPoints; seed++)
+      {
+        if (mask[seed] != value || labels[seed] >= 0) { continue; }
+        labels[seed] = numComponents;
+        queue.push_back(seed);
+        while (queue.empty() == false)
+        {
+          int64_t index = queue.front();
+          queue.pop_front();
+          int64_t x = index % xp;
+          int64_t y = (index / xp) % yp;
+          int64_t z = index / (xp * yp);
+          for (int64_t dz = -1; dz <= 1; dz++)
+          {
+            if (sliceBySlice == true && dz != 0) { continue; }
+            for (int64_t dy = -1; dy <= 1; dy++)
+            {
+              for (int64_t dx = -1; dx <= 1; dx++)
+              {
+                int32_t nonZero = (dx != 0) + (dy != 0) + (dz != 0);
+                if (nonZero == 0) { continue; }
+                if (nonZero == 2 && connectivity < ConnectedComponentLabeler::EdgeConnected) { continue; }
+                if (nonZero == 3 && connectivity < ConnectedComponentLabeler::CornerConnected) { continue; }
+                int64_t nx = x + dx;
+                int64_t ny = y + dy;
+                int64_t nz = z + dz;
+                if (nx < 0 || nx >= xp || ny < 0 || ny >= yp || nz < 0 || nz >= zp) { continue; }
+                int64_t neighbor = (nz * yp + ny) * xp + nx;
+                if (mask[neighbor] != value || labels[neighbor] >= 0) { continue; }
+                labels[neighbor] = numComponents;
+                queue.push_back(neighbor);
+              }
+            }
+          }
+        }
+        numComponents++;
+      }
+      return numComponents;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int CompareWithReference(const size_t dims[3], const std::vector<bool>& maskBits, bool value, int32_t connectivity, bool sliceBySlice)
+    {
+      size_t totalPoints = dims[0] * dims[1] * dims[2];
+      bool* mask = new bool[totalPoints];
+      for (size_t i = 0; i < totalPoints; i++)
+      {
+        mask[i] = maskBits[i];
+      }
+
+      std::vector<int64_t> expected;
+      int64_t expectedCount = ReferenceLabels(dims, mask, value, connectivity, sliceBySlice, expected);
+
+      ConnectedComponentLabeler labeler(dims, connectivity, sliceBySlice);
+      int64_t count = labeler.label(mask, value);
+      delete[] mask;
+
+      DREAM3D_REQUIRE_EQUAL(count, expectedCount)
+      const std::vector<int64_t>& labels = labeler.getLabels();
+      DREAM3D_REQUIRE_EQUAL(labels.size(), totalPoints)
+      std::vector<int64_t> sizes(expectedCount, 0);
+      for (size_t i = 0; i < totalPoints; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(labels[i], expected[i])
+        if (expected[i] >= 0) { sizes[expected[i]]++; }
+      }
+
+      const std::vector<int64_t>& componentSizes = labeler.getComponentSizes();
+      DREAM3D_REQUIRE_EQUAL(componentSizes.size(), sizes.size())
+      int64_t largest = -1;
+      for (int64_t c = 0; c < expectedCount; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(componentSizes[c], sizes[c])
+        if (largest < 0 || sizes[c] >= sizes[largest]) { largest = c; }
+      }
+      DREAM3D_REQUIRE_EQUAL(labeler.getLargestComponent(), largest)
+
+      std::vector<bool> boundary(expectedCount, false);
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            int64_t component = expected[(z * dims[1] + y) * dims[0] + x];
+            if (component < 0) { continue; }
+            bool surface = (x == 0 || x == dims[0] - 1 || y == 0 || y == dims[1] - 1);
+            if (sliceBySlice == false && (z == 0 || z == dims[2] - 1)) { surface = true; }
+            if (surface == true) { boundary[component] = true; }
+          }
+        }
+      }
+      std::vector<bool> boundaryComponents = labeler.findBoundaryComponents();
+      DREAM3D_REQUIRE_EQUAL(boundaryComponents.size(), boundary.size())
+      for (int64_t c = 0; c < expectedCount; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(boundaryComponents[c], boundary[c])
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // 161 rows of an odd length, so the parallel labeler cuts the volume into many slabs
+    // that start in the middle of a plane and components have to be joined across them
+    // -----------------------------------------------------------------------------
+    int TestConnectivities()
+    {
+      size_t dims[3] = { 11, 7, 23 };
+      const int32_t connectivities[3] = { ConnectedComponentLabeler::FaceConnected, ConnectedComponentLabeler::EdgeConnected, ConnectedComponentLabeler::CornerConnected };
+      const uint32_t densities[3] = { 20, 35, 55 };
+      for (int32_t d = 0; d < 3; d++)
+      {
+        std::vector<bool> mask = CreateMask(dims, 1000 + d, densities[d]);
+        for (int32_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(CompareWithReference(dims, mask, true, connectivities[c], false), EXIT_SUCCESS)
+          DREAM3D_REQUIRE_EQUAL(CompareWithReference(dims, mask, false, connectivities[c], false), EXIT_SUCCESS)
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestSliceBySlice()
+    {
+      size_t dims[3] = { 13, 9, 17 };
+      const int32_t connectivities[3] = { ConnectedComponentLabeler::FaceConnected, ConnectedComponentLabeler::EdgeConnected, ConnectedComponentLabeler::CornerConnected };
+      std::vector<bool> mask = CreateMask(dims, 77, 50);
+      for (int32_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(CompareWithReference(dims, mask, true, connectivities[c], true), EXIT_SUCCESS)
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // A single column of rows and a single voxel wide volume, where every row is its own slab
+    // -----------------------------------------------------------------------------
+    int TestThinVolumes()
+    {
+      size_t column[3] = { 1, 1, 200 };
+      std::vector<bool> mask = CreateMask(column, 5, 70);
+      DREAM3D_REQUIRE_EQUAL(CompareWithReference(column, mask, true, ConnectedComponentLabeler::CornerConnected, false), EXIT_SUCCESS)
+      size_t sheet[3] = { 1, 40, 6 };
+      mask = CreateMask(sheet, 6, 60);
+      DREAM3D_REQUIRE_EQUAL(CompareWithReference(sheet, mask, true, ConnectedComponentLabeler::EdgeConnected, false), EXIT_SUCCESS)
+      return EXIT_SUCCESS;
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestConnectivities())
+      DREAM3D_REGISTER_TEST(TestSliceBySlice())
+      DREAM3D_REGISTER_TEST(TestThinVolumes())
+    }
+
+  private:
+    ConnectedComponentLabelerTest(const ConnectedComponentLabelerTest&); // Copy Constructor Not Implemented
+    void operator=(const ConnectedComponentLabelerTest&); // Operator '=' Not Implemented
+};
@@ -0,0 +1,397 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "ProcessingTestFileLocations.h"
+
+static const size_t k_ErodeDilateDims[3] = { 8, 6, 3 };
+static const size_t k_ErodeDilateNumPoints = 8 * 6 * 3;
+static const QString k_ErodeDilateMaskName("Mask");
+static const QString k_ErodeDilateSourceIndexName("SourceIndex");
+static const QString k_ErodeDilateSourceNameName("SourceName");
+
+// Four features in the quadrants of each slice and a fifth one in the last slice, with
+// scattered bad voxels and a hole in the middle slice. Printed one Z slice at a time.
+static const int32_t k_ErodeDilateFeatureIds[k_ErodeDilateNumPoints] =
+{
+  1, 1, 1, 1, 2, 2, 2, 2,
+  1, 1, 1, 1, 0, 0, 2, 2,
+  1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 0, 4, 4, 0, 4,
+  0, 0, 0, 3, 4, 4, 4, 4,
+  3, 3, 3, 3, 4, 4, 4, 4,
+
+  1, 1, 1, 1, 2, 2, 2, 2,
+  1, 0, 1, 0, 0, 2, 2, 2,
+  1, 1, 1, 0, 0, 0, 0, 2,
+  3, 0, 0, 0, 0, 0, 4, 4,
+  3, 3, 0, 3, 4, 4, 4, 4,
+  3, 3, 3, 3, 4, 0, 4, 4,
+
+  1, 1, 1, 1, 0, 2, 2, 2,
+  1, 1, 1, 1, 2, 2, 0, 2,
+  5, 0, 5, 1, 2, 2, 2, 2,
+  5, 5, 5, 3, 4, 4, 4, 4,
+  5, 5, 5, 3, 4, 4, 4, 4,
+  5, 5, 5, 3, 0, 4, 4, 4
+};
+
+// The expected results were produced by the iterative filters that ran one pass over
+// the volume per iteration. Erode 1 iteration along X, Y and Z:
+static const int32_t k_ErodeBadDataXYZ1[k_ErodeDilateNumPoints] =
+{
+  1, 1, 1, 1, 0, 0, 2, 2,
+  1, 0, 1, 0, 0, 0, 0, 2,
+  1, 1, 1, 0, 0, 0, 0, 2,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 4, 4, 0, 4,
+  0, 0, 0, 3, 4, 0, 4, 4,
+
+  1, 0, 1, 0, 0, 2, 2, 2,
+  0, 0, 0, 0, 0, 0, 0, 2,
+  1, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 4,
+  0, 0, 0, 0, 0, 0, 4, 4,
+  3, 3, 0, 3, 0, 0, 0, 4,
+
+  1, 1, 1, 0, 0, 0, 0, 2,
+  1, 0, 1, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 2,
+  5, 0, 0, 0, 0, 0, 4, 4,
+  5, 5, 0, 3, 0, 4, 4, 4,
+  5, 5, 5, 0, 0, 0, 4, 4
+};
+
+// Dilate 2 iterations along X and Y:
+static const int32_t k_DilateBadDataXY2[k_ErodeDilateNumPoints] =
+{
+  1, 1, 1, 1, 2, 2, 2, 2,
+  1, 1, 1, 1, 2, 2, 2, 2,
+  1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4,
+  3, 3, 3, 3, 4, 4, 4, 4,
+  3, 3, 3, 3, 4, 4, 4, 4,
+
+  1, 1, 1, 1, 2, 2, 2, 2,
+  1, 1, 1, 1, 2, 2, 2, 2,
+  1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 1, 3, 4, 4, 4, 4,
+  3, 3, 3, 3, 4, 4, 4, 4,
+  3, 3, 3, 3, 4, 4, 4, 4,
+
+  1, 1, 1, 1, 2, 2, 2, 2,
+  1, 1, 1, 1, 2, 2, 2, 2,
+  5, 5, 5, 1, 2, 2, 2, 2,
+  5, 5, 5, 3, 4, 4, 4, 4,
+  5, 5, 5, 3, 4, 4, 4, 4,
+  5, 5, 5, 3, 4, 4, 4, 4
+};
+
+// Erode 2 iterations along Z:
+static const int32_t k_ErodeBadDataZ2[k_ErodeDilateNumPoints] =
+{
+  1, 1, 1, 1, 0, 2, 2, 2,
+  1, 0, 1, 0, 0, 0, 0, 2,
+  1, 0, 1, 0, 0, 0, 0, 2,
+  3, 0, 0, 0, 0, 0, 0, 4,
+  0, 0, 0, 3, 4, 4, 4, 4,
+  3, 3, 3, 3, 0, 0, 4, 4,
+
+  1, 1, 1, 1, 0, 2, 2, 2,
+  1, 0, 1, 0, 0, 0, 0, 2,
+  1, 0, 1, 0, 0, 0, 0, 2,
+  3, 0, 0, 0, 0, 0, 0, 4,
+  0, 0, 0, 3, 4, 4, 4, 4,
+  3, 3, 3, 3, 0, 0, 4, 4,
+
+  1, 1, 1, 1, 0, 2, 2, 2,
+  1, 0, 1, 0, 0, 0, 0, 2,
+  5, 0, 5, 0, 0, 0, 0, 2,
+  5, 0, 0, 0, 0, 0, 0, 4,
+  0, 0, 0, 3, 4, 4, 4, 4,
+  5, 5, 5, 3, 0, 0, 4, 4
+};
+
+// The mask is features 1 and 4. Dilate 2 iterations along X and Z:
+static const int32_t k_DilateMaskXZ2[k_ErodeDilateNumPoints] =
+{
+  1, 1, 1, 1, 1, 1, 0, 0,
+  1, 1, 1, 1, 1, 1, 0, 0,
+  1, 1, 1, 1, 1, 1, 0, 0,
+  0, 0, 1, 1, 1, 1, 1, 1,
+  0, 0, 1, 1, 1, 1, 1, 1,
+  0, 0, 1, 1, 1, 1, 1, 1,
+
+  1, 1, 1, 1, 1, 1, 0, 0,
+  1, 1, 1, 1, 1, 0, 0, 0,
+  1, 1, 1, 1, 1, 0, 0, 0,
+  0, 0, 0, 1, 1, 1, 1, 1,
+  0, 0, 1, 1, 1, 1, 1, 1,
+  0, 0, 1, 1, 1, 1, 1, 1,
+
+  1, 1, 1, 1, 1, 1, 0, 0,
+  1, 1, 1, 1, 1, 1, 0, 0,
+  1, 1, 1, 1, 1, 1, 0, 0,
+  0, 0, 1, 1, 1, 1, 1, 1,
+  0, 0, 1, 1, 1, 1, 1, 1,
+  0, 0, 0, 1, 1, 1, 1, 1
+};
+
+// Erode 1 iteration along X, Y and Z:
+static const int32_t k_ErodeMaskXYZ1[k_ErodeDilateNumPoints] =
+{
+  1, 1, 1, 0, 0, 0, 0, 0,
+  1, 0, 1, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 1, 0, 1,
+  0, 0, 0, 0, 0, 0, 1, 1,
+
+  1, 0, 1, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 1, 1,
+  0, 0, 0, 0, 0, 0, 0, 1,
+
+  1, 1, 1, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 1, 1, 1,
+  0, 0, 0, 0, 0, 0, 1, 1
+};
+
+class ErodeDilateTest
+{
+  public:
+    ErodeDilateTest(){}
+    virtual ~ErodeDilateTest(){}
+    SIMPL_TYPE_MACRO(ErodeDilateTest)
+
+    // -----------------------------------------------------------------------------
+    // Besides the feature ids and the mask the cell data holds the index of every voxel
+    // as a number and as a string, so the test can check that whole tuples were moved,
+    // including those of arrays that are not plain DataArrays
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestVolume()
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(k_ErodeDilateDims[0], k_ErodeDilateDims[1], k_ErodeDilateDims[2]);
+      m->setGeometry(image);
+
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = k_ErodeDilateDims[0];
+      tDims[1] = k_ErodeDilateDims[1];
+      tDims[2] = k_ErodeDilateDims[2];
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::FeatureIds, true);
+      BoolArrayType::Pointer mask = BoolArrayType::CreateArray(tDims, cDims, k_ErodeDilateMaskName, true);
+      Int32ArrayType::Pointer sourceIndex = Int32ArrayType::CreateArray(tDims, cDims, k_ErodeDilateSourceIndexName, true);
+      StringDataArray::Pointer sourceName = StringDataArray::CreateArray(k_ErodeDilateNumPoints, k_ErodeDilateSourceNameName);
+      for (size_t i = 0; i < k_ErodeDilateNumPoints; i++)
+      {
+        featureIds->setValue(i, k_ErodeDilateFeatureIds[i]);
+        mask->setValue(i, k_ErodeDilateFeatureIds[i] == 1 || k_ErodeDilateFeatureIds[i] == 4);
+        sourceIndex->setValue(i, static_cast<int32_t>(i));
+        sourceName->setValue(i, QString::number(i));
+      }
+      am->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+      am->addAttributeArray(k_ErodeDilateMaskName, mask);
+      am->addAttributeArray(k_ErodeDilateSourceIndexName, sourceIndex);
+      am->addAttributeArray(k_ErodeDilateSourceNameName, sourceName);
+      m->addAttributeMatrix(am->getName(), am);
+
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    IDataArray::Pointer GetCellArray(DataContainerArray::Pointer dca, const QString& name)
+    {
+      AttributeMatrix::Pointer am = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+      DREAM3D_REQUIRE_VALID_POINTER(am.get());
+      IDataArray::Pointer array = am->getAttributeArray(name);
+      DREAM3D_REQUIRE_VALID_POINTER(array.get());
+      DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), k_ErodeDilateNumPoints)
+      return array;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int RunFilter(const QString& filterName, const QString& arrayName, DataContainerArray::Pointer dca, unsigned int direction, int numIterations, bool xDirOn, bool yDirOn, bool zDirOn)
+    {
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filterName);
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, arrayName));
+      bool propWasSet = filter->setProperty((filterName == "ErodeDilateMask") ? "MaskArrayPath" : "FeatureIdsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(direction);
+      propWasSet = filter->setProperty("Direction", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(numIterations);
+      propWasSet = filter->setProperty("NumIterations", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(xDirOn);
+      propWasSet = filter->setProperty("XDirOn", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(yDirOn);
+      propWasSet = filter->setProperty("YDirOn", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(zDirOn);
+      propWasSet = filter->setProperty("ZDirOn", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int CheckBadData(unsigned int direction, int numIterations, bool xDirOn, bool yDirOn, bool zDirOn, const int32_t* expected)
+    {
+      DataContainerArray::Pointer dca = CreateTestVolume();
+      int err = RunFilter("ErodeDilateBadData", SIMPL::CellData::FeatureIds, dca, direction, numIterations, xDirOn, yDirOn, zDirOn);
+      DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+      Int32ArrayType::Pointer featureIds = std::dynamic_pointer_cast<Int32ArrayType>(GetCellArray(dca, SIMPL::CellData::FeatureIds));
+      Int32ArrayType::Pointer sourceIndex = std::dynamic_pointer_cast<Int32ArrayType>(GetCellArray(dca, k_ErodeDilateSourceIndexName));
+      StringDataArray::Pointer sourceName = std::dynamic_pointer_cast<StringDataArray>(GetCellArray(dca, k_ErodeDilateSourceNameName));
+      DREAM3D_REQUIRE_VALID_POINTER(featureIds.get());
+      DREAM3D_REQUIRE_VALID_POINTER(sourceIndex.get());
+      DREAM3D_REQUIRE_VALID_POINTER(sourceName.get());
+      for (size_t i = 0; i < k_ErodeDilateNumPoints; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), expected[i])
+        // Every voxel holds the whole tuple of the voxel it took its feature id from
+        int32_t source = sourceIndex->getValue(i);
+        DREAM3D_REQUIRED(source, >=, 0)
+        DREAM3D_REQUIRED(source, <, static_cast<int32_t>(k_ErodeDilateNumPoints))
+        DREAM3D_REQUIRE_EQUAL(k_ErodeDilateFeatureIds[source], featureIds->getValue(i))
+        DREAM3D_REQUIRE_EQUAL(sourceName->getValue(i), QString::number(source))
+        if (featureIds->getValue(i) == k_ErodeDilateFeatureIds[i])
+        {
+          DREAM3D_REQUIRE_EQUAL(source, static_cast<int32_t>(i))
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int CheckMask(unsigned int direction, int numIterations, bool xDirOn, bool yDirOn, bool zDirOn, const int32_t* expected)
+    {
+      DataContainerArray::Pointer dca = CreateTestVolume();
+      int err = RunFilter("ErodeDilateMask", k_ErodeDilateMaskName, dca, direction, numIterations, xDirOn, yDirOn, zDirOn);
+      DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+      BoolArrayType::Pointer mask = std::dynamic_pointer_cast<BoolArrayType>(GetCellArray(dca, k_ErodeDilateMaskName));
+      Int32ArrayType::Pointer featureIds = std::dynamic_pointer_cast<Int32ArrayType>(GetCellArray(dca, SIMPL::CellData::FeatureIds));
+      DREAM3D_REQUIRE_VALID_POINTER(mask.get());
+      DREAM3D_REQUIRE_VALID_POINTER(featureIds.get());
+      for (size_t i = 0; i < k_ErodeDilateNumPoints; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(mask->getValue(i), (expected[i] != 0))
+        // Only the mask itself changes
+        DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), k_ErodeDilateFeatureIds[i])
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestErodeDilateBadData()
+    {
+      DREAM3D_REQUIRE_EQUAL(CheckBadData(0, 1, true, true, true, k_ErodeBadDataXYZ1), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(CheckBadData(1, 2, true, true, false, k_DilateBadDataXY2), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(CheckBadData(0, 2, false, false, true, k_ErodeBadDataZ2), EXIT_SUCCESS)
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestErodeDilateMask()
+    {
+      DREAM3D_REQUIRE_EQUAL(CheckMask(0, 2, true, false, true, k_DilateMaskXZ2), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(CheckMask(1, 1, true, true, true, k_ErodeMaskXYZ1), EXIT_SUCCESS)
+      return EXIT_SUCCESS;
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestErodeDilateBadData())
+      DREAM3D_REGISTER_TEST(TestErodeDilateMask())
+    }
+
+  private:
+    ErodeDilateTest(const ErodeDilateTest&); // Copy Constructor Not Implemented
+    void operator=(const ErodeDilateTest&); // Operator '=' Not Implemented
+};
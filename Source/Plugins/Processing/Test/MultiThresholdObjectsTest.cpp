@@ -33,6 +33,8 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <vector>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QString>
 
@@ -49,6 +51,7 @@
 #include "SIMPLib/Utilities/QMetaObjectUtilities.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Processing/ProcessingFilters/ThresholdExpression.h"
 
 class MultiThresholdObjectsTest
 {
@@ -196,6 +199,34 @@ class MultiThresholdObjectsTest
             DREAM3D_REQUIRE_EQUAL(0, 1)
           }
         }
+
+        // Both comparisons together: float > 0.1 AND int < 15 selects elements 10 through 14
+        ComparisonInputs comp2;
+        v.compOperator = 1; // greater than
+        v.compValue = 0.1;
+        comp2.addInput(v);
+        v1.compOperator = 0; // less than
+        v1.compValue = 15;
+        comp2.addInput(v1);
+
+        var.setValue(comp2);
+        propWasSet = filter->setProperty("SelectedThresholds", var);
+        DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+        QVariant qv2(QString("ThresholdArray2"));
+        propWasSet = filter->setProperty("DestinationArrayName", qv2);
+        DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+        filter->execute();
+        DREAM3D_REQUIRED(filter->getErrorCondition(), >= , 0);
+
+        IDataArray::Pointer thresholdArray2 = vdc->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArray("ThresholdArray2");
+        DataArray<bool>* inputArray2 = DataArray<bool>::SafePointerDownCast(thresholdArray2.get());
+        bool* inputArrayPtr2 = inputArray2->getPointer(0);
+        for (size_t i = 0; i < 20; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(inputArrayPtr2[i], (i >= 10 && i < 15))
+        }
       }
       else
       {
@@ -205,6 +236,161 @@ class MultiThresholdObjectsTest
       return 1;
     }
 
+    // -----------------------------------------------------------------------------
+    // Evaluates the expression into both outputs, which start out filled with garbage, and
+    // checks every tuple (and the unused bits of the last packed word) against expected
+    // -----------------------------------------------------------------------------
+    int CheckExpression(const ThresholdExpression& expression, const std::vector<bool>& expected)
+    {
+      size_t numTuples = expected.size();
+      size_t numWords = ThresholdExpression::PackedWordCount(numTuples);
+      DREAM3D_REQUIRE_EQUAL(numWords, (numTuples + 63) / 64)
+
+      std::vector<uint8_t> destinationBytes(numTuples, 0xAB);
+      bool* destination = reinterpret_cast<bool*>(&(destinationBytes.front()));
+      std::vector<uint64_t> packed(numWords, ~static_cast<uint64_t>(0));
+      expression.evaluate(numTuples, destination, &(packed.front()));
+      for (size_t i = 0; i < numTuples; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(destination[i], expected[i])
+        bool bit = ((packed[i / 64] >> (i % 64)) & 1) != 0;
+        DREAM3D_REQUIRE_EQUAL(bit, expected[i])
+      }
+      if (numTuples % 64 != 0)
+      {
+        uint64_t unused = ~((static_cast<uint64_t>(1) << (numTuples % 64)) - 1);
+        DREAM3D_REQUIRE_EQUAL(packed[numWords - 1] & unused, 0)
+      }
+
+      // Each output on its own gives the same answer
+      std::vector<uint64_t> packedOnly(numWords, 0);
+      expression.evaluate(numTuples, NULL, &(packedOnly.front()));
+      std::vector<uint8_t> boolOnlyBytes(numTuples, 0);
+      expression.evaluate(numTuples, reinterpret_cast<bool*>(&(boolOnlyBytes.front())), NULL);
+      for (size_t w = 0; w < numWords; w++)
+      {
+        DREAM3D_REQUIRE_EQUAL(packedOnly[w], packed[w])
+      }
+      for (size_t i = 0; i < numTuples; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(boolOnlyBytes[i], destinationBytes[i])
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // OR nodes, nested trees and the packed output of the ThresholdExpression, which the
+    // filter itself does not use yet. The tuple counts cover partial words, partial blocks
+    // and several blocks, and the "Halves" array is constant over each block so the
+    // right hand side of AND and OR nodes gets skipped for some blocks and not others.
+    // -----------------------------------------------------------------------------
+    int TestThresholdExpression()
+    {
+      const size_t tupleCounts[6] = { 1, 63, 64, 65, ThresholdExpression::BlockSize + 1, 3 * ThresholdExpression::BlockSize + 37 };
+      for (int t = 0; t < 6; t++)
+      {
+        size_t numTuples = tupleCounts[t];
+        FloatArrayType::Pointer floats = FloatArrayType::CreateArray(numTuples, "Floats");
+        Int32ArrayType::Pointer ints = Int32ArrayType::CreateArray(numTuples, "Ints");
+        UInt8ArrayType::Pointer bytes = UInt8ArrayType::CreateArray(numTuples, "Bytes");
+        BoolArrayType::Pointer bools = BoolArrayType::CreateArray(numTuples, "Bools");
+        Int64ArrayType::Pointer halves = Int64ArrayType::CreateArray(numTuples, "Halves");
+        for (size_t i = 0; i < numTuples; i++)
+        {
+          floats->setValue(i, static_cast<float>((i * 37) % 101) / 100.0f);
+          ints->setValue(i, static_cast<int32_t>((i * 13) % 29) - 10);
+          bytes->setValue(i, static_cast<uint8_t>(i % 7));
+          bools->setValue(i, (i % 5) == 0);
+          halves->setValue(i, static_cast<int64_t>((i / ThresholdExpression::BlockSize) % 2));
+        }
+
+        std::vector<bool> expected(numTuples, false);
+
+        // floats > 0.5 OR ints < -5
+        {
+          ThresholdExpression expression;
+          int32_t lhs = expression.addComparison(floats, SIMPL::Comparison::Operator_GreaterThan, 0.5);
+          int32_t rhs = expression.addComparison(ints, SIMPL::Comparison::Operator_LessThan, -5);
+          DREAM3D_REQUIRED(lhs, >=, 0)
+          DREAM3D_REQUIRED(rhs, >=, 0)
+          expression.addOr(lhs, rhs);
+          for (size_t i = 0; i < numTuples; i++)
+          {
+            expected[i] = floats->getValue(i) > 0.5f || ints->getValue(i) < -5;
+          }
+          DREAM3D_REQUIRE_EQUAL(CheckExpression(expression, expected), EXIT_SUCCESS)
+        }
+
+        // (bytes == 3 OR bools != 0) AND floats < 0.8
+        {
+          ThresholdExpression expression;
+          int32_t a = expression.addComparison(bytes, SIMPL::Comparison::Operator_Equal, 3);
+          int32_t b = expression.addComparison(bools, SIMPL::Comparison::Operator_NotEqual, 0);
+          int32_t either = expression.addOr(a, b);
+          int32_t c = expression.addComparison(floats, SIMPL::Comparison::Operator_LessThan, 0.8);
+          expression.addAnd(either, c);
+          for (size_t i = 0; i < numTuples; i++)
+          {
+            expected[i] = (bytes->getValue(i) == 3 || bools->getValue(i) != false) && floats->getValue(i) < 0.8f;
+          }
+          DREAM3D_REQUIRE_EQUAL(CheckExpression(expression, expected), EXIT_SUCCESS)
+        }
+
+        // halves == 1 OR bytes == 2, and halves == 1 AND bytes == 2
+        {
+          ThresholdExpression orExpression;
+          int32_t lhs = orExpression.addComparison(halves, SIMPL::Comparison::Operator_Equal, 1);
+          int32_t rhs = orExpression.addComparison(bytes, SIMPL::Comparison::Operator_Equal, 2);
+          orExpression.addOr(lhs, rhs);
+          for (size_t i = 0; i < numTuples; i++)
+          {
+            expected[i] = halves->getValue(i) == 1 || bytes->getValue(i) == 2;
+          }
+          DREAM3D_REQUIRE_EQUAL(CheckExpression(orExpression, expected), EXIT_SUCCESS)
+
+          ThresholdExpression andExpression;
+          lhs = andExpression.addComparison(halves, SIMPL::Comparison::Operator_Equal, 1);
+          rhs = andExpression.addComparison(bytes, SIMPL::Comparison::Operator_Equal, 2);
+          andExpression.addAnd(lhs, rhs);
+          for (size_t i = 0; i < numTuples; i++)
+          {
+            expected[i] = halves->getValue(i) == 1 && bytes->getValue(i) == 2;
+          }
+          DREAM3D_REQUIRE_EQUAL(CheckExpression(andExpression, expected), EXIT_SUCCESS)
+        }
+
+        // (ints > 0 AND bytes < 3) OR (bools == 1 OR (halves == 0 AND floats > 0.3)), then
+        // the left subtree on its own through setRoot
+        {
+          ThresholdExpression expression;
+          int32_t a = expression.addComparison(ints, SIMPL::Comparison::Operator_GreaterThan, 0);
+          int32_t b = expression.addComparison(bytes, SIMPL::Comparison::Operator_LessThan, 3);
+          int32_t left = expression.addAnd(a, b);
+          int32_t c = expression.addComparison(bools, SIMPL::Comparison::Operator_Equal, 1);
+          int32_t d = expression.addComparison(halves, SIMPL::Comparison::Operator_Equal, 0);
+          int32_t e = expression.addComparison(floats, SIMPL::Comparison::Operator_GreaterThan, 0.3);
+          int32_t inner = expression.addAnd(d, e);
+          int32_t right = expression.addOr(c, inner);
+          expression.addOr(left, right);
+          for (size_t i = 0; i < numTuples; i++)
+          {
+            bool l = ints->getValue(i) > 0 && bytes->getValue(i) < 3;
+            bool r = bools->getValue(i) == true || (halves->getValue(i) == 0 && floats->getValue(i) > 0.3f);
+            expected[i] = l || r;
+          }
+          DREAM3D_REQUIRE_EQUAL(CheckExpression(expression, expected), EXIT_SUCCESS)
+
+          expression.setRoot(left);
+          for (size_t i = 0; i < numTuples; i++)
+          {
+            expected[i] = ints->getValue(i) > 0 && bytes->getValue(i) < 3;
+          }
+          DREAM3D_REQUIRE_EQUAL(CheckExpression(expression, expected), EXIT_SUCCESS)
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
     /**
   * @brief
 */
@@ -213,6 +399,7 @@ class MultiThresholdObjectsTest
       int err = EXIT_SUCCESS;
       DREAM3D_REGISTER_TEST( TestFilterAvailability() );
       DREAM3D_REGISTER_TEST( RunTest() )
+      DREAM3D_REGISTER_TEST( TestThresholdExpression() )
     }
   private:
     MultiThresholdObjectsTest(const MultiThresholdObjectsTest&); // Copy Constructor Not Implemented
@@ -35,17 +35,70 @@
 
 #include "AlignSectionsFeature.h"
 
+#include <algorithm>
 #include <fstream>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
+#include "Reconstruction/ReconstructionFilters/SectionShiftCorrelator.h"
+
+/**
+ * @brief The AlignSectionsFeatureShiftsImpl class finds the shift of a range of section pairs
+ * from the full mismatch surface of their masks
+ */
+class AlignSectionsFeatureShiftsImpl
+{
+  public:
+    AlignSectionsFeatureShiftsImpl(const SectionShiftCorrelator* correlator, bool* goodVoxels, int64_t dims[3], int64_t* newxshifts, int64_t* newyshifts) :
+      m_Correlator(correlator),
+      m_GoodVoxels(goodVoxels),
+      m_Newxshifts(newxshifts),
+      m_Newyshifts(newyshifts)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~AlignSectionsFeatureShiftsImpl() {}
+
+    void findShifts(int64_t start, int64_t end) const
+    {
+      int64_t sliceSize = m_Dims[0] * m_Dims[1];
+      for (int64_t iter = start; iter < end; iter++)
+      {
+        int64_t slice = (m_Dims[2] - 1) - iter;
+        m_Correlator->findBestShift(m_GoodVoxels + (slice + 1) * sliceSize, m_GoodVoxels + slice * sliceSize, m_Newxshifts[iter], m_Newyshifts[iter]);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      findShifts(r.begin(), r.end());
+    }
+#endif
+  private:
+    const SectionShiftCorrelator* m_Correlator;
+    bool* m_GoodVoxels;
+    int64_t m_Dims[3];
+    int64_t* m_Newxshifts;
+    int64_t* m_Newyshifts;
+};
 
 #include "moc_AlignSectionsFeature.cpp"
 // -----------------------------------------------------------------------------
@@ -53,6 +106,7 @@
 // -----------------------------------------------------------------------------
 AlignSectionsFeature::AlignSectionsFeature() :
   AlignSections(),
+  m_UseCrossCorrelation(false),
   m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask),
   m_GoodVoxels(NULL)
 {
@@ -74,6 +128,7 @@ void AlignSectionsFeature::setupFilterParameters()
 {
   // getting the current parameters that were set by the parent and adding to it before resetting it
   FilterParameterVector parameters = getFilterParameters();
+  parameters.push_back(BooleanFilterParameter::New("Use Cross Correlation Shift Search", "UseCrossCorrelation", getUseCrossCorrelation(), FilterParameter::Parameter));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Bool, 1, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
@@ -89,6 +144,7 @@ void AlignSectionsFeature::readFilterParameters(AbstractFilterParametersReader*
 {
   AlignSections::readFilterParameters(reader, index);
   reader->openFilterGroup(this, index);
+  setUseCrossCorrelation(reader->readValue("UseCrossCorrelation", getUseCrossCorrelation() ) );
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath() ) );
   reader->closeFilterGroup();
 }
@@ -100,6 +156,7 @@ int AlignSectionsFeature::writeFilterParameters(AbstractFilterParametersWriter*
 {
   AlignSections::writeFilterParameters(writer, index);
   writer->openFilterGroup(this, index);
+  SIMPL_FILTER_WRITE_PARAMETER(UseCrossCorrelation)
   SIMPL_FILTER_WRITE_PARAMETER(GoodVoxelsArrayPath)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
@@ -169,6 +226,29 @@ void AlignSectionsFeature::find_shifts(std::vector<int64_t>& xshifts, std::vecto
     static_cast<int64_t>(udims[2]),
   };
 
+  if (getUseCrossCorrelation() == true)
+  {
+    std::vector<int64_t> newxshifts(dims[2], 0);
+    std::vector<int64_t> newyshifts(dims[2], 0);
+    find_shifts_correlation(dims, newxshifts, newyshifts);
+    if (getCancel() == true) { return; }
+    for (int64_t iter = 1; iter < dims[2]; iter++)
+    {
+      int64_t slice = (dims[2] - 1) - iter;
+      xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+      yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
+      if (getWriteAlignmentShifts() == true)
+      {
+        outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
+      }
+    }
+    if (getWriteAlignmentShifts() == true)
+    {
+      outFile.close();
+    }
+    return;
+  }
+
   float disorientation = 0.0f;
   float mindisorientation = std::numeric_limits<float>::max();
   int32_t newxshift = 0;
@@ -258,6 +338,43 @@ void AlignSectionsFeature::find_shifts(std::vector<int64_t>& xshifts, std::vecto
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsFeature::find_shifts_correlation(int64_t dims[3], std::vector<int64_t>& newxshifts, std::vector<int64_t>& newyshifts)
+{
+  QString ss = QObject::tr("Aligning Sections || Determining Shifts by Cross Correlation");
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+  SectionShiftCorrelator correlator(dims[0], dims[1]);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Every pair that is compared at the same time holds its own zero padded transform
+  // buffer, so the pairs run in batches that keep that memory bounded
+  int64_t batchSize = correlator.getMaxConcurrentPairs();
+  for (int64_t batchStart = 1; batchStart < dims[2]; batchStart += batchSize)
+  {
+    if (getCancel() == true) { return; }
+    int64_t batchEnd = std::min(batchStart + batchSize, dims[2]);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<int64_t>(batchStart, batchEnd, 1),
+                        AlignSectionsFeatureShiftsImpl(&correlator, m_GoodVoxels, dims, &(newxshifts.front()), &(newyshifts.front())), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      AlignSectionsFeatureShiftsImpl serial(&correlator, m_GoodVoxels, dims, &(newxshifts.front()), &(newyshifts.front()));
+      serial.findShifts(batchStart, batchEnd);
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
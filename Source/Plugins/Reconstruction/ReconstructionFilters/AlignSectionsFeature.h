@@ -58,6 +58,9 @@ class AlignSectionsFeature : public AlignSections
 
     virtual ~AlignSectionsFeature();
 
+    SIMPL_FILTER_PARAMETER(bool, UseCrossCorrelation)
+    Q_PROPERTY(bool UseCrossCorrelation READ getUseCrossCorrelation WRITE setUseCrossCorrelation)
+
     SIMPL_FILTER_PARAMETER(DataArrayPath, GoodVoxelsArrayPath)
     Q_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
 
@@ -143,6 +146,16 @@ class AlignSectionsFeature : public AlignSections
      */
     virtual void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts);
 
+    /**
+     * @brief find_shifts_correlation Picks the shift of every section pair with the lowest
+     * mismatch fraction over all shifts of less than half a section, evaluated by cross correlation.
+     * The section pairs are processed in parallel.
+     * @param dims The dimensions of the image geometry
+     * @param newxshifts The X shift of section (dims[2] - 1 - iter) relative to the next section, stored at iter
+     * @param newyshifts The Y shift of section (dims[2] - 1 - iter) relative to the next section, stored at iter
+     */
+    void find_shifts_correlation(int64_t dims[3], std::vector<int64_t>& newxshifts, std::vector<int64_t>& newyshifts);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(bool, GoodVoxels)
 
@@ -34,12 +34,21 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -48,6 +57,151 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
+#include "Reconstruction/ReconstructionFilters/SectionShiftCorrelator.h"
+
+namespace
+{
+  /**
+   * @brief Returns the inverse of the mutual information between the feature ids of section slice,
+   * shifted by (xshift, yshift), and the feature ids of section slice + 1. Every fourth cell is sampled.
+   */
+  float findInverseMutualInformation(const int32_t* miFeatureIds, const int64_t dims[3], int64_t slice, int64_t xshift, int64_t yshift,
+                                     int32_t featurecount1, int32_t featurecount2,
+                                     std::vector<float>& mutualinfo12, std::vector<float>& mutualinfo1, std::vector<float>& mutualinfo2)
+  {
+    mutualinfo12.assign(featurecount1 * featurecount2, 0.0f);
+    mutualinfo1.assign(featurecount1, 0.0f);
+    mutualinfo2.assign(featurecount2, 0.0f);
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    int64_t refposition = 0;
+    int64_t curposition = 0;
+    int32_t refgnum = 0, curgnum = 0;
+    for (int64_t l = 0; l < dims[1]; l = l + 4)
+    {
+      for (int64_t n = 0; n < dims[0]; n = n + 4)
+      {
+        if ((l + yshift) >= 0 && (l + yshift) < dims[1] && (n + xshift) >= 0 && (n + xshift) < dims[0])
+        {
+          refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+          curposition = (slice * dims[0] * dims[1]) + ((l + yshift) * dims[0]) + (n + xshift);
+          refgnum = miFeatureIds[refposition];
+          curgnum = miFeatureIds[curposition];
+          if (curgnum >= 0 && refgnum >= 0)
+          {
+            mutualinfo12[curgnum * featurecount2 + refgnum]++;
+            mutualinfo1[curgnum]++;
+            mutualinfo2[refgnum]++;
+            count++;
+          }
+        }
+        else
+        {
+          mutualinfo12[0]++;
+          mutualinfo1[0]++;
+          mutualinfo2[0]++;
+        }
+      }
+    }
+    for (int32_t b = 0; b < featurecount1; b++)
+    {
+      mutualinfo1[b] = mutualinfo1[b] / count;
+    }
+    for (int32_t c = 0; c < featurecount2; c++)
+    {
+      mutualinfo2[c] = mutualinfo2[c] / float(count);
+    }
+    for (int32_t b = 0; b < featurecount1; b++)
+    {
+      for (int32_t c = 0; c < featurecount2; c++)
+      {
+        float joint = mutualinfo12[b * featurecount2 + c] / count;
+        float value = 0.0f;
+        if (mutualinfo1[b] > 0 && mutualinfo2[c] > 0) { value = (joint / (mutualinfo1[b] * mutualinfo2[c])); }
+        if (value != 0) { disorientation = disorientation + (joint * logf(value)); }
+      }
+    }
+    return 1.0f / disorientation;
+  }
+}
+
+/**
+ * @brief The AlignSectionsMutualInformationShiftsImpl class finds the shift of a range of section
+ * pairs by cross correlating their feature boundaries and then searching the 7x7 window around the
+ * correlation peak for the highest mutual information
+ */
+class AlignSectionsMutualInformationShiftsImpl
+{
+  public:
+    AlignSectionsMutualInformationShiftsImpl(const SectionShiftCorrelator* correlator, int32_t* miFeatureIds, bool* boundaries, int32_t* featurecounts,
+                                             int64_t dims[3], int64_t* newxshifts, int64_t* newyshifts) :
+      m_Correlator(correlator),
+      m_MIFeatureIds(miFeatureIds),
+      m_Boundaries(boundaries),
+      m_FeatureCounts(featurecounts),
+      m_Newxshifts(newxshifts),
+      m_Newyshifts(newyshifts)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~AlignSectionsMutualInformationShiftsImpl() {}
+
+    void findShifts(int64_t start, int64_t end) const
+    {
+      int64_t sliceSize = m_Dims[0] * m_Dims[1];
+      std::vector<float> mutualinfo12;
+      std::vector<float> mutualinfo1;
+      std::vector<float> mutualinfo2;
+      for (int64_t iter = start; iter < end; iter++)
+      {
+        int64_t slice = (m_Dims[2] - 1) - iter;
+        int64_t peakxshift = 0;
+        int64_t peakyshift = 0;
+        m_Correlator->findBestShift(m_Boundaries + (slice + 1) * sliceSize, m_Boundaries + slice * sliceSize, peakxshift, peakyshift);
+
+        int64_t newxshift = peakxshift;
+        int64_t newyshift = peakyshift;
+        float mindisorientation = findInverseMutualInformation(m_MIFeatureIds, m_Dims, slice, peakxshift, peakyshift, m_FeatureCounts[slice], m_FeatureCounts[slice + 1],
+                                                               mutualinfo12, mutualinfo1, mutualinfo2);
+        for (int32_t j = -3; j < 4; j++)
+        {
+          for (int32_t k = -3; k < 4; k++)
+          {
+            int64_t xshift = peakxshift + k;
+            int64_t yshift = peakyshift + j;
+            if ((j == 0 && k == 0) || llabs(xshift) >= (m_Dims[0] / 2) || llabs(yshift) >= (m_Dims[1] / 2)) { continue; }
+            float disorientation = findInverseMutualInformation(m_MIFeatureIds, m_Dims, slice, xshift, yshift, m_FeatureCounts[slice], m_FeatureCounts[slice + 1],
+                                                                mutualinfo12, mutualinfo1, mutualinfo2);
+            if (disorientation < mindisorientation)
+            {
+              newxshift = xshift;
+              newyshift = yshift;
+              mindisorientation = disorientation;
+            }
+          }
+        }
+        m_Newxshifts[iter] = newxshift;
+        m_Newyshifts[iter] = newyshift;
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      findShifts(r.begin(), r.end());
+    }
+#endif
+  private:
+    const SectionShiftCorrelator* m_Correlator;
+    int32_t* m_MIFeatureIds;
+    bool* m_Boundaries;
+    int32_t* m_FeatureCounts;
+    int64_t m_Dims[3];
+    int64_t* m_Newxshifts;
+    int64_t* m_Newyshifts;
+};
 
 #include "moc_AlignSectionsMutualInformation.cpp"
 // -----------------------------------------------------------------------------
@@ -57,6 +211,7 @@ AlignSectionsMutualInformation::AlignSectionsMutualInformation() :
   AlignSections(),
   m_MisorientationTolerance(5.0f),
   m_UseGoodVoxels(true),
+  m_UseCrossCorrelation(false),
   m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats),
   m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases),
   m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask),
@@ -93,6 +248,7 @@ void AlignSectionsMutualInformation::setupFilterParameters()
   parameters.push_front(DoubleFilterParameter::New("Misorientation Tolerance", "MisorientationTolerance", getMisorientationTolerance(), FilterParameter::Parameter));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(LinkedBooleanFilterParameter::New("Use Mask Array", "UseGoodVoxels", getUseGoodVoxels(), linkedProps, FilterParameter::Parameter));
+  parameters.push_back(BooleanFilterParameter::New("Use Cross Correlation Shift Search", "UseCrossCorrelation", getUseCrossCorrelation(), FilterParameter::Parameter));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
@@ -124,6 +280,7 @@ void AlignSectionsMutualInformation::readFilterParameters(AbstractFilterParamete
   reader->openFilterGroup(this, index);
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath() ) );
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels() ) );
+  setUseCrossCorrelation(reader->readValue("UseCrossCorrelation", getUseCrossCorrelation() ) );
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath() ) );
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath() ) );
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath() ) );
@@ -141,6 +298,7 @@ int AlignSectionsMutualInformation::writeFilterParameters(AbstractFilterParamete
   SIMPL_FILTER_WRITE_PARAMETER(CrystalStructuresArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(GoodVoxelsArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(UseGoodVoxels)
+  SIMPL_FILTER_WRITE_PARAMETER(UseCrossCorrelation)
   SIMPL_FILTER_WRITE_PARAMETER(CellPhasesArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(QuatsArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(MisorientationTolerance)
@@ -243,25 +401,43 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
     static_cast<int64_t>(udims[2]),
   };
 
+  form_features_sections();
+
+  if (getUseCrossCorrelation() == true)
+  {
+    std::vector<int64_t> newxshifts(dims[2], 0);
+    std::vector<int64_t> newyshifts(dims[2], 0);
+    find_shifts_correlation(dims, newxshifts, newyshifts);
+    if (getCancel() == true) { return; }
+    for (int64_t iter = 1; iter < dims[2]; iter++)
+    {
+      int64_t slice = (dims[2] - 1) - iter;
+      xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+      yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
+      if (getWriteAlignmentShifts() == true)
+      {
+        outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      }
+    }
+    m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
+    if (getWriteAlignmentShifts() == true)
+    {
+      outFile.close();
+    }
+    return;
+  }
+
   float disorientation = 0.0f;
   float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = NULL;
-  float* mutualinfo1 = NULL;
-  float* mutualinfo2 = NULL;
-  int32_t featurecount1 = 0, featurecount2 = 0;
+  std::vector<float> mutualinfo12;
+  std::vector<float> mutualinfo1;
+  std::vector<float> mutualinfo2;
   int64_t newxshift = 0;
   int64_t newyshift = 0;
   int64_t oldxshift = 0;
   int64_t oldyshift = 0;
-  float count = 0.0f;
   int64_t slice = 0;
 
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
-  form_features_sections();
-
   std::vector<std::vector<float> >  misorients;
   misorients.resize(dims[0]);
   for (int64_t a = 0; a < dims[0]; a++)
@@ -276,22 +452,6 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
     mindisorientation = std::numeric_limits<float>::max();
     slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float *[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for (int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for (int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
     oldxshift = -1;
     oldyshift = -1;
     newxshift = 0;
@@ -311,71 +471,11 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       {
         for (int32_t k = -3; k < 4; k++)
         {
-          disorientation = 0;
-          count = 0;
           if (misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2)
               && (j + oldyshift) < (dims[1] / 2))
           {
-            for (int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for (int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if ((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if (curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for (int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if (mutualinfo1[b] != 0) { ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]); }
-            }
-            for (int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if (mutualinfo2[c] != 0) { hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]); }
-            }
-            for (int32_t b = 0; b < featurecount1; b++)
-            {
-              for (int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if (mutualinfo12[b][c] != 0) { hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]); }
-                float value = 0.0f;
-                if (mutualinfo1[b] > 0 && mutualinfo2[c] > 0) { value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c])); }
-                if (value != 0) { disorientation = disorientation + (mutualinfo12[b][c] * logf(value)); }
-              }
-            }
-            for (int32_t b = 0; b < featurecount1; b++)
-            {
-              for (int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
+            disorientation = findInverseMutualInformation(miFeatureIds, dims, slice, k + oldxshift, j + oldyshift, featurecounts[slice], featurecounts[slice + 1],
+                                                          mutualinfo12, mutualinfo1, mutualinfo2);
             misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
             if (disorientation < mindisorientation)
             {
@@ -393,16 +493,6 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
     {
       outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for (int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
-    }
-    delete[] mutualinfo12;
-    mutualinfo1 = NULL;
-    mutualinfo2 = NULL;
-    mutualinfo12 = NULL;
   }
 
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
@@ -413,6 +503,71 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsMutualInformation::find_shifts_correlation(int64_t dims[3], std::vector<int64_t>& newxshifts, std::vector<int64_t>& newyshifts)
+{
+  QString ss = QObject::tr("Aligning Sections || Determining Shifts by Cross Correlation");
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+  int32_t* miFeatureIds = m_MIFeaturesPtr->getPointer(0);
+
+  // A cell is on a boundary when its feature id differs from the next cell in X or Y
+  BoolArrayType::Pointer boundariesPtr = BoolArrayType::CreateArray(m_MIFeaturesPtr->getNumberOfTuples(), "_INTERNAL_USE_ONLY_MIBoundaries");
+  bool* boundaries = boundariesPtr->getPointer(0);
+  for (int64_t slice = 0; slice < dims[2]; slice++)
+  {
+    for (int64_t l = 0; l < dims[1]; l++)
+    {
+      for (int64_t n = 0; n < dims[0]; n++)
+      {
+        int64_t point = (slice * dims[0] * dims[1]) + (l * dims[0]) + n;
+        boundaries[point] = (n < dims[0] - 1 && miFeatureIds[point + 1] != miFeatureIds[point])
+                            || (l < dims[1] - 1 && miFeatureIds[point + dims[0]] != miFeatureIds[point]);
+      }
+    }
+  }
+
+  SectionShiftCorrelator correlator(dims[0], dims[1]);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Every pair that is compared at the same time holds its own zero padded transform
+  // buffer and mutual information tables, the joint one featurecount1 * featurecount2
+  // floats, so the pairs run in batches that keep that memory bounded. The batches are
+  // sized for the largest tables of any pair.
+  size_t tableBytes = 0;
+  for (int64_t slice = 0; slice < dims[2] - 1; slice++)
+  {
+    size_t featurecount1 = static_cast<size_t>(featurecounts[slice]);
+    size_t featurecount2 = static_cast<size_t>(featurecounts[slice + 1]);
+    size_t bytes = (featurecount1 * featurecount2 + featurecount1 + featurecount2) * sizeof(float);
+    if (bytes > tableBytes) { tableBytes = bytes; }
+  }
+  int64_t batchSize = correlator.getMaxConcurrentPairs(1024 * 1024 * 1024, tableBytes);
+  for (int64_t batchStart = 1; batchStart < dims[2]; batchStart += batchSize)
+  {
+    if (getCancel() == true) { return; }
+    int64_t batchEnd = std::min(batchStart + batchSize, dims[2]);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<int64_t>(batchStart, batchEnd, 1),
+                        AlignSectionsMutualInformationShiftsImpl(&correlator, miFeatureIds, boundaries, featurecounts, dims, &(newxshifts.front()), &(newyshifts.front())), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      AlignSectionsMutualInformationShiftsImpl serial(&correlator, miFeatureIds, boundaries, featurecounts, dims, &(newxshifts.front()), &(newyshifts.front()));
+      serial.findShifts(batchStart, batchEnd);
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
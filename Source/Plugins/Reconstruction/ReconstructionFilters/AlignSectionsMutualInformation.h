@@ -66,6 +66,9 @@ class AlignSectionsMutualInformation : public AlignSections
     SIMPL_FILTER_PARAMETER(bool, UseGoodVoxels)
     Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+    SIMPL_FILTER_PARAMETER(bool, UseCrossCorrelation)
+    Q_PROPERTY(bool UseCrossCorrelation READ getUseCrossCorrelation WRITE setUseCrossCorrelation)
+
     SIMPL_FILTER_PARAMETER(DataArrayPath, QuatsArrayPath)
     Q_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
 
@@ -160,6 +163,16 @@ class AlignSectionsMutualInformation : public AlignSections
      */
     virtual void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts);
 
+    /**
+     * @brief find_shifts_correlation Locates the shift of every section pair by cross correlating the
+     * boundaries of the section features and then refines it with the mutual information in a 7x7 window
+     * around the correlation peak. The section pairs are processed in parallel.
+     * @param dims The dimensions of the image geometry
+     * @param newxshifts The X shift of section (dims[2] - 1 - iter) relative to the next section, stored at iter
+     * @param newyshifts The Y shift of section (dims[2] - 1 - iter) relative to the next section, stored at iter
+     */
+    void find_shifts_correlation(int64_t dims[3], std::vector<int64_t>& newxshifts, std::vector<int64_t>& newyshifts);
+
     /**
      * @brief form_features_sections Determines the existing features in a give slice
      */
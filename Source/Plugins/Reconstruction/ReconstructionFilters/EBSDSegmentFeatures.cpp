@@ -48,6 +48,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
+
 #include "Reconstruction/ReconstructionConstants.h"
 
 // Include the MOC generated file for this class
@@ -354,17 +356,11 @@ bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neig
   if (m_FeatureIds[neighborpoint] == 0 && (m_UseGoodVoxels == false || m_GoodVoxels[neighborpoint] == true))
   {
     float w = std::numeric_limits<float>::max();
-    QuatF q1 = QuaternionMathF::New();
-    QuatF q2 = QuaternionMathF::New();
     QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-
-    QuaternionMathF::Copy(quats[referencepoint], q1);
-    QuaternionMathF::Copy(quats[neighborpoint], q2);
 
     if (m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
     {
-      w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+      w = LaueMisorientationAngle(phase1, quats[referencepoint], quats[neighborpoint]);
     }
     if (w < m_MisoTolerance)
     {
@@ -0,0 +1,321 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "SectionShiftCorrelator.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+namespace
+{
+  /**
+   * @brief Returns the smallest power of two that is >= value
+   */
+  size_t nextPowerOfTwo(size_t value)
+  {
+    size_t n = 1;
+    while (n < value) { n = n << 1; }
+    return n;
+  }
+
+  /**
+   * @brief Fills the twiddle factors exp(-2 pi i k / n) for k < n / 2
+   */
+  void fillTwiddles(size_t n, std::vector<std::complex<double> >& twiddles)
+  {
+    twiddles.resize(n / 2);
+    for (size_t k = 0; k < n / 2; k++)
+    {
+      double angle = -SIMPLib::Constants::k_2Pi * static_cast<double>(k) / static_cast<double>(n);
+      twiddles[k] = std::complex<double>(cos(angle), sin(angle));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SectionShiftCorrelator::SectionShiftCorrelator(int64_t xDim, int64_t yDim) :
+  m_XDim(xDim),
+  m_YDim(yDim),
+  m_MaxXShift(xDim / 2 > 0 ? xDim / 2 - 1 : 0),
+  m_MaxYShift(yDim / 2 > 0 ? yDim / 2 - 1 : 0)
+{
+  // Padding to at least dim + maxShift keeps the circular correlation from wrapping
+  // into the shifts that are searched
+  m_XPadded = nextPowerOfTwo(static_cast<size_t>(m_XDim + m_MaxXShift));
+  m_YPadded = nextPowerOfTwo(static_cast<size_t>(m_YDim + m_MaxYShift));
+  fillTwiddles(m_XPadded, m_XTwiddles);
+  fillTwiddles(m_YPadded, m_YTwiddles);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SectionShiftCorrelator::~SectionShiftCorrelator()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t SectionShiftCorrelator::getMaxXShift() const
+{
+  return m_MaxXShift;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t SectionShiftCorrelator::getMaxYShift() const
+{
+  return m_MaxYShift;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SectionShiftCorrelator::transform(std::complex<double>* data, size_t n, size_t stride, const std::vector<std::complex<double> >& twiddles, bool inverse) const
+{
+  // Bit reversal permutation
+  for (size_t i = 1, j = 0; i < n; i++)
+  {
+    size_t bit = n >> 1;
+    for (; (j & bit) != 0; bit = bit >> 1)
+    {
+      j = j ^ bit;
+    }
+    j = j ^ bit;
+    if (i < j) { std::swap(data[i * stride], data[j * stride]); }
+  }
+
+  for (size_t len = 2; len <= n; len = len << 1)
+  {
+    size_t half = len >> 1;
+    size_t step = n / len;
+    for (size_t i = 0; i < n; i += len)
+    {
+      for (size_t k = 0; k < half; k++)
+      {
+        std::complex<double> w = twiddles[k * step];
+        if (inverse == true) { w = std::conj(w); }
+        std::complex<double>& a = data[(i + k) * stride];
+        std::complex<double>& b = data[(i + k + half) * stride];
+        std::complex<double> t = w * b;
+        b = a - t;
+        a = a + t;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SectionShiftCorrelator::transform2D(std::vector<std::complex<double> >& data, size_t rows, bool inverse) const
+{
+  for (size_t l = 0; l < rows; l++)
+  {
+    transform(&(data[l * m_XPadded]), m_XPadded, 1, m_XTwiddles, inverse);
+  }
+
+  // The columns are copied out so the butterflies run over contiguous memory
+  std::vector<std::complex<double> > column(m_YPadded);
+  for (size_t n = 0; n < m_XPadded; n++)
+  {
+    for (size_t l = 0; l < m_YPadded; l++)
+    {
+      column[l] = data[l * m_XPadded + n];
+    }
+    transform(&(column.front()), m_YPadded, 1, m_YTwiddles, inverse);
+    for (size_t l = 0; l < m_YPadded; l++)
+    {
+      data[l * m_XPadded + n] = column[l];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SectionShiftCorrelator::sumTable(const bool* section, std::vector<int64_t>& table) const
+{
+  int64_t width = m_XDim + 1;
+  table.assign(width * (m_YDim + 1), 0);
+  for (int64_t l = 0; l < m_YDim; l++)
+  {
+    int64_t rowSum = 0;
+    for (int64_t n = 0; n < m_XDim; n++)
+    {
+      if (section[l * m_XDim + n] == true) { rowSum++; }
+      table[(l + 1) * width + n + 1] = table[l * width + n + 1] + rowSum;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t SectionShiftCorrelator::boxSum(const std::vector<int64_t>& table, int64_t x0, int64_t x1, int64_t y0, int64_t y1) const
+{
+  int64_t width = m_XDim + 1;
+  return table[y1 * width + x1] - table[y0 * width + x1] - table[y1 * width + x0] + table[y0 * width + x0];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SectionShiftCorrelator::computeMismatchFractions(const bool* reference, const bool* current, std::vector<float>& fractions) const
+{
+  size_t paddedSize = m_XPadded * m_YPadded;
+
+  // Both real sections are packed into one complex buffer (reference + i * current) so a
+  // single forward transform yields the spectra of both
+  std::vector<std::complex<double> > packed(paddedSize, std::complex<double>(0.0, 0.0));
+  for (int64_t l = 0; l < m_YDim; l++)
+  {
+    for (int64_t n = 0; n < m_XDim; n++)
+    {
+      packed[l * m_XPadded + n] = std::complex<double>(reference[l * m_XDim + n] ? 1.0 : 0.0, current[l * m_XDim + n] ? 1.0 : 0.0);
+    }
+  }
+  transform2D(packed, static_cast<size_t>(m_YDim), false);
+
+  // conj(R) * C is the spectrum of sum_n r[n] * c[n + s]. Both sections are real so the
+  // value at the mirrored frequency is the conjugate and each pair is replaced in place
+  for (size_t ky = 0; ky < m_YPadded; ky++)
+  {
+    size_t kyMirror = (m_YPadded - ky) % m_YPadded;
+    for (size_t kx = 0; kx < m_XPadded; kx++)
+    {
+      size_t kxMirror = (m_XPadded - kx) % m_XPadded;
+      size_t index = ky * m_XPadded + kx;
+      size_t mirror = kyMirror * m_XPadded + kxMirror;
+      if (mirror < index) { continue; }
+      std::complex<double> z = packed[index];
+      std::complex<double> zMirror = std::conj(packed[mirror]);
+      std::complex<double> r = 0.5 * (z + zMirror);
+      std::complex<double> c = std::complex<double>(0.0, -0.5) * (z - zMirror);
+      std::complex<double> product = std::conj(r) * c;
+      packed[index] = product;
+      packed[mirror] = std::conj(product);
+    }
+  }
+  transform2D(packed, m_YPadded, true);
+
+  std::vector<int64_t> referenceTable;
+  std::vector<int64_t> currentTable;
+  sumTable(reference, referenceTable);
+  sumTable(current, currentTable);
+
+  int64_t xWidth = 2 * m_MaxXShift + 1;
+  int64_t yWidth = 2 * m_MaxYShift + 1;
+  double scale = 1.0 / static_cast<double>(paddedSize);
+  fractions.resize(xWidth * yWidth);
+  for (int64_t dy = -m_MaxYShift; dy <= m_MaxYShift; dy++)
+  {
+    int64_t y0 = dy < 0 ? -dy : 0;
+    int64_t y1 = dy > 0 ? m_YDim - dy : m_YDim;
+    size_t wrappedY = static_cast<size_t>(dy < 0 ? dy + static_cast<int64_t>(m_YPadded) : dy);
+    for (int64_t dx = -m_MaxXShift; dx <= m_MaxXShift; dx++)
+    {
+      int64_t x0 = dx < 0 ? -dx : 0;
+      int64_t x1 = dx > 0 ? m_XDim - dx : m_XDim;
+      size_t wrappedX = static_cast<size_t>(dx < 0 ? dx + static_cast<int64_t>(m_XPadded) : dx);
+      // The correlation of two 0/1 sections is an integer, rounding removes the transform error
+      int64_t both = static_cast<int64_t>(floor(packed[wrappedY * m_XPadded + wrappedX].real() * scale + 0.5));
+      int64_t referenceCount = boxSum(referenceTable, x0, x1, y0, y1);
+      int64_t currentCount = boxSum(currentTable, x0 + dx, x1 + dx, y0 + dy, y1 + dy);
+      int64_t mismatches = referenceCount + currentCount - 2 * both;
+      int64_t count = (x1 - x0) * (y1 - y0);
+      fractions[(dy + m_MaxYShift) * xWidth + dx + m_MaxXShift] = static_cast<float>(mismatches) / static_cast<float>(count);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SectionShiftCorrelator::findBestShift(const bool* reference, const bool* current, int64_t& xShift, int64_t& yShift) const
+{
+  std::vector<float> fractions;
+  computeMismatchFractions(reference, current, fractions);
+
+  int64_t xWidth = 2 * m_MaxXShift + 1;
+  float minFraction = std::numeric_limits<float>::max();
+  int64_t minDistance = std::numeric_limits<int64_t>::max();
+  xShift = 0;
+  yShift = 0;
+  for (int64_t dy = -m_MaxYShift; dy <= m_MaxYShift; dy++)
+  {
+    for (int64_t dx = -m_MaxXShift; dx <= m_MaxXShift; dx++)
+    {
+      float fraction = fractions[(dy + m_MaxYShift) * xWidth + dx + m_MaxXShift];
+      int64_t distance = dx * dx + dy * dy;
+      if (fraction < minFraction || (fraction == minFraction && distance < minDistance))
+      {
+        minFraction = fraction;
+        minDistance = distance;
+        xShift = dx;
+        yShift = dy;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SectionShiftCorrelator::getWorkingMemorySize() const
+{
+  size_t transformBytes = m_XPadded * m_YPadded * sizeof(std::complex<double>) + m_YPadded * sizeof(std::complex<double>);
+  size_t tableBytes = 2 * static_cast<size_t>((m_XDim + 1) * (m_YDim + 1)) * sizeof(int64_t);
+  size_t fractionBytes = static_cast<size_t>((2 * m_MaxXShift + 1) * (2 * m_MaxYShift + 1)) * sizeof(float);
+  return transformBytes + tableBytes + fractionBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t SectionShiftCorrelator::getMaxConcurrentPairs(size_t memoryBudget, size_t extraBytesPerPair) const
+{
+  size_t pairs = memoryBudget / (getWorkingMemorySize() + extraBytesPerPair);
+  return pairs > 0 ? static_cast<int64_t>(pairs) : 1;
+}
@@ -0,0 +1,135 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _sectionshiftcorrelator_h_
+#define _sectionshiftcorrelator_h_
+
+#include <complex>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The SectionShiftCorrelator class compares two boolean sections of an image
+ * geometry for every integer shift at once. For a shift (dx, dy) the cell (n, l) of the
+ * reference section is paired with the cell (n + dx, l + dy) of the current section and
+ * the mismatch fraction is the number of pairs with different values divided by the number
+ * of overlapping pairs. The products of the two sections are summed for all shifts with a
+ * zero padded 2D FFT cross correlation and the per shift cell totals come from summed area
+ * tables, so the whole surface costs a few transforms instead of one pass per shift.
+ */
+class SectionShiftCorrelator
+{
+  public:
+    /**
+     * @param xDim The X dimension of a section
+     * @param yDim The Y dimension of a section
+     */
+    SectionShiftCorrelator(int64_t xDim, int64_t yDim);
+    virtual ~SectionShiftCorrelator();
+
+    /**
+     * @brief Shifts are searched for -getMaxXShift() <= dx <= getMaxXShift(), which keeps
+     * at least half of the section overlapping. The Y range is handled the same way.
+     */
+    int64_t getMaxXShift() const;
+    int64_t getMaxYShift() const;
+
+    /**
+     * @brief computeMismatchFractions Fills fractions with the mismatch fraction of every shift.
+     * The value for (dx, dy) is stored at (dy + getMaxYShift()) * (2 * getMaxXShift() + 1) + dx + getMaxXShift()
+     * @param reference The reference section, xDim * yDim values in X fastest order
+     * @param current The section that is shifted against the reference
+     * @param fractions Output surface
+     */
+    void computeMismatchFractions(const bool* reference, const bool* current, std::vector<float>& fractions) const;
+
+    /**
+     * @brief findBestShift Returns the shift with the lowest mismatch fraction. Ties go to the
+     * shift closest to (0, 0).
+     */
+    void findBestShift(const bool* reference, const bool* current, int64_t& xShift, int64_t& yShift) const;
+
+    /**
+     * @brief getWorkingMemorySize Returns the number of bytes one call of computeMismatchFractions()
+     * allocates. Most of it is the zero padded complex transform buffer.
+     */
+    size_t getWorkingMemorySize() const;
+
+    /**
+     * @brief getMaxConcurrentPairs Returns how many section pairs may be compared at the same time
+     * for their working memory to stay within memoryBudget bytes. Always at least 1.
+     * @param memoryBudget
+     * @param extraBytesPerPair Memory the caller needs for each pair on top of getWorkingMemorySize()
+     */
+    int64_t getMaxConcurrentPairs(size_t memoryBudget = 1024 * 1024 * 1024, size_t extraBytesPerPair = 0) const;
+
+  private:
+    int64_t m_XDim;
+    int64_t m_YDim;
+    int64_t m_MaxXShift;
+    int64_t m_MaxYShift;
+    size_t m_XPadded;
+    size_t m_YPadded;
+    std::vector<std::complex<double> > m_XTwiddles;
+    std::vector<std::complex<double> > m_YTwiddles;
+
+    /**
+     * @brief transform Runs an in place radix-2 FFT over n values that are stride apart
+     */
+    void transform(std::complex<double>* data, size_t n, size_t stride, const std::vector<std::complex<double> >& twiddles, bool inverse) const;
+
+    /**
+     * @brief transform2D Runs the FFT over the first rows rows and then every column of a padded buffer.
+     * Rows past rows must be zero.
+     */
+    void transform2D(std::vector<std::complex<double> >& data, size_t rows, bool inverse) const;
+
+    /**
+     * @brief sumTable Builds an inclusive summed area table of a section with a zero border
+     */
+    void sumTable(const bool* section, std::vector<int64_t>& table) const;
+
+    /**
+     * @brief boxSum Returns the sum of the cells x0 <= n < x1, y0 <= l < y1 from a summed area table
+     */
+    int64_t boxSum(const std::vector<int64_t>& table, int64_t x0, int64_t x1, int64_t y0, int64_t y1) const;
+
+    SectionShiftCorrelator(const SectionShiftCorrelator&); // Copy Constructor Not Implemented
+    void operator=(const SectionShiftCorrelator&); // Operator '=' Not Implemented
+};
+
+#endif /* _sectionshiftcorrelator_h_ */
@@ -58,5 +58,9 @@ foreach(f ${_PrivateFilters} )
                         ${${PLUGIN_NAME}_SOURCE_DIR}/Documentation/${_filterGroupName}/${f}.md FALSE ${${PLUGIN_NAME}_BINARY_DIR})
 endforeach()
 
+# These are files that need to be compiled into the plugin but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER(${Reconstruction_SOURCE_DIR} ${_filterGroupName} SectionShiftCorrelator.h)
+ADD_SIMPL_SUPPORT_SOURCE(${Reconstruction_SOURCE_DIR} ${_filterGroupName} SectionShiftCorrelator.cpp)
+
 SIMPL_END_FILTER_GROUP(${Reconstruction_BINARY_DIR} "${_filterGroupName}" "Reconstruction Filters")
 
@@ -0,0 +1,206 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "Reconstruction/ReconstructionFilters/SectionShiftCorrelator.h"
+
+#include "ReconstructionTestFileLocations.h"
+
+class SectionShiftCorrelatorTest
+{
+  public:
+    SectionShiftCorrelatorTest(){}
+    virtual ~SectionShiftCorrelatorTest(){}
+    SIMPL_TYPE_MACRO(SectionShiftCorrelatorTest)
+
+    // -----------------------------------------------------------------------------
+    // Random section with the given fraction of true cells
+    // -----------------------------------------------------------------------------
+    std::vector<bool> CreateSection(int64_t xDim, int64_t yDim, uint32_t& seed, uint32_t percentTrue)
+    {
+      std::vector<bool> section(xDim * yDim, false);
+      for (size_t i = 0; i < section.size(); i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        section[i] = ((seed >> 16) % 100) < percentTrue;
+      }
+      return section;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Pairs the cell (n, l) of the reference with the cell (n + dx, l + dy) of the current section
+    // -----------------------------------------------------------------------------
+    float BruteForceFraction(const bool* reference, const bool* current, int64_t xDim, int64_t yDim, int64_t dx, int64_t dy)
+    {
+      int64_t mismatches = 0;
+      int64_t count = 0;
+      for (int64_t l = 0; l < yDim; l++)
+      {
+        for (int64_t n = 0; n < xDim; n++)
+        {
+          if (n + dx < 0 || n + dx >= xDim || l + dy < 0 || l + dy >= yDim) { continue; }
+          if (reference[l * xDim + n] != current[(l + dy) * xDim + n + dx]) { mismatches++; }
+          count++;
+        }
+      }
+      return static_cast<float>(mismatches) / static_cast<float>(count);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int CompareSurface(int64_t xDim, int64_t yDim, uint32_t referencePercent, uint32_t currentPercent)
+    {
+      uint32_t seed = static_cast<uint32_t>(xDim * 131 + yDim);
+      std::vector<bool> referenceBits = CreateSection(xDim, yDim, seed, referencePercent);
+      std::vector<bool> currentBits = CreateSection(xDim, yDim, seed, currentPercent);
+      std::vector<char> reference(referenceBits.begin(), referenceBits.end());
+      std::vector<char> current(currentBits.begin(), currentBits.end());
+      bool* referencePtr = reinterpret_cast<bool*>(&(reference.front()));
+      bool* currentPtr = reinterpret_cast<bool*>(&(current.front()));
+
+      SectionShiftCorrelator correlator(xDim, yDim);
+      int64_t maxX = correlator.getMaxXShift();
+      int64_t maxY = correlator.getMaxYShift();
+      DREAM3D_REQUIRE_EQUAL(maxX, (xDim / 2 > 0) ? xDim / 2 - 1 : 0)
+      DREAM3D_REQUIRE_EQUAL(maxY, (yDim / 2 > 0) ? yDim / 2 - 1 : 0)
+
+      std::vector<float> fractions;
+      correlator.computeMismatchFractions(referencePtr, currentPtr, fractions);
+      DREAM3D_REQUIRE_EQUAL(fractions.size(), static_cast<size_t>((2 * maxX + 1) * (2 * maxY + 1)))
+      for (int64_t dy = -maxY; dy <= maxY; dy++)
+      {
+        for (int64_t dx = -maxX; dx <= maxX; dx++)
+        {
+          float expected = BruteForceFraction(referencePtr, currentPtr, xDim, yDim, dx, dy);
+          DREAM3D_REQUIRE_EQUAL(fractions[(dy + maxY) * (2 * maxX + 1) + dx + maxX], expected)
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Sizes that are and are not powers of two, thin sections that have no shifts
+    // along one axis and sections that are almost empty or almost full
+    // -----------------------------------------------------------------------------
+    int TestMismatchSurface()
+    {
+      DREAM3D_REQUIRE_EQUAL(CompareSurface(13, 9, 50, 50), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(CompareSurface(16, 16, 30, 60), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(CompareSurface(37, 3, 50, 40), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(CompareSurface(1, 11, 50, 50), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(CompareSurface(24, 20, 2, 97), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(CompareSurface(64, 48, 50, 50), EXIT_SUCCESS)
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The current section is the reference moved by (xShift, yShift) with random cells
+    // in the part that is uncovered, so that shift is the only one without mismatches
+    // -----------------------------------------------------------------------------
+    int TestPlantedShift()
+    {
+      const int64_t xDim = 40;
+      const int64_t yDim = 32;
+      const int64_t shifts[6][2] = { { 0, 0 }, { 3, -2 }, { -7, 5 }, { 19, 0 }, { -19, -15 }, { 1, 15 } };
+      SectionShiftCorrelator correlator(xDim, yDim);
+      uint32_t seed = 12;
+      for (int32_t s = 0; s < 6; s++)
+      {
+        std::vector<bool> referenceBits = CreateSection(xDim, yDim, seed, 50);
+        std::vector<bool> currentBits = CreateSection(xDim, yDim, seed, 50);
+        for (int64_t l = 0; l < yDim; l++)
+        {
+          for (int64_t n = 0; n < xDim; n++)
+          {
+            int64_t sn = n + shifts[s][0];
+            int64_t sl = l + shifts[s][1];
+            if (sn < 0 || sn >= xDim || sl < 0 || sl >= yDim) { continue; }
+            currentBits[sl * xDim + sn] = referenceBits[l * xDim + n];
+          }
+        }
+        std::vector<char> reference(referenceBits.begin(), referenceBits.end());
+        std::vector<char> current(currentBits.begin(), currentBits.end());
+
+        int64_t xShift = 100;
+        int64_t yShift = 100;
+        correlator.findBestShift(reinterpret_cast<bool*>(&(reference.front())), reinterpret_cast<bool*>(&(current.front())), xShift, yShift);
+        DREAM3D_REQUIRE_EQUAL(xShift, shifts[s][0])
+        DREAM3D_REQUIRE_EQUAL(yShift, shifts[s][1])
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestMaxConcurrentPairs()
+    {
+      SectionShiftCorrelator correlator(100, 60);
+      size_t bytes = correlator.getWorkingMemorySize();
+      // 150 and 90 padded to 256 and 128
+      DREAM3D_REQUIRED(bytes, >=, static_cast<size_t>(256 * 128 * 16))
+      DREAM3D_REQUIRE_EQUAL(correlator.getMaxConcurrentPairs(0), 1)
+      DREAM3D_REQUIRE_EQUAL(correlator.getMaxConcurrentPairs(bytes - 1), 1)
+      DREAM3D_REQUIRE_EQUAL(correlator.getMaxConcurrentPairs(10 * bytes + 5), 10)
+      // Memory the caller needs for each pair counts against the same budget
+      DREAM3D_REQUIRE_EQUAL(correlator.getMaxConcurrentPairs(10 * bytes + 5, bytes), 5)
+      DREAM3D_REQUIRE_EQUAL(correlator.getMaxConcurrentPairs(bytes, 1), 1)
+      return EXIT_SUCCESS;
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestMismatchSurface())
+      DREAM3D_REGISTER_TEST(TestPlantedShift())
+      DREAM3D_REGISTER_TEST(TestMaxConcurrentPairs())
+    }
+
+  private:
+    SectionShiftCorrelatorTest(const SectionShiftCorrelatorTest&); // Copy Constructor Not Implemented
+    void operator=(const SectionShiftCorrelatorTest&); // Operator '=' Not Implemented
+};
@@ -44,10 +44,12 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/ResampleEngine.h"
 
 // Include the MOC generated file for this class
 #include "moc_ChangeResolution.cpp"
@@ -65,7 +67,13 @@ ChangeResolution::ChangeResolution() :
   m_RenumberFeatures(true),
   m_SaveAsNewDataContainer(false),
   m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds),
-  m_FeatureIds(NULL)
+  m_Interpolation(NearestNeighbor),
+  m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats),
+  m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases),
+  m_CrystalStructuresArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures),
+  m_FeatureIds(NULL),
+  m_CellPhases(NULL),
+  m_CrystalStructures(NULL)
 {
   m_Resolution.x = 1.0f;
   m_Resolution.y = 1.0f;
@@ -88,6 +96,24 @@ void ChangeResolution::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(FloatVec3FilterParameter::New("Resolution", "Resolution", getResolution(), FilterParameter::Parameter));
+  {
+    LinkedChoicesFilterParameter::Pointer parameter = LinkedChoicesFilterParameter::New();
+    parameter->setHumanLabel("Interpolation");
+    parameter->setPropertyName("Interpolation");
+
+    parameter->setDefaultValue(NearestNeighbor);
+
+    QVector<QString> choices;
+    choices.push_back("Nearest Neighbor");
+    choices.push_back("Smooth");
+    parameter->setChoices(choices);
+    QStringList linkedProps;
+    linkedProps << "QuatsArrayPath" << "CellPhasesArrayPath" << "CrystalStructuresArrayPath";
+    parameter->setLinkedProperties(linkedProps);
+    parameter->setEditable(false);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
   QStringList linkedProps;
   linkedProps << "CellFeatureAttributeMatrixPath" << "FeatureIdsArrayPath";
   parameters.push_back(LinkedBooleanFilterParameter::New("Renumber Features", "RenumberFeatures", getRenumberFeatures(), linkedProps, FilterParameter::Parameter));
@@ -103,6 +129,19 @@ void ChangeResolution::setupFilterParameters()
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
     parameters.push_back(DataArraySelectionFilterParameter::New("Feature Ids", "FeatureIdsArrayPath", getFeatureIdsArrayPath(), FilterParameter::RequiredArray, req));
   }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(DataArraySelectionFilterParameter::New("Quaternions", "QuatsArrayPath", getQuatsArrayPath(), FilterParameter::RequiredArray, req, Smooth));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(DataArraySelectionFilterParameter::New("Phases", "CellPhasesArrayPath", getCellPhasesArrayPath(), FilterParameter::RequiredArray, req, Smooth));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Cell Ensemble Data", FilterParameter::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::UInt32, 1, SIMPL::AttributeMatrixType::CellEnsemble, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(DataArraySelectionFilterParameter::New("Crystal Structures", "CrystalStructuresArrayPath", getCrystalStructuresArrayPath(), FilterParameter::RequiredArray, req, Smooth));
+  }
   parameters.push_back(SeparatorFilterParameter::New("Cell Feature Data", FilterParameter::RequiredArray));
   {
     AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(SIMPL::AttributeMatrixType::CellFeature, SIMPL::GeometryType::ImageGeometry);
@@ -125,6 +164,10 @@ void ChangeResolution::readFilterParameters(AbstractFilterParametersReader* read
   setResolution( reader->readFloatVec3("Resolution", getResolution() ) );
   setRenumberFeatures( reader->readValue("RenumberFeatures", getRenumberFeatures()) );
   setSaveAsNewDataContainer( reader->readValue("SaveAsNewDataContainer", getSaveAsNewDataContainer()) );
+  setInterpolation( reader->readValue("Interpolation", getInterpolation()) );
+  setQuatsArrayPath( reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath() ) );
+  setCellPhasesArrayPath( reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath() ) );
+  setCrystalStructuresArrayPath( reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath() ) );
   reader->closeFilterGroup();
 }
 
@@ -142,6 +185,10 @@ int ChangeResolution::writeFilterParameters(AbstractFilterParametersWriter* writ
   SIMPL_FILTER_WRITE_PARAMETER(Resolution)
   SIMPL_FILTER_WRITE_PARAMETER(RenumberFeatures)
   SIMPL_FILTER_WRITE_PARAMETER(SaveAsNewDataContainer)
+  SIMPL_FILTER_WRITE_PARAMETER(Interpolation)
+  SIMPL_FILTER_WRITE_PARAMETER(QuatsArrayPath)
+  SIMPL_FILTER_WRITE_PARAMETER(CellPhasesArrayPath)
+  SIMPL_FILTER_WRITE_PARAMETER(CrystalStructuresArrayPath)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -201,6 +248,33 @@ void ChangeResolution::dataCheck()
     if( NULL != m_FeatureIdsPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
     { m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
   }
+
+  // An empty Quaternions selection means there is no orientation data to average. Averaging
+  // quaternions needs the phase of every Cell and the crystal structure of every phase
+  if (getInterpolation() == Smooth && getQuatsArrayPath().getDataArrayName().isEmpty() == false)
+  {
+    if (getQuatsArrayPath().getDataContainerName() != getCellAttributeMatrixPath().getDataContainerName()
+        || getQuatsArrayPath().getAttributeMatrixName() != getCellAttributeMatrixPath().getAttributeMatrixName()
+        || getCellPhasesArrayPath().getDataContainerName() != getCellAttributeMatrixPath().getDataContainerName()
+        || getCellPhasesArrayPath().getAttributeMatrixName() != getCellAttributeMatrixPath().getAttributeMatrixName())
+    {
+      QString ss = QObject::tr("The Quaternions and Phases arrays must be stored in the selected Cell Attribute Matrix");
+      setErrorCondition(-5558);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    QVector<size_t> cDims(1, 4);
+    getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getQuatsArrayPath(), cDims);
+
+    cDims[0] = 1;
+    m_CellPhasesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getCellPhasesArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_CellPhasesPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_CellPhases = m_CellPhasesPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+    m_CrystalStructuresPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter>(this, getCrystalStructuresArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_CrystalStructuresPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_CrystalStructures = m_CrystalStructuresPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -330,70 +404,72 @@ void ChangeResolution::execute()
   if (m_ZP == 0) { m_ZP = 1; }
   size_t totalPoints = m_XP * m_YP * m_ZP;
 
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  size_t col = 0, row = 0, plane = 0;
-  size_t index = 0;
-  size_t index_old = 0 ;
-  size_t progressInt = 0;
-  std::vector<size_t> newindicies(totalPoints);
   float res[3] = { 0.0f, 0.0f, 0.0f };
   m->getGeometryAs<ImageGeom>()->getResolution(res);
 
-  for (size_t i = 0; i < m_ZP; i++)
+  size_t newDims[3] = { m_XP, m_YP, m_ZP };
+  ResampleEngine engine(dims, newDims);
+  std::vector<int64_t> newindicies;
+
+  if (m_Interpolation == Smooth)
   {
-    if (getCancel() == true) { break; }
-    progressInt = static_cast<size_t>((static_cast<float>(i) / m_ZP) * 100.0f);
-    QString ss = QObject::tr("Changing Resolution || %1% Complete").arg(progressInt);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    for (size_t j = 0; j < m_YP; j++)
+    // Labels are voted on, floating point data is interpolated and orientations are averaged
+    float scale[3] = { m_Resolution.x / res[0], m_Resolution.y / res[1], m_Resolution.z / res[2] };
+    engine.setScaling(scale);
+    QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+    for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
     {
-      for (size_t k = 0; k < m_XP; k++)
+      engine.setInterpolationType(*iter, ResampleEngine::SmoothInterpolationType(cellAttrMat->getAttributeArray(*iter)));
+    }
+    if (getQuatsArrayPath().getDataArrayName().isEmpty() == false)
+    {
+      engine.setInterpolationType(getQuatsArrayPath().getDataArrayName(), ResampleEngine::QuaternionAverage);
+      engine.setOrientationData(m_CellPhasesPtr.lock(), m_CrystalStructuresPtr.lock());
+    }
+  }
+  else
+  {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    size_t col = 0, row = 0, plane = 0;
+    size_t index = 0;
+    size_t index_old = 0 ;
+    size_t progressInt = 0;
+    newindicies.resize(totalPoints);
+
+    for (size_t i = 0; i < m_ZP; i++)
+    {
+      if (getCancel() == true) { return; }
+      progressInt = static_cast<size_t>((static_cast<float>(i) / m_ZP) * 100.0f);
+      QString ss = QObject::tr("Changing Resolution || %1% Complete").arg(progressInt);
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      for (size_t j = 0; j < m_YP; j++)
       {
-        x = (k * m_Resolution.x);
-        y = (j * m_Resolution.y);
-        z = (i * m_Resolution.z);
-        col = size_t(x / res[0]);
-        row = size_t(y / res[1]);
-        plane = size_t(z / res[2]);
-        index_old = (plane * dims[1] * dims[0]) + (row * dims[0]) + col;
-        index = (i * m_XP * m_YP) + (j * m_XP) + k;
-        newindicies[index] = index_old;
+        for (size_t k = 0; k < m_XP; k++)
+        {
+          x = (k * m_Resolution.x);
+          y = (j * m_Resolution.y);
+          z = (i * m_Resolution.z);
+          col = size_t(x / res[0]);
+          row = size_t(y / res[1]);
+          plane = size_t(z / res[2]);
+          index_old = (plane * dims[1] * dims[0]) + (row * dims[0]) + col;
+          index = (i * m_XP * m_YP) + (j * m_XP) + k;
+          newindicies[index] = static_cast<int64_t>(index_old);
+        }
       }
     }
+    engine.setIndexMap(&(newindicies.front()));
   }
 
-  QString ss = QObject::tr("Copying Data...");
-  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-
   QVector<size_t> tDims(3, 0);
   tDims[0] = m_XP;
   tDims[1] = m_YP;
   tDims[2] = m_ZP;
   AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
 
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-  {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory.
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resize(totalPoints);
-    void* source = NULL;
-    void* destination = NULL;
-    size_t newIndicies_I = 0;
-    int32_t nComp = data->getNumberOfComponents();
-    for (size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-      source = p->getVoidPointer((nComp * newIndicies_I));
-      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->addAttributeArray(*iter, data);
-  }
+  engine.resampleAttributeMatrix(cellAttrMat, newCellAttrMat, this);
+  if (getCancel() == true) { return; }
+
   m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x, m_Resolution.y, m_Resolution.z);
   m->getGeometryAs<ImageGeom>()->setDimensions(m_XP, m_YP, m_ZP);
   m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
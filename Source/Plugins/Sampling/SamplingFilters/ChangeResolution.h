@@ -76,6 +76,18 @@ class ChangeResolution : public AbstractFilter
     SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureIdsArrayPath)
     Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 
+    SIMPL_FILTER_PARAMETER(int, Interpolation)
+    Q_PROPERTY(int Interpolation READ getInterpolation WRITE setInterpolation)
+
+    SIMPL_FILTER_PARAMETER(DataArrayPath, QuatsArrayPath)
+    Q_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
+
+    SIMPL_FILTER_PARAMETER(DataArrayPath, CellPhasesArrayPath)
+    Q_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
+
+    SIMPL_FILTER_PARAMETER(DataArrayPath, CrystalStructuresArrayPath)
+    Q_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -177,7 +189,15 @@ class ChangeResolution : public AbstractFilter
     void initialize();
 
   private:
+    enum InterpolationChoices
+    {
+      NearestNeighbor,
+      Smooth
+    };
+
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
+    DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
+    DEFINE_DATAARRAY_VARIABLE(uint32_t, CrystalStructures)
 
     ChangeResolution(const ChangeResolution&); // Copy Constructor Not Implemented
     void operator=(const ChangeResolution&); // Operator '=' Not Implemented
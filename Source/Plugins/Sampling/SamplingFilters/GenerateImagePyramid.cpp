@@ -0,0 +1,404 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "GenerateImagePyramid.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/SIMPLibVersion.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/ResampleEngine.h"
+
+// Include the MOC generated file for this class
+#include "moc_GenerateImagePyramid.cpp"
+
+namespace
+{
+  /**
+   * @brief NextLevel Halves every axis that has more than one cell. The last cell of an
+   * odd axis covers a single source cell.
+   */
+  void NextLevel(const size_t dims[3], size_t levelDims[3], float scale[3])
+  {
+    for (int d = 0; d < 3; d++)
+    {
+      if (dims[d] > 1)
+      {
+        levelDims[d] = (dims[d] + 1) / 2;
+        scale[d] = 2.0f;
+      }
+      else
+      {
+        levelDims[d] = dims[d];
+        scale[d] = 1.0f;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+GenerateImagePyramid::GenerateImagePyramid() :
+  AbstractFilter(),
+  m_CellAttributeMatrixPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""),
+  m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats),
+  m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases),
+  m_CrystalStructuresArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures),
+  m_NumberOfLevels(3),
+  m_DataContainerPrefix("ImagePyramid_"),
+  m_CrystalStructures(NULL)
+{
+  setupFilterParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+GenerateImagePyramid::~GenerateImagePyramid()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateImagePyramid::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+  parameters.push_back(IntFilterParameter::New("Number of Levels", "NumberOfLevels", getNumberOfLevels(), FilterParameter::Parameter));
+  parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
+  {
+    AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(AttributeMatrixSelectionFilterParameter::New("Cell Attribute Matrix", "CellAttributeMatrixPath", getCellAttributeMatrixPath(), FilterParameter::RequiredArray, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(DataArraySelectionFilterParameter::New("Quaternions", "QuatsArrayPath", getQuatsArrayPath(), FilterParameter::RequiredArray, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, SIMPL::AttributeMatrixType::Cell, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(DataArraySelectionFilterParameter::New("Phases", "CellPhasesArrayPath", getCellPhasesArrayPath(), FilterParameter::RequiredArray, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Cell Ensemble Data", FilterParameter::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::UInt32, 1, SIMPL::AttributeMatrixType::CellEnsemble, SIMPL::GeometryType::ImageGeometry);
+    parameters.push_back(DataArraySelectionFilterParameter::New("Crystal Structures", "CrystalStructuresArrayPath", getCrystalStructuresArrayPath(), FilterParameter::RequiredArray, req));
+  }
+  parameters.push_back(StringFilterParameter::New("Data Container Prefix", "DataContainerPrefix", getDataContainerPrefix(), FilterParameter::CreatedArray));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateImagePyramid::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setCellAttributeMatrixPath( reader->readDataArrayPath("CellAttributeMatrixPath", getCellAttributeMatrixPath() ) );
+  setQuatsArrayPath( reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath() ) );
+  setCellPhasesArrayPath( reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath() ) );
+  setCrystalStructuresArrayPath( reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath() ) );
+  setNumberOfLevels( reader->readValue("NumberOfLevels", getNumberOfLevels()) );
+  setDataContainerPrefix( reader->readString("DataContainerPrefix", getDataContainerPrefix() ) );
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int GenerateImagePyramid::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
+{
+  writer->openFilterGroup(this, index);
+  SIMPL_FILTER_WRITE_PARAMETER(FilterVersion)
+  SIMPL_FILTER_WRITE_PARAMETER(CellAttributeMatrixPath)
+  SIMPL_FILTER_WRITE_PARAMETER(QuatsArrayPath)
+  SIMPL_FILTER_WRITE_PARAMETER(CellPhasesArrayPath)
+  SIMPL_FILTER_WRITE_PARAMETER(CrystalStructuresArrayPath)
+  SIMPL_FILTER_WRITE_PARAMETER(NumberOfLevels)
+  SIMPL_FILTER_WRITE_PARAMETER(DataContainerPrefix)
+  writer->closeFilterGroup();
+  return ++index; // we want to return the next index that was just written to
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateImagePyramid::initialize()
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString GenerateImagePyramid::getLevelDataContainerName(int level)
+{
+  return QString("%1%2x").arg(getDataContainerPrefix()).arg(1 << level);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateImagePyramid::dataCheck()
+{
+  setErrorCondition(0);
+
+  if (getNumberOfLevels() < 1 || getNumberOfLevels() > 6)
+  {
+    QString ss = QObject::tr("The Number of Levels (%1) must be between 1 and 6").arg(getNumberOfLevels());
+    setErrorCondition(-5560);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  if (getDataContainerPrefix().isEmpty() == true)
+  {
+    QString ss = QObject::tr("The Data Container Prefix must not be empty");
+    setErrorCondition(-5561);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getCellAttributeMatrixPath().getDataContainerName());
+  AttributeMatrix::Pointer cellAttrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath<AbstractFilter>(this, getCellAttributeMatrixPath(), -301);
+  if (getErrorCondition() < 0) { return; }
+
+  // An empty Quaternions selection means there is no orientation data to average. The Phases
+  // are pyramided along with the other Cell arrays, so every level can pick the phases of the
+  // level above it when averaging its quaternions
+  if (getQuatsArrayPath().getDataArrayName().isEmpty() == false)
+  {
+    if (getQuatsArrayPath().getDataContainerName() != getCellAttributeMatrixPath().getDataContainerName()
+        || getQuatsArrayPath().getAttributeMatrixName() != getCellAttributeMatrixPath().getAttributeMatrixName()
+        || getCellPhasesArrayPath().getDataContainerName() != getCellAttributeMatrixPath().getDataContainerName()
+        || getCellPhasesArrayPath().getAttributeMatrixName() != getCellAttributeMatrixPath().getAttributeMatrixName())
+    {
+      QString ss = QObject::tr("The Quaternions and Phases arrays must be stored in the selected Cell Attribute Matrix");
+      setErrorCondition(-5562);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    QVector<size_t> cDims(1, 4);
+    getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getQuatsArrayPath(), cDims);
+
+    cDims[0] = 1;
+    getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getCellPhasesArrayPath(), cDims);
+
+    m_CrystalStructuresPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter>(this, getCrystalStructuresArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_CrystalStructuresPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_CrystalStructures = m_CrystalStructuresPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if (getErrorCondition() < 0) { return; }
+  }
+
+  size_t dims[3] = { 0, 0, 0 };
+  image->getDimensions(dims);
+  float res[3] = { 0.0f, 0.0f, 0.0f };
+  image->getResolution(res);
+  float origin[3] = { 0.0f, 0.0f, 0.0f };
+  image->getOrigin(origin);
+
+  // Every level gets its own Data Container holding an Attribute Matrix with the same name
+  // and arrays as the source, so downstream filters only need to select a different Data Container
+  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  for (int level = 1; level <= getNumberOfLevels(); level++)
+  {
+    size_t levelDims[3] = { 0, 0, 0 };
+    float scale[3] = { 0.0f, 0.0f, 0.0f };
+    NextLevel(dims, levelDims, scale);
+    for (int d = 0; d < 3; d++)
+    {
+      dims[d] = levelDims[d];
+      res[d] *= scale[d];
+    }
+
+    DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getLevelDataContainerName(level));
+    if (getErrorCondition() < 0) { return; }
+
+    ImageGeom::Pointer levelImage = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    levelImage->setDimensions(dims[0], dims[1], dims[2]);
+    levelImage->setResolution(res[0], res[1], res[2]);
+    levelImage->setOrigin(origin[0], origin[1], origin[2]);
+    m->setGeometry(levelImage);
+
+    QVector<size_t> tDims(3, 0);
+    tDims[0] = dims[0];
+    tDims[1] = dims[1];
+    tDims[2] = dims[2];
+    AttributeMatrix::Pointer levelAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, cellAttrMat->getName(), tDims, SIMPL::AttributeMatrixType::Cell);
+    if (getErrorCondition() < 0) { return; }
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+    {
+      IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
+      IDataArray::Pointer data = p->createNewArray(totalPoints, p->getComponentDimensions(), p->getName(), false);
+      levelAttrMat->addAttributeArray(*iter, data);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateImagePyramid::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateImagePyramid::execute()
+{
+  setErrorCondition(0);
+  dataCheck();
+  if(getErrorCondition() < 0) { return; }
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getCellAttributeMatrixPath().getDataContainerName());
+  AttributeMatrix::Pointer srcAttrMat = m->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
+
+  size_t dims[3] = { 0, 0, 0 };
+  m->getGeometryAs<ImageGeom>()->getDimensions(dims);
+
+  // Each level is computed from the one above it, so the full resolution volume is
+  // only read once and every later level touches 1/8 of the data of its parent
+  QList<QString> voxelArrayNames = srcAttrMat->getAttributeArrayNames();
+  for (int level = 1; level <= getNumberOfLevels(); level++)
+  {
+    size_t levelDims[3] = { 0, 0, 0 };
+    float scale[3] = { 0.0f, 0.0f, 0.0f };
+    NextLevel(dims, levelDims, scale);
+
+    ResampleEngine engine(dims, levelDims);
+    engine.setScaling(scale);
+    for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+    {
+      engine.setInterpolationType(*iter, ResampleEngine::SmoothInterpolationType(srcAttrMat->getAttributeArray(*iter)));
+    }
+    if (getQuatsArrayPath().getDataArrayName().isEmpty() == false)
+    {
+      engine.setInterpolationType(getQuatsArrayPath().getDataArrayName(), ResampleEngine::QuaternionAverage);
+      Int32ArrayType::Pointer cellPhases = std::dynamic_pointer_cast<Int32ArrayType>(srcAttrMat->getAttributeArray(getCellPhasesArrayPath().getDataArrayName()));
+      engine.setOrientationData(cellPhases, m_CrystalStructuresPtr.lock());
+    }
+
+    AttributeMatrix::Pointer levelAttrMat = getDataContainerArray()->getDataContainer(getLevelDataContainerName(level))->getAttributeMatrix(srcAttrMat->getName());
+    for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+    {
+      if (getCancel() == true) { return; }
+      QString ss = QObject::tr("Level %1x || Resampling Array '%2'").arg(1 << level).arg(*iter);
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+      IDataArray::Pointer data = engine.resampleArray(srcAttrMat->getAttributeArray(*iter), engine.getInterpolationType(*iter));
+      levelAttrMat->addAttributeArray(*iter, data);
+    }
+
+    srcAttrMat = levelAttrMat;
+    for (int d = 0; d < 3; d++) { dims[d] = levelDims[d]; }
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer GenerateImagePyramid::newFilterInstance(bool copyFilterParameters)
+{
+  GenerateImagePyramid::Pointer filter = GenerateImagePyramid::New();
+  if(true == copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString GenerateImagePyramid::getCompiledLibraryName()
+{
+  return SamplingConstants::SamplingBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString GenerateImagePyramid::getBrandingString()
+{
+  return "Sampling";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString GenerateImagePyramid::getFilterVersion()
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream <<  SIMPLib::Version::Major() << "." << SIMPLib::Version::Minor() << "." << SIMPLib::Version::Patch();
+  return version;
+}
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString GenerateImagePyramid::getGroupName()
+{ return SIMPL::FilterGroups::SamplingFilters; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString GenerateImagePyramid::getSubGroupName()
+{ return SIMPL::FilterSubGroups::ResolutionFilters; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString GenerateImagePyramid::getHumanLabel()
+{ return "Generate Image Pyramid"; }
@@ -0,0 +1,627 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "ResampleEngine.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Common/AbstractFilter.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+namespace
+{
+  /**
+   * @brief Orders source tuples lexicographically by their component values
+   */
+  template<typename T>
+  class TupleLess
+  {
+    public:
+      TupleLess(const T* data, size_t numComp) : m_Data(data), m_NumComp(numComp) {}
+      bool operator()(size_t a, size_t b) const
+      {
+        const T* ta = m_Data + a * m_NumComp;
+        const T* tb = m_Data + b * m_NumComp;
+        for (size_t c = 0; c < m_NumComp; c++)
+        {
+          if (ta[c] < tb[c]) { return true; }
+          if (tb[c] < ta[c]) { return false; }
+        }
+        return false;
+      }
+    private:
+      const T* m_Data;
+      size_t m_NumComp;
+  };
+
+  template<typename T>
+  T ConvertInterpolatedValue(double value)
+  {
+    if (std::numeric_limits<T>::is_integer) { return static_cast<T>(std::floor(value + 0.5)); }
+    return static_cast<T>(value);
+  }
+}
+
+/**
+ * @brief The ResampleArrayImpl class fills a range of destination tuples of one array
+ */
+template<typename T>
+class ResampleArrayImpl
+{
+  public:
+    ResampleArrayImpl(const T* src, T* dst, size_t numComp, const size_t srcDims[3], const size_t dstDims[3],
+                      const float scale[3], const int64_t* indexMap, ResampleEngine::InterpolationType type) :
+      m_Src(src),
+      m_Dst(dst),
+      m_NumComp(numComp),
+      m_IndexMap(indexMap),
+      m_Type(type),
+      m_CellPhases(NULL),
+      m_CrystalStructures(NULL),
+      m_NumEnsembles(0)
+    {
+      for (int d = 0; d < 3; d++)
+      {
+        m_SrcDims[d] = srcDims[d];
+        m_DstDims[d] = dstDims[d];
+        m_Scale[d] = scale[d];
+      }
+    }
+    virtual ~ResampleArrayImpl() {}
+
+    void setOrientationData(const int32_t* cellPhases, const uint32_t* crystalStructures, size_t numEnsembles)
+    {
+      m_CellPhases = cellPhases;
+      m_CrystalStructures = crystalStructures;
+      m_NumEnsembles = numEnsembles;
+      m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      std::vector<size_t> cells;
+      for (size_t i = start; i < end; i++)
+      {
+        switch(m_Type)
+        {
+          case ResampleEngine::Trilinear:
+            trilinear(i);
+            break;
+          case ResampleEngine::MajorityVote:
+            majorityVote(i, cells);
+            break;
+          case ResampleEngine::QuaternionAverage:
+            quaternionAverage(i, cells);
+            break;
+          default:
+            nearestNeighbor(i);
+            break;
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const T* m_Src;
+    T* m_Dst;
+    size_t m_NumComp;
+    size_t m_SrcDims[3];
+    size_t m_DstDims[3];
+    float m_Scale[3];
+    const int64_t* m_IndexMap;
+    ResampleEngine::InterpolationType m_Type;
+    const int32_t* m_CellPhases;
+    const uint32_t* m_CrystalStructures;
+    size_t m_NumEnsembles;
+    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+
+    void destinationPosition(size_t i, size_t pos[3]) const
+    {
+      pos[0] = i % m_DstDims[0];
+      pos[1] = (i / m_DstDims[0]) % m_DstDims[1];
+      pos[2] = i / (m_DstDims[0] * m_DstDims[1]);
+    }
+
+    /**
+     * @brief footprint Computes the half open box of source cells covered by destination tuple i.
+     * The box always holds at least one cell.
+     */
+    void footprint(size_t i, size_t lo[3], size_t hi[3]) const
+    {
+      size_t pos[3] = { 0, 0, 0 };
+      destinationPosition(i, pos);
+      for (int d = 0; d < 3; d++)
+      {
+        float a = std::floor(pos[d] * m_Scale[d] + 1.0e-4f);
+        float b = std::ceil((pos[d] + 1) * m_Scale[d] - 1.0e-4f);
+        lo[d] = (a < 0.0f) ? 0 : static_cast<size_t>(a);
+        if (lo[d] >= m_SrcDims[d]) { lo[d] = m_SrcDims[d] - 1; }
+        hi[d] = (b < 0.0f) ? 0 : static_cast<size_t>(b);
+        if (hi[d] <= lo[d]) { hi[d] = lo[d] + 1; }
+        if (hi[d] > m_SrcDims[d]) { hi[d] = m_SrcDims[d]; }
+      }
+    }
+
+    void footprintCells(size_t i, std::vector<size_t>& cells) const
+    {
+      size_t lo[3] = { 0, 0, 0 };
+      size_t hi[3] = { 0, 0, 0 };
+      footprint(i, lo, hi);
+      cells.clear();
+      for (size_t z = lo[2]; z < hi[2]; z++)
+      {
+        for (size_t y = lo[1]; y < hi[1]; y++)
+        {
+          size_t row = (z * m_SrcDims[1] + y) * m_SrcDims[0];
+          for (size_t x = lo[0]; x < hi[0]; x++)
+          {
+            cells.push_back(row + x);
+          }
+        }
+      }
+    }
+
+    void copyTuple(size_t srcTuple, size_t dstTuple) const
+    {
+      const T* s = m_Src + srcTuple * m_NumComp;
+      T* d = m_Dst + dstTuple * m_NumComp;
+      for (size_t c = 0; c < m_NumComp; c++) { d[c] = s[c]; }
+    }
+
+    void zeroTuple(size_t dstTuple) const
+    {
+      T* d = m_Dst + dstTuple * m_NumComp;
+      for (size_t c = 0; c < m_NumComp; c++) { d[c] = static_cast<T>(0); }
+    }
+
+    void nearestNeighbor(size_t i) const
+    {
+      if (NULL != m_IndexMap)
+      {
+        if (m_IndexMap[i] < 0) { zeroTuple(i); }
+        else { copyTuple(static_cast<size_t>(m_IndexMap[i]), i); }
+        return;
+      }
+      size_t lo[3] = { 0, 0, 0 };
+      size_t hi[3] = { 0, 0, 0 };
+      footprint(i, lo, hi);
+      copyTuple((lo[2] * m_SrcDims[1] + lo[1]) * m_SrcDims[0] + lo[0], i);
+    }
+
+    void trilinear(size_t i) const
+    {
+      size_t pos[3] = { 0, 0, 0 };
+      destinationPosition(i, pos);
+      size_t i0[3] = { 0, 0, 0 };
+      size_t i1[3] = { 0, 0, 0 };
+      double w[3] = { 0.0, 0.0, 0.0 };
+      for (int d = 0; d < 3; d++)
+      {
+        // Continuous source coordinate of the destination cell center, measured between source cell centers
+        double c = (pos[d] + 0.5) * m_Scale[d] - 0.5;
+        double cMax = static_cast<double>(m_SrcDims[d] - 1);
+        if (c < 0.0) { c = 0.0; }
+        if (c > cMax) { c = cMax; }
+        i0[d] = static_cast<size_t>(c);
+        i1[d] = (i0[d] + 1 < m_SrcDims[d]) ? i0[d] + 1 : i0[d];
+        w[d] = c - static_cast<double>(i0[d]);
+      }
+      T* dst = m_Dst + i * m_NumComp;
+      for (size_t comp = 0; comp < m_NumComp; comp++)
+      {
+        double value = 0.0;
+        for (int corner = 0; corner < 8; corner++)
+        {
+          size_t x = (corner & 1) ? i1[0] : i0[0];
+          size_t y = (corner & 2) ? i1[1] : i0[1];
+          size_t z = (corner & 4) ? i1[2] : i0[2];
+          double weight = ((corner & 1) ? w[0] : 1.0 - w[0]) * ((corner & 2) ? w[1] : 1.0 - w[1]) * ((corner & 4) ? w[2] : 1.0 - w[2]);
+          if (weight == 0.0) { continue; }
+          size_t srcTuple = (z * m_SrcDims[1] + y) * m_SrcDims[0] + x;
+          value += weight * static_cast<double>(m_Src[srcTuple * m_NumComp + comp]);
+        }
+        dst[comp] = ConvertInterpolatedValue<T>(value);
+      }
+    }
+
+    /**
+     * @brief majorityVote Writes the most frequent tuple of the footprint. Ties go to the
+     * lexicographically smallest tuple so the result does not depend on scheduling.
+     */
+    void majorityVote(size_t i, std::vector<size_t>& cells) const
+    {
+      footprintCells(i, cells);
+      if (cells.size() == 1)
+      {
+        copyTuple(cells[0], i);
+        return;
+      }
+      TupleLess<T> less(m_Src, m_NumComp);
+      std::sort(cells.begin(), cells.end(), less);
+      size_t best = cells[0];
+      size_t bestCount = 0;
+      size_t runStart = 0;
+      for (size_t n = 1; n <= cells.size(); n++)
+      {
+        if (n == cells.size() || less(cells[runStart], cells[n]))
+        {
+          if (n - runStart > bestCount)
+          {
+            bestCount = n - runStart;
+            best = cells[runStart];
+          }
+          runStart = n;
+        }
+      }
+      copyTuple(best, i);
+    }
+
+    /**
+     * @brief majorityPhase Returns the most frequent phase of the footprint. Ties go to the
+     * smallest phase, which is the phase the majority vote of the phase array keeps.
+     */
+    int32_t majorityPhase(const std::vector<size_t>& cells) const
+    {
+      std::vector<int32_t> phases(cells.size(), 0);
+      for (size_t n = 0; n < cells.size(); n++) { phases[n] = m_CellPhases[cells[n]]; }
+      std::sort(phases.begin(), phases.end());
+      int32_t best = phases[0];
+      size_t bestCount = 0;
+      size_t runStart = 0;
+      for (size_t n = 1; n <= phases.size(); n++)
+      {
+        if (n == phases.size() || phases[n] != phases[runStart])
+        {
+          if (n - runStart > bestCount)
+          {
+            bestCount = n - runStart;
+            best = phases[runStart];
+          }
+          runStart = n;
+        }
+      }
+      return best;
+    }
+
+    /**
+     * @brief quaternionAverage Averages the quaternions of the most frequent phase of the
+     * footprint. Each one is first replaced by its symmetry equivalent nearest the first non
+     * zero quaternion of that phase, so equivalent orientations add up instead of cancelling,
+     * then the sum is normalized.
+     */
+    void quaternionAverage(size_t i, std::vector<size_t>& cells) const
+    {
+      footprintCells(i, cells);
+      int32_t phase = majorityPhase(cells);
+      SpaceGroupOps::Pointer ops;
+      if (phase >= 0 && static_cast<size_t>(phase) < m_NumEnsembles && m_CrystalStructures[phase] < static_cast<uint32_t>(m_OrientationOps.size()))
+      {
+        ops = m_OrientationOps[m_CrystalStructures[phase]];
+      }
+
+      QuatF sum = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
+      QuatF ref = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
+      bool haveRef = false;
+      for (size_t n = 0; n < cells.size(); n++)
+      {
+        if (m_CellPhases[cells[n]] != phase) { continue; }
+        const T* s = m_Src + cells[n] * 4;
+        QuatF q = QuaternionMathF::New(static_cast<float>(s[0]), static_cast<float>(s[1]), static_cast<float>(s[2]), static_cast<float>(s[3]));
+        if (haveRef == false)
+        {
+          if (q.x == 0.0f && q.y == 0.0f && q.z == 0.0f && q.w == 0.0f) { continue; }
+          QuaternionMathF::Copy(q, ref);
+          if (ref.w < 0.0f) { QuaternionMathF::Negate(ref); }
+          haveRef = true;
+        }
+        if (NULL != ops.get())
+        {
+          ops->getNearestQuat(ref, q);
+        }
+        else if (q.x * ref.x + q.y * ref.y + q.z * ref.z + q.w * ref.w < 0.0f)
+        {
+          QuaternionMathF::Negate(q);
+        }
+        QuaternionMathF::Add(sum, q, sum);
+      }
+      double norm = std::sqrt(static_cast<double>(sum.x) * sum.x + static_cast<double>(sum.y) * sum.y + static_cast<double>(sum.z) * sum.z + static_cast<double>(sum.w) * sum.w);
+      T* dst = m_Dst + i * 4;
+      dst[0] = (norm > 0.0) ? static_cast<T>(sum.x / norm) : static_cast<T>(0);
+      dst[1] = (norm > 0.0) ? static_cast<T>(sum.y / norm) : static_cast<T>(0);
+      dst[2] = (norm > 0.0) ? static_cast<T>(sum.z / norm) : static_cast<T>(0);
+      dst[3] = (norm > 0.0) ? static_cast<T>(sum.w / norm) : static_cast<T>(0);
+    }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResampleEngine::ResampleEngine(const size_t srcDims[3], const size_t dstDims[3]) :
+  m_HasScaling(false),
+  m_IndexMap(NULL)
+{
+  for (int d = 0; d < 3; d++)
+  {
+    m_SrcDims[d] = srcDims[d];
+    m_DstDims[d] = dstDims[d];
+    m_Scale[d] = (dstDims[d] > 0) ? static_cast<float>(srcDims[d]) / static_cast<float>(dstDims[d]) : 1.0f;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResampleEngine::~ResampleEngine()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResampleEngine::setIndexMap(const int64_t* newToOld)
+{
+  m_IndexMap = newToOld;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResampleEngine::setScaling(const float scale[3])
+{
+  for (int d = 0; d < 3; d++) { m_Scale[d] = scale[d]; }
+  m_HasScaling = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResampleEngine::setOrientationData(Int32ArrayType::Pointer cellPhases, UInt32ArrayType::Pointer crystalStructures)
+{
+  m_CellPhases = cellPhases;
+  m_CrystalStructures = crystalStructures;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResampleEngine::setInterpolationType(const QString& arrayName, InterpolationType type)
+{
+  m_InterpolationTypes[arrayName] = type;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResampleEngine::InterpolationType ResampleEngine::getInterpolationType(const QString& arrayName) const
+{
+  return m_InterpolationTypes.value(arrayName, NearestNeighbor);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResampleEngine::InterpolationType ResampleEngine::SmoothInterpolationType(IDataArray::Pointer array)
+{
+  if (NULL != std::dynamic_pointer_cast<FloatArrayType>(array).get() || NULL != std::dynamic_pointer_cast<DoubleArrayType>(array).get())
+  {
+    // Euler angles, quaternions and similar tuples can not be blended component by
+    // component, so only scalar fields are interpolated
+    if (array->getNumberOfComponents() != 1)
+    {
+      return NearestNeighbor;
+    }
+    return Trilinear;
+  }
+  return MajorityVote;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ResampleEngine::getNumberOfSourceTuples() const
+{
+  return m_SrcDims[0] * m_SrcDims[1] * m_SrcDims[2];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ResampleEngine::getNumberOfDestinationTuples() const
+{
+  return m_DstDims[0] * m_DstDims[1] * m_DstDims[2];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ResampleEngine::checkIndexMap() const
+{
+  if (NULL == m_IndexMap) { return true; }
+  int64_t numSrcTuples = static_cast<int64_t>(getNumberOfSourceTuples());
+  size_t numDstTuples = getNumberOfDestinationTuples();
+  for (size_t i = 0; i < numDstTuples; i++)
+  {
+    if (m_IndexMap[i] >= numSrcTuples) { return false; }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+IDataArray::Pointer ResampleEngine::resampleTyped(IDataArray::Pointer source, InterpolationType type) const
+{
+  typename DataArray<T>::Pointer srcPtr = std::dynamic_pointer_cast<DataArray<T> >(source);
+  size_t numComp = static_cast<size_t>(srcPtr->getNumberOfComponents());
+  size_t numDstTuples = getNumberOfDestinationTuples();
+
+  if (m_HasScaling == false) { type = NearestNeighbor; }
+  if (type == QuaternionAverage && (numComp != 4 || std::numeric_limits<T>::is_integer)) { type = NearestNeighbor; }
+  if (type == QuaternionAverage && (NULL == m_CellPhases.get() || NULL == m_CrystalStructures.get()
+                                    || m_CellPhases->getNumberOfTuples() != getNumberOfSourceTuples())) { type = NearestNeighbor; }
+
+  IDataArray::Pointer data = source->createNewArray(numDstTuples, source->getComponentDimensions(), source->getName(), true);
+  typename DataArray<T>::Pointer dstPtr = std::dynamic_pointer_cast<DataArray<T> >(data);
+  if (numDstTuples == 0) { return data; }
+
+  const T* src = srcPtr->getPointer(0);
+  T* dst = dstPtr->getPointer(0);
+
+  ResampleArrayImpl<T> impl(src, dst, numComp, m_SrcDims, m_DstDims, m_Scale, m_IndexMap, type);
+  if (type == QuaternionAverage)
+  {
+    impl.setOrientationData(m_CellPhases->getPointer(0), m_CrystalStructures->getPointer(0), m_CrystalStructures->getNumberOfTuples());
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numDstTuples), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numDstTuples);
+  }
+  return data;
+}
+
+#define RESAMPLE_ENGINE_DISPATCH(Type)\
+  if (NULL != std::dynamic_pointer_cast<DataArray<Type> >(source).get())\
+  {\
+    return resampleTyped<Type>(source, type);\
+  }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer ResampleEngine::resampleArray(IDataArray::Pointer source, InterpolationType type) const
+{
+  RESAMPLE_ENGINE_DISPATCH(int8_t)
+  RESAMPLE_ENGINE_DISPATCH(uint8_t)
+  RESAMPLE_ENGINE_DISPATCH(int16_t)
+  RESAMPLE_ENGINE_DISPATCH(uint16_t)
+  RESAMPLE_ENGINE_DISPATCH(int32_t)
+  RESAMPLE_ENGINE_DISPATCH(uint32_t)
+  RESAMPLE_ENGINE_DISPATCH(int64_t)
+  RESAMPLE_ENGINE_DISPATCH(uint64_t)
+  RESAMPLE_ENGINE_DISPATCH(float)
+  RESAMPLE_ENGINE_DISPATCH(double)
+  RESAMPLE_ENGINE_DISPATCH(bool)
+
+  // Any other kind of array is copied tuple by tuple through its void pointer
+  size_t numDstTuples = getNumberOfDestinationTuples();
+  IDataArray::Pointer data = source->createNewArray(numDstTuples, source->getComponentDimensions(), source->getName(), true);
+  size_t numComp = static_cast<size_t>(source->getNumberOfComponents());
+  size_t typeSize = source->getTypeSize();
+  std::vector<char> zero(typeSize, 0);
+  for (size_t i = 0; i < numDstTuples; i++)
+  {
+    int64_t srcTuple = 0;
+    if (NULL != m_IndexMap)
+    {
+      srcTuple = m_IndexMap[i];
+    }
+    else
+    {
+      size_t x = std::min(static_cast<size_t>((i % m_DstDims[0]) * m_Scale[0]), m_SrcDims[0] - 1);
+      size_t y = std::min(static_cast<size_t>(((i / m_DstDims[0]) % m_DstDims[1]) * m_Scale[1]), m_SrcDims[1] - 1);
+      size_t z = std::min(static_cast<size_t>((i / (m_DstDims[0] * m_DstDims[1])) * m_Scale[2]), m_SrcDims[2] - 1);
+      srcTuple = static_cast<int64_t>((z * m_SrcDims[1] + y) * m_SrcDims[0] + x);
+    }
+    if (srcTuple < 0)
+    {
+      data->initializeTuple(i, &(zero.front()));
+    }
+    else
+    {
+      ::memcpy(data->getVoidPointer(numComp * i), source->getVoidPointer(numComp * static_cast<size_t>(srcTuple)), typeSize * numComp);
+    }
+  }
+  return data;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResampleEngine::resampleAttributeMatrix(AttributeMatrix::Pointer source, AttributeMatrix::Pointer destination, AbstractFilter* filter) const
+{
+  QList<QString> arrayNames = source->getAttributeArrayNames();
+  int count = 0;
+  for (QList<QString>::iterator iter = arrayNames.begin(); iter != arrayNames.end(); ++iter)
+  {
+    count++;
+    if (NULL != filter)
+    {
+      if (filter->getCancel() == true) { return; }
+      QString ss = QObject::tr("Resampling Array '%1' (%2 of %3)").arg(*iter).arg(count).arg(arrayNames.size());
+      filter->notifyStatusMessage(filter->getMessagePrefix(), filter->getHumanLabel(), ss);
+    }
+
+    IDataArray::Pointer p = source->getAttributeArray(*iter);
+    source->removeAttributeArray(*iter);
+    IDataArray::Pointer data = resampleArray(p, getInterpolationType(*iter));
+    // Release the source array before the next one is resampled so that only one
+    // resampled array is alive next to the source volume at any time
+    p = IDataArray::NullPointer();
+    destination->addAttributeArray(*iter, data);
+  }
+}
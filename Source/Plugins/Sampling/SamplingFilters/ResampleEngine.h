@@ -0,0 +1,168 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _resampleengine_h_
+#define _resampleengine_h_
+
+#include <vector>
+
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+class AbstractFilter;
+
+/**
+ * @brief The ResampleEngine class moves the cell arrays of an image geometry onto a
+ * new grid. Arrays are resampled one at a time: each source array is removed from
+ * its AttributeMatrix, gathered into a destination array that is allocated at the
+ * final size and released before the next array is touched. Peak memory is therefore
+ * the source volume plus one resampled array instead of two full volumes.
+ *
+ * The destination grid is described either by an explicit new-to-old index map
+ * (any geometric transform, nearest neighbor only) or by a per axis scale factor
+ * between the two grids, which additionally enables the trilinear, majority vote and
+ * quaternion average interpolation types. The quaternion average also needs the cell
+ * phases and crystal structures given to setOrientationData().
+ */
+class ResampleEngine
+{
+  public:
+    enum InterpolationType
+    {
+      NearestNeighbor = 0,   //!< Copy the source tuple given by the index map
+      Trilinear = 1,         //!< Trilinear interpolation at the destination cell center
+      MajorityVote = 2,      //!< Most frequent tuple inside the destination cell footprint
+      QuaternionAverage = 3  //!< Symmetry aligned, normalized mean of the quaternions of the majority phase inside the footprint
+    };
+
+    /**
+     * @brief ResampleEngine
+     * @param srcDims Dimensions of the source cell grid
+     * @param dstDims Dimensions of the destination cell grid
+     */
+    ResampleEngine(const size_t srcDims[3], const size_t dstDims[3]);
+    virtual ~ResampleEngine();
+
+    /**
+     * @brief setIndexMap Destination tuple i is copied from source tuple newToOld[i].
+     * Negative entries produce a zero tuple. The map is not copied and must stay
+     * valid while the engine is in use.
+     */
+    void setIndexMap(const int64_t* newToOld);
+
+    /**
+     * @brief setScaling Destination cell (x, y, z) covers the source box
+     * [x * scale[0], (x + 1) * scale[0]) along X and likewise along Y and Z, in units
+     * of source cells. If no index map was set, the nearest neighbor map is derived
+     * from the lower corner of that box.
+     */
+    void setScaling(const float scale[3]);
+
+    /**
+     * @brief setOrientationData Sets the phase of every source cell and the crystal structure
+     * of every phase for the QuaternionAverage interpolation. Only the quaternions of the most
+     * frequent phase of a footprint are averaged, each one moved to its symmetry equivalent
+     * nearest the first of them. The engine keeps references to both arrays, so the phases stay
+     * valid while resampleAttributeMatrix() releases the source arrays.
+     */
+    void setOrientationData(Int32ArrayType::Pointer cellPhases, UInt32ArrayType::Pointer crystalStructures);
+
+    /**
+     * @brief setInterpolationType Selects the interpolation used for the named array.
+     * Arrays without an entry use NearestNeighbor.
+     */
+    void setInterpolationType(const QString& arrayName, InterpolationType type);
+    InterpolationType getInterpolationType(const QString& arrayName) const;
+
+    /**
+     * @brief SmoothInterpolationType Returns Trilinear for single component floating point
+     * arrays and MajorityVote for integer arrays, which keeps labels such as feature or phase
+     * ids valid. Floating point arrays with more than one component get NearestNeighbor,
+     * because tuples like Euler angles or quaternions can not be blended component by
+     * component; select QuaternionAverage for a quaternion array, or Trilinear for a plain
+     * vector field, explicitly with setInterpolationType().
+     */
+    static InterpolationType SmoothInterpolationType(IDataArray::Pointer array);
+
+    /**
+     * @brief checkIndexMap Returns false if the index map references a tuple outside
+     * of the source grid
+     */
+    bool checkIndexMap() const;
+
+    /**
+     * @brief resampleArray Returns a new array with one tuple per destination cell.
+     * Interpolation types that do not apply to the array (every type other than
+     * NearestNeighbor without a scaling, QuaternionAverage on anything but a 4 component
+     * float or double array or without orientation data, or any type on a non numeric
+     * array) fall back to NearestNeighbor.
+     */
+    IDataArray::Pointer resampleArray(IDataArray::Pointer source, InterpolationType type) const;
+
+    /**
+     * @brief resampleAttributeMatrix Moves every array of source into destination,
+     * resampling it on the way. The source AttributeMatrix is left empty.
+     * @param filter Used for progress messages and cancel requests; may be NULL
+     */
+    void resampleAttributeMatrix(AttributeMatrix::Pointer source, AttributeMatrix::Pointer destination, AbstractFilter* filter) const;
+
+    size_t getNumberOfSourceTuples() const;
+    size_t getNumberOfDestinationTuples() const;
+
+  private:
+    size_t m_SrcDims[3];
+    size_t m_DstDims[3];
+    float m_Scale[3];
+    bool m_HasScaling;
+    const int64_t* m_IndexMap;
+    std::vector<int64_t> m_DerivedIndexMap;
+    Int32ArrayType::Pointer m_CellPhases;
+    UInt32ArrayType::Pointer m_CrystalStructures;
+    QMap<QString, InterpolationType> m_InterpolationTypes;
+
+    template<typename T>
+    IDataArray::Pointer resampleTyped(IDataArray::Pointer source, InterpolationType type) const;
+
+    ResampleEngine(const ResampleEngine&); // Copy Constructor Not Implemented
+    void operator=(const ResampleEngine&); // Operator '=' Not Implemented
+};
+
+#endif /* _resampleengine_h_ */
@@ -56,6 +56,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/ResampleEngine.h"
 
 typedef struct
 {
@@ -497,53 +498,33 @@ void RotateSampleRefFrame::execute()
     serial.convert(0, params.zpNew, 0, params.ypNew, 0, params.xpNew);
   }
 
-  // This could technically be parallelized also where each thread takes an array to adjust. Except
-  // that the DataContainer is NOT thread safe or re-entrant so that would actually be a BAD idea.
-  QString attrMatName = getCellAttributeMatrixPath().getAttributeMatrixName();
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  size_t dims[3] = { static_cast<size_t>(xp), static_cast<size_t>(yp), static_cast<size_t>(zp) };
+  size_t newDims[3] = { static_cast<size_t>(xpNew), static_cast<size_t>(ypNew), static_cast<size_t>(zpNew) };
+  ResampleEngine engine(dims, newDims);
+  engine.setIndexMap(newindicies);
+  if (engine.checkIndexMap() == false)
+  {
+    QString ss = QObject::tr("The index is outside the bounds of the source array");
+    setErrorCondition(-11004);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
 
-  // resize attribute matrix
+  // The arrays are moved into a new AttributeMatrix one at a time, each source array
+  // being released as soon as its rotated copy exists
+  QString attrMatName = getCellAttributeMatrixPath().getAttributeMatrixName();
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(attrMatName);
   QVector<size_t> tDims(3);
   tDims[0] = params.xpNew;
   tDims[1] = params.ypNew;
   tDims[2] = params.zpNew;
-  m->getAttributeMatrix(attrMatName)->resizeAttributeArrays(tDims);
+  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
 
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-  {
-    IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name.
-    IDataArray::Pointer data = p->createNewArray(newNumCellTuples, p->getComponentDimensions(), p->getName());
-    void* source = NULL;
-    void* destination = NULL;
-    int64_t newIndicies_I = 0;
-    int32_t nComp = data->getNumberOfComponents();
-    for (size_t i = 0; i < static_cast<size_t>(newNumCellTuples); i++)
-    {
-      newIndicies_I = newindicies[i];
-      if(newIndicies_I >= 0)
-      {
-        source = p->getVoidPointer((nComp * newIndicies_I));
-        if (NULL == source)
-        {
-          QString ss = QObject::tr("The index is outside the bounds of the source array");
-          setErrorCondition(-11004);
-          notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-          return;
-        }
-        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-      }
-      else
-      {
-        int var = 0;
-        data->initializeTuple(i, &var);
-      }
-    }
-    m->getAttributeMatrix(attrMatName)->addAttributeArray(*iter, data);
-  }
+  engine.resampleAttributeMatrix(cellAttrMat, newCellAttrMat, this);
+  if (getCancel() == true) { return; }
+
+  m->removeAttributeMatrix(attrMatName);
+  m->addAttributeMatrix(attrMatName, newCellAttrMat);
   m->getGeometryAs<ImageGeom>()->setResolution(params.xResNew, params.yResNew, params.zResNew);
   m->getGeometryAs<ImageGeom>()->setDimensions(params.xpNew, params.ypNew, params.zpNew);
   m->getGeometryAs<ImageGeom>()->setOrigin(xMin, yMin, zMin);
@@ -20,6 +20,7 @@ set(_PublicFilters
   ChangeResolution
   CropImageGeometry
   ExtractFlaggedFeatures
+  GenerateImagePyramid
   NearestPointFuseRegularGrids
   RegularGridSampleSurfaceMesh
   RegularizeZSpacing
@@ -54,5 +55,10 @@ foreach(f ${_PrivateFilters} )
                         ${${PLUGIN_NAME}_SOURCE_DIR}/Documentation/${_filterGroupName}/${f}.md FALSE ${${PLUGIN_NAME}_BINARY_DIR})
 endforeach()
 
+#-------------
+# These are files that need to be compiled into the plugin but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER(${Sampling_SOURCE_DIR} ${_filterGroupName} ResampleEngine.h)
+ADD_SIMPL_SUPPORT_SOURCE(${Sampling_SOURCE_DIR} ${_filterGroupName} ResampleEngine.cpp)
+
 SIMPL_END_FILTER_GROUP(${Sampling_BINARY_DIR} "${_filterGroupName}" "SamplingFilters")
 
@@ -51,6 +51,7 @@
 
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/ResampleEngine.h"
 
 // Include the MOC generated file for this class
 #include "moc_WarpRegularGrid.cpp"
@@ -253,7 +254,7 @@ void WarpRegularGrid::execute()
   else { m = getDataContainerArray()->getDataContainer(getNewDataContainerName()); }
 
   AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
-  AttributeMatrix::Pointer newCellAttrMat = cellAttrMat->deepCopy();
+  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(cellAttrMat->getTupleDimensions(), cellAttrMat->getName(), cellAttrMat->getType());
 
   size_t dims[3] = { 0, 0, 0 };
   m->getGeometryAs<ImageGeom>()->getDimensions(dims);
@@ -266,8 +267,8 @@ void WarpRegularGrid::execute()
   int col = 0.0f, row = 0.0f, plane = 0.0f;
   size_t index;
   size_t index_old;
-  std::vector<size_t> newindicies(totalPoints);
-  std::vector<bool> goodPoint(totalPoints, true);
+  // Points that warp outside of the grid are marked with -1 and receive a zero tuple
+  std::vector<int64_t> newindicies(totalPoints);
 
   for (size_t i = 0; i < dims[2]; i++)
   {
@@ -287,46 +288,24 @@ void WarpRegularGrid::execute()
         row = newY / res[1];
         plane = i;
 
-        index_old = (plane * dims[0] * dims[1]) + (row * dims[0]) + col;
-        newindicies[index] = index_old;
-        if (col > 0 && col < dims[0] && row > 0 && row < dims[1]) { goodPoint[index] = true; }
-        else { goodPoint[index] = false; }
+        if (col > 0 && col < dims[0] && row > 0 && row < dims[1])
+        {
+          index_old = (plane * dims[0] * dims[1]) + (row * dims[0]) + col;
+          newindicies[index] = static_cast<int64_t>(index_old);
+        }
+        else
+        {
+          newindicies[index] = -1;
+        }
       }
     }
   }
 
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-  {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resize(totalPoints);
-    void* source = NULL;
-    void* destination = NULL;
-    size_t newIndicies_I = 0;
-    int nComp = data->getNumberOfComponents();
-    for (size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
+  ResampleEngine engine(dims, dims);
+  engine.setIndexMap(&(newindicies.front()));
+  engine.resampleAttributeMatrix(cellAttrMat, newCellAttrMat, this);
+  if (getCancel() == true) { return; }
 
-      if(goodPoint[i] == true)
-      {
-        source = p->getVoidPointer((nComp * newIndicies_I));
-        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-      }
-      else
-      {
-        int var = 0;
-        data->initializeTuple(i, &var);
-      }
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->addAttributeArray(*iter, data);
-  }
   m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   m->addAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName(), newCellAttrMat);
 
@@ -0,0 +1,299 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <map>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+#include "SamplingTestFileLocations.h"
+
+static const QString k_PyramidLabelsName("Labels");
+static const QString k_PyramidRampName("Ramp");
+static const QString k_PyramidEulersName("EulerAngles");
+
+class GenerateImagePyramidTest
+{
+  public:
+    GenerateImagePyramidTest(){}
+    virtual ~GenerateImagePyramidTest(){}
+    SIMPL_TYPE_MACRO(GenerateImagePyramidTest)
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    static float RampValue(float x, float y, float z)
+    {
+      return 0.5f * x - 2.0f * y + 4.0f * z + 7.0f;
+    }
+
+    // -----------------------------------------------------------------------------
+    // A single slice with an odd number of columns, so the last column of a level covers
+    // one source cell and the Z axis must not be reduced. Every quaternion is a cubic
+    // symmetry equivalent of the same orientation with an alternating sign.
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestVolume(const size_t dims[3], const QuatF& orientation)
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(dims[0], dims[1], dims[2]);
+      image->setResolution(0.5f, 0.25f, 1.0f);
+      image->setOrigin(1.0f, 2.0f, 3.0f);
+      m->setGeometry(image);
+
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = dims[0];
+      tDims[1] = dims[1];
+      tDims[2] = dims[2];
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer labels = Int32ArrayType::CreateArray(tDims, cDims, k_PyramidLabelsName, true);
+      FloatArrayType::Pointer ramp = FloatArrayType::CreateArray(tDims, cDims, k_PyramidRampName, true);
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
+      cDims[0] = 3;
+      FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(tDims, cDims, k_PyramidEulersName, true);
+      cDims[0] = 4;
+      FloatArrayType::Pointer quats = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Quats, true);
+
+      SpaceGroupOps::Pointer cubic = SpaceGroupOps::getOrientationOpsQVector()[Ebsd::CrystalStructure::Cubic_High];
+      uint32_t seed = 4321;
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            size_t index = (z * dims[1] + y) * dims[0] + x;
+            seed = seed * 1103515245u + 12345u;
+            labels->setValue(index, static_cast<int32_t>((seed >> 16) % 4));
+            ramp->setValue(index, RampValue(x, y, z));
+            phases->setValue(index, 1);
+            eulers->setComponent(index, 0, (index % 2 == 0) ? 0.02f : 6.25f);
+            eulers->setComponent(index, 1, 0.1f * index);
+            eulers->setComponent(index, 2, 1.0f);
+
+            QuatF symOp = QuaternionMathF::New();
+            cubic->getQuatSymOp(static_cast<int>((7 * index + 1) % cubic->getNumSymOps()), symOp);
+            QuatF q = QuaternionMathF::New();
+            QuaternionMathF::Multiply(symOp, orientation, q);
+            if (index % 2 == 1) { QuaternionMathF::Negate(q); }
+            quats->setComponent(index, 0, q.x);
+            quats->setComponent(index, 1, q.y);
+            quats->setComponent(index, 2, q.z);
+            quats->setComponent(index, 3, q.w);
+          }
+        }
+      }
+      am->addAttributeArray(k_PyramidLabelsName, labels);
+      am->addAttributeArray(k_PyramidRampName, ramp);
+      am->addAttributeArray(SIMPL::CellData::Phases, phases);
+      am->addAttributeArray(k_PyramidEulersName, eulers);
+      am->addAttributeArray(SIMPL::CellData::Quats, quats);
+      m->addAttributeMatrix(am->getName(), am);
+
+      AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(QVector<size_t>(1, 2), SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::AttributeMatrixType::CellEnsemble);
+      UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, SIMPL::EnsembleData::CrystalStructures);
+      crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+      crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+      ensembleAttrMat->addAttributeArray(SIMPL::EnsembleData::CrystalStructures, crystalStructures);
+      m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    template<typename T>
+    typename DataArray<T>::Pointer GetLevelArray(DataContainerArray::Pointer dca, const QString& dcName, const QString& name)
+    {
+      DataContainer::Pointer m = dca->getDataContainer(dcName);
+      DREAM3D_REQUIRE_VALID_POINTER(m.get());
+      AttributeMatrix::Pointer am = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+      DREAM3D_REQUIRE_VALID_POINTER(am.get());
+      typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T> >(am->getAttributeArray(name));
+      DREAM3D_REQUIRE_VALID_POINTER(array.get());
+      return array;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestGenerateImagePyramid()
+    {
+      size_t dims[3] = { 9, 6, 1 };
+      QuatF orientation = QuaternionMathF::New(0.2f, 0.4f, -0.1f, 0.8f);
+      QuaternionMathF::UnitQuaternion(orientation);
+      DataContainerArray::Pointer dca = CreateTestVolume(dims, orientation);
+
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("GenerateImagePyramid");
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+      bool propWasSet = filter->setProperty("CellAttributeMatrixPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(3);
+      propWasSet = filter->setProperty("NumberOfLevels", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(QString("Level_"));
+      propWasSet = filter->setProperty("DataContainerPrefix", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      // Odd axes round up, the single slice stays a single slice and the resolution
+      // doubles on every reduced axis
+      const QString levelNames[3] = { "Level_2x", "Level_4x", "Level_8x" };
+      const size_t levelDims[3][3] = { { 5, 3, 1 }, { 3, 2, 1 }, { 2, 1, 1 } };
+      const float levelRes[3][3] = { { 1.0f, 0.5f, 1.0f }, { 2.0f, 1.0f, 1.0f }, { 4.0f, 2.0f, 1.0f } };
+      for (int level = 0; level < 3; level++)
+      {
+        DataContainer::Pointer m = dca->getDataContainer(levelNames[level]);
+        DREAM3D_REQUIRE_VALID_POINTER(m.get());
+        ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+        DREAM3D_REQUIRE_VALID_POINTER(image.get());
+        size_t d[3] = { 0, 0, 0 };
+        image->getDimensions(d);
+        float res[3] = { 0.0f, 0.0f, 0.0f };
+        image->getResolution(res);
+        float origin[3] = { 0.0f, 0.0f, 0.0f };
+        image->getOrigin(origin);
+        for (int i = 0; i < 3; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(d[i], levelDims[level][i])
+          DREAM3D_REQUIRE_EQUAL(res[i], levelRes[level][i])
+        }
+        DREAM3D_REQUIRE_EQUAL(origin[0], 1.0f)
+        DREAM3D_REQUIRE_EQUAL(origin[1], 2.0f)
+        DREAM3D_REQUIRE_EQUAL(origin[2], 3.0f)
+        DREAM3D_REQUIRE_EQUAL(GetLevelArray<int32_t>(dca, levelNames[level], k_PyramidLabelsName)->getNumberOfTuples(), d[0] * d[1] * d[2])
+      }
+
+      // Content of the 2x level against the source volume
+      Int32ArrayType::Pointer labels = GetLevelArray<int32_t>(dca, SIMPL::Defaults::ImageDataContainerName, k_PyramidLabelsName);
+      FloatArrayType::Pointer eulers = GetLevelArray<float>(dca, SIMPL::Defaults::ImageDataContainerName, k_PyramidEulersName);
+      Int32ArrayType::Pointer levelLabels = GetLevelArray<int32_t>(dca, levelNames[0], k_PyramidLabelsName);
+      FloatArrayType::Pointer levelRamp = GetLevelArray<float>(dca, levelNames[0], k_PyramidRampName);
+      FloatArrayType::Pointer levelEulers = GetLevelArray<float>(dca, levelNames[0], k_PyramidEulersName);
+      for (size_t y = 0; y < levelDims[0][1]; y++)
+      {
+        for (size_t x = 0; x < levelDims[0][0]; x++)
+        {
+          size_t index = y * levelDims[0][0] + x;
+          size_t xEnd = (2 * x + 2 < dims[0]) ? 2 * x + 2 : dims[0];
+
+          std::map<int32_t, size_t> votes;
+          for (size_t sy = 2 * y; sy < 2 * y + 2; sy++)
+          {
+            for (size_t sx = 2 * x; sx < xEnd; sx++)
+            {
+              votes[labels->getValue(sy * dims[0] + sx)]++;
+            }
+          }
+          int32_t expected = votes.begin()->first;
+          size_t bestCount = 0;
+          for (std::map<int32_t, size_t>::iterator iter = votes.begin(); iter != votes.end(); ++iter)
+          {
+            if (iter->second > bestCount) { bestCount = iter->second; expected = iter->first; }
+          }
+          DREAM3D_REQUIRE_EQUAL(levelLabels->getValue(index), expected)
+
+          // The mean of the ramp over the block, which for the last odd column is that column
+          float cx = (xEnd - 2 * x == 2) ? 2.0f * x + 0.5f : 2.0f * x;
+          float ramp = RampValue(cx, 2.0f * y + 0.5f, 0.0f);
+          DREAM3D_REQUIRED(std::fabs(levelRamp->getValue(index) - ramp), <, 1.0e-4f)
+
+          size_t first = 2 * y * dims[0] + 2 * x;
+          for (int c = 0; c < 3; c++)
+          {
+            DREAM3D_REQUIRE_EQUAL(levelEulers->getComponent(index, c), eulers->getComponent(first, c))
+          }
+        }
+      }
+
+      // Every level averages symmetry equivalents of one orientation, so every level
+      // must still hold that orientation
+      SpaceGroupOps::Pointer cubic = SpaceGroupOps::getOrientationOpsQVector()[Ebsd::CrystalStructure::Cubic_High];
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      for (int level = 0; level < 3; level++)
+      {
+        FloatArrayType::Pointer quats = GetLevelArray<float>(dca, levelNames[level], SIMPL::CellData::Quats);
+        for (size_t i = 0; i < quats->getNumberOfTuples(); i++)
+        {
+          QuatF q = QuaternionMathF::New(quats->getComponent(i, 0), quats->getComponent(i, 1), quats->getComponent(i, 2), quats->getComponent(i, 3));
+          float miso = cubic->getMisoQuat(orientation, q, n1, n2, n3);
+          DREAM3D_REQUIRED(miso, <, 0.5f * SIMPLib::Constants::k_Pi / 180.0f)
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestGenerateImagePyramid())
+    }
+
+  private:
+    GenerateImagePyramidTest(const GenerateImagePyramidTest&); // Copy Constructor Not Implemented
+    void operator=(const GenerateImagePyramidTest&); // Operator '=' Not Implemented
+};
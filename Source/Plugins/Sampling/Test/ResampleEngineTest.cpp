@@ -0,0 +1,566 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <map>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/SecondOrderPolynomialFilterParameter.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+#include "Sampling/SamplingFilters/ResampleEngine.h"
+
+#include "SamplingTestFileLocations.h"
+
+static const QString k_ResampleLabelsName("Labels");
+static const QString k_ResampleRampName("Ramp");
+static const QString k_ResampleEulersName("Angles");
+
+class ResampleEngineTest
+{
+  public:
+    ResampleEngineTest(){}
+    virtual ~ResampleEngineTest(){}
+    SIMPL_TYPE_MACRO(ResampleEngineTest)
+
+    // -----------------------------------------------------------------------------
+    // Builds an image geometry with unit resolution holding a label array with plenty
+    // of ties, a linear ramp and a 3 component Euler angle array. The angles are not
+    // named like orientations, the smooth interpolation must go by the components.
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestVolume(const size_t dims[3])
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(dims[0], dims[1], dims[2]);
+      image->setResolution(1.0f, 1.0f, 1.0f);
+      image->setOrigin(0.0f, 0.0f, 0.0f);
+      m->setGeometry(image);
+
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = dims[0];
+      tDims[1] = dims[1];
+      tDims[2] = dims[2];
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer labels = Int32ArrayType::CreateArray(tDims, cDims, k_ResampleLabelsName, true);
+      FloatArrayType::Pointer ramp = FloatArrayType::CreateArray(tDims, cDims, k_ResampleRampName, true);
+      cDims[0] = 3;
+      FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(tDims, cDims, k_ResampleEulersName, true);
+
+      uint32_t seed = 12345;
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            size_t index = (z * dims[1] + y) * dims[0] + x;
+            seed = seed * 1103515245u + 12345u;
+            labels->setValue(index, static_cast<int32_t>((seed >> 16) % 3) + 1);
+            ramp->setValue(index, RampValue(x, y, z));
+            // Angles next to the 2 pi wrap, which blending would turn into meaningless values
+            eulers->setComponent(index, 0, (index % 2 == 0) ? 0.05f : 6.2f);
+            eulers->setComponent(index, 1, 0.01f * index);
+            eulers->setComponent(index, 2, 0.5f);
+          }
+        }
+      }
+      am->addAttributeArray(k_ResampleLabelsName, labels);
+      am->addAttributeArray(k_ResampleRampName, ramp);
+      am->addAttributeArray(k_ResampleEulersName, eulers);
+      m->addAttributeMatrix(am->getName(), am);
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    static float RampValue(float x, float y, float z)
+    {
+      return 3.0f * x + 2.0f * y - z + 1.0f;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    AbstractFilter::Pointer CreateResampleFilter(const QString& filtName, DataContainerArray::Pointer dca)
+    {
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+      bool propWasSet = filter->setProperty("CellAttributeMatrixPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      return filter;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    template<typename T>
+    typename DataArray<T>::Pointer GetCellArray(DataContainerArray::Pointer dca, const QString& name)
+    {
+      AttributeMatrix::Pointer am = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+      DREAM3D_REQUIRE_VALID_POINTER(am.get());
+      typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T> >(am->getAttributeArray(name));
+      DREAM3D_REQUIRE_VALID_POINTER(array.get());
+      return array;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    AbstractFilter::Pointer CreateChangeResolution(DataContainerArray::Pointer dca, FloatVec3_t resolution, int interpolation)
+    {
+      AbstractFilter::Pointer filter = CreateResampleFilter("ChangeResolution", dca);
+      QVariant var;
+      var.setValue(resolution);
+      bool propWasSet = filter->setProperty("Resolution", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(interpolation);
+      propWasSet = filter->setProperty("Interpolation", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(false);
+      propWasSet = filter->setProperty("RenumberFeatures", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("SaveAsNewDataContainer", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      // No orientations in the test volume
+      var.setValue(DataArrayPath());
+      propWasSet = filter->setProperty("QuatsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      return filter;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Nearest neighbor must pick the same source cell the filter always did
+    // -----------------------------------------------------------------------------
+    int TestChangeResolutionNearest()
+    {
+      size_t dims[3] = { 7, 5, 3 };
+      DataContainerArray::Pointer dca = CreateTestVolume(dims);
+      Int32ArrayType::Pointer labels = GetCellArray<int32_t>(dca, k_ResampleLabelsName);
+      FloatArrayType::Pointer eulers = GetCellArray<float>(dca, k_ResampleEulersName);
+
+      FloatVec3_t resolution;
+      resolution.x = 2.0f;
+      resolution.y = 1.5f;
+      resolution.z = 1.0f;
+      AbstractFilter::Pointer filter = CreateChangeResolution(dca, resolution, 0);
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      size_t newDims[3] = { 0, 0, 0 };
+      dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getGeometryAs<ImageGeom>()->getDimensions(newDims);
+      DREAM3D_REQUIRE_EQUAL(newDims[0], 3)
+      DREAM3D_REQUIRE_EQUAL(newDims[1], 3)
+      DREAM3D_REQUIRE_EQUAL(newDims[2], 3)
+
+      Int32ArrayType::Pointer newLabels = GetCellArray<int32_t>(dca, k_ResampleLabelsName);
+      FloatArrayType::Pointer newEulers = GetCellArray<float>(dca, k_ResampleEulersName);
+      DREAM3D_REQUIRE_EQUAL(newLabels->getNumberOfTuples(), 27)
+      for (size_t i = 0; i < newDims[2]; i++)
+      {
+        for (size_t j = 0; j < newDims[1]; j++)
+        {
+          for (size_t k = 0; k < newDims[0]; k++)
+          {
+            size_t col = size_t((k * resolution.x) / 1.0f);
+            size_t row = size_t((j * resolution.y) / 1.0f);
+            size_t plane = size_t((i * resolution.z) / 1.0f);
+            size_t indexOld = (plane * dims[1] * dims[0]) + (row * dims[0]) + col;
+            size_t index = (i * newDims[0] * newDims[1]) + (j * newDims[0]) + k;
+            DREAM3D_REQUIRE_EQUAL(newLabels->getValue(index), labels->getValue(indexOld))
+            for (int c = 0; c < 3; c++)
+            {
+              DREAM3D_REQUIRE_EQUAL(newEulers->getComponent(index, c), eulers->getComponent(indexOld, c))
+            }
+          }
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Smooth mode: labels are voted on, the ramp is interpolated exactly and the Euler
+    // angles are copied from the first cell of the footprint instead of being blended
+    // -----------------------------------------------------------------------------
+    int TestChangeResolutionSmooth()
+    {
+      size_t dims[3] = { 8, 6, 4 };
+      DataContainerArray::Pointer dca = CreateTestVolume(dims);
+      Int32ArrayType::Pointer labels = GetCellArray<int32_t>(dca, k_ResampleLabelsName);
+      FloatArrayType::Pointer eulers = GetCellArray<float>(dca, k_ResampleEulersName);
+
+      FloatVec3_t resolution;
+      resolution.x = 2.0f;
+      resolution.y = 2.0f;
+      resolution.z = 2.0f;
+      AbstractFilter::Pointer filter = CreateChangeResolution(dca, resolution, 1);
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      size_t newDims[3] = { 0, 0, 0 };
+      dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getGeometryAs<ImageGeom>()->getDimensions(newDims);
+      DREAM3D_REQUIRE_EQUAL(newDims[0], 4)
+      DREAM3D_REQUIRE_EQUAL(newDims[1], 3)
+      DREAM3D_REQUIRE_EQUAL(newDims[2], 2)
+
+      Int32ArrayType::Pointer newLabels = GetCellArray<int32_t>(dca, k_ResampleLabelsName);
+      FloatArrayType::Pointer newRamp = GetCellArray<float>(dca, k_ResampleRampName);
+      FloatArrayType::Pointer newEulers = GetCellArray<float>(dca, k_ResampleEulersName);
+      for (size_t i = 0; i < newDims[2]; i++)
+      {
+        for (size_t j = 0; j < newDims[1]; j++)
+        {
+          for (size_t k = 0; k < newDims[0]; k++)
+          {
+            size_t index = (i * newDims[0] * newDims[1]) + (j * newDims[0]) + k;
+
+            // Brute force vote over the 2x2x2 footprint, ties go to the smallest label
+            std::map<int32_t, size_t> votes;
+            for (size_t z = 2 * i; z < 2 * i + 2; z++)
+            {
+              for (size_t y = 2 * j; y < 2 * j + 2; y++)
+              {
+                for (size_t x = 2 * k; x < 2 * k + 2; x++)
+                {
+                  votes[labels->getValue((z * dims[1] + y) * dims[0] + x)]++;
+                }
+              }
+            }
+            int32_t expected = votes.begin()->first;
+            size_t bestCount = 0;
+            for (std::map<int32_t, size_t>::iterator iter = votes.begin(); iter != votes.end(); ++iter)
+            {
+              if (iter->second > bestCount) { bestCount = iter->second; expected = iter->first; }
+            }
+            DREAM3D_REQUIRE_EQUAL(newLabels->getValue(index), expected)
+
+            // The center of destination cell k sits at source coordinate 2 * k + 0.5
+            float ramp = RampValue(2.0f * k + 0.5f, 2.0f * j + 0.5f, 2.0f * i + 0.5f);
+            DREAM3D_REQUIRED(std::fabs(newRamp->getValue(index) - ramp), <, 1.0e-4f)
+
+            size_t first = (2 * i * dims[1] + 2 * j) * dims[0] + 2 * k;
+            for (int c = 0; c < 3; c++)
+            {
+              DREAM3D_REQUIRE_EQUAL(newEulers->getComponent(index, c), eulers->getComponent(first, c))
+            }
+          }
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // A 180 degree rotation about Z maps every cell onto the mirrored cell of the plane
+    // -----------------------------------------------------------------------------
+    int TestRotateSampleRefFrame()
+    {
+      size_t dims[3] = { 8, 6, 4 };
+      DataContainerArray::Pointer dca = CreateTestVolume(dims);
+      Int32ArrayType::Pointer labels = GetCellArray<int32_t>(dca, k_ResampleLabelsName);
+      FloatArrayType::Pointer ramp = GetCellArray<float>(dca, k_ResampleRampName);
+
+      AbstractFilter::Pointer filter = CreateResampleFilter("RotateSampleRefFrame", dca);
+      FloatVec3_t axis;
+      axis.x = 0.0f;
+      axis.y = 0.0f;
+      axis.z = 1.0f;
+      QVariant var;
+      var.setValue(axis);
+      bool propWasSet = filter->setProperty("RotationAxis", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(180.0f);
+      propWasSet = filter->setProperty("RotationAngle", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(false);
+      propWasSet = filter->setProperty("SliceBySlice", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      size_t newDims[3] = { 0, 0, 0 };
+      dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getGeometryAs<ImageGeom>()->getDimensions(newDims);
+      DREAM3D_REQUIRE_EQUAL(newDims[0], dims[0])
+      DREAM3D_REQUIRE_EQUAL(newDims[1], dims[1])
+      DREAM3D_REQUIRE_EQUAL(newDims[2], dims[2])
+
+      Int32ArrayType::Pointer newLabels = GetCellArray<int32_t>(dca, k_ResampleLabelsName);
+      FloatArrayType::Pointer newRamp = GetCellArray<float>(dca, k_ResampleRampName);
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            size_t index = (z * dims[1] + y) * dims[0] + x;
+            size_t indexOld = (z * dims[1] + (dims[1] - 1 - y)) * dims[0] + (dims[0] - 1 - x);
+            DREAM3D_REQUIRE_EQUAL(newLabels->getValue(index), labels->getValue(indexOld))
+            DREAM3D_REQUIRE_EQUAL(newRamp->getValue(index), ramp->getValue(indexOld))
+          }
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // A warp that shifts X by one cell. Cells that warp off the grid, and the first row
+    // which the filter has always treated as outside, receive a zero tuple
+    // -----------------------------------------------------------------------------
+    int TestWarpRegularGrid()
+    {
+      size_t dims[3] = { 8, 6, 4 };
+      DataContainerArray::Pointer dca = CreateTestVolume(dims);
+      Int32ArrayType::Pointer labels = GetCellArray<int32_t>(dca, k_ResampleLabelsName);
+      FloatArrayType::Pointer eulers = GetCellArray<float>(dca, k_ResampleEulersName);
+
+      AbstractFilter::Pointer filter = CreateResampleFilter("WarpRegularGrid", dca);
+      Float2ndOrderPoly_t a;
+      a.c20 = 0.0f; a.c02 = 0.0f; a.c11 = 0.0f; a.c10 = 1.0f; a.c01 = 0.0f; a.c00 = 1.0f;
+      Float2ndOrderPoly_t b;
+      b.c20 = 0.0f; b.c02 = 0.0f; b.c11 = 0.0f; b.c10 = 0.0f; b.c01 = 1.0f; b.c00 = 0.0f;
+      QVariant var;
+      var.setValue(0);
+      bool propWasSet = filter->setProperty("PolyOrder", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(a);
+      propWasSet = filter->setProperty("SecondOrderACoeff", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(b);
+      propWasSet = filter->setProperty("SecondOrderBCoeff", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(false);
+      propWasSet = filter->setProperty("SaveAsNewDataContainer", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      Int32ArrayType::Pointer newLabels = GetCellArray<int32_t>(dca, k_ResampleLabelsName);
+      FloatArrayType::Pointer newEulers = GetCellArray<float>(dca, k_ResampleEulersName);
+      DREAM3D_REQUIRE_EQUAL(newLabels->getNumberOfTuples(), labels->getNumberOfTuples())
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            size_t index = (z * dims[1] + y) * dims[0] + x;
+            if (x + 1 < dims[0] && y > 0)
+            {
+              size_t indexOld = index + 1;
+              DREAM3D_REQUIRE_EQUAL(newLabels->getValue(index), labels->getValue(indexOld))
+              for (int c = 0; c < 3; c++)
+              {
+                DREAM3D_REQUIRE_EQUAL(newEulers->getComponent(index, c), eulers->getComponent(indexOld, c))
+              }
+            }
+            else
+            {
+              DREAM3D_REQUIRE_EQUAL(newLabels->getValue(index), 0)
+              for (int c = 0; c < 3; c++)
+              {
+                DREAM3D_REQUIRE_EQUAL(newEulers->getComponent(index, c), 0.0f)
+              }
+            }
+          }
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Every footprint holds cubic symmetry equivalents of one orientation, half of them
+    // negated. The second footprint also holds cells of a hexagonal phase that are outvoted.
+    // A component wise mean of those quaternions would be a different orientation.
+    // -----------------------------------------------------------------------------
+    int TestQuaternionAverage()
+    {
+      size_t srcDims[3] = { 4, 2, 2 };
+      size_t dstDims[3] = { 2, 1, 1 };
+      size_t numSrc = srcDims[0] * srcDims[1] * srcDims[2];
+
+      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+      SpaceGroupOps::Pointer cubic = ops[Ebsd::CrystalStructure::Cubic_High];
+
+      QVector<size_t> tDims(1, numSrc);
+      QVector<size_t> cDims(1, 4);
+      FloatArrayType::Pointer quats = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Quats, true);
+      cDims[0] = 1;
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
+      UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, SIMPL::EnsembleData::CrystalStructures);
+      crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+      crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+      crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+
+      QuatF orientations[2] = { QuaternionMathF::New(0.1f, -0.3f, 0.4f, 0.6f), QuaternionMathF::New(-0.5f, 0.2f, 0.1f, 0.3f) };
+      QuaternionMathF::UnitQuaternion(orientations[0]);
+      QuaternionMathF::UnitQuaternion(orientations[1]);
+
+      size_t n = 0;
+      for (size_t z = 0; z < srcDims[2]; z++)
+      {
+        for (size_t y = 0; y < srcDims[1]; y++)
+        {
+          for (size_t x = 0; x < srcDims[0]; x++)
+          {
+            size_t index = (z * srcDims[1] + y) * srcDims[0] + x;
+            size_t footprint = x / 2;
+            QuatF symOp = QuaternionMathF::New();
+            cubic->getQuatSymOp(static_cast<int>((5 * n + 3) % cubic->getNumSymOps()), symOp);
+            QuatF q = QuaternionMathF::New();
+            QuaternionMathF::Multiply(symOp, orientations[footprint], q);
+            if (n % 2 == 1) { QuaternionMathF::Negate(q); }
+            int32_t phase = 1;
+            if (footprint == 1 && x == 3 && y + z < 2)
+            {
+              // Three of the eight cells belong to another phase with an unrelated orientation
+              phase = 2;
+              q = QuaternionMathF::New(0.9f, 0.1f, 0.0f, 0.42f);
+              QuaternionMathF::UnitQuaternion(q);
+            }
+            quats->setComponent(index, 0, q.x);
+            quats->setComponent(index, 1, q.y);
+            quats->setComponent(index, 2, q.z);
+            quats->setComponent(index, 3, q.w);
+            phases->setValue(index, phase);
+            n++;
+          }
+        }
+      }
+
+      ResampleEngine engine(srcDims, dstDims);
+      float scale[3] = { 2.0f, 2.0f, 2.0f };
+      engine.setScaling(scale);
+      engine.setOrientationData(phases, crystalStructures);
+      FloatArrayType::Pointer result = std::dynamic_pointer_cast<FloatArrayType>(engine.resampleArray(quats, ResampleEngine::QuaternionAverage));
+      DREAM3D_REQUIRE_VALID_POINTER(result.get());
+      DREAM3D_REQUIRE_EQUAL(result->getNumberOfTuples(), 2)
+
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      for (size_t i = 0; i < 2; i++)
+      {
+        QuatF avg = QuaternionMathF::New(result->getComponent(i, 0), result->getComponent(i, 1), result->getComponent(i, 2), result->getComponent(i, 3));
+        float norm = std::sqrt(avg.x * avg.x + avg.y * avg.y + avg.z * avg.z + avg.w * avg.w);
+        DREAM3D_REQUIRED(std::fabs(norm - 1.0f), <, 1.0e-4f)
+        float miso = cubic->getMisoQuat(orientations[i], avg, n1, n2, n3);
+        DREAM3D_REQUIRED(miso, <, 0.5f * SIMPLib::Constants::k_Pi / 180.0f)
+      }
+
+      // Without orientation data the quaternions are copied, never blended
+      ResampleEngine plain(srcDims, dstDims);
+      plain.setScaling(scale);
+      result = std::dynamic_pointer_cast<FloatArrayType>(plain.resampleArray(quats, ResampleEngine::QuaternionAverage));
+      DREAM3D_REQUIRE_VALID_POINTER(result.get());
+      for (int c = 0; c < 4; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(result->getComponent(0, c), quats->getComponent(0, c))
+        DREAM3D_REQUIRE_EQUAL(result->getComponent(1, c), quats->getComponent(2, c))
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The smooth interpolation depends on the type and component count only, never on
+    // the array name
+    // -----------------------------------------------------------------------------
+    int TestSmoothInterpolationType()
+    {
+      QVector<size_t> tDims(1, 4);
+      QVector<size_t> cDims(1, 1);
+      IDataArray::Pointer scalar = FloatArrayType::CreateArray(tDims, cDims, "QuatErrors", true);
+      DREAM3D_REQUIRE_EQUAL(ResampleEngine::SmoothInterpolationType(scalar), ResampleEngine::Trilinear)
+      scalar = DoubleArrayType::CreateArray(tDims, cDims, "EulerDistance", true);
+      DREAM3D_REQUIRE_EQUAL(ResampleEngine::SmoothInterpolationType(scalar), ResampleEngine::Trilinear)
+      IDataArray::Pointer labels = Int32ArrayType::CreateArray(tDims, cDims, "Quats", true);
+      DREAM3D_REQUIRE_EQUAL(ResampleEngine::SmoothInterpolationType(labels), ResampleEngine::MajorityVote)
+      labels = BoolArrayType::CreateArray(tDims, cDims, "Mask", true);
+      DREAM3D_REQUIRE_EQUAL(ResampleEngine::SmoothInterpolationType(labels), ResampleEngine::MajorityVote)
+
+      cDims[0] = 3;
+      IDataArray::Pointer tuples = FloatArrayType::CreateArray(tDims, cDims, "Orientation", true);
+      DREAM3D_REQUIRE_EQUAL(ResampleEngine::SmoothInterpolationType(tuples), ResampleEngine::NearestNeighbor)
+      cDims[0] = 4;
+      tuples = DoubleArrayType::CreateArray(tDims, cDims, "Rotation", true);
+      DREAM3D_REQUIRE_EQUAL(ResampleEngine::SmoothInterpolationType(tuples), ResampleEngine::NearestNeighbor)
+      labels = UInt8ArrayType::CreateArray(tDims, cDims, "IPFColors", true);
+      DREAM3D_REQUIRE_EQUAL(ResampleEngine::SmoothInterpolationType(labels), ResampleEngine::MajorityVote)
+      return EXIT_SUCCESS;
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestChangeResolutionNearest())
+      DREAM3D_REGISTER_TEST(TestChangeResolutionSmooth())
+      DREAM3D_REGISTER_TEST(TestRotateSampleRefFrame())
+      DREAM3D_REGISTER_TEST(TestWarpRegularGrid())
+      DREAM3D_REGISTER_TEST(TestQuaternionAverage())
+      DREAM3D_REGISTER_TEST(TestSmoothInterpolationType())
+    }
+
+  private:
+    ResampleEngineTest(const ResampleEngineTest&); // Copy Constructor Not Implemented
+    void operator=(const ResampleEngineTest&); // Operator '=' Not Implemented
+};
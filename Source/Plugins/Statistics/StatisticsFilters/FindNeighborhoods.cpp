@@ -35,6 +35,16 @@
 
 #include "FindNeighborhoods.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -46,11 +56,108 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/FlatNeighborList.h"
+
 #include "Statistics/StatisticsConstants.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindNeighborhoods.cpp"
 
+/**
+ * @brief The FindNeighborhoodsImpl class finds the neighborhoods of a range of Features.
+ * Feature j is in the neighborhood of Feature i if the bins of their centroids are less
+ * than the critical distance of i apart along every axis. The Features are bucketed by
+ * bin, so only the bins within reach of a Feature are searched. A Feature whose bin is
+ * negative has no finite centroid and is in no neighborhood. The class is run once
+ * to count the neighborhoods and once more to fill them in.
+ */
+class FindNeighborhoodsImpl
+{
+  public:
+    FindNeighborhoodsImpl(const int64_t* bins, const float* criticalDistance, const int64_t binDims[3],
+                          const FlatNeighborList<int32_t>* binMembers, FlatNeighborList<int32_t>* neighborhoods, bool fill) :
+      m_Bins(bins),
+      m_CriticalDistance(criticalDistance),
+      m_BinMembers(binMembers),
+      m_Neighborhoods(neighborhoods),
+      m_Fill(fill)
+    {
+      m_BinDims[0] = binDims[0];
+      m_BinDims[1] = binDims[1];
+      m_BinDims[2] = binDims[2];
+    }
+    virtual ~FindNeighborhoodsImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      std::vector<int32_t> found;
+      for (size_t i = start; i < end; i++)
+      {
+        if (i == 0 || m_Bins[3 * i] < 0) { continue; }
+        found.clear();
+
+        // The bin distances are whole numbers, so the largest one that is still smaller
+        // than the critical distance is the number of bins to search on either side
+        float criticalDistance = m_CriticalDistance[i];
+        int64_t maxDim = std::max(m_BinDims[0], std::max(m_BinDims[1], m_BinDims[2]));
+        int64_t reach = -1;
+        if (criticalDistance > static_cast<float>(maxDim)) { reach = maxDim; }
+        else if (criticalDistance > 0.0f) { reach = static_cast<int64_t>(std::ceil(criticalDistance)) - 1; }
+
+        if (reach >= 0)
+        {
+          int64_t lo[3] = { 0, 0, 0 };
+          int64_t hi[3] = { 0, 0, 0 };
+          for (int32_t d = 0; d < 3; d++)
+          {
+            lo[d] = std::max<int64_t>(m_Bins[3 * i + d] - reach, 0);
+            hi[d] = std::min<int64_t>(m_Bins[3 * i + d] + reach, m_BinDims[d] - 1);
+          }
+          for (int64_t z = lo[2]; z <= hi[2]; z++)
+          {
+            for (int64_t y = lo[1]; y <= hi[1]; y++)
+            {
+              for (int64_t x = lo[0]; x <= hi[0]; x++)
+              {
+                size_t bin = static_cast<size_t>((z * m_BinDims[1] + y) * m_BinDims[0] + x);
+                const int32_t* members = m_BinMembers->getList(bin);
+                size_t numMembers = m_BinMembers->getListSize(bin);
+                for (size_t m = 0; m < numMembers; m++)
+                {
+                  if (static_cast<size_t>(members[m]) != i) { found.push_back(members[m]); }
+                }
+              }
+            }
+          }
+        }
+
+        if (m_Fill == false)
+        {
+          m_Neighborhoods->setListSize(i, found.size());
+        }
+        else
+        {
+          std::sort(found.begin(), found.end());
+          std::copy(found.begin(), found.end(), m_Neighborhoods->getList(i));
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const int64_t* m_Bins;
+    const float* m_CriticalDistance;
+    int64_t m_BinDims[3];
+    const FlatNeighborList<int32_t>* m_BinMembers;
+    FlatNeighborList<int32_t>* m_Neighborhoods;
+    bool m_Fill;
+};
 
 
 // -----------------------------------------------------------------------------
@@ -206,15 +313,12 @@ void FindNeighborhoods::preflight()
 // -----------------------------------------------------------------------------
 void FindNeighborhoods::find_neighborhoods()
 {
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-
-  std::vector<std::vector<int32_t> > neighborhoodlist;
   std::vector<float> criticalDistance;
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_EquivalentDiametersArrayPath.getDataContainerName());
   size_t totalFeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
 
-  neighborhoodlist.resize(totalFeatures);
+  if (totalFeatures < 2) { return; }
   criticalDistance.resize(totalFeatures);
 
   float aveDiam = 0.0f;
@@ -230,78 +334,88 @@ void FindNeighborhoods::find_neighborhoods()
     criticalDistance[i] /= aveDiam;
   }
 
-  float m_OriginX = 0.0f, m_OriginY = 0.0f, m_OriginZ = 0.0f;
-  m->getGeometryAs<ImageGeom>()->getOrigin(m_OriginX, m_OriginY, m_OriginZ);
+  float origin[3] = { 0.0f, 0.0f, 0.0f };
+  float res[3] = { 0.0f, 0.0f, 0.0f };
   size_t udims[3] = { 0, 0, 0 };
+  m->getGeometryAs<ImageGeom>()->getOrigin(origin);
+  m->getGeometryAs<ImageGeom>()->getResolution(res);
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
 
-  size_t xbin = 0, ybin = 0, zbin = 0;
-  std::vector<int64_t> bins(3 * totalFeatures, 0);
-  for (size_t i = 1; i < totalFeatures; i++)
+  // The bin grid spans the geometry, so its size does not depend on the centroids. A Feature
+  // that owns no cells has a NaN centroid; it gets bin -1 and is left out of every neighborhood
+  int64_t binDims[3] = { 1, 1, 1 };
+  for (int32_t d = 0; d < 3; d++)
   {
-    x = m_Centroids[3 * i];
-    y = m_Centroids[3 * i + 1];
-    z = m_Centroids[3 * i + 2];
-    xbin = int32_t((x - m_OriginX) / aveDiam);
-    ybin = int32_t((y - m_OriginY) / aveDiam);
-    zbin = int32_t((z - m_OriginZ) / aveDiam);
-    bins[3 * i] = xbin;
-    bins[3 * i + 1] = ybin;
-    bins[3 * i + 2] = zbin;
+    float extent = static_cast<float>(udims[d]) * res[d] / aveDiam;
+    if (std::isfinite(extent) && extent > 0.0f) { binDims[d] = static_cast<int64_t>(extent) + 1; }
   }
 
-  int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
-  float dBinX = 0, dBinY = 0, dBinZ = 0;
-  float criticalDistance1 = 0, criticalDistance2 = 0;
-
+  std::vector<int64_t> bins(3 * totalFeatures, -1);
   for (size_t i = 1; i < totalFeatures; i++)
   {
-    if (i % 1000 == 0)
+    float binf[3] = { 0.0f, 0.0f, 0.0f };
+    bool valid = true;
+    for (int32_t d = 0; d < 3; d++)
     {
-
-      QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalFeatures);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      binf[d] = (m_Centroids[3 * i + d] - origin[d]) / aveDiam;
+      if (std::isfinite(binf[d]) == false) { valid = false; }
     }
-    x = m_Centroids[3 * i];
-    y = m_Centroids[3 * i + 1];
-    z = m_Centroids[3 * i + 2];
-    bin1x = bins[3 * i];
-    bin1y = bins[3 * i + 1];
-    bin1z = bins[3 * i + 2];
-    criticalDistance1 = criticalDistance[i];
-
-    for (size_t j = i + 1; j < totalFeatures; j++)
+    if (valid == false) { continue; }
+    for (int32_t d = 0; d < 3; d++)
     {
-      bin2x = bins[3 * j];
-      bin2y = bins[3 * j + 1];
-      bin2z = bins[3 * j + 2];
-      criticalDistance2 = criticalDistance[j];
-      // Use the llabs version of the "C" abs function because we are using int64_t
-      // do NOT try to use the std::abs() function as this is C++11 ONLY
-      dBinX = llabs(bin2x - bin1x);
-      dBinY = llabs(bin2y - bin1y);
-      dBinZ = llabs(bin2z - bin1z);
-
-      if (dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
-      {
-        m_Neighborhoods[i]++;
-        neighborhoodlist[i].push_back(j);
-      }
+      binf[d] = std::max(0.0f, std::min(binf[d], static_cast<float>(binDims[d] - 1)));
+      bins[3 * i + d] = static_cast<int64_t>(binf[d]);
+    }
+  }
 
-      if (dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
-      {
-        m_Neighborhoods[j]++;
-        neighborhoodlist[j].push_back(i);
-      }
+  FlatNeighborList<int32_t> binMembers;
+  binMembers.setNumberOfFeatures(static_cast<size_t>(binDims[0] * binDims[1] * binDims[2]));
+  for (int32_t sweep = 0; sweep < 2; sweep++)
+  {
+    if (sweep == 1) { binMembers.allocate(); }
+    for (size_t i = 1; i < totalFeatures; i++)
+    {
+      if (bins[3 * i] < 0) { continue; }
+      size_t bin = static_cast<size_t>((bins[3 * i + 2] * binDims[1] + bins[3 * i + 1]) * binDims[0] + bins[3 * i]);
+      if (sweep == 0) { binMembers.addToListSize(bin); }
+      else { binMembers.append(bin, static_cast<int32_t>(i)); }
+    }
+  }
+
+  if (getCancel() == true) { return; }
+
+  FlatNeighborList<int32_t> neighborhoods;
+  neighborhoods.setNumberOfFeatures(totalFeatures);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  for (int32_t sweep = 0; sweep < 2; sweep++)
+  {
+    if (sweep == 1) { neighborhoods.allocate(); }
+    FindNeighborhoodsImpl impl(&(bins.front()), &(criticalDistance.front()), binDims, &binMembers, &neighborhoods, sweep == 1);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalFeatures), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, totalFeatures);
     }
+
+    if (getCancel() == true) { return; }
   }
+
   for (size_t i = 1; i < totalFeatures; i++)
   {
-    // Set the vector for each list into the NeighborhoodList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborhoodlist[i].begin(), neighborhoodlist[i].end());
-    m_NeighborhoodList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
+    m_Neighborhoods[i] = static_cast<int32_t>(neighborhoods.getListSize(i));
   }
+  neighborhoods.copyToNeighborList(m_NeighborhoodList.lock());
 }
 
 // -----------------------------------------------------------------------------
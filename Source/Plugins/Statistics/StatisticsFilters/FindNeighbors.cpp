@@ -35,6 +35,8 @@
 
 #include "FindNeighbors.h"
 
+#include <algorithm>
+
 #include <QtCore/QDateTime>
 
 #include "SIMPLib/Common/Constants.h"
@@ -48,6 +50,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/FlatNeighborList.h"
+
 #include "Statistics/StatisticsConstants.h"
 
 // Include the MOC generated file for this class
@@ -261,99 +265,111 @@ void FindNeighbors::execute()
   neighpoints[4] = dims[0];
   neighpoints[5] = dims[0] * dims[1];
 
+  int64_t xPoints = dims[0];
+  int64_t yPoints = dims[1];
+  int64_t zPoints = dims[2];
+
   int64_t column = 0, row = 0, plane = 0;
   int32_t feature = 0;
-  int32_t nnum = 0;
   int8_t onsurf = 0;
   bool good = false;
   int64_t neighbor = 0;
 
-  std::vector<std::vector<int32_t> > neighborlist;
-  std::vector<std::vector<float> > neighborsurfacearealist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
-
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t currentMillis = millis;
 
   for (size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if (currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if (getCancel() == true) { return; }
-
     m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
     if (m_StoreSurfaceFeatures == true) { m_SurfaceFeatures[i] = false; }
-
   }
 
-  for (size_t j = 0; j < totalPoints; j++)
+  // Every face between a cell of a Feature and a cell of another (positive) Feature is
+  // recorded in the list of the first Feature. The first sweep counts the faces of each
+  // Feature so the second sweep can write them straight into one flat array.
+  FlatNeighborList<int32_t> faces;
+  faces.setNumberOfFeatures(totalFeatures);
+
+  for (int32_t sweep = 0; sweep < 2; sweep++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if (currentMillis - millis > 1000)
+    if (sweep == 1) { faces.allocate(); }
+
+    for (size_t j = 0; j < totalPoints; j++)
     {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
+      currentMillis = QDateTime::currentMSecsSinceEpoch();
+      if (currentMillis - millis > 1000)
+      {
+        QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists (Sweep %1 of 2) || %2% Complete").arg(sweep + 1).arg((static_cast<float>(j) / totalPoints) * 100);
+        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+        millis = QDateTime::currentMSecsSinceEpoch();
+      }
 
-    if (getCancel() == true) { return; }
+      if (getCancel() == true) { return; }
 
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if (feature > 0)
-    {
-      column = static_cast<int64_t>( j % m->getGeometryAs<ImageGeom>()->getXPoints() );
-      row = static_cast<int64_t>( (j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints() );
-      plane = static_cast<int64_t>( j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()) );
-      if (m_StoreSurfaceFeatures == true)
+      onsurf = 0;
+      feature = m_FeatureIds[j];
+      if (feature > 0)
       {
-        if ((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-             || row == 0 || row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1)
-             || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1)))
-            && m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
+        column = static_cast<int64_t>( j % xPoints );
+        row = static_cast<int64_t>( (j / xPoints) % yPoints );
+        plane = static_cast<int64_t>( j / (xPoints * yPoints) );
+        if (m_StoreSurfaceFeatures == true && sweep == 0)
         {
-          m_SurfaceFeatures[feature] = true;
+          if ((column == 0 || column == (xPoints - 1) || row == 0 || row == (yPoints - 1) || plane == 0 || plane == (zPoints - 1)) && zPoints != 1)
+          {
+            m_SurfaceFeatures[feature] = true;
+          }
+          if ((column == 0 || column == (xPoints - 1) || row == 0 || row == (yPoints - 1)) && zPoints == 1)
+          {
+            m_SurfaceFeatures[feature] = true;
+          }
         }
-        if ((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 || row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) && m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
+        for (int32_t k = 0; k < 6; k++)
         {
-          m_SurfaceFeatures[feature] = true;
-        }
-      }
-      for (int32_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64_t>( j + neighpoints[k] );
-        if (k == 0 && plane == 0) { good = false; }
-        if (k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1)) { good = false; }
-        if (k == 1 && row == 0) { good = false; }
-        if (k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1)) { good = false; }
-        if (k == 2 && column == 0) { good = false; }
-        if (k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) { good = false; }
-        if (good == true && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
+          good = true;
+          neighbor = static_cast<int64_t>( j + neighpoints[k] );
+          if (k == 0 && plane == 0) { good = false; }
+          if (k == 5 && plane == (zPoints - 1)) { good = false; }
+          if (k == 1 && row == 0) { good = false; }
+          if (k == 4 && row == (yPoints - 1)) { good = false; }
+          if (k == 2 && column == 0) { good = false; }
+          if (k == 3 && column == (xPoints - 1)) { good = false; }
+          if (good == true && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
+          {
+            onsurf++;
+            if (sweep == 0) { faces.addToListSize(feature); }
+            else { faces.append(feature, m_FeatureIds[neighbor]); }
+          }
         }
       }
+      if (m_StoreBoundaryCells == true && sweep == 0) { m_BoundaryCells[j] = onsurf; }
     }
-    if (m_StoreBoundaryCells == true) { m_BoundaryCells[j] = onsurf; }
   }
 
-  // We do this to create new set of NeighborList objects
+  // Sorting the faces of each Feature groups them by neighbor; each run of equal
+  // neighbors becomes one entry of the neighbor list, with the shared surface area
+  // given by the length of the run. Neighbors come out in ascending order.
+  FlatNeighborList<int32_t> neighbors;
+  neighbors.setNumberOfFeatures(totalFeatures);
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    if (getCancel() == true) { return; }
+
+    int32_t* list = faces.getList(i);
+    size_t numFaces = faces.getListSize(i);
+    std::sort(list, list + numFaces);
+    for (size_t f = 0; f < numFaces; f++)
+    {
+      if (f == 0 || list[f] != list[f - 1]) { m_NumNeighbors[i]++; }
+    }
+    neighbors.setListSize(i, m_NumNeighbors[i]);
+  }
+  neighbors.allocate();
+
+  FlatNeighborList<float> surfaceAreas;
+  surfaceAreas.copyLayout(neighbors);
+
+  float faceArea = m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getYRes();
   for (size_t i = 1; i < totalFeatures; i++)
   {
     currentMillis = QDateTime::currentMSecsSinceEpoch();
@@ -364,48 +380,25 @@ void FindNeighbors::execute()
       millis = QDateTime::currentMSecsSinceEpoch();
     }
 
-    if(getCancel() == true) { return; }
-
-
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>( neighborlist[i].size() );
-
-    // this increments the voxel counts for each feature
-    for (int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
+    if (getCancel() == true) { return; }
 
-    for (QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
+    const int32_t* list = faces.getList(i);
+    size_t numFaces = faces.getListSize(i);
+    size_t runStart = 0;
+    for (size_t f = 1; f <= numFaces; f++)
     {
-      int32_t neigh = iter.key(); // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getYRes();
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
+      if (f == numFaces || list[f] != list[runStart])
+      {
+        neighbors.append(i, list[runStart]);
+        surfaceAreas.append(i, float(f - runStart) * faceArea);
+        runStart = f;
+      }
     }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
-    m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
-
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
-    m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
   }
 
+  neighbors.copyToNeighborList(m_NeighborList.lock());
+  surfaceAreas.copyToNeighborList(m_SharedSurfaceAreaList.lock());
+
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
@@ -34,6 +34,13 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindShapes.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -46,13 +53,257 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/FeatureStatisticsEngine.h"
 
 #include "Statistics/StatisticsConstants.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindShapes.cpp"
 
+namespace
+{
+  /**
+   * @brief SymmetricEigenvalues Solves the characteristic cubic of the symmetric 3x3 tensors
+   * stored as (xx, yy, zz, xy, yz, xz) for the Features in [start, end). The roots are written
+   * in descending order. The loop body has no data dependent branches so that the compiler can
+   * vectorize a block of Features at a time.
+   */
+  void SymmetricEigenvalues(const double* moments, double* eigenvalues, size_t start, size_t end)
+  {
+    for (size_t i = start; i < end; i++)
+    {
+      const double* t = moments + 6 * i;
+      double Ixx = t[0], Iyy = t[1], Izz = t[2], Ixy = t[3], Iyz = t[4], Ixz = t[5];
+
+      double b = (-Ixx - Iyy - Izz);
+      double c = ((Ixx * Izz) + (Ixx * Iyy) + (Iyy * Izz) - (Ixz * Ixz) - (Ixy * Ixy) - (Iyz * Iyz));
+      double d = ((Ixz * Iyy * Ixz) + (Ixy * Izz * Ixy) + (Iyz * Ixx * Iyz) - (Ixx * Iyy * Izz) - (Ixy * Iyz * Ixz) - (Ixy * Iyz * Ixz));
+      // f and g are the p and q values when reducing the cubic equation to t^3 + pt + q = 0
+      double f = ((3.0 * c) - (b * b)) / 3.0;
+      double g = ((2.0 * b * b * b) - (9.0 * b * c) + (27.0 * d)) / 27.0;
+      double h = (g * g / 4.0) + (f * f * f / 27.0);
+      double rsquare = (g * g / 4.0) - h;
+      double r = (rsquare > 0.0) ? sqrt(rsquare) : 0.0;
+      double value = (r != 0.0) ? -g / (2.0 * r) : 1.0;
+      value = (value > 1.0) ? 1.0 : value;
+      value = (value < -1.0) ? -1.0 : value;
+      double theta = acos(value);
+
+      double const1 = pow(r, 0.33333333333);
+      double const2 = cos(theta / 3.0);
+      double const3 = b / 3.0;
+      double const4 = 1.7320508 * sin(theta / 3.0);
+
+      eigenvalues[3 * i] = 2 * const1 * const2 - (const3);
+      eigenvalues[3 * i + 1] = -const1 * (const2 - (const4)) - const3;
+      eigenvalues[3 * i + 2] = -const1 * (const2 + (const4)) - const3;
+    }
+  }
+
+  /**
+   * @brief SymmetricEigenvector Computes the unit eigenvector of the symmetric tensor t for the
+   * eigenvalue lambda as the largest cross product of two rows of (t - lambda * I). Returns false
+   * if lambda is a repeated eigenvalue, in which case the rows do not span a plane. The sign is
+   * chosen so that the largest component is positive.
+   */
+  bool SymmetricEigenvector(const double* t, double lambda, double scale, double v[3])
+  {
+    double r0[3] = { t[0] - lambda, t[3], t[5] };
+    double r1[3] = { t[3], t[1] - lambda, t[4] };
+    double r2[3] = { t[5], t[4], t[2] - lambda };
+    double c[3][3] =
+    {
+      { r0[1] * r1[2] - r0[2] * r1[1], r0[2] * r1[0] - r0[0] * r1[2], r0[0] * r1[1] - r0[1] * r1[0] },
+      { r0[1] * r2[2] - r0[2] * r2[1], r0[2] * r2[0] - r0[0] * r2[2], r0[0] * r2[1] - r0[1] * r2[0] },
+      { r1[1] * r2[2] - r1[2] * r2[1], r1[2] * r2[0] - r1[0] * r2[2], r1[0] * r2[1] - r1[1] * r2[0] }
+    };
+    int32_t best = 0;
+    double bestNorm = 0.0;
+    for (int32_t n = 0; n < 3; n++)
+    {
+      double norm = c[n][0] * c[n][0] + c[n][1] * c[n][1] + c[n][2] * c[n][2];
+      if (norm > bestNorm) { bestNorm = norm, best = n; }
+    }
+    if (bestNorm <= 1.0e-20 * scale * scale * scale * scale) { return false; }
+    bestNorm = sqrt(bestNorm);
+    int32_t largest = 0;
+    for (int32_t n = 0; n < 3; n++)
+    {
+      v[n] = c[best][n] / bestNorm;
+      if (fabs(v[n]) > fabs(v[largest])) { largest = n; }
+    }
+    if (v[largest] < 0.0)
+    {
+      v[0] = -v[0], v[1] = -v[1], v[2] = -v[2];
+    }
+    return true;
+  }
+
+  /**
+   * @brief PerpendicularUnitVector Returns a unit vector perpendicular to the unit vector n
+   */
+  void PerpendicularUnitVector(const double n[3], double p[3])
+  {
+    // Cross with the coordinate axis that is the least parallel to n
+    if (fabs(n[0]) <= fabs(n[1]) && fabs(n[0]) <= fabs(n[2])) { p[0] = 0.0, p[1] = n[2], p[2] = -n[1]; }
+    else if (fabs(n[1]) <= fabs(n[2])) { p[0] = -n[2], p[1] = 0.0, p[2] = n[0]; }
+    else { p[0] = n[1], p[1] = -n[0], p[2] = 0.0; }
+    double norm = sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    p[0] /= norm, p[1] /= norm, p[2] /= norm;
+  }
+
+  void Cross(const double a[3], const double b[3], double c[3])
+  {
+    c[0] = a[1] * b[2] - a[2] * b[1];
+    c[1] = a[2] * b[0] - a[0] * b[2];
+    c[2] = a[0] * b[1] - a[1] * b[0];
+  }
+}
+
+/**
+ * @brief The FindShapesAxesImpl class computes the principal axis lengths and aspect ratios
+ * of a range of Features from their inertia tensors
+ */
+class FindShapesAxesImpl
+{
+  public:
+    FindShapesAxesImpl(double* moments, double* eigenvalues, float* axisLengths, float* aspectRatios, double scaleFactor) :
+      m_Moments(moments),
+      m_EigenValues(eigenvalues),
+      m_AxisLengths(axisLengths),
+      m_AspectRatios(aspectRatios),
+      m_ScaleFactor(scaleFactor)
+    {}
+    virtual ~FindShapesAxesImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      SymmetricEigenvalues(m_Moments, m_EigenValues, start, end);
+      for (size_t i = start; i < end; i++)
+      {
+        double r1 = m_EigenValues[3 * i];
+        double r2 = m_EigenValues[3 * i + 1];
+        double r3 = m_EigenValues[3 * i + 2];
+
+        double I1 = (15.0 * r1) / (4.0 * M_PI);
+        double I2 = (15.0 * r2) / (4.0 * M_PI);
+        double I3 = (15.0 * r3) / (4.0 * M_PI);
+        double A = (I1 + I2 - I3) / 2.0f;
+        double B = (I1 + I3 - I2) / 2.0f;
+        double C = (I2 + I3 - I1) / 2.0f;
+        double a = (A * A * A * A) / (B * C);
+        a = pow(a, 0.1);
+        double b = B / A;
+        b = sqrt(b) * a;
+        double c = A / (a * a * a * b);
+
+        m_AxisLengths[3 * i] = static_cast<float>(a / m_ScaleFactor);
+        m_AxisLengths[3 * i + 1] = static_cast<float>(b / m_ScaleFactor);
+        m_AxisLengths[3 * i + 2] = static_cast<float>(c / m_ScaleFactor);
+        float bovera = static_cast<float>(b / a);
+        float covera = static_cast<float>(c / a);
+        if (A == 0 || B == 0 || C == 0) { bovera = 0.0f, covera = 0.0f; }
+        m_AspectRatios[2 * i] = bovera;
+        m_AspectRatios[2 * i + 1] = covera;
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    double* m_Moments;
+    double* m_EigenValues;
+    float* m_AxisLengths;
+    float* m_AspectRatios;
+    double m_ScaleFactor;
+};
+
+/**
+ * @brief The FindShapesAxisEulersImpl class computes the orientation of the principal axes
+ * of a range of Features as Euler angles
+ */
+class FindShapesAxisEulersImpl
+{
+  public:
+    FindShapesAxisEulersImpl(double* moments, double* eigenvalues, float* axisEulerAngles) :
+      m_Moments(moments),
+      m_EigenValues(eigenvalues),
+      m_AxisEulerAngles(axisEulerAngles)
+    {}
+    virtual ~FindShapesAxisEulersImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        const double* t = m_Moments + 6 * i;
+        const double* e = m_EigenValues + 3 * i;
+        double scale = fabs(e[0]);
+        if (fabs(e[2]) > scale) { scale = fabs(e[2]); }
+
+        // n1 belongs to the largest and n3 to the smallest eigenvalue. A repeated eigenvalue
+        // leaves its axis free within a plane, any vector of that plane is used then.
+        double n1[3] = { 1.0, 0.0, 0.0 };
+        double n2[3] = { 0.0, 1.0, 0.0 };
+        double n3[3] = { 0.0, 0.0, 1.0 };
+        bool good1 = SymmetricEigenvector(t, e[0], scale, n1);
+        bool good3 = SymmetricEigenvector(t, e[2], scale, n3);
+        if (good1 == true && good3 == false) { PerpendicularUnitVector(n1, n3); }
+        if (good1 == false && good3 == true) { PerpendicularUnitVector(n3, n1); }
+        if (good1 == true || good3 == true)
+        {
+          Cross(n1, n3, n2);
+          double norm2 = sqrt(n2[0] * n2[0] + n2[1] * n2[1] + n2[2] * n2[2]);
+          n2[0] /= norm2, n2[1] /= norm2, n2[2] /= norm2;
+          Cross(n2, n1, n3);
+        }
 
+        //insert principal unit vectors into rotation matrix representing Feature reference frame within the sample reference frame
+        //(Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
+        float g[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+        for (int32_t n = 0; n < 3; n++)
+        {
+          g[0][n] = static_cast<float>(n3[n]);
+          g[1][n] = static_cast<float>(n2[n]);
+          g[2][n] = static_cast<float>(n1[n]);
+        }
+
+        //check for right-handedness
+        typedef  OrientationTransforms<FOrientArrayType, float> OrientationTransformType;
+        OrientationTransformType::ResultType result = FOrientTransformsType::om_check(FOrientArrayType(g));
+        if (result.result == 0)
+        {
+          g[2][0] *= -1.0f;
+          g[2][1] *= -1.0f;
+          g[2][2] *= -1.0f;
+        }
+
+        FOrientArrayType eu(3, 0.0f);
+        FOrientTransformsType::om2eu(FOrientArrayType(g), eu);
+
+        m_AxisEulerAngles[3 * i] = eu[0];
+        m_AxisEulerAngles[3 * i + 1] = eu[1];
+        m_AxisEulerAngles[3 * i + 2] = eu[2];
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    double* m_Moments;
+    double* m_EigenValues;
+    float* m_AxisEulerAngles;
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -239,7 +490,6 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   m_FeatureMoments->resize(numfeatures * 6);
   featuremoments = m_FeatureMoments->getPointer(0);
@@ -257,90 +507,32 @@ void FindShapes::find_moments()
   float modYRes = yRes * float(m_ScaleFactor);
   float modZRes = zRes * float(m_ScaleFactor);
 
+  // The moments are summed about the given centroids and rescaled to the modified resolution
+  size_t dims[3] = { xPoints, yPoints, zPoints };
+  float res[3] = { xRes, yRes, zRes };
+  FeatureStatisticsEngine engine(m_FeatureIds, dims, res, numfeatures);
+  engine.addAccumulators(FeatureStatisticsEngine::Moments);
+  engine.setReferenceCentroids(m_Centroids);
+  engine.execute();
+  double scale2 = static_cast<double>(m_ScaleFactor) * static_cast<double>(m_ScaleFactor);
+
+  // Each voxel used to be split into 8 sub-voxels offset by a quarter of the resolution
+  double hxx = static_cast<double>(modXRes / 4.0f) * static_cast<double>(modXRes / 4.0f);
+  double hyy = static_cast<double>(modYRes / 4.0f) * static_cast<double>(modYRes / 4.0f);
+  double hzz = static_cast<double>(modZRes / 4.0f) * static_cast<double>(modZRes / 4.0f);
   for (size_t i = 0; i < numfeatures; i++)
   {
-    featuremoments[6 * i + 0] = 0.0f;
-    featuremoments[6 * i + 1] = 0.0f;
-    featuremoments[6 * i + 2] = 0.0f;
-    featuremoments[6 * i + 3] = 0.0f;
-    featuremoments[6 * i + 4] = 0.0f;
-    featuremoments[6 * i + 5] = 0.0f;
+    const double* s = engine.getMoments(i);
+    double count = static_cast<double>(engine.getCount(i));
+    featuremoments[6 * i + 0] = 8.0 * (scale2 * (s[FeatureStatisticsEngine::YY] + s[FeatureStatisticsEngine::ZZ]) + count * (hyy + hzz));
+    featuremoments[6 * i + 1] = 8.0 * (scale2 * (s[FeatureStatisticsEngine::XX] + s[FeatureStatisticsEngine::ZZ]) + count * (hxx + hzz));
+    featuremoments[6 * i + 2] = 8.0 * (scale2 * (s[FeatureStatisticsEngine::XX] + s[FeatureStatisticsEngine::YY]) + count * (hxx + hyy));
+    featuremoments[6 * i + 3] = 8.0 * scale2 * s[FeatureStatisticsEngine::XY];
+    featuremoments[6 * i + 4] = 8.0 * scale2 * s[FeatureStatisticsEngine::YZ];
+    featuremoments[6 * i + 5] = 8.0 * scale2 * s[FeatureStatisticsEngine::XZ];
+    m_Volumes[i] = m_Volumes[i] + static_cast<float>(count);
   }
 
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for (size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for (size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for (size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        x = float(k * modXRes);
-        y = float(j * modYRes);
-        z = float(i * modZRes);
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist1 = (z1 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist2 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist2 = (z2 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist3 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist3 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist3 = (z1 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist4 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist4 = (z2 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist5 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist5 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist5 = (z1 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist6 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist6 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist6 = (z2 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist7 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist7 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist7 = (z1 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist8 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist8 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist8 = (z2 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3))
-             + ((ydist4) * (ydist4)) + ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6))
-             + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) + ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3))
-             + ((xdist4) * (xdist4)) + ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6))
-             + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) + ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3))
-             + ((xdist4) * (xdist4)) + ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6))
-             + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) + ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6))
-             + ((xdist7) * (ydist7)) + ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6))
-             + ((ydist7) * (zdist7)) + ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6))
-             + ((xdist7) * (zdist7)) + ((xdist8) * (zdist8));
-
-        featuremoments[gnum * 6 + 0] = featuremoments[gnum * 6 + 0] + xx;
-        featuremoments[gnum * 6 + 1] = featuremoments[gnum * 6 + 1] + yy;
-        featuremoments[gnum * 6 + 2] = featuremoments[gnum * 6 + 2] + zz;
-        featuremoments[gnum * 6 + 3] = featuremoments[gnum * 6 + 3] + xy;
-        featuremoments[gnum * 6 + 4] = featuremoments[gnum * 6 + 4] + yz;
-        featuremoments[gnum * 6 + 5] = featuremoments[gnum * 6 + 5] + xz;
-        m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-      }
-    }
-  }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
   double konst1 =  static_cast<double>((modXRes / 2.0) * (modYRes / 2.0) * (modZRes / 2.0));
@@ -382,7 +574,6 @@ void FindShapes::find_moments2D()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  float xx = 0.0f, yy = 0.0f, xy = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   m_FeatureMoments->resize(numfeatures * 6);
   featuremoments = m_FeatureMoments->getPointer(0);
@@ -415,44 +606,31 @@ void FindShapes::find_moments2D()
   float modXRes = xRes * m_ScaleFactor;
   float modYRes = yRes * m_ScaleFactor;
 
-  for (size_t i = 0; i < 6 * numfeatures; i++)
+  // The plane is passed to the engine as its own X and Y axes, matching the centroid components used below
+  size_t dims[3] = { xPoints, yPoints, 1 };
+  float res[3] = { xRes, yRes, 1.0f };
+  FeatureStatisticsEngine engine(m_FeatureIds, dims, res, numfeatures);
+  engine.addAccumulators(FeatureStatisticsEngine::Moments);
+  engine.setReferenceCentroids(m_Centroids);
+  engine.execute();
+  double scale2 = static_cast<double>(m_ScaleFactor) * static_cast<double>(m_ScaleFactor);
+
+  // Each pixel used to be split into 4 sub-pixels offset by a quarter of the resolution
+  double hxx = static_cast<double>(modXRes / 4.0f) * static_cast<double>(modXRes / 4.0f);
+  double hyy = static_cast<double>(modYRes / 4.0f) * static_cast<double>(modYRes / 4.0f);
+  for (size_t i = 0; i < numfeatures; i++)
   {
-    featuremoments[i] = 0.0;
+    const double* s = engine.getMoments(i);
+    double count = static_cast<double>(engine.getCount(i));
+    featuremoments[6 * i + 0] = 4.0 * (scale2 * s[FeatureStatisticsEngine::YY] + count * hyy);
+    featuremoments[6 * i + 1] = 4.0 * (scale2 * s[FeatureStatisticsEngine::XX] + count * hxx);
+    featuremoments[6 * i + 2] = 4.0 * scale2 * s[FeatureStatisticsEngine::XY];
+    featuremoments[6 * i + 3] = 0.0;
+    featuremoments[6 * i + 4] = 0.0;
+    featuremoments[6 * i + 5] = 0.0;
+    m_Volumes[i] = m_Volumes[i] + static_cast<float>(count);
   }
 
-  float x = 0.0f, y = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f;
-  size_t yStride = 0;
-  for (size_t j = 0; j < yPoints; j++)
-  {
-    yStride = j * xPoints;
-    for (size_t k = 0; k < xPoints; k++)
-    {
-      int32_t gnum = m_FeatureIds[yStride + k];
-      x = float(k) * modXRes;
-      y = float(j) * modYRes;
-      x1 = x + (modXRes / 4.0f);
-      x2 = x - (modXRes / 4.0f);
-      y1 = y + (modYRes / 4.0f);
-      y2 = y - (modYRes / 4.0f);
-      xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-      ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-      xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-      ydist2 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-      xdist3 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-      ydist3 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-      xdist4 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-      ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-      xx = ((ydist1) * (ydist1)) + ((ydist2) * (ydist2)) + ((ydist3) * (ydist3)) + ((ydist4) * (ydist4));
-      yy = ((xdist1) * (xdist1)) + ((xdist2) * (xdist2)) + ((xdist3) * (xdist3)) + ((xdist4) * (xdist4));
-      xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4));
-      featuremoments[gnum * 6 + 0] = featuremoments[gnum * 6 + 0] + xx;
-      featuremoments[gnum * 6 + 1] = featuremoments[gnum * 6 + 1] + yy;
-      featuremoments[gnum * 6 + 2] = featuremoments[gnum * 6 + 2] + xy;
-      m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-    }
-  }
   double konst1 = static_cast<double>((modXRes / 2.0) * (modYRes / 2.0));
   double konst2 = static_cast<double>(xRes * yRes);
   for (size_t i = 1; i < numfeatures; i++)
@@ -469,15 +647,6 @@ void FindShapes::find_moments2D()
 // -----------------------------------------------------------------------------
 void FindShapes::find_axes()
 {
-  double I1 = 0.0, I2 = 0.0, I3 = 0.0;
-  double Ixx = 0.0, Iyy = 0.0, Izz = 0.0, Ixy = 0.0, Ixz = 0.0, Iyz = 0.0;
-  double a = 0.0, b = 0.0, c = 0.0, d = 0.0, f = 0.0, g = 0.0, h = 0.0;
-  double rsquare = 0.0, r = 0.0, theta = 0.0;
-  double A = 0.0, B = 0.0, C = 0.0;
-  double r1 = 0.0, r2 = 0.0, r3 = 0.0;
-  float bovera = 0.0f, covera = 0.0f;
-  double value = 0.0;
-
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
   m_FeatureMoments->resize(numfeatures * 6);
@@ -486,72 +655,23 @@ void FindShapes::find_axes()
   m_FeatureEigenVals->resize(numfeatures * 3);
   featureeigenvals = m_FeatureEigenVals->getPointer(0);
 
-  for (size_t i = 1; i < numfeatures; i++)
+  if (numfeatures < 2) { return; }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  FindShapesAxesImpl impl(featuremoments, featureeigenvals, m_AxisLengths, m_AspectRatios, m_ScaleFactor);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
   {
-    Ixx = featuremoments[i * 6 + 0];
-    Iyy = featuremoments[i * 6 + 1];
-    Izz = featuremoments[i * 6 + 2];
-
-    Ixy = featuremoments[i * 6 + 3];
-    Iyz = featuremoments[i * 6 + 4];
-    Ixz = featuremoments[i * 6 + 5];
-
-    a = 1.0;
-    b = (-Ixx - Iyy - Izz);
-    c = ((Ixx * Izz) + (Ixx * Iyy) + (Iyy * Izz) - (Ixz * Ixz) - (Ixy * Ixy) - (Iyz * Iyz));
-    d = 0.0;
-    d = ((Ixz * Iyy * Ixz) + (Ixy * Izz * Ixy) + (Iyz * Ixx * Iyz) - (Ixx * Iyy * Izz) - (Ixy * Iyz * Ixz) - (Ixy * Iyz * Ixz));
-    // f and g are the p and q values when reducing the cubic equation to t^3 + pt + q = 0
-    f = ((3.0 * c / a) - ((b / a) * (b / a))) / 3.0;
-    g = ((2.0 * (b / a) * (b / a) * (b / a)) - (9.0 * b * c / (a * a)) + (27.0 * (d / a))) / 27.0;
-    h = (g * g / 4.0) + (f * f * f / 27.0);
-    rsquare = (g * g / 4.0) - h;
-    r = sqrt(rsquare);
-    if (rsquare < 0.0) { r = 0.0; }
-    theta = 0;
-    if (r == 0)
-    {
-      theta = 0;
-    }
-    if (r != 0)
-    {
-      value = -g / (2.0 * r);
-      if (value > 1) { value = 1.0; }
-      if (value < -1) { value = -1.0; }
-      theta = acos(value);
-    }
-    double const1 = pow(r, 0.33333333333);
-    double const2 = cos(theta / 3.0);
-    double const3 = b / (3.0 * a);
-    double const4 = 1.7320508 * sin(theta / 3.0);
-
-    r1 = 2 * const1 * const2 - (const3);
-    r2 = -const1 * (const2 - (const4)) - const3;
-    r3 = -const1 * (const2 + (const4)) - const3;
-    featureeigenvals[3 * i] = r1;
-    featureeigenvals[3 * i + 1] = r2;
-    featureeigenvals[3 * i + 2] = r3;
-
-    I1 = (15.0 * r1) / (4.0 * M_PI);
-    I2 = (15.0 * r2) / (4.0 * M_PI);
-    I3 = (15.0 * r3) / (4.0 * M_PI);
-    A = (I1 + I2 - I3) / 2.0f;
-    B = (I1 + I3 - I2) / 2.0f;
-    C = (I2 + I3 - I1) / 2.0f;
-    a = (A * A * A * A) / (B * C);
-    a = pow(a, 0.1);
-    b = B / A;
-    b = sqrt(b) * a;
-    c = A / (a * a * a * b);
-
-    m_AxisLengths[3 * i] = static_cast<float>(a / m_ScaleFactor);
-    m_AxisLengths[3 * i + 1] = static_cast<float>(b / m_ScaleFactor);
-    m_AxisLengths[3 * i + 2] = static_cast<float>(c / m_ScaleFactor);
-    bovera = static_cast<float>(b / a);
-    covera = static_cast<float>(c / a);
-    if (A == 0 || B == 0 || C == 0) { bovera = 0.0f, covera = 0.0f; }
-    m_AspectRatios[2 * i] = bovera;
-    m_AspectRatios[2 * i + 1] = covera;
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures, 256), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(1, numfeatures);
   }
 }
 
@@ -642,153 +762,23 @@ void FindShapes::find_axes2D()
 void FindShapes::find_axiseulers()
 {
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
-  for (size_t i = 1; i < numfeatures; i++)
-  {
-    double Ixx = featuremoments[i * 6 + 0];
-    double Iyy = featuremoments[i * 6 + 1];
-    double Izz = featuremoments[i * 6 + 2];
-    double Ixy = featuremoments[i * 6 + 3];
-    double Iyz = featuremoments[i * 6 + 4];
-    double Ixz = featuremoments[i * 6 + 5];
-    double radius1 = featureeigenvals[3 * i];
-    double radius2 = featureeigenvals[3 * i + 1];
-    double radius3 = featureeigenvals[3 * i + 2];
-
-    double e[3][1];
-    double vect[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
-    e[0][0] = radius1;
-    e[1][0] = radius2;
-    e[2][0] = radius3;
-    double uber[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
-    double bmat[3][1];
-    bmat[0][0] = 0.0000001;
-    bmat[1][0] = 0.0000001;
-    bmat[2][0] = 0.0000001;
-
-    for (int32_t j = 0; j < 3; j++)
-    {
-      uber[0][0] = Ixx - e[j][0];
-      uber[0][1] = Ixy;
-      uber[0][2] = Ixz;
-      uber[1][0] = Ixy;
-      uber[1][1] = Iyy - e[j][0];
-      uber[1][2] = Iyz;
-      uber[2][0] = Ixz;
-      uber[2][1] = Iyz;
-      uber[2][2] = Izz - e[j][0];
-      double** uberelim;
-      double** uberbelim;
-      uberelim = new double *[3];
-      uberbelim = new double *[3];
-      for (int32_t d = 0; d < 3; d++)
-      {
-        uberelim[d] = new double[3];
-        uberbelim[d] = new double[1];
-      }
-      int32_t elimcount = 0;
-      int32_t elimcount1 = 0;
-      double q = 0.0;
-      double sum = 0.0;
-      double c = 0.0;
-      for (int32_t a = 0; a < 3; a++)
-      {
-        elimcount1 = 0;
-        for (int32_t b = 0; b < 3; b++)
-        {
-          uberelim[elimcount][elimcount1] = uber[a][b];
-          elimcount1++;
-        }
-        uberbelim[elimcount][0] = bmat[a][0];
-        elimcount++;
-      }
-      for (int32_t k = 0; k < elimcount - 1; k++)
-      {
-        for (int32_t l = k + 1; l < elimcount; l++)
-        {
-          c = uberelim[l][k] / uberelim[k][k];
-          for (int32_t r = k + 1; r < elimcount; r++)
-          {
-            uberelim[l][r] = uberelim[l][r] - c * uberelim[k][r];
-          }
-          uberbelim[l][0] = uberbelim[l][0] - c * uberbelim[k][0];
-        }
-      }
-      uberbelim[elimcount - 1][0] = uberbelim[elimcount - 1][0] / uberelim[elimcount - 1][elimcount - 1];
-      for (int32_t l = 1; l < elimcount; l++)
-      {
-        int32_t r = (elimcount - 1) - l;
-        sum = 0.0;
-        for (int32_t n = r + 1; n < elimcount; n++)
-        {
-          sum = sum + (uberelim[r][n] * uberbelim[n][0]);
-        }
-        uberbelim[r][0] = (uberbelim[r][0] - sum) / uberelim[r][r];
-      }
-      for (int32_t p = 0; p < elimcount; p++)
-      {
-        q = uberbelim[p][0];
-        vect[j][p] = q;
-      }
-      for (int32_t d = 0; d < 3; d++)
-      {
-        delete uberelim[d];
-        delete uberbelim[d];
-      }
-      delete uberelim;
-      delete uberbelim;
-    }
+  if (numfeatures < 2) { return; }
 
-    double n1x = vect[0][0];
-    double n1y = vect[0][1];
-    double n1z = vect[0][2];
-    double n2x = vect[1][0];
-    double n2y = vect[1][1];
-    double n2z = vect[1][2];
-    double n3x = vect[2][0];
-    double n3y = vect[2][1];
-    double n3z = vect[2][2];
-    double norm1 = sqrt(((n1x * n1x) + (n1y * n1y) + (n1z * n1z)));
-    double norm2 = sqrt(((n2x * n2x) + (n2y * n2y) + (n2z * n2z)));
-    double norm3 = sqrt(((n3x * n3x) + (n3y * n3y) + (n3z * n3z)));
-    n1x = n1x / norm1;
-    n1y = n1y / norm1;
-    n1z = n1z / norm1;
-    n2x = n2x / norm2;
-    n2y = n2y / norm2;
-    n2z = n2z / norm2;
-    n3x = n3x / norm3;
-    n3y = n3y / norm3;
-    n3z = n3z / norm3;
-
-    //insert principal unit vectors into rotation matrix representing Feature reference frame within the sample reference frame
-    //(Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
-    float g[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-    g[0][0] = n3x;
-    g[0][1] = n3y;
-    g[0][2] = n3z;
-    g[1][0] = n2x;
-    g[1][1] = n2y;
-    g[1][2] = n2z;
-    g[2][0] = n1x;
-    g[2][1] = n1y;
-    g[2][2] = n1z;
-
-    //check for right-handedness
-    typedef  OrientationTransforms<FOrientArrayType, float> OrientationTransformType;
-    OrientationTransformType::ResultType result = FOrientTransformsType::om_check(FOrientArrayType(g));
-    if (result.result == 0)
-    {
-      g[2][0] *= -1.0f;
-      g[2][1] *= -1.0f;
-      g[2][2] *= -1.0f;
-    }
-
-    FOrientArrayType eu(3, 0.0f);
-    FOrientTransformsType::om2eu(FOrientArrayType(g), eu);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-    m_AxisEulerAngles[3 * i] = eu[0];
-    m_AxisEulerAngles[3 * i + 1] = eu[1];
-    m_AxisEulerAngles[3 * i + 2] = eu[2];
+  FindShapesAxisEulersImpl impl(featuremoments, featureeigenvals, m_AxisEulerAngles);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures, 256), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(1, numfeatures);
   }
 }
 
@@ -46,6 +46,8 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/FeatureStatisticsEngine.h"
+
 #include "Statistics/StatisticsConstants.h"
 
 // Include the MOC generated file for this class
@@ -192,24 +194,20 @@ void FindSizes::find_sizes()
   float diameter = 0.0f;
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<float>::Pointer m_FeatureCounts = DataArray<float>::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts");
-  m_FeatureCounts->initializeWithZeros();
-  float* featurecounts = m_FeatureCounts->getPointer(0);
-
-  for (size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
-  float res_scalar = m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getYRes() * m->getGeometryAs<ImageGeom>()->getZRes();
+  size_t dims[3] = { image->getXPoints(), image->getYPoints(), image->getZPoints() };
+  float res[3] = { image->getXRes(), image->getYRes(), image->getZRes() };
+  FeatureStatisticsEngine engine(m_FeatureIds, dims, res, numfeatures);
+  engine.addAccumulators(FeatureStatisticsEngine::Count);
+  engine.execute();
+  float res_scalar = engine.getCellVolume();
   float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_Pi;
   for (size_t i = 1; i < numfeatures; i++)
   {
-    m_NumCells[i] = static_cast<int32_t>( featurecounts[i] );
-    m_Volumes[i] = (featurecounts[i] * res_scalar);
+    m_NumCells[i] = engine.getCount(i);
+    m_Volumes[i] = (static_cast<float>(m_NumCells[i]) * res_scalar);
     radcubed = m_Volumes[i] / vol_term;
     diameter = 2.0f * powf(radcubed, 0.3333333333f);
     m_EquivalentDiameters[i] = diameter;
@@ -225,26 +223,19 @@ void FindSizes::find_sizes2D()
   float diameter = 0.0f;
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<float>::Pointer m_FeatureCounts = DataArray<float>::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts");
-  m_FeatureCounts->initializeWithZeros();
-  float* featurecounts = m_FeatureCounts->getPointer(0);
-
-  for (size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
-  float res_scalar = 0.0f;
-  if (m->getGeometryAs<ImageGeom>()->getXPoints() == 1) { res_scalar = m->getGeometryAs<ImageGeom>()->getYRes() * m->getGeometryAs<ImageGeom>()->getZRes(); }
-  else if (m->getGeometryAs<ImageGeom>()->getYPoints() == 1) { res_scalar = m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getZRes(); }
-  else if (m->getGeometryAs<ImageGeom>()->getZPoints() == 1) { res_scalar = m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getYRes(); }
+  size_t dims[3] = { image->getXPoints(), image->getYPoints(), image->getZPoints() };
+  float res[3] = { image->getXRes(), image->getYRes(), image->getZRes() };
+  FeatureStatisticsEngine engine(m_FeatureIds, dims, res, numfeatures);
+  engine.addAccumulators(FeatureStatisticsEngine::Count);
+  engine.execute();
+  float res_scalar = engine.getCellVolume();
   for (size_t i = 1; i < numfeatures; i++)
   {
-    m_NumCells[i] = static_cast<int32_t>( featurecounts[i] );
-    m_Volumes[i] = (featurecounts[i] * res_scalar);
+    m_NumCells[i] = engine.getCount(i);
+    m_Volumes[i] = (static_cast<float>(m_NumCells[i]) * res_scalar);
     radsquared = m_Volumes[i] / SIMPLib::Constants::k_Pi;
     diameter = (2 * sqrtf(radsquared));
     m_EquivalentDiameters[i] = diameter;
@@ -0,0 +1,220 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "StatisticsTestFileLocations.h"
+
+// Every sixth Feature owns no cells: its diameter is 0 and its centroid is NaN
+static const size_t k_NeighborhoodsNumFeatures = 41;
+
+class FindNeighborhoodsTest
+{
+  public:
+    FindNeighborhoodsTest(){}
+    virtual ~FindNeighborhoodsTest(){}
+    SIMPL_TYPE_MACRO(FindNeighborhoodsTest)
+
+    // -----------------------------------------------------------------------------
+    // The filter only reads the Feature data and the extent of the geometry, so the
+    // cells themselves are not needed
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestData()
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      size_t dims[3] = { 20, 15, 10 };
+      float res[3] = { 0.5f, 1.0f, 2.0f };
+      float origin[3] = { -4.0f, 3.0f, 1.0f };
+      image->setDimensions(dims[0], dims[1], dims[2]);
+      image->setResolution(res[0], res[1], res[2]);
+      image->setOrigin(origin[0], origin[1], origin[2]);
+      m->setGeometry(image);
+
+      AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(QVector<size_t>(1, k_NeighborhoodsNumFeatures), SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+      QVector<size_t> cDims(1, 1);
+      FloatArrayType::Pointer diameters = FloatArrayType::CreateArray(k_NeighborhoodsNumFeatures, cDims, SIMPL::FeatureData::EquivalentDiameters, true);
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(k_NeighborhoodsNumFeatures, cDims, SIMPL::FeatureData::Phases, true);
+      cDims[0] = 3;
+      FloatArrayType::Pointer centroids = FloatArrayType::CreateArray(k_NeighborhoodsNumFeatures, cDims, SIMPL::FeatureData::Centroids, true);
+      diameters->initializeWithZeros();
+      phases->initializeWithValue(1);
+      centroids->initializeWithZeros();
+
+      uint32_t seed = 4242;
+      for (size_t i = 1; i < k_NeighborhoodsNumFeatures; i++)
+      {
+        if (i % 6 == 0)
+        {
+          for (size_t d = 0; d < 3; d++) { centroids->setComponent(i, d, std::numeric_limits<float>::quiet_NaN()); }
+          continue;
+        }
+        for (size_t d = 0; d < 3; d++)
+        {
+          seed = seed * 1103515245u + 12345u;
+          centroids->setComponent(i, d, origin[d] + dims[d] * res[d] * static_cast<float>((seed >> 16) % 1001) / 1000.0f);
+        }
+        seed = seed * 1103515245u + 12345u;
+        diameters->setValue(i, 0.5f + static_cast<float>((seed >> 16) % 100) / 20.0f);
+      }
+      featureAttrMat->addAttributeArray(diameters->getName(), diameters);
+      featureAttrMat->addAttributeArray(phases->getName(), phases);
+      featureAttrMat->addAttributeArray(centroids->getName(), centroids);
+      m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Compares every pair of Features, the way the filter did before it bucketed the
+    // Features by bin. Features without a finite centroid are in no neighborhood.
+    // -----------------------------------------------------------------------------
+    std::vector<std::vector<int32_t> > FindNeighborhoodsBruteForce(DataContainerArray::Pointer dca, float multiplesOfAverage)
+    {
+      DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+      AttributeMatrix::Pointer featureAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      FloatArrayType::Pointer diameters = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::EquivalentDiameters));
+      FloatArrayType::Pointer centroids = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::Centroids));
+      float origin[3] = { 0.0f, 0.0f, 0.0f };
+      m->getGeometryAs<ImageGeom>()->getOrigin(origin);
+
+      float aveDiam = 0.0f;
+      for (size_t i = 1; i < k_NeighborhoodsNumFeatures; i++) { aveDiam += diameters->getValue(i); }
+      aveDiam /= k_NeighborhoodsNumFeatures;
+
+      std::vector<std::vector<int32_t> > neighborhoods(k_NeighborhoodsNumFeatures);
+      for (size_t i = 1; i < k_NeighborhoodsNumFeatures; i++)
+      {
+        if (std::isfinite(centroids->getComponent(i, 0)) == false) { continue; }
+        float criticalDistance = diameters->getValue(i) * multiplesOfAverage / aveDiam;
+        for (size_t j = 1; j < k_NeighborhoodsNumFeatures; j++)
+        {
+          if (j == i || std::isfinite(centroids->getComponent(j, 0)) == false) { continue; }
+          bool inside = true;
+          for (size_t d = 0; d < 3; d++)
+          {
+            int64_t bin1 = static_cast<int64_t>((centroids->getComponent(i, d) - origin[d]) / aveDiam);
+            int64_t bin2 = static_cast<int64_t>((centroids->getComponent(j, d) - origin[d]) / aveDiam);
+            if (static_cast<float>(llabs(bin2 - bin1)) >= criticalDistance) { inside = false; }
+          }
+          if (inside == true) { neighborhoods[i].push_back(static_cast<int32_t>(j)); }
+        }
+      }
+      return neighborhoods;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFindNeighborhoods()
+    {
+      float multiples[3] = { 0.5f, 1.0f, 2.5f };
+      for (size_t t = 0; t < 3; t++)
+      {
+        DataContainerArray::Pointer dca = CreateTestData();
+        std::vector<std::vector<int32_t> > expected = FindNeighborhoodsBruteForce(dca, multiples[t]);
+
+        FilterManager* fm = FilterManager::Instance();
+        IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("FindNeighborhoods");
+        DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+        AbstractFilter::Pointer filter = filterFactory->create();
+        filter->setDataContainerArray(dca);
+        QVariant var;
+        var.setValue(multiples[t]);
+        bool propWasSet = filter->setProperty("MultiplesOfAverage", var);
+        DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+        filter->execute();
+        DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+        AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+        Int32ArrayType::Pointer counts = std::dynamic_pointer_cast<Int32ArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::Neighborhoods));
+        NeighborList<int32_t>::Pointer lists = std::dynamic_pointer_cast<NeighborList<int32_t> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::NeighborhoodList));
+        DREAM3D_REQUIRE_VALID_POINTER(counts.get());
+        DREAM3D_REQUIRE_VALID_POINTER(lists.get());
+
+        size_t total = 0;
+        for (size_t i = 1; i < k_NeighborhoodsNumFeatures; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(counts->getValue(i)), expected[i].size())
+          std::vector<int32_t>& list = lists->getListReference(static_cast<int32_t>(i));
+          DREAM3D_REQUIRE_EQUAL(list.size(), expected[i].size())
+          for (size_t j = 0; j < expected[i].size(); j++)
+          {
+            DREAM3D_REQUIRE_EQUAL(list[j], expected[i][j])
+          }
+          if (i % 6 == 0) { DREAM3D_REQUIRE_EQUAL(list.empty(), true) }
+          total += expected[i].size();
+        }
+        // Make sure the fixture actually has neighborhoods to compare
+        DREAM3D_REQUIRED(total, >, 0)
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestFindNeighborhoods())
+    }
+
+  private:
+    FindNeighborhoodsTest(const FindNeighborhoodsTest&); // Copy Constructor Not Implemented
+    void operator=(const FindNeighborhoodsTest&); // Operator '=' Not Implemented
+};
@@ -0,0 +1,230 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "StatisticsTestFileLocations.h"
+
+// Feature 0 is the background and the last Feature owns no cells
+static const int32_t k_NeighborsNumFeatures = 11;
+
+class FindNeighborsTest
+{
+  public:
+    FindNeighborsTest(){}
+    virtual ~FindNeighborsTest(){}
+    SIMPL_TYPE_MACRO(FindNeighborsTest)
+
+    // -----------------------------------------------------------------------------
+    // Blocks of Features 1 to 9 with scattered background cells and scattered cells
+    // of other Features
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestVolume(const size_t dims[3])
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(dims[0], dims[1], dims[2]);
+      image->setResolution(0.5f, 1.5f, 2.0f);
+      image->setOrigin(0.0f, 0.0f, 0.0f);
+      m->setGeometry(image);
+
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = dims[0];
+      tDims[1] = dims[1];
+      tDims[2] = dims[2];
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::FeatureIds, true);
+      uint32_t seed = 1234;
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            size_t index = (z * dims[1] + y) * dims[0] + x;
+            seed = seed * 1103515245u + 12345u;
+            int32_t feature = 1 + static_cast<int32_t>((x / 3 + 3 * (y / 3) + 2 * (z / 2)) % 9);
+            if ((seed >> 16) % 9 == 0) { feature = 0; }
+            else if ((seed >> 16) % 13 == 0) { feature = 1 + static_cast<int32_t>((seed >> 8) % 9); }
+            featureIds->setValue(index, feature);
+          }
+        }
+      }
+      am->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+      m->addAttributeMatrix(am->getName(), am);
+
+      AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(QVector<size_t>(1, k_NeighborsNumFeatures), SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+      m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFindNeighbors()
+    {
+      size_t dims[3] = { 11, 8, 5 };
+      DataContainerArray::Pointer dca = CreateTestVolume(dims);
+      DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+      Int32ArrayType::Pointer featureIds = std::dynamic_pointer_cast<Int32ArrayType>(m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArray(SIMPL::CellData::FeatureIds));
+
+      // Count the faces between every ordered pair of distinct positive Features, the
+      // faces of each cell that touch another Feature and the Features on the volume border
+      std::vector<std::map<int32_t, int32_t> > faceCounts(k_NeighborsNumFeatures);
+      std::vector<int8_t> boundaryCells(featureIds->getNumberOfTuples(), 0);
+      std::vector<bool> surfaceFeatures(k_NeighborsNumFeatures, false);
+      int64_t offsets[3] = { 1, static_cast<int64_t>(dims[0]), static_cast<int64_t>(dims[0] * dims[1]) };
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            int64_t index = static_cast<int64_t>((z * dims[1] + y) * dims[0] + x);
+            int32_t feature = featureIds->getValue(index);
+            if (feature <= 0) { continue; }
+            size_t coords[3] = { x, y, z };
+            for (size_t d = 0; d < 3; d++)
+            {
+              if (coords[d] == 0 || coords[d] == dims[d] - 1) { surfaceFeatures[feature] = true; }
+              for (int32_t dir = -1; dir <= 1; dir += 2)
+              {
+                if ((dir < 0 && coords[d] == 0) || (dir > 0 && coords[d] == dims[d] - 1)) { continue; }
+                int32_t neighbor = featureIds->getValue(index + dir * offsets[d]);
+                if (neighbor > 0 && neighbor != feature)
+                {
+                  faceCounts[feature][neighbor]++;
+                  boundaryCells[index]++;
+                }
+              }
+            }
+          }
+        }
+      }
+
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("FindNeighbors");
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+      QVariant var;
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+      bool propWasSet = filter->setProperty("CellFeatureAttributeMatrixPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(true);
+      propWasSet = filter->setProperty("StoreBoundaryCells", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("StoreSurfaceFeatures", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      AttributeMatrix::Pointer featureAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      Int32ArrayType::Pointer numNeighbors = std::dynamic_pointer_cast<Int32ArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::NumNeighbors));
+      BoolArrayType::Pointer surfaceFeaturesPtr = std::dynamic_pointer_cast<BoolArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::SurfaceFeatures));
+      NeighborList<int32_t>::Pointer neighborList = std::dynamic_pointer_cast<NeighborList<int32_t> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::NeighborList));
+      NeighborList<float>::Pointer areaList = std::dynamic_pointer_cast<NeighborList<float> >(featureAttrMat->getAttributeArray(SIMPL::FeatureData::SharedSurfaceAreaList));
+      Int8ArrayType::Pointer boundaryCellsPtr = std::dynamic_pointer_cast<Int8ArrayType>(m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArray(SIMPL::CellData::BoundaryCells));
+      DREAM3D_REQUIRE_VALID_POINTER(numNeighbors.get());
+      DREAM3D_REQUIRE_VALID_POINTER(surfaceFeaturesPtr.get());
+      DREAM3D_REQUIRE_VALID_POINTER(neighborList.get());
+      DREAM3D_REQUIRE_VALID_POINTER(areaList.get());
+      DREAM3D_REQUIRE_VALID_POINTER(boundaryCellsPtr.get());
+
+      // Every face has the area of an XY face, whatever its orientation
+      float faceArea = 0.5f * 1.5f;
+      for (int32_t i = 1; i < k_NeighborsNumFeatures; i++)
+      {
+        std::vector<int32_t>& neighbors = neighborList->getListReference(i);
+        std::vector<float>& areas = areaList->getListReference(i);
+        DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(numNeighbors->getValue(i)), faceCounts[i].size())
+        DREAM3D_REQUIRE_EQUAL(neighbors.size(), faceCounts[i].size())
+        DREAM3D_REQUIRE_EQUAL(areas.size(), faceCounts[i].size())
+        DREAM3D_REQUIRE_EQUAL(surfaceFeaturesPtr->getValue(i), surfaceFeatures[i])
+        size_t n = 0;
+        for (std::map<int32_t, int32_t>::iterator iter = faceCounts[i].begin(); iter != faceCounts[i].end(); ++iter, ++n)
+        {
+          DREAM3D_REQUIRE_EQUAL(neighbors[n], iter->first)
+          DREAM3D_REQUIRE_EQUAL(areas[n], float(iter->second) * faceArea)
+        }
+      }
+      // The Feature without cells has no neighbors and is nobody's neighbor
+      DREAM3D_REQUIRE_EQUAL(numNeighbors->getValue(k_NeighborsNumFeatures - 1), 0)
+      DREAM3D_REQUIRE_EQUAL(surfaceFeaturesPtr->getValue(k_NeighborsNumFeatures - 1), false)
+
+      for (size_t i = 0; i < boundaryCells.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(boundaryCellsPtr->getValue(i), boundaryCells[i])
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestFindNeighbors())
+    }
+
+  private:
+    FindNeighborsTest(const FindNeighborsTest&); // Copy Constructor Not Implemented
+    void operator=(const FindNeighborsTest&); // Operator '=' Not Implemented
+};
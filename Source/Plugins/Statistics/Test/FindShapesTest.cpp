@@ -0,0 +1,248 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "StatisticsTestFileLocations.h"
+
+static const float k_ShapesResolution = 0.5f;
+
+class FindShapesTest
+{
+  public:
+    FindShapesTest(){}
+    virtual ~FindShapesTest(){}
+    SIMPL_TYPE_MACRO(FindShapesTest)
+
+    // -----------------------------------------------------------------------------
+    // Feature 1 is a 12 x 6 x 3 box of cells. Feature 2 is a voxelized ellipsoid with
+    // semi-axes of 4, 12 and 7 cells along X, Y and Z. The centroids are the mean cell
+    // coordinates, as FindFeatureCentroids computes them.
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestVolume()
+    {
+      size_t dims[3] = { 40, 30, 24 };
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(dims[0], dims[1], dims[2]);
+      image->setResolution(k_ShapesResolution, k_ShapesResolution, k_ShapesResolution);
+      image->setOrigin(0.0f, 0.0f, 0.0f);
+      m->setGeometry(image);
+
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = dims[0];
+      tDims[1] = dims[1];
+      tDims[2] = dims[2];
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::FeatureIds, true);
+
+      double sums[3][4] = { { 0.0, 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0, 0.0 } };
+      for (size_t z = 0; z < dims[2]; z++)
+      {
+        for (size_t y = 0; y < dims[1]; y++)
+        {
+          for (size_t x = 0; x < dims[0]; x++)
+          {
+            int32_t feature = 0;
+            if (x >= 2 && x < 14 && y >= 2 && y < 8 && z >= 2 && z < 5) { feature = 1; }
+            double ex = (static_cast<double>(x) - 27.0) / 4.0;
+            double ey = (static_cast<double>(y) - 15.0) / 12.0;
+            double ez = (static_cast<double>(z) - 12.0) / 7.0;
+            if (ex * ex + ey * ey + ez * ez <= 1.0) { feature = 2; }
+            featureIds->setValue((z * dims[1] + y) * dims[0] + x, feature);
+            sums[feature][0] += x * k_ShapesResolution;
+            sums[feature][1] += y * k_ShapesResolution;
+            sums[feature][2] += z * k_ShapesResolution;
+            sums[feature][3] += 1.0;
+          }
+        }
+      }
+      am->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+      m->addAttributeMatrix(am->getName(), am);
+
+      AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(QVector<size_t>(1, 3), SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+      cDims[0] = 3;
+      FloatArrayType::Pointer centroids = FloatArrayType::CreateArray(QVector<size_t>(1, 3), cDims, SIMPL::FeatureData::Centroids, true);
+      for (size_t i = 0; i < 3; i++)
+      {
+        for (size_t d = 0; d < 3; d++)
+        {
+          centroids->setComponent(i, d, static_cast<float>(sums[i][d] / sums[i][3]));
+        }
+      }
+      featureAttrMat->addAttributeArray(SIMPL::FeatureData::Centroids, centroids);
+      m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+      dca->addDataContainer(m);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Checks that the rows of the Bunge orientation matrix of the axis Euler angles
+    // are the long, middle and short axes, with their signs
+    // -----------------------------------------------------------------------------
+    void CheckAxisEulerAngles(const float* eulers, const float axes[3][3])
+    {
+      float c1 = std::cos(eulers[0]), s1 = std::sin(eulers[0]);
+      float c = std::cos(eulers[1]), s = std::sin(eulers[1]);
+      float c2 = std::cos(eulers[2]), s2 = std::sin(eulers[2]);
+      float g[3][3] =
+      {
+        { c1 * c2 - s1 * s2 * c, s1 * c2 + c1 * s2 * c, s2 * s },
+        { -c1 * s2 - s1 * c2 * c, -s1 * s2 + c1 * c2 * c, c2 * s },
+        { s1 * s, -c1 * s, c }
+      };
+      for (int32_t i = 0; i < 3; i++)
+      {
+        for (int32_t j = 0; j < 3; j++)
+        {
+          DREAM3D_REQUIRE(std::fabs(g[i][j] - axes[i][j]) < 1.0E-3f)
+        }
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFindShapes()
+    {
+      DataContainerArray::Pointer dca = CreateTestVolume();
+
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("FindShapes");
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+      QVariant var;
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+      bool propWasSet = filter->setProperty("CellFeatureAttributeMatrixName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+      propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids));
+      propWasSet = filter->setProperty("CentroidsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      FloatArrayType::Pointer volumes = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::Volumes));
+      FloatArrayType::Pointer omega3s = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::Omega3s));
+      FloatArrayType::Pointer axisLengths = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::AxisLengths));
+      FloatArrayType::Pointer aspectRatios = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::AspectRatios));
+      FloatArrayType::Pointer axisEulerAngles = std::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(SIMPL::FeatureData::AxisEulerAngles));
+      DREAM3D_REQUIRE_VALID_POINTER(volumes.get());
+      DREAM3D_REQUIRE_VALID_POINTER(omega3s.get());
+      DREAM3D_REQUIRE_VALID_POINTER(axisLengths.get());
+      DREAM3D_REQUIRE_VALID_POINTER(aspectRatios.get());
+      DREAM3D_REQUIRE_VALID_POINTER(axisEulerAngles.get());
+
+      // The box: every cell is split into 2 x 2 x 2 sub-cells, so the mean square offset along an
+      // axis with N cells is res^2 * ((N^2 - 1) / 12 + 1 / 16). An ellipsoid with semi-axes a, b, c
+      // has the second moment V a^2 / 5 along a, and Omega3 is V^5 over the determinant of the
+      // second moment tensor, normalized by 2000 pi^2 / 9.
+      double res = static_cast<double>(k_ShapesResolution);
+      double cells[3] = { 12.0, 6.0, 3.0 };
+      double meanSquares[3] = { 0.0, 0.0, 0.0 };
+      for (int32_t d = 0; d < 3; d++)
+      {
+        meanSquares[d] = res * res * ((cells[d] * cells[d] - 1.0) / 12.0 + 1.0 / 16.0);
+      }
+      double volume = cells[0] * cells[1] * cells[2] * res * res * res;
+      double k = 15.0 * volume / (4.0 * M_PI);
+      double a = pow(k * k * pow(meanSquares[0], 4.0) / (meanSquares[1] * meanSquares[2]), 0.1);
+      double b = a * sqrt(meanSquares[1] / meanSquares[0]);
+      double c = a * sqrt(meanSquares[2] / meanSquares[0]);
+      double omega3 = volume * volume / (meanSquares[0] * meanSquares[1] * meanSquares[2]) / (2000.0 * M_PI * M_PI / 9.0);
+      DREAM3D_REQUIRE(std::fabs(volumes->getValue(1) - volume) < 1.0E-3 * volume)
+      DREAM3D_REQUIRE(std::fabs(axisLengths->getComponent(1, 0) - a) < 1.0E-3 * a)
+      DREAM3D_REQUIRE(std::fabs(axisLengths->getComponent(1, 1) - b) < 1.0E-3 * b)
+      DREAM3D_REQUIRE(std::fabs(axisLengths->getComponent(1, 2) - c) < 1.0E-3 * c)
+      DREAM3D_REQUIRE(std::fabs(aspectRatios->getComponent(1, 0) - b / a) < 1.0E-3)
+      DREAM3D_REQUIRE(std::fabs(aspectRatios->getComponent(1, 1) - c / a) < 1.0E-3)
+      DREAM3D_REQUIRE(std::fabs(omega3s->getValue(1) - omega3) < 1.0E-3)
+
+      // The voxelized ellipsoid only approximates the semi-axes 6, 3.5 and 2 and an Omega3 of 1
+      DREAM3D_REQUIRE(std::fabs(axisLengths->getComponent(2, 0) - 6.0f) < 0.03f * 6.0f)
+      DREAM3D_REQUIRE(std::fabs(axisLengths->getComponent(2, 1) - 3.5f) < 0.03f * 3.5f)
+      DREAM3D_REQUIRE(std::fabs(axisLengths->getComponent(2, 2) - 2.0f) < 0.03f * 2.0f)
+      DREAM3D_REQUIRE(std::fabs(aspectRatios->getComponent(2, 0) - 3.5f / 6.0f) < 0.02f)
+      DREAM3D_REQUIRE(std::fabs(aspectRatios->getComponent(2, 1) - 2.0f / 6.0f) < 0.02f)
+      DREAM3D_REQUIRE(omega3s->getValue(2) > 0.95f)
+      DREAM3D_REQUIRE(omega3s->getValue(2) <= 1.0f)
+
+      // Each axis is signed so that its largest component is positive and the frame is right handed
+      float boxAxes[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+      CheckAxisEulerAngles(axisEulerAngles->getPointer(3), boxAxes);
+      float ellipsoidAxes[3][3] = { { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f } };
+      CheckAxisEulerAngles(axisEulerAngles->getPointer(6), ellipsoidAxes);
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestFindShapes() )
+    }
+
+  private:
+    FindShapesTest(const FindShapesTest&); // Copy Constructor Not Implemented
+    void operator=(const FindShapesTest&); // Operator '=' Not Implemented
+};
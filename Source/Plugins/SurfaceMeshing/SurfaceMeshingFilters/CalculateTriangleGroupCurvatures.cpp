@@ -47,13 +47,11 @@
 
 #include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring,
-    std::vector<int64_t> triangleIds,
     bool useNormalsForCurveFitting,
     DoubleArrayType::Pointer principleCurvature1,
     DoubleArrayType::Pointer principleCurvature2,
@@ -67,7 +65,6 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
     DataArray<double>::Pointer surfaceMeshTriangleCentroids,
     AbstractFilter* parent) :
   m_NRing(nring),
-  m_TriangleIds(triangleIds),
   m_UseNormalsForCurveFitting(useNormalsForCurveFitting),
   m_PrincipleCurvature1(principleCurvature1),
   m_PrincipleCurvature2(principleCurvature2),
@@ -93,12 +90,11 @@ CalculateTriangleGroupCurvatures::~CalculateTriangleGroupCurvatures()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void subtractVector3d(DataArray<double>::Pointer data, double* v)
+void subtractVector3d(double* data, size_t count, double* v)
 {
-  size_t count = data->getNumberOfTuples();
   for (size_t i = 0; i < count; ++i)
   {
-    double* ptr = data->getPointer(i * 3);
+    double* ptr = data + i * 3;
     ptr[0] = ptr[0] - v[0];
     ptr[1] = ptr[1] - v[1];
     ptr[2] = ptr[2] - v[2];
@@ -108,21 +104,29 @@ void subtractVector3d(DataArray<double>::Pointer data, double* v)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void CalculateTriangleGroupCurvatures::operator()() const
+void CalculateTriangleGroupCurvatures::compute(const int64_t* triangleIds, size_t count, Workspace& workspace) const
 {
   int32_t err = 0;
 
-  if (m_TriangleIds.size() == 0)
+  if (count == 0)
   {
     return;
   }
 
-  // Instantiate a FindNRingNeighbors class to use during the loop
-  FindNRingNeighbors::Pointer nRingNeighborAlg = FindNRingNeighbors::New();
+  // The N ring finder of this thread is reused for every triangle
+  if (NULL == workspace.nRingNeighborAlg.get())
+  {
+    workspace.nRingNeighborAlg = FindNRingNeighbors::New();
+  }
+  FindNRingNeighbors* nRingNeighborAlg = workspace.nRingNeighborAlg.get();
 
+  int64_t* triangles = m_TrianglesPtr->getTriPointer(0);
+  ElementDynamicList* node2Triangle = m_TrianglesPtr->getElementsContainingVert().get();
   int32_t* faceLabels = m_SurfaceMeshFaceLabels->getPointer(0);
+  double* centroids = m_SurfaceMeshTriangleCentroids->getPointer(0);
+  double* normals = m_SurfaceMeshFaceNormals->getPointer(0);
 
-  int32_t* fl = faceLabels + m_TriangleIds[0] * 2;
+  const int32_t* fl = faceLabels + triangleIds[0] * 2;
   int32_t feature0 = 0;
   int32_t feature1 = 0;
   if (fl[0] < fl[1])
@@ -140,33 +144,35 @@ void CalculateTriangleGroupCurvatures::operator()() const
   bool computeMean = (m_MeanCurvature.get() != NULL);
   bool computeDirection = (m_PrincipleDirection1.get() != NULL);
 
-  std::vector<int64_t>::size_type tCount = m_TriangleIds.size();
   // For each triangle in the group
-  for(std::vector<int64_t>::size_type i = 0; i < tCount; ++i)
+  for(size_t i = 0; i < count; ++i)
   {
     if (m_ParentFilter->getCancel() == true) { return; }
-    int64_t triId = m_TriangleIds[i];
+    int64_t triId = triangleIds[i];
     nRingNeighborAlg->setTriangleId(triId);
     nRingNeighborAlg->setRegionId0(feature0);
     nRingNeighborAlg->setRegionId1(feature1);
     nRingNeighborAlg->setRing(m_NRing);
-    err = nRingNeighborAlg->generate(m_TrianglesPtr, faceLabels);
+    err = nRingNeighborAlg->generate(triangles, node2Triangle, faceLabels);
     Q_ASSERT(err >= 0);
 
-    UniqueFaceIds_t triPatch = nRingNeighborAlg->getNRingTriangles();
+    const FindNRingNeighbors::UniqueFaceIds_t& triPatch = nRingNeighborAlg->getNRingTriangles();
     Q_ASSERT(triPatch.size() > 1);
 
-    DataArray<double>::Pointer patchCentroids = extractPatchData(triId, triPatch, m_SurfaceMeshTriangleCentroids->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Centroids"));
-    DataArray<double>::Pointer patchNormals = extractPatchData(triId, triPatch, m_SurfaceMeshFaceNormals->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Normals"));
+    extractPatchData(triId, triPatch, centroids, workspace.patchCentroids);
+    extractPatchData(triId, triPatch, normals, workspace.patchNormals);
+    double* patchCentroids = &(workspace.patchCentroids.front());
+    double* patchNormals = &(workspace.patchNormals.front());
+    size_t patchSize = triPatch.size();
 
     // Translate the patch to the 0,0,0 origin
-    double sub[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    subtractVector3d(patchCentroids, sub);
+    double sub[3] = { patchCentroids[0], patchCentroids[1], patchCentroids[2] };
+    subtractVector3d(patchCentroids, patchSize, sub);
 
-    double np[3] = {patchNormals->getComponent(0, 0), patchNormals->getComponent(0, 1), patchNormals->getComponent(0, 2) };
+    double np[3] = { patchNormals[0], patchNormals[1], patchNormals[2] };
 
-    double seedCentroid[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2) };
-    double firstCentroid[3] = {patchCentroids->getComponent(1, 0), patchCentroids->getComponent(1, 1), patchCentroids->getComponent(1, 2) };
+    double seedCentroid[3] = { patchCentroids[0], patchCentroids[1], patchCentroids[2] };
+    double firstCentroid[3] = { patchCentroids[3], patchCentroids[4], patchCentroids[5] };
 
     double temp[3] = {firstCentroid[0] - seedCentroid[0], firstCentroid[1] - seedCentroid[1], firstCentroid[2] - seedCentroid[2]};
     double vp[3] = {0.0, 0.0, 0.0};
@@ -187,15 +193,15 @@ void CalculateTriangleGroupCurvatures::operator()() const
     };
     double out[3] = { 0.0, 0.0, 0.0 };
     // Transform all centroids and normals to new coordinate system
-    for (size_t m = 0; m < patchCentroids->getNumberOfTuples(); ++m)
+    for (size_t m = 0; m < patchSize; ++m)
     {
-      ::memcpy(out, patchCentroids->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchCentroids->getPointer(m * 3), out);
-      ::memcpy(patchCentroids->getPointer(m * 3), out, 3 * sizeof(double));
+      ::memcpy(out, patchCentroids + m * 3, 3 * sizeof(double));
+      MatrixMath::Multiply3x3with3x1(rot, patchCentroids + m * 3, out);
+      ::memcpy(patchCentroids + m * 3, out, 3 * sizeof(double));
 
-      ::memcpy(out, patchNormals->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchNormals->getPointer(m * 3), out);
-      ::memcpy(patchNormals->getPointer(m * 3), out, 3 * sizeof(double));
+      ::memcpy(out, patchNormals + m * 3, 3 * sizeof(double));
+      MatrixMath::Multiply3x3with3x1(rot, patchNormals + m * 3, out);
+      ::memcpy(patchNormals + m * 3, out, 3 * sizeof(double));
 
       // We rotate the normals now but we dont use them yet. If we start using part 3 of Goldfeathers paper then we
       // will need the normals.
@@ -207,15 +213,15 @@ void CalculateTriangleGroupCurvatures::operator()() const
       static const uint32_t USE_NORMALS = 7;
       uint32_t cols = NO_NORMALS;
       if (m_UseNormalsForCurveFitting == true) { cols = USE_NORMALS; }
-      size_t rows = patchCentroids->getNumberOfTuples();
+      size_t rows = patchSize;
       Eigen::MatrixXd A(rows, cols);
       Eigen::VectorXd b(rows);
       double x = 0.0, y = 0.0, z = 0.0;
       for (size_t m = 0; m < rows; ++m)
       {
-        x = patchCentroids->getComponent(m, 0);
-        y = patchCentroids->getComponent(m, 1);
-        z = patchCentroids->getComponent(m, 2);
+        x = patchCentroids[m * 3];
+        y = patchCentroids[m * 3 + 1];
+        z = patchCentroids[m * 3 + 2];
 
         A(m) = 0.5 * x * x;  // 1/2 x^2
         A(m + rows) = x * y; // x*y
@@ -292,31 +298,27 @@ void CalculateTriangleGroupCurvatures::operator()() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId,
-    UniqueFaceIds_t& triPatch,
-    double* data,
-    const QString& name) const
+void CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId,
+    const FindNRingNeighbors::UniqueFaceIds_t& triPatch,
+    const double* data,
+    std::vector<double>& patchData) const
 {
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer extractedData = DataArray<double>::CreateArray(triPatch.size(), cDims, name);
+  patchData.resize(triPatch.size() * 3);
   // This little chunk makes sure the current seed triangles centroid and normal data appear
   // first in the returned arrays which makes the next steps a tad easier.
-  int32_t i = 0;
-  extractedData->setComponent(i, 0, data[triId * 3]);
-  extractedData->setComponent(i, 1, data[triId * 3 + 1]);
-  extractedData->setComponent(i, 2, data[triId * 3 + 2]);
+  size_t i = 0;
+  patchData[0] = data[triId * 3];
+  patchData[1] = data[triId * 3 + 1];
+  patchData[2] = data[triId * 3 + 2];
   ++i;
-  triPatch.erase(triId);
 
-  for (UniqueFaceIds_t::iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
+  for (FindNRingNeighbors::UniqueFaceIds_t::const_iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
   {
     int64_t t = *iter;
-    extractedData->setComponent(i, 0, data[t * 3]);
-    extractedData->setComponent(i, 1, data[t * 3 + 1]);
-    extractedData->setComponent(i, 2, data[t * 3 + 2]);
+    if (t == triId) { continue; }
+    patchData[i * 3] = data[t * 3];
+    patchData[i * 3 + 1] = data[t * 3 + 1];
+    patchData[i * 3 + 2] = data[t * 3 + 2];
     ++i;
   }
-  triPatch.insert(triId);
-
-  return extractedData;
 }
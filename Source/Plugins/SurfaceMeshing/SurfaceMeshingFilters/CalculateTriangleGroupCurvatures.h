@@ -37,22 +37,27 @@
 #ifndef _calculatetrianglegroupcurvatures_h_
 #define _calculatetrianglegroupcurvatures_h_
 
-#include <set>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Common/AbstractFilter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
+
 /**
- * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for a group of triangles
- * where each triangle in the group will have the 2 Principal Curvature values computed and optionally
- * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed.
+ * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for groups of triangles
+ * where each triangle in a group will have the 2 Principal Curvature values computed and optionally
+ * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed. A single
+ * instance is shared by all the threads; each thread passes its own Workspace so that the N ring
+ * and patch buffers are reused from one triangle to the next.
  */
 class CalculateTriangleGroupCurvatures
 {
   public:
     CalculateTriangleGroupCurvatures(int64_t nring,
-                                     std::vector<int64_t> triangleIds, bool useNormalsForCurveFitting,
+                                     bool useNormalsForCurveFitting,
                                      DoubleArrayType::Pointer principleCurvature1,
                                      DoubleArrayType::Pointer principleCurvature2,
                                      DoubleArrayType::Pointer principleDirection1,
@@ -67,9 +72,28 @@ class CalculateTriangleGroupCurvatures
 
     virtual ~CalculateTriangleGroupCurvatures();
 
-    void operator()() const;
+    /**
+     * @brief The Workspace class holds the per thread buffers. The N ring finder is
+     * created on first use so that copies of an empty Workspace do not share one.
+     */
+    class Workspace
+    {
+      public:
+        Workspace() {}
+
+        FindNRingNeighbors::Pointer nRingNeighborAlg;
+        std::vector<double> patchCentroids;
+        std::vector<double> patchNormals;
+    };
 
-    typedef std::set<int64_t> UniqueFaceIds_t;
+    /**
+     * @brief compute Computes the curvatures of a list of triangles that all belong to
+     * the same Feature face
+     * @param triangleIds The triangles
+     * @param count The number of triangles
+     * @param workspace The buffers of the calling thread
+     */
+    void compute(const int64_t* triangleIds, size_t count, Workspace& workspace) const;
 
   protected:
     CalculateTriangleGroupCurvatures();
@@ -79,16 +103,13 @@ class CalculateTriangleGroupCurvatures
      * @param triId The seed triangle Id
      * @param triPatch The group of triangles being used
      * @param data The data to extract from
-     * @param name The name of the data array being used
-     * @return Shared pointer to the extracted data
+     * @param patchData The extracted data; the seed triangle comes first
      */
-    DataArray<double>::Pointer extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch,
-                                                double* data,
-                                                const QString& name) const;
+    void extractPatchData(int64_t triId, const FindNRingNeighbors::UniqueFaceIds_t& triPatch,
+                          const double* data, std::vector<double>& patchData) const;
 
   private:
     int64_t m_NRing;
-    std::vector<int64_t> m_TriangleIds;
     bool m_UseNormalsForCurveFitting;
     DoubleArrayType::Pointer m_PrincipleCurvature1;
     DoubleArrayType::Pointer m_PrincipleCurvature2;
@@ -101,6 +122,9 @@ class CalculateTriangleGroupCurvatures
     DataArray<double>::Pointer m_SurfaceMeshFaceNormals;
     DataArray<double>::Pointer m_SurfaceMeshTriangleCentroids;
     AbstractFilter* m_ParentFilter;
+
+    CalculateTriangleGroupCurvatures(const CalculateTriangleGroupCurvatures&); // Copy Constructor Not Implemented
+    void operator=(const CalculateTriangleGroupCurvatures&); // Operator '=' Not Implemented
 };
 
 #endif /* _CalculateTriangleGroupCurvatures_H_ */
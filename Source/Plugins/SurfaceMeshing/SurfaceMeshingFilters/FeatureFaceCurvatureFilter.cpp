@@ -34,10 +34,15 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FeatureFaceCurvatureFilter.h"
 
+#include <algorithm>
+#include <functional>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
-#include <tbb/task_group.h>
-#include <tbb/task.h>
+#include <tbb/enumerable_thread_specific.h>
 #endif
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -52,6 +57,7 @@
 #include "SIMPLib/SIMPLibVersion.h"
 
 #include "CalculateTriangleGroupCurvatures.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/FeatureFaceGrouping.h"
 
 // Include the MOC generated file for this class
 #include "moc_FeatureFaceCurvatureFilter.cpp"
@@ -318,6 +324,126 @@ void FeatureFaceCurvatureFilter::preflight()
   setInPreflight(false);
 }
 
+/**
+ * @brief The CurvatureChunkSegment struct is a run of triangles of a single Feature
+ * face, given as a range of the Feature face to triangle index
+ */
+struct CurvatureChunkSegment
+{
+  size_t start;
+  size_t count;
+};
+
+/**
+ * @brief BuildCurvatureChunks Cuts the Feature faces into chunks of about grain
+ * triangles. Faces are visited from the largest to the smallest; a face larger
+ * than the grain is split over several chunks and small faces are batched into
+ * shared chunks, so both a few huge faces and millions of tiny ones end up as a
+ * moderate number of similar sized tasks.
+ * @param faceTriangles The Feature face to triangle index
+ * @param grain The target number of triangles per chunk
+ * @param segments Output segments of all chunks
+ * @param chunkOffsets Output first segment of each chunk, with one extra entry at the end
+ */
+static void BuildCurvatureChunks(const FlatNeighborList<int64_t>& faceTriangles, size_t grain,
+                                 std::vector<CurvatureChunkSegment>& segments, std::vector<size_t>& chunkOffsets)
+{
+  size_t numFaces = faceTriangles.getNumberOfFeatures();
+  std::vector<std::pair<size_t, size_t> > faces;
+  faces.reserve(numFaces);
+  for (size_t f = 0; f < numFaces; f++)
+  {
+    if (faceTriangles.getListSize(f) > 0) { faces.push_back(std::make_pair(faceTriangles.getListSize(f), f)); }
+  }
+  std::sort(faces.begin(), faces.end(), std::greater<std::pair<size_t, size_t> >());
+
+  segments.clear();
+  chunkOffsets.assign(1, 0);
+  size_t openChunkSize = 0;
+  for (size_t i = 0; i < faces.size(); i++)
+  {
+    size_t start = faceTriangles.getListStart(faces[i].second);
+    size_t size = faces[i].first;
+    if (size >= grain)
+    {
+      // Split the face over chunks of its own
+      size_t pieces = (size + grain - 1) / grain;
+      for (size_t p = 0; p < pieces; p++)
+      {
+        size_t pieceStart = size * p / pieces;
+        size_t pieceEnd = size * (p + 1) / pieces;
+        CurvatureChunkSegment segment = { start + pieceStart, pieceEnd - pieceStart };
+        segments.push_back(segment);
+        chunkOffsets.push_back(segments.size());
+      }
+    }
+    else
+    {
+      // Batch small faces until the chunk is full
+      CurvatureChunkSegment segment = { start, size };
+      segments.push_back(segment);
+      openChunkSize += size;
+      if (openChunkSize >= grain)
+      {
+        chunkOffsets.push_back(segments.size());
+        openChunkSize = 0;
+      }
+    }
+  }
+  if (chunkOffsets.back() != segments.size()) { chunkOffsets.push_back(segments.size()); }
+}
+
+/**
+ * @brief The CalculateCurvatureChunksImpl class computes the curvatures of a range of
+ * chunks, using the N ring and patch buffers of the calling thread
+ */
+class CalculateCurvatureChunksImpl
+{
+    const CalculateTriangleGroupCurvatures* m_Curvatures;
+    const int64_t* m_TriangleIds;
+    const std::vector<CurvatureChunkSegment>& m_Segments;
+    const std::vector<size_t>& m_ChunkOffsets;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::enumerable_thread_specific<CalculateTriangleGroupCurvatures::Workspace>* m_Workspaces;
+#endif
+
+  public:
+    CalculateCurvatureChunksImpl(const CalculateTriangleGroupCurvatures* curvatures, const int64_t* triangleIds,
+                                 const std::vector<CurvatureChunkSegment>& segments, const std::vector<size_t>& chunkOffsets) :
+      m_Curvatures(curvatures),
+      m_TriangleIds(triangleIds),
+      m_Segments(segments),
+      m_ChunkOffsets(chunkOffsets)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      , m_Workspaces(NULL)
+#endif
+    {}
+    virtual ~CalculateCurvatureChunksImpl() {}
+
+    void compute(size_t start, size_t end, CalculateTriangleGroupCurvatures::Workspace& workspace) const
+    {
+      for (size_t c = start; c < end; c++)
+      {
+        for (size_t seg = m_ChunkOffsets[c]; seg < m_ChunkOffsets[c + 1]; seg++)
+        {
+          m_Curvatures->compute(m_TriangleIds + m_Segments[seg].start, m_Segments[seg].count, workspace);
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void setWorkspaces(tbb::enumerable_thread_specific<CalculateTriangleGroupCurvatures::Workspace>* workspaces)
+    {
+      m_Workspaces = workspaces;
+    }
+
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      compute(r.begin(), r.end(), m_Workspaces->local());
+    }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -343,90 +469,73 @@ void FeatureFaceCurvatureFilter::execute()
     triangleGeom->findElementsContainingVert();
   }
 
-  // get the QMap from the SharedFeatureFaces filter
-  SharedFeatureFaces_t sharedFeatureFaces;
+  // Build the list of triangles of every Feature face
+  FlatNeighborList<int64_t> faceTriangles;
+  FeatureFaceGrouping::BuildFaceTriangleIndex(m_SurfaceMeshFeatureFaceIds, numTriangles, faceTriangles);
 
-  int32_t maxFaceId = 0;
-  for (int64_t t = 0; t < numTriangles; ++t)
-  {
-    if (m_SurfaceMeshFeatureFaceIds[t] > maxFaceId) { maxFaceId = m_SurfaceMeshFeatureFaceIds[t]; }
-  }
-  std::vector<int32_t> faceSizes(maxFaceId + 1, 0);
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for (int64_t t = 0; t < numTriangles; ++t)
-  {
-    faceSizes[m_SurfaceMeshFeatureFaceIds[t]]++;
-  }
-
-  // Allocate all the vectors that we need
-  for (size_t iter = 0; iter < faceSizes.size(); ++iter)
-  {
-    FaceIds_t v;
-    v.reserve(faceSizes[iter]);
-    sharedFeatureFaces[iter] = v;
-  }
-
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    sharedFeatureFaces[m_SurfaceMeshFeatureFaceIds[t]].push_back(t);
-  }
-
-  m_TotalFeatureFaces = sharedFeatureFaces.size();
+  m_TotalFeatureFaces = faceTriangles.getNumberOfFeatures();
   m_CompletedFeatureFaces = 0;
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
-#endif
-
-
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_group* g = new tbb::task_group;
+  size_t numThreads = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
 #else
-
+  size_t numThreads = 1;
 #endif
-  // typedef here for conveneince
-  typedef SharedFeatureFaces_t::iterator SharedFeatureFaceIterator_t;
 
-  for(SharedFeatureFaceIterator_t iter = sharedFeatureFaces.begin(); iter != sharedFeatureFaces.end(); ++iter)
-  {
-    QString ss = QObject::tr("Working on Face Id %1/%2").arg((*iter).first).arg(maxFaceId);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+  // Cut the Feature faces into chunks of roughly equal work
+  size_t grain = std::max<size_t>(32, static_cast<size_t>(numTriangles) / (64 * numThreads));
+  std::vector<CurvatureChunkSegment> segments;
+  std::vector<size_t> chunkOffsets;
+  BuildCurvatureChunks(faceTriangles, grain, segments, chunkOffsets);
+  size_t numChunks = chunkOffsets.size() - 1;
 
-    FaceIds_t& triangleIds = (*iter).second;
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if (doParallel == true)
-    {
-      g->run(CalculateTriangleGroupCurvatures(m_NRing, triangleIds, m_UseNormalsForCurveFitting,
+  CalculateTriangleGroupCurvatures curvatures(m_NRing, m_UseNormalsForCurveFitting,
                                               m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
                                               m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(),
                                               m_SurfaceMeshGaussianCurvaturesPtr.lock(), m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom,
                                               m_SurfaceMeshFaceLabelsPtr.lock(),
                                               m_SurfaceMeshFaceNormalsPtr.lock(),
                                               m_SurfaceMeshTriangleCentroidsPtr.lock(),
-                                              this ) );
+                                              this);
+  CalculateCurvatureChunksImpl chunksImpl(&curvatures, faceTriangles.getList(0), segments, chunkOffsets);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::enumerable_thread_specific<CalculateTriangleGroupCurvatures::Workspace> workspaces;
+  chunksImpl.setWorkspaces(&workspaces);
+#endif
+  CalculateTriangleGroupCurvatures::Workspace serialWorkspace;
+
+  // The chunks are run in a few waves so that progress is reported from this thread
+  // a handful of times instead of once per Feature face
+  size_t chunksPerWave = std::max<size_t>(8 * numThreads, (numChunks + 9) / 10);
+  size_t trianglesDone = 0;
+  for (size_t wave = 0; wave < numChunks; wave += chunksPerWave)
+  {
+    size_t waveEnd = std::min(wave + chunksPerWave, numChunks);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(wave, waveEnd, 1), chunksImpl, tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalculateTriangleGroupCurvatures curvature(m_NRing, triangleIds, m_UseNormalsForCurveFitting,
-                                                 m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                                 m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(),
-                                                 m_SurfaceMeshGaussianCurvaturesPtr.lock(), m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom,
-                                                 m_SurfaceMeshFaceLabelsPtr.lock(),
-                                                 m_SurfaceMeshFaceNormalsPtr.lock(),
-                                                 m_SurfaceMeshTriangleCentroidsPtr.lock(),
-                                                 this );
-      curvature();
+      chunksImpl.compute(wave, waveEnd, serialWorkspace);
     }
-  }
-  // *********************** END END END END END END  ********************************************************************
+    if (getCancel() == true) { return; }
 
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  g->wait(); // Wait for all the threads to complete before moving on.
-  delete g;
-#endif
+    for (size_t c = wave; c < waveEnd; c++)
+    {
+      for (size_t seg = chunkOffsets[c]; seg < chunkOffsets[c + 1]; seg++)
+      {
+        trianglesDone += segments[seg].count;
+      }
+    }
+    QString ss = QObject::tr("%1/%2 Triangles Complete").arg(trianglesDone).arg(numTriangles);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+  }
 
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
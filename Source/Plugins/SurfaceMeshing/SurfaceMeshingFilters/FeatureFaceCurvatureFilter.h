@@ -56,7 +56,6 @@ class FeatureFaceCurvatureFilter : public SurfaceMeshFilter
     virtual ~FeatureFaceCurvatureFilter();
 
     typedef std::vector<int64_t> FaceIds_t;
-    typedef std::map<int32_t, FaceIds_t> SharedFeatureFaces_t;
 
     SIMPL_FILTER_PARAMETER(DataArrayPath, FaceAttributeMatrixPath)
     Q_PROPERTY(DataArrayPath FaceAttributeMatrixPath READ getFaceAttributeMatrixPath WRITE setFaceAttributeMatrixPath)
@@ -0,0 +1,376 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _featurefacegrouping_h_
+#define _featurefacegrouping_h_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "OrientationLib/Utilities/FlatNeighborList.h"
+
+/**
+ * @brief The FeatureFaceGrouping class groups the triangles of a surface mesh into
+ * Feature faces, i.e. the sets of triangles that share the same (unordered) pair of
+ * Feature labels. Label pairs are packed into 64 bit keys and grouped with open
+ * addressing hash tables: every block of triangles is hashed into its own table in
+ * parallel, the block tables are merged, and a final parallel pass looks up the
+ * Feature face id of every triangle. Feature face ids are handed out in the order
+ * the label pairs first appear in the triangle list, starting at 1; id 0 is kept
+ * for the (0, 0) pair.
+ * The class also builds the compressed Feature face to triangle index that filters
+ * iterating over the triangles of each Feature face work from.
+ */
+class FeatureFaceGrouping
+{
+  public:
+    FeatureFaceGrouping() :
+      m_NumFeatureFaces(1)
+    {}
+    virtual ~FeatureFaceGrouping() {}
+
+    /**
+     * @brief execute Assigns a Feature face id to every triangle
+     * @param faceLabels The 2 component face labels of the triangles
+     * @param numTriangles The number of triangles
+     * @param featureFaceIds Output Feature face id of every triangle
+     */
+    void execute(const int32_t* faceLabels, int64_t numTriangles, int32_t* featureFaceIds)
+    {
+      int64_t numBlocks = (numTriangles + k_BlockSize - 1) / k_BlockSize;
+      std::vector<KeyTable> blockTables(numBlocks);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), HashBlocksImpl(faceLabels, numTriangles, &blockTables), tbb::auto_partitioner());
+#else
+      HashBlocksImpl serial(faceLabels, numTriangles, &blockTables);
+      serial.hash(0, numBlocks);
+#endif
+
+      // Merge the block tables; the first occurrence of a key is the smallest first
+      // occurrence over all the blocks
+      size_t numEntries = 0;
+      for (int64_t b = 0; b < numBlocks; b++)
+      {
+        numEntries = std::max(numEntries, blockTables[b].size());
+      }
+      KeyTable table(numEntries);
+      for (int64_t b = 0; b < numBlocks; b++)
+      {
+        KeyTable& block = blockTables[b];
+        for (size_t slot = 0; slot < block.capacity(); slot++)
+        {
+          if (block.isEmpty(slot)) { continue; }
+          Entry& entry = table.insert(block.key(slot));
+          Entry& blockEntry = block.entry(slot);
+          if (entry.first < 0 || blockEntry.first < entry.first) { entry.first = blockEntry.first; }
+          entry.count += blockEntry.count;
+        }
+        KeyTable().swap(block);
+      }
+
+      // Hand out ids in order of first appearance
+      std::vector<std::pair<int64_t, size_t> > order;
+      order.reserve(table.size());
+      for (size_t slot = 0; slot < table.capacity(); slot++)
+      {
+        if (!table.isEmpty(slot)) { order.push_back(std::make_pair(table.entry(slot).first, slot)); }
+      }
+      std::sort(order.begin(), order.end());
+
+      m_NumFeatureFaces = static_cast<int32_t>(order.size()) + 1;
+      m_FeatureFaceLabels.assign(2 * m_NumFeatureFaces, 0);
+      m_NumTriangles.assign(m_NumFeatureFaces, 0);
+      for (size_t i = 0; i < order.size(); i++)
+      {
+        size_t slot = order[i].second;
+        int32_t id = static_cast<int32_t>(i) + 1;
+        table.entry(slot).id = id;
+        m_FeatureFaceLabels[2 * id] = KeyLabel(table.key(slot), 0);
+        m_FeatureFaceLabels[2 * id + 1] = KeyLabel(table.key(slot), 1);
+        m_NumTriangles[id] = table.entry(slot).count;
+        if (table.key(slot) == 0) { m_NumTriangles[0] = table.entry(slot).count; }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::parallel_for(tbb::blocked_range<int64_t>(0, numTriangles), AssignIdsImpl(faceLabels, &table, featureFaceIds), tbb::auto_partitioner());
+#else
+      AssignIdsImpl serialIds(faceLabels, &table, featureFaceIds);
+      serialIds.assign(0, numTriangles);
+#endif
+    }
+
+    /**
+     * @brief getNumberOfFeatureFaces Returns the number of Feature faces including
+     * the reserved id 0
+     */
+    int32_t getNumberOfFeatureFaces() const { return m_NumFeatureFaces; }
+
+    /**
+     * @brief getFeatureFaceLabels Returns the ordered label pair of every Feature face
+     */
+    const std::vector<int32_t>& getFeatureFaceLabels() const { return m_FeatureFaceLabels; }
+
+    /**
+     * @brief getNumTriangles Returns the number of triangles of every Feature face
+     */
+    const std::vector<int32_t>& getNumTriangles() const { return m_NumTriangles; }
+
+    /**
+     * @brief BuildFaceTriangleIndex Builds the list of triangles of every Feature face
+     * from the Feature face ids with a counting sort. The triangles of each list are in
+     * increasing order.
+     * @param featureFaceIds The Feature face id of every triangle
+     * @param numTriangles The number of triangles
+     * @param index Output Feature face to triangle index
+     */
+    static void BuildFaceTriangleIndex(const int32_t* featureFaceIds, int64_t numTriangles, FlatNeighborList<int64_t>& index)
+    {
+      int32_t maxFaceId = 0;
+      for (int64_t t = 0; t < numTriangles; t++)
+      {
+        if (featureFaceIds[t] > maxFaceId) { maxFaceId = featureFaceIds[t]; }
+      }
+      index.setNumberOfFeatures(maxFaceId + 1);
+      for (int64_t t = 0; t < numTriangles; t++)
+      {
+        index.addToListSize(featureFaceIds[t]);
+      }
+      index.allocate();
+      for (int64_t t = 0; t < numTriangles; t++)
+      {
+        index.append(featureFaceIds[t], t);
+      }
+    }
+
+    /**
+     * @brief PackLabels Packs an unordered pair of labels into a single key
+     */
+    static inline uint64_t PackLabels(int32_t label0, int32_t label1)
+    {
+      if (label1 < label0) { std::swap(label0, label1); }
+      return (static_cast<uint64_t>(static_cast<uint32_t>(label1)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(label0));
+    }
+
+    /**
+     * @brief KeyLabel Returns the smaller (0) or larger (1) label of a packed key
+     */
+    static inline int32_t KeyLabel(uint64_t key, int32_t which)
+    {
+      return static_cast<int32_t>(static_cast<uint32_t>(which == 0 ? key : (key >> 32)));
+    }
+
+  private:
+    enum { k_BlockSize = 1 << 18 };
+
+    struct Entry
+    {
+      int64_t first;
+      int32_t count;
+      int32_t id;
+    };
+
+    /**
+     * @brief The KeyTable class is a linear probing hash table from packed label
+     * pairs to an Entry. It grows when it is half full.
+     */
+    class KeyTable
+    {
+      public:
+        explicit KeyTable(size_t expectedSize = 0) :
+          m_Size(0)
+        {
+          size_t capacity = 16;
+          while (capacity < 2 * expectedSize) { capacity *= 2; }
+          m_Keys.resize(capacity, 0);
+          Entry empty = { -1, 0, 0 };
+          m_Entries.resize(capacity, empty);
+          m_Used.resize(capacity, 0);
+        }
+
+        size_t size() const { return m_Size; }
+        size_t capacity() const { return m_Keys.size(); }
+        bool isEmpty(size_t slot) const { return m_Used[slot] == 0; }
+        uint64_t key(size_t slot) const { return m_Keys[slot]; }
+        Entry& entry(size_t slot) { return m_Entries[slot]; }
+
+        Entry& insert(uint64_t key)
+        {
+          if (2 * (m_Size + 1) > capacity()) { grow(); }
+          size_t slot = findSlot(key);
+          if (m_Used[slot] == 0)
+          {
+            m_Used[slot] = 1;
+            m_Keys[slot] = key;
+            m_Size++;
+          }
+          return m_Entries[slot];
+        }
+
+        const Entry* find(uint64_t key) const
+        {
+          size_t slot = findSlot(key);
+          return m_Used[slot] == 0 ? NULL : &(m_Entries[slot]);
+        }
+
+        void swap(KeyTable& other)
+        {
+          std::swap(m_Size, other.m_Size);
+          m_Keys.swap(other.m_Keys);
+          m_Entries.swap(other.m_Entries);
+          m_Used.swap(other.m_Used);
+        }
+
+      private:
+        size_t m_Size;
+        std::vector<uint64_t> m_Keys;
+        std::vector<Entry> m_Entries;
+        std::vector<uint8_t> m_Used;
+
+        size_t findSlot(uint64_t key) const
+        {
+          size_t mask = capacity() - 1;
+          size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+          while (m_Used[slot] != 0 && m_Keys[slot] != key)
+          {
+            slot = (slot + 1) & mask;
+          }
+          return slot;
+        }
+
+        void grow()
+        {
+          KeyTable bigger(capacity());
+          for (size_t slot = 0; slot < capacity(); slot++)
+          {
+            if (m_Used[slot] != 0) { bigger.insert(m_Keys[slot]) = m_Entries[slot]; }
+          }
+          swap(bigger);
+        }
+    };
+
+    /**
+     * @brief The HashBlocksImpl class counts the label pairs of blocks of triangles
+     */
+    class HashBlocksImpl
+    {
+        const int32_t* m_FaceLabels;
+        int64_t m_NumTriangles;
+        std::vector<KeyTable>* m_Tables;
+
+      public:
+        HashBlocksImpl(const int32_t* faceLabels, int64_t numTriangles, std::vector<KeyTable>* tables) :
+          m_FaceLabels(faceLabels),
+          m_NumTriangles(numTriangles),
+          m_Tables(tables)
+        {}
+
+        void hash(size_t start, size_t end) const
+        {
+          for (size_t b = start; b < end; b++)
+          {
+            int64_t begin = static_cast<int64_t>(b) * k_BlockSize;
+            int64_t last = std::min(begin + static_cast<int64_t>(k_BlockSize), m_NumTriangles);
+            KeyTable& table = (*m_Tables)[b];
+            for (int64_t t = begin; t < last; t++)
+            {
+              Entry& entry = table.insert(PackLabels(m_FaceLabels[2 * t], m_FaceLabels[2 * t + 1]));
+              if (entry.first < 0) { entry.first = t; }
+              entry.count++;
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          hash(r.begin(), r.end());
+        }
+#endif
+    };
+
+    /**
+     * @brief The AssignIdsImpl class looks up the Feature face id of every triangle
+     */
+    class AssignIdsImpl
+    {
+        const int32_t* m_FaceLabels;
+        const KeyTable* m_Table;
+        int32_t* m_FeatureFaceIds;
+
+      public:
+        AssignIdsImpl(const int32_t* faceLabels, const KeyTable* table, int32_t* featureFaceIds) :
+          m_FaceLabels(faceLabels),
+          m_Table(table),
+          m_FeatureFaceIds(featureFaceIds)
+        {}
+
+        void assign(int64_t start, int64_t end) const
+        {
+          for (int64_t t = start; t < end; t++)
+          {
+            m_FeatureFaceIds[t] = m_Table->find(PackLabels(m_FaceLabels[2 * t], m_FaceLabels[2 * t + 1]))->id;
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<int64_t>& r) const
+        {
+          assign(r.begin(), r.end());
+        }
+#endif
+    };
+
+    int32_t m_NumFeatureFaces;
+    std::vector<int32_t> m_FeatureFaceLabels;
+    std::vector<int32_t> m_NumTriangles;
+
+    FeatureFaceGrouping(const FeatureFaceGrouping&); // Copy Constructor Not Implemented
+    void operator=(const FeatureFaceGrouping&); // Operator '=' Not Implemented
+};
+
+#endif /* _featurefacegrouping_h_ */
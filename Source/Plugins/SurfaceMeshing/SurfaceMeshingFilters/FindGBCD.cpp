@@ -42,6 +42,9 @@
 #include <tbb/task_scheduler_init.h>
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QDateTime>
 
 #include "SIMPLib/SIMPLibVersion.h"
@@ -63,91 +66,116 @@
 
 /**
  * @brief The CalculateGBCDImpl class implements a threaded algorithm that calculates the
- * grain boundary character distribution (GBCD) for a surface mesh
+ * grain boundary character distribution (GBCD) for a surface mesh. Each face adds its area
+ * straight into a GBCD histogram. In parallel a chunk of faces is split into as many slices as
+ * there are scratch histograms (each with the per phase face areas appended at the end) and every
+ * slice accumulates into its own histogram; the histograms are summed once all chunks are done.
  */
 class CalculateGBCDImpl
 {
-    size_t startOffset;
-    size_t numEntriesPerTri;
-    Int32ArrayType::Pointer m_LabelsArray;
-    DoubleArrayType::Pointer m_NormalsArray;
-    Int32ArrayType::Pointer m_PhasesArray;
-    FloatArrayType::Pointer m_EulersArray;
-
-    FloatArrayType::Pointer m_GbcdDeltasArray;
-    FloatArrayType::Pointer m_GbcdLimitsArray;
-    Int32ArrayType::Pointer m_GbcdSizesArray;
-    Int32ArrayType::Pointer m_GbcdBinsArray;
-    BoolArrayType::Pointer  m_GbcdHemiCheckArray;
-
-    UInt32ArrayType::Pointer m_CrystalStructuresArray;
-    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+    int32_t* m_Labels;
+    double* m_Normals;
+    double* m_Areas;
+    int32_t* m_Phases;
+    float* m_Eulers;
+
+    float* m_GBCDdeltas;
+    float* m_GBCDlimits;
+    int32_t* m_GBCDsizes;
+    size_t m_TotalPhases;
+    size_t m_TotalGBCDBins;
+
+    // Symmetry operators of each phase, read once instead of once per face and operator pair
+    QVector<int32_t> m_NumSymOps;
+    QVector<float> m_SymOps;
+
+    std::vector<std::vector<double> >* m_Histograms;
+    size_t m_ChunkStart;
+    size_t m_ChunkEnd;
 
   public:
-    CalculateGBCDImpl(size_t i, size_t numMisoReps, Int32ArrayType::Pointer Labels, DoubleArrayType::Pointer Normals, FloatArrayType::Pointer Eulers,
+    enum
+    {
+      k_MaxSymOps = 24
+    };
+
+    CalculateGBCDImpl(Int32ArrayType::Pointer Labels, DoubleArrayType::Pointer Normals, DoubleArrayType::Pointer Areas, FloatArrayType::Pointer Eulers,
                       Int32ArrayType::Pointer Phases, UInt32ArrayType::Pointer CrystalStructures,
-                      Int32ArrayType::Pointer Bins, BoolArrayType::Pointer HemiCheck,
-                      FloatArrayType::Pointer GBCDdeltas, Int32ArrayType::Pointer  GBCDsizes,
-                      FloatArrayType::Pointer GBCDlimits) :
-      startOffset(i),
-      numEntriesPerTri(numMisoReps),
-      m_LabelsArray(Labels),
-      m_NormalsArray(Normals),
-      m_PhasesArray(Phases),
-      m_EulersArray(Eulers),
-      m_GbcdDeltasArray(GBCDdeltas),
-      m_GbcdLimitsArray(GBCDlimits),
-      m_GbcdSizesArray(GBCDsizes),
-      m_GbcdBinsArray(Bins),
-      m_GbcdHemiCheckArray(HemiCheck),
-      m_CrystalStructuresArray(CrystalStructures)
+                      FloatArrayType::Pointer GBCDdeltas, Int32ArrayType::Pointer GBCDsizes,
+                      FloatArrayType::Pointer GBCDlimits, size_t totalGBCDBins) :
+      m_Labels(Labels->getPointer(0)),
+      m_Normals(Normals->getPointer(0)),
+      m_Areas(Areas->getPointer(0)),
+      m_Phases(Phases->getPointer(0)),
+      m_Eulers(Eulers->getPointer(0)),
+      m_GBCDdeltas(GBCDdeltas->getPointer(0)),
+      m_GBCDlimits(GBCDlimits->getPointer(0)),
+      m_GBCDsizes(GBCDsizes->getPointer(0)),
+      m_TotalPhases(CrystalStructures->getNumberOfTuples()),
+      m_TotalGBCDBins(totalGBCDBins),
+      m_Histograms(NULL),
+      m_ChunkStart(0),
+      m_ChunkEnd(0)
     {
-      m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
+      QVector<SpaceGroupOps::Pointer> orientationOps = SpaceGroupOps::getOrientationOpsQVector();
+      uint32_t* crystalStructures = CrystalStructures->getPointer(0);
+      m_NumSymOps.fill(0, m_TotalPhases);
+      m_SymOps.fill(0.0f, m_TotalPhases * k_MaxSymOps * 9);
+      float sym[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      for (size_t p = 1; p < m_TotalPhases; p++)
+      {
+        uint32_t cryst = crystalStructures[p];
+        if (cryst >= static_cast<uint32_t>(orientationOps.size())) { continue; }
+        int32_t nsym = orientationOps[cryst]->getNumSymOps();
+        if (nsym > k_MaxSymOps) { nsym = k_MaxSymOps; }
+        m_NumSymOps[p] = nsym;
+        for (int32_t j = 0; j < nsym; j++)
+        {
+          orientationOps[cryst]->getMatSymOp(j, sym);
+          for (int32_t m = 0; m < 9; m++) { m_SymOps[(p * k_MaxSymOps + j) * 9 + m] = sym[m / 3][m % 3]; }
+        }
+      }
     }
     virtual ~CalculateGBCDImpl() {}
 
-    void generate(size_t start, size_t end) const
+    /**
+     * @brief setChunk Sets the scratch histograms and the faces [start, end) that operator() splits between them
+     */
+    void setChunk(std::vector<std::vector<double> >* histograms, size_t start, size_t end)
     {
+      m_Histograms = histograms;
+      m_ChunkStart = start;
+      m_ChunkEnd = end;
+    }
 
-      // We want to work with the raw pointers for speed so get those pointers.
-      float* m_GBCDdeltas = m_GbcdDeltasArray->getPointer(0);
-      float* m_GBCDlimits = m_GbcdLimitsArray->getPointer(0);
-      int* m_GBCDsizes = m_GbcdSizesArray->getPointer(0);
-      int32_t* m_Bins = m_GbcdBinsArray->getPointer(0);
-      bool* m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
-
-      int32_t* m_Labels = m_LabelsArray->getPointer(0);
-      double* m_Normals = m_NormalsArray->getPointer(0);
-      int32_t* m_Phases = m_PhasesArray->getPointer(0);
-      float* m_Eulers = m_EulersArray->getPointer(0);
-      uint32_t* m_CrystalStructures = m_CrystalStructuresArray->getPointer(0);
-
-
-      int32_t j = 0;//, j4;
-      int32_t k = 0;//, k4;
+    /**
+     * @brief generate Adds the faces in [start, end) to a GBCD histogram
+     * @param gbcd Histogram of m_TotalPhases * m_TotalGBCDBins values
+     * @param totalFaceArea Total binned area for each phase
+     */
+    void generate(size_t start, size_t end, double* gbcd, double* totalFaceArea) const
+    {
+      int32_t j = 0;
+      int32_t k = 0;
       int32_t m = 0;
       int32_t temp = 0;
-      //bool gbcd_indices_good;
       int32_t feature1 = 0, feature2 = 0;
       int32_t inversion = 1;
       float g1ea[3] = { 0.0f, 0.0f, 0.0f }, g2ea[3] = { 0.0f, 0.0f, 0.0f };
       float g1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, g2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-      float g1s[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, g2s[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-      float sym1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, sym2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-      float g2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, dg[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float sym[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float g2s[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, dg[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float g1sTable[k_MaxSymOps][3][3];
+      float g2tTable[k_MaxSymOps][3][3];
       float euler_mis[3] = { 0.0f, 0.0f, 0.0f };
       float normal[3] = { 0.0f, 0.0f, 0.0f };
       float xstl1_norm1[3] = { 0.0f, 0.0f, 0.0f };
       int32_t gbcd_index = 0;
       float sqCoord[2] = { 0.0f, 0.0f }, sqCoordInv[2] = { 0.0f, 0.0f };
       bool nhCheck = false, nhCheckInv = true;
-      int32_t SYMcounter = 0;
-      int64_t TRIcounter = static_cast<int64_t>(start - startOffset);
-      int64_t TRIcounterShift = 0;
 
       for (size_t i = start; i < end; i++)
       {
-        SYMcounter = 0;
         feature1 = m_Labels[2 * i];
         feature2 = m_Labels[2 * i + 1];
         normal[0] = m_Normals[3 * i];
@@ -158,8 +186,12 @@ class CalculateGBCDImpl
 
         if (m_Phases[feature1] == m_Phases[feature2] && m_Phases[feature1] > 0)
         {
-          TRIcounterShift = (TRIcounter * numEntriesPerTri);
-          uint32_t cryst = m_CrystalStructures[m_Phases[feature1]];
+          int32_t phase = m_Phases[feature1];
+          double area = m_Areas[i];
+          double* phaseGBCD = gbcd + phase * m_TotalGBCDBins;
+          int32_t nsym = m_NumSymOps[phase];
+          const float* symOps = m_SymOps.data() + phase * k_MaxSymOps * 9;
+
           for (int32_t q = 0; q < 2; q++)
           {
             if (q == 1)
@@ -184,14 +216,20 @@ class CalculateGBCDImpl
             FOrientTransformsType::eu2om(FOrientArrayType(g2ea, 3), om);
             om.toGMatrix(g2);
 
-            int32_t nsym = m_OrientationOps[cryst]->getNumSymOps();
+            // The symmetric variants of both orientations only depend on one operator each, so
+            // compute them once per face instead of once per operator pair
+            for (j = 0; j < nsym; j++)
+            {
+              for (m = 0; m < 9; m++) { sym[m / 3][m % 3] = symOps[j * 9 + m]; }
+              MatrixMath::Multiply3x3with3x3(sym, g1, g1sTable[j]);
+              MatrixMath::Multiply3x3with3x3(sym, g2, g2s);
+              MatrixMath::Transpose3x3(g2s, g2tTable[j]);
+            }
+
             for (j = 0; j < nsym; j++)
             {
-              // rotate g1 by symOp
-              m_OrientationOps[cryst]->getMatSymOp(j, sym1);
-              MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
               // get the crystal directions along the triangle normals
-              MatrixMath::Multiply3x3with3x1(g1s, normal, xstl1_norm1);
+              MatrixMath::Multiply3x3with3x1(g1sTable[j], normal, xstl1_norm1);
               // get coordinates in square projection of crystal normal parallel to boundary normal
               nhCheck = getSquareCoord(xstl1_norm1, sqCoord);
               if (inversion == 1)
@@ -204,14 +242,8 @@ class CalculateGBCDImpl
 
               for (k = 0; k < nsym; k++)
               {
-                // calculate the symmetric misorienation
-                m_OrientationOps[cryst]->getMatSymOp(k, sym2);
-                // rotate g2 by symOp
-                MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
-                // transpose rotated g2
-                MatrixMath::Transpose3x3(g2s, g2t);
                 // calculate delta g
-                MatrixMath::Multiply3x3with3x3(g1s, g2t, dg);
+                MatrixMath::Multiply3x3with3x3(g1sTable[j], g2tTable[k], dg);
                 // translate matrix to euler angles
                 FOrientArrayType om(dg);
 
@@ -226,34 +258,38 @@ class CalculateGBCDImpl
                   gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoord);
                   if (gbcd_index != -1)
                   {
-                    m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheck;
-                    m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                    phaseGBCD[2 * gbcd_index + (nhCheck ? 0 : 1)] += area;
+                    totalFaceArea[phase] += area;
                   }
-                  SYMcounter++;
                   if (inversion == 1)
                   {
                     gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoordInv);
                     if (gbcd_index != -1)
                     {
-                      m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheckInv;
-                      m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                      phaseGBCD[2 * gbcd_index + (nhCheckInv ? 0 : 1)] += area;
+                      totalFaceArea[phase] += area;
                     }
-                    SYMcounter++;
                   }
                 }
-                else { SYMcounter += 2; }
               }
             }
           }
         }
-        TRIcounter++;
       }
     }
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
     void operator()(const tbb::blocked_range<size_t>& r) const
     {
-      generate(r.begin(), r.end());
+      size_t numHistograms = m_Histograms->size();
+      size_t chunkSize = m_ChunkEnd - m_ChunkStart;
+      for (size_t h = r.begin(); h < r.end(); h++)
+      {
+        std::vector<double>& histogram = (*m_Histograms)[h];
+        size_t start = m_ChunkStart + chunkSize * h / numHistograms;
+        size_t end = m_ChunkStart + chunkSize * (h + 1) / numHistograms;
+        generate(start, end, &(histogram[0]), &(histogram[m_TotalPhases * m_TotalGBCDBins]));
+      }
     }
 #endif
 
@@ -342,6 +378,7 @@ FindGBCD::FindGBCD() :
   m_FeaturePhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases),
   m_CrystalStructuresArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures),
   m_GBCDArrayName(SIMPL::EnsembleData::GBCD),
+  m_HistogramMemoryBudget(1024 * 1024 * 1024),
   m_SurfaceMeshFaceAreas(NULL),
   m_SurfaceMeshFaceLabels(NULL),
   m_SurfaceMeshFaceNormals(NULL),
@@ -351,15 +388,11 @@ FindGBCD::FindGBCD() :
   m_GBCD(NULL),
   m_GbcdDeltas(NULL),
   m_GbcdSizes(NULL),
-  m_GbcdLimits(NULL),
-  m_GbcdBins(NULL),
-  m_HemiCheck(NULL)
+  m_GbcdLimits(NULL)
 {
   m_GbcdDeltasArray = FloatArrayType::NullPointer();
   m_GbcdSizesArray = Int32ArrayType::NullPointer();
   m_GbcdLimitsArray = FloatArrayType::NullPointer();
-  m_GbcdBinsArray = Int32ArrayType::NullPointer();
-  m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
 
   setupFilterParameters();
 }
@@ -460,14 +493,10 @@ void FindGBCD::initialize()
   m_GbcdDeltasArray = FloatArrayType::NullPointer();
   m_GbcdSizesArray = Int32ArrayType::NullPointer();
   m_GbcdLimitsArray = FloatArrayType::NullPointer();
-  m_GbcdBinsArray = Int32ArrayType::NullPointer();
-  m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
 
   m_GbcdDeltas = nullptr;
   m_GbcdSizes = nullptr;
   m_GbcdLimits = nullptr;
-  m_GbcdBins = nullptr;
-  m_HemiCheck = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -503,8 +532,8 @@ void FindGBCD::dataCheckSurfaceMesh()
   if( NULL != m_SurfaceMeshFaceAreasPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
   { m_SurfaceMeshFaceAreas = m_SurfaceMeshFaceAreasPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
 
-  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.  Note that the input parameters do not affect the size and can be dummy values here;
-  sizeGBCD(0, 0);
+  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.
+  sizeGBCD();
   cDims.resize(6);
   cDims[0] = m_GbcdSizes[0];
   cDims[1] = m_GbcdSizes[1];
@@ -577,82 +606,85 @@ void FindGBCD::execute()
 
   size_t totalPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
   size_t totalFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
-  size_t faceChunkSize = 50000;
-  size_t numMisoReps = 576 * 4;
-  if (totalFaces < faceChunkSize) { faceChunkSize = totalFaces; }
-  // call the sizeGBCD function with proper chunkSize and numMisoReps to get Bins array set up properly
-  sizeGBCD(faceChunkSize, numMisoReps);
+  sizeGBCD();
   int32_t totalGBCDBins = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3] * m_GbcdSizes[4] * 2;
 
+  //create an array to hold the total face area for each phase and initialize the array to 0.0
+  DoubleArrayType::Pointer totalFaceAreaPtr = DoubleArrayType::CreateArray(totalPhases, "totalFaceArea");
+  totalFaceAreaPtr->initializeWithValue(0.0);
+  double* totalFaceArea = totalFaceAreaPtr->getPointer(0);
+
+  QString ss = QObject::tr("Calculating GBCD || %1 Triangles").arg(totalFaces);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+  CalculateGBCDImpl calculator(m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_SurfaceMeshFaceAreasPtr.lock(), m_FeatureEulerAnglesPtr.lock(),
+                               m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray, totalGBCDBins);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  // Every slice of a chunk accumulates into its own scratch histogram, so the number of
+  // histograms is bounded by the memory budget; when even two do not fit the faces are
+  // accumulated serially straight into the GBCD
+  size_t histogramSize = totalPhases * totalGBCDBins + totalPhases;
+  size_t numHistograms = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+  size_t memoryBudget = (m_HistogramMemoryBudget > 0) ? static_cast<size_t>(m_HistogramMemoryBudget) : 0;
+  numHistograms = std::min(numHistograms, memoryBudget / (histogramSize * sizeof(double)));
+  if (numHistograms < 2) { doParallel = false; }
+  std::vector<std::vector<double> > histograms;
+  if (doParallel == true) { histograms.assign(numHistograms, std::vector<double>(histogramSize, 0.0)); }
+#endif
+
+  size_t faceChunkSize = 50000;
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t currentMillis = millis;
   uint64_t startMillis = millis;
   uint64_t estimatedTime = 0;
   float timeDiff = 0.0f;
-  startMillis =  QDateTime::currentMSecsSinceEpoch();
-  int32_t hemisphere = 0;
-
-  //create an array to hold the total face area for each phase and initialize the array to 0.0
-  DoubleArrayType::Pointer totalFaceAreaPtr = DoubleArrayType::CreateArray(totalPhases, "totalFaceArea");
-  totalFaceAreaPtr->initializeWithValue(0.0);
-  double* totalFaceArea = totalFaceAreaPtr->getPointer(0);
 
-  QString ss = QObject::tr("Calculating GBCD || 0/%1 Completed").arg(totalFaces);
   for (size_t i = 0; i < totalFaces; i = i + faceChunkSize)
   {
     if(getCancel() == true) { return; }
-    if (i + faceChunkSize >= totalFaces)
+    if (i + faceChunkSize >= totalFaces) { faceChunkSize = totalFaces - i; }
+
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if (currentMillis - millis > 1000)
     {
-      faceChunkSize = totalFaces - i;
+      ss = QObject::tr("Calculating GBCD || Triangles %1/%2 Completed").arg(i).arg(totalFaces);
+      timeDiff = ((float)i / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalFaces - i) / timeDiff;
+      ss = ss + QObject::tr(" || Est. Time Remain: %1").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime));
+      millis = QDateTime::currentMSecsSinceEpoch();
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
     }
-    m_GbcdBinsArray->initializeWithValue(-1);
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
     if (doParallel == true)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize),
-                        CalculateGBCDImpl(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray), tbb::auto_partitioner());
-
+      calculator.setChunk(&histograms, i, i + faceChunkSize);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numHistograms, 1), calculator, tbb::auto_partitioner());
     }
     else
 #endif
     {
-      CalculateGBCDImpl serial(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
-      serial.generate(i, i + faceChunkSize);
+      calculator.generate(i, i + faceChunkSize, m_GBCD, totalFaceArea);
     }
+  }
 
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if (currentMillis - millis > 1000)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  for (size_t h = 0; h < histograms.size(); h++)
+  {
+    const double* histogram = &(histograms[h][0]);
+    for (size_t j = 0; j < totalPhases * totalGBCDBins; j++)
     {
-      QString ss = QObject::tr("Calculating GBCD || Triangles %1/%2 Completed").arg(i).arg(totalFaces);
-      timeDiff = ((float)i / (float)(currentMillis - startMillis));
-      estimatedTime = (float)(totalFaces - i) / timeDiff;
-      ss = ss + QObject::tr(" || Est. Time Remain: %1").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime));
-      millis = QDateTime::currentMSecsSinceEpoch();
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      m_GBCD[j] += histogram[j];
     }
-
-    if(getCancel() == true) { return; }
-
-    int32_t phase = 0;
-    int32_t feature = 0;
-    double area = 0.0;
-    for (size_t j = 0; j < faceChunkSize; j++)
+    for (size_t j = 0; j < totalPhases; j++)
     {
-      area = m_SurfaceMeshFaceAreas[i + j];
-      feature = m_SurfaceMeshFaceLabels[2 * (i + j)];
-      phase = m_FeaturePhases[feature];
-      for (size_t k = 0; k < numMisoReps; k++)
-      {
-        if (m_GbcdBins[(j * numMisoReps) + (k)] >= 0)
-        {
-          hemisphere = 0;
-          if (m_HemiCheck[(j * numMisoReps) + k] == false) { hemisphere = 1; }
-          m_GBCD[(phase * totalGBCDBins) + (2 * m_GbcdBins[(j * numMisoReps) + (k)] + hemisphere)] += area;
-          totalFaceArea[phase] += area;
-        }
-      }
+      totalFaceArea[j] += histogram[totalPhases * totalGBCDBins + j];
     }
   }
+#endif
+
+  if(getCancel() == true) { return; }
 
   ss = QObject::tr("Starting GBCD Normalization");
   notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
@@ -674,7 +706,7 @@ void FindGBCD::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
+void FindGBCD::sizeGBCD()
 {
   m_GbcdDeltasArray = FloatArrayType::CreateArray(5, "GBCDDeltas");
   m_GbcdDeltasArray->initializeWithZeros();
@@ -682,17 +714,10 @@ void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
   m_GbcdLimitsArray->initializeWithZeros();
   m_GbcdSizesArray = Int32ArrayType::CreateArray(5, "GBCDSizes");
   m_GbcdSizesArray->initializeWithZeros();
-  QVector<size_t> cDims(1, numMisoReps);
-  m_GbcdBinsArray = Int32ArrayType::CreateArray(faceChunkSize, cDims, "GBCDBins");
-  m_GbcdBinsArray->initializeWithZeros();
-  m_GbcdHemiCheckArray = BoolArrayType::CreateArray(faceChunkSize, cDims, "GBCDHemiCheck");
-  m_GbcdHemiCheckArray->initializeWithValue(false);
 
   m_GbcdDeltas = m_GbcdDeltasArray->getPointer(0);
   m_GbcdSizes = m_GbcdSizesArray->getPointer(0);
   m_GbcdLimits = m_GbcdLimitsArray->getPointer(0);
-  m_GbcdBins = m_GbcdBinsArray->getPointer(0);
-  m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
   //Original Ranges from Dave R.
   //m_GBCDlimits[0] = 0.0f;
@@ -63,6 +63,8 @@
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/NormalSphereGrid.h"
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -113,6 +115,66 @@ class TriAreaAndNormals
     }
 };
 
+/**
+ * @brief The SelectedTrisArrays class holds the selected triangles as flat structure of arrays
+ * so the probing threads can share one read only copy. Entry 2*i of the normals index is the
+ * normal of grain 1 of triangle i and entry 2*i+1 is its inversion.
+ */
+class SelectedTrisArrays
+{
+  public:
+    QVector<double> area;
+    QVector<float> normal_grain1_x;
+    QVector<float> normal_grain1_y;
+    QVector<float> normal_grain1_z;
+    QVector<float> normal_grain2_x;
+    QVector<float> normal_grain2_y;
+    QVector<float> normal_grain2_z;
+
+    template<typename Container>
+    void assign(const Container& tris)
+    {
+      int32_t numTris = static_cast<int32_t>(tris.size());
+      area.resize(numTris);
+      normal_grain1_x.resize(numTris);
+      normal_grain1_y.resize(numTris);
+      normal_grain1_z.resize(numTris);
+      normal_grain2_x.resize(numTris);
+      normal_grain2_y.resize(numTris);
+      normal_grain2_z.resize(numTris);
+      for (int32_t i = 0; i < numTris; i++)
+      {
+        area[i] = tris[i].area;
+        normal_grain1_x[i] = tris[i].normal_grain1_x;
+        normal_grain1_y[i] = tris[i].normal_grain1_y;
+        normal_grain1_z[i] = tris[i].normal_grain1_z;
+        normal_grain2_x[i] = tris[i].normal_grain2_x;
+        normal_grain2_y[i] = tris[i].normal_grain2_y;
+        normal_grain2_z[i] = tris[i].normal_grain2_z;
+      }
+    }
+
+    int32_t size() const { return area.size(); }
+
+    void buildIndex(NormalSphereGrid& grid) const
+    {
+      int32_t numTris = size();
+      QVector<float> x(2 * numTris);
+      QVector<float> y(2 * numTris);
+      QVector<float> z(2 * numTris);
+      for (int32_t i = 0; i < numTris; i++)
+      {
+        x[2 * i] = normal_grain1_x[i];
+        y[2 * i] = normal_grain1_y[i];
+        z[2 * i] = normal_grain1_z[i];
+        x[2 * i + 1] = -normal_grain1_x[i];
+        y[2 * i + 1] = -normal_grain1_y[i];
+        z[2 * i + 1] = -normal_grain1_z[i];
+      }
+      grid.build(x.data(), y.data(), z.data(), x.size());
+    }
+};
+
 /**
  * @brief The TrisSelector class implements a threaded algorithm that determines which triangles to
  * include in the GBCD calculation
@@ -337,11 +399,8 @@ class ProbeDistrib
     QVector<float> samplPtsX;
     QVector<float> samplPtsY;
     QVector<float> samplPtsZ;
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
-#else
-    QVector<TriAreaAndNormals> selectedTris;
-#endif
+    const SelectedTrisArrays& selectedTris;
+    const NormalSphereGrid& normalsGrid;
     float planeResolSq;
     double totalFaceArea;
     int numDistinctGBs;
@@ -355,11 +414,8 @@ class ProbeDistrib
         QVector<float> __samplPtsX,
         QVector<float> __samplPtsY,
         QVector<float> __samplPtsZ,
-    #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-        tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
-    #else
-        QVector<TriAreaAndNormals> __selectedTris,
-    #endif
+        const SelectedTrisArrays& __selectedTris,
+        const NormalSphereGrid& __normalsGrid,
         float __planeResolSq,
         double __totalFaceArea,
         int __numDistinctGBs,
@@ -372,6 +428,7 @@ class ProbeDistrib
       samplPtsY(__samplPtsY),
       samplPtsZ(__samplPtsZ),
       selectedTris(__selectedTris),
+      normalsGrid(__normalsGrid),
       planeResolSq(__planeResolSq),
       totalFaceArea(__totalFaceArea),
       numDistinctGBs(__numDistinctGBs),
@@ -390,28 +447,35 @@ class ProbeDistrib
         float fixedNormal2[3] = { 0.0f, 0.0f, 0.0f };
         MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormal2);
 
-        for (int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+        // Only triangles whose (possibly inverted) grain 1 normal lies within sqrt(2) * planeResol
+        // of the probe can satisfy distSq < planeResolSq, and the grid holds all of them
+        size_t cells[NormalSphereGrid::MaxNeighborCells];
+        size_t numCells = normalsGrid.getNeighborCells(fixedNormal1, cells);
+
+        for (size_t c = 0; c < numCells; c++)
         {
-          for (int inversion = 0; inversion <= 1; inversion++)
+          for (size_t pos = normalsGrid.getCellBegin(cells[c]); pos < normalsGrid.getCellEnd(cells[c]); pos++)
           {
+            size_t entry = normalsGrid.getItem(pos);
+            int32_t triRepresIdx = static_cast<int32_t>(entry / 2);
             float sign = 1.0f;
-            if (inversion == 1) sign = -1.0f;
+            if (entry % 2 == 1) sign = -1.0f;
 
             float theta1 = acosf(sign * (
-                                   selectedTris[triRepresIdx].normal_grain1_x * fixedNormal1[0] +
-                                   selectedTris[triRepresIdx].normal_grain1_y * fixedNormal1[1] +
-                                   selectedTris[triRepresIdx].normal_grain1_z * fixedNormal1[2]));
+                                   selectedTris.normal_grain1_x[triRepresIdx] * fixedNormal1[0] +
+                                   selectedTris.normal_grain1_y[triRepresIdx] * fixedNormal1[1] +
+                                   selectedTris.normal_grain1_z[triRepresIdx] * fixedNormal1[2]));
 
             float theta2 = acosf(-sign * (
-                                   selectedTris[triRepresIdx].normal_grain2_x * fixedNormal2[0] +
-                                   selectedTris[triRepresIdx].normal_grain2_y * fixedNormal2[1] +
-                                   selectedTris[triRepresIdx].normal_grain2_z * fixedNormal2[2]));
+                                   selectedTris.normal_grain2_x[triRepresIdx] * fixedNormal2[0] +
+                                   selectedTris.normal_grain2_y[triRepresIdx] * fixedNormal2[1] +
+                                   selectedTris.normal_grain2_z[triRepresIdx] * fixedNormal2[2]));
 
             float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
 
             if (distSq < planeResolSq)
             {
-              (*distribValues)[ptIdx] += selectedTris[triRepresIdx].area;
+              (*distribValues)[ptIdx] += selectedTris.area[triRepresIdx];
             }
           }
         }
@@ -1046,6 +1110,14 @@ void FindGBCDMetricBased::execute()
     totalFaceArea += m_FaceAreas[triIdx] * double(triIncluded.at(triIdx));
   }
 
+  // Flatten the selected triangles and index their normals on the unit sphere so that each
+  // sampling point only visits the triangles that can be within the plane resolution
+  SelectedTrisArrays selectedTrisArrays;
+  selectedTrisArrays.assign(selectedTris);
+  selectedTris.clear();
+  NormalSphereGrid normalsGrid(sqrtf(2.0f * m_PlaneResolSq));
+  selectedTrisArrays.buildIndex(normalsGrid);
+
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
@@ -1072,7 +1144,8 @@ void FindGBCDMetricBased::execute()
         samplPtsX,
         samplPtsY,
         samplPtsZ,
-        selectedTris,
+        selectedTrisArrays,
+        normalsGrid,
         m_PlaneResolSq,
         totalFaceArea,
         numDistinctGBs,
@@ -1089,7 +1162,8 @@ void FindGBCDMetricBased::execute()
         samplPtsX,
         samplPtsY,
         samplPtsZ,
-        selectedTris,
+        selectedTrisArrays,
+        normalsGrid,
         m_PlaneResolSq,
         totalFaceArea,
         numDistinctGBs,
@@ -63,6 +63,8 @@
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/NormalSphereGrid.h"
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -110,6 +112,72 @@ class TriAreaAndNormals
     }
 };
 
+/**
+ * @brief The SelectedTrisArrays class holds the selected triangles as flat structure of arrays
+ * so the probing threads can share one read only copy. The normals index holds four entries per
+ * triangle: entry 4*i+2*k+s is normal k (0 for grain 1, 1 for grain 2) of triangle i, inverted when s is 1.
+ */
+class SelectedTrisArrays
+{
+  public:
+    QVector<double> area;
+    QVector<float> normal_grain1_x;
+    QVector<float> normal_grain1_y;
+    QVector<float> normal_grain1_z;
+    QVector<float> normal_grain2_x;
+    QVector<float> normal_grain2_y;
+    QVector<float> normal_grain2_z;
+
+    template<typename Container>
+    void assign(const Container& tris)
+    {
+      int32_t numTris = static_cast<int32_t>(tris.size());
+      area.resize(numTris);
+      normal_grain1_x.resize(numTris);
+      normal_grain1_y.resize(numTris);
+      normal_grain1_z.resize(numTris);
+      normal_grain2_x.resize(numTris);
+      normal_grain2_y.resize(numTris);
+      normal_grain2_z.resize(numTris);
+      for (int32_t i = 0; i < numTris; i++)
+      {
+        area[i] = tris[i].area;
+        normal_grain1_x[i] = tris[i].normal_grain1_x;
+        normal_grain1_y[i] = tris[i].normal_grain1_y;
+        normal_grain1_z[i] = tris[i].normal_grain1_z;
+        normal_grain2_x[i] = tris[i].normal_grain2_x;
+        normal_grain2_y[i] = tris[i].normal_grain2_y;
+        normal_grain2_z[i] = tris[i].normal_grain2_z;
+      }
+    }
+
+    int32_t size() const { return area.size(); }
+
+    void buildIndex(NormalSphereGrid& grid) const
+    {
+      int32_t numTris = size();
+      QVector<float> x(4 * numTris);
+      QVector<float> y(4 * numTris);
+      QVector<float> z(4 * numTris);
+      for (int32_t i = 0; i < numTris; i++)
+      {
+        x[4 * i] = normal_grain1_x[i];
+        y[4 * i] = normal_grain1_y[i];
+        z[4 * i] = normal_grain1_z[i];
+        x[4 * i + 1] = -normal_grain1_x[i];
+        y[4 * i + 1] = -normal_grain1_y[i];
+        z[4 * i + 1] = -normal_grain1_z[i];
+        x[4 * i + 2] = normal_grain2_x[i];
+        y[4 * i + 2] = normal_grain2_y[i];
+        z[4 * i + 2] = normal_grain2_z[i];
+        x[4 * i + 3] = -normal_grain2_x[i];
+        y[4 * i + 3] = -normal_grain2_y[i];
+        z[4 * i + 3] = -normal_grain2_z[i];
+      }
+      grid.build(x.data(), y.data(), z.data(), x.size());
+    }
+};
+
 /**
  * @brief The TrisSelector class implements a threaded algorithm that determines which triangles to
  * include in the GBPD calculation
@@ -129,6 +197,7 @@ class TrisSelector
     QVector<SpaceGroupOps::Pointer> m_OrientationOps;
     uint32_t cryst;
     int32_t nsym;
+    QVector<float> symOps;
     uint32_t* m_CrystalStructures;
     float* m_Eulers;
     int32_t* m_Phases;
@@ -254,11 +323,8 @@ class ProbeDistrib
     QVector<float>* samplPtsX;
     QVector<float>* samplPtsY;
     QVector<float>* samplPtsZ;
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
-#else
-    QVector<TriAreaAndNormals> selectedTris;
-#endif
+    const SelectedTrisArrays& selectedTris;
+    const NormalSphereGrid& normalsGrid;
     float limitDist;
     double totalFaceArea;
     int numDistinctGBs;
@@ -274,11 +340,8 @@ class ProbeDistrib
         QVector<float> *__samplPtsX,
         QVector<float> *__samplPtsY,
         QVector<float> *__samplPtsZ,
-    #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-        tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
-    #else
-        QVector<TriAreaAndNormals> __selectedTris,
-    #endif
+        const SelectedTrisArrays& __selectedTris,
+        const NormalSphereGrid& __normalsGrid,
         float __limitDist,
         double __totalFaceArea,
         int __numDistinctGBs,
@@ -291,6 +354,7 @@ class ProbeDistrib
       samplPtsY(__samplPtsY),
       samplPtsZ(__samplPtsZ),
       selectedTris(__selectedTris),
+      normalsGrid(__normalsGrid),
       limitDist(__limitDist),
       totalFaceArea(__totalFaceArea),
       numDistinctGBs(__numDistinctGBs),
@@ -299,6 +363,13 @@ class ProbeDistrib
     {
       m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
       nsym = m_OrientationOps[__cryst]->getNumSymOps();
+      symOps.resize(nsym * 9);
+      for (int j = 0; j < nsym; j++)
+      {
+        float sym[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+        m_OrientationOps[cryst]->getMatSymOp(j, sym);
+        for (int k = 0; k < 9; k++) { symOps[j * 9 + k] = sym[k / 3][k % 3]; }
+      }
     }
 
     virtual ~ProbeDistrib() {}
@@ -311,57 +382,57 @@ class ProbeDistrib
 
         float probeNormal[3] = { (*samplPtsX).at(ptIdx), (*samplPtsY).at(ptIdx), (*samplPtsZ).at(ptIdx) };
 
-        for (int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+        for (int j = 0; j < nsym; j++)
         {
-          float normal1[3] = {
-            selectedTris[triRepresIdx].normal_grain1_x,
-            selectedTris[triRepresIdx].normal_grain1_y,
-            selectedTris[triRepresIdx].normal_grain1_z };
-
-          float normal2[3] = {
-            selectedTris[triRepresIdx].normal_grain2_x,
-            selectedTris[triRepresIdx].normal_grain2_y,
-            selectedTris[triRepresIdx].normal_grain2_z };
-
           float sym[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+          for (int k = 0; k < 9; k++) { sym[k / 3][k % 3] = symOps[j * 9 + k]; }
 
-          for (int j = 0; j < nsym; j++)
+          // The angle between the probe and sym * n equals the angle between transpose(sym) * probe
+          // and n, so the unsymmetrized normals can be looked up in the grid
+          float symProbe[3] = { 0.0f, 0.0f, 0.0f };
+          for (int k = 0; k < 3; k++)
           {
-            m_OrientationOps[cryst]->getMatSymOp(j, sym);
-
-            float sym_normal1[3] = { 0.0f, 0.0f, 0.0f };
-            float sym_normal2[3] = { 0.0f, 0.0f, 0.0f };
+            symProbe[k] = sym[0][k] * probeNormal[0] + sym[1][k] * probeNormal[1] + sym[2][k] * probeNormal[2];
+          }
 
-            MatrixMath::Multiply3x3with3x1(sym, normal1, sym_normal1);
-            MatrixMath::Multiply3x3with3x1(sym, normal2, sym_normal2);
+          size_t cells[NormalSphereGrid::MaxNeighborCells];
+          size_t numCells = normalsGrid.getNeighborCells(symProbe, cells);
 
-            for (int inversion = 0; inversion <= 1; inversion++)
+          for (size_t c = 0; c < numCells; c++)
+          {
+            for (size_t pos = normalsGrid.getCellBegin(cells[c]); pos < normalsGrid.getCellEnd(cells[c]); pos++)
             {
+              size_t entry = normalsGrid.getItem(pos);
+              int32_t triRepresIdx = static_cast<int32_t>(entry / 4);
               float sign = 1.0f;
-              if (inversion == 1) sign = -1.0f;
+              if (entry % 2 == 1) sign = -1.0f;
+
+              float normal[3] = { 0.0f, 0.0f, 0.0f };
+              if ((entry / 2) % 2 == 0)
+              {
+                normal[0] = selectedTris.normal_grain1_x[triRepresIdx];
+                normal[1] = selectedTris.normal_grain1_y[triRepresIdx];
+                normal[2] = selectedTris.normal_grain1_z[triRepresIdx];
+              }
+              else
+              {
+                normal[0] = selectedTris.normal_grain2_x[triRepresIdx];
+                normal[1] = selectedTris.normal_grain2_y[triRepresIdx];
+                normal[2] = selectedTris.normal_grain2_z[triRepresIdx];
+              }
 
-              float gamma1 = acosf(sign * (
-                                     probeNormal[0] * sym_normal1[0] +
-                                     probeNormal[1] * sym_normal1[1] +
-                                     probeNormal[2] * sym_normal1[2]));
+              float sym_normal[3] = { 0.0f, 0.0f, 0.0f };
+              MatrixMath::Multiply3x3with3x1(sym, normal, sym_normal);
 
-              float gamma2 = acosf(sign * (
-                                     probeNormal[0] * sym_normal2[0] +
-                                     probeNormal[1] * sym_normal2[1] +
-                                     probeNormal[2] * sym_normal2[2]));
+              float gamma = acosf(sign * (
+                                    probeNormal[0] * sym_normal[0] +
+                                    probeNormal[1] * sym_normal[1] +
+                                    probeNormal[2] * sym_normal[2]));
 
-              if (gamma1 < limitDist)
+              if (gamma < limitDist)
               {
                 // Kahan summation algorithm
-                double __y = selectedTris[triRepresIdx].area - __c;
-                double __t = (*distribValues)[ptIdx] + __y;
-                __c = (__t - (*distribValues)[ptIdx]);
-                __c -=__y;
-                (*distribValues)[ptIdx] = __t;
-              }
-              if (gamma2 < limitDist)
-              {
-                double __y = selectedTris[triRepresIdx].area - __c;
+                double __y = selectedTris.area[triRepresIdx] - __c;
                 double __t = (*distribValues)[ptIdx] + __y;
                 __c = (__t - (*distribValues)[ptIdx]);
                 __c -= __y;
@@ -1082,6 +1153,14 @@ void FindGBPDMetricBased::execute()
   double totalFaceArea = 0.0;
   for (int i = 0; i < static_cast<int>(selectedTris.size()); i++) { totalFaceArea += selectedTris.at(i).area; }
 
+  // Flatten the selected triangles and index their normals on the unit sphere so that each
+  // sampling point only visits the normals that can be within the limiting distance
+  SelectedTrisArrays selectedTrisArrays;
+  selectedTrisArrays.assign(selectedTris);
+  selectedTris.clear();
+  NormalSphereGrid normalsGrid(m_LimitDist);
+  selectedTrisArrays.buildIndex(normalsGrid);
+
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
@@ -1108,7 +1187,8 @@ void FindGBPDMetricBased::execute()
         &samplPtsX,
         &samplPtsY,
         &samplPtsZ,
-        selectedTris,
+        selectedTrisArrays,
+        normalsGrid,
         m_LimitDist,
         totalFaceArea,
         numDistinctGBs,
@@ -1125,7 +1205,8 @@ void FindGBPDMetricBased::execute()
         &samplPtsX,
         &samplPtsY,
         &samplPtsZ,
-        selectedTris,
+        selectedTrisArrays,
+        normalsGrid,
         m_LimitDist,
         totalFaceArea,
         numDistinctGBs,
@@ -36,6 +36,8 @@
 
 #include "FindNRingNeighbors.h"
 
+#include <algorithm>
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -81,9 +83,6 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
   int64_t* triangles = triangleGeom->getTriPointer(0);
   int32_t err = 0;
 
-  //Clear out all the previous triangles.
-  m_NRingTriangles.clear();
-
   // Make sure we have the proper connectivity built
   ElementDynamicList::Pointer node2TrianglePtr = triangleGeom->getElementsContainingVert();
   if (node2TrianglePtr.get() == NULL)
@@ -96,6 +95,19 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
     node2TrianglePtr = triangleGeom->getElementsContainingVert();
   }
 
+  return generate(triangles, node2TrianglePtr.get(), faceLabels);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t FindNRingNeighbors::generate(const int64_t* triangles, ElementDynamicList* node2Triangle, const int32_t* faceLabels)
+{
+  int32_t err = 0;
+
+  //Clear out all the previous triangles.
+  m_NRingTriangles.clear();
+
   // Figure out these boolean values for a sanity check
   bool check0 = faceLabels[m_TriangleId * 2] == m_RegionId0 && faceLabels[m_TriangleId * 2 + 1] == m_RegionId1;
   bool check1 = faceLabels[m_TriangleId * 2 + 1] == m_RegionId0 && faceLabels[m_TriangleId * 2] == m_RegionId1;
@@ -110,26 +122,23 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
 #endif
 
   // Add our seed triangle
-  m_NRingTriangles.insert(m_TriangleId);
+  m_NRingTriangles.push_back(m_TriangleId);
 
   for (int64_t ring = 0; ring < m_Ring; ++ring)
   {
-    // Make a copy of the 1 Ring Triangles that we just found so that we can use those triangles as the
-    // seed triangles for the 2 Ring triangles
-    UniqueFaceIds_t lcvTriangles(m_NRingTriangles);
-
-    // Now that we have the 1 ring triangles, get the 2 Ring neighbors from that list
-    for (UniqueFaceIds_t::iterator triIter = lcvTriangles.begin(); triIter != lcvTriangles.end(); ++triIter)
+    // The triangles found so far are the seed triangles for the next ring; the
+    // neighbors are appended behind them and the list is made unique afterwards
+    size_t numSeeds = m_NRingTriangles.size();
+    for (size_t s = 0; s < numSeeds; ++s)
     {
-      int64_t triangleIdx = *triIter;
+      int64_t triangleIdx = m_NRingTriangles[s];
       // For each node, get the triangle ids that the node belongs to
       for(int32_t i = 0; i < 3; ++i)
       {
         // Get all the triangles for this Node id
-        uint16_t tCount = node2TrianglePtr->getNumberOfElements(triangles[triangleIdx * 3 + i]);
-        int64_t* data = node2TrianglePtr->getElementListPointer(triangles[triangleIdx * 3 + i]);
+        uint16_t tCount = node2Triangle->getNumberOfElements(triangles[triangleIdx * 3 + i]);
+        int64_t* data = node2Triangle->getElementListPointer(triangles[triangleIdx * 3 + i]);
 
-        // Copy all the triangles into our "2Ring" set which will be the unique set of triangle ids
         for (uint16_t t = 0; t < tCount; ++t)
         {
           int64_t tid = data[t];
@@ -137,11 +146,13 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
           check1 = faceLabels[tid * 2 + 1] == m_RegionId0 && faceLabels[tid * 2] == m_RegionId1;
           if (check0 == true || check1 == true)
           {
-            m_NRingTriangles.insert(tid);
+            m_NRingTriangles.push_back(tid);
           }
         }
       }
     }
+    std::sort(m_NRingTriangles.begin(), m_NRingTriangles.end());
+    m_NRingTriangles.erase(std::unique(m_NRingTriangles.begin(), m_NRingTriangles.end()), m_NRingTriangles.end());
   }
   return err;
 }
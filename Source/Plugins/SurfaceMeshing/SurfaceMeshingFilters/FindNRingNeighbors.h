@@ -37,7 +37,7 @@
 #ifndef _findnringneighbors_h_
 #define _findnringneighbors_h_
 
-#include <set>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
@@ -55,7 +55,12 @@ class FindNRingNeighbors
 
     virtual ~FindNRingNeighbors();
 
-    typedef std::set<int64_t> UniqueFaceIds_t;
+    /**
+     * @brief The N ring triangles are kept as a sorted list of unique triangle ids. The
+     * list keeps its storage between calls to generate() so that a FindNRingNeighbors
+     * object that is reused for many seed triangles does not allocate per triangle.
+     */
+    typedef std::vector<int64_t> UniqueFaceIds_t;
 
     SIMPL_INSTANCE_PROPERTY(int64_t, TriangleId)
 
@@ -95,6 +100,16 @@ class FindNRingNeighbors
      */
     int32_t generate(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels);
 
+    /**
+     * @brief generate Generates the N rings from the raw triangle list and the
+     * vertex to triangle connectivity, which must already have been built
+     * @param triangles Triangle list of the TriangleGeom
+     * @param node2Triangle Triangles containing each vertex
+     * @param faceLabels Feature Id labels for the TriangleGeom
+     * @return Integer error value
+     */
+    int32_t generate(const int64_t* triangles, ElementDynamicList* node2Triangle, const int32_t* faceLabels);
+
     SIMPL_INSTANCE_PROPERTY(bool, WriteBinaryFile)
     SIMPL_INSTANCE_PROPERTY(bool, WriteConformalMesh)
 
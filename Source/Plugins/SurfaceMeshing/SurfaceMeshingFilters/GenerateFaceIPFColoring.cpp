@@ -62,6 +62,7 @@
 #include "OrientationLib/SpaceGroupOps/TriclinicOps.h"
 #include "OrientationLib/SpaceGroupOps/TrigonalLowOps.h"
 #include "OrientationLib/SpaceGroupOps/TrigonalOps.h"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 
@@ -94,23 +95,9 @@ class CalculateFaceIPFColorsImpl
 
     void generate(size_t start, size_t end) const
     {
-      // Create 1 of every type of Ops class. This condenses the code below
-      QVector<SpaceGroupOps::Pointer> ops;
-      ops.push_back(HexagonalOps::New());
-      ops.push_back(CubicOps::New());
-      ops.push_back(HexagonalLowOps::New());
-      ops.push_back(CubicLowOps::New());
-      ops.push_back(TriclinicOps::New());
-      ops.push_back(MonoclinicOps::New());
-      ops.push_back(OrthoRhombicOps::New());
-      ops.push_back(TetragonalLowOps::New());
-      ops.push_back(TetragonalOps::New());
-      ops.push_back(TrigonalLowOps::New());
-      ops.push_back(TrigonalOps::New());
-
-      double refDir[3] = {0.0, 0.0, 0.0};
-      double dEuler[3] = {0.0, 0.0, 0.0};
-      SIMPL::Rgb argb = 0x00000000;
+      // The colors are computed in batches of faces that share a Laue class
+      LaueIPFColorBatch batch;
+      float refDir[3] = {0.0f, 0.0f, 0.0f};
 
       int32_t feature1 = 0, feature2 = 0, phase1 = 0, phase2 = 0;
       for (size_t i = start; i < end; i++)
@@ -128,17 +115,10 @@ class CalculateFaceIPFColorsImpl
           // Make sure we are using a valid Euler Angles with valid crystal symmetry
           if (m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
           {
-            dEuler[0] = m_Eulers[3 * feature1 + 0];
-            dEuler[1] = m_Eulers[3 * feature1 + 1];
-            dEuler[2] = m_Eulers[3 * feature1 + 2];
-            refDir[0] = m_Normals[3 * i + 0];
-            refDir[1] = m_Normals[3 * i + 1];
-            refDir[2] = m_Normals[3 * i + 2];
-
-            argb = ops[m_CrystalStructures[phase1]]->generateIPFColor(dEuler, refDir, false);
-            m_Colors[6 * i] = RgbColor::dRed(argb);
-            m_Colors[6 * i + 1] = RgbColor::dGreen(argb);
-            m_Colors[6 * i + 2] = RgbColor::dBlue(argb);
+            refDir[0] = static_cast<float>(m_Normals[3 * i + 0]);
+            refDir[1] = static_cast<float>(m_Normals[3 * i + 1]);
+            refDir[2] = static_cast<float>(m_Normals[3 * i + 2]);
+            batch.add(m_CrystalStructures[phase1], m_Eulers + 3 * feature1, refDir, m_Colors + 6 * i);
           }
         }
         else // Phase 1 was Zero so assign a black color
@@ -155,17 +135,10 @@ class CalculateFaceIPFColorsImpl
           // Make sure we are using a valid Euler Angles with valid crystal symmetry
           if (m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
           {
-            dEuler[0] = m_Eulers[3 * feature2 + 0];
-            dEuler[1] = m_Eulers[3 * feature2 + 1];
-            dEuler[2] = m_Eulers[3 * feature2 + 2];
-            refDir[0] = -m_Normals[3 * i + 0];
-            refDir[1] = -m_Normals[3 * i + 1];
-            refDir[2] = -m_Normals[3 * i + 2];
-
-            argb = ops[m_CrystalStructures[phase1]]->generateIPFColor(dEuler, refDir, false);
-            m_Colors[6 * i + 3] = RgbColor::dRed(argb);
-            m_Colors[6 * i + 4] = RgbColor::dGreen(argb);
-            m_Colors[6 * i + 5] = RgbColor::dBlue(argb);
+            refDir[0] = static_cast<float>(-m_Normals[3 * i + 0]);
+            refDir[1] = static_cast<float>(-m_Normals[3 * i + 1]);
+            refDir[2] = static_cast<float>(-m_Normals[3 * i + 2]);
+            batch.add(m_CrystalStructures[phase1], m_Eulers + 3 * feature2, refDir, m_Colors + 6 * i + 3);
           }
         }
         else
@@ -175,6 +148,7 @@ class CalculateFaceIPFColorsImpl
           m_Colors[6 * i + 5] = 0;
         }
       }
+      batch.flush();
     }
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
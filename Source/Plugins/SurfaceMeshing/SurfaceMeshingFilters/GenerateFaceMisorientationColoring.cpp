@@ -58,6 +58,7 @@
 #include "OrientationLib/SpaceGroupOps/OrthoRhombicOps.h"
 #include "OrientationLib/SpaceGroupOps/TetragonalOps.h"
 #include "OrientationLib/SpaceGroupOps/TrigonalOps.h"
+#include "OrientationLib/SpaceGroupOps/LaueOps.hpp"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 
@@ -75,7 +76,6 @@ class CalculateFaceMisorientationColorsImpl
     float* m_Quats;
     float* m_Colors;
     unsigned int* m_CrystalStructures;
-    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
 
   public:
     CalculateFaceMisorientationColorsImpl(int32_t* labels, int32_t* phases, float* quats, float* colors, unsigned int* crystalStructures) :
@@ -84,9 +84,7 @@ class CalculateFaceMisorientationColorsImpl
       m_Quats(quats),
       m_Colors(colors),
       m_CrystalStructures(crystalStructures)
-    {
-      m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
-    }
+    {}
     virtual ~CalculateFaceMisorientationColorsImpl() {}
 
     void generate(size_t start, size_t end) const
@@ -112,7 +110,7 @@ class CalculateFaceMisorientationColorsImpl
           {
             QuaternionMathF::Copy(quats[feature1], q1);
             QuaternionMathF::Copy(quats[feature2], q2);
-            w = m_OrientationOps[m_CrystalStructures[phase1]]->getMisoQuat(q1, q2, n1, n2, n3);
+            w = LaueOps<Ebsd::CrystalStructure::Cubic_High>::getMisoQuat(q1, q2, n1, n2, n3);
             w = w * radToDeg;
             m_Colors[3 * i + 0] = w * n1;
             m_Colors[3 * i + 1] = w * n2;
@@ -122,7 +120,7 @@ class CalculateFaceMisorientationColorsImpl
           {
             QuaternionMathF::Copy(quats[feature1], q1);
             QuaternionMathF::Copy(quats[feature2], q2);
-            w = m_OrientationOps[m_CrystalStructures[phase1]]->getMisoQuat(q1, q2, n1, n2, n3);
+            w = LaueOps<Ebsd::CrystalStructure::Hexagonal_High>::getMisoQuat(q1, q2, n1, n2, n3);
             w = w * radToDeg;
             m_Colors[3 * i + 0] = w * n1;
             m_Colors[3 * i + 1] = w * n2;
@@ -35,6 +35,15 @@
 
 #include "QuickSurfaceMesh.h"
 
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/TemplateHelpers.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -182,6 +191,416 @@ void copyCellArraysToFaceArrays(size_t faceIndex, size_t firstCellIndex, size_t
   if (!forceSecondToZero) { ::memcpy(faceTuplePtr + numComps, secondCellTuplePtr, sizeof(T) * numComps); }
 }
 
+typedef void (*CopyCellArraysToFaceArraysFunction)(size_t, size_t, size_t, IDataArray::Pointer, IDataArray::Pointer, bool);
+
+/**
+ * @brief getCopyCellArraysToFaceArraysFunction Picks the instantiation of copyCellArraysToFaceArrays
+ * that matches the type of a cell array, so the type is resolved once on the calling thread
+ * instead of once per face inside the worker threads
+ * @return The function, or NULL if the array type is not supported
+ */
+CopyCellArraysToFaceArraysFunction getCopyCellArraysToFaceArraysFunction(IDataArray::Pointer cellArray)
+{
+  if (TemplateHelpers::CanDynamicCast<FloatArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<float>; }
+  if (TemplateHelpers::CanDynamicCast<DoubleArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<double>; }
+  if (TemplateHelpers::CanDynamicCast<Int8ArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<int8_t>; }
+  if (TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<uint8_t>; }
+  if (TemplateHelpers::CanDynamicCast<Int16ArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<int16_t>; }
+  if (TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<uint16_t>; }
+  if (TemplateHelpers::CanDynamicCast<Int32ArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<int32_t>; }
+  if (TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<uint32_t>; }
+  if (TemplateHelpers::CanDynamicCast<Int64ArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<int64_t>; }
+  if (TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<uint64_t>; }
+  if (TemplateHelpers::CanDynamicCast<BoolArrayType>()(cellArray)) { return copyCellArraysToFaceArrays<bool>; }
+  return NULL;
+}
+
+namespace QSMFaces
+{
+  /**
+   * @brief The faces a single voxel can contribute to the mesh, listed in the
+   * order the voxel sweep emits them. Boundary faces sit on the outside of the
+   * volume and are owned by the voxel and "-1"; internal faces are only emitted
+   * on the +x, +y and +z side of a voxel whose neighbor has a different Feature Id.
+   */
+  enum FaceType
+  {
+    XMin = 0,
+    YMin,
+    ZMin,
+    XMax,
+    XInternal,
+    YMax,
+    YInternal,
+    ZMax,
+    ZInternal
+  };
+
+  /**
+   * @brief Node offsets (di, dj, dk) from the voxel's lower corner for the four
+   * nodes of each face type
+   */
+  static const int32_t Corners[9][4][3] =
+  {
+    { { 0, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 0, 1, 1 } },
+    { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 0, 1 }, { 1, 0, 1 } },
+    { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 } },
+    { { 1, 0, 0 }, { 1, 1, 0 }, { 1, 0, 1 }, { 1, 1, 1 } },
+    { { 1, 0, 0 }, { 1, 1, 0 }, { 1, 0, 1 }, { 1, 1, 1 } },
+    { { 1, 1, 0 }, { 0, 1, 0 }, { 1, 1, 1 }, { 0, 1, 1 } },
+    { { 1, 1, 0 }, { 0, 1, 0 }, { 1, 1, 1 }, { 0, 1, 1 } },
+    { { 1, 0, 1 }, { 0, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } },
+    { { 1, 0, 1 }, { 0, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } }
+  };
+
+  /**
+   * @brief Face corners making up the two triangles of each face type
+   */
+  static const int32_t Triangles[9][6] =
+  {
+    { 0, 1, 2, 1, 3, 2 },
+    { 0, 2, 1, 1, 2, 3 },
+    { 0, 1, 2, 1, 3, 2 },
+    { 2, 1, 0, 2, 3, 1 },
+    { 0, 1, 2, 1, 3, 2 },
+    { 2, 1, 0, 2, 3, 1 },
+    { 0, 1, 2, 1, 3, 2 },
+    { 1, 2, 0, 3, 2, 1 },
+    { 0, 2, 1, 1, 2, 3 }
+  };
+
+  /**
+   * @brief Collects the Feature Ids that touch a node in a fixed inline array.
+   * A node touches at most 8 voxels, and a boundary node at most 4 voxels plus
+   * the outside "-1", so 8 entries are always enough.
+   */
+  struct NodeOwners
+  {
+    int32_t owners[8];
+    int32_t count;
+
+    inline void insert(int32_t featureId)
+    {
+      for (int32_t n = 0; n < count; n++)
+      {
+        if (owners[n] == featureId) { return; }
+      }
+      if (count < 8) { owners[count++] = featureId; }
+    }
+
+    inline int8_t nodeType() const
+    {
+      int8_t type = static_cast<int8_t>(count > 4 ? 4 : count);
+      for (int32_t n = 0; n < count; n++)
+      {
+        if (owners[n] == -1) { type += 10; break; }
+      }
+      return type;
+    }
+  };
+}
+
+/**
+ * @brief The QuickSurfaceMeshGrid class holds the voxel grid being meshed and
+ * enumerates the faces of each voxel. Nodes are numbered plane by plane: a node
+ * plane kz holds the (xP+1)*(yP+1) nodes at z index kz and is touched only by
+ * the voxel slabs kz-1 and kz, so every pass below only ever needs two planes of
+ * node data in memory instead of the full (xP+1)*(yP+1)*(zP+1) lattice.
+ */
+class QuickSurfaceMeshGrid
+{
+  public:
+    QuickSurfaceMeshGrid(int32_t* featureIds, int64_t xP, int64_t yP, int64_t zP) :
+      m_FeatureIds(featureIds),
+      m_XP(xP),
+      m_YP(yP),
+      m_ZP(zP)
+    {}
+    virtual ~QuickSurfaceMeshGrid() {}
+
+    int64_t getPlaneSize() const { return (m_XP + 1) * (m_YP + 1); }
+
+    /**
+     * @brief getVoxelFaces Fills the face types and the opposite voxel (-1 for the
+     * outside of the volume) of every face voxel (i, j, k) contributes
+     * @return The number of faces
+     */
+    inline int32_t getVoxelFaces(int64_t i, int64_t j, int64_t k, int32_t* faceTypes, int64_t* neighbors) const
+    {
+      int64_t point = (k * m_XP * m_YP) + (j * m_XP) + i;
+      int32_t count = 0;
+      if (i == 0) { faceTypes[count] = QSMFaces::XMin; neighbors[count++] = -1; }
+      if (j == 0) { faceTypes[count] = QSMFaces::YMin; neighbors[count++] = -1; }
+      if (k == 0) { faceTypes[count] = QSMFaces::ZMin; neighbors[count++] = -1; }
+      if (i == (m_XP - 1)) { faceTypes[count] = QSMFaces::XMax; neighbors[count++] = -1; }
+      else if (m_FeatureIds[point] != m_FeatureIds[point + 1]) { faceTypes[count] = QSMFaces::XInternal; neighbors[count++] = point + 1; }
+      if (j == (m_YP - 1)) { faceTypes[count] = QSMFaces::YMax; neighbors[count++] = -1; }
+      else if (m_FeatureIds[point] != m_FeatureIds[point + m_XP]) { faceTypes[count] = QSMFaces::YInternal; neighbors[count++] = point + m_XP; }
+      if (k == (m_ZP - 1)) { faceTypes[count] = QSMFaces::ZMax; neighbors[count++] = -1; }
+      else if (m_FeatureIds[point] != m_FeatureIds[point + (m_XP * m_YP)]) { faceTypes[count] = QSMFaces::ZInternal; neighbors[count++] = point + (m_XP * m_YP); }
+      return count;
+    }
+
+    /**
+     * @brief markSlab Visits every face of voxel slab k. Nodes of the faces that lie
+     * in node plane k are flagged in lower and nodes in plane k+1 in upper; either
+     * may be NULL. When owners is non-NULL the Feature Ids on both sides of each face
+     * are recorded for the nodes in plane k (ownerDk == 0) or k+1 (ownerDk == 1).
+     * @return The number of triangles the slab contributes
+     */
+    template<typename T>
+    int64_t markSlab(int64_t k, T* lower, T* upper, QSMFaces::NodeOwners* owners, int32_t ownerDk) const
+    {
+      int32_t faceTypes[6] = { 0, 0, 0, 0, 0, 0 };
+      int64_t neighbors[6] = { 0, 0, 0, 0, 0, 0 };
+      int64_t triangleCount = 0;
+      for (int64_t j = 0; j < m_YP; j++)
+      {
+        for (int64_t i = 0; i < m_XP; i++)
+        {
+          int32_t numFaces = getVoxelFaces(i, j, k, faceTypes, neighbors);
+          triangleCount += 2 * numFaces;
+          for (int32_t f = 0; f < numFaces; f++)
+          {
+            int32_t owner1 = m_FeatureIds[(k * m_XP * m_YP) + (j * m_XP) + i];
+            int32_t owner2 = neighbors[f] < 0 ? -1 : m_FeatureIds[neighbors[f]];
+            for (int32_t c = 0; c < 4; c++)
+            {
+              const int32_t* corner = QSMFaces::Corners[faceTypes[f]][c];
+              int64_t node = ((j + corner[1]) * (m_XP + 1)) + (i + corner[0]);
+              T* mask = (corner[2] == 0) ? lower : upper;
+              if (NULL != mask) { mask[node] = 1; }
+              if (NULL != owners && corner[2] == ownerDk)
+              {
+                owners[node].insert(owner1);
+                owners[node].insert(owner2);
+              }
+            }
+          }
+        }
+      }
+      return triangleCount;
+    }
+
+  private:
+    int32_t* m_FeatureIds;
+    int64_t m_XP;
+    int64_t m_YP;
+    int64_t m_ZP;
+};
+
+/**
+ * @brief The QuickSurfaceMeshCountImpl class counts the triangles of each voxel
+ * slab and the nodes of each node plane so the emit pass can be given exclusive
+ * output ranges with a prefix sum.
+ */
+class QuickSurfaceMeshCountImpl
+{
+    QuickSurfaceMeshGrid* m_Grid;
+    int64_t m_ZP;
+    int64_t* m_SlabTriangles;
+    int64_t* m_PlaneNodes;
+
+  public:
+    QuickSurfaceMeshCountImpl(QuickSurfaceMeshGrid* grid, int64_t zP, int64_t* slabTriangles, int64_t* planeNodes) :
+      m_Grid(grid),
+      m_ZP(zP),
+      m_SlabTriangles(slabTriangles),
+      m_PlaneNodes(planeNodes)
+    {}
+    virtual ~QuickSurfaceMeshCountImpl() {}
+
+    void count(size_t start, size_t end) const
+    {
+      int64_t planeSize = m_Grid->getPlaneSize();
+      std::vector<uint8_t> lower(planeSize, 0);
+      std::vector<uint8_t> upper(planeSize, 0);
+      if (start > 0) { m_Grid->markSlab<uint8_t>(start - 1, NULL, &(upper.front()), NULL, -1); }
+      for (size_t k = start; k < end; k++)
+      {
+        lower.swap(upper);
+        std::fill(upper.begin(), upper.end(), 0);
+        m_SlabTriangles[k] = m_Grid->markSlab<uint8_t>(k, &(lower.front()), &(upper.front()), NULL, -1);
+        m_PlaneNodes[k] = std::count(lower.begin(), lower.end(), 1);
+      }
+      if (static_cast<int64_t>(end) == m_ZP) { m_PlaneNodes[m_ZP] = std::count(upper.begin(), upper.end(), 1); }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      count(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The QuickSurfaceMeshEmitImpl class writes the vertices, node types,
+ * triangles, face labels and transferred face arrays for a range of voxel slabs.
+ * It slides a window of two node planes through the range; each plane's node ids
+ * are its offset from the node prefix sum plus the rank of the node in the plane.
+ * A range writes the vertices of the planes [start, end), and the last range also
+ * writes the top plane, so no vertex is written by two threads. The copy functions of
+ * the transferred arrays are resolved beforehand, so nothing in here can fail.
+ */
+class QuickSurfaceMeshEmitImpl
+{
+    QuickSurfaceMeshGrid* m_Grid;
+    int32_t* m_FeatureIds;
+    int64_t m_XP;
+    int64_t m_YP;
+    int64_t m_ZP;
+    float m_Res[3];
+    float m_Origin[3];
+    int64_t* m_TriangleOffsets;
+    int64_t* m_NodeOffsets;
+    float* m_Vertex;
+    int64_t* m_Triangle;
+    int32_t* m_FaceLabels;
+    int8_t* m_NodeTypes;
+    std::vector<IDataArray::WeakPointer>& m_SelectedWeakPtrVector;
+    std::vector<IDataArray::WeakPointer>& m_CreatedWeakPtrVector;
+    const std::vector<CopyCellArraysToFaceArraysFunction>& m_CopyFunctions;
+
+  public:
+    QuickSurfaceMeshEmitImpl(QuickSurfaceMeshGrid* grid, int32_t* featureIds, int64_t dims[3], float res[3], float origin[3],
+                             int64_t* triangleOffsets, int64_t* nodeOffsets, float* vertex, int64_t* triangle, int32_t* faceLabels, int8_t* nodeTypes,
+                             std::vector<IDataArray::WeakPointer>& selectedArrays, std::vector<IDataArray::WeakPointer>& createdArrays,
+                             const std::vector<CopyCellArraysToFaceArraysFunction>& copyFunctions) :
+      m_Grid(grid),
+      m_FeatureIds(featureIds),
+      m_XP(dims[0]),
+      m_YP(dims[1]),
+      m_ZP(dims[2]),
+      m_TriangleOffsets(triangleOffsets),
+      m_NodeOffsets(nodeOffsets),
+      m_Vertex(vertex),
+      m_Triangle(triangle),
+      m_FaceLabels(faceLabels),
+      m_NodeTypes(nodeTypes),
+      m_SelectedWeakPtrVector(selectedArrays),
+      m_CreatedWeakPtrVector(createdArrays),
+      m_CopyFunctions(copyFunctions)
+    {
+      for (int32_t d = 0; d < 3; d++)
+      {
+        m_Res[d] = res[d];
+        m_Origin[d] = origin[d];
+      }
+    }
+    virtual ~QuickSurfaceMeshEmitImpl() {}
+
+    /**
+     * @brief buildPlane Fills nodeIds with the global id of every used node in
+     * node plane kz (-1 for unused nodes). If writeVertices is true the vertex
+     * coordinates and node types of the plane are written as well.
+     */
+    void buildPlane(int64_t kz, std::vector<int64_t>& nodeIds, std::vector<QSMFaces::NodeOwners>& owners, bool writeVertices) const
+    {
+      std::fill(nodeIds.begin(), nodeIds.end(), -1);
+      QSMFaces::NodeOwners* ownersPtr = NULL;
+      if (writeVertices)
+      {
+        QSMFaces::NodeOwners empty;
+        empty.count = 0;
+        std::fill(owners.begin(), owners.end(), empty);
+        ownersPtr = &(owners.front());
+      }
+      if (kz > 0) { m_Grid->markSlab<int64_t>(kz - 1, NULL, &(nodeIds.front()), ownersPtr, 1); }
+      if (kz < m_ZP) { m_Grid->markSlab<int64_t>(kz, &(nodeIds.front()), NULL, ownersPtr, 0); }
+
+      int64_t nodeId = m_NodeOffsets[kz];
+      for (int64_t j = 0; j <= m_YP; j++)
+      {
+        for (int64_t i = 0; i <= m_XP; i++)
+        {
+          int64_t node = (j * (m_XP + 1)) + i;
+          if (nodeIds[node] == -1) { continue; }
+          nodeIds[node] = nodeId;
+          if (writeVertices)
+          {
+            QSM_GETCOORD(i, m_Res[0], m_Vertex[nodeId * 3 + 0], m_Origin[0]);
+            QSM_GETCOORD(j, m_Res[1], m_Vertex[nodeId * 3 + 1], m_Origin[1]);
+            QSM_GETCOORD(kz, m_Res[2], m_Vertex[nodeId * 3 + 2], m_Origin[2]);
+            m_NodeTypes[nodeId] = owners[node].nodeType();
+          }
+          nodeId++;
+        }
+      }
+    }
+
+    void generate(size_t start, size_t end) const
+    {
+      int64_t planeSize = m_Grid->getPlaneSize();
+      std::vector<int64_t> lower(planeSize, -1);
+      std::vector<int64_t> upper(planeSize, -1);
+      std::vector<QSMFaces::NodeOwners> owners(planeSize);
+      int32_t faceTypes[6] = { 0, 0, 0, 0, 0, 0 };
+      int64_t neighbors[6] = { 0, 0, 0, 0, 0, 0 };
+      int64_t faceNodes[4] = { 0, 0, 0, 0 };
+
+      buildPlane(start, upper, owners, true);
+      for (size_t k = start; k < end; k++)
+      {
+        lower.swap(upper);
+        bool writeUpper = (static_cast<int64_t>(k) + 1 == m_ZP);
+        buildPlane(k + 1, upper, owners, writeUpper || (k + 1 < end));
+
+        int64_t triangleIndex = m_TriangleOffsets[k];
+        for (int64_t j = 0; j < m_YP; j++)
+        {
+          for (int64_t i = 0; i < m_XP; i++)
+          {
+            int64_t point = (k * m_XP * m_YP) + (j * m_XP) + i;
+            int32_t numFaces = m_Grid->getVoxelFaces(i, j, k, faceTypes, neighbors);
+            for (int32_t f = 0; f < numFaces; f++)
+            {
+              for (int32_t c = 0; c < 4; c++)
+              {
+                const int32_t* corner = QSMFaces::Corners[faceTypes[f]][c];
+                int64_t node = ((j + corner[1]) * (m_XP + 1)) + (i + corner[0]);
+                faceNodes[c] = (corner[2] == 0) ? lower[node] : upper[node];
+              }
+              const int32_t* tris = QSMFaces::Triangles[faceTypes[f]];
+              for (int32_t t = 0; t < 2; t++)
+              {
+                m_Triangle[triangleIndex * 3 + 0] = faceNodes[tris[t * 3 + 0]];
+                m_Triangle[triangleIndex * 3 + 1] = faceNodes[tris[t * 3 + 1]];
+                m_Triangle[triangleIndex * 3 + 2] = faceNodes[tris[t * 3 + 2]];
+                if (neighbors[f] < 0)
+                {
+                  m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
+                  m_FaceLabels[triangleIndex * 2 + 1] = -1;
+                  for (size_t a = 0; a < m_SelectedWeakPtrVector.size(); a++)
+                  {
+                    m_CopyFunctions[a](triangleIndex, point, point, m_SelectedWeakPtrVector[a].lock(), m_CreatedWeakPtrVector[a].lock(), true);
+                  }
+                }
+                else
+                {
+                  m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neighbors[f]];
+                  m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+                  for (size_t a = 0; a < m_SelectedWeakPtrVector.size(); a++)
+                  {
+                    m_CopyFunctions[a](triangleIndex, neighbors[f], point, m_SelectedWeakPtrVector[a].lock(), m_CreatedWeakPtrVector[a].lock(), false);
+                  }
+                }
+                triangleIndex++;
+              }
+            }
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -315,8 +734,8 @@ void QuickSurfaceMesh::execute()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
   
-  float m_OriginX = 0.0f, m_OriginY = 0.0f, m_OriginZ = 0.0f;
-  m->getGeometryAs<ImageGeom>()->getOrigin(m_OriginX, m_OriginY, m_OriginZ);
+  float origin[3] = { 0.0f, 0.0f, 0.0f };
+  m->getGeometryAs<ImageGeom>()->getOrigin(origin);
   
   size_t udims[3] = { 0, 0, 0 };
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
@@ -331,300 +750,65 @@ void QuickSurfaceMesh::execute()
   int64_t xP = dims[0];
   int64_t yP = dims[1];
   int64_t zP = dims[2];
-  float xRes = m->getGeometryAs<ImageGeom>()->getXRes();
-  float yRes = m->getGeometryAs<ImageGeom>()->getYRes();
-  float zRes = m->getGeometryAs<ImageGeom>()->getZRes();
-  
-  std::vector<std::set<int32_t> > ownerLists;
-  
-  int64_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
-  std::vector<int64_t> m_NodeIds(possibleNumNodes, -1);
-  
-  int64_t nodeCount = 0;
-  int64_t triangleCount = 0;
-  
-  int64_t point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
-  
-  int64_t nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
-  
-  // first determining which nodes are actually boundary nodes and
-  // count number of nodes and triangles that will be created
-  for (int64_t k = 0; k < zP; k++)
+  float res[3] =
   {
-    for (int64_t j = 0; j < yP; j++)
+    m->getGeometryAs<ImageGeom>()->getXRes(),
+    m->getGeometryAs<ImageGeom>()->getYRes(),
+    m->getGeometryAs<ImageGeom>()->getZRes()
+  };
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Resolve the type of every transferred array up front, an unsupported type is reported
+  // here instead of from inside the worker threads
+  std::vector<CopyCellArraysToFaceArraysFunction> copyFunctions(m_SelectedWeakPtrVector.size(), NULL);
+  for (size_t a = 0; a < m_SelectedWeakPtrVector.size(); a++)
+  {
+    copyFunctions[a] = getCopyCellArraysToFaceArraysFunction(m_SelectedWeakPtrVector[a].lock());
+    if (NULL == copyFunctions[a])
     {
-      for (int64_t i = 0; i < xP; i++)
-      {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-        
-        if (i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if (j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if (k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if (i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if (m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if (j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if (m_FeatureIds[point] != m_FeatureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if (k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if (m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if (m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if (m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-      }
+      setErrorCondition(-11007);
+      QString ss = QObject::tr("The Attribute Array %1 is of an unsupported type").arg(m_SelectedWeakPtrVector[a].lock()->getName());
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
     }
   }
-  
+
+  QuickSurfaceMeshGrid grid(m_FeatureIds, xP, yP, zP);
+
+  // First pass: count the triangles of every voxel slab and the nodes of every node plane
+  std::vector<int64_t> slabTriangles(zP, 0);
+  std::vector<int64_t> planeNodes(zP + 1, 0);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, zP),
+                      QuickSurfaceMeshCountImpl(&grid, zP, &(slabTriangles.front()), &(planeNodes.front())), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    QuickSurfaceMeshCountImpl serial(&grid, zP, &(slabTriangles.front()), &(planeNodes.front()));
+    serial.count(0, zP);
+  }
+
+  // Turn the counts into the first triangle of each slab and the first node of each plane
+  std::vector<int64_t> triangleOffsets(zP + 1, 0);
+  std::vector<int64_t> nodeOffsets(zP + 2, 0);
+  for (int64_t k = 0; k < zP; k++)
+  {
+    triangleOffsets[k + 1] = triangleOffsets[k] + slabTriangles[k];
+  }
+  for (int64_t k = 0; k <= zP; k++)
+  {
+    nodeOffsets[k + 1] = nodeOffsets[k] + planeNodes[k];
+  }
+  int64_t triangleCount = triangleOffsets[zP];
+  int64_t nodeCount = nodeOffsets[zP + 1];
+
   // now create node and triangle arrays knowing the number that will be needed
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   triangleGeom->resizeTriList(triangleCount);
@@ -633,554 +817,30 @@ void QuickSurfaceMesh::execute()
   float* vertex = triangleGeom->getVertexPointer(0);
   int64_t* triangle = triangleGeom->getTriPointer(0);
   
-  
   QVector<size_t> tDims(1, nodeCount);
   sm->getAttributeMatrix(getVertexAttributeMatrixName())->resizeAttributeArrays(tDims);
   tDims[0] = triangleCount;
   sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
-  
   updateVertexInstancePointers();
   updateFaceInstancePointers();
-  
-  ownerLists.resize(nodeCount);
-  
-  // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  int64_t triangleIndex = 0;
-  for (int64_t k = 0; k < zP; k++)
+
+  // Second pass: each slab writes its triangles into its own range of the triangle list
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
   {
-    for (int64_t j = 0; j < yP; j++)
-    {
-      for (int64_t i = 0; i < xP; i++)
-      {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-        
-        if (i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if (j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-  
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if (k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-        
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if (i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if (m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock())
-          }
-          
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock())
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh1]);
-        }
-        if (j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if (m_FeatureIds[point] != m_FeatureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock())
-          }
-          
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock())
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh2]);
-        }
-        if (k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), true)
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if (m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId1] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId1] * 3 + 2], m_OriginZ);
-          
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2] * 3 + 0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId2] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId2] * 3 + 2], m_OriginZ);
-          
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          QSM_GETCOORD((i + 1), xRes, vertex[m_NodeIds[nodeId3] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId3] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId3] * 3 + 2], m_OriginZ);
-          
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId4] * 3 + 0], m_OriginX);
-          QSM_GETCOORD((j + 1), yRes, vertex[m_NodeIds[nodeId4] * 3 + 1], m_OriginY);
-          QSM_GETCOORD((k + 1), zRes, vertex[m_NodeIds[nodeId4] * 3 + 2], m_OriginZ);
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock())
-          }
-          
-          triangleIndex++;
-          
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          
-          for (int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock())
-          }
-          
-          triangleIndex++;
-          
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh3]);
-        }
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, zP),
+                      QuickSurfaceMeshEmitImpl(&grid, m_FeatureIds, dims, res, origin, &(triangleOffsets.front()), &(nodeOffsets.front()),
+                                               vertex, triangle, m_FaceLabels, m_NodeTypes, m_SelectedWeakPtrVector, m_CreatedWeakPtrVector, copyFunctions),
+                      tbb::auto_partitioner());
   }
-  
-  for (int64_t i = 0; i < nodeCount; i++)
+  else
+#endif
   {
-    m_NodeTypes[i] = ownerLists[i].size();
-    if (m_NodeTypes[i] > 4) { m_NodeTypes[i] = 4; }
-    if (ownerLists[i].find(-1) != ownerLists[i].end()) { m_NodeTypes[i] += 10; }
+    QuickSurfaceMeshEmitImpl serial(&grid, m_FeatureIds, dims, res, origin, &(triangleOffsets.front()), &(nodeOffsets.front()),
+                                    vertex, triangle, m_FaceLabels, m_NodeTypes, m_SelectedWeakPtrVector, m_CreatedWeakPtrVector, copyFunctions);
+    serial.generate(0, zP);
   }
-  
+
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
@@ -35,6 +35,12 @@
 
 #include "SharedFeatureFaceFilter.h"
 
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -44,6 +50,7 @@
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/FeatureFaceGrouping.h"
 
 // Include the MOC generated file for this class
 #include "moc_SharedFeatureFaceFilter.cpp"
@@ -200,66 +207,25 @@ void SharedFeatureFaceFilter::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t totalPoints = triangleGeom->getNumberOfTris();
 
-  QMap<uint64_t, int32_t> faceSizeMap;
-  QMap<uint64_t, int32_t> faceIdMap; // This maps a unique 64 bit integer to an increasing 32 bit integer
-  int32_t index = 1;
-  struct { int g; int r; } faceId;
-  uint64_t* faceId_64 = reinterpret_cast<uint64_t*>(&faceId);
-  int32_t fl0 = -1;
-  int32_t fl1 = -1;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+#endif
 
-  std::vector< std::pair<int32_t, int32_t> > faceLabelMap;
-  faceLabelMap.push_back( std::pair<int32_t, int32_t>(0, 0) );
-
-  // Loop through all the Triangles and figure out how many triangles we have in each one.
-  for (int64_t t = 0; t < totalPoints; ++t)
-  {
-    fl0 = m_SurfaceMeshFaceLabels[t * 2];
-    fl1 = m_SurfaceMeshFaceLabels[t * 2 + 1];
-    if (fl0 < fl1)
-    {
-      faceId.g = fl0;
-      faceId.r = fl1;
-    }
-    else
-    {
-      faceId.g = fl1;
-      faceId.r = fl0;
-    }
-
-    QMap<uint64_t, int32_t>::iterator iter = faceSizeMap.find(*faceId_64);
-    if (iter == faceSizeMap.end())
-    {
-      faceSizeMap[*faceId_64] = 1;
-      faceIdMap[*faceId_64] = index;
-      m_SurfaceMeshFeatureFaceIds[t] = index;
-      faceLabelMap.push_back( std::pair<int32_t, int32_t>(faceId.g, faceId.r) );
-      ++index;
-    }
-    else
-    {
-      iter.value()++;
-      m_SurfaceMeshFeatureFaceIds[t] = faceIdMap[*faceId_64];
-    }
-  }
+  // Group the triangles by their (unordered) label pair
+  FeatureFaceGrouping grouping;
+  grouping.execute(m_SurfaceMeshFaceLabels, totalPoints, m_SurfaceMeshFeatureFaceIds);
+  int32_t numFeatureFaces = grouping.getNumberOfFeatureFaces();
 
   // resize + update pointers
-  QVector<size_t> tDims(1, index);
+  QVector<size_t> tDims(1, numFeatureFaces);
   faceFeatureAttrMat->resizeAttributeArrays(tDims);
   m_SurfaceMeshFeatureFaceLabels = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getPointer(0);
   m_SurfaceMeshFeatureFaceNumTriangles = m_SurfaceMeshFeatureFaceNumTrianglesPtr.lock()->getPointer(0);
 
-  for (int32_t i = 0; i < index; i++)
-  {
-    // get feature face labels
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = faceLabelMap[i].first;
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = faceLabelMap[i].second;
-
-    // get feature triangle count
-    faceId.g = faceLabelMap[i].first;
-    faceId.r = faceLabelMap[i].second;
-    m_SurfaceMeshFeatureFaceNumTriangles[i] = faceSizeMap[*faceId_64];
-  }
+  const std::vector<int32_t>& featureFaceLabels = grouping.getFeatureFaceLabels();
+  const std::vector<int32_t>& numTriangles = grouping.getNumTriangles();
+  std::copy(featureFaceLabels.begin(), featureFaceLabels.end(), m_SurfaceMeshFeatureFaceLabels);
+  std::copy(numTriangles.begin(), numTriangles.end(), m_SurfaceMeshFeatureFaceNumTriangles);
 
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -0,0 +1,203 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _normalspheregrid_h_
+#define _normalspheregrid_h_
+
+#include <stddef.h>
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+/**
+ * @brief The NormalSphereGrid class is a spatial index over unit vectors. The vectors are
+ * binned into a uniform grid of cubic cells that covers [-1, 1]^3, where the edge of a cell
+ * is at least the chord length that corresponds to the largest angle of interest. Every
+ * vector within that angle of a query direction is therefore stored in one of the 27 cells
+ * around the cell of the query, so a probe only has to visit those cells instead of every
+ * vector. The vectors are stored cell by cell in one flat array (compressed row storage),
+ * and the grid is read only once it is built so it can be shared between threads.
+ */
+class NormalSphereGrid
+{
+  public:
+    /**
+     * @brief NormalSphereGrid
+     * @param maxAngle The largest angle (in radians) between a query and a vector that will be searched for
+     */
+    NormalSphereGrid(float maxAngle) :
+      m_Dims(1),
+      m_CellSize(2.0f)
+    {
+      if (maxAngle < 0.0f) { maxAngle = 0.0f; }
+      if (maxAngle < SIMPLib::Constants::k_Pi)
+      {
+        // Chord length between two unit vectors at maxAngle, padded so that rounding in the
+        // callers' own distance tests can never reject a vector the grid has skipped
+        float chord = 2.0f * sinf(0.5f * maxAngle);
+        chord = chord * 1.001f + 1.0E-5f;
+        float dims = floorf(2.0f / chord);
+        m_Dims = (dims < 1.0f) ? 1 : static_cast<size_t>(dims);
+        if (m_Dims > static_cast<size_t>(MaxCellsPerAxis)) { m_Dims = static_cast<size_t>(MaxCellsPerAxis); }
+        m_CellSize = 2.0f / static_cast<float>(m_Dims);
+      }
+      m_CellStarts.resize(m_Dims * m_Dims * m_Dims + 1, 0);
+    }
+
+    virtual ~NormalSphereGrid() {}
+
+    enum
+    {
+      MaxNeighborCells = 27,
+      MaxCellsPerAxis = 128
+    };
+
+    /**
+     * @brief build Bins the unit vectors into the grid. The index of each vector in the
+     * input arrays is what is stored in the cells.
+     * @param x X components of the vectors
+     * @param y Y components of the vectors
+     * @param z Z components of the vectors
+     * @param numVectors Number of vectors
+     */
+    void build(const float* x, const float* y, const float* z, size_t numVectors)
+    {
+      size_t numCells = m_Dims * m_Dims * m_Dims;
+      std::vector<size_t> cellOfVector(numVectors, 0);
+      std::fill(m_CellStarts.begin(), m_CellStarts.end(), 0);
+
+      // Count the vectors in each cell, then turn the counts into offsets
+      for (size_t i = 0; i < numVectors; i++)
+      {
+        size_t cell = (getCellCoordinate(z[i]) * m_Dims + getCellCoordinate(y[i])) * m_Dims + getCellCoordinate(x[i]);
+        cellOfVector[i] = cell;
+        m_CellStarts[cell + 1]++;
+      }
+      for (size_t c = 0; c < numCells; c++)
+      {
+        m_CellStarts[c + 1] += m_CellStarts[c];
+      }
+
+      // Scatter the vector indices, keeping the input order within each cell
+      m_Items.resize(numVectors);
+      std::vector<size_t> fill(m_CellStarts.begin(), m_CellStarts.end() - 1);
+      for (size_t i = 0; i < numVectors; i++)
+      {
+        m_Items[fill[cellOfVector[i]]++] = i;
+      }
+    }
+
+    /**
+     * @brief getNeighborCells Writes the cells that may hold vectors within the maximum
+     * angle of the query direction.
+     * @param query Unit query direction
+     * @param cells Output array of at least MaxNeighborCells entries
+     * @return Number of cells written
+     */
+    size_t getNeighborCells(const float query[3], size_t* cells) const
+    {
+      size_t cx = getCellCoordinate(query[0]);
+      size_t cy = getCellCoordinate(query[1]);
+      size_t cz = getCellCoordinate(query[2]);
+
+      size_t xMin = (cx > 0) ? cx - 1 : 0;
+      size_t yMin = (cy > 0) ? cy - 1 : 0;
+      size_t zMin = (cz > 0) ? cz - 1 : 0;
+      size_t xMax = (cx + 1 < m_Dims) ? cx + 1 : m_Dims - 1;
+      size_t yMax = (cy + 1 < m_Dims) ? cy + 1 : m_Dims - 1;
+      size_t zMax = (cz + 1 < m_Dims) ? cz + 1 : m_Dims - 1;
+
+      size_t count = 0;
+      for (size_t k = zMin; k <= zMax; k++)
+      {
+        for (size_t j = yMin; j <= yMax; j++)
+        {
+          for (size_t i = xMin; i <= xMax; i++)
+          {
+            size_t cell = (k * m_Dims + j) * m_Dims + i;
+            if (m_CellStarts[cell] != m_CellStarts[cell + 1])
+            {
+              cells[count] = cell;
+              count++;
+            }
+          }
+        }
+      }
+      return count;
+    }
+
+    /**
+     * @brief getCellBegin Returns the position in the item list of the first vector of a cell
+     */
+    inline size_t getCellBegin(size_t cell) const { return m_CellStarts[cell]; }
+
+    /**
+     * @brief getCellEnd Returns the position in the item list one past the last vector of a cell
+     */
+    inline size_t getCellEnd(size_t cell) const { return m_CellStarts[cell + 1]; }
+
+    /**
+     * @brief getItem Returns the index of the vector stored at a position of the item list
+     */
+    inline size_t getItem(size_t pos) const { return m_Items[pos]; }
+
+    /**
+     * @brief getNumberOfCellsPerAxis
+     */
+    size_t getNumberOfCellsPerAxis() const { return m_Dims; }
+
+  protected:
+    size_t getCellCoordinate(float value) const
+    {
+      float coord = floorf((value + 1.0f) / m_CellSize);
+      if (coord < 0.0f) { return 0; }
+      if (coord >= static_cast<float>(m_Dims)) { return m_Dims - 1; }
+      return static_cast<size_t>(coord);
+    }
+
+  private:
+    size_t m_Dims;
+    float m_CellSize;
+    std::vector<size_t> m_CellStarts;
+    std::vector<size_t> m_Items;
+
+    NormalSphereGrid(const NormalSphereGrid&); // Copy Constructor Not Implemented
+    void operator=(const NormalSphereGrid&); // Operator '=' Not Implemented
+};
+
+#endif /* _normalspheregrid_h_ */
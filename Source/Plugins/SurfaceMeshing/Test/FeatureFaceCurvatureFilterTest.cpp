@@ -0,0 +1,288 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+static const double k_CurvatureSphereRadius = 5.0;
+
+class FeatureFaceCurvatureFilterTest
+{
+  public:
+    FeatureFaceCurvatureFilterTest(){}
+    virtual ~FeatureFaceCurvatureFilterTest(){}
+    SIMPL_TYPE_MACRO(FeatureFaceCurvatureFilterTest)
+
+    // -----------------------------------------------------------------------------
+    // Returns the index of the vertex halfway between two vertices, projected on the
+    // sphere, creating it the first time the edge is seen
+    // -----------------------------------------------------------------------------
+    int64_t MidpointVertex(int64_t v0, int64_t v1, std::vector<double>& vertices, std::map<std::pair<int64_t, int64_t>, int64_t>& midpoints)
+    {
+      std::pair<int64_t, int64_t> edge = (v0 < v1) ? std::make_pair(v0, v1) : std::make_pair(v1, v0);
+      std::map<std::pair<int64_t, int64_t>, int64_t>::iterator iter = midpoints.find(edge);
+      if (iter != midpoints.end()) { return iter->second; }
+      double p[3] = { 0.0, 0.0, 0.0 };
+      double length = 0.0;
+      for (size_t j = 0; j < 3; j++)
+      {
+        p[j] = 0.5 * (vertices[3 * v0 + j] + vertices[3 * v1 + j]);
+        length += p[j] * p[j];
+      }
+      length = std::sqrt(length);
+      int64_t index = static_cast<int64_t>(vertices.size() / 3);
+      for (size_t j = 0; j < 3; j++) { vertices.push_back(k_CurvatureSphereRadius * p[j] / length); }
+      midpoints[edge] = index;
+      return index;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Closed sphere of Feature 1, built by subdividing an octahedron. The upper half is
+    // one large Feature face (1, 2); every octant of the lower half is its own Feature
+    // face (1, 3) to (1, 6), so the Feature faces are split over chunks of different sizes
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestData()
+    {
+      std::vector<double> vertices;
+      std::vector<int64_t> triangles;
+      for (int32_t i = 0; i < 6; i++)
+      {
+        double v[3] = { 0.0, 0.0, 0.0 };
+        v[i / 2] = (i % 2 == 0) ? k_CurvatureSphereRadius : -k_CurvatureSphereRadius;
+        vertices.insert(vertices.end(), v, v + 3);
+      }
+      for (int32_t octant = 0; octant < 8; octant++)
+      {
+        triangles.push_back((octant & 1) ? 1 : 0);
+        triangles.push_back((octant & 2) ? 3 : 2);
+        triangles.push_back((octant & 4) ? 5 : 4);
+      }
+      for (int32_t level = 0; level < 4; level++)
+      {
+        std::map<std::pair<int64_t, int64_t>, int64_t> midpoints;
+        std::vector<int64_t> subdivided;
+        for (size_t t = 0; t < triangles.size(); t += 3)
+        {
+          int64_t a = triangles[t];
+          int64_t b = triangles[t + 1];
+          int64_t c = triangles[t + 2];
+          int64_t ab = MidpointVertex(a, b, vertices, midpoints);
+          int64_t bc = MidpointVertex(b, c, vertices, midpoints);
+          int64_t ca = MidpointVertex(c, a, vertices, midpoints);
+          int64_t children[12] = { a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca };
+          subdivided.insert(subdivided.end(), children, children + 12);
+        }
+        triangles.swap(subdivided);
+      }
+      size_t numVertices = vertices.size() / 3;
+      size_t numTriangles = triangles.size() / 3;
+
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer sm = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+      SharedVertexList::Pointer vertexList = TriangleGeom::CreateSharedVertexList(numVertices);
+      TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numTriangles, vertexList, SIMPL::Geometry::TriangleGeometry, true);
+      float* vertex = triangleGeom->getVertexPointer(0);
+      for (size_t i = 0; i < 3 * numVertices; i++) { vertex[i] = static_cast<float>(vertices[i]); }
+      int64_t* triangle = triangleGeom->getTriPointer(0);
+      for (size_t i = 0; i < 3 * numTriangles; i++) { triangle[i] = triangles[i]; }
+      sm->setGeometry(triangleGeom);
+
+      AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(QVector<size_t>(1, numTriangles), SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::AttributeMatrixType::Face);
+      QVector<size_t> cDims(1, 2);
+      Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels, true);
+      cDims[0] = 1;
+      Int32ArrayType::Pointer featureFaceIds = Int32ArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFeatureFaceId, true);
+      cDims[0] = 3;
+      DoubleArrayType::Pointer faceNormals = DoubleArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFaceNormals, true);
+      DoubleArrayType::Pointer faceCentroids = DoubleArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFaceCentroids, true);
+      for (size_t t = 0; t < numTriangles; t++)
+      {
+        double p[3][3];
+        double centroid[3] = { 0.0, 0.0, 0.0 };
+        for (size_t k = 0; k < 3; k++)
+        {
+          for (size_t j = 0; j < 3; j++)
+          {
+            p[k][j] = static_cast<double>(vertex[3 * triangle[3 * t + k] + j]);
+            centroid[j] += p[k][j] / 3.0;
+          }
+        }
+        double e0[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+        double e1[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+        double normal[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+        double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        // Point the normals out of the sphere
+        if (normal[0] * centroid[0] + normal[1] * centroid[1] + normal[2] * centroid[2] < 0.0) { length = -length; }
+        for (size_t j = 0; j < 3; j++)
+        {
+          faceNormals->setComponent(t, j, normal[j] / length);
+          faceCentroids->setComponent(t, j, centroid[j]);
+        }
+
+        int32_t lowerOctant = (centroid[0] < 0.0 ? 1 : 0) + (centroid[1] < 0.0 ? 2 : 0);
+        int32_t faceId = (centroid[2] > 0.0) ? 1 : 2 + lowerOctant;
+        faceLabels->setComponent(t, 0, 1);
+        faceLabels->setComponent(t, 1, faceId + 1);
+        featureFaceIds->setValue(t, faceId);
+      }
+      faceAttrMat->addAttributeArray(faceLabels->getName(), faceLabels);
+      faceAttrMat->addAttributeArray(featureFaceIds->getName(), featureFaceIds);
+      faceAttrMat->addAttributeArray(faceNormals->getName(), faceNormals);
+      faceAttrMat->addAttributeArray(faceCentroids->getName(), faceCentroids);
+      sm->addAttributeMatrix(faceAttrMat->getName(), faceAttrMat);
+      dca->addDataContainer(sm);
+
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    AttributeMatrix::Pointer RunFeatureFaceCurvatureFilter()
+    {
+      DataContainerArray::Pointer dca = CreateTestData();
+
+      QString filtName = "FeatureFaceCurvatureFilter";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      var.setValue(true);
+      bool propWasSet = filter->setProperty("ComputeGaussianCurvature", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("ComputeMeanCurvature", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      AttributeMatrix::Pointer am = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName);
+      DREAM3D_REQUIRE_VALID_POINTER(am.get());
+      return am;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    DoubleArrayType::Pointer GetCurvatureArray(AttributeMatrix::Pointer am, const QString& name)
+    {
+      DoubleArrayType::Pointer array = std::dynamic_pointer_cast<DoubleArrayType>(am->getAttributeArray(name));
+      DREAM3D_REQUIRE_VALID_POINTER(array.get());
+      return array;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Every triangle is fitted on its own, so running the chunks on one thread or on
+    // all of them has to give the same values. The fit on a sphere also has to find
+    // both principal curvatures close to 1 / radius.
+    // -----------------------------------------------------------------------------
+    int TestSerialMatchesParallel()
+    {
+      AttributeMatrix::Pointer serial;
+      {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        // The filter's own scheduler joins this one, so its parallel_for runs on one thread
+        tbb::task_scheduler_init init(1);
+#endif
+        serial = RunFeatureFaceCurvatureFilter();
+      }
+      AttributeMatrix::Pointer parallel = RunFeatureFaceCurvatureFilter();
+
+      QStringList names;
+      names << SIMPL::FaceData::SurfaceMeshPrincipalCurvature1 << SIMPL::FaceData::SurfaceMeshPrincipalCurvature2;
+      names << SIMPL::FaceData::SurfaceMeshPrincipalDirection1 << SIMPL::FaceData::SurfaceMeshPrincipalDirection2;
+      names << SIMPL::FaceData::SurfaceMeshGaussianCurvatures << SIMPL::FaceData::SurfaceMeshMeanCurvatures;
+      for (int32_t n = 0; n < names.size(); n++)
+      {
+        DoubleArrayType::Pointer expected = GetCurvatureArray(serial, names[n]);
+        DoubleArrayType::Pointer actual = GetCurvatureArray(parallel, names[n]);
+        DREAM3D_REQUIRE_EQUAL(expected->getSize(), actual->getSize())
+        for (size_t i = 0; i < expected->getSize(); i++)
+        {
+          DREAM3D_REQUIRED(std::fabs(expected->getValue(i) - actual->getValue(i)), <=, 1.0e-12)
+        }
+      }
+
+      DoubleArrayType::Pointer kappa1 = GetCurvatureArray(parallel, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1);
+      DoubleArrayType::Pointer kappa2 = GetCurvatureArray(parallel, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2);
+      double meanKappa = 0.0;
+      for (size_t t = 0; t < kappa1->getNumberOfTuples(); t++)
+      {
+        meanKappa += kappa1->getValue(t) + kappa2->getValue(t);
+      }
+      meanKappa /= 2.0 * static_cast<double>(kappa1->getNumberOfTuples());
+      DREAM3D_REQUIRED(std::fabs(meanKappa * k_CurvatureSphereRadius - 1.0), <, 0.1)
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestSerialMatchesParallel())
+    }
+
+  private:
+    FeatureFaceCurvatureFilterTest(const FeatureFaceCurvatureFilterTest&); // Copy Constructor Not Implemented
+    void operator=(const FeatureFaceCurvatureFilterTest&); // Operator '=' Not Implemented
+};
@@ -0,0 +1,228 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/FeatureFaceGrouping.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class FeatureFaceGroupingTest
+{
+  public:
+    FeatureFaceGroupingTest(){}
+    virtual ~FeatureFaceGroupingTest(){}
+    SIMPL_TYPE_MACRO(FeatureFaceGroupingTest)
+
+    // -----------------------------------------------------------------------------
+    // Checks the Feature face to triangle index against the Feature face ids
+    // -----------------------------------------------------------------------------
+    int CheckFaceTriangleIndex(const std::vector<int32_t>& featureFaceIds, int32_t numFeatureFaces)
+    {
+      int64_t numTriangles = static_cast<int64_t>(featureFaceIds.size());
+      FlatNeighborList<int64_t> index;
+      FeatureFaceGrouping::BuildFaceTriangleIndex(&(featureFaceIds.front()), numTriangles, index);
+      DREAM3D_REQUIRE(index.getNumberOfFeatures() <= static_cast<size_t>(numFeatureFaces))
+      DREAM3D_REQUIRE_EQUAL(index.getNumberOfValues(), static_cast<size_t>(numTriangles))
+
+      std::vector<std::vector<int64_t> > expected(index.getNumberOfFeatures());
+      for (int64_t t = 0; t < numTriangles; t++)
+      {
+        expected[featureFaceIds[t]].push_back(t);
+      }
+      for (size_t f = 0; f < index.getNumberOfFeatures(); f++)
+      {
+        DREAM3D_REQUIRE_EQUAL(index.getListSize(f), expected[f].size())
+        for (size_t i = 0; i < expected[f].size(); i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(index.getValue(f, i), expected[f][i])
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Groups a hand built label array with swapped pairs, two (0, 0) triangles and
+    // triangles on the outside (-1) of the mesh
+    // -----------------------------------------------------------------------------
+    int TestHandBuiltLabels()
+    {
+      const int32_t faceLabels[20] =
+      {
+        1, 2,
+        2, 3,
+        2, 1,
+        0, 0,
+        -1, 3,
+        3, 2,
+        1, -1,
+        0, 0,
+        3, -1,
+        1, 2
+      };
+      const int32_t expectedIds[10] = { 1, 2, 1, 3, 4, 2, 5, 3, 4, 1 };
+      const int32_t expectedLabels[12] = { 0, 0, 1, 2, 2, 3, 0, 0, -1, 3, -1, 1 };
+      const int32_t expectedNumTriangles[6] = { 2, 3, 2, 2, 2, 1 };
+
+      std::vector<int32_t> featureFaceIds(10, -1);
+      FeatureFaceGrouping grouping;
+      grouping.execute(faceLabels, 10, &(featureFaceIds.front()));
+
+      DREAM3D_REQUIRE_EQUAL(grouping.getNumberOfFeatureFaces(), 6)
+      for (int32_t t = 0; t < 10; t++)
+      {
+        DREAM3D_REQUIRE_EQUAL(featureFaceIds[t], expectedIds[t])
+      }
+      for (int32_t f = 0; f < 6; f++)
+      {
+        DREAM3D_REQUIRE_EQUAL(grouping.getFeatureFaceLabels()[2 * f], expectedLabels[2 * f])
+        DREAM3D_REQUIRE_EQUAL(grouping.getFeatureFaceLabels()[2 * f + 1], expectedLabels[2 * f + 1])
+        DREAM3D_REQUIRE_EQUAL(grouping.getNumTriangles()[f], expectedNumTriangles[f])
+      }
+
+      // The lists of every Feature face, in increasing triangle order; id 0 is empty
+      FlatNeighborList<int64_t> index;
+      FeatureFaceGrouping::BuildFaceTriangleIndex(&(featureFaceIds.front()), 10, index);
+      const int64_t expectedLists[10] = { 0, 2, 9, 1, 5, 3, 7, 4, 8, 6 };
+      const size_t expectedOffsets[7] = { 0, 0, 3, 5, 7, 9, 10 };
+      DREAM3D_REQUIRE_EQUAL(index.getNumberOfFeatures(), 6)
+      for (size_t f = 0; f < 6; f++)
+      {
+        DREAM3D_REQUIRE_EQUAL(index.getListStart(f), expectedOffsets[f])
+        DREAM3D_REQUIRE_EQUAL(index.getListEnd(f), expectedOffsets[f + 1])
+      }
+      for (size_t i = 0; i < 10; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(index.getValues()[i], expectedLists[i])
+      }
+
+      // Without any (0, 0) triangle the reserved bucket stays empty
+      const int32_t noZeroLabels[6] = { 4, 1, 1, 4, 5, 4 };
+      std::vector<int32_t> noZeroIds(3, -1);
+      FeatureFaceGrouping noZero;
+      noZero.execute(noZeroLabels, 3, &(noZeroIds.front()));
+      DREAM3D_REQUIRE_EQUAL(noZero.getNumberOfFeatureFaces(), 3)
+      DREAM3D_REQUIRE_EQUAL(noZero.getNumTriangles()[0], 0)
+      DREAM3D_REQUIRE_EQUAL(noZero.getFeatureFaceLabels()[0], 0)
+      DREAM3D_REQUIRE_EQUAL(noZero.getFeatureFaceLabels()[1], 0)
+      DREAM3D_REQUIRE_EQUAL(noZeroIds[0], 1)
+      DREAM3D_REQUIRE_EQUAL(noZeroIds[1], 1)
+      DREAM3D_REQUIRE_EQUAL(noZeroIds[2], 2)
+      DREAM3D_REQUIRE_EQUAL(noZero.getFeatureFaceLabels()[2], 1)
+      DREAM3D_REQUIRE_EQUAL(noZero.getFeatureFaceLabels()[3], 4)
+      DREAM3D_REQUIRE_EQUAL(noZero.getFeatureFaceLabels()[4], 4)
+      DREAM3D_REQUIRE_EQUAL(noZero.getFeatureFaceLabels()[5], 5)
+      DREAM3D_REQUIRE_EQUAL(noZero.getNumTriangles()[1], 2)
+      DREAM3D_REQUIRE_EQUAL(noZero.getNumTriangles()[2], 1)
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Groups enough random label pairs to span several hash blocks and compares the
+    // result with the serial map based grouping the filter used to do
+    // -----------------------------------------------------------------------------
+    int TestMultipleBlocks()
+    {
+      const int64_t numTriangles = 3 * (1 << 18) + 17;
+      std::vector<int32_t> faceLabels(2 * numTriangles);
+      uint32_t seed = 4321u;
+      for (int64_t i = 0; i < 2 * numTriangles; i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        faceLabels[i] = static_cast<int32_t>((seed >> 16) % 400) - 1;
+      }
+
+      std::map<std::pair<int32_t, int32_t>, int32_t> idMap;
+      std::vector<std::pair<int32_t, int32_t> > labelMap(1, std::make_pair(0, 0));
+      std::vector<int32_t> numTrianglesMap(1, 0);
+      std::vector<int32_t> expectedIds(numTriangles);
+      for (int64_t t = 0; t < numTriangles; t++)
+      {
+        std::pair<int32_t, int32_t> labels = std::make_pair(std::min(faceLabels[2 * t], faceLabels[2 * t + 1]), std::max(faceLabels[2 * t], faceLabels[2 * t + 1]));
+        std::map<std::pair<int32_t, int32_t>, int32_t>::iterator iter = idMap.find(labels);
+        if (iter == idMap.end())
+        {
+          iter = idMap.insert(std::make_pair(labels, static_cast<int32_t>(labelMap.size()))).first;
+          labelMap.push_back(labels);
+          numTrianglesMap.push_back(0);
+        }
+        expectedIds[t] = iter->second;
+        numTrianglesMap[iter->second]++;
+        if (labels.first == 0 && labels.second == 0) { numTrianglesMap[0]++; }
+      }
+
+      std::vector<int32_t> featureFaceIds(numTriangles, -1);
+      FeatureFaceGrouping grouping;
+      grouping.execute(&(faceLabels.front()), numTriangles, &(featureFaceIds.front()));
+
+      DREAM3D_REQUIRE_EQUAL(grouping.getNumberOfFeatureFaces(), static_cast<int32_t>(labelMap.size()))
+      for (int64_t t = 0; t < numTriangles; t++)
+      {
+        DREAM3D_REQUIRE_EQUAL(featureFaceIds[t], expectedIds[t])
+      }
+      for (size_t f = 0; f < labelMap.size(); f++)
+      {
+        DREAM3D_REQUIRE_EQUAL(grouping.getFeatureFaceLabels()[2 * f], labelMap[f].first)
+        DREAM3D_REQUIRE_EQUAL(grouping.getFeatureFaceLabels()[2 * f + 1], labelMap[f].second)
+        DREAM3D_REQUIRE_EQUAL(grouping.getNumTriangles()[f], numTrianglesMap[f])
+      }
+
+      return CheckFaceTriangleIndex(featureFaceIds, grouping.getNumberOfFeatureFaces());
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestHandBuiltLabels())
+      DREAM3D_REGISTER_TEST(TestMultipleBlocks())
+    }
+
+  private:
+    FeatureFaceGroupingTest(const FeatureFaceGroupingTest&); // Copy Constructor Not Implemented
+    void operator=(const FeatureFaceGroupingTest&); // Operator '=' Not Implemented
+};
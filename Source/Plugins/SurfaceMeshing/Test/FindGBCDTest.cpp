@@ -0,0 +1,238 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+// Features 1 to 4 are cubic, 5 to 7 hexagonal; Feature 0 and the -1 labels are the outside
+static const int32_t k_GBCDNumFeatures = 8;
+static const size_t k_GBCDNumFaces = 3000;
+
+class FindGBCDTest
+{
+  public:
+    FindGBCDTest(){}
+    virtual ~FindGBCDTest(){}
+    SIMPL_TYPE_MACRO(FindGBCDTest)
+
+    // -----------------------------------------------------------------------------
+    // The GBCD only reads the face labels, normals and areas, so the faces do not
+    // need to form a closed mesh
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestData()
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      uint32_t seed = 1618;
+
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(1, 1, 1);
+      m->setGeometry(image);
+
+      QVector<size_t> cDims(1, 3);
+      AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(QVector<size_t>(1, k_GBCDNumFeatures), SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+      FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(k_GBCDNumFeatures, cDims, SIMPL::FeatureData::EulerAngles, true);
+      cDims[0] = 1;
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(k_GBCDNumFeatures, cDims, SIMPL::FeatureData::Phases, true);
+      phases->setValue(0, 0);
+      for (int32_t i = 0; i < k_GBCDNumFeatures * 3; i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        float scale = (i % 3 == 1) ? SIMPLib::Constants::k_Pi : SIMPLib::Constants::k_2Pi;
+        eulers->setValue(i, scale * static_cast<float>((seed >> 16) % 1000) / 1000.0f);
+      }
+      for (int32_t i = 1; i < k_GBCDNumFeatures; i++)
+      {
+        phases->setValue(i, (i < 5) ? 1 : 2);
+      }
+      featureAttrMat->addAttributeArray(eulers->getName(), eulers);
+      featureAttrMat->addAttributeArray(phases->getName(), phases);
+      m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+      AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(QVector<size_t>(1, 3), SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::AttributeMatrixType::CellEnsemble);
+      UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, cDims, SIMPL::EnsembleData::CrystalStructures, true);
+      crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+      crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+      crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+      ensembleAttrMat->addAttributeArray(crystalStructures->getName(), crystalStructures);
+      m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+      dca->addDataContainer(m);
+
+      DataContainer::Pointer sm = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+      SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(0);
+      TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(0, vertices, SIMPL::Geometry::TriangleGeometry, true);
+      sm->setGeometry(triangleGeom);
+
+      AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(QVector<size_t>(1, k_GBCDNumFaces), SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::AttributeMatrixType::Face);
+      cDims[0] = 2;
+      Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(k_GBCDNumFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels, true);
+      cDims[0] = 3;
+      DoubleArrayType::Pointer faceNormals = DoubleArrayType::CreateArray(k_GBCDNumFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceNormals, true);
+      cDims[0] = 1;
+      DoubleArrayType::Pointer faceAreas = DoubleArrayType::CreateArray(k_GBCDNumFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceAreas, true);
+      for (size_t i = 0; i < k_GBCDNumFaces; i++)
+      {
+        for (size_t j = 0; j < 2; j++)
+        {
+          seed = seed * 1103515245u + 12345u;
+          faceLabels->setComponent(i, j, static_cast<int32_t>((seed >> 16) % (k_GBCDNumFeatures + 1)) - 1);
+        }
+        double normal[3] = { 0.0, 0.0, 0.0 };
+        double length = 0.0;
+        while (length < 0.01)
+        {
+          for (size_t j = 0; j < 3; j++)
+          {
+            seed = seed * 1103515245u + 12345u;
+            normal[j] = static_cast<double>((seed >> 16) % 2001) / 1000.0 - 1.0;
+          }
+          length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        }
+        for (size_t j = 0; j < 3; j++) { faceNormals->setComponent(i, j, normal[j] / length); }
+        seed = seed * 1103515245u + 12345u;
+        faceAreas->setValue(i, 0.1 + static_cast<double>((seed >> 16) % 1000) / 100.0);
+      }
+      faceAttrMat->addAttributeArray(faceLabels->getName(), faceLabels);
+      faceAttrMat->addAttributeArray(faceNormals->getName(), faceNormals);
+      faceAttrMat->addAttributeArray(faceAreas->getName(), faceAreas);
+      sm->addAttributeMatrix(faceAttrMat->getName(), faceAttrMat);
+      dca->addDataContainer(sm);
+
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    DoubleArrayType::Pointer RunFindGBCD(qint64 memoryBudget)
+    {
+      DataContainerArray::Pointer dca = CreateTestData();
+
+      QString filtName = "FindGBCD";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      var.setValue(memoryBudget);
+      bool propWasSet = filter->setProperty("HistogramMemoryBudget", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      AttributeMatrix::Pointer am = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getAttributeMatrix(SIMPL::Defaults::FaceEnsembleAttributeMatrixName);
+      DREAM3D_REQUIRE_VALID_POINTER(am.get());
+      DoubleArrayType::Pointer gbcdPtr = std::dynamic_pointer_cast<DoubleArrayType>(am->getAttributeArray(SIMPL::EnsembleData::GBCD));
+      DREAM3D_REQUIRE_VALID_POINTER(gbcdPtr.get());
+      return gbcdPtr;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void CompareGBCD(DoubleArrayType::Pointer expected, DoubleArrayType::Pointer actual)
+    {
+      DREAM3D_REQUIRE_EQUAL(expected->getSize(), actual->getSize())
+      for (size_t i = 0; i < expected->getSize(); i++)
+      {
+        double diff = std::fabs(expected->getValue(i) - actual->getValue(i));
+        DREAM3D_REQUIRED(diff, <=, 1.0e-9 * std::max(1.0, std::fabs(expected->getValue(i))))
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    // A zero budget accumulates serially straight into the GBCD, the default budget and
+    // a budget of exactly two scratch histograms split the faces between histograms
+    // -----------------------------------------------------------------------------
+    int TestFindGBCDParallelMatchesSerial()
+    {
+      DoubleArrayType::Pointer serial = RunFindGBCD(0);
+
+      // Every deposited area is counted in its phase total as well, so after the MRD
+      // normalization the bins of each populated phase sum to the number of bins
+      size_t numPhases = serial->getNumberOfTuples();
+      size_t numBins = serial->getSize() / numPhases;
+      for (size_t p = 1; p < numPhases; p++)
+      {
+        double sum = 0.0;
+        for (size_t j = 0; j < numBins; j++) { sum += serial->getValue(p * numBins + j); }
+        DREAM3D_REQUIRED(std::fabs(sum - double(numBins)), <, 1.0e-6 * double(numBins))
+      }
+
+      CompareGBCD(serial, RunFindGBCD(1024 * 1024 * 1024));
+
+      qint64 histogramBytes = static_cast<qint64>((serial->getSize() + numPhases) * sizeof(double));
+      CompareGBCD(serial, RunFindGBCD(2 * histogramBytes));
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestFindGBCDParallelMatchesSerial())
+    }
+
+  private:
+    FindGBCDTest(const FindGBCDTest&); // Copy Constructor Not Implemented
+    void operator=(const FindGBCDTest&); // Operator '=' Not Implemented
+};
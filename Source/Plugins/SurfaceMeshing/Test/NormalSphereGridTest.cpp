@@ -0,0 +1,477 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/NormalSphereGrid.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class NormalSphereGridTest
+{
+  public:
+    NormalSphereGridTest() :
+      m_Seed(20160601u)
+    {}
+    virtual ~NormalSphereGridTest(){}
+    SIMPL_TYPE_MACRO(NormalSphereGridTest)
+
+    // -----------------------------------------------------------------------------
+    // Uniform random number in [0, 1)
+    // -----------------------------------------------------------------------------
+    float NextRandom()
+    {
+      m_Seed = m_Seed * 1103515245u + 12345u;
+      return static_cast<float>((m_Seed >> 8) & 0xFFFFFF) / 16777216.0f;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Random unit vector, uniformly distributed on the sphere
+    // -----------------------------------------------------------------------------
+    void RandomUnitVector(float v[3])
+    {
+      float z = 2.0f * NextRandom() - 1.0f;
+      float phi = SIMPLib::Constants::k_2Pi * NextRandom();
+      float r = sqrtf(std::max(0.0f, 1.0f - z * z));
+      v[0] = r * cosf(phi);
+      v[1] = r * sinf(phi);
+      v[2] = z;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Rotation matrix of a random unit quaternion
+    // -----------------------------------------------------------------------------
+    void RandomRotation(float g[3][3])
+    {
+      float q[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+      float norm = 0.0f;
+      while (norm < 1.0E-3f)
+      {
+        norm = 0.0f;
+        for (int i = 0; i < 4; i++)
+        {
+          q[i] = 2.0f * NextRandom() - 1.0f;
+          norm += q[i] * q[i];
+        }
+      }
+      norm = sqrtf(norm);
+      float w = q[0] / norm, x = q[1] / norm, y = q[2] / norm, z = q[3] / norm;
+      g[0][0] = 1.0f - 2.0f * (y * y + z * z);
+      g[0][1] = 2.0f * (x * y - w * z);
+      g[0][2] = 2.0f * (x * z + w * y);
+      g[1][0] = 2.0f * (x * y + w * z);
+      g[1][1] = 1.0f - 2.0f * (x * x + z * z);
+      g[1][2] = 2.0f * (y * z - w * x);
+      g[2][0] = 2.0f * (x * z - w * y);
+      g[2][1] = 2.0f * (y * z + w * x);
+      g[2][2] = 1.0f - 2.0f * (x * x + y * y);
+    }
+
+    // -----------------------------------------------------------------------------
+    // The 24 proper rotations of the cube, i.e. the signed permutation matrices with determinant 1
+    // -----------------------------------------------------------------------------
+    std::vector<float> CubicSymOps()
+    {
+      const int perms[6][3] = { { 0, 1, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 0, 2, 1 }, { 2, 1, 0 }, { 1, 0, 2 } };
+      std::vector<float> symOps;
+      for (int p = 0; p < 6; p++)
+      {
+        float parity = (p < 3) ? 1.0f : -1.0f;
+        for (int s = 0; s < 8; s++)
+        {
+          float signs[3] = { (s & 1) ? -1.0f : 1.0f, (s & 2) ? -1.0f : 1.0f, (s & 4) ? -1.0f : 1.0f };
+          if (parity * signs[0] * signs[1] * signs[2] < 0.0f) { continue; }
+          float sym[9] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+          for (int row = 0; row < 3; row++)
+          {
+            sym[row * 3 + perms[p][row]] = signs[row];
+          }
+          symOps.insert(symOps.end(), sym, sym + 9);
+        }
+      }
+      return symOps;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Every vector within the maximum angle of a query is in one of its neighbor cells,
+    // and every vector is stored exactly once
+    // -----------------------------------------------------------------------------
+    int TestNeighborCells()
+    {
+      const size_t numVectors = 400;
+      const size_t numQueries = 300;
+      const float maxAngles[7] = { 0.001f, 0.05f, 0.3f, 1.0f, 2.5f, SIMPLib::Constants::k_Pi, 4.0f };
+      for (int a = 0; a < 7; a++)
+      {
+        std::vector<float> x(numVectors), y(numVectors), z(numVectors);
+        for (size_t i = 0; i < numVectors; i++)
+        {
+          float v[3];
+          RandomUnitVector(v);
+          x[i] = v[0];
+          y[i] = v[1];
+          z[i] = v[2];
+        }
+        // Queries on and right next to the stored vectors, plus random ones
+        std::vector<float> queries(3 * numQueries);
+        for (size_t q = 0; q < numQueries; q++)
+        {
+          RandomUnitVector(&(queries[3 * q]));
+          if (q < numVectors && q % 3 == 0)
+          {
+            queries[3 * q] = x[q];
+            queries[3 * q + 1] = y[q];
+            queries[3 * q + 2] = z[q];
+          }
+        }
+
+        NormalSphereGrid grid(maxAngles[a]);
+        DREAM3D_REQUIRE(grid.getNumberOfCellsPerAxis() >= 1)
+        DREAM3D_REQUIRE(grid.getNumberOfCellsPerAxis() <= static_cast<size_t>(NormalSphereGrid::MaxCellsPerAxis))
+        grid.build(&(x.front()), &(y.front()), &(z.front()), numVectors);
+
+        size_t numCells = grid.getNumberOfCellsPerAxis() * grid.getNumberOfCellsPerAxis() * grid.getNumberOfCellsPerAxis();
+        std::vector<int> timesStored(numVectors, 0);
+        for (size_t c = 0; c < numCells; c++)
+        {
+          for (size_t pos = grid.getCellBegin(c); pos < grid.getCellEnd(c); pos++)
+          {
+            timesStored[grid.getItem(pos)]++;
+          }
+        }
+        for (size_t i = 0; i < numVectors; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(timesStored[i], 1)
+        }
+
+        for (size_t q = 0; q < numQueries; q++)
+        {
+          const float* query = &(queries[3 * q]);
+          std::vector<bool> found(numVectors, false);
+          size_t cells[NormalSphereGrid::MaxNeighborCells];
+          size_t numNeighborCells = grid.getNeighborCells(query, cells);
+          DREAM3D_REQUIRE(numNeighborCells <= static_cast<size_t>(NormalSphereGrid::MaxNeighborCells))
+          for (size_t c = 0; c < numNeighborCells; c++)
+          {
+            for (size_t pos = grid.getCellBegin(cells[c]); pos < grid.getCellEnd(cells[c]); pos++)
+            {
+              found[grid.getItem(pos)] = true;
+            }
+          }
+          for (size_t i = 0; i < numVectors; i++)
+          {
+            float dot = query[0] * x[i] + query[1] * y[i] + query[2] * z[i];
+            float angle = acosf(std::max(-1.0f, std::min(1.0f, dot)));
+            if (angle < maxAngles[a]) { DREAM3D_REQUIRE_EQUAL(found[i], true) }
+          }
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The FindGBCDMetricBased probe: the grid over +/- the grain 1 normals has to select
+    // exactly the (triangle, inversion) pairs the loop over every triangle accepted
+    // -----------------------------------------------------------------------------
+    int TestGBCDProbe()
+    {
+      const int32_t numTris = 300;
+      const size_t numProbes = 200;
+      std::vector<float> n1(3 * numTris), n2(3 * numTris);
+      std::vector<double> area(numTris);
+      for (int32_t i = 0; i < numTris; i++)
+      {
+        RandomUnitVector(&(n1[3 * i]));
+        RandomUnitVector(&(n2[3 * i]));
+        area[i] = 0.5 + static_cast<double>(NextRandom());
+      }
+      float gFixedT[3][3];
+      RandomRotation(gFixedT);
+
+      std::vector<float> x(2 * numTris), y(2 * numTris), z(2 * numTris);
+      for (int32_t i = 0; i < numTris; i++)
+      {
+        x[2 * i] = n1[3 * i];
+        y[2 * i] = n1[3 * i + 1];
+        z[2 * i] = n1[3 * i + 2];
+        x[2 * i + 1] = -n1[3 * i];
+        y[2 * i + 1] = -n1[3 * i + 1];
+        z[2 * i + 1] = -n1[3 * i + 2];
+      }
+
+      const float planeResols[3] = { 0.1f, 0.4f, 1.2f };
+      for (int r = 0; r < 3; r++)
+      {
+        float planeResolSq = planeResols[r] * planeResols[r];
+        NormalSphereGrid grid(sqrtf(2.0f * planeResolSq));
+        grid.build(&(x.front()), &(y.front()), &(z.front()), x.size());
+
+        for (size_t p = 0; p < numProbes; p++)
+        {
+          float fixedNormal1[3];
+          RandomUnitVector(fixedNormal1);
+          // Half of the probes sit on a triangle so every probe resolution gets hits
+          if (p % 2 == 0)
+          {
+            int32_t tri = static_cast<int32_t>(p / 2) % numTris;
+            fixedNormal1[0] = n1[3 * tri];
+            fixedNormal1[1] = n1[3 * tri + 1];
+            fixedNormal1[2] = n1[3 * tri + 2];
+          }
+          float fixedNormal2[3];
+          for (int i = 0; i < 3; i++)
+          {
+            fixedNormal2[i] = gFixedT[i][0] * fixedNormal1[0] + gFixedT[i][1] * fixedNormal1[1] + gFixedT[i][2] * fixedNormal1[2];
+          }
+
+          std::vector<size_t> expected;
+          double expectedArea = 0.0;
+          for (int32_t tri = 0; tri < numTris; tri++)
+          {
+            for (int inversion = 0; inversion <= 1; inversion++)
+            {
+              if (AcceptGBCD(n1, n2, tri, inversion, fixedNormal1, fixedNormal2, planeResolSq))
+              {
+                expected.push_back(2 * tri + inversion);
+                expectedArea += area[tri];
+              }
+            }
+          }
+
+          std::vector<size_t> accepted;
+          double acceptedArea = 0.0;
+          size_t cells[NormalSphereGrid::MaxNeighborCells];
+          size_t numCells = grid.getNeighborCells(fixedNormal1, cells);
+          for (size_t c = 0; c < numCells; c++)
+          {
+            for (size_t pos = grid.getCellBegin(cells[c]); pos < grid.getCellEnd(cells[c]); pos++)
+            {
+              size_t entry = grid.getItem(pos);
+              int32_t tri = static_cast<int32_t>(entry / 2);
+              if (AcceptGBCD(n1, n2, tri, static_cast<int>(entry % 2), fixedNormal1, fixedNormal2, planeResolSq))
+              {
+                accepted.push_back(entry);
+                acceptedArea += area[tri];
+              }
+            }
+          }
+
+          std::sort(accepted.begin(), accepted.end());
+          DREAM3D_REQUIRE_EQUAL(accepted.size(), expected.size())
+          for (size_t i = 0; i < expected.size(); i++)
+          {
+            DREAM3D_REQUIRE_EQUAL(accepted[i], expected[i])
+          }
+          DREAM3D_REQUIRE(fabs(acceptedArea - expectedArea) <= 1.0E-9 * (1.0 + expectedArea))
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Distance test of FindGBCDMetricBased for one triangle and inversion
+    // -----------------------------------------------------------------------------
+    bool AcceptGBCD(const std::vector<float>& n1, const std::vector<float>& n2, int32_t tri, int inversion,
+                    const float fixedNormal1[3], const float fixedNormal2[3], float planeResolSq)
+    {
+      float sign = (inversion == 1) ? -1.0f : 1.0f;
+      float theta1 = acosf(sign * (n1[3 * tri] * fixedNormal1[0] + n1[3 * tri + 1] * fixedNormal1[1] + n1[3 * tri + 2] * fixedNormal1[2]));
+      float theta2 = acosf(-sign * (n2[3 * tri] * fixedNormal2[0] + n2[3 * tri + 1] * fixedNormal2[1] + n2[3 * tri + 2] * fixedNormal2[2]));
+      float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
+      return distSq < planeResolSq;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The FindGBPDMetricBased probe: looking up transpose(sym) * probe among +/- both
+    // normals has to select exactly the (triangle, symmetry, normal, inversion) entries
+    // that comparing the probe with sym * n for every triangle accepted
+    // -----------------------------------------------------------------------------
+    int TestGBPDProbe()
+    {
+      const int32_t numTris = 250;
+      const size_t numProbes = 150;
+      std::vector<float> normals(6 * numTris);
+      std::vector<double> area(numTris);
+      for (int32_t i = 0; i < numTris; i++)
+      {
+        RandomUnitVector(&(normals[6 * i]));
+        RandomUnitVector(&(normals[6 * i + 3]));
+        area[i] = 0.5 + static_cast<double>(NextRandom());
+      }
+      std::vector<float> symOps = CubicSymOps();
+      int nsym = static_cast<int>(symOps.size() / 9);
+      DREAM3D_REQUIRE_EQUAL(nsym, 24)
+
+      std::vector<float> x(4 * numTris), y(4 * numTris), z(4 * numTris);
+      for (int32_t i = 0; i < numTris; i++)
+      {
+        for (int k = 0; k < 2; k++)
+        {
+          const float* n = &(normals[6 * i + 3 * k]);
+          x[4 * i + 2 * k] = n[0];
+          y[4 * i + 2 * k] = n[1];
+          z[4 * i + 2 * k] = n[2];
+          x[4 * i + 2 * k + 1] = -n[0];
+          y[4 * i + 2 * k + 1] = -n[1];
+          z[4 * i + 2 * k + 1] = -n[2];
+        }
+      }
+
+      const float limitDists[3] = { 0.05f, 0.2f, 0.7f };
+      for (int d = 0; d < 3; d++)
+      {
+        NormalSphereGrid grid(limitDists[d]);
+        grid.build(&(x.front()), &(y.front()), &(z.front()), x.size());
+
+        for (size_t p = 0; p < numProbes; p++)
+        {
+          float probeNormal[3];
+          RandomUnitVector(probeNormal);
+          if (p % 2 == 0)
+          {
+            const float* n = &(normals[3 * (p % (2 * numTris))]);
+            probeNormal[0] = n[0];
+            probeNormal[1] = n[1];
+            probeNormal[2] = n[2];
+          }
+
+          // Entries are numbered ((tri * nsym + j) * 2 + k) * 2 + inversion
+          std::vector<size_t> expected;
+          double expectedArea = 0.0;
+          for (int32_t tri = 0; tri < numTris; tri++)
+          {
+            for (int j = 0; j < nsym; j++)
+            {
+              for (int inversion = 0; inversion <= 1; inversion++)
+              {
+                for (int k = 0; k < 2; k++)
+                {
+                  if (AcceptGBPD(normals, symOps, tri, j, k, inversion, probeNormal, limitDists[d]))
+                  {
+                    expected.push_back(((tri * nsym + j) * 2 + k) * 2 + inversion);
+                    expectedArea += area[tri];
+                  }
+                }
+              }
+            }
+          }
+
+          std::vector<size_t> accepted;
+          double acceptedArea = 0.0;
+          for (int j = 0; j < nsym; j++)
+          {
+            const float* sym = &(symOps[9 * j]);
+            float symProbe[3] = { 0.0f, 0.0f, 0.0f };
+            for (int k = 0; k < 3; k++)
+            {
+              symProbe[k] = sym[k] * probeNormal[0] + sym[3 + k] * probeNormal[1] + sym[6 + k] * probeNormal[2];
+            }
+            size_t cells[NormalSphereGrid::MaxNeighborCells];
+            size_t numCells = grid.getNeighborCells(symProbe, cells);
+            for (size_t c = 0; c < numCells; c++)
+            {
+              for (size_t pos = grid.getCellBegin(cells[c]); pos < grid.getCellEnd(cells[c]); pos++)
+              {
+                size_t entry = grid.getItem(pos);
+                int32_t tri = static_cast<int32_t>(entry / 4);
+                int k = static_cast<int>((entry / 2) % 2);
+                int inversion = static_cast<int>(entry % 2);
+                if (AcceptGBPD(normals, symOps, tri, j, k, inversion, probeNormal, limitDists[d]))
+                {
+                  accepted.push_back(((tri * nsym + j) * 2 + k) * 2 + inversion);
+                  acceptedArea += area[tri];
+                }
+              }
+            }
+          }
+
+          std::sort(expected.begin(), expected.end());
+          std::sort(accepted.begin(), accepted.end());
+          DREAM3D_REQUIRE_EQUAL(accepted.size(), expected.size())
+          for (size_t i = 0; i < expected.size(); i++)
+          {
+            DREAM3D_REQUIRE_EQUAL(accepted[i], expected[i])
+          }
+          DREAM3D_REQUIRE(fabs(acceptedArea - expectedArea) <= 1.0E-9 * (1.0 + expectedArea))
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Distance test of FindGBPDMetricBased for one normal of a triangle under one symmetry operator
+    // -----------------------------------------------------------------------------
+    bool AcceptGBPD(const std::vector<float>& normals, const std::vector<float>& symOps, int32_t tri, int j, int k, int inversion,
+                    const float probeNormal[3], float limitDist)
+    {
+      const float* normal = &(normals[6 * tri + 3 * k]);
+      const float* sym = &(symOps[9 * j]);
+      float symNormal[3];
+      for (int i = 0; i < 3; i++)
+      {
+        symNormal[i] = sym[3 * i] * normal[0] + sym[3 * i + 1] * normal[1] + sym[3 * i + 2] * normal[2];
+      }
+      float sign = (inversion == 1) ? -1.0f : 1.0f;
+      float gamma = acosf(sign * (probeNormal[0] * symNormal[0] + probeNormal[1] * symNormal[1] + probeNormal[2] * symNormal[2]));
+      return gamma < limitDist;
+    }
+
+    /**
+    * @brief
+    */
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestNeighborCells())
+      DREAM3D_REGISTER_TEST(TestGBCDProbe())
+      DREAM3D_REGISTER_TEST(TestGBPDProbe())
+    }
+
+  private:
+    uint32_t m_Seed;
+
+    NormalSphereGridTest(const NormalSphereGridTest&); // Copy Constructor Not Implemented
+    void operator=(const NormalSphereGridTest&); // Operator '=' Not Implemented
+};
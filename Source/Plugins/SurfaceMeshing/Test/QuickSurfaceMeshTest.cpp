@@ -0,0 +1,299 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cmath>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class QuickSurfaceMeshTest
+{
+  public:
+    QuickSurfaceMeshTest(){}
+    virtual ~QuickSurfaceMeshTest(){}
+    SIMPL_TYPE_MACRO(QuickSurfaceMeshTest)
+
+    // -----------------------------------------------------------------------------
+    // Returns the Feature of voxel (x, y, z), or -1 outside of the volume
+    // -----------------------------------------------------------------------------
+    int32_t GetFeature(const int32_t* featureIds, const int64_t dims[3], int64_t x, int64_t y, int64_t z)
+    {
+      if (x < 0 || y < 0 || z < 0 || x >= dims[0] || y >= dims[1] || z >= dims[2]) { return -1; }
+      return featureIds[(z * dims[1] + y) * dims[0] + x];
+    }
+
+    // -----------------------------------------------------------------------------
+    // Checks a mesh against the voxels it was built from: every face between two
+    // different Features, or between a voxel and the outside, is split into exactly two
+    // triangles; every triangle's normal points into the Feature of its first label and
+    // away from the second (-1 outside); the node types are the number of distinct
+    // Features around the node (at most 4), plus 10 on the outside of the volume.
+    // -----------------------------------------------------------------------------
+    void CheckQuickSurfaceMesh(const int32_t* featureIds, const int64_t dims[3], const float res[3], const float origin[3],
+                               const float* vertices, int64_t numVertices, const int64_t* triangles, int64_t numTriangles,
+                               const int32_t* faceLabels, const int8_t* nodeTypes)
+    {
+      // Faces are keyed by the lattice point of their lower corner and their normal axis
+      std::set<std::vector<int64_t> > expectedFaces;
+      std::set<std::vector<int64_t> > expectedNodes;
+      for (int64_t z = 0; z <= dims[2]; z++)
+      {
+        for (int64_t y = 0; y <= dims[1]; y++)
+        {
+          for (int64_t x = 0; x <= dims[0]; x++)
+          {
+            int64_t p[3] = { x, y, z };
+            for (int64_t axis = 0; axis < 3; axis++)
+            {
+              // The face spans one voxel along the other two axes and separates the voxel
+              // starting at p from the one before it along the axis
+              if (p[(axis + 1) % 3] == dims[(axis + 1) % 3] || p[(axis + 2) % 3] == dims[(axis + 2) % 3]) { continue; }
+              int64_t q[3] = { p[0], p[1], p[2] };
+              q[axis]--;
+              int32_t f1 = GetFeature(featureIds, dims, p[0], p[1], p[2]);
+              int32_t f2 = GetFeature(featureIds, dims, q[0], q[1], q[2]);
+              if (f1 == f2) { continue; }
+              std::vector<int64_t> face(p, p + 3);
+              face.push_back(axis);
+              expectedFaces.insert(face);
+              for (int64_t c = 0; c < 4; c++)
+              {
+                std::vector<int64_t> node(p, p + 3);
+                node[(axis + 1) % 3] += c % 2;
+                node[(axis + 2) % 3] += c / 2;
+                expectedNodes.insert(node);
+              }
+            }
+          }
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(numTriangles, static_cast<int64_t>(2 * expectedFaces.size()))
+      DREAM3D_REQUIRE_EQUAL(numVertices, static_cast<int64_t>(expectedNodes.size()))
+
+      // Every vertex is a distinct lattice point that some face touches
+      std::map<std::vector<int64_t>, int64_t> lattice;
+      std::vector<std::vector<int64_t> > vertexLattice(numVertices);
+      for (int64_t v = 0; v < numVertices; v++)
+      {
+        std::vector<int64_t> node(3, 0);
+        for (int32_t d = 0; d < 3; d++)
+        {
+          float index = (vertices[3 * v + d] - origin[d]) / res[d];
+          node[d] = static_cast<int64_t>(std::floor(index + 0.5f));
+          DREAM3D_REQUIRED(std::fabs(index - float(node[d])), <, 1.0e-4f)
+        }
+        DREAM3D_REQUIRE_EQUAL(expectedNodes.count(node), 1)
+        DREAM3D_REQUIRE_EQUAL(lattice.count(node), 0)
+        lattice[node] = v;
+        vertexLattice[v] = node;
+
+        // Node types count the Features of the 8 voxels around the node
+        std::set<int32_t> owners;
+        for (int32_t c = 0; c < 8; c++)
+        {
+          owners.insert(GetFeature(featureIds, dims, node[0] - 1 + (c & 1), node[1] - 1 + ((c >> 1) & 1), node[2] - 1 + ((c >> 2) & 1)));
+        }
+        int8_t nodeType = static_cast<int8_t>(owners.size() > 4 ? 4 : owners.size());
+        if (owners.count(-1) > 0) { nodeType += 10; }
+        DREAM3D_REQUIRE_EQUAL(nodeTypes[v], nodeType)
+      }
+
+      std::map<std::vector<int64_t>, int32_t> trianglesPerFace;
+      for (int64_t t = 0; t < numTriangles; t++)
+      {
+        int64_t corner[3][3];
+        for (int32_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRED(triangles[3 * t + c], <, numVertices)
+          for (int32_t d = 0; d < 3; d++) { corner[c][d] = vertexLattice[triangles[3 * t + c]][d]; }
+        }
+        // The triangle spans half of a face; its bounding box is the whole face
+        std::vector<int64_t> face(4, 0);
+        int64_t normal[3] = { 0, 0, 0 };
+        int64_t axis = -1;
+        for (int32_t d = 0; d < 3; d++)
+        {
+          int64_t e1 = corner[1][(d + 1) % 3] - corner[0][(d + 1) % 3];
+          int64_t e2 = corner[2][(d + 2) % 3] - corner[0][(d + 2) % 3];
+          int64_t e3 = corner[1][(d + 2) % 3] - corner[0][(d + 2) % 3];
+          int64_t e4 = corner[2][(d + 1) % 3] - corner[0][(d + 1) % 3];
+          normal[d] = e1 * e2 - e3 * e4;
+          face[d] = std::min(corner[0][d], std::min(corner[1][d], corner[2][d]));
+          if (normal[d] != 0) { axis = d; }
+        }
+        DREAM3D_REQUIRED(axis, >=, 0)
+        DREAM3D_REQUIRE_EQUAL(std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]), 1)
+        face[3] = axis;
+        DREAM3D_REQUIRE_EQUAL(expectedFaces.count(face), 1)
+        trianglesPerFace[face]++;
+
+        // The voxel in front of the triangle holds the first label, the one behind it the second
+        int64_t front[3] = { face[0], face[1], face[2] };
+        int64_t back[3] = { face[0], face[1], face[2] };
+        if (normal[axis] > 0) { back[axis]--; }
+        else { front[axis]--; }
+        DREAM3D_REQUIRE_EQUAL(faceLabels[2 * t], GetFeature(featureIds, dims, front[0], front[1], front[2]))
+        DREAM3D_REQUIRE_EQUAL(faceLabels[2 * t + 1], GetFeature(featureIds, dims, back[0], back[1], back[2]))
+      }
+      for (std::map<std::vector<int64_t>, int32_t>::iterator iter = trianglesPerFace.begin(); iter != trianglesPerFace.end(); ++iter)
+      {
+        DREAM3D_REQUIRE_EQUAL(iter->second, 2)
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestQuickSurfaceMesh()
+    {
+      int64_t dims[3] = { 5, 4, 3 };
+      float res[3] = { 1.0f, 2.0f, 0.5f };
+      float origin[3] = { 1.0f, -1.0f, 0.0f };
+
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(dims[0], dims[1], dims[2]);
+      image->setResolution(res[0], res[1], res[2]);
+      image->setOrigin(origin[0], origin[1], origin[2]);
+      m->setGeometry(image);
+
+      QVector<size_t> tDims(3, 0);
+      tDims[0] = dims[0];
+      tDims[1] = dims[1];
+      tDims[2] = dims[2];
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::FeatureIds, true);
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
+      uint32_t seed = 31337;
+      for (int64_t z = 0; z < dims[2]; z++)
+      {
+        for (int64_t y = 0; y < dims[1]; y++)
+        {
+          for (int64_t x = 0; x < dims[0]; x++)
+          {
+            int64_t index = (z * dims[1] + y) * dims[0] + x;
+            seed = seed * 1103515245u + 12345u;
+            int32_t feature = 1 + static_cast<int32_t>(x / 3 + 2 * (y / 2));
+            if ((seed >> 16) % 5 == 0) { feature = 5 + static_cast<int32_t>((seed >> 8) % 2); }
+            featureIds->setValue(index, feature);
+            phases->setValue(index, 1 + feature % 2);
+          }
+        }
+      }
+      am->addAttributeArray(featureIds->getName(), featureIds);
+      am->addAttributeArray(phases->getName(), phases);
+      m->addAttributeMatrix(am->getName(), am);
+      dca->addDataContainer(m);
+
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("QuickSurfaceMesh");
+      DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get());
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+      QVariant var;
+      QVector<DataArrayPath> selectedPaths(1, DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases));
+      var.setValue(selectedPaths);
+      bool propWasSet = filter->setProperty("SelectedDataArrayPaths", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+      DataContainer::Pointer sm = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+      DREAM3D_REQUIRE_VALID_POINTER(sm.get());
+      TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+      DREAM3D_REQUIRE_VALID_POINTER(triangleGeom.get());
+      AttributeMatrix::Pointer faceAttrMat = sm->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName);
+      AttributeMatrix::Pointer vertexAttrMat = sm->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName);
+      Int32ArrayType::Pointer faceLabels = std::dynamic_pointer_cast<Int32ArrayType>(faceAttrMat->getAttributeArray(SIMPL::FaceData::SurfaceMeshFaceLabels));
+      Int32ArrayType::Pointer facePhases = std::dynamic_pointer_cast<Int32ArrayType>(faceAttrMat->getAttributeArray(SIMPL::CellData::Phases));
+      Int8ArrayType::Pointer nodeTypes = std::dynamic_pointer_cast<Int8ArrayType>(vertexAttrMat->getAttributeArray(SIMPL::VertexData::SurfaceMeshNodeType));
+      DREAM3D_REQUIRE_VALID_POINTER(faceLabels.get());
+      DREAM3D_REQUIRE_VALID_POINTER(facePhases.get());
+      DREAM3D_REQUIRE_VALID_POINTER(nodeTypes.get());
+
+      int64_t numTriangles = static_cast<int64_t>(triangleGeom->getNumberOfTris());
+      int64_t numVertices = static_cast<int64_t>(triangleGeom->getNumberOfVertices());
+      DREAM3D_REQUIRE_EQUAL(static_cast<int64_t>(faceLabels->getNumberOfTuples()), numTriangles)
+      DREAM3D_REQUIRE_EQUAL(static_cast<int64_t>(nodeTypes->getNumberOfTuples()), numVertices)
+      CheckQuickSurfaceMesh(featureIds->getPointer(0), dims, res, origin, triangleGeom->getVertexPointer(0), numVertices,
+                            triangleGeom->getTriPointer(0), numTriangles, faceLabels->getPointer(0), nodeTypes->getPointer(0));
+
+      // The transferred cell array holds the values of the voxels on both sides; the
+      // second value of a face on the outside of the volume is not written
+      for (int64_t t = 0; t < numTriangles; t++)
+      {
+        int32_t label1 = faceLabels->getComponent(t, 0);
+        int32_t label2 = faceLabels->getComponent(t, 1);
+        DREAM3D_REQUIRE_EQUAL(facePhases->getComponent(t, 0), 1 + label1 % 2)
+        if (label2 != -1) { DREAM3D_REQUIRE_EQUAL(facePhases->getComponent(t, 1), 1 + label2 % 2) }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST(TestQuickSurfaceMesh())
+    }
+
+  private:
+    QuickSurfaceMeshTest(const QuickSurfaceMeshTest&); // Copy Constructor Not Implemented
+    void operator=(const QuickSurfaceMeshTest&); // Operator '=' Not Implemented
+};
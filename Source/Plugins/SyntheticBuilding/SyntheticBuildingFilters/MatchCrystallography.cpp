@@ -458,6 +458,7 @@ void MatchCrystallography::initializeArrays(size_t ensem)
     return;
   }
 
+  m_ActualOdfSampler.reset(m_ActualOdf->getPointer(0), m_ActualOdf->getSize());
   m_SimOdf = FloatArrayType::CreateArray(m_ActualOdf->getSize(), SIMPL::StringConstants::ODF);
   m_SimMdf = FloatArrayType::CreateArray(m_ActualMdf->getSize(), SIMPL::StringConstants::MisorientationBins);
   for (size_t j = 0; j < m_SimOdf->getSize(); j++)
@@ -600,17 +601,8 @@ void MatchCrystallography::assign_eulers(size_t ensem)
 // -----------------------------------------------------------------------------
 int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
 {
-  int32_t choose = 0;
-  float totaldensity = 0.0f;
-
-  for (int32_t j = 0; j < numbins; j++)
-  {
-    float density = m_ActualOdf->getValue(j);
-    float td1 = totaldensity;
-    totaldensity = totaldensity + density;
-    if (random < totaldensity && random >= td1) { choose = j; break; }
-  }
-  return choose;
+  int32_t choose = m_ActualOdfSampler.pickBin(random);
+  return (choose < numbins) ? choose : 0;
 }
 
 // -----------------------------------------------------------------------------
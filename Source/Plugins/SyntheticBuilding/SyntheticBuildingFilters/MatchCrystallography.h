@@ -43,6 +43,7 @@
 #include "SIMPLib/DataArrays/NeighborList.hpp"
 #include "SIMPLib/DataArrays/StatsDataArray.h"
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+#include "OrientationLib/Texture/ODFSampler.hpp"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 
@@ -302,6 +303,7 @@ class MatchCrystallography : public AbstractFilter
     std::vector<float> m_TotalSurfaceArea;
 
     FloatArrayType::Pointer m_ActualOdf;
+    ODFSampler<float> m_ActualOdfSampler;
     FloatArrayType::Pointer m_SimOdf;
     FloatArrayType::Pointer m_ActualMdf;
     FloatArrayType::Pointer m_SimMdf;